@@ -9,6 +9,8 @@
 #include <stella/common/PaletteHandler.hxx>
 #include <stella/common/VideoModeHandler.hxx>
 #include <array>
+#include <span>
+#include <utility>
 
 class Console;
 class OSystem;
@@ -96,6 +98,10 @@ public:
 	uInt16 getRGBPhosphor16(const uInt32 c, const uInt32 p) const;
 	uInt32 getRGBPhosphor32(const uInt32 c, const uInt32 p) const;
 
+	// palette for GPU lookup of PixelFmtI8/IA88 frames, 2nd half holds the decayed phosphor colors
+	std::span<const uInt32> indexedPalette() const { return tiaColorMapIndexed; }
+	bool takeIndexedPaletteChange() { return std::exchange(indexedPaletteDirty, false); }
+
 	void clear() {}
 
 	void updateSurfaceSettings() {}
@@ -109,14 +115,17 @@ private:
 	PaletteHandler myPaletteHandler;
 	uInt16 tiaColorMap16[256]{};
 	uInt32 tiaColorMap32[256]{};
+	std::array<uInt32, 512> tiaColorMapIndexed{};
 	uInt8 myPhosphorPalette[256][256]{};
 	std::array<uInt8, 160 * TIAConstants::frameBufferHeight> prevFramebuffer{};
 	Common::Rect myImageRect{};
 	float myPhosphorPercent = 0.80f;
 	bool myUsePhosphor{};
+	bool indexedPaletteDirty{true};
 	IG::PixelFormatId format;
 
 	std::array<uInt8, 3> getRGBPhosphorTriple(uInt32 c, uInt32 p) const;
+	void updateIndexedPalette();
 	template <int outputBits>
 	void renderOutput(IG::MutablePixmapView pix, TIA &tia);
 };
@@ -48,6 +48,7 @@ void FrameBuffer::enablePhosphor(bool enable, int blend)
         myPhosphorPalette[c][p] = getPhosphor(c, p);
   }
 	prevFramebuffer = {};
+	updateIndexedPalette();
 }
 
 uint8_t FrameBuffer::getPhosphor(uInt8 c1, uInt8 c2) const
@@ -69,7 +70,22 @@ void FrameBuffer::setTIAPalette(const PaletteArray& palette)
 		uint8_t b = palette[i] & 0xff;
 		tiaColorMap16[i] = IG::PixelDescRGB565.build(r >> 3, g >> 2, b >> 3, 0);
 		tiaColorMap32[i] = desc32.build((int)r, (int)g, (int)b, 0);
+		tiaColorMapIndexed[i] = IG::PixelDescRGBA8888Native.build((int)r, (int)g, (int)b, 0xFF);
 	}
+	updateIndexedPalette();
+}
+
+void FrameBuffer::updateIndexedPalette()
+{
+	// decay the previous frame's colors the same way as getPhosphor() so the GPU
+	// only needs a per-channel max of the two lookups
+	for(auto i : IG::iotaCount(256))
+	{
+		auto [r, g, b, a] = IG::PixelDescRGBA8888Native.rgba(tiaColorMapIndexed[i]);
+		tiaColorMapIndexed[256 + i] = IG::PixelDescRGBA8888Native.build(
+			(int)getPhosphor(0, r), (int)getPhosphor(0, g), (int)getPhosphor(0, b), 0xFF);
+	}
+	indexedPaletteDirty = true;
 }
 
 void FrameBuffer::setPixelFormat(IG::PixelFormatId fmt)
@@ -147,7 +163,24 @@ void FrameBuffer::renderOutput(IG::MutablePixmapView pix, TIA &tia)
 
 void FrameBuffer::render(IG::MutablePixmapView pix, TIA &tia)
 {
-	if(format == IG::PixelFmtRGB565)
+	if(pix.format() == IG::PixelFmtI8 || pix.format() == IG::PixelFmtIA88) // palette lookup done by the video layer
+	{
+		IG::PixmapView framePix{{{(int)tia.width(), (int)tia.height()}, IG::PixelFmtI8}, tia.frameBuffer()};
+		assumeExpr(pix.size() == framePix.size());
+		if(pix.format() == IG::PixelFmtIA88)
+		{
+			// pair each index with the previous frame's index for the phosphor blend
+			assumeExpr(myUsePhosphor);
+			uint8_t* prevFrame = prevFramebuffer.data();
+			pix.writeTransformed([&prevFrame](uint8_t p) { return uint16_t(p | (*prevFrame++ << 8)); }, framePix);
+			memcpy(prevFramebuffer.data(), tia.frameBuffer(), sizeof(prevFramebuffer));
+		}
+		else
+		{
+			pix.write(framePix);
+		}
+	}
+	else if(format == IG::PixelFmtRGB565)
 	{
 		renderOutput<16>(pix, tia);
 	}
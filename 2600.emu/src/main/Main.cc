@@ -34,9 +34,12 @@
 #include <emuframework/EmuAppInlines.hh>
 #include <emuframework/EmuSystemInlines.hh>
 #undef Debugger
+#include <imagine/fs/FS.hh>
+#include <imagine/io/FileIO.hh>
 #include <imagine/util/format.hh>
 #include <imagine/util/string.h>
 #include <imagine/logger/logger.h>
+#include <ranges>
 
 namespace EmuEx
 {
@@ -46,6 +49,7 @@ constexpr size_t MAX_ROM_SIZE = 512 * 1024;
 const char *EmuSystem::creditsViewStr = CREDITS_INFO_STRING "(c) 2011-2024\nRobert Broglia\nwww.explusalpha.com\n\nPortions (c) the\nStella Team\nstella-emu.github.io";
 bool EmuSystem::hasPALVideoSystem = true;
 bool EmuSystem::hasResetModes = true;
+bool EmuSystem::canRenderPaletteIndices = true;
 IG::Audio::SampleFormat EmuSystem::audioSampleFormat = IG::Audio::SampleFormats::f32;
 bool EmuSystem::hasRectangularPixels = true;
 bool EmuApp::needsGlobalInstance = true;
@@ -72,6 +76,85 @@ const char *EmuSystem::systemName() const
 	return "Atari 2600";
 }
 
+// Results of cartridge, frame layout & controller autodetection are kept per ROM MD5 in a
+// text file with one "md5 cartType format leftController rightController" line per ROM so later
+// loads skip the detection passes, "AUTO" marks a value that wasn't detected
+constexpr std::array detectCacheProps{PropType::Cart_Type, PropType::Display_Format, PropType::Controller_Left, PropType::Controller_Right};
+constexpr size_t detectCacheMaxEntries = 4096;
+
+static FS::PathString detectCachePath(ApplicationContext ctx)
+{
+	return FS::pathString(ctx.cachePath(), "romDetect");
+}
+
+static std::string_view detectCacheEntry(std::string_view cache, std::string_view md5)
+{
+	for(auto l : cache | std::views::split('\n'))
+	{
+		std::string_view line{l};
+		if(line.size() > md5.size() && line.starts_with(md5) && line[md5.size()] == ' ')
+			return line.substr(md5.size() + 1);
+	}
+	return {};
+}
+
+// replaces props still set to AUTO with previously detected values, returns false if the ROM isn't cached
+static bool applyDetectCache(ApplicationContext ctx, std::string_view md5, Properties &props)
+{
+	auto buff = FileUtils::bufferFromPath(detectCachePath(ctx), {.test = true});
+	if(!buff)
+		return false;
+	auto entry = detectCacheEntry(buff.stringView(), md5);
+	if(entry.empty())
+		return false;
+	auto propIt = detectCacheProps.begin();
+	for(auto v : entry | std::views::split(' '))
+	{
+		if(propIt == detectCacheProps.end())
+			break;
+		std::string val{std::string_view{v}};
+		if(val != "AUTO" && props.get(*propIt) == "AUTO")
+			props.set(*propIt, val);
+		propIt++;
+	}
+	log.info("using cached detection results:{}", entry);
+	return true;
+}
+
+static void storeDetectCache(ApplicationContext ctx, std::string_view md5, const Properties &props, const Console &console)
+{
+	bool swappedPorts = props.get(PropType::Console_SwapPorts) == "YES";
+	auto leftType = (swappedPorts ? console.rightController() : console.leftController()).type();
+	auto rightType = (swappedPorts ? console.leftController() : console.rightController()).type();
+	std::array<std::string, detectCacheProps.size()> detected{console.cartridge().detectedType(), console.getFormatString(),
+		Controller::getPropName(leftType), Controller::getPropName(rightType)};
+	std::string entry{md5};
+	bool hasDetected{};
+	for(auto i : iotaCount(detectCacheProps.size()))
+	{
+		// only values Stella autodetected are worth keeping, others come from the properties database or options
+		bool wasDetected = props.get(detectCacheProps[i]) == "AUTO";
+		hasDetected |= wasDetected;
+		entry += ' ';
+		entry += wasDetected ? detected[i] : "AUTO";
+	}
+	if(!hasDetected)
+		return;
+	entry += '\n';
+	auto path = detectCachePath(ctx);
+	auto buff = FileUtils::bufferFromPath(path, {.test = true});
+	std::string_view cache = buff ? buff.stringView() : std::string_view{};
+	// drop the oldest entries once full
+	for(auto entries = std::ranges::count(cache, '\n'); entries >= ptrdiff_t(detectCacheMaxEntries); entries--)
+	{
+		cache.remove_prefix(cache.find('\n') + 1);
+	}
+	std::string content{cache};
+	content += entry;
+	if(FileUtils::writeToPath(path, std::span{reinterpret_cast<const unsigned char*>(content.data()), content.size()}) == -1)
+		log.error("error writing detection cache:{}", path);
+}
+
 FS::FileString A2600System::stateFilename(int slot, std::string_view name) const
 {
 	return IG::format<FS::FileString>("{}.0{}.sta", name, saveSlotChar(slot));
@@ -112,6 +195,8 @@ void A2600System::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDeleg
 	Properties props{};
 	os.propSet().getMD5(md5, props);
 	defaultGameProps = props;
+	const string romMd5 = md5; // CartCreator changes md5 to the selected game of a multi-cart
+	bool detectCached = applyDetectCache(appContext(), romMd5, props);
 	auto &romType = props.get(PropType::Cart_Type);
 	FilesystemNode fsNode{contentFileName().data()};
 	auto &settings = os.settings();
@@ -131,6 +216,8 @@ void A2600System::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDeleg
 	}
 	os.makeConsole(cartridge, props, contentFileName().data());
 	auto &console = os.console();
+	if(!detectCached)
+		storeDetectCache(appContext(), romMd5, props, console);
 	autoDetectedInput1 = limitToSupportedControllerTypes(console.leftController().type());
 	setControllerType(EmuApp::get(appContext()), console, optionInputPort1);
 	Paddles::setDigitalSensitivity(optionPaddleDigitalSensitivity);
@@ -167,8 +254,12 @@ void A2600System::configAudioRate(FrameTime outputFrameTime, int outputRate)
 
 static void renderVideo(EmuSystemTaskContext taskCtx, EmuVideo &video, FrameBuffer &fb, TIA &tia)
 {
-	auto fmt = video.renderPixelFormat();
+	auto fmt = video.usesPaletteIndices() ? (fb.phosphorEnabled() ? IG::PixelFmtIA88 : IG::PixelFmtI8) : video.renderPixelFormat();
 	auto img = video.startFrameWithFormat(taskCtx, {{(int)tia.width(), (int)tia.height()}, fmt});
+	if(video.isPaletted() && fb.takeIndexedPaletteChange())
+	{
+		video.setPalette(fb.indexedPalette());
+	}
 	fb.render(img.pixmap(), tia);
 	img.endFrame();
 }
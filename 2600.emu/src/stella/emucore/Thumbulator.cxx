@@ -135,6 +135,7 @@ Thumbulator::Thumbulator(const uInt16* rom_ptr, uInt16* ram_ptr, uInt32 rom_size
     cStart{c_start},
     cStack{c_stack},
     decodedRom{make_unique<Op[]>(romSize / 2)},  // NOLINT
+    decodedRam{make_unique<DecodedRamOp[]>(RAMSIZE / 2)},  // NOLINT
     ram{ram_ptr},
     configuration{configurefor},
     myCartridge{cartridge}
@@ -1114,6 +1115,13 @@ int Thumbulator::execute()
 #ifndef UNSAFE_OPTIMIZATIONS
   if ((instructionPtr & 0xF0000000) == 0 && instructionPtr < romSize)
     decodedOp = decodedRom[instructionPtr >> 1];
+  else if ((instructionPtr & 0xF0000000) == 0x40000000)
+  {
+    DecodedRamOp& cached = decodedRam[(instructionPtr & RAMADDMASK) >> 1];
+    if (cached.op == Op::invalid || cached.inst != inst)
+      cached = {uInt16(inst), decodeInstructionWord(inst)};
+    decodedOp = cached.op;
+  }
   else
     decodedOp = decodeInstructionWord(inst);
 #else
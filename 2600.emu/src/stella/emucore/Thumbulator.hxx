@@ -274,6 +274,10 @@ class Thumbulator
     uInt32 cStart{0};
     uInt32 cStack{0};
     const unique_ptr<Op[]> decodedRom;  // NOLINT
+    // Code copied to RAM can change under us, so each entry remembers the
+    // instruction word it was decoded from and is re-decoded on mismatch
+    struct DecodedRamOp { uInt16 inst{0}; Op op{Op::invalid}; };
+    const unique_ptr<DecodedRamOp[]> decodedRam;  // NOLINT
     uInt16* ram{nullptr};
     std::array<uInt32, 16> reg_norm; // normal execution mode, do not have a thread mode
     uInt32 cpsr{0};
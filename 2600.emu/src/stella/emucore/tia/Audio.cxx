@@ -83,6 +83,25 @@ void Audio::tick()
   if (++myCounter == 228) myCounter = 0;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Audio::tick(uInt32 clocks)
+{
+  while (clocks > 0) {
+    // Only the counter values with a phase update need a full tick
+    const uInt32 nextPhase =
+      myCounter <= 9 ? 9 : myCounter <= 37 ? 37 : myCounter <= 81 ? 81 : myCounter <= 149 ? 149 : 228 + 9;
+    const uInt32 idleClocks = std::min(clocks, nextPhase - myCounter);
+
+    myCounter = (myCounter + idleClocks) % 228;
+    clocks -= idleClocks;
+
+    if (clocks > 0) {
+      tick();
+      --clocks;
+    }
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Audio::phase1()
 {
@@ -46,6 +46,11 @@ class Audio : public Serializable
 
     void tick();
 
+    /**
+      Equivalent to calling tick() the given number of times.
+    */
+    void tick(uInt32 clocks);
+
     AudioChannel& channel0();
 
     AudioChannel& channel1();
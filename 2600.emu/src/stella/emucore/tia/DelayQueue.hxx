@@ -43,6 +43,14 @@ class DelayQueue : public Serializable
 
     template<typename T> void execute(T executor);
 
+    /**
+      True if no writes are pending, in which case execute() only advances
+      the queue and skip() can be used to advance it several clocks at once.
+    */
+    bool isEmpty() const;
+
+    void skip(uInt32 clocks);
+
     /**
       Serializable methods (see that class for more information).
     */
@@ -118,6 +126,23 @@ void DelayQueue<length, capacity>::execute(T executor)
   myIndex = smartmod<length>(myIndex + 1);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<unsigned length, unsigned capacity>
+bool DelayQueue<length, capacity>::isEmpty() const
+{
+  for (uInt32 i = 0; i < length; ++i)
+    if (myMembers[i].mySize) return false;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<unsigned length, unsigned capacity>
+void DelayQueue<length, capacity>::skip(uInt32 clocks)
+{
+  myIndex = (myIndex + clocks) % length;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 template<unsigned length, unsigned capacity>
 bool DelayQueue<length, capacity>::save(Serializer& out) const
@@ -1417,6 +1417,28 @@ void TIA::cycle(uInt32 colorClocks)
 {
   for (uInt32 i = 0; i < colorClocks; ++i)
   {
+    // While the line cache is active and no writes are pending nothing happens
+    // until the end of the line, so skip there instead of ticking every clock
+    if (myLinesSinceChange >= 2 && myDelayQueue.isEmpty()) {
+      const uInt32 clocks = std::min<uInt32>(colorClocks - i, TIAConstants::H_CLOCKS - myHctr);
+
+      myDelayQueue.skip(clocks);
+      myCollisionUpdateRequired = clocks == 1 && myCollisionUpdateScheduled;
+      myCollisionUpdateScheduled = false;
+
+      myHctr += clocks;
+      if (myHctr >= TIAConstants::H_CLOCKS)
+        nextLine();
+
+      #ifdef SOUND_SUPPORT
+        myAudio.tick(clocks);
+      #endif
+
+      myTimestamp += clocks;
+      i += clocks - 1;
+      continue;
+    }
+
     myDelayQueue.execute(
       [this] (uInt8 address, uInt8 value) {delayedWrite(address, value);}
     );
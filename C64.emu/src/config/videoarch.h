@@ -22,6 +22,7 @@ struct video_canvas_s
 	bool initialized;
 	bool created;
 	bool skipFrame;
+	bool renderDirect; // frontend renders the draw buffer into the video texture itself
 	uint8_t pixelFormat;
 };
 typedef struct video_canvas_s video_canvas_t;
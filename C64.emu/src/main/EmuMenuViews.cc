@@ -296,6 +296,16 @@ class CustomSystemOptionView : public SystemOptionView, public MainAppHelper
 		}
 	};
 
+	BoolMenuItem mediaActivityWarp
+	{
+		"Fast-forward During Disk/Tape Access", attachParams(),
+		(bool)system().mediaActivityWarp,
+		[this](BoolMenuItem &item)
+		{
+			system().mediaActivityWarp = item.flipBoolValue(*this);
+		}
+	};
+
 	TextMenuItem joystickModeItems[3]
 	{
 		{toString(JoystickMode::Port1),    attachParams(), {.id = JoystickMode::Port1}},
@@ -339,6 +349,7 @@ public:
 		loadStockItems();
 		item.emplace_back(&defaultModel);
 		item.emplace_back(&defaultTrueDriveEmu);
+		item.emplace_back(&mediaActivityWarp);
 		item.emplace_back(&joystickMode);
 	}
 };
@@ -996,6 +1007,17 @@ class MachineOptionView : public TableView, public MainAppHelper
 		}
 	};
 
+	BoolMenuItem driveIdleSkip
+	{
+		"Skip Idle Drive CPU Cycles", attachParams(),
+		system().driveIdleSkip(),
+		[this](BoolMenuItem &item, View &, Input::Event e)
+		{
+			system().sessionOptionSet();
+			system().setDriveIdleSkip(item.flipBoolValue(*this));
+		}
+	};
+
 	TextHeadingMenuItem videoHeader{system().videoChipStr(), attachParams()};
 
 	std::vector<std::string> paletteName{};
@@ -1078,6 +1100,7 @@ public:
 			menuItem.emplace_back(&vic20MemExpansions);
 		}
 		menuItem.emplace_back(&trueDriveEmu);
+		menuItem.emplace_back(&driveIdleSkip);
 		menuItem.emplace_back(&autostartTDE);
 		menuItem.emplace_back(&autostartBasicLoad);
 		menuItem.emplace_back(&autostartWarp);
@@ -494,18 +494,22 @@ void C64System::loadContent(IO &, EmuSystemCreateParams params, OnLoadProgressDe
 void C64System::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio)
 {
 	audioPtr = audio;
+	if(!*plugin.media_activity)
+		mediaActivityWarpCancelled = false;
 	setCanvasSkipFrame(!video);
+	updateCanvasRenderDirect(video);
 	signalViceThreadAndWait();
 	if(video)
 	{
-		video->startFrameWithAltFormat(taskCtx, canvasSrcPix);
+		startCanvasFrame(taskCtx, *video);
 	}
 	audioPtr = {};
 }
 
 void C64System::renderFramebuffer(EmuVideo &video)
 {
-	video.startFrameWithAltFormat({}, canvasSrcPix);
+	updateCanvasRenderDirect(&video);
+	startCanvasFrame({}, video);
 }
 
 void C64System::configAudioRate(FrameTime outputFrameTime, int outputRate)
@@ -520,7 +524,8 @@ void C64System::configAudioRate(FrameTime outputFrameTime, int outputRate)
 
 bool C64System::shouldFastForward() const
 {
-	return *plugin.warp_mode_enabled;
+	return *plugin.warp_mode_enabled ||
+		(mediaActivityWarp && !mediaActivityWarpCancelled && *plugin.media_activity);
 }
 
 void EmuApp::onCustomizeNavView(EmuApp::NavView &view)
@@ -92,7 +92,8 @@ enum
 	CFGKEY_DEFAULT_DRIVE_TRUE_EMULATION = 288, CFGKEY_COLOR_SATURATION = 289,
 	CFGKEY_COLOR_CONTRAST = 290, CFGKEY_COLOR_BRIGHTNESS = 291,
 	CFGKEY_COLOR_GAMMA = 292, CFGKEY_COLOR_TINT = 293,
-	CFGKEY_DEFAULT_JOYSTICK_MODE = 294
+	CFGKEY_DEFAULT_JOYSTICK_MODE = 294, CFGKEY_DRIVE_IDLE_SKIP = 295,
+	CFGKEY_MEDIA_ACTIVITY_WARP = 296
 };
 
 enum Vic20Ram : uint8_t
@@ -130,6 +131,7 @@ public:
 	std::string defaultPaletteName{};
 	std::string lastMissingSysFile;
 	IG::PixmapView canvasSrcPix{};
+	IG::WPt canvasSrcPos{};
 	PixelFormat pixFmt{PixelFmtRGBA8888};
 	ViceSystem currSystem{};
 	bool viceThreadSignaled{};
@@ -139,6 +141,9 @@ public:
 	Property<JoystickMode, CFGKEY_JOYSTICK_MODE,
 		PropertyDesc<JoystickMode>{.defaultValue = JoystickMode::Auto}> joystickMode;
 	JoystickMode effectiveJoystickMode{};
+	// fast-forward while a drive LED or datasette motor is on, until the user gives input
+	Property<bool, CFGKEY_MEDIA_ACTIVITY_WARP> mediaActivityWarp;
+	bool mediaActivityWarpCancelled{};
 	bool ctrlLock{};
 	bool c64IsInit{}, c64FailedInit{};
 	std::array <FS::PathString, Config::envIsLinux ? 3 : 1> sysFilePath{};
@@ -175,6 +180,8 @@ public:
 	int reSidSampling() const;
 	void setDriveTrueEmulation(bool on);
 	bool driveTrueEmulation() const;
+	void setDriveIdleSkip(bool on);
+	bool driveIdleSkip() const;
 	void setAutostartWarp(bool on);
 	bool autostartWarp() const;
 	void setAutostartTDE(bool on);
@@ -260,6 +267,8 @@ protected:
 	bool virtualDeviceTraps() const;
 	void handleKeyboardInput(InputAction, bool positionalShift = {});
 	void setCanvasSkipFrame(bool on);
+	void updateCanvasRenderDirect(EmuVideo *);
+	void startCanvasFrame(EmuSystemTaskContext, EmuVideo &);
 	bool updateCanvasPixelFormat(struct video_canvas_s *, PixelFormat);
 	void tryLoadingSplitVic20Cart();
 };
@@ -509,6 +509,7 @@ VicePlugin commonVicePlugin(void *lib, ViceSystem system)
 	VicePlugin plugin{};
 	loadSymbolCheck(plugin.joystick_value, lib, "joystick_value");
 	loadSymbolCheck(plugin.warp_mode_enabled, lib, "warp_mode_enabled");
+	loadSymbolCheck(plugin.media_activity, lib, "media_activity");
 	loadSymbolCheck(plugin.resources_get_string_, lib, "resources_get_string");
 	loadSymbolCheck(plugin.resources_set_string_, lib, "resources_set_string");
 	loadSymbolCheck(plugin.resources_get_int_, lib, "resources_get_int");
@@ -50,6 +50,7 @@ struct VicePlugin
 	IG::SharedLibraryRef libHandle{};
 	uint16_t (*joystick_value)[JOYPORT_MAX_PORTS]{};
 	int *warp_mode_enabled{};
+	unsigned int *media_activity{};
 	std::span<const std::string_view> modelNames{};
 	std::string_view configName{};
 	const char *borderModeStr{""};
@@ -617,6 +617,8 @@ void C64System::handleInputAction(EmuApp *app, InputAction a)
 			positionalShift = true;
 		}
 	}
+	if(a.isPushed() && *plugin.media_activity)
+		mediaActivityWarpCancelled = true;
 	auto key = C64Key(a.code);
 	switch(key)
 	{
@@ -151,6 +151,7 @@ bool C64System::resetSessionOptions(EmuApp &)
 	setDriveType(10, DRIVE_TYPE_NONE);
 	setDriveType(11, DRIVE_TYPE_NONE);
 	setDriveTrueEmulation(defaultDriveTrueEmulation);
+	setDriveIdleSkip(true);
 	return true;
 }
 
@@ -182,6 +183,7 @@ bool C64System::readConfig(ConfigType type, MapIO &io, unsigned key)
 			case CFGKEY_COLOR_GAMMA: return readOptionValue<int16_t>(io, [&](auto v){ setColorSetting(ColorSetting::Gamma, v); });
 			case CFGKEY_COLOR_TINT: return readOptionValue<int16_t>(io, [&](auto v){ setColorSetting(ColorSetting::Tint, v); });
 			case CFGKEY_DEFAULT_JOYSTICK_MODE: return readOptionValue(io, defaultJoystickMode);
+			case CFGKEY_MEDIA_ACTIVITY_WARP: return readOptionValue(io, mediaActivityWarp);
 		}
 	}
 	else if(type == ConfigType::SESSION)
@@ -191,6 +193,7 @@ bool C64System::readConfig(ConfigType type, MapIO &io, unsigned key)
 			case CFGKEY_MODEL:
 				return readOptionValue<bool>(io, [&](auto v){ if(modelIdIsValid(v)) { setModel(v); } });
 			case CFGKEY_DRIVE_TRUE_EMULATION: return readOptionValue<bool>(io, [&](auto v){ setDriveTrueEmulation(v); });
+			case CFGKEY_DRIVE_IDLE_SKIP: return readOptionValue<bool>(io, [&](auto v){ setDriveIdleSkip(v); });
 			case CFGKEY_AUTOSTART_WARP: return readOptionValue<bool>(io, [&](auto v){ setAutostartWarp(v); });
 			case CFGKEY_AUTOSTART_TDE: return readOptionValue<bool>(io, [&](auto v){ setAutostartTDE(v); });
 			case CFGKEY_AUTOSTART_BASIC_LOAD: return readOptionValue<bool>(io, [&](auto v){ setIntResource("AutostartBasicLoad", v); });
@@ -256,6 +259,7 @@ void C64System::writeConfig(ConfigType type, FileIO &io)
 		writeOptionValueIfNotDefault(io, CFGKEY_COLOR_GAMMA, int16_t(colorSetting(ColorSetting::Gamma)), 1000);
 		writeOptionValueIfNotDefault(io, CFGKEY_COLOR_TINT, int16_t(colorSetting(ColorSetting::Tint)), 1000);
 		writeOptionValueIfNotDefault(io, defaultJoystickMode);
+		writeOptionValueIfNotDefault(io, mediaActivityWarp);
 	}
 	else if(type == ConfigType::SESSION)
 	{
@@ -309,6 +313,7 @@ void C64System::writeConfig(ConfigType type, FileIO &io)
 			writeOptionValue(io, CFGKEY_DRIVE11_TYPE, (uint16_t)driveType);
 		}
 		writeOptionValueIfNotDefault(io, CFGKEY_DRIVE_TRUE_EMULATION, driveTrueEmulation(), defaultDriveTrueEmulation);
+		writeOptionValueIfNotDefault(io, CFGKEY_DRIVE_IDLE_SKIP, driveIdleSkip(), true);
 	}
 }
 
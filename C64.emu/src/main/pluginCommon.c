@@ -174,10 +174,25 @@ int ui_extend_image_dialog(void)
 
 void ui_display_reset(int device, int mode) {}
 
+// bits 0-3: drive 8-11 LED on, bits 4-5: datasette 1-2 motor on
+unsigned int media_activity;
+
+static void setMediaActivity(unsigned int bit, int on)
+{
+	if(on)
+		media_activity |= bit;
+	else
+		media_activity &= ~bit;
+}
+
 void ui_display_drive_led(unsigned int drive_number,
 	unsigned int drive_base,
 	unsigned int led_pwm1,
-	unsigned int led_pwm2) {}
+	unsigned int led_pwm2)
+{
+	if(drive_number < 4)
+		setMediaActivity(1u << drive_number, led_pwm1 || led_pwm2);
+}
 void ui_display_drive_track(unsigned int drive_number,
   unsigned int drive_base,
   unsigned int half_track_number,
@@ -385,7 +400,11 @@ void fullscreen_capability(cap_fullscreen_t *cap_fullscreen) {}
 void ui_display_tape_current_image(int port, const char *image) {}
 void ui_display_drive_current_image(unsigned int unit_number, unsigned int drive_number, const char *image) {}
 void ui_display_tape_control_status(int port, int control) {}
-void ui_display_tape_motor_status(int port, int motor) {}
+void ui_display_tape_motor_status(int port, int motor)
+{
+	if(port >= 0 && port < 2)
+		setMediaActivity(0x10u << port, motor);
+}
 void ui_display_recording(int recording_status) {}
 void ui_display_playback(int playback_status, char *version) {}
 void ui_display_event_time(unsigned int current, unsigned int total) {}
@@ -177,6 +177,24 @@ bool C64System::driveTrueEmulation() const
 	return intResource("Drive8TrueEmulation");
 }
 
+void C64System::setDriveIdleSkip(bool on)
+{
+	// trap the drive CPU when it enters the DOS ROM idle loop and only
+	// catch up its cycles when the IEC bus or a VIA wakes it again
+	log.info("set drive idle skip:{}", on);
+	enterCPUTrap();
+	auto method = on ? DRIVE_IDLE_TRAP_IDLE : DRIVE_IDLE_NO_IDLE;
+	setIntResource("Drive8IdleMethod", method);
+	setIntResource("Drive9IdleMethod", method);
+	setIntResource("Drive10IdleMethod", method);
+	setIntResource("Drive11IdleMethod", method);
+}
+
+bool C64System::driveIdleSkip() const
+{
+	return intResource("Drive8IdleMethod") != DRIVE_IDLE_NO_IDLE;
+}
+
 constexpr const char *driveTypeName[4]
 {
 	"Drive8Type",
@@ -122,7 +122,7 @@ int video_canvas_set_palette(video_canvas_t *c, struct palette_s *palette)
 
 void video_canvas_refresh(struct video_canvas_s *c, unsigned int xs, unsigned int ys, unsigned int xi, unsigned int yi, unsigned int w, unsigned int h)
 {
-	if(!c->created) [[unlikely]]
+	if(!c->created || c->renderDirect) [[unlikely]]
 		return;
 	xi *= c->videoconfig->scalex;
 	w *= c->videoconfig->scalex;
@@ -158,10 +158,12 @@ void C64System::resetCanvasSourcePixmap(struct video_canvas_s *c)
 		}
 		int width = 320+(xBorderSize*2 - startX*2);
 		int widthPadding = startX*2;
-		canvasSrcPix = pixmapView(c).subView({startX, startY}, {width, height});
+		canvasSrcPos = {startX, startY};
+		canvasSrcPix = pixmapView(c).subView(canvasSrcPos, {width, height});
 	}
 	else
 	{
+		canvasSrcPos = {};
 		canvasSrcPix = pixmapView(c);
 	}
 }
@@ -192,6 +194,71 @@ static void refreshFullCanvas(video_canvas_t *canvas)
 		std::min(canvas->draw_buffer->canvas_height, viewport->last_line - viewport->first_line + 1));
 }
 
+static bool canRenderDirect(const struct video_canvas_s *c, const EmuVideo &video)
+{
+	// interlaced output swaps draw buffers at the end of the frame so
+	// only the canvas refresh sees the right field
+	return c->created && c->pixmapData &&
+		video.renderPixelFormat() == IG::PixelFormat{IG::PixelFormatId{c->pixelFormat}} &&
+		!c->videoconfig->interlaced &&
+		c->videoconfig->scalex == 1 && c->videoconfig->scaley == 1;
+}
+
+void C64System::updateCanvasRenderDirect(EmuVideo *video)
+{
+	auto c = activeCanvas;
+	if(!c || !video)
+		return;
+	bool direct = canRenderDirect(c, *video);
+	if(c->renderDirect && !direct)
+	{
+		// bring the pixmap up to date since direct frames skipped it
+		c->renderDirect = false;
+		refreshFullCanvas(c);
+	}
+	c->renderDirect = direct;
+}
+
+void C64System::startCanvasFrame(EmuSystemTaskContext taskCtx, EmuVideo &video)
+{
+	auto c = activeCanvas;
+	if(!c || !c->renderDirect)
+	{
+		video.startFrameWithAltFormat(taskCtx, canvasSrcPix);
+		return;
+	}
+	if(!canRenderDirect(c, video)) [[unlikely]]
+	{
+		c->renderDirect = false;
+		refreshFullCanvas(c);
+		video.startFrameWithAltFormat(taskCtx, canvasSrcPix);
+		return;
+	}
+	// The VICE thread is paused at vsync so its draw buffer holds the finished frame,
+	// render it straight into the texture instead of going through the canvas pixmap
+	auto img = video.startFrameWithFormat(taskCtx, canvasSrcPix.desc());
+	auto pix = img.pixmap();
+	auto viewport = c->viewport;
+	auto geometry = c->geometry;
+	int xs = viewport->first_x + geometry->extra_offscreen_border_left;
+	int ys = viewport->first_line;
+	int xi = viewport->x_offset;
+	int yi = viewport->y_offset;
+	int w = std::min(c->draw_buffer->canvas_width, geometry->screen_size.width - viewport->first_x);
+	int h = std::min(c->draw_buffer->canvas_height, viewport->last_line - viewport->first_line + 1);
+	// clip to the cropped area of the canvas
+	int x0 = std::max(xi, canvasSrcPos.x);
+	int y0 = std::max(yi, canvasSrcPos.y);
+	int x1 = std::min(xi + w, canvasSrcPos.x + pix.w());
+	int y1 = std::min(yi + h, canvasSrcPos.y + pix.h());
+	if(x1 > x0 && y1 > y0)
+	{
+		plugin.video_canvas_render(c, (uint8_t*)pix.data(), x1 - x0, y1 - y0,
+			xs + (x0 - xi), ys + (y0 - yi), x0 - canvasSrcPos.x, y0 - canvasSrcPos.y, pix.pitchBytes());
+	}
+	img.endFrame();
+}
+
 bool C64System::updateCanvasPixelFormat(struct video_canvas_s *c, IG::PixelFormat fmt)
 {
 	assumeExpr(isValidPixelFormat(fmt));
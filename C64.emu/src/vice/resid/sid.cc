@@ -29,6 +29,11 @@
 
 #include <iostream>
 #include <fstream>
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 using namespace std;
 
 namespace reSID
@@ -46,6 +51,41 @@ inline short clip(int input)
     return (short)input;
 }
 
+// ----------------------------------------------------------------------------
+// Convolution of fir_N samples with one FIR table, the inner loop of the
+// resampling modes. Eight 16 bit products are summed per step into 32 bit
+// lanes, matching the int accumulation of the scalar loop.
+// ----------------------------------------------------------------------------
+static inline int convolve(const short* a, const short* b, int n)
+{
+  int out = 0;
+  int i = 0;
+#if defined(__ARM_NEON)
+  int32x4_t acc = vdupq_n_s32(0);
+  for (; i + 8 <= n; i += 8) {
+    int16x8_t x = vld1q_s16(a + i);
+    int16x8_t y = vld1q_s16(b + i);
+    acc = vmlal_s16(acc, vget_low_s16(x), vget_low_s16(y));
+    acc = vmlal_s16(acc, vget_high_s16(x), vget_high_s16(y));
+  }
+  int32x2_t acc2 = vadd_s32(vget_low_s32(acc), vget_high_s32(acc));
+  out = vget_lane_s32(vpadd_s32(acc2, acc2), 0);
+#elif defined(__SSE2__)
+  __m128i acc = _mm_setzero_si128();
+  for (; i + 8 <= n; i += 8) {
+    acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128((const __m128i*)(a + i)),
+                                            _mm_loadu_si128((const __m128i*)(b + i))));
+  }
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+  out = _mm_cvtsi128_si32(acc);
+#endif
+  for (; i < n; i++) {
+    out += a[i]*b[i];
+  }
+  return out;
+}
+
 // ----------------------------------------------------------------------------
 // Constructor.
 // ----------------------------------------------------------------------------
@@ -990,10 +1030,7 @@ int SID::clock_resample(cycle_count& delta_t, short* buf, int n, int interleave)
     short* sample_start = sample + sample_index - fir_N - 1 + RINGSIZE;
 
     // Convolution with filter impulse response.
-    int v1 = 0;
-    for (int j = 0; j < fir_N; j++) {
-      v1 += sample_start[j]*fir_start[j];
-    }
+    int v1 = convolve(sample_start, fir_start, fir_N);
 
     // Use next FIR table, wrap around to first FIR table using
     // next sample.
@@ -1004,10 +1041,7 @@ int SID::clock_resample(cycle_count& delta_t, short* buf, int n, int interleave)
     fir_start = fir + fir_offset*fir_N;
 
     // Convolution with filter impulse response.
-    int v2 = 0;
-    for (int k = 0; k < fir_N; k++) {
-      v2 += sample_start[k]*fir_start[k];
-    }
+    int v2 = convolve(sample_start, fir_start, fir_N);
 
     // Linear interpolation.
     // fir_offset_rmd is equal for all samples, it can thus be factorized out:
@@ -1056,10 +1090,7 @@ int SID::clock_resample_fastmem(cycle_count& delta_t, short* buf, int n, int int
     short* sample_start = sample + sample_index - fir_N + RINGSIZE;
 
     // Convolution with filter impulse response.
-    int v = 0;
-    for (int j = 0; j < fir_N; j++) {
-      v += sample_start[j]*fir_start[j];
-    }
+    int v = convolve(sample_start, fir_start, fir_N);
 
     v >>= FIR_SHIFT;
 
@@ -33,6 +33,7 @@
 #include "vicii-chip-model.h"
 #include "vicii-draw-cycle.h"
 #include "viciitypes.h"
+#include "vsync.h"
 
 /* disable for debugging */
 #define DRAW_INLINE inline
@@ -117,6 +118,9 @@ static uint8_t last_color_value;
 
 static unsigned int cycle_flags_pipe;
 
+/* set for lines of frames the frontend won't display */
+static int skip_colors = 0;
+
 void vicii_monitor_colreg_store(int reg, int value)
 {
     cregs[reg] = value;
@@ -662,6 +666,24 @@ static DRAW_INLINE void draw_colors8(void)
     update_cregs();
 }
 
+/* Used in place of draw_colors8() on skipped frames, the graphics, sprite
+   and border stages still run since collisions and register latches
+   depend on them, only the color resolved output is dropped. */
+static DRAW_INLINE void skip_colors8(void)
+{
+    if (vicii.dbuf_offset > VICII_DRAW_BUFFER_SIZE - 8) {
+        return;
+    }
+
+    if (last_color_reg != 0xff) {
+        cregs[last_color_reg] = last_color_value;
+    }
+    memcpy(pixel_buffer, render_buffer, 8);
+    vicii.dbuf_offset += 8;
+
+    update_cregs();
+}
+
 
 /**************************************************************************
  *
@@ -674,6 +696,7 @@ void vicii_draw_cycle(void)
     /* reset rendering on raster cycle 1 */
     if (vicii.raster_cycle == 1) {
         vicii.dbuf_offset = 0;
+        skip_colors = vsync_should_skip_frame(vicii.raster.canvas);
     }
 
     draw_graphics8(cycle_flags_pipe);
@@ -682,7 +705,11 @@ void vicii_draw_cycle(void)
 
     draw_border8();
 
-    draw_colors8();
+    if (skip_colors) {
+        skip_colors8();
+    } else {
+        draw_colors8();
+    }
 
     cycle_flags_pipe = vicii.cycle_flags;
 }
@@ -1,8 +1,13 @@
 include $(IMAGINE_PATH)/make/imagineStaticLibBase.mk
 
 SRC += \
+ArchiveCache.cc \
+AudioResampler.cc \
 AutosaveManager.cc \
+AutoTuner.cc \
+BackupMemoryWriter.cc \
 ConfigFile.cc \
+DirtyLineTracker.cc \
 EmuApp.cc \
 EmuAudio.cc \
 EmuInput.cc \
@@ -12,13 +17,22 @@ EmuSystemTask.cc \
 EmuTiming.cc \
 EmuVideo.cc \
 EmuVideoLayer.cc \
+EnergyMeter.cc \
+FrameTimeTelemetry.cc \
 InputDeviceConfig.cc \
 InputDeviceData.cc \
+InputReplay.cc \
 KeyConfig.cc \
 OutputTimingManager.cc \
 pathUtils.cc \
+RamSearch.cc \
 RecentContent.cc \
 RewindManager.cc \
+RunAheadManager.cc \
+ScreenshotWriter.cc \
+StageProfiler.cc \
+StateSaveWorker.cc \
+ThermalGovernor.cc \
 ToggleInput.cc \
 TurboInput.cc \
 VideoImageEffect.cc \
@@ -42,6 +56,7 @@ gui/LoadProgressView.cc \
 gui/MainMenuView.cc \
 gui/PlaceVControlsView.cc \
 gui/PlaceVideoView.cc \
+gui/RamSearchView.cc \
 gui/RecentContentView.cc \
 gui/StateSlotView.cc \
 gui/SystemActionsView.cc \
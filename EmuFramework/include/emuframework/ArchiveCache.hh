@@ -0,0 +1,62 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/base/ApplicationContext.hh>
+#include <imagine/io/IO.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <cstdint>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+// On-disk LRU cache of content decompressed from archives, so loading the same archive
+// again maps the extracted file instead of inflating it. Entries are keyed by the archive's
+// location, size, and modification time, and the least recently used ones are
+// deleted to stay under the size cap.
+class ArchiveCache
+{
+public:
+	static constexpr uint16_t defaultSizeCapMiB = 256;
+
+	ArchiveCache(ApplicationContext ctx): appCtx{ctx} {}
+	// returns 0 if the archive can't be identified reliably or caching is off
+	uint64_t key(CStringView archivePath, size_t archiveSize) const;
+	// returns the mapped content and sets its name in the archive if it's cached
+	IO open(uint64_t key, FS::FileString &entryName);
+	// extracts the entry into the cache and returns it mapped, or an empty IO if it isn't cached.
+	// A failed write after reading from the entry also resets it, so the archive must be re-opened.
+	IO store(uint64_t key, std::string_view entryName, IO &entry);
+	void setSizeCap(uint16_t mib);
+	uint16_t sizeCap() const { return sizeCapMiB; }
+	size_t size();
+	void clear();
+	bool readConfig(MapIO &, unsigned key);
+	void writeConfig(FileIO &) const;
+
+private:
+	ApplicationContext appCtx;
+	FS::PathString dirPath;
+	uint16_t sizeCapMiB{defaultSizeCapMiB};
+
+	const FS::PathString &directory();
+	FS::PathString entryPath(uint64_t key, std::string_view ext);
+	void evict(size_t bytesNeeded);
+};
+
+}
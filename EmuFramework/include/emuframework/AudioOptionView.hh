@@ -42,6 +42,8 @@ protected:
 	TextMenuItem soundBuffersItem[7];
 	MultiChoiceMenuItem soundBuffers;
 	BoolMenuItem addSoundBuffersOnUnderrun;
+	BoolMenuItem workerThread;
+	BoolMenuItem rateControl;
 	StaticArrayList<TextMenuItem, 5> audioRateItem;
 	MultiChoiceMenuItem audioRate;
 	ConditionalMember<IG::Audio::Manager::HAS_SOLO_MIX, BoolMenuItem> audioSoloMix;
@@ -0,0 +1,59 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/audio/Format.hh>
+#include <array>
+#include <vector>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+// Streaming band-limited resampler using a Kaiser windowed sinc filter. Filter phases
+// are linearly interpolated so any ratio is exact and it can change on every call
+// without clicks, which lets the output rate be nudged to track buffer fill.
+class AudioResampler
+{
+public:
+	static constexpr size_t taps = 32;
+	static constexpr size_t phases = 128;
+
+	AudioResampler();
+	// ratio is output frames per input frame, returns the frames written to dest.
+	// Input that can't be processed yet is kept for the next call.
+	size_t resample(void *dest, size_t destFrames, const void *src, size_t srcFrames, Audio::Format, double ratio);
+	// the most frames the next resample() call with these parameters can produce
+	size_t maxOutputFrames(size_t srcFrames, double ratio) const;
+	// drop any pending input and history
+	void reset();
+
+private:
+	using Phase = std::array<float, taps>;
+
+	std::vector<Phase> filter; // phases + 1 entries
+	std::vector<Phase> filterDelta; // difference to the next phase for interpolation
+	std::array<std::vector<float>, 2> input; // de-interleaved pending frames, including filter history
+	double pos{}; // position of the next output frame relative to the start of input
+	float cutoff{};
+	Audio::Format format{};
+
+	void makeFilter(float cutoff);
+	void appendInput(const void *src, size_t srcFrames);
+};
+
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	EmuFramework is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	EmuFramework is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/base/Timer.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/util/container/ArrayList.hh>
+#include <cstdint>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+class EmuApp;
+
+// Runs the loaded content for a few seconds under each candidate frame clock & pipelining
+// setting, then with fewer audio buffers, measuring them through the frame time telemetry.
+// Keeps the configuration with the lowest frame start to present time that didn't miss
+// frames or underrun audio.
+class AutoTuner
+{
+public:
+	AutoTuner(EmuApp &);
+	// sets up the first candidate, emulation must be shown afterwards to begin measuring
+	bool start();
+	// restores the settings from before start(), call with emulation paused
+	void cancel();
+	bool isRunning() const { return candidates.size(); }
+
+	struct Config
+	{
+		FrameTimeSource frameTimeSource{};
+		bool pipelineFrames{};
+		int8_t soundBuffers{};
+	};
+
+private:
+	struct Result
+	{
+		Config config{};
+		SteadyClockTime latency{};
+	};
+
+	EmuApp &app;
+	Timer stepTimer;
+	StaticArrayList<Config, 8> candidates;
+	Config originalConfig{};
+	Result best{};
+	uint32_t underrunsAtStart{};
+	uint8_t candidateIdx{};
+	uint8_t frameCandidates{}; // the rest lower the audio buffers of the best one
+	bool foundStable{};
+	bool lastStable{};
+	bool measuring{};
+	bool telemetryWasEnabled{};
+
+	Config currentConfig() const;
+	void apply(Config);
+	void step();
+	void evaluate();
+	void restartWith(Config);
+	void finish();
+};
+
+}
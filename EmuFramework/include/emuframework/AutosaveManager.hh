@@ -23,6 +23,7 @@
 #include <string>
 #include <string_view>
 #include <functional>
+#include <optional>
 
 namespace EmuEx
 {
@@ -54,12 +55,7 @@ public:
 	bool load(LoadAutosaveMode m) { return load(AutosaveActionSource::Auto, m); }
 	bool load(AutosaveActionSource src = AutosaveActionSource::Auto) { return load(src, LoadAutosaveMode::Normal); }
 	bool setSlot(std::string_view name);
-	void resetSlot(std::string_view name = "")
-	{
-		autoSaveSlot = name;
-		saveTimer.cancel();
-		stateIO = {};
-	}
+	void resetSlot(std::string_view name = "");
 	bool renameSlot(std::string_view name, std::string_view newName);
 	bool deleteSlot(std::string_view name);
 	std::string_view slotName() const { return autoSaveSlot; }
@@ -83,14 +79,19 @@ private:
 	EmuApp &app;
 	std::string autoSaveSlot;
 	FileIO stateIO;
+	std::optional<uint32_t> lastStateHash; // of the state sections when the autosave state was last written
 
+	bool stateUnchangedSinceSave();
 	bool saveState();
+	bool saveMappedState();
 	bool loadState();
+	void reopenStateIO();
 
 public:
 	PausableTimer<Minutes> saveTimer;
 	AutosaveLaunchMode autosaveLaunchMode{};
 	bool saveOnlyBackupMemory{};
+	bool useMappedState{};
 };
 
 }
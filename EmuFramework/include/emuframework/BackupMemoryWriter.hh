@@ -0,0 +1,73 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/io/FileIO.hh>
+#include <imagine/util/memory/DynArray.hh>
+#include <imagine/thread/Thread.hh>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <span>
+#include <vector>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+// Writes snapshots of backup memory on a background thread so a flush only costs a copy
+// on the emulation thread. A snapshot replaces any pending one for the same file region,
+// and all files written in a batch are synced once after the batch.
+class BackupMemoryWriter
+{
+public:
+	BackupMemoryWriter() = default;
+	// syncFiles can be false for scratch files that don't need to survive a crash
+	explicit BackupMemoryWriter(bool syncFiles): syncFiles{syncFiles} {}
+	~BackupMemoryWriter() { stop(); }
+	// copies data to write at offset, the file must stay open until wait() returns
+	void push(FileIO &, std::span<const uint8_t> data, size_t offset = 0);
+	void wait();
+	void stop();
+	// applies to the worker thread now if it's running, otherwise once it starts
+	void setCPUAffinityMask(CPUMask);
+
+private:
+	struct Job
+	{
+		FileIO *file{};
+		DynArray<uint8_t> data;
+		size_t size{};
+		size_t offset{};
+	};
+
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable jobCond;
+	std::condition_variable idleCond;
+	std::vector<Job> jobs;
+	std::vector<DynArray<uint8_t>> freeBuffers;
+	ThreadId threadId{};
+	CPUMask cpuMask{};
+	bool isWorking{};
+	bool quit{};
+	bool syncFiles{true};
+
+	void run();
+};
+
+}
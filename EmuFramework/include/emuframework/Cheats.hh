@@ -34,8 +34,11 @@ public:
 
 protected:
 	TextMenuItem edit;
+	TextMenuItem ramSearch;
 	std::vector<BoolMenuItem> cheat;
 
+	size_t fixedItems() const { return system().hasStateSections() ? 2 : 1; }
+
 	virtual void loadCheatItems() = 0;
 };
 
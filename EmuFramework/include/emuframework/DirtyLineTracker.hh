@@ -0,0 +1,54 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace EmuEx
+{
+
+// Lines [start, end) of a frame that differ from the previous one, an end of -1 covers the whole frame
+struct DirtyLineRange
+{
+	int16_t start{};
+	int16_t end{-1};
+
+	constexpr bool isWholeFrame() const { return end == -1; }
+	constexpr bool isEmpty() const { return start == end; }
+};
+
+// Keeps a copy of each line's source data from the last rendered frame so a core's scanline
+// renderer can report which lines changed. The data compared should fully determine the
+// output pixels, such as the line's final palette colors before conversion to the video format.
+class DirtyLineTracker
+{
+public:
+	DirtyLineTracker(int lines, size_t lineBytes);
+	void updateLine(int line, const void *data);
+	// returns the range changed since the last call
+	DirtyLineRange takeRange();
+
+private:
+	std::vector<uint8_t> lastFrame;
+	size_t lineBytes{};
+	int16_t lines{};
+	int16_t dirtyStart;
+	int16_t dirtyEnd{};
+};
+
+}
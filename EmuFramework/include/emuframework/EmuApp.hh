@@ -24,9 +24,19 @@
 #include <emuframework/EmuInput.hh>
 #include <emuframework/EmuOptions.hh>
 #include <emuframework/AutosaveManager.hh>
+#include <emuframework/ArchiveCache.hh>
 #include <emuframework/OutputTimingManager.hh>
 #include <emuframework/RecentContent.hh>
 #include <emuframework/RewindManager.hh>
+#include <emuframework/RunAheadManager.hh>
+#include <emuframework/FrameTimeTelemetry.hh>
+#include <emuframework/InputReplay.hh>
+#include <emuframework/RamSearch.hh>
+#include <emuframework/StateSaveWorker.hh>
+#include <emuframework/ScreenshotWriter.hh>
+#include <emuframework/BackupMemoryWriter.hh>
+#include <emuframework/ThermalGovernor.hh>
+#include <emuframework/AutoTuner.hh>
 #include <imagine/input/inputDefs.hh>
 #include <imagine/gui/ViewManager.hh>
 #include <imagine/gui/ToastView.hh>
@@ -40,6 +50,7 @@
 #include <imagine/data-type/image/PixmapReader.hh>
 #include <imagine/data-type/image/PixmapWriter.hh>
 #include <imagine/bluetooth/BluetoothAdapter.hh>
+#include <imagine/thread/JobPool.hh>
 #include <imagine/font/Font.hh>
 #include <imagine/util/used.hh>
 #include <imagine/util/enum.hh>
@@ -156,6 +167,10 @@ public:
 	static bool allowsTurboModifier(KeyCode);
 
 	void mainInitCommon(IG::ApplicationInitParams, IG::ApplicationContext);
+	// loads content and runs the given frames without video/audio output, then prints timing results,
+	// optionally starting from a state file and writing the final state to another
+	int runBenchmark(CStringView path, int frames, const char *loadStatePath = {}, const char *saveStatePath = {});
+	int runReplay(CStringView path, CStringView replayPath, const char *saveStatePath = {});
 	static void onCustomizeNavView(NavView &v);
 	void createSystemWithMedia(IG::IO, CStringView path, std::string_view displayName,
 		const Input::Event &, EmuSystemCreateParams, ViewAttachParams, CreateSystemCompleteDelegate);
@@ -183,10 +198,13 @@ public:
 	FS::PathString contentSaveFilePath(std::string_view ext) const;
 	void setupStaticBackupMemoryFile(FileIO &, std::string_view ext, size_t staticSize, uint8_t initValue = 0) const;
 	void readState(std::span<uint8_t> buff);
+	// stops input recording and writes it out, reason names the action that interrupted it, if any
+	void stopInputRecording(std::string_view reason = {});
 	size_t writeState(std::span<uint8_t> buff, SaveStateFlags = {});
 	DynArray<uint8_t> saveState();
-	bool saveState(CStringView path);
-	bool saveStateWithSlot(int slot);
+	bool saveState(CStringView path, bool notify = false);
+	bool saveStateWithSlot(int slot, bool notify = false);
+	StateSaveWorker::Job makeStateSaveJob();
 	bool loadState(CStringView path);
 	bool loadStateWithSlot(int slot);
 	bool shouldOverwriteExistingState() const;
@@ -225,6 +243,7 @@ public:
 	void setCPUNeedsLowLatency(IG::ApplicationContext, bool needed);
 	bool advanceFrames(FrameParams, EmuSystemTask *);
 	void runFrames(EmuSystemTaskContext, EmuVideo *, EmuAudio *, int frames);
+	void runFrame(EmuSystemTaskContext, EmuVideo *, EmuAudio *);
 	void skipFrames(EmuSystemTaskContext, int frames, EmuAudio *);
 	bool skipForwardFrames(EmuSystemTaskContext, int frames);
 	void notifyWindowPresented();
@@ -279,6 +298,8 @@ public:
 	{
 		return emuWindow().evalFrameTimeSource(frameTimeSource);
 	};
+	// only when the timer source is chosen explicitly since it's also the default on screens without timestamps
+	bool usesVariableRefresh() const { return frameTimeSource == FrameTimeSource::Timer; }
 
 	// System Options
 	bool setAltSpeed(AltSpeedMode mode, int16_t speed);
@@ -287,6 +308,11 @@ public:
 	void setCPUAffinity(int cpuNumber, bool on);
 	bool cpuAffinity(int cpuNumber) const;
 	void applyCPUAffinity(bool active);
+	// reads the system's game mode, battery mode drops the image effect and lets the CPU idle,
+	// performance mode forces sustained performance and skips no frames predictively
+	void applyGameMode(IG::ApplicationContext);
+	// shared worker threads for per-frame jobs, started on first use and part of the frame thread group
+	JobPool &jobPool();
 
 	// GUI Options
 	void setIdleDisplayPowerSave(bool on);
@@ -341,21 +367,37 @@ public:
 	InputManager inputManager;
 	OutputTimingManager outputTimingManager;
 	RewindManager rewindManager{*this};
+	ArchiveCache archiveCache;
+	RunAheadManager runAheadManager;
+	StateSaveWorker stateSaveWorker{*this};
+	BackupMemoryWriter backupMemoryWriter;
+	ThermalGovernor thermalGovernor{*this};
+	AutoTuner autoTuner{*this};
 	ConditionalMember<enableFrameTimeStats, FrameTimeStats> frameTimeStats;
+	FrameTimeTelemetry frameTimeTelemetry;
+	InputReplay inputReplay;
+	RamSearch ramSearch;
 	[[no_unique_address]] IG::VibrationManager vibrationManager;
 protected:
 	EmuSystemTask emuSystemTask{*this};
 	mutable Gfx::Texture assetBuffImg[wise_enum::size<AssetFileID>];
 	int savedAdvancedFrames{};
+	MemoryCharge<MemoryCategory::guest> guestMemoryCharge; // the system's state sections, mostly emulated RAM
 	[[no_unique_address]] IG::Data::PixmapReader pixmapReader;
 	[[no_unique_address]] IG::Data::PixmapWriter pixmapWriter;
 	[[no_unique_address]] PerformanceHintManager perfHintManager;
 	[[no_unique_address]] PerformanceHintSession perfHintSession;
+	std::atomic<SteadyClockTimePoint> frameWorkStartTime{}; // when the emulation thread began the pending frame
 	ConditionalMember<MOGA_INPUT, std::unique_ptr<Input::MogaManager>> mogaManagerPtr;
+	std::unique_ptr<JobPool> jobPoolPtr;
+	bool cpuAffinityActive{};
+	GameMode gameMode{}; // last mode read from the system's game settings
 	Gfx::DrawableConfig windowDrawableConf;
 	ConditionalMember<Config::TRANSLUCENT_SYSTEM_UI, bool> layoutBehindSystemUI{};
 	bool enableBlankFrameInsertion{};
+	SteadyClockTimePoint startupTime{}; // cleared after the first frame is drawn
 public:
+	ScreenshotWriter screenshotWriter{*this}; // after pixmapWriter so it's destroyed first
 	BluetoothAdapter bluetoothAdapter;
 	RecentContent recentContent;
 	FS::PathString contentSearchPath;
@@ -365,6 +407,7 @@ public:
 	ConditionalProperty<Config::cpuAffinity, CPUMask, CFGKEY_CPU_AFFINITY_MASK> cpuAffinityMask;
 	Property<int16_t, CFGKEY_FAST_MODE_SPEED,
 		PropertyDesc<int16_t>{.defaultValue = 800, .isValid = isValidFastSpeed}> fastModeSpeed;
+	Property<bool, CFGKEY_FAST_MODE_MAX_THROUGHPUT> fastModeMaxThroughput;
 	Property<int16_t, CFGKEY_SLOW_MODE_SPEED,
 		PropertyDesc<int16_t>{.defaultValue = 50, .isValid = isValidSlowSpeed}> slowModeSpeed;
 	Property<int16_t, CFGKEY_FONT_Y_SIZE, PropertyDesc<int16_t>{
@@ -372,6 +415,8 @@ public:
 		.mutableDefault = true,
 		.isValid = isValidFontSize}> fontSize;
 	Property<int8_t, CFGKEY_FRAME_INTERVAL, PropertyDesc<int8_t>{.defaultValue = 1, .isValid = isValidFrameInterval}> frameInterval;
+	Property<bool, CFGKEY_PREDICTIVE_FRAME_SKIP> predictiveFrameSkip;
+	Property<bool, CFGKEY_BATCH_FRAME_INTERVAL> batchFrameInterval;
 	ConditionalProperty<Config::envIsAndroid, bool, CFGKEY_NOTIFICATION_ICON,
 		PropertyDesc<bool>{.defaultValue = true, .mutableDefault = true}> showsNotificationIcon;
 	ConditionalProperty<CAN_HIDE_TITLE_BAR, bool, CFGKEY_TITLE_BAR,
@@ -395,6 +440,8 @@ public:
 	Property<Rotation, CFGKEY_CONTENT_ROTATION,
 		PropertyDesc<Rotation>{.defaultValue = Rotation::ANY, .isValid = enumIsValidUpToLast}> contentRotation;
 	Property<bool, CFGKEY_IDLE_DISPLAY_POWER_SAVE> idleDisplayPowerSave;
+	Property<StateCompression, CFGKEY_STATE_COMPRESSION,
+		PropertyDesc<StateCompression>{.isValid = enumIsValidUpToLast}> stateCompression;
 	Property<bool, CFGKEY_SHOW_HIDDEN_FILES> showHiddenFilesInPicker;
 	Property<bool, CFGKEY_CONFIRM_OVERWRITE_STATE, PropertyDesc<bool>{.defaultValue = true}> confirmOverwriteState;
 	Property<bool, CFGKEY_SYSTEM_ACTIONS_IS_DEFAULT_MENU, PropertyDesc<bool>{.defaultValue = true}> systemActionsIsDefaultMenu;
@@ -415,6 +462,10 @@ public:
 		PropertyDesc<Gfx::PresentMode>{.defaultValue = Gfx::PresentMode::Auto, .isValid = enumIsValidUpToLast}> presentMode;
 	ConditionalMember<Gfx::supportsPresentationTime, PresentationTimeMode> presentationTimeMode{PresentationTimeMode::basic};
 	Property<bool, CFGKEY_BLANK_FRAME_INSERTION> allowBlankFrameInsertion;
+	Property<bool, CFGKEY_PACED_FRAME_TIMING> pacedFrameTiming;
+	Property<bool, CFGKEY_PIPELINE_FRAMES> pipelineFrames;
+	Property<bool, CFGKEY_GPU_PALETTE_CONVERSION, PropertyDesc<bool>{.defaultValue = true}> gpuPaletteConversion;
+	Property<bool, CFGKEY_PARTIAL_FRAME_UPLOAD, PropertyDesc<bool>{.defaultValue = true}> partialFrameUpload;
 
 protected:
 	struct ConfigParams
@@ -423,6 +474,8 @@ protected:
 	};
 
 	void onMainWindowCreated(ViewAttachParams, const Input::Event &);
+	void openContentOnLaunch(CStringView path);
+	void logStartupPhase(std::string_view phase) const;
 	ConfigParams loadConfigFile(IG::ApplicationContext);
 	void saveConfigFile(IG::ApplicationContext);
 	void saveConfigFile(FileIO &);
@@ -15,13 +15,21 @@
 	You should have received a copy of the GNU General Public License
 	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
 
+#include <emuframework/AudioResampler.hh>
 #include <imagine/audio/OutputStream.hh>
 #include <imagine/audio/Manager.hh>
 #include <imagine/time/Time.hh>
 #include <imagine/util/container/RingBuffer.hh>
+#include <imagine/util/memory/MemoryAccounting.hh>
 #include <imagine/util/used.hh>
+#include <imagine/util/DelegateFunc.hh>
+#include <imagine/thread/Thread.hh>
+#include <algorithm>
+#include <array>
+#include <concepts>
 #include <memory>
 #include <atomic>
+#include <thread>
 
 namespace IG
 {
@@ -63,6 +71,39 @@ public:
 	void close();
 	void flush();
 	void writeFrames(const void *samples, size_t framesToWrite);
+	// Returns where to write up to the given frames in the output format, or null if they need processing
+	// first and should go through writeFrames(), endDirectWrite() then commits the frames actually written
+	void *beginDirectWrite(size_t frames);
+	void endDirectWrite(size_t frames);
+
+	// Writes up to maxFrames produced by fill(void *dest, size_t frames), which returns the frames
+	// it wrote. They go straight into the output or worker buffer when possible, otherwise through
+	// a temporary buffer and writeFrames().
+	size_t writeFrames(size_t maxFrames, std::invocable<void*, size_t> auto &&fill)
+	{
+		if(!maxFrames) [[unlikely]]
+			return 0;
+		if(auto dest = beginDirectWrite(maxFrames)) [[likely]]
+		{
+			size_t frames = fill(dest, maxFrames);
+			endDirectWrite(frames);
+			return frames;
+		}
+		std::array<uint8_t, 4096> buff;
+		const size_t blockFrames = format().bytesToFrames(buff.size());
+		size_t written{};
+		while(written < maxFrames)
+		{
+			size_t requested = std::min(blockFrames, maxFrames - written);
+			size_t frames = fill(static_cast<void*>(buff.data()), requested);
+			writeFrames(buff.data(), frames);
+			written += frames;
+			if(frames < requested)
+				break;
+		}
+		return written;
+	}
+
 	void setRate(int rate);
 	int rate() const { return rate_; }
 	int maxRate() const { return defaultRate; }
@@ -77,6 +118,12 @@ public:
 	bool isEnabled() const;
 	void setEnabledDuringAltSpeed(bool on);
 	bool isEnabledDuringAltSpeed() const;
+	void setReverseWrites(bool on) { reverseWrites = on; }
+	// applies to the worker thread now if it's running, otherwise once it starts
+	void setWorkerCPUAffinityMask(CPUMask);
+	ThreadId workerId() const { return workerThreadId; }
+	// times the output ran out of samples since the app started
+	uint32_t underrunCount() const { return underruns.load(std::memory_order_relaxed); }
 	IG::Audio::Format format() const;
 	explicit operator bool() const { return bool(rBuff.capacity()); }
 	void writeConfig(FileIO &) const;
@@ -84,9 +131,29 @@ public:
 
 	IG::Audio::Manager manager;
 protected:
+	using AudioBuffer = RingBuffer<uint8_t, RingBufferConf{.mirrored = true}>;
+
+	struct DirectWrite
+	{
+		AudioBuffer::RWSpan span{{}, {}};
+		bool toWorker{};
+	};
+
 	IG::Audio::OutputStream audioStream;
-	RingBuffer<uint8_t, RingBufferConf{.mirrored = true}> rBuff;
+	AudioBuffer rBuff;
+	AudioBuffer workerBuff;
+	DirectWrite directWrite;
+	std::thread workerThread;
+	std::atomic<ThreadId> workerThreadId{};
+	std::atomic<CPUMask> workerCPUMask{};
+	std::atomic_uint32_t underruns{};
+	MemoryCharge<MemoryCategory::audio> bufferCharge;
+	AudioResampler resampler;
 	SteadyClockTimePoint lastUnderrunTime{};
+	SteadyClockTimePoint rateControlWindowStart{};
+	double rateControlFill{};
+	size_t rateControlMinFill{};
+	size_t rateControlMaxFillBytes{};
 	double speedMultiplier{1.};
 	size_t targetBufferFillBytes{};
 	size_t bufferIncrementBytes{};
@@ -99,18 +166,34 @@ protected:
 	AudioFlags flags{defaultAudioFlags};
 	ConditionalMember<IG::Audio::Config::MULTIPLE_SYSTEM_APIS, IG::Audio::Api> audioAPI{};
 	bool addSoundBuffersOnUnderrun{};
+	bool reverseWrites{};
 public:
 	bool addSoundBuffersOnUnderrunSetting{};
+	bool useWorkerThread{}; // takes effect on next start()
+	bool dynamicRateControl{};
 	int8_t defaultSoundBuffers{3};
 	int8_t soundBuffers{defaultSoundBuffers};
+	// sees every sample written by the system, even without an open output stream
+	DelegateFunc<void(std::span<const uint8_t>)> onWriteFrames;
 
 	size_t framesFree() const;
 	size_t framesWritten() const;
 	size_t framesCapacity() const;
 	bool shouldStartAudioWrites(size_t bytesToWrite = 0) const;
 	void resizeAudioBuffer(size_t targetBufferFillBytes);
+	void updateBufferCharge() { bufferCharge.set(rBuff.capacity() + workerBuff.capacity()); }
 	void updateVolume();
 	void updateAddBuffersOnUnderrun();
+
+protected:
+	double updateRateControl(double speed);
+	void resetRateControl();
+	void processFrames(const void *samples, size_t framesToWrite, IG::Audio::Format, double speed, bool reverse);
+	void handleUnderrun(IG::Audio::Format, double speed);
+	void startWritesIfFilled(size_t bytesWritten, IG::Audio::Format);
+	void startWorker();
+	void stopWorker();
+	void runWorker();
 };
 
 }
@@ -83,7 +83,18 @@ enum { CFGKEY_SOUND = 0, CFGKEY_TOUCH_CONTROL_DISPLAY = 1,
 	CFGKEY_INPUT_KEY_CONFIGS_V2 = 114, CFGKEY_VCONTROLLER_HIGHLIGHT_PUSHED_BUTTONS = 115,
 	CFGKEY_RECENT_CONTENT_V2 = 116, CFGKEY_MAX_RECENT_CONTENT = 117,
 	CFGKEY_REWIND_STATES = 118, CFGKEY_REWIND_TIMER_SECS = 119,
-	CFGKEY_FRAME_CLOCK = 120,
+	CFGKEY_FRAME_CLOCK = 120, CFGKEY_REWIND_KEYFRAME_INTERVAL = 121,
+	CFGKEY_REWIND_FRAME_INTERVAL = 122, CFGKEY_REWIND_CONTINUOUS = 123,
+	CFGKEY_REWIND_CONTINUOUS_INTERVAL = 124, CFGKEY_REWIND_REVERSE_AUDIO = 125,
+	CFGKEY_STATE_COMPRESSION = 126, CFGKEY_AUTOSAVE_MAPPED_STATE = 127,
+	CFGKEY_RUN_AHEAD_FRAMES = 128, CFGKEY_RUN_AHEAD_SECOND_INSTANCE = 129,
+	CFGKEY_REWIND_MEMORY_BUDGET = 130, CFGKEY_FRAME_TIME_TELEMETRY = 131,
+	CFGKEY_PREDICTIVE_FRAME_SKIP = 132, CFGKEY_PACED_FRAME_TIMING = 133,
+	CFGKEY_AUDIO_WORKER_THREAD = 134, CFGKEY_AUDIO_RATE_CONTROL = 135,
+	CFGKEY_GPU_PALETTE_CONVERSION = 136, CFGKEY_PARTIAL_FRAME_UPLOAD = 137,
+	CFGKEY_ARCHIVE_CACHE_SIZE = 138, CFGKEY_THERMAL_GOVERNOR = 139,
+	CFGKEY_PIPELINE_FRAMES = 140, CFGKEY_FAST_MODE_MAX_THROUGHPUT = 141,
+	CFGKEY_BATCH_FRAME_INTERVAL = 142, CFGKEY_REWIND_DISK_SPILL = 143,
 	// 256+ is reserved
 };
 
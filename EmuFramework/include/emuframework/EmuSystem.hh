@@ -137,9 +137,27 @@ using FrameTime = Nanoseconds;
 
 constexpr const char *optionUserPathContentToken = ":CONTENT:";
 
+WISE_ENUM_CLASS((StateCompression, uint8_t),
+	Default,
+	Fast,
+	Small
+);
+
 struct SaveStateFlags
 {
 	uint8_t uncompressed:1{};
+	// only read back by this process with unchanged core settings, allows a core's raw memory layout
+	uint8_t sessionOnly:1{};
+	StateCompression compression{};
+};
+
+// A named block of live emulator memory that's part of the save state,
+// lets the framework compare or copy state regions without serializing
+struct StateSection
+{
+	const char *name{};
+	std::span<uint8_t> data;
+	uint32_t address{}; // start of data in the emulated CPU's address space, if it's mapped there
 };
 
 class EmuSystem
@@ -176,6 +194,7 @@ public:
 
 	using OnLoadProgressDelegate = IG::DelegateFunc<bool(int pos, int max, const char *label)>;
 	using NameFilterFunc = bool(*)(std::string_view name);
+	using StateSectionDelegate = IG::DelegateFunc<void(StateSection)>;
 	using BackupMemoryDirtyFlags = uint8_t;
 	enum class ResetMode: uint8_t { HARD, SOFT };
 
@@ -186,6 +205,7 @@ public:
 	static bool hasBundledGames;
 	static bool hasPALVideoSystem;
 	static bool canRenderRGBA8888;
+	static bool canRenderPaletteIndices;
 	static bool hasResetModes;
 	static bool handlesArchiveFiles;
 	static bool handlesGenericIO;
@@ -194,10 +214,12 @@ public:
 	static int forcedSoundRate;
 	static IG::Audio::SampleFormat audioSampleFormat;
 	static NameFilterFunc defaultFsFilter;
+	static NameFilterFunc uncachedArchiveEntryFilter; // entries needing the rest of their archive, like CD images
 	static const char *creditsViewStr;
 	static F2Size validFrameRateRange;
 	static bool hasRectangularPixels;
 	static bool stateSizeChangesAtRuntime;
+	static bool hasGzipStates; // compressed states from writeState() are gzip data of the uncompressed state
 
 	EmuSystem(IG::ApplicationContext ctx): appCtx{ctx} {}
 
@@ -245,6 +267,12 @@ public:
 	FS::FileString contentDisplayNameForPath(CStringView path) const;
 	IG::Rotation contentRotation() const;
 	void addThreadGroupIds(std::vector<ThreadId> &) const;
+	void forEachStateSection(StateSectionDelegate);
+	bool hasStateSections() const;
+	// Syncs a secondary emulator instance to the current state and runs it ahead the given frames,
+	// rendering only the last one, so the primary instance's audio/video state is never rolled back
+	void runAheadFrames(EmuSystemTaskContext, EmuVideo &, int frames);
+	bool hasRunAheadInstance() const;
 
 	ApplicationContext appContext() const { return appCtx; }
 	bool isActive() const { return state == State::ACTIVE; }
@@ -254,6 +282,8 @@ public:
 	void saveState(CStringView uri);
 	DynArray<uint8_t> saveState();
 	DynArray<uint8_t> uncompressGzipState(std::span<uint8_t> buff, size_t expectedSize = 0);
+	// defaultLevel is the zlib level used for StateCompression::Default
+	static size_t compressState(std::span<uint8_t> dest, std::span<const uint8_t> src, SaveStateFlags, int defaultLevel = -1);
 	bool stateExists(int slot) const;
 	static std::string_view stateSlotName(int slot);
 	std::string_view stateSlotName() { return stateSlotName(stateSlot()); }
@@ -360,7 +390,8 @@ public:
 	static double audioMixRate(int outputRate, double inputFrameRate, FrameTime outputFrameTime);
 	double audioMixRate(int outputRate, FrameTime outputFrameTime) const { return audioMixRate(outputRate, frameRate(), outputFrameTime); }
 	void configFrameTime(int outputRate, FrameTime outputFrameTime);
-	SteadyClockTime benchmark(EmuVideo &video);
+	// pass a null video to time frames as they run when skipped
+	SteadyClockTime benchmark(EmuVideo *video);
 	bool hasContent() const;
 	void resetFrameTime();
 	void pause(EmuApp &);
@@ -382,7 +413,8 @@ protected:
 	State state{};
 	bool sessionOptionsSet{};
 	BackupMemoryDirtyFlags backupMemoryDirtyFlags{};
-	int8_t backupMemoryCounter{};
+	int8_t backupMemoryCounter{}; // frames to wait after the last write before flushing
+	int16_t backupMemoryMaxCounter{}; // frames to wait after the first unflushed write
 	FS::PathString contentDirectory_; // full directory path of content on disk, if any
 	FS::PathString contentLocation_; // full path or URI to content
 	FS::FileString contentFileName_; // name + extension of content, inside archive if any
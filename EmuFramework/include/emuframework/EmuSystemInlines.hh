@@ -17,6 +17,7 @@
 
 #include <emuframework/EmuSystem.hh>
 #include <emuframework/EmuVideo.hh>
+#include <emuframework/StageProfiler.hh>
 #include <main/MainSystem.hh>
 #include <imagine/io/IO.hh>
 
@@ -196,6 +197,7 @@ void EmuSystem::closeSystem()
 
 void EmuSystem::runFrame(EmuSystemTaskContext task, EmuVideo *video, EmuAudio *audio)
 {
+	ScopedStageTimer stageTimer{ProfileStage::cpu};
 	static_cast<MainSystem*>(this)->runFrame(task, video, audio);
 }
 
@@ -280,4 +282,26 @@ void EmuSystem::addThreadGroupIds(std::vector<ThreadId> &ids) const
 		static_cast<const MainSystem*>(this)->addThreadGroupIds(ids);
 }
 
+void EmuSystem::forEachStateSection(StateSectionDelegate del)
+{
+	if(&MainSystem::forEachStateSection != &EmuSystem::forEachStateSection)
+		static_cast<MainSystem*>(this)->forEachStateSection(del);
+}
+
+bool EmuSystem::hasStateSections() const
+{
+	return &MainSystem::forEachStateSection != &EmuSystem::forEachStateSection;
+}
+
+void EmuSystem::runAheadFrames(EmuSystemTaskContext taskCtx, EmuVideo &video, int frames)
+{
+	if(&MainSystem::runAheadFrames != &EmuSystem::runAheadFrames)
+		static_cast<MainSystem*>(this)->runAheadFrames(taskCtx, video, frames);
+}
+
+bool EmuSystem::hasRunAheadInstance() const
+{
+	return &MainSystem::runAheadFrames != &EmuSystem::runAheadFrames;
+}
+
 }
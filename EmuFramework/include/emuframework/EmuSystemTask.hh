@@ -15,10 +15,11 @@
 	You should have received a copy of the GNU General Public License
 	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
 
-#include <imagine/base/MessagePort.hh>
+#include <imagine/base/SPSCMessagePort.hh>
 #include <imagine/thread/Thread.hh>
 #include <imagine/time/Time.hh>
 #include <imagine/util/variant.hh>
+#include <atomic>
 
 namespace EmuEx
 {
@@ -28,6 +29,7 @@ using namespace IG;
 class EmuVideo;
 class EmuAudio;
 class EmuApp;
+struct FrameTimeStats;
 
 class EmuSystemTask
 {
@@ -37,11 +39,10 @@ public:
 		FrameParams params;
 	};
 
-	struct FramePresentedCommand {};
 	struct PauseCommand {};
 	struct ExitCommand {};
 
-	using CommandVariant = std::variant<FrameParamsCommand, FramePresentedCommand, PauseCommand, ExitCommand>;
+	using CommandVariant = std::variant<FrameParamsCommand, PauseCommand, ExitCommand>;
 	class Command: public CommandVariant, public AddVisit
 	{
 	public:
@@ -65,17 +66,25 @@ public:
 	void notifyFramePresented();
 	void sendVideoFormatChangedReply(EmuVideo &);
 	void sendFrameFinishedReply(EmuVideo &);
-	void sendScreenshotReply(bool success);
 	auto threadId() const { return threadId_; }
 
 private:
 	EmuApp &app;
-	MessagePort<CommandMessage> commandPort{"EmuSystemTask Command"};
+	// commands only come from the main thread, frame presentation is signaled
+	// separately since it can come from the renderer thread
+	SPSCMessagePort<CommandMessage> commandPort{"EmuSystemTask Command"};
+	std::atomic_bool framePresented{};
 	std::thread taskThread;
 	ThreadId threadId_{};
 	FrameParams frameParams;
+	uint32_t wakeups{}; // since wakeupSampleTime, for the frame time stats
+	SteadyClockTimePoint wakeupSampleTime{};
+
+	void countWakeup(FrameTimeStats &);
 public:
-	bool framePending{};
+	int8_t pendingFrames{}; // frames submitted for drawing but not yet presented
+	// with 2, the next frame is emulated while the previous one is still being presented
+	int8_t maxPendingFrames{1};
 };
 
 }
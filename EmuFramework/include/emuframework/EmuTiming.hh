@@ -28,6 +28,26 @@ struct EmuFrameTimeInfo
 	SteadyClockTime frameTimeDiff{};
 };
 
+// Decides ahead of time which frames to run without video from a moving average of their
+// measured cost, spreading the skipped frames evenly so the pattern doesn't judder
+class FrameSkipPredictor
+{
+public:
+	static constexpr double targetBudgetFraction = .9;
+	static constexpr double maxSkipRatio = .75; // always show at least 1 in 4 frames
+
+	void addFrameCost(SteadyClockTime cost, bool hadVideo);
+	bool shouldSkipVideo(SteadyClockTime frameBudget);
+	void reset();
+	double skipRatio() const { return skipRatio_; }
+
+protected:
+	double videoFrameCost{};
+	double skippedFrameCost{};
+	double skipRatio_{};
+	double skipAccumulator{};
+};
+
 class EmuTiming
 {
 public:
@@ -35,15 +55,20 @@ public:
 	void setFrameTime(SteadyClockTime time);
 	void reset();
 	SteadyClockTimePoint lastFrameTimestamp() const { return lastFrameTimestamp_; }
+	SteadyClockTime frameTime() const { return timePerVideoFrame; }
 
 protected:
 	SteadyClockTime timePerVideoFrame{};
 	SteadyClockTimePoint startFrameTime{};
 	SteadyClockTimePoint lastFrameTimestamp_{};
+	SteadyClockTime pacedTime{};
 	int64_t lastFrame{};
 	int8_t savedAdvancedFrames{};
 public:
+	FrameSkipPredictor frameSkipPredictor;
 	int8_t exactFrameDivisor{};
+	// count whole screen frames instead of rounding raw timestamps, see advanceFrames()
+	bool usePacedFrames{};
 };
 
 }
@@ -18,8 +18,11 @@
 #include <emuframework/EmuAppHelper.hh>
 #include <emuframework/EmuSystemTask.hh>
 #include <emuframework/EmuSystemTaskContext.hh>
+#include <emuframework/DirtyLineTracker.hh>
 #include <imagine/gfx/PixmapBufferTexture.hh>
 #include <imagine/gfx/SyncFence.hh>
+#include <array>
+#include <span>
 
 namespace EmuEx
 {
@@ -35,12 +38,15 @@ public:
 	EmuVideoImage(EmuSystemTaskContext taskCtx, EmuVideo &vid, Gfx::LockedTextureBuffer texBuff);
 	IG::MutablePixmapView pixmap() const;
 	explicit operator bool() const;
+	// lets the upload skip lines unchanged since the last frame, the whole image is still written
+	void setDirtyLines(DirtyLineRange r) { dirtyLines = r; }
 	void endFrame();
 
 protected:
 	EmuSystemTaskContext taskCtx;
 	EmuVideo *emuVideo{};
 	Gfx::LockedTextureBuffer texBuff;
+	DirtyLineRange dirtyLines;
 };
 
 class EmuVideo : public EmuAppHelper
@@ -62,12 +68,13 @@ public:
 	void startFrameWithFormat(EmuSystemTaskContext, IG::PixmapView pix);
 	void startFrameWithAltFormat(EmuSystemTaskContext, IG::PixmapView pix);
 	void startUnchangedFrame(EmuSystemTaskContext);
-	void finishFrame(EmuSystemTaskContext, Gfx::LockedTextureBuffer texBuff);
+	void finishFrame(EmuSystemTaskContext, Gfx::LockedTextureBuffer texBuff, DirtyLineRange dirtyLines = {});
 	void finishFrame(EmuSystemTaskContext, IG::PixmapView pix);
 	void dispatchFrameFinished() { onFrameFinished(*this); }
 	void clear();
 	void takeGameScreenshot();
 	bool isExternalTexture() const;
+	bool isMultiBuffered() const { return vidImg && !singleBuffered; }
 	Gfx::PixmapBufferTexture &image();
 	Gfx::Renderer &renderer() const;
 	IG::ApplicationContext appContext() const;
@@ -79,25 +86,40 @@ public:
 	bool setRenderPixelFormat(EmuSystem &, IG::PixelFormat, Gfx::ColorSpace);
 	IG::PixelFormat renderPixelFormat() const;
 	IG::PixelFormat internalRenderPixelFormat() const;
+	// With GPU palette conversion the core writes PixelFmtI8 indices and the video layer
+	// looks them up in the palette texture, entries are in PixelDescRGBA8888Native order.
+	// PixelFmtIA88 pairs each index with the previous frame's index for phosphor blending,
+	// using palette entries 256-511 as the decayed colors of the previous frame.
+	bool usesPaletteIndices() const;
+	bool uploadsPartialFrames() const;
+	bool isPaletted() const;
+	bool isPalettedWithPrevFrame() const;
+	void setPalette(std::span<const uint32_t>);
+	const Gfx::Texture &paletteTexture() const { return paletteTex; }
 	static Gfx::TextureSamplerConfig samplerConfigForLinearFilter(bool useLinearFilter);
 	static MutablePixmapView takeInterlacedFields(MutablePixmapView, bool isOddField);
 
 protected:
 	Gfx::RendererTask *rTask{};
 	Gfx::PixmapBufferTexture vidImg;
+	Gfx::Texture paletteTex;
+	std::array<uint32_t, 512> palette{}; // 256x2 texture, 2nd row only used with PixelFmtIA88
 public:
 	FrameFinishedDelegate onFrameFinished;
 	FormatChangedDelegate onFormatChanged;
 protected:
 	IG::PixelFormat renderFmt;
 	Gfx::TextureBufferMode bufferMode{};
+	bool singleBuffered{};
 	bool screenshotNextFrame{};
+	bool needsFullUpload{true}; // texture contents were lost or never written
 	Gfx::ColorSpace colSpace{Gfx::ColorSpace::LINEAR};
 	bool useLinearFilter{true};
 
 	void doScreenshot(EmuSystemTaskContext, IG::PixmapView pix);
 	void postFrameFinished(EmuSystemTaskContext);
 	Gfx::TextureSamplerConfig samplerConfig() const { return samplerConfigForLinearFilter(useLinearFilter); }
+	bool bufferModeUploadsTexture() const;
 
 public:
 	bool isOddField{};
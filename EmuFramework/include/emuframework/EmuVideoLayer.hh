@@ -52,6 +52,9 @@ public:
 	void setEffect(EmuSystem &, ImageEffectId, IG::PixelFormat);
 	ImageEffectId effectId() const { return userEffectId; }
 	void updateEffect(EmuSystem &, IG::PixelFormat);
+	// draws without the user effect while keeping it as the configured one
+	void setEffectSuspended(EmuSystem &, bool suspended, IG::PixelFormat);
+	bool effectSuspended() const { return userEffectSuspended; }
 	void setEffectFormat(IG::PixelFormat);
 	void setLinearFilter(bool on);
 	bool usingLinearFilter() const { return useLinearFilter; }
@@ -81,7 +84,8 @@ public:
 	EmuVideo &video;
 private:
 	VideoImageOverlay vidImgOverlay;
-	IG::StaticArrayList<VideoImageEffect*, 1> effects;
+	IG::StaticArrayList<VideoImageEffect*, 2> effects;
+	VideoImageEffect paletteEffect;
 	VideoImageEffect userEffect;
 	Gfx::ITexQuads quad;
 	Gfx::TextureSpan texture;
@@ -104,17 +108,21 @@ public:
 private:
 	IG::Rotation rotation{};
 	bool useLinearFilter{true};
+	bool userEffectSuspended{};
+	bool paletteEffectUsesPrevFrame{};
 
 	void placeOverlay();
 	void updateEffectImageSize();
 	void buildEffectChain();
 	bool updateConvertColorSpaceEffect();
+	bool updatePaletteEffect();
 	void updateSprite();
 	void updateBrightness();
 	void logOutputFormat();
 	Gfx::Renderer &renderer();
 	Gfx::ColorSpace videoColorSpace(IG::PixelFormat videoFmt) const;
 	Gfx::TextureSamplerConfig samplerConfig() const;
+	ImageEffectId activeEffectId() const { return userEffectSuspended ? ImageEffectId::DIRECT : userEffectId; }
 };
 
 }
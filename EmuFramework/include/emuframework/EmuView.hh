@@ -29,6 +29,7 @@ class EmuInputView;
 class EmuVideoLayer;
 class EmuSystem;
 struct FrameTimeStats;
+struct StageTimes;
 
 class EmuView : public View
 {
@@ -41,6 +42,9 @@ public:
 	bool hasLayer() const { return layer; }
 	void setLayoutInputView(EmuInputView *view) { inputView = view; }
 	void updateFrameTimeStats(FrameTimeStats, SteadyClockTimePoint currentFrameTimestamp);
+	void drawStageTimesText(Gfx::RendererCommands &__restrict__);
+	void drawLatencyProbe(Gfx::RendererCommands &__restrict__);
+	void updateStageTimes(const StageTimes &);
 	void updateAudioStats(int underruns, int overruns, int callbacks, double avgCallbackFrames, int frames);
 	void clearAudioStats();
 	EmuVideoLayer *videoLayer() const { return layer; }
@@ -57,12 +61,15 @@ private:
 		WRect rect{};
 	};
 	ConditionalMember<enableFrameTimeStats, FrameTimeStatsUI> frameTimeStats;
+	FrameTimeStatsUI stageTimes;
+	Gfx::IQuads latencyProbeQuads;
 	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
 	Gfx::Text audioStatsText{};
 	WRect audioStatsRect{};
 	#endif
 
 	void placeFrameTimeStats();
+	void placeStageTimes();
 };
 
 }
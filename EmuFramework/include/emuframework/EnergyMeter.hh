@@ -0,0 +1,65 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	EmuFramework is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	EmuFramework is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/time/Time.hh>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace IG
+{
+class ApplicationContext;
+}
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+struct CPUFreqResidency
+{
+	int policy{};
+	int kHz{};
+	SteadyClockTime time{};
+};
+
+// Estimates energy use by integrating battery power sampled from the thread running frames,
+// along with how long each CPU frequency policy spent at each frequency since the last reset
+class EnergyMeter
+{
+public:
+	static constexpr Milliseconds sampleInterval{250};
+
+	void reset();
+	// cheap unless sampleInterval has passed since the last sample
+	void sample(ApplicationContext, SteadyClockTimePoint);
+	double joules() const { return microjoules.load(std::memory_order_relaxed) / 1e6; }
+	SteadyClockTime measuredTime() const { return SteadyClockTime{measuredTime_.load(std::memory_order_relaxed)}; }
+	double averageWatts() const;
+	bool hasPower() const { return measuredTime().count(); }
+	// time at each frequency since the last reset, empty if cpufreq stats aren't readable
+	std::vector<CPUFreqResidency> cpuFreqResidency() const;
+
+private:
+	std::vector<CPUFreqResidency> freqTimesAtReset;
+	SteadyClockTimePoint lastSampleTime{};
+	int64_t lastMicrowatts{};
+	std::atomic_uint64_t microjoules{};
+	std::atomic<SteadyClockTime::rep> measuredTime_{};
+};
+
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/config.hh>
+#include <emuframework/OutputTimingManager.hh>
+#include <emuframework/EnergyMeter.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/gfx/defs.hh>
+#include <array>
+#include <atomic>
+
+namespace IG
+{
+class MapIO;
+class FileIO;
+class ApplicationContext;
+}
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+// Fixed-width bins of frame stage durations, safe to update from any thread
+class FrameTimeHistogram
+{
+public:
+	static constexpr Microseconds binWidth{100};
+	static constexpr size_t bins = 512; // the last bin also collects any longer durations
+
+	void add(SteadyClockTime);
+	void clear();
+	uint32_t count() const;
+	uint32_t binCount(size_t idx) const { return counts[idx].load(std::memory_order_relaxed); }
+	// upper bound of the bin containing the given fraction of samples
+	Microseconds percentile(double p) const;
+
+private:
+	std::array<std::atomic_uint32_t, bins> counts{};
+};
+
+enum class FrameTimeMetric : uint8_t
+{
+	emulation,
+	submitToPresent,
+	frame,
+	inputToPresent,
+};
+
+constexpr size_t frameTimeMetrics = 4;
+constexpr size_t drawStatCount = 7; // fields of Gfx::DrawStats
+
+// Low overhead frame timing collection usable in release builds,
+// fed from the same events as the debug frame time stats overlay
+class FrameTimeTelemetry
+{
+public:
+	bool isEnabled() const { return enabled; }
+	void setEnabled(bool on);
+	void record(FrameTimeStatEvent, SteadyClockTimePoint);
+	void recordMissedFrameCallback() { if(enabled) missedFrameCallbacks_.fetch_add(1, std::memory_order_relaxed); }
+	// a streamed media read like MSU-1 audio that had to wait on storage
+	void recordStreamUnderrun() { if(enabled) streamUnderruns_.fetch_add(1, std::memory_order_relaxed); }
+	// measures from the input event to the present of the first frame drawn after it
+	void recordInput(SteadyClockTimePoint);
+	bool hasPendingInput() const { return inputTimestamp.load(std::memory_order_relaxed); }
+	// accumulates the renderer's counts for the frame just presented
+	void recordDrawStats(const Gfx::DrawStats &);
+	void recordEnergy(ApplicationContext ctx, SteadyClockTimePoint t) { energyMeter.sample(ctx, t); }
+	const EnergyMeter &energy() const { return energyMeter; }
+	bool showsLatencyProbe() const { return enabled && showLatencyProbe; }
+	void setShowLatencyProbe(bool on) { showLatencyProbe = on; }
+	void clear();
+	const FrameTimeHistogram &histogram(FrameTimeMetric m) const { return histograms[to_underlying(m)]; }
+	uint32_t frames() const { return frames_.load(std::memory_order_relaxed); }
+	uint32_t missedFrameCallbacks() const { return missedFrameCallbacks_.load(std::memory_order_relaxed); }
+	uint32_t streamUnderruns() const { return streamUnderruns_.load(std::memory_order_relaxed); }
+	bool writeCSV(FileIO &) const;
+	bool readConfig(MapIO &, unsigned key);
+	void writeConfig(FileIO &) const;
+	static const char *metricName(FrameTimeMetric);
+
+private:
+	std::array<FrameTimeHistogram, frameTimeMetrics> histograms;
+	std::array<std::atomic<SteadyClockTime::rep>, 7> timestamps{};
+	std::atomic_uint32_t frames_{};
+	std::atomic_uint32_t missedFrameCallbacks_{};
+	std::atomic_uint32_t streamUnderruns_{};
+	std::atomic<SteadyClockTime::rep> inputTimestamp{};
+	std::atomic_uint32_t drawStatFrames{};
+	std::array<std::atomic_uint64_t, drawStatCount> drawStatTotals{};
+	std::array<std::atomic_uint32_t, drawStatCount> drawStatMax{};
+	EnergyMeter energyMeter;
+	bool enabled{};
+	bool showLatencyProbe{}; // flash a test pattern for external measurement, not saved
+
+	SteadyClockTimePoint timestamp(FrameTimeStatEvent e) const
+	{
+		return SteadyClockTimePoint{SteadyClockTime{timestamps[to_underlying(e)].load(std::memory_order_relaxed)}};
+	}
+};
+
+}
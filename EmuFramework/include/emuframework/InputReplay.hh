@@ -0,0 +1,86 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/config.hh>
+#include <emuframework/EmuSystem.hh>
+#include <imagine/util/memory/DynArray.hh>
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace IG
+{
+class FileIO;
+}
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+class EmuApp;
+
+struct ReplayAction
+{
+	uint32_t frame{};
+	uint32_t metaState{};
+	KeyCode code{};
+	uint8_t flags{};
+	Input::Action state{};
+	uint8_t padding{};
+
+	constexpr InputAction inputAction() const { return {code, std::bit_cast<KeyFlags>(flags), state, metaState}; }
+};
+
+static_assert(sizeof(ReplayAction) == 12);
+
+// Records system input actions against a starting save state so the same
+// session can be replayed frame-exactly, e.g. as a regression benchmark
+class InputReplay
+{
+public:
+	// start recording from the current system state
+	void startRecording(EmuSystem &);
+	void stopRecording();
+	bool isRecording() const { return recording.load(std::memory_order_relaxed); }
+	void recordAction(InputAction);
+	void onFramesRun(int frames);
+	// only valid once recording has stopped
+	bool write(FileIO &) const;
+	// replaces any recording in progress
+	void read(FileIO &);
+	// restore the starting state, must be called before playback
+	void rewind(EmuApp &, EmuSystem &);
+	// apply the actions recorded before the given frame
+	void applyActions(EmuApp &, EmuSystem &, uint32_t frame);
+	uint32_t frames() const { return totalFrames; }
+	size_t actions() const { return actionList.size(); }
+	bool hasData() const { return startState.size(); }
+
+private:
+	DynArray<uint8_t> startState;
+	std::vector<ReplayAction> actionList;
+	std::mutex actionMutex;
+	std::atomic_uint32_t frameCount{};
+	uint32_t totalFrames{};
+	size_t nextAction{};
+	std::atomic_bool recording{};
+};
+
+}
@@ -16,7 +16,9 @@
 	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
 
 #include <emuframework/EmuSystem.hh>
+#include <emuframework/ThermalGovernor.hh>
 #include <imagine/time/Time.hh>
+#include <imagine/gfx/defs.hh>
 #include <imagine/gui/MenuItem.hh>
 #include <span>
 
@@ -46,6 +48,10 @@ struct FrameTimeStats
 	SteadyClockTimePoint aboutToPresent{};
 	SteadyClockTimePoint endOfDraw{};
 	int missedFrameCallbacks{};
+	uint32_t videoBufferStalls{};
+	float taskWakeupsPerSecond{};
+	ThermalTier thermalTier{};
+	Gfx::DrawStats drawStats{};
 };
 
 struct FrameTimeConfig
@@ -62,7 +68,8 @@ public:
 	static constexpr FrameTime originalOption{-1};
 
 	constexpr OutputTimingManager() = default;
-	FrameTimeConfig frameTimeConfig(const EmuSystem &, std::span<const FrameRate> supportedFrameRates) const;
+	// with variable refresh the auto option uses the system's exact rate instead of the closest screen rate
+	FrameTimeConfig frameTimeConfig(const EmuSystem &, std::span<const FrameRate> supportedFrameRates, bool variableRefresh = false) const;
 	static bool frameTimeOptionIsValid(FrameTime time);
 	bool setFrameTimeOption(VideoSystem, FrameTime frameTime);
 
@@ -0,0 +1,68 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	EmuFramework is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	EmuFramework is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/EmuSystem.hh>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+enum class RamSearchCompare : uint8_t
+{
+	equal,
+	notEqual,
+	greater,
+	less,
+	equalValue,
+};
+
+// Narrows down the bytes of a state section that changed in a given way between
+// snapshots, for finding the addresses to target with a cheat code
+class RamSearch
+{
+public:
+	// snapshot the given section index and make every byte a candidate
+	bool start(EmuSystem &, size_t sectionIdx);
+	// keep the candidates whose current value compares true against the snapshot,
+	// or against value with RamSearchCompare::equalValue, then take a new snapshot
+	void filter(EmuSystem &, RamSearchCompare, uint8_t value = 0);
+	void reset();
+	bool isActive() const { return snapshot.size(); }
+	size_t candidates() const { return candidateCount; }
+	size_t sectionIndex() const { return sectionIdx; }
+	uint32_t sectionAddress() const { return address; }
+	// offset of the candidate at index idx, fastest when called for neighboring indices
+	size_t candidateOffset(size_t idx) const;
+	uint8_t value(size_t offset) const { return snapshot[offset]; }
+
+private:
+	std::vector<uint8_t> snapshot;
+	std::vector<uint64_t> candidateBits;
+	size_t candidateCount{};
+	mutable size_t cursorWord{};
+	mutable size_t cursorCandidates{}; // candidates before cursorWord
+	size_t sectionIdx{};
+	uint32_t address{};
+};
+
+StateSection stateSection(EmuSystem &, size_t idx);
+
+}
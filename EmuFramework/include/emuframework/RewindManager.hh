@@ -16,13 +16,22 @@
 	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
 
 #include <emuframework/config.hh>
+#include <emuframework/EmuSystemTaskContext.hh>
+#include <emuframework/BackupMemoryWriter.hh>
 #include <imagine/base/PausableTimer.hh>
 #include <imagine/util/memory/FlexArray.hh>
+#include <imagine/util/memory/DynArray.hh>
+#include <imagine/util/DelegateFunc.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <atomic>
+#include <array>
+#include <vector>
 
 namespace IG
 {
 class MapIO;
-class FileIO;
+class ApplicationContext;
 }
 
 namespace EmuEx
@@ -31,6 +40,69 @@ namespace EmuEx
 using namespace IG;
 
 class EmuApp;
+class EmuSystem;
+class EmuVideo;
+class EmuAudio;
+
+constexpr int8_t defaultContinuousRewindInterval = 2;
+constexpr size_t rewindTierCount = 3;
+
+// A ring of states stored in a single buffer, each either a keyframe or the XOR of
+// the state with the one saved before it, both zero-run encoded
+class DeltaStateStore
+{
+public:
+	static size_t maxEncodedSize(size_t stateSize);
+	void reset(size_t buffSize, size_t maxRecords, size_t stateSize);
+	void clear();
+	// state must be the full state buffer size with any bytes past size zeroed,
+	// encodeBuff must be at least maxEncodedSize() bytes
+	void save(std::span<const uint8_t> state, size_t size, uint64_t seq, size_t keyframeInterval, std::span<uint8_t> encodeBuff);
+	std::span<uint8_t> newestState() { return {headState.data(), newestRecord().stateSize}; }
+	uint64_t newestSeq() const { return newestRecord().seq; }
+	void popNewest();
+	void dropFromSeq(uint64_t seq) { while(recordCount && newestSeq() >= seq) popNewest(); }
+	bool hasStorage() const { return records.size(); }
+	bool empty() const { return !recordCount; }
+	size_t size() const { return recordCount; }
+	size_t bytesUsed() const { return storedBytes; }
+	size_t capacity() const { return recordBuff.size(); }
+	size_t bytesAllocated() const;
+	// appends the oldest keyframe and its deltas to out in a form loadGroup() accepts
+	void serializeOldestGroup(std::vector<uint8_t> &out) const;
+	// restores a serialized group into an empty store
+	void loadGroup(std::span<const uint8_t> data);
+
+	// called before the oldest group is dropped to make space for a new record
+	DelegateFunc<void(const DeltaStateStore &)> onDropGroup;
+
+private:
+	struct DeltaRecord
+	{
+		uint64_t seq{};
+		size_t offset{};
+		uint32_t dataSize{};
+		uint32_t stateSize{};
+		bool isKeyframe{};
+	};
+
+	DynArray<uint8_t> recordBuff;
+	DynArray<DeltaRecord> records; // used as a ring with the oldest at firstRecordIdx
+	DynArray<uint8_t> headState; // uncompressed copy of the newest record
+	size_t firstRecordIdx{};
+	size_t recordCount{};
+	size_t recordWritePos{};
+	size_t recordsSinceKeyframe{};
+	size_t storedBytes{};
+
+	size_t recordIdx(size_t i) const { return (firstRecordIdx + i) % records.size(); }
+	const DeltaRecord &newestRecord() const { return records[recordIdx(recordCount - 1)]; }
+	std::span<uint8_t> recordData(const DeltaRecord &r) const { return {recordBuff.data() + r.offset, r.dataSize}; }
+	size_t allocRecord(size_t size);
+	void popOldestRecordGroup();
+	void rebuildHeadState();
+	void resetPositions();
+};
 
 class RewindManager
 {
@@ -39,11 +111,19 @@ public:
 	void clear();
 	bool reset();
 	void rewindState(EmuApp &);
+	void setRewinding(EmuApp &, bool on);
+	bool isRewinding() const { return rewinding.load(std::memory_order_relaxed); }
+	// called from the emulation thread while rewinding, returns true when a previous state was loaded
+	bool stepRewind(EmuApp &, int frames);
+	void runRewindFrame(EmuApp &, EmuSystemTaskContext, EmuVideo *, EmuAudio *);
 	void startTimer();
 	void pauseTimer();
 	void resetTimer();
 	bool readConfig(MapIO &, unsigned key);
 	void writeConfig(FileIO &) const;
+	size_t memoryUsed() const;
+	size_t memoryAllocated() const;
+	size_t spillBytesUsed() const;
 
 	void updateMaxStates(size_t max)
 	{
@@ -51,12 +131,57 @@ public:
 		reset();
 	}
 
-	bool reset(size_t stateSize_)
+	void updateKeyframeInterval(size_t interval)
+	{
+		keyframeInterval = interval;
+		reset();
+	}
+
+	void updateMemoryBudget(uint16_t mib)
+	{
+		memoryBudgetMiB = mib;
+		reset();
+	}
+
+	void updateDiskSpill(bool on)
+	{
+		diskSpill = on;
+		reset();
+	}
+
+	bool reset(size_t stateSize_, double frameRate_)
 	{
 		stateSize = stateSize_;
+		frameRate = frameRate_;
 		return reset();
 	}
 
+	bool isEnabled() const { return maxStates || usesMemoryBudget(); }
+	bool usesMemoryBudget() const { return memoryBudgetMiB; }
+	bool usesDeltaStates() const { return keyframeInterval || usesMemoryBudget(); }
+	bool usesFrameInterval() const { return frameInterval || usesMemoryBudget(); }
+	bool hasStorage() const { return stateEntries.size() || stores[0].hasStorage(); }
+	size_t activeFrameInterval() const { return usesMemoryBudget() ? adaptiveFrameInterval : frameInterval; }
+
+	void updateFrameInterval(size_t interval)
+	{
+		frameInterval = interval;
+		framesSinceSave = 0;
+	}
+
+	// called from the emulation thread after running frames when using a frame interval
+	void onFramesRun(EmuSystem &sys, int frames)
+	{
+		if(!usesFrameInterval() || !hasStorage())
+			return;
+		frameCount += frames;
+		framesSinceSave += frames;
+		if(framesSinceSave < activeFrameInterval())
+			return;
+		framesSinceSave = 0;
+		saveState(sys);
+	}
+
 private:
 	struct StateEntry
 	{
@@ -66,13 +191,61 @@ private:
 
 	FlexArray<StateEntry> stateEntries;
 	size_t stateIdx{};
+	// with a memory budget each store keeps states at a coarser spacing over a longer span,
+	// otherwise only the first is used
+	std::array<DeltaStateStore, rewindTierCount> stores;
+	std::array<size_t, rewindTierCount> storeFrameInterval{};
+	DynArray<uint8_t> scratchState;
+	DynArray<uint8_t> encodeBuff;
+	// groups dropped from the longest spanning store are appended to a file in the cache
+	// directory used as a ring, and read back once rewinding passes the stores in memory
+	struct SpillGroup
+	{
+		size_t offset{};
+		size_t size{};
+	};
+	FileIO spillFile;
+	FS::PathString spillPath;
+	BackupMemoryWriter spillWriter{false}; // rewind.spill is a throwaway cache, skip syncing it
+	std::vector<SpillGroup> spillGroups; // oldest first
+	std::vector<uint8_t> spillBuff;
+	size_t spillWritePos{};
+	size_t spillCapacity{};
+	uint64_t frameCount{};
+	size_t framesSinceSave{};
+	size_t adaptiveFrameInterval{1};
+	size_t savesSinceAdapt{};
+	double frameRate{60.};
+	int framesUntilRewindStep{};
+	std::atomic_bool rewinding{};
+	MemoryCharge<MemoryCategory::rewind> memoryCharge;
 public:
 	size_t stateSize{};
 	size_t maxStates{};
+	size_t keyframeInterval{};
+	size_t frameInterval{};
+	uint16_t memoryBudgetMiB{};
+	int8_t continuousRewindInterval{defaultContinuousRewindInterval};
+	bool continuousRewind{};
+	bool reverseAudio{true};
+	bool diskSpill{};
 	PausableTimer<Seconds> saveTimer;
 
 private:
-	void saveState(EmuApp &);
+	void saveState(EmuSystem &);
+	void saveDeltaState(EmuSystem &);
+	bool loadPrevState(EmuApp &);
+	bool loadPrevDeltaState(EmuApp &);
+	bool resetDeltaStorage();
+	void resetBudgetStorage();
+	void clearDeltaStorage();
+	void adaptFrameInterval();
+	DeltaStateStore &spillStore() { return usesMemoryBudget() ? stores.back() : stores[0]; }
+	void setupSpill();
+	void openSpillFile(ApplicationContext);
+	void clearSpill();
+	void spillOldestGroup(const DeltaStateStore &);
+	bool loadSpilledGroup();
 };
 
 }
@@ -0,0 +1,58 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/config.hh>
+#include <emuframework/EmuSystemTaskContext.hh>
+#include <imagine/util/memory/DynArray.hh>
+
+namespace IG
+{
+class MapIO;
+class FileIO;
+}
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+class EmuApp;
+class EmuVideo;
+class EmuAudio;
+
+constexpr int8_t maxRunAheadFrames = 4;
+
+class RunAheadManager
+{
+public:
+	// Runs the given frames with run-ahead applied, returns false if the caller should run them normally.
+	// Called from the emulation thread.
+	bool runFrames(EmuApp &, EmuSystemTaskContext, EmuVideo *, EmuAudio *, int frames);
+	void updateFrames(int8_t frames_);
+	int8_t frames() const { return frames_; }
+	void clear();
+	bool readConfig(MapIO &, unsigned key);
+	void writeConfig(FileIO &) const;
+
+	bool useSecondInstance{true}; // only used if the system provides one
+
+private:
+	DynArray<uint8_t> stateBuff;
+	int8_t frames_{};
+};
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/pixmap/Pixmap.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <imagine/util/memory/DynArray.hh>
+#include <thread>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+class EmuApp;
+
+// Encodes and writes screenshots on a background thread so taking one only costs
+// a copy of the frame on the emulation thread
+class ScreenshotWriter
+{
+public:
+	ScreenshotWriter(EmuApp &app): app{app} {}
+	~ScreenshotWriter() { wait(); }
+	// waits for any screenshot still being written and returns its reused buffer
+	MutablePixmapView allocPixmap(PixmapDesc);
+	// pix must come from allocPixmap()
+	void write(PixmapView pix, FS::PathString path);
+	void wait();
+
+private:
+	EmuApp &app;
+	std::thread thread;
+	DynArray<uint8_t> buffer;
+};
+
+}
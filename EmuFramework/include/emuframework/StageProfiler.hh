@@ -0,0 +1,106 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/time/Time.hh>
+#include <array>
+#include <atomic>
+#include <optional>
+#include <string_view>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+enum class ProfileStage : int8_t
+{
+	none = -1,
+	cpu,
+	video,
+	sound,
+	audioOutput,
+};
+
+constexpr size_t profileStages = 4;
+
+struct StageTimes
+{
+	std::array<SteadyClockTime, profileStages> times{};
+	SteadyClockTime period{};
+
+	SteadyClockTime operator[](ProfileStage stage) const { return times[size_t(stage)]; }
+};
+
+// Accumulates CPU time spent in each emulation stage, cores mark stages with
+// ScopedStageTimer. Time in a nested stage isn't counted in its parent.
+class StageProfiler
+{
+public:
+	static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+	static void setEnabled(bool on);
+	static void add(ProfileStage stage, SteadyClockTime t)
+	{
+		totals[size_t(stage)].fetch_add(t.count(), std::memory_order_relaxed);
+	}
+	// returns the totals and resets them once at least the given period has passed
+	static std::optional<StageTimes> takeTimes(SteadyClockTimePoint now, SteadyClockTime period = Seconds{1});
+	static std::string_view stageName(ProfileStage);
+
+	static inline thread_local ProfileStage activeStage{ProfileStage::none};
+	static inline thread_local SteadyClockTimePoint activeStageStart{};
+
+private:
+	static inline std::array<std::atomic<SteadyClockTime::rep>, profileStages> totals{};
+	static inline std::atomic_bool enabled{};
+	static inline SteadyClockTimePoint periodStart{};
+};
+
+class ScopedStageTimer
+{
+public:
+	ScopedStageTimer(ProfileStage stage)
+	{
+		if(!StageProfiler::isEnabled()) [[likely]]
+			return;
+		auto now = SteadyClock::now();
+		prevStage = StageProfiler::activeStage;
+		if(prevStage != ProfileStage::none)
+			StageProfiler::add(prevStage, now - StageProfiler::activeStageStart);
+		StageProfiler::activeStage = stage;
+		StageProfiler::activeStageStart = now;
+		isActive = true;
+	}
+
+	~ScopedStageTimer()
+	{
+		if(!isActive) [[likely]]
+			return;
+		auto now = SteadyClock::now();
+		StageProfiler::add(StageProfiler::activeStage, now - StageProfiler::activeStageStart);
+		StageProfiler::activeStage = prevStage;
+		StageProfiler::activeStageStart = now;
+	}
+
+	ScopedStageTimer(const ScopedStageTimer &) = delete;
+	ScopedStageTimer &operator=(const ScopedStageTimer &) = delete;
+
+private:
+	ProfileStage prevStage{ProfileStage::none};
+	bool isActive{};
+};
+
+}
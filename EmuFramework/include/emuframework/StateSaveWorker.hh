@@ -0,0 +1,85 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/config.hh>
+#include <emuframework/EmuSystem.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/util/memory/DynArray.hh>
+#include <imagine/thread/Thread.hh>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+class EmuApp;
+
+// Compresses and writes save states on a background thread so only the
+// raw state capture has to happen while emulation is paused
+class StateSaveWorker
+{
+public:
+	struct Job
+	{
+		DynArray<uint8_t> state;
+		size_t size{};
+		FileIO file;
+		FileIO *sharedFile{}; // written in place of file when set, must outlive the job
+		const char *errorMsg{"Can't save state"};
+		StateCompression compression{};
+		bool compress{};
+		bool notifySaved{};
+
+		FileIO &output() { return sharedFile ? *sharedFile : file; }
+	};
+
+	StateSaveWorker(EmuApp &app): app{app} {}
+	~StateSaveWorker() { stop(); }
+	DynArray<uint8_t> allocBuffer(size_t size);
+	void push(Job);
+	void wait();
+	void stop();
+	// applies to the worker thread now if it's running, otherwise once it starts
+	void setCPUAffinityMask(CPUMask);
+
+private:
+	EmuApp &app;
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable jobCond;
+	std::condition_variable idleCond;
+	std::deque<Job> jobs;
+	std::vector<DynArray<uint8_t>> freeBuffers;
+	DynArray<uint8_t> compressBuffer; // only used by the worker thread
+	size_t buffersReused{};
+	size_t buffersAllocated{};
+	ThreadId threadId{};
+	CPUMask cpuMask{};
+	bool isWorking{};
+	bool quit{};
+
+	void run();
+	void write(Job &);
+	void releaseBuffer(DynArray<uint8_t>);
+};
+
+}
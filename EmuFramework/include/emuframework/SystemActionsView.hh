@@ -32,7 +32,7 @@ public:
 	void onShow() override;
 	void loadStandardItems();
 
-	static constexpr int STANDARD_ITEMS = 10;
+	static constexpr int STANDARD_ITEMS = 11;
 	static constexpr int MAX_SYSTEM_ITEMS = 6;
 
 protected:
@@ -44,6 +44,7 @@ protected:
 	TextMenuItem stateSlot;
 	ConditionalMember<Config::envIsAndroid, TextMenuItem> addLauncherIcon;
 	TextMenuItem screenshot;
+	TextMenuItem inputRecording;
 	TextMenuItem resetSessionOptions;
 	TextMenuItem close;
 	StaticArrayList<MenuItem*, STANDARD_ITEMS + MAX_SYSTEM_ITEMS> item;
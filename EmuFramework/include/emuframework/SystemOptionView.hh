@@ -30,6 +30,7 @@ class SystemOptionView : public TableView, public EmuAppHelper
 public:
 	SystemOptionView(ViewAttachParams attach, bool customMenu = false);
 	void loadStockItems();
+	void onShow() override;
 
 protected:
 	TextMenuItem autosaveTimerItem[5];
@@ -37,18 +38,42 @@ protected:
 	TextMenuItem autosaveLaunchItem[4];
 	MultiChoiceMenuItem autosaveLaunch;
 	BoolMenuItem autosaveContent;
+	BoolMenuItem autosaveMappedState;
 	BoolMenuItem confirmOverwriteState;
+	TextMenuItem stateCompressionItem[3];
+	MultiChoiceMenuItem stateCompression;
 	TextMenuItem fastModeSpeedItem[6];
 	MultiChoiceMenuItem fastModeSpeed;
+	BoolMenuItem fastModeMaxThroughput;
 	TextMenuItem slowModeSpeedItem[3];
 	MultiChoiceMenuItem slowModeSpeed;
 	TextMenuItem rewindStatesItem[4];
 	MultiChoiceMenuItem rewindStates;
+	TextMenuItem rewindMemoryBudgetItem[6];
+	MultiChoiceMenuItem rewindMemoryBudget;
+	DualTextMenuItem rewindMemoryUsage;
+	BoolMenuItem rewindDiskSpill;
 	DualTextMenuItem rewindTimeInterval;
+	TextMenuItem rewindFrameIntervalItem[6];
+	MultiChoiceMenuItem rewindFrameInterval;
+	TextMenuItem rewindKeyframeIntervalItem[4];
+	MultiChoiceMenuItem rewindKeyframeInterval;
+	BoolMenuItem continuousRewind;
+	TextMenuItem continuousRewindIntervalItem[4];
+	MultiChoiceMenuItem continuousRewindInterval;
+	BoolMenuItem rewindReverseAudio;
+	TextMenuItem runAheadFramesItem[5];
+	MultiChoiceMenuItem runAheadFrames;
+	BoolMenuItem runAheadSecondInstance;
+	TextMenuItem archiveCacheSizeItem[6];
+	MultiChoiceMenuItem archiveCacheSize;
 	ConditionalMember<Config::envIsAndroid, BoolMenuItem> performanceMode;
+	ConditionalMember<Config::envIsAndroid, BoolMenuItem> thermalGovernor;
 	ConditionalMember<Config::envIsAndroid && Config::DEBUG_BUILD, BoolMenuItem> noopThread;
 	ConditionalMember<Config::cpuAffinity, TextMenuItem> cpuAffinity;
-	StaticArrayList<MenuItem*, 30> item;
+	StaticArrayList<MenuItem*, 32> item;
+
+	void updateRewindMemoryUsage();
 };
 
 }
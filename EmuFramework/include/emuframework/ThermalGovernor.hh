@@ -0,0 +1,69 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	EmuFramework is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	EmuFramework is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/base/Timer.hh>
+#include <imagine/io/IO.hh>
+#include <imagine/util/enum.hh>
+#include <atomic>
+#include <cstdint>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+class EmuApp;
+
+WISE_ENUM_CLASS((ThermalTier, uint8_t),
+	Nominal,
+	NoImageEffect,
+	FrameSkip);
+
+// Polls the device's thermal status and headroom during emulation and gives up optional work
+// in steps as it heats up, first the image effect pass and then video frames via predictive
+// frame skip, so it has a chance to stay below the point where the OS throttles the CPU.
+// Tiers go up as soon as a poll calls for it but only go down after several cool polls.
+class ThermalGovernor
+{
+public:
+	ThermalGovernor(EmuApp &);
+	void start();
+	void pause();
+	// returns to the minimum tier
+	void reset();
+	ThermalTier tier() const { return tier_.load(std::memory_order_relaxed); }
+	// lowest tier used regardless of temperature, also applies while disabled
+	void setMinTier(ThermalTier);
+	ThermalTier minTier() const { return minTier_; }
+	void setEnabled(bool);
+	bool isEnabled() const { return enabled; }
+	bool readConfig(MapIO &, unsigned key);
+	void writeConfig(FileIO &) const;
+
+private:
+	EmuApp &app;
+	Timer pollTimer;
+	std::atomic<ThermalTier> tier_{};
+	ThermalTier minTier_{};
+	int8_t coolPolls{};
+	bool enabled{};
+
+	void poll();
+	void setTier(ThermalTier);
+};
+
+}
@@ -17,15 +17,19 @@
 
 #include <emuframework/inputDefs.hh>
 #include <imagine/util/container/ArrayList.hh>
+#include <mutex>
 
 namespace EmuEx
 {
 
 class EmuApp;
 
+// Keys are added and removed by input events on the main thread while update() runs on the
+// emulation thread once per emulated frame, so the turbo rate follows the emulated timeline
 struct TurboInput
 {
 	StaticArrayList<KeyInfo, 5> keys;
+	std::mutex keyMutex;
 	int clock{};
 
 	constexpr TurboInput() = default;
@@ -33,6 +37,7 @@ struct TurboInput
 	void removeEvent(KeyInfo);
 	void updateEvent(EmuApp &, KeyInfo, Input::Action);
 	void update(EmuApp &);
+	void clear();
 };
 
 }
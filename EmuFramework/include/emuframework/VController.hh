@@ -209,16 +209,23 @@ public:
 		setAlpha(alpha, container);
 	}
 
-	void updateSprite(auto &quads)
+	void writeSprite(auto &quads, ssize_t idx) const
 	{
-		Gfx::ILitTexQuad({.bounds = bounds_.as<int16_t>(), .color = spriteColor, .textureSpan = texture}).write(quads, spriteIdx);
+		Gfx::ILitTexQuad({.bounds = bounds_.as<int16_t>(), .color = spriteColor, .textureSpan = texture}).write(quads, idx);
 	}
 
+	void writeBounds(auto &boundQuads, ssize_t idx) const
+	{
+		float brightness = isHighlighted ? 2.f : 1.f;
+		Gfx::IColQuad({.bounds = extendedBounds_.as<int16_t>(), .color = Gfx::Color{.5f}.multiplyRGB(brightness)}).write(boundQuads, idx);
+	}
+
+	void updateSprite(auto &quads) { writeSprite(quads, spriteIdx); }
+
 	void updateSprite(auto &quads, auto &boundQuads)
 	{
 		updateSprite(quads);
-		float brightness = isHighlighted ? 2.f : 1.f;
-		Gfx::IColQuad({.bounds = extendedBounds_.as<int16_t>(), .color = Gfx::Color{.5f}.multiplyRGB(brightness)}).write(boundQuads, spriteIdx);
+		writeBounds(boundQuads, spriteIdx);
 	}
 
 	Gfx::TextureSpan texture;
@@ -287,6 +294,7 @@ public:
 	WRect paddingRect() const { return {{int(-paddingPixels().x), int(-paddingPixels().y)}, {int(paddingPixels().x), int(paddingPixels().y)}}; }
 	WRect realBounds() const { return bounds() + paddingRect(); }
 	int rows() const;
+	int enabledButtons() const { return enabledBtns; }
 	std::array<KeyInfo, 2> findButtonIndices(WPt windowPos) const;
 	void drawBounds(Gfx::RendererCommands &__restrict__) const;
 	std::string name(const InputManager &) const;
@@ -322,6 +330,7 @@ protected:
 	int16_t btnRowShift{};
 public:
 	LayoutConfig layout{};
+	bool spritesChanged{}; // set when any sprite is rewritten, cleared by VController after batching
 };
 
 class VControllerUIButtonGroup : public BaseVControllerButtonGroup<VControllerUIButtonGroup>
@@ -647,6 +656,21 @@ private:
 	const WindowData *winData{};
 	const Gfx::GlyphTextureSet *facePtr{};
 	Gfx::IndexBuffer<uint8_t> fanQuadIdxs;
+	// sprites of all visible gamepad button groups, drawn with a single call per frame
+	struct BatchedButtonGroup
+	{
+		const VControllerButtonGroup *group{};
+		int buttons{};
+		bool showsBounds{};
+
+		constexpr bool operator==(const BatchedButtonGroup &) const = default;
+	};
+	std::vector<BatchedButtonGroup> batchedGroups;
+	Gfx::QuadIndexArray<uint16_t> btnBatchIdxs;
+	Gfx::ObjectVertexArray<Gfx::ILitTexQuad> btnBatchQuads;
+	Gfx::ObjectVertexArray<Gfx::IColQuad> btnBatchBoundQuads;
+	int btnBatchSprites{};
+	int btnBatchBounds{};
 	Gfx::TextureBinding gamepadTex, uiTex;
 	VControllerKeyboard kb;
 	std::vector<VControllerElement> gpElements{};
@@ -674,6 +698,7 @@ private:
 	std::array<KeyInfo, 2> findGamepadElements(WPt pos);
 	KeyInfo keyboardKeyFromPointer(const Input::MotionEvent &);
 	void applyButtonSize();
+	void updateButtonBatch(bool showHidden);
 	void resetEmulatedDevicePositions(std::vector<VControllerElement> &) const;
 	std::vector<VControllerElement> defaultEmulatedDeviceGroups() const;
 	void resetUIPositions(std::vector<VControllerElement> &) const;
@@ -19,6 +19,11 @@
 #include <imagine/gfx/Program.hh>
 #include <imagine/gfx/Quads.hh>
 #include <imagine/util/enum.hh>
+#include <deque>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace EmuEx
 {
@@ -31,8 +36,20 @@ WISE_ENUM_CLASS((ImageEffectId, uint8_t),
 	(SCALE2X, 2),
 	(PRESCALE2X, 3),
 	(PRESCALE3X, 4),
-	(PRESCALE4X, 5));
+	(PRESCALE4X, 5),
+	(SCALE4X, 6),
+	(HQ2X_SCALE2X, 7));
 
+// Runs one or more shader passes over the video image. Multi-pass effects are loaded from
+// a preset in shaders/<name>-preset.txt using a subset of the RetroArch preset keys:
+//   shaders = N
+//   shaderN = name of a shaders/<name>-v.txt & -f.txt pair
+//   scaleN, scale_xN, scale_yN = integer scale of the pass output relative to its input
+//   filter_linearN = true/false, filtering used when sampling the pass input
+//   formatN = rgb565/rgba8888, format of an intermediate pass output
+// Intermediate render targets come from a pool reused across size & format changes,
+// shaders are only compiled when the effect is created. Shaders declaring a PAL sampler
+// read the palette texture set with setPaletteTexture().
 class VideoImageEffect
 {
 public:
@@ -40,39 +57,71 @@ public:
 
 	struct EffectDesc
 	{
-		const char *vShaderFilename;
-		const char *fShaderFilename;
+		const char *name; // shader pair or preset name
 		WSize scale;
+		bool isPreset{};
 	};
 
+	struct PassDesc
+	{
+		std::string shaderName;
+		WSize scale{1, 1};
+		PixelFormat format{}; // unset uses the effect's format
+		bool linearFilter{};
+	};
+
+	// looks up PixelFmtI8 video in the palette texture
+	static constexpr EffectDesc paletteDesc{"palette", {1, 1}};
+	// looks up PixelFmtIA88 video, blending in the previous frame's decayed colors
+	static constexpr EffectDesc palettePhosphorDesc{"palette-phosphor", {1, 1}};
+
 	constexpr	VideoImageEffect() = default;
 	VideoImageEffect(Gfx::Renderer &r, Id effect, PixelFormat, Gfx::ColorSpace, Gfx::TextureSamplerConfig, WSize size);
+	VideoImageEffect(Gfx::Renderer &r, EffectDesc, PixelFormat, Gfx::ColorSpace, Gfx::TextureSamplerConfig, WSize size);
 	void setImageSize(Gfx::Renderer &r, WSize size, Gfx::TextureSamplerConfig);
 	void setFormat(Gfx::Renderer &r, IG::PixelFormat, Gfx::ColorSpace, Gfx::TextureSamplerConfig);
 	void setSampler(Gfx::TextureSamplerConfig);
-	Gfx::Program &program();
+	void setPaletteTexture(const Gfx::Texture *tex) { paletteTex = tex; }
 	Gfx::Texture &renderTarget();
-	void drawRenderTarget(Gfx::RendererCommands &, Gfx::TextureSpan);
+	void draw(Gfx::RendererCommands &, Gfx::TextureSpan);
 	constexpr IG::PixelFormat imageFormat() const { return format; }
-	operator bool() const { return (bool)prog; }
+	size_t passCount() const { return passes.size(); }
+	operator bool() const { return !passes.empty(); }
+	static std::vector<PassDesc> parsePreset(std::string_view);
 
 private:
+	struct Pass
+	{
+		Gfx::Program prog;
+		int srcTexelDeltaU{};
+		int srcTexelHalfDeltaU{};
+		int srcPixelsU{};
+		int paletteU{};
+		WSize scale{1, 1};
+		WSize inputSize{1, 1};
+		WSize outputSize{1, 1};
+		PixelFormat format{};
+		bool linearFilter{};
+		int8_t targetIdx{-1}; // index into targetPool, -1 for the final render target
+	};
+
 	Gfx::ITexQuads quad;
 	Gfx::Texture renderTarget_;
-	Gfx::Program prog;
-	int srcTexelDeltaU{};
-	int srcTexelHalfDeltaU{};
-	int srcPixelsU{};
-	WSize renderTargetScale;
+	std::deque<Gfx::Texture> targetPool; // intermediate targets, stable addresses for TextureSpan
+	std::vector<Pass> passes;
+	const Gfx::Texture *paletteTex{};
 	WSize renderTargetImgSize;
 	WSize inputImgSize{1, 1};
 	IG::PixelFormat format;
 	Gfx::ColorSpace colorSpace{Gfx::ColorSpace::LINEAR};
 
 	void initRenderTargetTexture(Gfx::Renderer &r, Gfx::TextureSamplerConfig);
-	void updateProgramUniforms(Gfx::Renderer &r);
+	void initIntermediateTargets(Gfx::Renderer &r);
+	void updatePassSizes();
+	void updateProgramUniforms(Pass &);
 	void compile(Gfx::Renderer &r, EffectDesc desc, Gfx::TextureSamplerConfig);
-	void compileEffect(Gfx::Renderer &r, EffectDesc desc, bool useFallback);
+	void compileEffect(Gfx::Renderer &r, std::span<const PassDesc>, bool useFallback);
+	Gfx::TextureSpan passInput(size_t idx, Gfx::TextureSpan srcTex) const;
 };
 
 }
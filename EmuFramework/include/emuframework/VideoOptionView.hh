@@ -52,7 +52,7 @@ protected:
 	MultiChoiceMenuItem contentRotation;
 	TextMenuItem placeVideo;
 	BoolMenuItem imgFilter;
-	TextMenuItem imgEffectItem[6];
+	TextMenuItem imgEffectItem[8];
 	MultiChoiceMenuItem imgEffect;
 	TextMenuItem overlayEffectItem[8];
 	MultiChoiceMenuItem overlayEffect;
@@ -66,6 +66,8 @@ protected:
 	ConditionalMember<Config::BASE_MULTI_SCREEN && Config::BASE_MULTI_WINDOW, BoolMenuItem> showOnSecondScreen;
 	TextMenuItem renderPixelFormatItem[3];
 	MultiChoiceMenuItem renderPixelFormat;
+	BoolMenuItem gpuPaletteConversion;
+	BoolMenuItem partialFrameUpload;
 	TextMenuItem brightnessItem[2];
 	TextMenuItem redItem[2];
 	TextMenuItem greenItem[2];
@@ -0,0 +1,217 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/ArchiveCache.hh>
+#include <emuframework/EmuOptions.hh>
+#include <emuframework/Option.hh>
+#include <imagine/fs/FS.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/util/format.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <vector>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"ArchiveCache"};
+constexpr std::string_view contentExt{".bin"}, nameExt{".name"}, tempExt{".tmp"};
+
+// 64-bit FNV-1a
+static uint64_t hashBytes(uint64_t hash, std::string_view bytes)
+{
+	for(auto c : bytes)
+	{
+		hash ^= uint8_t(c);
+		hash *= 0x100000001b3;
+	}
+	return hash;
+}
+
+static uint64_t hashValue(uint64_t hash, auto val)
+{
+	return hashBytes(hash, {reinterpret_cast<const char*>(&val), sizeof(val)});
+}
+
+uint64_t ArchiveCache::key(CStringView archivePath, size_t archiveSize) const
+{
+	if(!sizeCapMiB)
+		return 0;
+	auto lastWriteTime = appCtx.fileUriLastWriteTime(archivePath);
+	if(lastWriteTime == FS::file_time_type{})
+		return 0;
+	uint64_t hash = 0xcbf29ce484222325;
+	hash = hashBytes(hash, archivePath);
+	hash = hashValue(hash, uint64_t(archiveSize));
+	hash = hashValue(hash, int64_t(lastWriteTime.time_since_epoch().count()));
+	return hash ? hash : 1;
+}
+
+const FS::PathString &ArchiveCache::directory()
+{
+	if(!dirPath.size())
+	{
+		try
+		{
+			dirPath = FS::createDirectorySegments(appCtx.cachePath(), "archiveCache");
+		}
+		catch(std::exception &err)
+		{
+			log.error("can't create cache directory:{}", err.what());
+		}
+	}
+	return dirPath;
+}
+
+FS::PathString ArchiveCache::entryPath(uint64_t key, std::string_view ext)
+{
+	return FS::pathString(directory(), std::format("{:016x}{}", key, ext));
+}
+
+IO ArchiveCache::open(uint64_t key, FS::FileString &entryName)
+{
+	if(!key || !directory().size())
+		return {};
+	auto contentPath = entryPath(key, contentExt);
+	auto nameBuff = FileUtils::bufferFromPath(entryPath(key, nameExt), {.test = true});
+	if(!nameBuff)
+		return {};
+	FileIO io{contentPath, {.test = true, .accessHint = IOAccessHint::All}};
+	if(!io)
+		return {};
+	entryName = nameBuff.stringView();
+	// mark as recently used for eviction
+	FS::last_write_time(contentPath, FS::file_time_type::clock::now());
+	log.info("loading {} from cache:{}", entryName, contentPath);
+	return io;
+}
+
+IO ArchiveCache::store(uint64_t key, std::string_view entryName, IO &entry)
+{
+	if(!key || !directory().size())
+		return {};
+	size_t entrySize = entry.size();
+	size_t capBytes = size_t(sizeCapMiB) * 1024 * 1024;
+	if(entrySize > capBytes)
+	{
+		log.info("not caching {}, size:{} exceeds cap", entryName, entrySize);
+		return {};
+	}
+	evict(entrySize);
+	auto tempPath = entryPath(key, tempExt);
+	auto contentPath = entryPath(key, contentExt);
+	auto namePath = entryPath(key, nameExt);
+	if(FileUtils::writeToPath(tempPath, entry) != ssize_t(entrySize) ||
+		FileUtils::writeToPath(namePath, std::span{reinterpret_cast<const unsigned char*>(entryName.data()), entryName.size()}) == -1 ||
+		!FS::rename(tempPath, contentPath))
+	{
+		log.error("error writing cache entry:{}", contentPath);
+		FS::remove(tempPath);
+		FS::remove(namePath);
+		entry = {};
+		return {};
+	}
+	log.info("cached {} ({} bytes) in:{}", entryName, entrySize, contentPath);
+	FileIO io{contentPath, {.test = true, .accessHint = IOAccessHint::All}};
+	if(!io)
+		entry = {};
+	return io;
+}
+
+void ArchiveCache::setSizeCap(uint16_t mib)
+{
+	sizeCapMiB = mib;
+	if(!mib)
+		clear();
+	else
+		evict(0);
+}
+
+size_t ArchiveCache::size()
+{
+	if(!directory().size())
+		return 0;
+	size_t total{};
+	for(auto &e : FS::directory_iterator{dirPath})
+	{
+		if(e.name().ends_with(contentExt))
+			total += FS::status(e.path()).size();
+	}
+	return total;
+}
+
+void ArchiveCache::clear()
+{
+	if(!directory().size())
+		return;
+	log.info("clearing cache");
+	std::vector<FS::PathString> paths;
+	for(auto &e : FS::directory_iterator{dirPath}) { paths.emplace_back(e.path()); }
+	for(const auto &p : paths) { FS::remove(p); }
+}
+
+void ArchiveCache::evict(size_t bytesNeeded)
+{
+	if(!directory().size())
+		return;
+	struct Entry
+	{
+		FS::PathString path;
+		size_t size;
+		FS::file_time_type lastUse;
+	};
+	std::vector<Entry> entries;
+	size_t total{};
+	for(auto &e : FS::directory_iterator{dirPath})
+	{
+		if(!e.name().ends_with(contentExt))
+			continue;
+		auto status = FS::status(e.path());
+		entries.emplace_back(e.path(), size_t(status.size()), status.lastWriteTime());
+		total += status.size();
+	}
+	size_t capBytes = size_t(sizeCapMiB) * 1024 * 1024;
+	if(total + bytesNeeded <= capBytes)
+		return;
+	std::ranges::sort(entries, {}, &Entry::lastUse);
+	for(const auto &e : entries)
+	{
+		if(total + bytesNeeded <= capBytes)
+			break;
+		log.info("evicting:{} ({} bytes)", e.path, e.size);
+		auto namePath = e.path;
+		namePath.resize(namePath.size() - contentExt.size());
+		namePath += nameExt;
+		FS::remove(e.path);
+		FS::remove(namePath);
+		total -= e.size;
+	}
+}
+
+bool ArchiveCache::readConfig(MapIO &io, unsigned key)
+{
+	switch(key)
+	{
+		default: return false;
+		case CFGKEY_ARCHIVE_CACHE_SIZE: return readOptionValue(io, sizeCapMiB);
+	}
+}
+
+void ArchiveCache::writeConfig(FileIO &io) const
+{
+	writeOptionValueIfNotDefault(io, CFGKEY_ARCHIVE_CACHE_SIZE, sizeCapMiB, defaultSizeCapMiB);
+}
+
+}
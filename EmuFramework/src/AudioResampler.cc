@@ -0,0 +1,236 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/AudioResampler.hh>
+#include <imagine/util/ranges.hh>
+#include <imagine/util/utility.h>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"AudioResampler"};
+constexpr double kaiserBeta = 8.; // ~80dB stop-band attenuation
+constexpr float passband = .9f; // fraction of the lower Nyquist frequency kept
+constexpr size_t historyFrames = AudioResampler::taps / 2 - 1;
+
+// sum of x[i] * (h[i] + dh[i] * frac)
+static float dotProduct(const float *x, const float *h, const float *dh, float frac)
+{
+	constexpr auto taps = AudioResampler::taps;
+	static_assert(taps % 4 == 0);
+	#if defined(__ARM_NEON)
+	float32x4_t sum = vdupq_n_f32(0.f);
+	for(size_t i = 0; i < taps; i += 4)
+	{
+		float32x4_t coef = vmlaq_n_f32(vld1q_f32(h + i), vld1q_f32(dh + i), frac);
+		sum = vmlaq_f32(sum, vld1q_f32(x + i), coef);
+	}
+	#if defined(__aarch64__)
+	return vaddvq_f32(sum);
+	#else
+	float32x2_t half = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+	return vget_lane_f32(vpadd_f32(half, half), 0);
+	#endif
+	#elif defined(__SSE2__)
+	__m128 sum = _mm_setzero_ps();
+	__m128 fracV = _mm_set1_ps(frac);
+	for(size_t i = 0; i < taps; i += 4)
+	{
+		__m128 coef = _mm_add_ps(_mm_loadu_ps(h + i), _mm_mul_ps(_mm_loadu_ps(dh + i), fracV));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(x + i), coef));
+	}
+	sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+	sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+	return _mm_cvtss_f32(sum);
+	#else
+	float sum{};
+	for(size_t i = 0; i < taps; i++)
+	{
+		sum += x[i] * (h[i] + dh[i] * frac);
+	}
+	return sum;
+	#endif
+}
+
+// zeroth order modified Bessel function of the first kind
+static double besselI0(double x)
+{
+	double sum = 1., term = 1.;
+	for(int k = 1; k < 32; k++)
+	{
+		double t = x / (2. * k);
+		term *= t * t;
+		sum += term;
+		if(term < sum * 1e-12)
+			break;
+	}
+	return sum;
+}
+
+AudioResampler::AudioResampler()
+{
+	makeFilter(passband);
+}
+
+void AudioResampler::makeFilter(float newCutoff)
+{
+	constexpr double halfWidth = taps / 2;
+	const double i0Beta = besselI0(kaiserBeta);
+	filter.resize(phases + 1);
+	for(auto p : iotaCount(phases + 1))
+	{
+		double frac = double(p) / phases;
+		double sum{};
+		for(auto k : iotaCount(taps))
+		{
+			double d = double(k) - historyFrames - frac;
+			double x = d * newCutoff;
+			double sinc = x == 0. ? 1. : std::sin(std::numbers::pi * x) / (std::numbers::pi * x);
+			double r = std::clamp(d / halfWidth, -1., 1.);
+			double window = besselI0(kaiserBeta * std::sqrt(1. - r * r)) / i0Beta;
+			filter[p][k] = sinc * window;
+			sum += filter[p][k];
+		}
+		// unity gain at DC for every phase so ratio changes don't modulate the volume
+		for(auto &c : filter[p])
+		{
+			c /= sum;
+		}
+	}
+	filterDelta.resize(phases);
+	for(auto p : iotaCount(phases))
+	{
+		for(auto k : iotaCount(taps))
+		{
+			filterDelta[p][k] = filter[p + 1][k] - filter[p][k];
+		}
+	}
+	cutoff = newCutoff;
+	log.info("made filter with cutoff:{}", newCutoff);
+}
+
+void AudioResampler::reset()
+{
+	for(auto &i : input)
+	{
+		i.clear();
+	}
+	pos = 0;
+	format = {};
+}
+
+void AudioResampler::appendInput(const void *src, size_t srcFrames)
+{
+	auto channels = format.channels;
+	auto start = input[0].size();
+	for(auto c : iotaCount(channels))
+	{
+		input[c].resize(start + srcFrames);
+	}
+	auto deinterleave = [&](auto *s, float scale)
+	{
+		for(auto i : iotaCount(srcFrames))
+		{
+			for(auto c : iotaCount(channels))
+			{
+				input[c][start + i] = float(s[i * channels + c]) * scale;
+			}
+		}
+	};
+	if(format.sample.isFloat())
+		deinterleave(static_cast<const float*>(src), 1.f);
+	else
+		deinterleave(static_cast<const int16_t*>(src), 1.f / 32768.f);
+	if(!start)
+	{
+		// prime the history with the first frame instead of silence to avoid a click on reset
+		for(auto c : iotaCount(channels))
+		{
+			input[c].insert(input[c].begin(), historyFrames, input[c][0]);
+		}
+	}
+}
+
+size_t AudioResampler::maxOutputFrames(size_t srcFrames, double ratio) const
+{
+	if(!srcFrames)
+		return 0;
+	auto pending = input[0].size() ? input[0].size() : historyFrames;
+	double usable = double(pending + srcFrames) - (taps - 1) - pos;
+	if(usable <= 0.)
+		return 0;
+	return std::ceil(usable * ratio);
+}
+
+size_t AudioResampler::resample(void *dest, size_t destFrames, const void *src, size_t srcFrames,
+	Audio::Format srcFormat, double ratio)
+{
+	assumeExpr(srcFormat.channels == 1 || srcFormat.channels == 2);
+	if(srcFormat != format)
+	{
+		reset();
+		format = srcFormat;
+	}
+	if(!srcFrames)
+		return 0;
+	float wantedCutoff = std::min(1., ratio) * passband;
+	if(std::abs(wantedCutoff - cutoff) > .02f) // small rate adjustments reuse the current filter
+		makeFilter(wantedCutoff);
+	appendInput(src, srcFrames);
+	const auto channels = format.channels;
+	const double step = 1. / ratio;
+	const size_t avail = input[0].size();
+	size_t frames{};
+	auto writeFrames = [&](auto *d, float scale, float minVal, float maxVal)
+	{
+		for(; frames < destFrames; frames++)
+		{
+			size_t idx = size_t(pos);
+			if(idx + taps > avail)
+				break;
+			float phasePos = (pos - idx) * phases;
+			size_t phase = std::min(size_t(phasePos), phases - 1);
+			float phaseFrac = phasePos - phase;
+			for(auto c : iotaCount(channels))
+			{
+				float out = dotProduct(&input[c][idx], filter[phase].data(), filterDelta[phase].data(), phaseFrac);
+				d[frames * channels + c] = std::clamp(out * scale, minVal, maxVal);
+			}
+			pos += step;
+		}
+	};
+	if(format.sample.isFloat())
+		writeFrames(static_cast<float*>(dest), 1.f, -1.f, 1.f);
+	else
+		writeFrames(static_cast<int16_t*>(dest), 32768.f, -32768.f, 32767.f);
+	auto consumed = std::min(size_t(pos), avail);
+	for(auto c : iotaCount(channels))
+	{
+		input[c].erase(input[c].begin(), input[c].begin() + consumed);
+	}
+	pos -= consumed;
+	return frames;
+}
+
+}
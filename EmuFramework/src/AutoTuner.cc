@@ -0,0 +1,184 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/AutoTuner.hh>
+#include <emuframework/EmuApp.hh>
+#include <imagine/base/Screen.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <format>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"AutoTuner"};
+constexpr Milliseconds settleTime{500};
+constexpr Seconds measureTime{2};
+constexpr int8_t minSoundBuffers = 1;
+
+AutoTuner::AutoTuner(EmuApp &app):
+	app{app},
+	stepTimer
+	{
+		"AutoTuner::stepTimer",
+		[this]()
+		{
+			step();
+			return false;
+		}
+	} {}
+
+bool AutoTuner::start()
+{
+	if(isRunning() || !app.system().hasContent())
+		return false;
+	originalConfig = currentConfig();
+	candidates.clear();
+	for(auto src : {FrameTimeSource::Screen, FrameTimeSource::Timer, FrameTimeSource::Renderer})
+	{
+		if(src == FrameTimeSource::Screen && !app.emuWindow().screen()->supportsTimestamps())
+			continue;
+		for(auto pipeline : {false, true})
+		{
+			candidates.emplace_back(src, pipeline, originalConfig.soundBuffers);
+		}
+	}
+	frameCandidates = candidates.size();
+	candidateIdx = 0;
+	best = {};
+	foundStable = measuring = false;
+	telemetryWasEnabled = app.frameTimeTelemetry.isEnabled();
+	app.frameTimeTelemetry.setEnabled(true);
+	log.info("starting with {} candidates", candidates.size());
+	apply(candidates[0]);
+	stepTimer.runIn(settleTime);
+	app.postMessage(3, false, "Measuring frame timing configurations, please wait");
+	return true;
+}
+
+void AutoTuner::cancel()
+{
+	if(!isRunning())
+		return;
+	log.info("canceled");
+	stepTimer.cancel();
+	candidates.clear();
+	apply(originalConfig);
+	app.frameTimeTelemetry.setEnabled(telemetryWasEnabled);
+}
+
+AutoTuner::Config AutoTuner::currentConfig() const
+{
+	return {app.frameTimeSource, app.pipelineFrames, app.audio.soundBuffers};
+}
+
+void AutoTuner::apply(Config c)
+{
+	bool frameTimeSourceChanged = c.frameTimeSource != app.frameTimeSource;
+	app.frameTimeSource = c.frameTimeSource;
+	app.pipelineFrames = c.pipelineFrames;
+	app.audio.soundBuffers = c.soundBuffers;
+	if(frameTimeSourceChanged)
+		app.video.resetImage(); // texture can switch between single/double buffered
+}
+
+void AutoTuner::restartWith(Config c)
+{
+	// the frame handler is removed using the current frame time source so pause before changing it
+	app.pauseEmulation();
+	apply(c);
+	auto &win = app.emuWindow();
+	win.configureFrameTimeSource(app.frameTimeSource);
+	app.setIntendedFrameRate(win, app.configFrameTime());
+	app.startEmulation();
+}
+
+void AutoTuner::step()
+{
+	if(!measuring)
+	{
+		// start counting once the new configuration had time to settle
+		app.frameTimeTelemetry.clear();
+		underrunsAtStart = app.audio.underrunCount();
+		measuring = true;
+		stepTimer.runIn(measureTime);
+		return;
+	}
+	measuring = false;
+	evaluate();
+	if(++candidateIdx < frameCandidates)
+	{
+		restartWith(candidates[candidateIdx]);
+	}
+	else if(foundStable && (candidateIdx == frameCandidates || lastStable)
+		&& best.config.soundBuffers > minSoundBuffers && !candidates.isFull())
+	{
+		// try less audio latency with the chosen frame timing
+		auto c = best.config;
+		c.soundBuffers--;
+		candidates.emplace_back(c);
+		restartWith(c);
+	}
+	else
+	{
+		finish();
+		return;
+	}
+	stepTimer.runIn(settleTime);
+}
+
+void AutoTuner::evaluate()
+{
+	auto &telemetry = app.frameTimeTelemetry;
+	const auto &c = candidates[candidateIdx];
+	auto frames = telemetry.frames();
+	auto expectedFrames = FloatSeconds{measureTime}.count() * app.system().frameRate() / std::max(int(app.frameInterval), 1);
+	auto missed = telemetry.missedFrameCallbacks();
+	auto underruns = app.audio.underrunCount() - underrunsAtStart;
+	// without input during the run, the frame start to present time stands in for input latency
+	SteadyClockTime latency = telemetry.histogram(FrameTimeMetric::frame).percentile(.95);
+	lastStable = frames && frames >= expectedFrames * .95 && missed <= frames / 100 && !underruns;
+	log.info("{} frame clock, pipelining:{}, sound buffers:{} -> frames:{}/{:.0f} missed:{} underruns:{} latency:{}{}",
+		wise_enum::to_string(c.frameTimeSource), c.pipelineFrames, c.soundBuffers,
+		frames, expectedFrames, missed, underruns, duration_cast<Microseconds>(latency), lastStable ? "" : " (unstable)");
+	if(!lastStable)
+		return;
+	// candidates with fewer audio buffers are only tried on the best one so they win by being stable
+	if(!foundStable || candidateIdx >= frameCandidates || latency < best.latency)
+	{
+		best = {c, latency};
+		foundStable = true;
+	}
+}
+
+void AutoTuner::finish()
+{
+	candidates.clear();
+	app.frameTimeTelemetry.setEnabled(telemetryWasEnabled);
+	if(!foundStable)
+	{
+		log.info("no stable configuration");
+		restartWith(originalConfig);
+		app.postErrorMessage(4, "No stable configuration found, kept current settings");
+		return;
+	}
+	auto &c = best.config;
+	log.info("chose {} frame clock, pipelining:{}, sound buffers:{}", wise_enum::to_string(c.frameTimeSource), c.pipelineFrames, c.soundBuffers);
+	restartWith(c);
+	app.postMessage(4, false, std::format("Using {} frame clock, {} pipelining, {} sound buffers",
+		wise_enum::to_string(c.frameTimeSource), c.pipelineFrames ? "with" : "without", c.soundBuffers));
+}
+
+}
@@ -20,6 +20,7 @@
 #include "pathUtils.hh"
 #include <imagine/io/MapIO.hh>
 #include <imagine/io/FileIO.hh>
+#include <imagine/util/zlib.hh>
 #include <imagine/logger/logger.h>
 
 namespace EmuEx
@@ -51,13 +52,35 @@ bool AutosaveManager::save(AutosaveActionSource src)
 	system().flushBackupMemory(app);
 	if(saveOnlyBackupMemory && src == AutosaveActionSource::Auto)
 		return true;
+	if(src == AutosaveActionSource::Auto && stateUnchangedSinceSave())
+	{
+		log.info("autosave state unchanged since last save");
+		return true;
+	}
 	return saveState();
 }
 
+// Hashes the system's state sections, if it provides them, to catch timer and
+// exit autosaves when no frames ran since the last one, such as while paused
+bool AutosaveManager::stateUnchangedSinceSave()
+{
+	auto &sys = system();
+	if(!sys.hasStateSections())
+		return false;
+	app.syncEmulationThread();
+	auto hash = crc32(0, nullptr, 0);
+	sys.forEachStateSection([&](StateSection s) { hash = crc32_z(hash, s.data.data(), s.data.size()); });
+	bool unchanged = lastStateHash == uint32_t(hash);
+	lastStateHash = hash;
+	return unchanged;
+}
+
 bool AutosaveManager::load(AutosaveActionSource src, LoadAutosaveMode mode)
 {
 	if(autoSaveSlot == noAutosaveName)
 		return true;
+	app.stateSaveWorker.wait();
+	app.backupMemoryWriter.wait(); // pending writes may use the file loadBackupMemory() reopens
 	try
 	{
 		system().loadBackupMemory(app);
@@ -92,20 +115,56 @@ bool AutosaveManager::load(AutosaveActionSource src, LoadAutosaveMode mode)
 
 bool AutosaveManager::saveState()
 {
+	if(useMappedState && saveMappedState())
+		return true;
 	log.info("saving autosave state");
-	stateIO.truncate(0);
-	auto state = app.saveState();
-	if(stateIO.write(state.span(), 0).bytes != ssize_t(state.size()))
+	if(stateIO.map().size())
+		reopenStateIO(); // switching away from the mapped backend
+	auto job = app.makeStateSaveJob();
+	job.sharedFile = &stateIO;
+	job.errorMsg = "Error writing autosave state";
+	app.stateSaveWorker.push(std::move(job));
+	return true;
+}
+
+// Writes the uncompressed state directly into a shared mapping of the autosave file,
+// only touched pages become dirty and the OS writes them back on its own schedule
+bool AutosaveManager::saveMappedState()
+{
+	auto &sys = system();
+	app.syncEmulationThread();
+	app.stateSaveWorker.wait();
+	auto size = sys.stateSize();
+	if(stateIO.map().size() != size)
 	{
-		app.postErrorMessage(4, "Error writing autosave state");
-		return false;
+		reopenStateIO();
+		if(!stateIO.truncate(size) || !stateIO.tryMap(OpenFlags::createFile()))
+		{
+			log.warn("unable to map autosave state, using normal writes");
+			return false;
+		}
+	}
+	log.info("saving mapped autosave state");
+	auto written = sys.writeState(stateIO.map(), {.uncompressed = true});
+	if(written != size)
+	{
+		// state is smaller than the mapping, trim the file so it doesn't end with stale data
+		reopenStateIO();
+		stateIO.truncate(written);
 	}
 	return true;
 }
 
+void AutosaveManager::reopenStateIO()
+{
+	stateIO = {};
+	stateIO = appContext().openFileUri(statePath(), OpenFlags::createFile());
+}
+
 bool AutosaveManager::loadState()
 {
 	log.info("loading autosave state");
+	lastStateHash = {};
 	try
 	{
 		app.readState(stateIO.buffer(IOBufferMode::Direct));
@@ -133,6 +192,16 @@ bool AutosaveManager::setSlot(std::string_view name)
 	return load();
 }
 
+void AutosaveManager::resetSlot(std::string_view name)
+{
+	// pending autosave writes reference stateIO
+	app.stateSaveWorker.wait();
+	autoSaveSlot = name;
+	saveTimer.cancel();
+	stateIO = {};
+	lastStateHash = {};
+}
+
 bool AutosaveManager::renameSlot(std::string_view name, std::string_view newName)
 {
 	if(!appContext().renameFileUri(system().contentLocalSaveDirectory(name),
@@ -248,6 +317,7 @@ bool AutosaveManager::readConfig(MapIO &io, unsigned key)
 				saveTimer.frequency = mins;
 		});
 		case CFGKEY_AUTOSAVE_CONTENT: return readOptionValue(io, saveOnlyBackupMemory);
+		case CFGKEY_AUTOSAVE_MAPPED_STATE: return readOptionValue(io, useMappedState);
 	}
 }
 
@@ -256,6 +326,7 @@ void AutosaveManager::writeConfig(FileIO &io) const
 	writeOptionValueIfNotDefault(io, CFGKEY_AUTOSAVE_LAUNCH_MODE, autosaveLaunchMode, AutosaveLaunchMode::Load);
 	writeOptionValueIfNotDefault(io, CFGKEY_AUTOSAVE_TIMER_MINS, saveTimer.frequency.count(), defaultSaveFreq.count());
 	writeOptionValueIfNotDefault(io, CFGKEY_AUTOSAVE_CONTENT, saveOnlyBackupMemory, false);
+	writeOptionValueIfNotDefault(io, CFGKEY_AUTOSAVE_MAPPED_STATE, useMappedState, false);
 }
 
 ApplicationContext AutosaveManager::appContext() const { return system().appContext(); }
@@ -0,0 +1,136 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/BackupMemoryWriter.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <cstring>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"BackupMemoryWriter"};
+constexpr size_t maxFreeBuffers = 2;
+
+void BackupMemoryWriter::push(FileIO &file, std::span<const uint8_t> data, size_t offset)
+{
+	std::scoped_lock lock{mutex};
+	if(!thread.joinable())
+	{
+		quit = false;
+		thread = std::thread{[this]{ run(); }};
+	}
+	auto it = std::ranges::find_if(jobs, [&](const Job &j){ return j.file == &file && j.offset == offset; });
+	Job *job{};
+	if(it != jobs.end())
+	{
+		job = &*it;
+	}
+	else
+	{
+		job = &jobs.emplace_back(&file, DynArray<uint8_t>{}, 0, offset);
+		if(freeBuffers.size())
+		{
+			job->data = std::move(freeBuffers.back());
+			freeBuffers.pop_back();
+		}
+	}
+	if(job->data.size() < data.size())
+		job->data = dynArrayForOverwrite<uint8_t>(data.size());
+	std::memcpy(job->data.data(), data.data(), data.size());
+	job->size = data.size();
+	jobCond.notify_one();
+}
+
+void BackupMemoryWriter::wait()
+{
+	std::unique_lock lock{mutex};
+	idleCond.wait(lock, [&]{ return jobs.empty() && !isWorking; });
+}
+
+void BackupMemoryWriter::stop()
+{
+	if(!thread.joinable())
+		return;
+	{
+		std::scoped_lock lock{mutex};
+		quit = true;
+		jobCond.notify_one();
+	}
+	thread.join();
+}
+
+void BackupMemoryWriter::setCPUAffinityMask(CPUMask mask)
+{
+	std::scoped_lock lock{mutex};
+	cpuMask = mask;
+	if(threadId)
+		setThreadCPUAffinityMask(std::span{&threadId, 1}, mask);
+}
+
+void BackupMemoryWriter::run()
+{
+	log.info("starting thread");
+	std::vector<Job> batch;
+	std::vector<FileIO*> writtenFiles;
+	std::unique_lock lock{mutex};
+	threadId = thisThreadId();
+	if(cpuMask)
+		setThreadCPUAffinityMask(std::span{&threadId, 1}, cpuMask);
+	while(true)
+	{
+		jobCond.wait(lock, [&]{ return jobs.size() || quit; });
+		// finish all queued writes before exiting so no save data is lost
+		if(jobs.empty())
+			break;
+		std::swap(batch, jobs);
+		isWorking = true;
+		lock.unlock();
+		writtenFiles.clear();
+		for(auto &job : batch)
+		{
+			if(job.file->write(std::span<const uint8_t>{job.data.data(), job.size}, job.offset).bytes != ssize_t(job.size))
+				log.error("error writing {} bytes of backup memory", job.size);
+			if(std::ranges::find(writtenFiles, job.file) == writtenFiles.end())
+				writtenFiles.emplace_back(job.file);
+		}
+		if(syncFiles)
+		{
+			for(auto file : writtenFiles)
+			{
+				file->sync();
+			}
+			log.info("wrote {} backup memory region(s) to {} file(s)", batch.size(), writtenFiles.size());
+		}
+		else
+		{
+			log.debug("wrote {} region(s) to {} file(s)", batch.size(), writtenFiles.size());
+		}
+		lock.lock();
+		for(auto &job : batch)
+		{
+			if(freeBuffers.size() < maxFreeBuffers)
+				freeBuffers.emplace_back(std::move(job.data));
+		}
+		batch.clear();
+		isWorking = false;
+		if(jobs.empty())
+			idleCond.notify_all();
+	}
+	threadId = {};
+	log.info("exiting thread");
+}
+
+}
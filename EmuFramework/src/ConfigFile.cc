@@ -52,9 +52,12 @@ void EmuApp::saveConfigFile(FileIO &io)
 	writeOptionValueIfNotDefault(io, hidesStatusBar);
 	writeOptionValueIfNotDefault(io, showsBundledGames);
 	writeOptionValueIfNotDefault(io, frameInterval);
+	writeOptionValueIfNotDefault(io, predictiveFrameSkip);
+	writeOptionValueIfNotDefault(io, batchFrameInterval);
 	writeOptionValueIfNotDefault(io, frameTimeSource);
 	writeOptionValueIfNotDefault(io, idleDisplayPowerSave);
 	writeOptionValueIfNotDefault(io, confirmOverwriteState);
+	writeOptionValueIfNotDefault(io, stateCompression);
 	writeOptionValueIfNotDefault(io, systemActionsIsDefaultMenu);
 	writeOptionValueIfNotDefault(io, pauseUnfocused);
 	writeOptionValueIfNotDefault(io, emuOrientation);
@@ -85,17 +88,27 @@ void EmuApp::saveConfigFile(FileIO &io)
 	writeOptionValueIfNotDefault(io, CFGKEY_VIDEO_LANDSCAPE_OFFSET, videoLayer.landscapeOffset, 0);
 	writeOptionValueIfNotDefault(io, CFGKEY_VIDEO_PORTRAIT_OFFSET, videoLayer.portraitOffset, 0);
 	writeOptionValueIfNotDefault(io, fastModeSpeed);
+	writeOptionValueIfNotDefault(io, fastModeMaxThroughput);
 	writeOptionValueIfNotDefault(io, slowModeSpeed);
 	writeOptionValueIfNotDefault(io, CFGKEY_FRAME_RATE, outputTimingManager.frameTimeOption(VideoSystem::NATIVE_NTSC), OutputTimingManager::autoOption);
 	writeOptionValueIfNotDefault(io, CFGKEY_FRAME_RATE_PAL, outputTimingManager.frameTimeOption(VideoSystem::PAL), OutputTimingManager::autoOption);
 	inputManager.vController.writeConfig(io);
 	autosaveManager.writeConfig(io);
 	rewindManager.writeConfig(io);
+	archiveCache.writeConfig(io);
+	thermalGovernor.writeConfig(io);
+	runAheadManager.writeConfig(io);
+	frameTimeTelemetry.writeConfig(io);
 	audio.writeConfig(io);
 	videoLayer.writeConfig(io);
 	if(overrideScreenFrameRate)
 		writeOptionValue(io, CFGKEY_OVERRIDE_SCREEN_FRAME_RATE, overrideScreenFrameRate);
 	writeOptionValueIfNotDefault(io, allowBlankFrameInsertion);
+	writeOptionValueIfNotDefault(io, pacedFrameTiming);
+	writeOptionValueIfNotDefault(io, pipelineFrames);
+	if(EmuSystem::canRenderPaletteIndices)
+		writeOptionValueIfNotDefault(io, gpuPaletteConversion);
+	writeOptionValueIfNotDefault(io, partialFrameUpload);
 	if(Config::Bluetooth::scanCache && !bluetoothAdapter.useScanCache)
 		writeOptionValue(io, CFGKEY_BLUETOOTH_SCAN_CACHE, false);
 	writeOptionValueIfNotDefault(io, cpuAffinityMask);
@@ -158,6 +171,14 @@ EmuApp::ConfigParams EmuApp::loadConfigFile(IG::ApplicationContext ctx)
 						return true;
 					if(rewindManager.readConfig(io, key))
 						return true;
+					if(archiveCache.readConfig(io, key))
+						return true;
+					if(thermalGovernor.readConfig(io, key))
+						return true;
+					if(runAheadManager.readConfig(io, key))
+						return true;
+					if(frameTimeTelemetry.readConfig(io, key))
+						return true;
 					if(audio.readConfig(io, key))
 						return true;
 					if(recentContent.readConfig(io, key, system()))
@@ -168,6 +189,8 @@ EmuApp::ConfigParams EmuApp::loadConfigFile(IG::ApplicationContext ctx)
 					return false;
 				}
 				case CFGKEY_FRAME_INTERVAL: return readOptionValue(io, frameInterval);
+				case CFGKEY_PREDICTIVE_FRAME_SKIP: return readOptionValue(io, predictiveFrameSkip);
+				case CFGKEY_BATCH_FRAME_INTERVAL: return readOptionValue(io, batchFrameInterval);
 				case CFGKEY_FRAME_RATE: return readOptionValue<FrameTime>(io, [&](auto &&val){outputTimingManager.setFrameTimeOption(VideoSystem::NATIVE_NTSC, val);});
 				case CFGKEY_FRAME_RATE_PAL: return readOptionValue<FrameTime>(io, [&](auto &&val){outputTimingManager.setFrameTimeOption(VideoSystem::PAL, val);});
 				case CFGKEY_LAST_DIR:
@@ -193,7 +216,9 @@ EmuApp::ConfigParams EmuApp::loadConfigFile(IG::ApplicationContext ctx)
 				case CFGKEY_LAYOUT_BEHIND_SYSTEM_UI:
 					return ctx.hasTranslucentSysUI() ? readOptionValue(io, layoutBehindSystemUI) : false;
 				case CFGKEY_CONFIRM_OVERWRITE_STATE: return readOptionValue(io, confirmOverwriteState);
+				case CFGKEY_STATE_COMPRESSION: return readOptionValue(io, stateCompression);
 				case CFGKEY_FAST_MODE_SPEED: return readOptionValue(io, fastModeSpeed);
+				case CFGKEY_FAST_MODE_MAX_THROUGHPUT: return readOptionValue(io, fastModeMaxThroughput);
 				case CFGKEY_SLOW_MODE_SPEED: return readOptionValue(io, slowModeSpeed);
 				case CFGKEY_NOTIFY_INPUT_DEVICE_CHANGE: return readOptionValue(io, notifyOnInputDeviceChange);
 				case CFGKEY_MOGA_INPUT_SYSTEM:
@@ -225,6 +250,10 @@ EmuApp::ConfigParams EmuApp::loadConfigFile(IG::ApplicationContext ctx)
 				case CFGKEY_SHOW_HIDDEN_FILES: return readOptionValue(io, showHiddenFilesInPicker);
 				case CFGKEY_OVERRIDE_SCREEN_FRAME_RATE: return readOptionValue(io, overrideScreenFrameRate);
 				case CFGKEY_BLANK_FRAME_INSERTION: return readOptionValue(io, allowBlankFrameInsertion);
+				case CFGKEY_PACED_FRAME_TIMING: return readOptionValue(io, pacedFrameTiming);
+				case CFGKEY_PIPELINE_FRAMES: return readOptionValue(io, pipelineFrames);
+				case CFGKEY_GPU_PALETTE_CONVERSION: return EmuSystem::canRenderPaletteIndices ? readOptionValue(io, gpuPaletteConversion) : false;
+				case CFGKEY_PARTIAL_FRAME_UPLOAD: return readOptionValue(io, partialFrameUpload);
 				case CFGKEY_CONTENT_ROTATION: return readOptionValue(io, contentRotation);
 				case CFGKEY_VIDEO_LANDSCAPE_ASPECT_RATIO: return readOptionValue(io, videoLayer.landscapeAspectRatio, isValidAspectRatio);
 				case CFGKEY_VIDEO_PORTRAIT_ASPECT_RATIO: return readOptionValue(io, videoLayer.portraitAspectRatio, isValidAspectRatio);
@@ -0,0 +1,52 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+
+#include <emuframework/DirtyLineTracker.hh>
+#include <imagine/util/utility.h>
+#include <algorithm>
+#include <cstring>
+
+namespace EmuEx
+{
+
+DirtyLineTracker::DirtyLineTracker(int lines, size_t lineBytes):
+	lastFrame(lines * lineBytes),
+	lineBytes{lineBytes},
+	lines{int16_t(lines)},
+	dirtyStart{int16_t(lines)} {}
+
+void DirtyLineTracker::updateLine(int line, const void *data)
+{
+	assumeExpr(line >= 0 && line < lines);
+	auto lastLine = &lastFrame[line * lineBytes];
+	if(!std::memcmp(lastLine, data, lineBytes))
+		return;
+	std::memcpy(lastLine, data, lineBytes);
+	dirtyStart = std::min(dirtyStart, int16_t(line));
+	dirtyEnd = std::max(dirtyEnd, int16_t(line + 1));
+}
+
+DirtyLineRange DirtyLineTracker::takeRange()
+{
+	DirtyLineRange range{dirtyStart, dirtyEnd};
+	if(range.start >= range.end)
+		range = {0, 0};
+	dirtyStart = lines;
+	dirtyEnd = 0;
+	return range;
+}
+
+}
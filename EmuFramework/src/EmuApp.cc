@@ -29,6 +29,7 @@
 #include <emuframework/VideoOptionView.hh>
 #include <emuframework/FilePathOptionView.hh>
 #include <emuframework/AppKeyCode.hh>
+#include <emuframework/StageProfiler.hh>
 #include "gui/AutosaveSlotView.hh"
 #include "InputDeviceData.hh"
 #include "WindowData.hh"
@@ -39,6 +40,7 @@
 #include <imagine/fs/FS.hh>
 #include <imagine/fs/ArchiveFS.hh>
 #include <imagine/io/IO.hh>
+#include <imagine/io/FileIO.hh>
 #include <imagine/gfx/Renderer.hh>
 #include <imagine/gfx/RendererTask.hh>
 #include <imagine/gui/ToastView.hh>
@@ -48,10 +50,17 @@
 #include <imagine/util/ScopeGuard.hh>
 #include <imagine/util/format.hh>
 #include <imagine/util/string.h>
+#include <imagine/util/zlib.hh>
+#include <imagine/util/memory/MemoryAccounting.hh>
 #include <imagine/thread/Thread.hh>
 #include <imagine/bluetooth/BluetoothInputDevice.hh>
 #include <imagine/input/android/MogaManager.hh>
+#include <bit>
 #include <cmath>
+#include <cstdio>
+#if __has_include(<sys/resource.h>)
+#include <sys/resource.h>
+#endif
 
 namespace EmuEx
 {
@@ -95,6 +104,7 @@ EmuApp::EmuApp(ApplicationInitParams initParams, ApplicationContext &ctx):
 	audio{ctx},
 	videoLayer{video, defaultVideoAspectRatio()},
 	inputManager{ctx},
+	archiveCache{ctx},
 	vibrationManager{ctx},
 	pixmapReader{ctx},
 	pixmapWriter{ctx},
@@ -195,30 +205,51 @@ const Window &EmuApp::emuWindow() const { return viewController().emuWindow(); }
 
 void EmuApp::setCPUNeedsLowLatency(IG::ApplicationContext ctx, bool needed)
 {
+	if(needed)
+		applyGameMode(ctx);
+	ctx.setGameState(false, needed);
+	// battery mode lets the CPU idle between frames instead of keeping it busy or at sustained clocks
+	bool isBatteryMode = gameMode == GameMode::battery;
 	#ifdef __ANDROID__
 	if(useNoopThread)
-		ctx.setNoopThreadActive(needed);
+		ctx.setNoopThreadActive(needed && !isBatteryMode);
 	#endif
-	if(useSustainedPerformanceMode)
-		ctx.setSustainedPerformanceMode(needed);
+	if(useSustainedPerformanceMode || gameMode == GameMode::performance)
+		ctx.setSustainedPerformanceMode(needed && !isBatteryMode);
 	applyCPUAffinity(needed);
 }
 
+void EmuApp::applyGameMode(IG::ApplicationContext ctx)
+{
+	auto mode = ctx.gameMode();
+	if(mode == gameMode)
+		return;
+	log.info("game mode changed from {} to {}", int(gameMode), int(mode));
+	gameMode = mode;
+	thermalGovernor.setMinTier(mode == GameMode::battery ? ThermalTier::NoImageEffect : ThermalTier::Nominal);
+}
+
 static void suspendEmulation(EmuApp &app)
 {
 	if(!app.system().hasContent())
 		return;
 	app.autosaveManager.save();
 	app.system().flushBackupMemory(app);
+	app.stateSaveWorker.wait();
+	app.backupMemoryWriter.wait();
 }
 
 void EmuApp::closeSystem()
 {
 	showUI();
 	emuSystemTask.stop();
+	thermalGovernor.reset();
 	system().closeRuntimeSystem(*this);
 	autosaveManager.resetSlot();
 	rewindManager.clear();
+	inputReplay.stopRecording();
+	ramSearch.reset();
+	guestMemoryCharge.set(0);
 	viewController().onSystemClosed();
 }
 
@@ -263,15 +294,220 @@ void EmuApp::showExitAlert(ViewAttachParams attach, const Input::Event &e)
 		attach, system().hasContent()), e, false);
 }
 
-static const char *parseCommandArgs(IG::CommandArgs arg)
+struct CommandLineOptions
 {
-	if(arg.c < 2)
+	const char *launchPath{};
+	const char *replayPath{};
+	const char *loadStatePath{};
+	const char *saveStatePath{};
+	int benchmarkFrames{};
+};
+
+static CommandLineOptions parseCommandArgs(IG::CommandArgs arg)
+{
+	CommandLineOptions opts;
+	for(int i = 1; i < arg.c; i++)
 	{
-		return nullptr;
+		if(std::string_view{arg.v[i]} == "--bench" && i + 1 < arg.c)
+		{
+			opts.benchmarkFrames = std::max(int(std::strtol(arg.v[++i], nullptr, 10)), 1);
+		}
+		else if(std::string_view{arg.v[i]} == "--replay" && i + 1 < arg.c)
+		{
+			opts.replayPath = arg.v[++i];
+		}
+		else if(std::string_view{arg.v[i]} == "--load-state" && i + 1 < arg.c)
+		{
+			opts.loadStatePath = arg.v[++i];
+		}
+		else if(std::string_view{arg.v[i]} == "--save-state" && i + 1 < arg.c)
+		{
+			opts.saveStatePath = arg.v[++i];
+		}
+		else if(!opts.launchPath)
+		{
+			opts.launchPath = arg.v[i];
+		}
+	}
+	if(opts.launchPath)
+		log.info("starting content from command line:{}", opts.launchPath);
+	return opts;
+}
+
+static size_t peakResidentSetKiB()
+{
+	#if __has_include(<sys/resource.h>)
+	rusage usage{};
+	if(getrusage(RUSAGE_SELF, &usage) == 0)
+		return usage.ru_maxrss;
+	#endif
+	return 0;
+}
+
+static size_t guestMemoryBytes(EmuSystem &sys)
+{
+	size_t bytes{};
+	sys.forEachStateSection([&](StateSection s) { bytes += s.data.size(); });
+	return bytes;
+}
+
+static void printMemoryAccounting()
+{
+	for(auto [cat, name] : wise_enum::range<MemoryCategory>)
+	{
+		std::fputs(std::format("memory {}: {} KiB, peak {} KiB\n", name,
+			MemoryAccounting::current(cat) / 1024, MemoryAccounting::peak(cat) / 1024).c_str(), stdout);
+	}
+}
+
+// the benchmark runs frames back to back so power is drawn for the whole run,
+// scale the measured energy up to it in case some intervals were skipped
+static void printEnergy(const EnergyMeter &energy, int frames, SteadyClockTime elapsed)
+{
+	if(energy.hasPower())
+	{
+		auto joules = energy.averageWatts() * duration_cast<FloatSeconds>(elapsed).count();
+		std::fputs(std::format("energy: {:.3f} mJ/frame, {:.2f} W average over {:.1f}s measured\n",
+			joules * 1000. / frames, energy.averageWatts(), duration_cast<FloatSeconds>(energy.measuredTime()).count()).c_str(), stdout);
+	}
+	else
+	{
+		std::fputs("energy: battery power not available, run on battery power to measure\n", stdout);
+	}
+	auto residency = energy.cpuFreqResidency();
+	for(auto policy = -1; auto &r : residency)
+	{
+		if(r.policy == policy)
+			continue;
+		policy = r.policy;
+		SteadyClockTime total{};
+		for(auto &p : residency)
+		{
+			if(p.policy == policy)
+				total += p.time;
+		}
+		std::string line = std::format("cpufreq policy{}:", policy);
+		for(auto &p : residency)
+		{
+			if(p.policy == policy)
+				std::format_to(std::back_inserter(line), " {} MHz {:.1f}%,", p.kHz / 1000, 100. * p.time.count() / total.count());
+		}
+		line.back() = '\n';
+		std::fputs(line.c_str(), stdout);
+	}
+}
+
+static bool writeFinalState(EmuSystem &sys, const char *saveStatePath)
+{
+	if(!saveStatePath)
+		return true;
+	try
+	{
+		sys.saveState(saveStatePath);
+		return true;
+	}
+	catch(std::exception &err)
+	{
+		std::fputs(std::format("error saving state {}: {}\n", saveStatePath, err.what()).c_str(), stderr);
+		return false;
+	}
+}
+
+int EmuApp::runBenchmark(CStringView path, int frames, const char *loadStatePath, const char *saveStatePath)
+{
+	auto &sys = system();
+	try
+	{
+		sys.createWithMedia({}, path, appContext().fileUriDisplayName(path), {},
+			[](int, int, const char *){ return true; });
+	}
+	catch(std::exception &err)
+	{
+		std::fputs(std::format("error loading {}: {}\n", path, err.what()).c_str(), stderr);
+		return 1;
+	}
+	if(loadStatePath)
+	{
+		try
+		{
+			sys.loadState(*this, loadStatePath);
+		}
+		catch(std::exception &err)
+		{
+			std::fputs(std::format("error loading state {}: {}\n", loadStatePath, err.what()).c_str(), stderr);
+			return 1;
+		}
+	}
+	guestMemoryCharge.set(guestMemoryBytes(sys));
+	sys.configFrameTime(audio.rate(), sys.frameTime());
+	log.info("running {} benchmark frames", frames);
+	EnergyMeter energy;
+	energy.reset();
+	auto startTime = SteadyClock::now();
+	for(auto i : iotaCount(frames))
+	{
+		sys.runFrame({}, nullptr, nullptr);
+		energy.sample(appContext(), SteadyClock::now());
+	}
+	auto elapsed = SteadyClock::now() - startTime;
+	auto secs = duration_cast<FloatSeconds>(elapsed).count();
+	std::fputs(std::format("{}: {} frames in {:.3f}s, {:.1f} frames/sec, {} ns/frame, peak RSS {} KiB\n",
+		sys.contentDisplayName(), frames, secs, frames / secs,
+		duration_cast<Nanoseconds>(elapsed).count() / frames, peakResidentSetKiB()).c_str(), stdout);
+	printEnergy(energy, frames, elapsed);
+	printMemoryAccounting();
+	return writeFinalState(sys, saveStatePath) ? 0 : 1;
+}
+
+int EmuApp::runReplay(CStringView path, CStringView replayPath, const char *saveStatePath)
+{
+	auto &sys = system();
+	try
+	{
+		FileIO replayFile{replayPath, {.accessHint = IOAccessHint::All}};
+		inputReplay.read(replayFile);
+		sys.createWithMedia({}, path, appContext().fileUriDisplayName(path), {},
+			[](int, int, const char *){ return true; });
+		sys.configFrameTime(audio.rate(), sys.frameTime());
+		inputReplay.rewind(*this, sys);
+	}
+	catch(std::exception &err)
+	{
+		std::fputs(std::format("error starting replay {}: {}\n", replayPath, err.what()).c_str(), stderr);
+		return 1;
+	}
+	// no framebuffer exists without a renderer, so each frame is checked by the CRC
+	// of its uncompressed save state and of the audio samples the system produced
+	uLong audioCrc = crc32(0, nullptr, 0);
+	audio.onWriteFrames = [&](std::span<const uint8_t> samples)
+	{
+		audioCrc = crc32(audioCrc, samples.data(), samples.size());
+	};
+	DynArray<uint8_t> stateBuff;
+	uLong runCrc = crc32(0, nullptr, 0);
+	SteadyClockTime elapsed{};
+	auto frames = inputReplay.frames();
+	log.info("replaying {} frames", frames);
+	std::fputs("frame,state_crc32,audio_crc32\n", stdout);
+	for(auto i : iotaCount(frames))
+	{
+		inputReplay.applyActions(*this, sys, i);
+		auto startTime = SteadyClock::now();
+		sys.runFrame({}, nullptr, &audio);
+		elapsed += SteadyClock::now() - startTime;
+		if(auto size = sys.stateSize(); stateBuff.size() < size)
+			stateBuff = dynArrayForOverwrite<uint8_t>(size);
+		auto stateSize = sys.writeState(stateBuff, {.uncompressed = true});
+		auto stateCrc = crc32(0, stateBuff.data(), stateSize);
+		runCrc = crc32(runCrc, reinterpret_cast<const Bytef*>(&stateCrc), sizeof(stateCrc));
+		std::fputs(std::format("{},{:08x},{:08x}\n", i, stateCrc, audioCrc).c_str(), stdout);
 	}
-	auto launchPath = arg.v[1];
-	log.info("starting content from command line:{}", launchPath);
-	return launchPath;
+	audio.onWriteFrames = {};
+	auto secs = duration_cast<FloatSeconds>(elapsed).count();
+	std::fputs(std::format("{}: replayed {} frames in {:.3f}s, {:.1f} frames/sec, {} ns/frame, state crc32 {:08x}, audio crc32 {:08x}, peak RSS {} KiB\n",
+		sys.contentDisplayName(), frames, secs, frames / secs,
+		frames ? duration_cast<Nanoseconds>(elapsed).count() / frames : 0, runCrc, audioCrc, peakResidentSetKiB()).c_str(), stdout);
+	return writeFinalState(sys, saveStatePath) ? 0 : 1;
 }
 
 bool EmuApp::setWindowDrawableConfig(Gfx::DrawableConfig conf)
@@ -394,11 +630,33 @@ static SteadyClockTime targetFrameTime(const Screen &s)
 
 void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::ApplicationContext ctx)
 {
+	startupTime = SteadyClock::now();
 	auto appConfig = loadConfigFile(ctx);
 	system().onOptionsLoaded();
 	loadSystemOptions();
+	logStartupPhase("config loaded");
 	updateLegacySavePathOnStoragePath(ctx, system());
-	system().setInitialLoadPath(parseCommandArgs(initParams.commandArgs()));
+	auto cmdOpts = parseCommandArgs(initParams.commandArgs());
+	if(cmdOpts.benchmarkFrames)
+	{
+		// headless run, exits before any window or audio is created
+		if(!cmdOpts.launchPath)
+		{
+			std::fputs("--bench needs a content path\n", stderr);
+			ctx.exit(1);
+		}
+		ctx.exit(runBenchmark(cmdOpts.launchPath, cmdOpts.benchmarkFrames, cmdOpts.loadStatePath, cmdOpts.saveStatePath));
+	}
+	if(cmdOpts.replayPath)
+	{
+		if(!cmdOpts.launchPath)
+		{
+			std::fputs("--replay needs a content path\n", stderr);
+			ctx.exit(1);
+		}
+		ctx.exit(runReplay(cmdOpts.launchPath, cmdOpts.replayPath, cmdOpts.saveStatePath));
+	}
+	system().setInitialLoadPath(cmdOpts.launchPath);
 	audio.manager.setMusicVolumeControlHint();
 	if(!renderer.supportsColorSpace())
 		windowDrawableConf.colorSpace = {};
@@ -424,6 +682,9 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 					ctx.addNotification(title, title, system().contentDisplayName());
 				}
 			}
+			stateSaveWorker.wait();
+			backupMemoryWriter.wait();
+			screenshotWriter.wait();
 			audio.close();
 			audio.manager.endSession();
 			saveConfigFile(ctx);
@@ -439,10 +700,14 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 	ctx.makeWindow(winConf,
 		[this, appConfig](IG::ApplicationContext ctx, IG::Window &win)
 		{
+			logStartupPhase("window created");
 			renderer.initMainTask(&win, windowDrawableConfig());
 			textureBufferMode = renderer.validateTextureBufferMode(textureBufferMode);
+			logStartupPhase("renderer initialized");
+			// glyphs are only rendered on first use, creating the faces just loads the fonts and metrics
 			viewManager.defaultFace = {renderer, fontManager.makeSystem(), fontSettings(win)};
 			viewManager.defaultBoldFace = {renderer, fontManager.makeBoldSystem(), fontSettings(win)};
+			logStartupPhase("fonts loaded");
 			ViewAttachParams viewAttach{viewManager, win, renderer.task()};
 			auto &vController = inputManager.vController;
 			auto &winData = win.makeAppData<MainWindowData>(viewAttach, vController, videoLayer, system());
@@ -458,6 +723,7 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 			auto &screen = *win.screen();
 			winData.viewController.placeElements();
 			winData.viewController.pushAndShow(makeView(viewAttach, ViewID::MAIN_MENU));
+			logStartupPhase("main menu created");
 			configureSecondaryScreens();
 			video.onFormatChanged =  [this, &viewController = winData.viewController](EmuVideo&)
 			{
@@ -468,7 +734,6 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 			video.setTextureBufferMode(system(), textureBufferMode);
 			videoLayer.setRendererTask(renderer.task());
 			applyRenderPixelFormat();
-			videoLayer.updateEffect(system(), videoEffectPixelFormat());
 			system().onFrameUpdate = [this](FrameParams params)
 			{
 				emuSystemTask.updateFrameParams(params);
@@ -483,7 +748,23 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 					[&](const DrawEvent& e)
 					{
 						record(FrameTimeStatEvent::startOfDraw);
-						auto reportTime = scopeGuard([&]{ reportFrameWorkTime(); });
+						auto reportTime = scopeGuard([&]
+						{
+							reportFrameWorkTime();
+							if(hasTime(startupTime)) [[unlikely]]
+							{
+								logStartupPhase("first frame drawn");
+								startupTime = {};
+								// compile the configured effect while the main menu is up instead of delaying its first frame,
+								// any content started before this runs just shows unprocessed video for a frame
+								appContext().runOnMainThread([this](ApplicationContext)
+								{
+									syncEmulationThread();
+									videoLayer.updateEffect(system(), videoEffectPixelFormat());
+									log.info("compiled startup effect");
+								});
+							}
+						});
 						return viewController().drawMainWindow(win, e.params, renderer.task());
 					},
 					[&](const WindowSurfaceChangeEvent& e)
@@ -619,10 +900,11 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 				launchPathStr.size())
 			{
 				system().setInitialLoadPath("");
-				handleOpenFileCommand(launchPathStr);
+				openContentOnLaunch(launchPathStr);
 			}
 
 			win.show();
+			logStartupPhase("window shown");
 		});
 }
 
@@ -654,13 +936,19 @@ bool EmuApp::advanceFrames(FrameParams frameParams, EmuSystemTask *taskPtr)
 		}
 		frameInfo.advanced = 1;
 	}
+	bool maxThroughput = fastModeMaxThroughput && sys.frameTimeMultiplier < 1.;
+	if(maxThroughput)
+	{
+		// only the presented frame is converted and no audio is processed while fast-forwarding
+		audioPtr = nullptr;
+	}
 	if(!frameInfo.advanced)
 	{
 		if(enableBlankFrameInsertion)
 		{
 			viewCtrl.drawBlankFrame = true;
 			if(taskPtr)
-				taskPtr->framePending = true;
+				taskPtr->pendingFrames++;
 			win.postDraw(1);
 			return true;
 		}
@@ -671,35 +959,70 @@ bool EmuApp::advanceFrames(FrameParams frameParams, EmuSystemTask *taskPtr)
 	{
 		// running at a lower target fps
 		savedAdvancedFrames += frameInfo.advanced;
+		// defer the skipped frames to run in one burst with the presented frame,
+		// letting the thread sleep through the intermediate screen frames
+		if(batchFrameInterval && !sys.shouldFastForward())
+			return false;
 	}
 	else
 	{
-		savedAdvancedFrames = 0;
+		auto deferredFrames = std::exchange(savedAdvancedFrames, 0);
+		if(batchFrameInterval)
+			frameInfo.advanced += deferredFrames;
 		if(!allowFrameSkip)
 		{
 			frameInfo.advanced = 1;
 		}
 	}
 	assumeExpr(frameInfo.advanced > 0);
-	// cap advanced frames if we're falling behind
+	// cap advanced frames if we're falling behind, scaled by the speed when favoring throughput
+	// so a slow wakeup doesn't throttle fast-forward to a few frames per present
 	if(frameInfo.frameTimeDiff > Milliseconds{70})
-		frameInfo.advanced = std::min(frameInfo.advanced, 4);
+		frameInfo.advanced = std::min(frameInfo.advanced, maxThroughput ? int(4. / sys.frameTimeMultiplier) : 4);
+	bool isRewinding = rewindManager.isRewinding();
+	if(isRewinding && !rewindManager.stepRewind(*this, frameInfo.advanced))
+		return false;
 	EmuVideo *videoPtr = savedAdvancedFrames ? nullptr : &video;
+	bool usePredictiveSkip = ((predictiveFrameSkip && gameMode != GameMode::performance) || thermalGovernor.tier() >= ThermalTier::FrameSkip)
+		&& allowFrameSkip && !isRewinding;
+	if(videoPtr && usePredictiveSkip && sys.timing.frameSkipPredictor.shouldSkipVideo(sys.timing.frameTime()))
+	{
+		videoPtr = nullptr;
+	}
 	if(videoPtr)
 	{
 		if(showFrameTimeStats)
 		{
+			frameTimeStats.videoBufferStalls = video.image().bufferStalls();
+			frameTimeStats.thermalTier = thermalGovernor.tier();
+			frameTimeStats.drawStats = renderer.lastFrameDrawStats();
 			viewCtrl.emuView.updateFrameTimeStats(frameTimeStats, frameParams.timestamp);
 		}
+		if(StageProfiler::isEnabled())
+		{
+			if(auto times = StageProfiler::takeTimes(frameParams.timestamp))
+				viewCtrl.emuView.updateStageTimes(*times);
+		}
 		record(FrameTimeStatEvent::startOfFrame, frameParams.timestamp);
 		record(FrameTimeStatEvent::startOfEmulation);
 		win.setDrawEventPriority(Window::drawEventPriorityLocked);
 		if(taskPtr)
-			taskPtr->framePending = true;
+			taskPtr->pendingFrames++;
 	}
-	inputManager.turboActions.update(*this);
 	//log.debug("running {} frame(s), skip:{}", frameInfo.advanced, !videoPtr);
-	runFrames({taskPtr}, videoPtr, audioPtr, frameInfo.advanced);
+	if(perfHintSession)
+		frameWorkStartTime = SteadyClock::now();
+	if(isRewinding)
+	{
+		rewindManager.runRewindFrame(*this, {taskPtr}, videoPtr, audioPtr);
+	}
+	else
+	{
+		auto emulateStartTime = usePredictiveSkip ? SteadyClock::now() : SteadyClockTimePoint{};
+		runFrames({taskPtr}, videoPtr, audioPtr, frameInfo.advanced);
+		if(usePredictiveSkip)
+			sys.timing.frameSkipPredictor.addFrameCost((SteadyClock::now() - emulateStartTime) / frameInfo.advanced, videoPtr);
+	}
 	if(!videoPtr)
 	{
 		reportFrameWorkTime();
@@ -806,15 +1129,43 @@ void EmuApp::handleOpenFileCommand(CStringView path)
 	}
 }
 
+void EmuApp::openContentOnLaunch(CStringView path)
+{
+	if(appContext().fileUriType(path) == FS::file_type::directory)
+	{
+		handleOpenFileCommand(path);
+		return;
+	}
+	// only the main menu exists at this point, so skip straight to loading without resetting the UI
+	auto name = appContext().fileUriDisplayName(path);
+	if(name.empty())
+	{
+		postErrorMessage(std::format("Can't access path name for:\n{}", path));
+		return;
+	}
+	log.info("opening file {} on launch", path);
+	onSelectFileFromPicker({}, path, name, Input::KeyEvent{}, {}, attachParams());
+}
+
+void EmuApp::logStartupPhase(std::string_view phase) const
+{
+	if(!hasTime(startupTime))
+		return;
+	log.info("startup {} at:{}", phase, duration_cast<Milliseconds>(SteadyClock::now() - startupTime));
+}
+
 void EmuApp::runBenchmarkOneShot(EmuVideo &video)
 {
 	log.info("starting benchmark");
-	auto time = system().benchmark(video);
+	auto time = system().benchmark(&video);
+	// also time the same number of skipped frames to show how much of the frame cost is rendering
+	auto skipTime = system().benchmark(nullptr);
 	autosaveManager.resetSlot(noAutosaveName);
 	closeSystem();
 	auto timeSecs = duration_cast<FloatSeconds>(time);
-	log.info("done in:{}", timeSecs);
-	postMessage(2, 0, std::format("{:.2f} fps", 180. / timeSecs.count()));
+	auto skipTimeSecs = duration_cast<FloatSeconds>(skipTime);
+	log.info("done in:{}, skipped frames in:{}", timeSecs, skipTimeSecs);
+	postMessage(2, 0, std::format("{:.2f} fps, {:.2f} fps skipped", 180. / timeSecs.count(), 180. / skipTimeSecs.count()));
 }
 
 void EmuApp::showEmulation()
@@ -841,9 +1192,13 @@ void EmuApp::startEmulation()
 		win.postDraw(1);
 	};
 	frameTimeStats = {};
+	// writing the next frame while the previous one is presented needs a spare video buffer
+	emuSystemTask.maxPendingFrames = pipelineFrames && !enableBlankFrameInsertion && video.isMultiBuffered() ? 2 : 1;
 	emuSystemTask.start();
-	setCPUNeedsLowLatency(appContext(), true);
 	system().start(*this);
+	// after starting the system so threads it starts, like the audio worker, are in the thread group
+	setCPUNeedsLowLatency(appContext(), true);
+	thermalGovernor.start();
 	addOnFrameDelayed();
 }
 
@@ -852,6 +1207,7 @@ void EmuApp::showUI(bool updateTopView)
 	if(!viewController().isShowingEmulation())
 		return;
 	pauseEmulation();
+	autoTuner.cancel();
 	configureAppForEmulation(false);
 	videoLayer.setBrightnessScale(menuVideoBrightnessScale);
 	viewController().showMenuView(updateTopView);
@@ -860,6 +1216,7 @@ void EmuApp::showUI(bool updateTopView)
 void EmuApp::pauseEmulation()
 {
 	setCPUNeedsLowLatency(appContext(), false);
+	thermalGovernor.pause();
 	emuSystemTask.pause();
 	video.onFrameFinished = [](EmuVideo&){};
 	system().pause(*this);
@@ -901,6 +1258,7 @@ void EmuApp::reloadSystem(EmuSystemCreateParams params)
 		return;
 	viewController().popToSystemActionsMenu();
 	emuSystemTask.pause();
+	backupMemoryWriter.wait(); // pending writes refer to the system's files
 	auto ctx = appContext();
 	try
 	{
@@ -921,7 +1279,8 @@ void EmuApp::reloadSystem(EmuSystemCreateParams params)
 void EmuApp::onSystemCreated()
 {
 	updateVideoContentRotation();
-	if(!rewindManager.reset(system().stateSize()))
+	guestMemoryCharge.set(guestMemoryBytes(system()));
+	if(!rewindManager.reset(system().stateSize(), system().frameRate()))
 	{
 		postErrorMessage(4, "Not enough memory for rewind states");
 	}
@@ -1039,11 +1398,39 @@ void EmuApp::setupStaticBackupMemoryFile(FileIO &io, std::string_view ext, size_
 void EmuApp::readState(std::span<uint8_t> buff)
 {
 	syncEmulationThread();
+	stopInputRecording("state load");
 	system().readState(*this, buff);
 	system().clearInputBuffers(viewController().inputView);
 	autosaveManager.resetTimer();
 }
 
+// A replay only holds its starting state and the input after it, so anything else that
+// changes the system state, like a state load, rewind or reset, ends the recording
+void EmuApp::stopInputRecording(std::string_view reason)
+{
+	if(!inputReplay.isRecording())
+		return;
+	syncEmulationThread();
+	inputReplay.stopRecording();
+	auto ctx = appContext();
+	auto path = FS::pathString(FS::createDirectorySegments(ctx.storagePath(), "EmuEx"),
+		std::format("{}-{}.replay", system().contentName(), ctx.formatDateAndTimeAsFilename(WallClock::now())));
+	try
+	{
+		FileIO io{path, OpenFlags::newFile()};
+		if(!inputReplay.write(io))
+			throw std::runtime_error{"write failed"};
+		if(reason.size())
+			postMessage(4, false, std::format("Input recording ended by {}, wrote {} frame replay to {}", reason, inputReplay.frames(), path));
+		else
+			postMessage(4, false, std::format("Wrote {} frame replay to {}", inputReplay.frames(), path));
+	}
+	catch(std::exception &err)
+	{
+		postErrorMessage(4, std::format("Error writing replay: {}", err.what()));
+	}
+}
+
 size_t EmuApp::writeState(std::span<uint8_t> buff, SaveStateFlags flags)
 {
 	syncEmulationThread();
@@ -1056,18 +1443,31 @@ DynArray<uint8_t> EmuApp::saveState()
 	return system().saveState();
 }
 
-bool EmuApp::saveState(CStringView path)
+StateSaveWorker::Job EmuApp::makeStateSaveJob()
+{
+	syncEmulationThread();
+	auto &sys = system();
+	// gzip compression is deferred to the worker thread when the system supports it
+	bool compress = EmuSystem::hasGzipStates;
+	auto buff = stateSaveWorker.allocBuffer(sys.stateSize());
+	auto size = sys.writeState(buff, {.uncompressed = compress, .compression = stateCompression});
+	return {.state = std::move(buff), .size = size, .compression = stateCompression, .compress = compress};
+}
+
+bool EmuApp::saveState(CStringView path, bool notify)
 {
 	if(!system().hasContent())
 	{
 		postErrorMessage("System not running");
 		return false;
 	}
-	syncEmulationThread();
 	log.info("saving state {}", path);
 	try
 	{
-		system().saveState(path);
+		auto job = makeStateSaveJob();
+		job.file = appContext().openFileUri(path, OpenFlags::newFile());
+		job.notifySaved = notify;
+		stateSaveWorker.push(std::move(job));
 		return true;
 	}
 	catch(std::exception &err)
@@ -1077,9 +1477,9 @@ bool EmuApp::saveState(CStringView path)
 	}
 }
 
-bool EmuApp::saveStateWithSlot(int slot)
+bool EmuApp::saveStateWithSlot(int slot, bool notify)
 {
-	return saveState(system().statePath(slot));
+	return saveState(system().statePath(slot), notify);
 }
 
 bool EmuApp::loadState(CStringView path)
@@ -1091,6 +1491,7 @@ bool EmuApp::loadState(CStringView path)
 	}
 	log.info("loading state {}", path);
 	syncEmulationThread();
+	stateSaveWorker.wait();
 	try
 	{
 		system().loadState(*this, path);
@@ -1152,7 +1553,7 @@ std::unique_ptr<YesNoAlertView> EmuApp::makeCloseContentView()
 void EmuApp::resetInput()
 {
 	inputManager.turboModifierActive = false;
-	inputManager.turboActions = {};
+	inputManager.turboActions.clear();
 	setRunSpeed(1.);
 }
 
@@ -1294,7 +1695,7 @@ FrameTimeConfig EmuApp::configFrameTime()
 {
 	std::array<FrameRate, 1> overrideRate{overrideScreenFrameRate};
 	auto supportedRates = overrideScreenFrameRate ? std::span<const FrameRate>{overrideRate.data(), 1} : emuScreen().supportedFrameRates();
-	auto frameTimeConfig = outputTimingManager.frameTimeConfig(system(), supportedRates);
+	auto frameTimeConfig = outputTimingManager.frameTimeConfig(system(), supportedRates, usesVariableRefresh());
 	system().configFrameTime(audio.format().rate, frameTimeConfig.time);
 	system().timing.exactFrameDivisor = 0;
 	if(frameTimeConfig.refreshMultiplier > 0 &&
@@ -1303,14 +1704,28 @@ FrameTimeConfig EmuApp::configFrameTime()
 		system().timing.exactFrameDivisor = std::round(emuScreen().frameRate() / frameTimeConfig.rate);
 		log.info("using exact frame divisor:{}", system().timing.exactFrameDivisor);
 	}
+	system().timing.usePacedFrames = pacedFrameTiming;
 	return frameTimeConfig;
 }
 
 void EmuApp::runFrames(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio, int frames)
 {
-	skipFrames(taskCtx, frames - 1, audio);
-	system().runFrame(taskCtx, video, audio);
+	if(!runAheadManager.runFrames(*this, taskCtx, video, audio, frames))
+	{
+		skipFrames(taskCtx, frames - 1, audio);
+		runFrame(taskCtx, video, audio);
+	}
 	system().updateBackupMemoryCounter();
+	rewindManager.onFramesRun(system(), frames);
+}
+
+void EmuApp::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio)
+{
+	// turbo input is synthesized per emulated frame so its rate doesn't depend on how many
+	// frames each advance runs, and any actions it sends are recorded against the exact frame
+	inputManager.turboActions.update(*this);
+	system().runFrame(taskCtx, video, audio);
+	inputReplay.onFramesRun(1);
 }
 
 void EmuApp::skipFrames(EmuSystemTaskContext taskCtx, int frames, EmuAudio *audio)
@@ -1318,7 +1733,7 @@ void EmuApp::skipFrames(EmuSystemTaskContext taskCtx, int frames, EmuAudio *audi
 	assert(system().hasContent());
 	for(auto i : iotaCount(frames))
 	{
-		system().runFrame(taskCtx, nullptr, audio);
+		runFrame(taskCtx, nullptr, audio);
 	}
 }
 
@@ -1401,7 +1816,8 @@ void EmuApp::setIntendedFrameRate(Window &win, FrameTimeConfig config)
 			log.info("Multiplied intended frame rate to:{:g}", config.rate);
 		}
 	}
-	return win.setIntendedFrameRate(overrideScreenFrameRate ? FrameRate(overrideScreenFrameRate) : config.rate);
+	return win.setIntendedFrameRate(overrideScreenFrameRate ? FrameRate(overrideScreenFrameRate) : config.rate,
+		usesVariableRefresh() && !overrideScreenFrameRate);
 }
 
 void EmuApp::onFocusChange(bool in)
@@ -1536,11 +1952,25 @@ void EmuApp::configureSecondaryScreens()
 
 void EmuApp::record(FrameTimeStatEvent event, SteadyClockTimePoint t)
 {
+	bool useTelemetry = frameTimeTelemetry.isEnabled();
+	bool useStats = showFrameTimeStats;
+	if((!useTelemetry && !useStats) || !viewController().isShowingEmulation())
+		return;
+	if(!hasTime(t))
+		t = SteadyClock::now();
+	if(useTelemetry)
+	{
+		frameTimeTelemetry.record(event, t);
+		if(event == FrameTimeStatEvent::endOfDraw)
+		{
+			frameTimeTelemetry.recordDrawStats(renderer.lastFrameDrawStats());
+			frameTimeTelemetry.recordEnergy(appContext(), t);
+		}
+	}
 	doIfUsed(frameTimeStats, [&](auto &frameTimeStats)
 	{
-		if(!showFrameTimeStats || !viewController().isShowingEmulation())
-			return;
-		(&frameTimeStats.startOfFrame)[to_underlying(event)] = hasTime(t) ? t : SteadyClock::now();
+		if(useStats)
+			(&frameTimeStats.startOfFrame)[to_underlying(event)] = t;
 	});
 }
 
@@ -1598,24 +2028,43 @@ bool EmuApp::setAltSpeed(AltSpeedMode mode, int16_t speed)
 
 void EmuApp::applyCPUAffinity(bool active)
 {
+	cpuAffinityActive = active;
 	if(cpuAffinityMode.value() == CPUAffinityMode::Any)
 		return;
 	auto frameThreadGroup = std::vector{emuSystemTask.threadId(), renderer.task().threadId()};
 	system().addThreadGroupIds(frameThreadGroup);
+	if(jobPoolPtr)
+		jobPoolPtr->addThreadIds(frameThreadGroup);
 	for(auto [idx, id] : enumerate(frameThreadGroup))
 	{
 		if(!id)
 			log.warn("invalid thread group id @ index:{}", idx);
 	}
+	std::erase(frameThreadGroup, ThreadId{});
+	if(cpuAffinityMode.value() == CPUAffinityMode::Auto)
+	{
+		// keep threads that only need to keep up, not finish within the frame, off the performance cores
+		auto backgroundMask = active ? appContext().efficiencyCPUMask() : 0;
+		if(backgroundMask)
+			log.info("applying background CPU affinity mask {:X}", backgroundMask);
+		// the audio worker joins the performance hint session instead when one is used
+		audio.setWorkerCPUAffinityMask(perfHintManager ? 0 : backgroundMask);
+		stateSaveWorker.setCPUAffinityMask(backgroundMask);
+		backupMemoryWriter.setCPUAffinityMask(backgroundMask);
+	}
 	if(cpuAffinityMode.value() == CPUAffinityMode::Auto && perfHintManager)
 	{
 		if(active)
 		{
+			// the audio worker has to keep up with every frame, so it's included even though it isn't a frame thread
+			auto hintThreadGroup = frameThreadGroup;
+			if(auto id = audio.workerId())
+				hintThreadGroup.emplace_back(id);
 			auto targetTime = targetFrameTime(emuScreen());
-			perfHintSession = perfHintManager.session(frameThreadGroup, targetTime);
+			perfHintSession = perfHintManager.session(hintThreadGroup, targetTime);
 			if(perfHintSession)
-				log.info("made performance hint session with target time:{} ({} - {})",
-					targetTime, emuScreen().frameTime(), emuScreen().presentationDeadline());
+				log.info("made performance hint session with {} threads, target time:{} ({} - {})",
+					hintThreadGroup.size(), targetTime, emuScreen().frameTime(), emuScreen().presentationDeadline());
 			else
 				log.error("error making performance hint session");
 		}
@@ -1632,6 +2081,20 @@ void EmuApp::applyCPUAffinity(bool active)
 	setThreadCPUAffinityMask(frameThreadGroup, mask);
 }
 
+JobPool &EmuApp::jobPool()
+{
+	if(!jobPoolPtr)
+	{
+		// leave a core each for the emulation and renderer threads, preferring performance cores
+		auto perfMask = appContext().performanceCPUMask();
+		int cores = perfMask ? std::popcount(perfMask) : appContext().cpuCount();
+		jobPoolPtr = std::make_unique<JobPool>(std::max(cores - 2, 0), "EmuJobPool");
+		if(cpuAffinityActive && *jobPoolPtr)
+			applyCPUAffinity(true);
+	}
+	return *jobPoolPtr;
+}
+
 void EmuApp::setCPUAffinity(int cpuNumber, bool on)
 {
 	doIfUsed(cpuAffinityMask, [&](auto &cpuAffinityMask)
@@ -1670,9 +2133,10 @@ void EmuApp::closeBluetoothConnections()
 
 void EmuApp::reportFrameWorkTime()
 {
-	auto lastFrameTimestamp = system().timing.lastFrameTimestamp();
-	if(perfHintSession && hasTime(lastFrameTimestamp))
-		perfHintSession.reportActualWorkTime(SteadyClock::now() - lastFrameTimestamp);
+	// the work spans running the frame until its draw is submitted, excluding any wait for the emulation thread to wake
+	auto startTime = frameWorkStartTime.exchange({});
+	if(perfHintSession && hasTime(startTime))
+		perfHintSession.reportActualWorkTime(SteadyClock::now() - startTime);
 }
 
 MainWindowData &EmuApp::mainWindowData() const
@@ -17,9 +17,12 @@
 #include <emuframework/EmuAudio.hh>
 #include <emuframework/EmuSystem.hh>
 #include <emuframework/Option.hh>
+#include <emuframework/StageProfiler.hh>
 #include <imagine/audio/Manager.hh>
 #include <imagine/util/algorithm.h>
 #include <imagine/logger/logger.h>
+#include <algorithm>
+#include <cstring>
 
 namespace EmuEx
 {
@@ -47,6 +50,16 @@ static AudioStats audioStats{};
 static IG::Timer audioStatsTimer{"audioStatsTimer"};
 #endif
 
+// header of each block of samples queued for the worker thread
+struct AudioWorkerChunk
+{
+	uint32_t frames{};
+	IG::Audio::Format format{};
+	double speedMultiplier{1.};
+	bool reverse{};
+	bool quit{};
+};
+
 static void startAudioStats(IG::Audio::Format format)
 {
 	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
@@ -137,10 +150,23 @@ static void simpleResample(void *dest, size_t destFrames, const void *src, size_
 	}
 }
 
+static void reverseFrames(void *frames, size_t count, IG::Audio::Format format)
+{
+	auto reverse = [&]<class T>(T *data){ std::reverse(data, data + count); };
+	switch(format.framesToBytes(1))
+	{
+		case 2: return reverse((uint16_t*)frames);
+		case 4: return reverse((uint32_t*)frames);
+		case 8: return reverse((uint64_t*)frames);
+	}
+	bug_unreachable("invalid frame size:%zu", format.framesToBytes(1));
+}
+
 void EmuAudio::resizeAudioBuffer(size_t targetBufferFillBytes)
 {
 	auto oldCapacity = rBuff.capacity();
 	rBuff.setMinCapacity(targetBufferFillBytes + bufferIncrementBytes);
+	updateBufferCharge();
 	if(Config::DEBUG_BUILD && rBuff.capacity() != oldCapacity)
 	{
 		log.info("created audio buffer:{} frames ({}), fill target:{} frames ({})",
@@ -168,6 +194,8 @@ void EmuAudio::start(FloatSeconds bufferDuration)
 	auto inputFormat = format();
 	targetBufferFillBytes = inputFormat.timeToBytes(targetBufferFillDuration);
 	bufferIncrementBytes = inputFormat.timeToBytes(bufferDuration);
+	rateControlMaxFillBytes = targetBufferFillBytes;
+	resetRateControl();
 	if(!audioStream.isOpen())
 	{
 		resizeAudioBuffer(targetBufferFillBytes);
@@ -206,6 +234,7 @@ void EmuAudio::start(FloatSeconds bufferDuration)
 							audioWriteState = AudioWriteState::UNDERRUN;
 						}
 						lastUnderrunTime = now;
+						underruns.fetch_add(1, std::memory_order_relaxed);
 						#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
 						audioStats.underruns++;
 						#endif
@@ -238,15 +267,28 @@ void EmuAudio::start(FloatSeconds bufferDuration)
 		}
 		audioStream.play();
 	}
+	// with a burst based output, replace one frame of headroom with a couple of bursts
+	// since audio is consumed at the burst granularity instead of per frame
+	if(size_t burstBytes = inputFormat.framesToBytes(audioStream.framesPerBurst()) * 2;
+		burstBytes && burstBytes < bufferIncrementBytes)
+	{
+		targetBufferFillBytes = targetBufferFillBytes - bufferIncrementBytes + burstBytes;
+		rateControlMaxFillBytes = targetBufferFillBytes;
+		log.info("using burst sized buffer fill target:{}", inputFormat.bytesToTime(targetBufferFillBytes));
+	}
+	if(useWorkerThread)
+		startWorker();
 }
 
 void EmuAudio::stop()
 {
+	stopWorker();
 	stopAudioStats();
 	audioWriteState = AudioWriteState::BUFFER;
 	if(audioStream)
 		audioStream.close();
 	rBuff.clear();
+	resampler.reset();
 }
 
 void EmuAudio::close()
@@ -254,56 +296,164 @@ void EmuAudio::close()
 	stop();
 	audioStream.reset();
 	rBuff.reset();
+	updateBufferCharge();
 }
 
 void EmuAudio::flush()
 {
 	if(!audioStream) [[unlikely]]
 		return;
+	bool restartWorker = workerThread.joinable();
+	stopWorker();
 	stopAudioStats();
 	audioWriteState = AudioWriteState::BUFFER;
 	if(audioStream)
 		audioStream.flush();
 	rBuff.clear();
+	resampler.reset();
+	if(restartWorker)
+		startWorker();
 }
 
 void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
 {
 	if(!framesToWrite) [[unlikely]]
 		return;
+	ScopedStageTimer stageTimer{ProfileStage::audioOutput};
+	if(onWriteFrames) [[unlikely]]
+	{
+		onWriteFrames({static_cast<const uint8_t*>(samples), format().framesToBytes(framesToWrite)});
+		if(!rBuff.capacity())
+			return;
+	}
 	assumeExpr(rBuff.capacity());
+	if(workerThread.joinable())
+	{
+		// only copy the samples here, the worker does the rest off the emulation thread
+		AudioWorkerChunk chunk{uint32_t(framesToWrite), format(), speedMultiplier, reverseWrites};
+		auto bytes = chunk.format.framesToBytes(framesToWrite);
+		auto span = workerBuff.beginWrite(sizeof(chunk) + bytes);
+		if(span.size() < sizeof(chunk) + bytes) [[unlikely]]
+		{
+			log.info("worker overrun, only {} out of {} bytes free", span.size(), sizeof(chunk) + bytes);
+			return;
+		}
+		std::memcpy(span.data(), &chunk, sizeof(chunk));
+		copy_n(static_cast<const uint8_t*>(samples), bytes, span.data() + sizeof(chunk));
+		workerBuff.endWrite(span);
+		workerBuff.notifyWrite();
+		return;
+	}
+	processFrames(samples, framesToWrite, format(), speedMultiplier, reverseWrites);
+}
+
+void *EmuAudio::beginDirectWrite(size_t frames)
+{
+	if(!rBuff.capacity()) [[unlikely]]
+		return nullptr;
 	auto inputFormat = format();
+	auto bytes = inputFormat.framesToBytes(frames);
+	if(workerThread.joinable())
+	{
+		// the worker applies any resampling or reversing
+		auto chunkBytes = sizeof(AudioWorkerChunk) + bytes;
+		auto span = workerBuff.beginWrite(chunkBytes);
+		if(span.size() < chunkBytes) [[unlikely]]
+			return nullptr;
+		directWrite = {span, true};
+		return span.data() + sizeof(AudioWorkerChunk);
+	}
+	if(dynamicRateControl || speedMultiplier != 1. || reverseWrites)
+		return nullptr;
+	handleUnderrun(inputFormat, speedMultiplier);
+	auto span = rBuff.beginWrite(bytes);
+	if(span.size() < bytes) [[unlikely]]
+		return nullptr;
+	resampler.reset();
+	directWrite = {span, false};
+	return span.data();
+}
+
+void EmuAudio::endDirectWrite(size_t frames)
+{
+	ScopedStageTimer stageTimer{ProfileStage::audioOutput};
+	auto inputFormat = format();
+	auto bytes = inputFormat.framesToBytes(frames);
+	auto &span = directWrite.span;
+	if(directWrite.toWorker)
+	{
+		auto samples = span.data() + sizeof(AudioWorkerChunk);
+		if(onWriteFrames) [[unlikely]]
+			onWriteFrames({samples, bytes});
+		if(!frames) [[unlikely]]
+			return;
+		AudioWorkerChunk chunk{uint32_t(frames), inputFormat, speedMultiplier, reverseWrites};
+		std::memcpy(span.data(), &chunk, sizeof(chunk));
+		workerBuff.endWrite({span.first(sizeof(chunk) + bytes), span.idxs});
+		workerBuff.notifyWrite();
+	}
+	else
+	{
+		if(onWriteFrames) [[unlikely]]
+			onWriteFrames({span.data(), bytes});
+		rBuff.endWrite({span.first(bytes), span.idxs});
+		startWritesIfFilled(bytes, inputFormat);
+	}
+}
+
+void EmuAudio::handleUnderrun(IG::Audio::Format inputFormat, double speed)
+{
 	switch(audioWriteState)
 	{
 		case AudioWriteState::MULTI_UNDERRUN:
-			if(speedMultiplier == 1. && addSoundBuffersOnUnderrun &&
+			if(speed == 1. && addSoundBuffersOnUnderrun &&
 				inputFormat.bytesToTime(rBuff.capacity()).count() <= 1.) // hard cap buffer increase to 1 sec
 			{
 				log.warn("increasing buffer size due to multiple underruns within a short time");
 				targetBufferFillBytes += bufferIncrementBytes;
+				rateControlMaxFillBytes = std::max(rateControlMaxFillBytes, targetBufferFillBytes);
 				resizeAudioBuffer(targetBufferFillBytes);
 			}
 			[[fallthrough]];
 		case AudioWriteState::UNDERRUN:
+			if(dynamicRateControl)
+			{
+				// give back a buffer taken by rate control and restart its stability window
+				if(targetBufferFillBytes < rateControlMaxFillBytes)
+				{
+					targetBufferFillBytes += bufferIncrementBytes;
+					log.info("rate control restored fill target:{}", inputFormat.bytesToTime(targetBufferFillBytes));
+				}
+				resetRateControl();
+			}
 			audioWriteState = AudioWriteState::BUFFER;
 		break;
 		default:
 		break;
 	}
+}
+
+void EmuAudio::processFrames(const void *samples, size_t framesToWrite, IG::Audio::Format inputFormat, double speed, bool reverse)
+{
+	handleUnderrun(inputFormat, speed);
 	const size_t sampleFrames = framesToWrite;
-	if(speedMultiplier != 1.) [[unlikely]]
-	{
-		framesToWrite = std::ceil((double)framesToWrite / speedMultiplier);
-		framesToWrite = std::max(framesToWrite, 1zu);
-	}
+	double ratio = 1. / speed;
+	if(dynamicRateControl)
+		ratio *= updateRateControl(speed);
+	const bool useResampler = dynamicRateControl || speed != 1.;
+	if(useResampler) [[unlikely]]
+		framesToWrite = resampler.maxOutputFrames(sampleFrames, ratio);
+	else
+		resampler.reset();
 	auto bytes = inputFormat.framesToBytes(framesToWrite);
 	{
 		auto span = rBuff.beginWrite(bytes);
+		size_t writtenFrames = inputFormat.bytesToFrames(span.size());
 		if(bytes <= span.size())
 		{
-			if(sampleFrames != framesToWrite)
+			if(useResampler)
 			{
-				simpleResample(span.data(), framesToWrite, samples, sampleFrames, inputFormat);
+				writtenFrames = resampler.resample(span.data(), framesToWrite, samples, sampleFrames, inputFormat, ratio);
 			}
 			else
 			{
@@ -316,11 +466,18 @@ void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
 			#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
 			audioStats.overruns++;
 			#endif
-			auto freeFrames = inputFormat.bytesToFrames(span.size());
-			simpleResample(span.data(), freeFrames, samples, sampleFrames, inputFormat);
+			simpleResample(span.data(), writtenFrames, samples, sampleFrames, inputFormat);
+			resampler.reset();
 		}
-		rBuff.endWrite(span);
+		if(reverse) [[unlikely]]
+			reverseFrames(span.data(), writtenFrames, inputFormat);
+		rBuff.endWrite({span.first(inputFormat.framesToBytes(writtenFrames)), span.idxs});
 	}
+	startWritesIfFilled(bytes, inputFormat);
+}
+
+void EmuAudio::startWritesIfFilled(size_t bytes, IG::Audio::Format inputFormat)
+{
 	if(audioWriteState == AudioWriteState::BUFFER && shouldStartAudioWrites(bytes))
 	{
 		if(Config::DEBUG_BUILD)
@@ -334,6 +491,112 @@ void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
 	}
 }
 
+void EmuAudio::resetRateControl()
+{
+	rateControlWindowStart = SteadyClock::now();
+	rateControlFill = targetBufferFillBytes;
+	rateControlMinFill = SIZE_MAX;
+}
+
+// Returns the output rate adjustment that steers the buffer towards its fill target.
+// Once the fill has stayed at least a whole buffer above empty for the stability period
+// the target is lowered by one buffer, down to a single buffer.
+double EmuAudio::updateRateControl(double speed)
+{
+	constexpr double maxAdjust = .005;
+	constexpr auto stablePeriod = Seconds{10};
+	if(speed != 1. || audioWriteState != AudioWriteState::ACTIVE)
+		return 1.;
+	auto fill = framesWritten() * format().bytesPerFrame();
+	rateControlFill += (double(fill) - rateControlFill) / 16.; // smooth out callback granularity
+	rateControlMinFill = std::min(rateControlMinFill, fill);
+	auto now = SteadyClock::now();
+	if(now - rateControlWindowStart >= stablePeriod)
+	{
+		if(rateControlMinFill > bufferIncrementBytes && targetBufferFillBytes > bufferIncrementBytes)
+		{
+			targetBufferFillBytes -= bufferIncrementBytes;
+			log.info("rate control lowered fill target:{}", format().bytesToTime(targetBufferFillBytes));
+		}
+		rateControlWindowStart = now;
+		rateControlMinFill = SIZE_MAX;
+	}
+	double error = (double(targetBufferFillBytes) - rateControlFill) / double(targetBufferFillBytes);
+	return 1. + std::clamp(error, -1., 1.) * maxAdjust;
+}
+
+void EmuAudio::startWorker()
+{
+	if(workerThread.joinable())
+		return;
+	workerBuff.setMinCapacity(targetBufferFillBytes * 2 + bufferIncrementBytes);
+	updateBufferCharge();
+	workerBuff.clear();
+	workerThread = std::thread{[this]{ runWorker(); }};
+	// wait for the ID so the worker can be added to thread groups right away
+	workerThreadId.wait(ThreadId{});
+}
+
+void EmuAudio::stopWorker()
+{
+	if(!workerThread.joinable())
+		return;
+	AudioWorkerChunk chunk{.quit = true};
+	while(true)
+	{
+		auto span = workerBuff.beginWrite(sizeof(chunk), {.blocking = true});
+		if(span.size() == sizeof(chunk))
+		{
+			std::memcpy(span.data(), &chunk, sizeof(chunk));
+			workerBuff.endWrite(span);
+			workerBuff.notifyWrite();
+			break;
+		}
+	}
+	workerThread.join();
+	workerBuff.clear();
+}
+
+void EmuAudio::setWorkerCPUAffinityMask(CPUMask mask)
+{
+	workerCPUMask = mask;
+	if(ThreadId id = workerThreadId)
+		setThreadCPUAffinityMask(std::span{&id, 1}, mask);
+}
+
+void EmuAudio::runWorker()
+{
+	log.info("starting worker thread");
+	ThreadId id = thisThreadId();
+	workerThreadId = id;
+	workerThreadId.notify_all();
+	if(auto mask = workerCPUMask.load())
+		setThreadCPUAffinityMask(std::span{&id, 1}, mask);
+	while(true)
+	{
+		// chunks are always written whole so any data read starts with a complete chunk
+		auto span = workerBuff.beginRead(workerBuff.capacity(), {.blocking = true});
+		size_t consumed{};
+		while(consumed < span.size())
+		{
+			AudioWorkerChunk chunk;
+			std::memcpy(&chunk, span.data() + consumed, sizeof(chunk));
+			consumed += sizeof(chunk);
+			if(chunk.quit)
+			{
+				workerBuff.endRead({span.first(consumed), span.idxs});
+				workerThreadId = {};
+				log.info("exiting worker thread");
+				return;
+			}
+			processFrames(span.data() + consumed, chunk.frames, chunk.format, chunk.speedMultiplier, chunk.reverse);
+			consumed += chunk.format.framesToBytes(chunk.frames);
+		}
+		workerBuff.endRead({span.first(consumed), span.idxs});
+		workerBuff.notifyRead();
+	}
+}
+
 void EmuAudio::setRate(int newRate)
 {
 	assert(newRate <= defaultRate);
@@ -456,6 +719,8 @@ void EmuAudio::writeConfig(FileIO &io) const
 	writeOptionValueIfNotDefault(io, CFGKEY_SOUND_VOLUME, maxVolume(), 100);
 	writeOptionValueIfNotDefault(io, CFGKEY_ADD_SOUND_BUFFERS_ON_UNDERRUN, addSoundBuffersOnUnderrunSetting, false);
 	writeOptionValueIfNotDefault(io, CFGKEY_AUDIO_API, audioAPI, Audio::Api::DEFAULT);
+	writeOptionValueIfNotDefault(io, CFGKEY_AUDIO_WORKER_THREAD, useWorkerThread, false);
+	writeOptionValueIfNotDefault(io, CFGKEY_AUDIO_RATE_CONTROL, dynamicRateControl, false);
 }
 
 bool EmuAudio::readConfig(MapIO &io, unsigned key)
@@ -468,6 +733,8 @@ bool EmuAudio::readConfig(MapIO &io, unsigned key)
 		case CFGKEY_SOUND_VOLUME: return readOptionValue<int8_t>(io, [&](auto v){ setMaxVolume(v); }, isValidVolumeSetting);
 		case CFGKEY_ADD_SOUND_BUFFERS_ON_UNDERRUN: return readOptionValue(io, addSoundBuffersOnUnderrunSetting);
 		case CFGKEY_AUDIO_API: return readOptionValue(io, audioAPI);
+		case CFGKEY_AUDIO_WORKER_THREAD: return readOptionValue(io, useWorkerThread);
+		case CFGKEY_AUDIO_RATE_CONTROL: return readOptionValue(io, dynamicRateControl);
 	}
 	return false;
 }
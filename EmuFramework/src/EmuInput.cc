@@ -89,10 +89,7 @@ bool InputManager::handleAppActionKeyInput(EmuApp& app, InputAction action, cons
 				break;
 			static auto doSaveState = [](EmuApp &app, bool notify)
 			{
-				if(app.saveStateWithSlot(app.system().stateSlot()) && notify)
-				{
-					app.postMessage("State Saved");
-				}
+				app.saveStateWithSlot(app.system().stateSlot(), notify);
 			};
 			if(app.shouldOverwriteExistingState())
 			{
@@ -164,7 +161,7 @@ bool InputManager::handleAppActionKeyInput(EmuApp& app, InputAction action, cons
 		{
 			turboModifierActive = isPushed;
 			if(!isPushed)
-				turboActions = {};
+				turboActions.clear();
 			break;
 		}
 		case exitApp:
@@ -189,12 +186,16 @@ bool InputManager::handleAppActionKeyInput(EmuApp& app, InputAction action, cons
 		}
 		case rewind:
 		{
-			if(!isPushed)
-				break;
-			if(app.rewindManager.maxStates)
-				app.rewindManager.rewindState(app);
-			else
-				app.postMessage(3, false, "Please set rewind states in Options➔System");
+			auto &rewindManager = app.rewindManager;
+			if(!rewindManager.isEnabled())
+			{
+				if(isPushed)
+					app.postMessage(3, false, "Please set rewind states in Options➔System");
+			}
+			else if(rewindManager.continuousRewind)
+				rewindManager.setRewinding(app, isPushed);
+			else if(isPushed)
+				rewindManager.rewindState(app);
 			break;
 		}
 		case softReset:
@@ -202,6 +203,7 @@ bool InputManager::handleAppActionKeyInput(EmuApp& app, InputAction action, cons
 			if(!isPushed)
 				break;
 			app.syncEmulationThread();
+			app.stopInputRecording("reset");
 			system.reset(app, EmuSystem::ResetMode::SOFT);
 			break;
 		}
@@ -210,6 +212,7 @@ bool InputManager::handleAppActionKeyInput(EmuApp& app, InputAction action, cons
 			if(!isPushed)
 				break;
 			app.syncEmulationThread();
+			app.stopInputRecording("reset");
 			system.reset(app, EmuSystem::ResetMode::HARD);
 			break;
 		}
@@ -241,7 +244,9 @@ void InputManager::handleSystemKeyInput(EmuApp& app, KeyInfo keyInfo, Input::Act
 		app.defaultVController().updateSystemKeys(keyInfo, act == Input::Action::PUSHED);
 		for(auto code : keyInfo.codes)
 		{
-			app.system().handleInputAction(&app, {code, keyInfo.flags, act, metaState});
+			InputAction action{code, keyInfo.flags, act, metaState};
+			app.inputReplay.recordAction(action);
+			app.system().handleInputAction(&app, action);
 		}
 	}
 }
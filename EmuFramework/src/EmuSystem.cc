@@ -44,8 +44,10 @@ constexpr SystemLogger log{"EmuSystem"};
 [[gnu::weak]] bool EmuSystem::hasBundledGames = false;
 [[gnu::weak]] bool EmuSystem::hasPALVideoSystem = false;
 [[gnu::weak]] bool EmuSystem::canRenderRGBA8888 = true;
+[[gnu::weak]] bool EmuSystem::canRenderPaletteIndices = false;
 [[gnu::weak]] bool EmuSystem::hasResetModes = false;
 [[gnu::weak]] bool EmuSystem::handlesArchiveFiles = false;
+[[gnu::weak]] EmuSystem::NameFilterFunc EmuSystem::uncachedArchiveEntryFilter{};
 [[gnu::weak]] bool EmuSystem::handlesGenericIO = true;
 [[gnu::weak]] bool EmuSystem::hasCheats = false;
 [[gnu::weak]] bool EmuSystem::hasSound = true;
@@ -54,6 +56,7 @@ constexpr SystemLogger log{"EmuSystem"};
 [[gnu::weak]] F2Size EmuSystem::validFrameRateRange{minFrameRate, 80.};
 [[gnu::weak]] bool EmuSystem::hasRectangularPixels = false;
 [[gnu::weak]] bool EmuSystem::stateSizeChangesAtRuntime = false;
+[[gnu::weak]] bool EmuSystem::hasGzipStates = false;
 
 bool EmuSystem::stateExists(int slot) const
 {
@@ -91,6 +94,21 @@ DynArray<uint8_t> EmuSystem::saveState()
 	return stateArr;
 }
 
+size_t EmuSystem::compressState(std::span<uint8_t> dest, std::span<const uint8_t> src, SaveStateFlags flags, int defaultLevel)
+{
+	auto level = [&]
+	{
+		switch(flags.compression)
+		{
+			case StateCompression::Default: return defaultLevel;
+			case StateCompression::Fast: return Z_BEST_SPEED;
+			case StateCompression::Small: return Z_BEST_COMPRESSION;
+		}
+		bug_unreachable("invalid StateCompression");
+	}();
+	return compressGzip(dest, src, level);
+}
+
 DynArray<uint8_t> EmuSystem::uncompressGzipState(std::span<uint8_t> buff, size_t expectedSize)
 {
 	assert(hasGzipHeader(buff));
@@ -272,9 +290,11 @@ void EmuSystem::closeRuntimeSystem(EmuApp &app)
 		app.saveSessionOptions();
 		log.info("closing game:{}", contentName_);
 		flushBackupMemory(app);
+		app.backupMemoryWriter.wait(); // pending writes refer to the system's files
 		closeSystem();
 		app.autosaveManager.cancelTimer();
 		app.rewindManager.clear();
+		app.runAheadManager.clear();
 		state = State::OFF;
 	}
 	clearGamePaths();
@@ -310,21 +330,21 @@ void EmuSystem::start(EmuApp &app)
 	onStart();
 	app.startAudio();
 	app.autosaveManager.startTimer();
-	if(stateSizeChangesAtRuntime && app.rewindManager.maxStates)
+	if(stateSizeChangesAtRuntime && app.rewindManager.isEnabled())
 	{
 		auto newStateSize = stateSize();
 		if(newStateSize != app.rewindManager.stateSize)
-			app.rewindManager.reset(newStateSize);
+			app.rewindManager.reset(newStateSize, frameRate());
 	}
 	app.rewindManager.startTimer();
 }
 
-SteadyClockTime EmuSystem::benchmark(EmuVideo &video)
+SteadyClockTime EmuSystem::benchmark(EmuVideo *video)
 {
 	auto before = SteadyClock::now();
 	for(auto i : iotaCount(180))
 	{
-		runFrame({}, &video, nullptr);
+		runFrame({}, video, nullptr);
 	}
 	return SteadyClock::now() - before;
 }
@@ -419,30 +439,42 @@ void EmuSystem::loadContentFromPath(CStringView pathStr, std::string_view displa
 		path, displayName, params, onLoadProgress);
 }
 
+static IO findArchiveContent(IO file, FS::FileString &originalName)
+{
+	for(auto &entry : FS::ArchiveIterator{std::move(file)})
+	{
+		if(entry.type() == FS::file_type::directory)
+		{
+			continue;
+		}
+		auto name = entry.name();
+		log.info("archive file entry:{}", name);
+		if(EmuSystem::defaultFsFilter(name))
+		{
+			originalName = name;
+			return std::move(entry);
+		}
+	}
+	throw std::runtime_error("No recognized file extensions in archive");
+}
+
 void EmuSystem::loadContentFromFile(IO file, CStringView path, std::string_view displayName, EmuSystemCreateParams params, OnLoadProgressDelegate onLoadProgress)
 {
 	if(!EmuSystem::handlesArchiveFiles && EmuApp::hasArchiveExtension(displayName))
 	{
-		IO io{};
+		auto &archiveCache = EmuApp::get(appContext()).archiveCache;
+		auto cacheKey = archiveCache.key(path, file.size());
 		FS::FileString originalName{};
-		for(auto &entry : FS::ArchiveIterator{std::move(file)})
-		{
-			if(entry.type() == FS::file_type::directory)
-			{
-				continue;
-			}
-			auto name = entry.name();
-			log.info("archive file entry:{}", name);
-			if(EmuSystem::defaultFsFilter(name))
-			{
-				originalName = name;
-				io = std::move(entry);
-				break;
-			}
-		}
+		IO io = archiveCache.open(cacheKey, originalName);
 		if(!io)
 		{
-			throw std::runtime_error("No recognized file extensions in archive");
+			io = findArchiveContent(std::move(file), originalName);
+			if(uncachedArchiveEntryFilter && uncachedArchiveEntryFilter(originalName))
+				cacheKey = 0;
+			if(auto cachedIO = archiveCache.store(cacheKey, originalName, io))
+				io = std::move(cachedIO);
+			else if(!io) // entry was partly read by a failed cache write
+				io = findArchiveContent(appContext().openFileUri(path, {.accessHint = IOAccessHint::Sequential}), originalName);
 		}
 		closeAndSetupNew(path, displayName);
 		contentFileName_ = originalName;
@@ -545,12 +577,16 @@ void EmuSystem::flushBackupMemory(EmuApp &app, BackupMemoryDirtyFlags flags)
 	onFlushBackupMemory(app, flags);
 	backupMemoryDirtyFlags = 0;
 	backupMemoryCounter = 0;
+	backupMemoryMaxCounter = 0;
 }
 
 void EmuSystem::onBackupMemoryWritten(BackupMemoryDirtyFlags flags)
 {
 	backupMemoryDirtyFlags |= flags;
 	backupMemoryCounter = 127;
+	// games writing continuously would otherwise keep delaying the flush
+	if(!backupMemoryMaxCounter)
+		backupMemoryMaxCounter = 600;
 }
 
 bool EmuSystem::updateBackupMemoryCounter()
@@ -558,7 +594,8 @@ bool EmuSystem::updateBackupMemoryCounter()
 	if(backupMemoryCounter) [[unlikely]]
 	{
 		backupMemoryCounter--;
-		if(!backupMemoryCounter)
+		backupMemoryMaxCounter--;
+		if(!backupMemoryCounter || !backupMemoryMaxCounter)
 		{
 			flushBackupMemory(EmuApp::get(appContext()), backupMemoryDirtyFlags);
 			return true;
@@ -44,6 +44,9 @@ void EmuSystemTask::start()
 			commandPort.attach(eventLoop, [this, &started](auto msgs)
 			{
 				std::binary_semaphore *syncSemPtr{};
+				doIfUsed(app.frameTimeStats, [&](auto &stats) { countWakeup(stats); });
+				if(framePresented.exchange(false, std::memory_order_acquire))
+					pendingFrames = 0; // any older pending frame was superseded by the presented one
 				for(auto msg : msgs)
 				{
 					bool threadIsRunning = msg.command.visit(overloaded
@@ -53,11 +56,6 @@ void EmuSystemTask::start()
 							frameParams = cmd.params;
 							return true;
 						},
-						[&](FramePresentedCommand &cmd)
-						{
-							framePending = false;
-							return true;
-						},
 						[&](PauseCommand &)
 						{
 							//log.debug("got pause command");
@@ -77,13 +75,13 @@ void EmuSystemTask::start()
 				}
 				if(hasTime(frameParams.timestamp))
 				{
-					if(!framePending)
+					if(pendingFrames < maxPendingFrames)
 					{
 						auto params = std::exchange(frameParams, {});
 						bool renderingFrame = app.advanceFrames(params, this);
 						if(params.isFromRenderer())
 						{
-							framePending = false;
+							pendingFrames = 0;
 							if(!renderingFrame)
 							{
 								app.emuWindow().postDraw(1);
@@ -94,11 +92,12 @@ void EmuSystemTask::start()
 					{
 						log.debug("previous async frame not ready yet");
 						doIfUsed(app.frameTimeStats, [&](auto &stats) { stats.missedFrameCallbacks++; });
+						app.frameTimeTelemetry.recordMissedFrameCallback();
 					}
 				}
 				if(syncSemPtr)
 				{
-					framePending = false;
+					pendingFrames = 0;
 					syncSemPtr->release();
 				}
 				return true;
@@ -111,6 +110,22 @@ void EmuSystemTask::start()
 		});
 }
 
+void EmuSystemTask::countWakeup(FrameTimeStats &stats)
+{
+	wakeups++;
+	auto now = SteadyClock::now();
+	if(!hasTime(wakeupSampleTime))
+	{
+		wakeupSampleTime = now;
+		return;
+	}
+	auto elapsed = now - wakeupSampleTime;
+	if(elapsed < Seconds{1})
+		return;
+	stats.taskWakeupsPerSecond = std::exchange(wakeups, 0) / duration_cast<FloatSeconds>(elapsed).count();
+	wakeupSampleTime = now;
+}
+
 void EmuSystemTask::pause()
 {
 	if(!taskThread.joinable())
@@ -140,7 +155,8 @@ void EmuSystemTask::notifyFramePresented()
 {
 	if(!taskThread.joinable()) [[unlikely]]
 		return;
-	commandPort.send({.command = FramePresentedCommand{}});
+	framePresented.store(true, std::memory_order_release);
+	commandPort.wake();
 }
 
 void EmuSystemTask::sendVideoFormatChangedReply(EmuVideo &video)
@@ -156,12 +172,4 @@ void EmuSystemTask::sendFrameFinishedReply(EmuVideo &video)
 	video.dispatchFrameFinished();
 }
 
-void EmuSystemTask::sendScreenshotReply(bool success)
-{
-	app.runOnMainThread([&app = app, success](ApplicationContext ctx)
-	{
-		app.printScreenshotResult(success);
-	});
-}
-
 }
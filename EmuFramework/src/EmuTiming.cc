@@ -17,6 +17,7 @@
 #include <imagine/util/utility.h>
 #include <imagine/util/math.hh>
 #include <imagine/logger/logger.h>
+#include <algorithm>
 #include <cmath>
 
 namespace EmuEx
@@ -54,6 +55,19 @@ EmuFrameTimeInfo EmuTiming::advanceFrames(FrameParams params)
 		assumeExpr(startFrameTime.time_since_epoch().count() > 0);
 		assumeExpr(params.timestamp > startFrameTime);
 		auto timeTotal = params.timestamp - startFrameTime;
+		if(usePacedFrames && params.frameTime.count() > 0)
+		{
+			// Advance a paced timeline by whole screen frames so timestamp jitter near a frame boundary
+			// can't produce a double frame followed by a dropped one. The timeline is pulled slowly
+			// towards the real timestamps to correct drift from the nominal screen frame time.
+			pacedTime += params.frameTime * params.elapsedFrames(lastTimestamp);
+			auto drift = timeTotal - pacedTime;
+			if(abs(drift) > params.frameTime * 3)
+				pacedTime += drift; // resync after a stall
+			else
+				pacedTime += drift / 128;
+			timeTotal = pacedTime;
+		}
 		auto now = divRoundClosestPositive(timeTotal.count(), timePerVideoFrame.count());
 		int elapsedFrames = now - lastFrame;
 		lastFrame = now;
@@ -66,12 +80,57 @@ void EmuTiming::setFrameTime(SteadyClockTime time)
 	timePerVideoFrame = time;
 	log.info("configured frame time:{} ({:g} fps)", timePerVideoFrame, toHz(time));
 	reset();
+	frameSkipPredictor.reset();
 }
 
 void EmuTiming::reset()
 {
 	startFrameTime = {};
+	pacedTime = {};
 	savedAdvancedFrames = {};
 }
 
+void FrameSkipPredictor::addFrameCost(SteadyClockTime cost, bool hadVideo)
+{
+	constexpr double weight = .1;
+	auto secs = duration_cast<FloatSeconds>(cost).count();
+	auto &avg = hadVideo ? videoFrameCost : skippedFrameCost;
+	avg = avg ? avg + (secs - avg) * weight : secs;
+}
+
+bool FrameSkipPredictor::shouldSkipVideo(SteadyClockTime frameBudget)
+{
+	if(!videoFrameCost)
+		return false;
+	auto target = duration_cast<FloatSeconds>(frameBudget).count() * targetBudgetFraction;
+	double ratio{};
+	if(videoFrameCost > target)
+	{
+		// until a skipped frame is measured, assume it saves half the cost
+		auto skippedCost = skippedFrameCost ? skippedFrameCost : videoFrameCost * .5;
+		ratio = skippedCost < target && skippedCost < videoFrameCost ?
+			(videoFrameCost - target) / (videoFrameCost - skippedCost) : maxSkipRatio;
+		ratio = std::min(ratio, maxSkipRatio);
+	}
+	// ease towards the new ratio so brief spikes don't cause bursts of skips
+	skipRatio_ += (ratio - skipRatio_) * .2;
+	if(skipRatio_ < .01)
+	{
+		skipAccumulator = 0;
+		return false;
+	}
+	skipAccumulator += skipRatio_;
+	if(skipAccumulator >= 1.)
+	{
+		skipAccumulator -= 1.;
+		return true;
+	}
+	return false;
+}
+
+void FrameSkipPredictor::reset()
+{
+	*this = {};
+}
+
 }
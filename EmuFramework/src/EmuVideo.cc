@@ -19,6 +19,8 @@
 #include <imagine/gfx/RendererTask.hh>
 #include <imagine/gfx/RendererCommands.hh>
 #include <imagine/logger/logger.h>
+#include <algorithm>
+#include <memory>
 
 namespace EmuEx
 {
@@ -71,13 +73,14 @@ bool EmuVideo::setFormat(IG::PixmapDesc desc, EmuSystemTaskContext taskCtx)
 	{
 		Gfx::TextureConfig conf{desc, samplerConfig()};
 		conf.colorSpace = colSpace;
-		bool singleBuffer = renderer().maxSwapChainImages() < 3 || app().effectiveFrameTimeSource() != FrameTimeSource::Renderer;
-		vidImg = renderer().makePixmapBufferTexture(conf, bufferMode, singleBuffer);
+		singleBuffered = renderer().maxSwapChainImages() < 3 || app().effectiveFrameTimeSource() != FrameTimeSource::Renderer;
+		vidImg = renderer().makePixmapBufferTexture(conf, bufferMode, singleBuffered);
 	}
 	else
 	{
 		vidImg.setFormat(desc, colSpace, samplerConfig());
 	}
+	needsFullUpload = true;
 	log.info("resized to:{}x{}", desc.w(), desc.h());
 	if(taskCtx)
 	{
@@ -145,12 +148,17 @@ void EmuVideo::postFrameFinished(EmuSystemTaskContext taskCtx)
 	}
 }
 
-void EmuVideo::finishFrame(EmuSystemTaskContext taskCtx, Gfx::LockedTextureBuffer texBuff)
+void EmuVideo::finishFrame(EmuSystemTaskContext taskCtx, Gfx::LockedTextureBuffer texBuff, DirtyLineRange dirtyLines)
 {
 	if(screenshotNextFrame) [[unlikely]]
 	{
 		doScreenshot(taskCtx, texBuff.pixmap());
 	}
+	if(!dirtyLines.isWholeFrame() && !needsFullUpload && uploadsPartialFrames())
+	{
+		texBuff.setDirtyLines(dirtyLines.start, dirtyLines.end);
+	}
+	needsFullUpload = false;
 	app().record(FrameTimeStatEvent::aboutToSubmitFrame);
 	vidImg.unlock(texBuff);
 	postFrameFinished(taskCtx);
@@ -164,6 +172,7 @@ void EmuVideo::finishFrame(EmuSystemTaskContext taskCtx, IG::PixmapView pix)
 	}
 	app().record(FrameTimeStatEvent::aboutToSubmitFrame);
 	vidImg.write(pix, {.async = true});
+	needsFullUpload = false;
 	postFrameFinished(taskCtx);
 }
 
@@ -172,6 +181,7 @@ void EmuVideo::clear()
 	if(!vidImg)
 		return;
 	vidImg.clear();
+	needsFullUpload = true;
 }
 
 void EmuVideo::takeGameScreenshot()
@@ -179,17 +189,35 @@ void EmuVideo::takeGameScreenshot()
 	screenshotNextFrame = true;
 }
 
+static uint32_t maxPerChannel(uint32_t a, uint32_t b)
+{
+	uint32_t res{};
+	for(int shift = 0; shift < 32; shift += 8)
+	{
+		res |= std::max((a >> shift) & 0xFF, (b >> shift) & 0xFF) << shift;
+	}
+	return res;
+}
+
 void EmuVideo::doScreenshot(EmuSystemTaskContext taskCtx, IG::PixmapView pix)
 {
 	screenshotNextFrame = false;
-	auto success = app().writeScreenshot(pix, app().makeNextScreenshotFilename());
-	if(taskCtx)
+	// only copy the frame here, PNG encoding and file I/O run on the screenshot writer's thread
+	auto &writer = app().screenshotWriter;
+	if(pix.format() == IG::PixelFmtI8 || pix.format() == IG::PixelFmtIA88)
 	{
-		taskCtx.task().sendScreenshotReply(success);
+		auto rgbaPix = writer.allocPixmap({pix.size(), IG::PixelFmtRGBA8888});
+		if(pix.format() == IG::PixelFmtIA88)
+			rgbaPix.writeTransformed([&](uint16_t p){ return maxPerChannel(palette[p & 0xFF], palette[256 + (p >> 8)]); }, pix);
+		else
+			rgbaPix.writeTransformed([&](uint8_t p){ return palette[p]; }, pix);
+		writer.write(rgbaPix, app().makeNextScreenshotFilename());
 	}
 	else
 	{
-		app().printScreenshotResult(success);
+		auto copyPix = writer.allocPixmap(pix.desc());
+		copyPix.write(pix);
+		writer.write(copyPix, app().makeNextScreenshotFilename());
 	}
 }
 
@@ -232,7 +260,7 @@ EmuVideoImage::operator bool() const
 void EmuVideoImage::endFrame()
 {
 	assumeExpr(texBuff);
-	emuVideo->finishFrame(taskCtx, texBuff);
+	emuVideo->finishFrame(taskCtx, texBuff, dirtyLines);
 }
 
 WSize EmuVideo::size() const
@@ -308,6 +336,46 @@ IG::PixelFormat EmuVideo::internalRenderPixelFormat() const
 	return renderPixelFormat() == IG::PixelFmtBGRA8888 ? IG::PixelFmtRGBA8888 : renderPixelFormat();
 }
 
+bool EmuVideo::bufferModeUploadsTexture() const
+{
+	// other modes write directly to memory backing the texture
+	return bufferMode == Gfx::TextureBufferMode::SYSTEM_MEMORY || bufferMode == Gfx::TextureBufferMode::PBO;
+}
+
+bool EmuVideo::usesPaletteIndices() const
+{
+	// formats not backed by a plain GL texture can't hold indices
+	return EmuSystem::canRenderPaletteIndices && app().gpuPaletteConversion && bufferModeUploadsTexture();
+}
+
+bool EmuVideo::uploadsPartialFrames() const
+{
+	return app().partialFrameUpload && bufferModeUploadsTexture();
+}
+
+bool EmuVideo::isPaletted() const
+{
+	return vidImg && (vidImg.pixmapDesc().format == IG::PixelFmtI8 || isPalettedWithPrevFrame());
+}
+
+bool EmuVideo::isPalettedWithPrevFrame() const
+{
+	return vidImg && vidImg.pixmapDesc().format == IG::PixelFmtIA88;
+}
+
+void EmuVideo::setPalette(std::span<const uint32_t> colors)
+{
+	assumeExpr(colors.size() <= palette.size());
+	std::ranges::copy(colors, palette.begin());
+	if(!paletteTex)
+	{
+		Gfx::TextureConfig conf{{{256, 2}, IG::PixelFmtRGBA8888}, Gfx::SamplerConfigs::noLinearNoMipClamp};
+		paletteTex = renderer().makeTexture(conf);
+	}
+	// synchronous since palette is re-written in place, updates are rare so the wait is negligible
+	paletteTex.write(0, {{{256, 2}, IG::PixelFmtRGBA8888}, palette.data()}, {});
+}
+
 Gfx::TextureSamplerConfig EmuVideo::samplerConfigForLinearFilter(bool useLinearFilter)
 {
 	return useLinearFilter ? Gfx::SamplerConfigs::noMipClamp : Gfx::SamplerConfigs::noLinearNoMipClamp;
@@ -162,10 +162,7 @@ void EmuVideoLayer::draw(Gfx::RendererCommands &cmds)
 		for(auto &ePtr : effects)
 		{
 			auto &e = *ePtr;
-			cmds.setProgram(e.program());
-			cmds.setRenderTarget(e.renderTarget());
-			cmds.clear();
-			e.drawRenderTarget(cmds, srcTex);
+			e.draw(cmds, srcTex);
 			srcTex = e.renderTarget();
 		}
 		cmds.setDefaultRenderTarget();
@@ -205,6 +202,7 @@ void EmuVideoLayer::setFormat(EmuSystem &sys, IG::PixelFormat videoFmt, IG::Pixe
 	if(!video.setRenderPixelFormat(sys, videoFmt, videoColorSpace(videoFmt)))
 	{
 		setEffectFormat(effectFmt);
+		updatePaletteEffect();
 		updateConvertColorSpaceEffect();
 		updateSprite();
 		setOverlay(userOverlayEffectId);
@@ -238,12 +236,22 @@ void EmuVideoLayer::setEffect(EmuSystem &sys, ImageEffectId effect, IG::PixelFor
 	if(userEffectId == effect)
 		return;
 	userEffectId = effect;
-	updateEffect(sys, fmt);
+	if(!userEffectSuspended)
+		updateEffect(sys, fmt);
+}
+
+void EmuVideoLayer::setEffectSuspended(EmuSystem &sys, bool suspended, IG::PixelFormat fmt)
+{
+	if(userEffectSuspended == suspended)
+		return;
+	userEffectSuspended = suspended;
+	if(userEffectId != ImageEffectId::DIRECT)
+		updateEffect(sys, fmt);
 }
 
 void EmuVideoLayer::updateEffect(EmuSystem &sys, IG::PixelFormat fmt)
 {
-	if(userEffectId == ImageEffectId::DIRECT)
+	if(activeEffectId() == ImageEffectId::DIRECT)
 	{
 		userEffect = {};
 		buildEffectChain();
@@ -253,7 +261,7 @@ void EmuVideoLayer::updateEffect(EmuSystem &sys, IG::PixelFormat fmt)
 	}
 	else
 	{
-		userEffect = {renderer(), userEffectId, fmt, colorSpace(), samplerConfig(), video.size()};
+		userEffect = {renderer(), activeEffectId(), fmt, colorSpace(), samplerConfig(), video.size()};
 		buildEffectChain();
 		video.setRenderPixelFormat(sys, video.renderPixelFormat(), Gfx::ColorSpace::LINEAR);
 	}
@@ -277,7 +285,8 @@ void EmuVideoLayer::updateBrightness()
 void EmuVideoLayer::onVideoFormatChanged(IG::PixelFormat effectFmt)
 {
 	setEffectFormat(effectFmt);
-	if(!updateConvertColorSpaceEffect())
+	bool rebuiltChain = updatePaletteEffect();
+	if(!updateConvertColorSpaceEffect() && !rebuiltChain)
 	{
 		updateEffectImageSize();
 	}
@@ -318,6 +327,10 @@ void EmuVideoLayer::updateEffectImageSize()
 void EmuVideoLayer::buildEffectChain()
 {
 	effects.clear();
+	if(paletteEffect)
+	{
+		effects.emplace_back(&paletteEffect);
+	}
 	if(userEffect)
 	{
 		effects.emplace_back(&userEffect);
@@ -331,7 +344,7 @@ bool EmuVideoLayer::updateConvertColorSpaceEffect()
 {
 	bool needsConversion = video.colorSpace() == Gfx::ColorSpace::LINEAR
 		&& colorSpace() == Gfx::ColorSpace::SRGB
-		&& userEffectId == ImageEffectId::DIRECT;
+		&& activeEffectId() == ImageEffectId::DIRECT;
 	if(needsConversion && !userEffect)
 	{
 		userEffect = {renderer(), ImageEffectId::DIRECT, IG::PixelFmtRGBA8888, Gfx::ColorSpace::SRGB, samplerConfig(), video.size()};
@@ -339,7 +352,7 @@ bool EmuVideoLayer::updateConvertColorSpaceEffect()
 		buildEffectChain();
 		return true;
 	}
-	else if(!needsConversion && userEffect && userEffectId == ImageEffectId::DIRECT)
+	else if(!needsConversion && userEffect && activeEffectId() == ImageEffectId::DIRECT)
 	{
 		userEffect = {};
 		log.info("deleted sRGB conversion effect");
@@ -349,6 +362,35 @@ bool EmuVideoLayer::updateConvertColorSpaceEffect()
 	return false;
 }
 
+bool EmuVideoLayer::updatePaletteEffect()
+{
+	// the lookup outputs what the video image would hold without indices, including its color space
+	auto fmt = video.internalRenderPixelFormat();
+	if(video.isPaletted() && (!paletteEffect || paletteEffectUsesPrevFrame != video.isPalettedWithPrevFrame()))
+	{
+		paletteEffectUsesPrevFrame = video.isPalettedWithPrevFrame();
+		paletteEffect = {renderer(), paletteEffectUsesPrevFrame ? VideoImageEffect::palettePhosphorDesc : VideoImageEffect::paletteDesc,
+			fmt, video.colorSpace(), Gfx::SamplerConfigs::noLinearNoMipClamp, video.size()};
+		paletteEffect.setPaletteTexture(&video.paletteTexture());
+		log.info("made palette lookup effect{}", paletteEffectUsesPrevFrame ? " with phosphor blend" : "");
+		buildEffectChain();
+		return true;
+	}
+	else if(!video.isPaletted() && paletteEffect)
+	{
+		paletteEffect = {};
+		log.info("deleted palette lookup effect");
+		buildEffectChain();
+		return true;
+	}
+	else if(paletteEffect)
+	{
+		paletteEffect.setFormat(renderer(), fmt, video.colorSpace(),
+			&paletteEffect == effects.back() ? samplerConfig() : Gfx::SamplerConfigs::noLinearNoMipClamp);
+	}
+	return false;
+}
+
 void EmuVideoLayer::updateSprite()
 {
 	if(effects.size())
@@ -374,6 +416,8 @@ void EmuVideoLayer::logOutputFormat()
 			auto &e = *ePtr;
 			str += " -> effect:";
 			str += e.imageFormat().name();
+			if(e.passCount() > 1)
+				str += std::format(" ({} passes)", e.passCount());
 		}
 		log.info("{}", str);
 	}
@@ -382,7 +426,7 @@ void EmuVideoLayer::logOutputFormat()
 Gfx::ColorSpace EmuVideoLayer::videoColorSpace(IG::PixelFormat videoFmt) const
 {
 	// if we want sRGB output and are rendering directly, set the video to sRGB if possible
-	return colorSpace() == Gfx::ColorSpace::SRGB && userEffectId == ImageEffectId::DIRECT ?
+	return colorSpace() == Gfx::ColorSpace::SRGB && activeEffectId() == ImageEffectId::DIRECT ?
 			Gfx::Renderer::supportedColorSpace(videoFmt, colorSpace()) : Gfx::ColorSpace::LINEAR;
 }
 
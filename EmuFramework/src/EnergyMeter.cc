@@ -0,0 +1,95 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/EnergyMeter.hh>
+#include <imagine/base/ApplicationContext.hh>
+#include <imagine/util/memory/UniqueFileStream.hh>
+#include <algorithm>
+#include <format>
+#include <unistd.h>
+
+namespace EmuEx
+{
+
+// cumulative time at each frequency since boot, reported by the kernel in 10ms ticks
+static std::vector<CPUFreqResidency> readFreqTimes()
+{
+	std::vector<CPUFreqResidency> times;
+	#ifdef __linux__
+	// policies are named after their first CPU
+	for(int policy = 0; policy < sysconf(_SC_NPROCESSORS_CONF); policy++)
+	{
+		auto file = UniqueFileStream{fopen(std::format("/sys/devices/system/cpu/cpufreq/policy{}/stats/time_in_state", policy).c_str(), "r")};
+		if(!file)
+			continue;
+		int kHz;
+		long long ticks;
+		while(fscanf(file.get(), "%d %lld", &kHz, &ticks) == 2)
+		{
+			times.emplace_back(policy, kHz, Milliseconds{ticks * 10});
+		}
+	}
+	#endif
+	return times;
+}
+
+void EnergyMeter::reset()
+{
+	freqTimesAtReset = readFreqTimes();
+	lastSampleTime = {};
+	lastMicrowatts = 0;
+	microjoules.store(0, std::memory_order_relaxed);
+	measuredTime_.store(0, std::memory_order_relaxed);
+}
+
+void EnergyMeter::sample(ApplicationContext ctx, SteadyClockTimePoint t)
+{
+	if(hasTime(lastSampleTime) && t - lastSampleTime < sampleInterval)
+		return;
+	auto microwatts = ctx.batteryPowerMicrowatts();
+	// skip intervals spanning a pause or a dropped reading instead of extrapolating over them
+	if(hasTime(lastSampleTime) && t - lastSampleTime < sampleInterval * 4 && microwatts && lastMicrowatts)
+	{
+		auto interval = t - lastSampleTime;
+		auto avgMicrowatts = (microwatts + lastMicrowatts) / 2;
+		microjoules.fetch_add(avgMicrowatts * duration_cast<Microseconds>(interval).count() / 1'000'000, std::memory_order_relaxed);
+		measuredTime_.fetch_add(interval.count(), std::memory_order_relaxed);
+	}
+	lastSampleTime = t;
+	lastMicrowatts = microwatts;
+}
+
+double EnergyMeter::averageWatts() const
+{
+	auto secs = duration_cast<FloatSeconds>(measuredTime()).count();
+	return secs ? joules() / secs : 0.;
+}
+
+std::vector<CPUFreqResidency> EnergyMeter::cpuFreqResidency() const
+{
+	if(freqTimesAtReset.empty())
+		return {};
+	auto times = readFreqTimes();
+	// match by policy and frequency since a policy's stats can be missing while its CPUs are offline
+	for(auto &t : times)
+	{
+		auto it = std::ranges::find_if(freqTimesAtReset, [&](auto &r){ return r.policy == t.policy && r.kHz == t.kHz; });
+		t.time = it != freqTimesAtReset.end() ? t.time - it->time : SteadyClockTime{}; // no baseline if it came online later
+	}
+	std::erase_if(times, [](auto &r){ return r.time.count() <= 0; });
+	return times;
+}
+
+}
@@ -0,0 +1,230 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/FrameTimeTelemetry.hh>
+#include <emuframework/Option.hh>
+#include <emuframework/EmuOptions.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/util/ranges.hh>
+#include <imagine/logger/logger.h>
+#include <format>
+#include <string>
+#include <cmath>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"FrameTimeTelemetry"};
+
+constexpr std::pair<const char*, uint32_t Gfx::DrawStats::*> drawStatFields[]
+{
+	{"draw_calls", &Gfx::DrawStats::drawCalls},
+	{"texture_binds", &Gfx::DrawStats::textureBinds},
+	{"program_switches", &Gfx::DrawStats::programSwitches},
+	{"state_changes", &Gfx::DrawStats::stateChanges},
+	{"texture_uploads", &Gfx::DrawStats::textureUploads},
+	{"buffer_uploads", &Gfx::DrawStats::bufferUploads},
+	{"upload_bytes", &Gfx::DrawStats::uploadBytes},
+};
+static_assert(std::size(drawStatFields) == drawStatCount);
+
+void FrameTimeHistogram::add(SteadyClockTime time)
+{
+	if(time.count() < 0)
+		return;
+	auto idx = std::min(size_t(duration_cast<Microseconds>(time) / binWidth), bins - 1);
+	counts[idx].fetch_add(1, std::memory_order_relaxed);
+}
+
+void FrameTimeHistogram::clear()
+{
+	for(auto &c : counts)
+		c.store(0, std::memory_order_relaxed);
+}
+
+uint32_t FrameTimeHistogram::count() const
+{
+	uint32_t total{};
+	for(auto &c : counts)
+		total += c.load(std::memory_order_relaxed);
+	return total;
+}
+
+Microseconds FrameTimeHistogram::percentile(double p) const
+{
+	auto total = count();
+	if(!total)
+		return {};
+	auto target = std::max(uint32_t(std::ceil(total * p)), 1u);
+	uint32_t sum{};
+	for(auto i : iotaCount(bins))
+	{
+		sum += binCount(i);
+		if(sum >= target)
+			return binWidth * (i + 1);
+	}
+	return binWidth * bins;
+}
+
+void FrameTimeTelemetry::setEnabled(bool on)
+{
+	if(on == enabled)
+		return;
+	enabled = on;
+	log.info("{} telemetry", on ? "enabled" : "disabled");
+	clear();
+}
+
+void FrameTimeTelemetry::recordInput(SteadyClockTimePoint t)
+{
+	if(!enabled || !hasTime(t))
+		return;
+	// keep the oldest input until it's presented
+	SteadyClockTime::rep expected{};
+	inputTimestamp.compare_exchange_strong(expected, t.time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+void FrameTimeTelemetry::record(FrameTimeStatEvent event, SteadyClockTimePoint t)
+{
+	timestamps[to_underlying(event)].store(t.time_since_epoch().count(), std::memory_order_relaxed);
+	if(event != FrameTimeStatEvent::endOfDraw)
+		return;
+	// only count inputs that arrived before this frame started drawing, otherwise it can't reflect them
+	if(auto inputTime = inputTimestamp.load(std::memory_order_relaxed);
+		inputTime && inputTime <= timestamps[to_underlying(FrameTimeStatEvent::startOfDraw)].load(std::memory_order_relaxed))
+	{
+		histograms[to_underlying(FrameTimeMetric::inputToPresent)].add(t - SteadyClockTimePoint{SteadyClockTime{inputTime}});
+		inputTimestamp.compare_exchange_strong(inputTime, 0, std::memory_order_relaxed);
+	}
+	auto startOfFrame = timestamp(FrameTimeStatEvent::startOfFrame);
+	if(!hasTime(startOfFrame))
+		return; // draw wasn't from an emulated frame
+	timestamps[to_underlying(FrameTimeStatEvent::startOfFrame)].store(0, std::memory_order_relaxed);
+	auto startOfEmulation = timestamp(FrameTimeStatEvent::startOfEmulation);
+	auto aboutToSubmitFrame = timestamp(FrameTimeStatEvent::aboutToSubmitFrame);
+	// frames that never submitted new video keep an older submit time, only count the full frame time
+	if(aboutToSubmitFrame >= startOfEmulation)
+	{
+		histograms[to_underlying(FrameTimeMetric::emulation)].add(aboutToSubmitFrame - startOfEmulation);
+		histograms[to_underlying(FrameTimeMetric::submitToPresent)].add(t - aboutToSubmitFrame);
+	}
+	histograms[to_underlying(FrameTimeMetric::frame)].add(t - startOfFrame);
+	frames_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FrameTimeTelemetry::recordDrawStats(const Gfx::DrawStats &stats)
+{
+	for(auto i : iotaCount(std::size(drawStatFields)))
+	{
+		auto val = stats.*drawStatFields[i].second;
+		drawStatTotals[i].fetch_add(val, std::memory_order_relaxed);
+		if(val > drawStatMax[i].load(std::memory_order_relaxed))
+			drawStatMax[i].store(val, std::memory_order_relaxed);
+	}
+	drawStatFrames.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FrameTimeTelemetry::clear()
+{
+	for(auto &h : histograms)
+		h.clear();
+	for(auto &t : timestamps)
+		t.store(0, std::memory_order_relaxed);
+	frames_.store(0, std::memory_order_relaxed);
+	missedFrameCallbacks_.store(0, std::memory_order_relaxed);
+	streamUnderruns_.store(0, std::memory_order_relaxed);
+	inputTimestamp.store(0, std::memory_order_relaxed);
+	drawStatFrames.store(0, std::memory_order_relaxed);
+	for(auto &t : drawStatTotals)
+		t.store(0, std::memory_order_relaxed);
+	for(auto &m : drawStatMax)
+		m.store(0, std::memory_order_relaxed);
+	energyMeter.reset();
+}
+
+const char *FrameTimeTelemetry::metricName(FrameTimeMetric m)
+{
+	switch(m)
+	{
+		case FrameTimeMetric::emulation: return "emulation";
+		case FrameTimeMetric::submitToPresent: return "submit_to_present";
+		case FrameTimeMetric::frame: return "frame";
+		case FrameTimeMetric::inputToPresent: return "input_to_present";
+	}
+	return "";
+}
+
+bool FrameTimeTelemetry::writeCSV(FileIO &io) const
+{
+	// long format so files from different builds and devices can be concatenated and compared
+	std::string csv{"metric,field,value\n"};
+	std::format_to(std::back_inserter(csv), "all,frames,{}\nall,missed_frame_callbacks,{}\nall,stream_underruns,{}\n",
+		frames(), missedFrameCallbacks(), streamUnderruns());
+	for(auto i : iotaCount(frameTimeMetrics))
+	{
+		auto m = FrameTimeMetric(i);
+		auto &h = histogram(m);
+		auto name = metricName(m);
+		std::format_to(std::back_inserter(csv), "{0},count,{1}\n{0},p50_us,{2}\n{0},p95_us,{3}\n{0},p99_us,{4}\n",
+			name, h.count(), h.percentile(.5).count(), h.percentile(.95).count(), h.percentile(.99).count());
+		for(auto b : iotaCount(FrameTimeHistogram::bins))
+		{
+			if(auto c = h.binCount(b))
+				std::format_to(std::back_inserter(csv), "{},bin_{}_us,{}\n", name, (FrameTimeHistogram::binWidth * b).count(), c);
+		}
+	}
+	if(auto drawFrames = drawStatFrames.load(std::memory_order_relaxed))
+	{
+		for(auto i : iotaCount(std::size(drawStatFields)))
+		{
+			std::format_to(std::back_inserter(csv), "draw,{0}_avg,{1:.1f}\ndraw,{0}_max,{2}\n", drawStatFields[i].first,
+				double(drawStatTotals[i].load(std::memory_order_relaxed)) / drawFrames, drawStatMax[i].load(std::memory_order_relaxed));
+		}
+	}
+	if(energyMeter.hasPower())
+	{
+		std::format_to(std::back_inserter(csv), "energy,measured_s,{:.1f}\nenergy,avg_w,{:.3f}\nenergy,mj_per_frame,{:.3f}\n",
+			duration_cast<FloatSeconds>(energyMeter.measuredTime()).count(), energyMeter.averageWatts(),
+			frames() ? energyMeter.joules() * 1000. / frames() : 0.);
+	}
+	for(auto &r : energyMeter.cpuFreqResidency())
+	{
+		std::format_to(std::back_inserter(csv), "cpufreq_policy{},{}_mhz_ms,{}\n", r.policy, r.kHz / 1000,
+			duration_cast<Milliseconds>(r.time).count());
+	}
+	return io.write(csv.data(), csv.size()) == ssize_t(csv.size());
+}
+
+bool FrameTimeTelemetry::readConfig(MapIO &io, unsigned key)
+{
+	switch(key)
+	{
+		default: return false;
+		case CFGKEY_FRAME_TIME_TELEMETRY:
+		{
+			auto read = readOptionValue(io, enabled);
+			if(enabled)
+				energyMeter.reset();
+			return read;
+		}
+	}
+}
+
+void FrameTimeTelemetry::writeConfig(FileIO &io) const
+{
+	writeOptionValueIfNotDefault(io, CFGKEY_FRAME_TIME_TELEMETRY, enabled, false);
+}
+
+}
@@ -0,0 +1,125 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/InputReplay.hh>
+#include <emuframework/EmuApp.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/logger/logger.h>
+#include <format>
+#include <stdexcept>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"InputReplay"};
+constexpr uint32_t replayMagic = 0x50525845; // "EXRP"
+constexpr uint32_t replayVersion = 1;
+
+struct ReplayHeader
+{
+	uint32_t magic{replayMagic};
+	uint32_t version{replayVersion};
+	uint32_t frames{};
+	uint32_t stateSize{};
+	uint32_t actions{};
+};
+
+void InputReplay::startRecording(EmuSystem &sys)
+{
+	startState = dynArrayForOverwrite<uint8_t>(sys.stateSize());
+	startState.trim(sys.writeState(startState, {.uncompressed = true}));
+	{
+		std::scoped_lock lock{actionMutex};
+		actionList.clear();
+	}
+	frameCount.store(0, std::memory_order_relaxed);
+	totalFrames = 0;
+	nextAction = 0;
+	recording.store(true, std::memory_order_relaxed);
+	log.info("started recording with {} byte state", startState.size());
+}
+
+void InputReplay::stopRecording()
+{
+	if(!recording.exchange(false, std::memory_order_relaxed))
+		return;
+	totalFrames = frameCount.load(std::memory_order_relaxed);
+	log.info("stopped recording after {} frames with {} actions", totalFrames, actionList.size());
+}
+
+void InputReplay::recordAction(InputAction action)
+{
+	if(!isRecording())
+		return;
+	// input arrives on the main thread while frames run on the emulation thread,
+	// so the action is applied before the next frame that hasn't started yet
+	std::scoped_lock lock{actionMutex};
+	actionList.emplace_back(frameCount.load(std::memory_order_relaxed), action.metaState,
+		action.code, std::bit_cast<uint8_t>(action.flags), action.state);
+}
+
+void InputReplay::onFramesRun(int frames)
+{
+	if(!isRecording())
+		return;
+	frameCount.fetch_add(frames, std::memory_order_relaxed);
+}
+
+bool InputReplay::write(FileIO &io) const
+{
+	assert(!isRecording());
+	ReplayHeader header{.frames = totalFrames, .stateSize = uint32_t(startState.size()), .actions = uint32_t(actionList.size())};
+	return io.put(header) == ssize_t(sizeof(header)) &&
+		io.write(startState.span()).bytes == ssize_t(startState.size()) &&
+		io.write(std::span{actionList}).bytes == ssize_t(actionList.size() * sizeof(ReplayAction));
+}
+
+void InputReplay::read(FileIO &io)
+{
+	stopRecording();
+	auto header = io.get<ReplayHeader>();
+	if(header.magic != replayMagic)
+		throw std::runtime_error{"not an input replay file"};
+	if(header.version != replayVersion)
+		throw std::runtime_error{std::format("unsupported replay version {}", header.version)};
+	if(!header.stateSize)
+		throw std::runtime_error{"replay has no starting state"};
+	startState = dynArrayForOverwrite<uint8_t>(header.stateSize);
+	if(io.read(startState.span()).bytes != ssize_t(header.stateSize))
+		throw std::runtime_error{"truncated replay state"};
+	actionList.resize(header.actions);
+	if(io.read(std::span{actionList}).bytes != ssize_t(header.actions * sizeof(ReplayAction)))
+		throw std::runtime_error{"truncated replay actions"};
+	totalFrames = header.frames;
+	nextAction = 0;
+	log.info("read replay of {} frames with {} actions", totalFrames, actionList.size());
+}
+
+void InputReplay::rewind(EmuApp &app, EmuSystem &sys)
+{
+	assert(hasData());
+	sys.readState(app, startState);
+	nextAction = 0;
+}
+
+void InputReplay::applyActions(EmuApp &app, EmuSystem &sys, uint32_t frame)
+{
+	for(; nextAction < actionList.size() && actionList[nextAction].frame <= frame; nextAction++)
+	{
+		sys.handleInputAction(&app, actionList[nextAction].inputAction());
+	}
+}
+
+}
@@ -75,13 +75,13 @@ bool OutputTimingManager::setFrameTimeOption(VideoSystem vidSys, FrameTime time)
 	return true;
 }
 
-FrameTimeConfig OutputTimingManager::frameTimeConfig(const EmuSystem &system, std::span<const FrameRate> supportedFrameRates) const
+FrameTimeConfig OutputTimingManager::frameTimeConfig(const EmuSystem &system, std::span<const FrameRate> supportedFrameRates, bool variableRefresh) const
 {
 	auto t = frameTimeVar(system.videoSystem());
 	assumeExpr(frameTimeOptionIsValid(t));
 	if(t.count() > 0)
 		return {t, FrameRate(toHz(t)), 0};
-	else if(t == originalOption)
+	else if(t == originalOption || variableRefresh)
 		return {system.scaledFrameTime(), FrameRate(system.scaledFrameRate()), 0};
 	return bestOutputTimeForScreen(supportedFrameRates, system.scaledFrameTime());
 }
@@ -0,0 +1,166 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/RamSearch.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"RamSearch"};
+constexpr size_t blockSize = 64; // bytes per candidate word
+
+StateSection stateSection(EmuSystem &sys, size_t idx)
+{
+	StateSection sec;
+	size_t i{};
+	sys.forEachStateSection([&](StateSection s)
+	{
+		if(i++ == idx)
+			sec = s;
+	});
+	return sec;
+}
+
+// Compares a full block into a byte array in a loop the compiler vectorizes,
+// then packs each group of 8 0/1 bytes into 8 bits with one multiply
+template<class Cmp>
+static uint64_t compareBlock(const uint8_t *cur, const uint8_t *prev, Cmp cmp)
+{
+	uint8_t res[blockSize];
+	for(size_t i = 0; i < blockSize; i++)
+		res[i] = cmp(cur[i], prev[i]);
+	uint64_t mask{};
+	for(size_t i = 0; i < blockSize / 8; i++)
+	{
+		uint64_t bytes;
+		std::memcpy(&bytes, &res[i * 8], 8);
+		if constexpr(std::endian::native == std::endian::big)
+			bytes = std::byteswap(bytes);
+		mask |= ((bytes * 0x0102040810204080) >> 56) << (i * 8);
+	}
+	return mask;
+}
+
+template<class Cmp>
+static size_t filterCandidates(std::span<uint64_t> bits, std::span<const uint8_t> cur, std::span<const uint8_t> prev, Cmp cmp)
+{
+	size_t count{};
+	const auto fullBlocks = cur.size() / blockSize;
+	for(size_t w = 0; w < fullBlocks; w++)
+	{
+		if(bits[w])
+			bits[w] &= compareBlock(&cur[w * blockSize], &prev[w * blockSize], cmp);
+		count += std::popcount(bits[w]);
+	}
+	if(auto tail = cur.size() % blockSize)
+	{
+		auto &word = bits[fullBlocks];
+		auto base = fullBlocks * blockSize;
+		for(size_t i = 0; i < tail; i++)
+		{
+			if(!cmp(cur[base + i], prev[base + i]))
+				word &= ~(uint64_t{1} << i);
+		}
+		count += std::popcount(word);
+	}
+	return count;
+}
+
+bool RamSearch::start(EmuSystem &sys, size_t idx)
+{
+	auto sec = stateSection(sys, idx);
+	if(sec.data.empty())
+	{
+		reset();
+		return false;
+	}
+	snapshot.assign(sec.data.begin(), sec.data.end());
+	candidateBits.assign((sec.data.size() + blockSize - 1) / blockSize, ~uint64_t{});
+	if(auto tail = sec.data.size() % blockSize)
+		candidateBits.back() = (uint64_t{1} << tail) - 1;
+	candidateCount = sec.data.size();
+	cursorWord = cursorCandidates = 0;
+	sectionIdx = idx;
+	address = sec.address;
+	log.info("started search of {} ({} bytes)", sec.name, sec.data.size());
+	return true;
+}
+
+void RamSearch::filter(EmuSystem &sys, RamSearchCompare compare, uint8_t value)
+{
+	if(!isActive())
+		return;
+	auto cur = stateSection(sys, sectionIdx).data;
+	if(cur.size() != snapshot.size())
+	{
+		log.warn("section size changed, ending search");
+		reset();
+		return;
+	}
+	switch(compare)
+	{
+		case RamSearchCompare::equal:
+			candidateCount = filterCandidates(candidateBits, cur, snapshot, [](uint8_t c, uint8_t p) { return c == p; }); break;
+		case RamSearchCompare::notEqual:
+			candidateCount = filterCandidates(candidateBits, cur, snapshot, [](uint8_t c, uint8_t p) { return c != p; }); break;
+		case RamSearchCompare::greater:
+			candidateCount = filterCandidates(candidateBits, cur, snapshot, [](uint8_t c, uint8_t p) { return c > p; }); break;
+		case RamSearchCompare::less:
+			candidateCount = filterCandidates(candidateBits, cur, snapshot, [](uint8_t c, uint8_t p) { return c < p; }); break;
+		case RamSearchCompare::equalValue:
+			candidateCount = filterCandidates(candidateBits, cur, snapshot, [=](uint8_t c, uint8_t) { return c == value; }); break;
+	}
+	std::ranges::copy(cur, snapshot.begin());
+	cursorWord = cursorCandidates = 0;
+}
+
+void RamSearch::reset()
+{
+	snapshot = {};
+	candidateBits = {};
+	candidateCount = 0;
+	cursorWord = cursorCandidates = 0;
+}
+
+size_t RamSearch::candidateOffset(size_t idx) const
+{
+	assert(idx < candidateCount);
+	// walk from the word of the last lookup since results are viewed a screen of rows at a time
+	auto w = cursorWord;
+	auto before = cursorCandidates;
+	while(idx < before)
+	{
+		before -= std::popcount(candidateBits[--w]);
+	}
+	while(idx >= before + std::popcount(candidateBits[w]))
+	{
+		before += std::popcount(candidateBits[w++]);
+	}
+	cursorWord = w;
+	cursorCandidates = before;
+	auto word = candidateBits[w];
+	for(auto n = idx - before; n; n--)
+	{
+		word &= word - 1;
+	}
+	return w * blockSize + std::countr_zero(word);
+}
+
+}
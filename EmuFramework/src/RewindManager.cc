@@ -15,9 +15,16 @@
 
 #include <emuframework/RewindManager.hh>
 #include <emuframework/EmuApp.hh>
+#include <emuframework/EmuViewController.hh>
 #include <emuframework/Option.hh>
 #include <emuframework/EmuOptions.hh>
+#include <imagine/base/ApplicationContext.hh>
+#include <imagine/fs/FS.hh>
+#include <imagine/util/ScopeGuard.hh>
 #include <imagine/logger/logger.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 
 namespace EmuEx
 {
@@ -25,6 +32,250 @@ namespace EmuEx
 constexpr SystemLogger log{"RewindMgr"};
 constexpr Seconds defaultSaveFreq{1};
 
+// Delta encoding: a sequence of blocks, each made of a 32-bit count of unchanged bytes to skip,
+// a 32-bit literal length, and the literal bytes XOR'd with the reference state.
+// A zero run must be at least minZeroRun bytes to end a literal so the encoded size
+// never exceeds the state size by more than a single block header.
+constexpr size_t blockHeaderSize = sizeof(uint32_t) * 2;
+constexpr size_t minZeroRun = blockHeaderSize;
+
+static uint64_t loadWord(const uint8_t *p)
+{
+	uint64_t w;
+	std::memcpy(&w, p, sizeof(w));
+	return w;
+}
+
+// encode state, or keyframe if ref is null, into dest which must be at least maxEncodedSize() bytes
+static size_t encodeDelta(uint8_t *dest, std::span<const uint8_t> state, const uint8_t *ref)
+{
+	const size_t size = state.size();
+	const uint8_t *src = state.data();
+	auto diffAt = [&](size_t i) -> uint8_t { return ref ? src[i] ^ ref[i] : src[i]; };
+	size_t outPos{}, i{};
+	while(i < size)
+	{
+		size_t skipStart = i;
+		if(ref)
+			while(i + 8 <= size && loadWord(src + i) == loadWord(ref + i)) i += 8;
+		else
+			while(i + 8 <= size && !loadWord(src + i)) i += 8;
+		while(i < size && !diffAt(i)) i++;
+		if(i == size)
+			break;
+		size_t litStart = i, zeros{};
+		while(i < size)
+		{
+			if(diffAt(i++))
+				zeros = 0;
+			else if(++zeros == minZeroRun)
+				break;
+		}
+		size_t litEnd = zeros == minZeroRun ? i - minZeroRun : i;
+		uint32_t header[2]{uint32_t(litStart - skipStart), uint32_t(litEnd - litStart)};
+		std::memcpy(dest + outPos, header, sizeof(header));
+		outPos += sizeof(header);
+		for(auto j = litStart; j < litEnd; j++)
+			dest[outPos++] = diffAt(j);
+		i = litEnd;
+	}
+	return outPos;
+}
+
+// XOR the encoded blocks into dest, which must be zeroed first when decoding a keyframe
+static void applyDelta(std::span<uint8_t> dest, std::span<const uint8_t> delta)
+{
+	size_t pos{};
+	for(size_t i = 0; i < delta.size();)
+	{
+		uint32_t header[2];
+		std::memcpy(header, &delta[i], sizeof(header));
+		i += sizeof(header);
+		pos += header[0];
+		assumeExpr(pos + header[1] <= dest.size());
+		for(auto j : iotaCount(header[1]))
+			dest[pos + j] ^= delta[i + j];
+		pos += header[1];
+		i += header[1];
+	}
+}
+
+size_t DeltaStateStore::maxEncodedSize(size_t stateSize) { return stateSize + blockHeaderSize; }
+
+void DeltaStateStore::reset(size_t buffSize, size_t maxRecords, size_t stateSize)
+{
+	clear();
+	recordBuff.resetForOverwrite(buffSize);
+	records.reset(maxRecords);
+	headState.reset(stateSize);
+}
+
+void DeltaStateStore::clear()
+{
+	onDropGroup = {};
+	recordBuff = {};
+	records = {};
+	headState = {};
+	resetPositions();
+}
+
+void DeltaStateStore::resetPositions()
+{
+	firstRecordIdx = recordCount = recordWritePos = recordsSinceKeyframe = storedBytes = 0;
+}
+
+size_t DeltaStateStore::bytesAllocated() const
+{
+	return recordBuff.size() + records.size() * sizeof(DeltaRecord) + headState.size();
+}
+
+size_t DeltaStateStore::allocRecord(size_t size)
+{
+	assumeExpr(size <= recordBuff.size());
+	if(recordCount == records.size())
+		popOldestRecordGroup();
+	auto pos = recordWritePos;
+	if(pos + size > recordBuff.size())
+	{
+		// wrap around, dropping any records still stored past the write position
+		while(recordCount && records[firstRecordIdx].offset >= recordWritePos)
+			popOldestRecordGroup();
+		pos = 0;
+	}
+	while(recordCount)
+	{
+		auto &oldest = records[firstRecordIdx];
+		if(oldest.offset >= pos + size || oldest.offset + oldest.dataSize <= pos)
+			break;
+		popOldestRecordGroup();
+	}
+	if(!recordCount)
+		pos = 0;
+	recordWritePos = pos + size;
+	return pos;
+}
+
+void DeltaStateStore::popOldestRecordGroup()
+{
+	// the oldest record is always a keyframe, drop it with all deltas depending on it
+	assumeExpr(recordCount);
+	if(onDropGroup)
+		onDropGroup(*this);
+	do
+	{
+		storedBytes -= records[firstRecordIdx].dataSize;
+		firstRecordIdx = recordIdx(1);
+		recordCount--;
+	} while(recordCount && !records[firstRecordIdx].isKeyframe);
+	if(!recordCount)
+		resetPositions();
+}
+
+void DeltaStateStore::save(std::span<const uint8_t> state, size_t size, uint64_t seq, size_t keyframeInterval, std::span<uint8_t> encodeBuff)
+{
+	assumeExpr(state.size() == headState.size());
+	bool isKeyframe = !recordCount || recordsSinceKeyframe + 1 >= keyframeInterval;
+	auto encodedSize = encodeDelta(encodeBuff.data(), state, isKeyframe ? nullptr : headState.data());
+	auto offset = allocRecord(encodedSize);
+	if(!isKeyframe && !recordCount)
+	{
+		// the group this delta depends on was dropped to make space
+		isKeyframe = true;
+		encodedSize = encodeDelta(encodeBuff.data(), state, nullptr);
+		offset = allocRecord(encodedSize);
+	}
+	std::copy_n(encodeBuff.data(), encodedSize, &recordBuff[offset]);
+	records[recordIdx(recordCount)] = {seq, offset, uint32_t(encodedSize), uint32_t(size), isKeyframe};
+	recordCount++;
+	storedBytes += encodedSize;
+	recordsSinceKeyframe = isKeyframe ? 0 : recordsSinceKeyframe + 1;
+	std::copy(state.begin(), state.end(), headState.begin());
+	//log.debug("saved {} rewind state size:{} encoded:{}", isKeyframe ? "keyframe" : "delta", size, encodedSize);
+}
+
+void DeltaStateStore::popNewest()
+{
+	assumeExpr(recordCount);
+	auto rec = newestRecord();
+	recordCount--;
+	storedBytes -= rec.dataSize;
+	recordWritePos = rec.offset;
+	if(!recordCount)
+	{
+		resetPositions();
+		return;
+	}
+	if(rec.isKeyframe)
+	{
+		rebuildHeadState();
+	}
+	else
+	{
+		// XOR is its own inverse so the delta takes the head back to the previous state
+		applyDelta(headState, recordData(rec));
+		recordsSinceKeyframe--;
+	}
+}
+
+void DeltaStateStore::rebuildHeadState()
+{
+	size_t keyIdx = recordCount - 1;
+	while(!records[recordIdx(keyIdx)].isKeyframe)
+		keyIdx--;
+	std::fill(headState.begin(), headState.end(), 0);
+	for(auto i = keyIdx; i < recordCount; i++)
+	{
+		applyDelta(headState, recordData(records[recordIdx(i)]));
+	}
+	recordsSinceKeyframe = recordCount - 1 - keyIdx;
+}
+
+// Serialized groups are a sequence of records, each a header followed by its encoded data,
+// starting with the keyframe
+struct GroupRecordHeader
+{
+	uint64_t seq;
+	uint32_t dataSize;
+	uint32_t stateSize;
+};
+
+void DeltaStateStore::serializeOldestGroup(std::vector<uint8_t> &out) const
+{
+	assumeExpr(recordCount);
+	out.clear();
+	for(size_t i = 0; i < recordCount; i++)
+	{
+		auto &rec = records[recordIdx(i)];
+		if(i && rec.isKeyframe)
+			break;
+		GroupRecordHeader header{rec.seq, rec.dataSize, rec.stateSize};
+		auto pos = out.size();
+		out.resize(pos + sizeof(header) + rec.dataSize);
+		std::memcpy(&out[pos], &header, sizeof(header));
+		std::copy_n(&recordBuff[rec.offset], rec.dataSize, &out[pos + sizeof(header)]);
+	}
+}
+
+void DeltaStateStore::loadGroup(std::span<const uint8_t> data)
+{
+	assumeExpr(!recordCount);
+	for(size_t i = 0; i + sizeof(GroupRecordHeader) <= data.size();)
+	{
+		GroupRecordHeader header;
+		std::memcpy(&header, &data[i], sizeof(header));
+		i += sizeof(header);
+		assumeExpr(i + header.dataSize <= data.size());
+		auto offset = allocRecord(header.dataSize);
+		std::copy_n(&data[i], header.dataSize, &recordBuff[offset]);
+		records[recordIdx(recordCount)] = {header.seq, offset, header.dataSize, header.stateSize, !recordCount};
+		recordCount++;
+		storedBytes += header.dataSize;
+		i += header.dataSize;
+	}
+	if(recordCount)
+		rebuildHeadState();
+}
+
 RewindManager::RewindManager(EmuApp &app):
 	saveTimer
 	{
@@ -33,7 +284,8 @@ RewindManager::RewindManager(EmuApp &app):
 		[this, &app]()
 		{
 			//log.debug("running rewind save state timer");
-			saveState(app);
+			app.syncEmulationThread();
+			saveState(app.system());
 			saveTimer.update();
 			return true;
 		}
@@ -42,17 +294,33 @@ RewindManager::RewindManager(EmuApp &app):
 void RewindManager::clear()
 {
 	saveTimer.cancel();
+	rewinding = false;
 	stateEntries = {};
 	stateIdx = 0;
 	stateSize = 0;
+	clearDeltaStorage();
+	memoryCharge.set(0);
 }
 
 bool RewindManager::reset()
 {
 	if(!stateSize)
 		return true;
+	auto updateCharge = scopeGuard([&]{ memoryCharge.set(memoryAllocated()); });
 	try
 	{
+		if(usesMemoryBudget())
+		{
+			stateEntries = {};
+			resetBudgetStorage();
+			return true;
+		}
+		if(usesDeltaStates() && maxStates)
+		{
+			stateEntries = {};
+			return resetDeltaStorage();
+		}
+		clearDeltaStorage();
 		if(maxStates)
 			log.info("allocating {} states of size:{}", maxStates, stateSize);
 		stateEntries.reset(maxStates, stateSize);
@@ -65,34 +333,371 @@ bool RewindManager::reset()
 	}
 }
 
-void RewindManager::saveState(EmuApp &app)
+bool RewindManager::resetDeltaStorage()
+{
+	clearDeltaStorage();
+	// budget enough space for every keyframe at its worst-case size plus the same again for deltas
+	auto keyframes = maxStates / keyframeInterval + 1;
+	auto buffSize = keyframes * DeltaStateStore::maxEncodedSize(stateSize) * 2;
+	log.info("allocating {} bytes for {} delta states with keyframe interval:{}", buffSize, maxStates, keyframeInterval);
+	stores[0].reset(buffSize, maxStates, stateSize);
+	scratchState.resetForOverwrite(stateSize);
+	encodeBuff.resetForOverwrite(DeltaStateStore::maxEncodedSize(stateSize));
+	setupSpill();
+	return true;
+}
+
+// Memory budget tiers: every adaptive interval (starting at every frame) for the last few seconds,
+// every second for the last minute, and every 10 seconds for as long as the rest of the budget lasts
+constexpr double recentTierSecs = 5;
+constexpr double minuteTierSecs = 60;
+constexpr double longTierIntervalSecs = 10;
+constexpr size_t budgetKeyframeInterval = 30;
+constexpr size_t adaptIntervalSaves = 64;
+
+void RewindManager::resetBudgetStorage()
+{
+	clearDeltaStorage();
+	size_t budget = size_t(memoryBudgetMiB) * 1024 * 1024;
+	// each store needs space for at least a couple of worst-case keyframes
+	auto minStoreSize = DeltaStateStore::maxEncodedSize(stateSize) * 2;
+	std::array<size_t, rewindTierCount> storeSize{budget / 4, budget / 4, budget / 2};
+	for(auto &size : storeSize)
+	{
+		if(size < minStoreSize)
+		{
+			log.warn("rewind memory budget too small for state size:{}", stateSize);
+			size = minStoreSize;
+		}
+	}
+	auto framesPerSec = std::max(size_t(std::round(frameRate)), 1zu);
+	storeFrameInterval = {1, framesPerSec, framesPerSec * size_t(longTierIntervalSecs)};
+	std::array<size_t, rewindTierCount> storeRecords
+	{
+		size_t(recentTierSecs * framesPerSec) + 1,
+		size_t(minuteTierSecs) + 1,
+		std::clamp(storeSize[2] / 4096, 64zu, 16384zu),
+	};
+	for(auto i : iotaCount(rewindTierCount))
+	{
+		log.info("allocating {} bytes for up to {} delta states every {} frame(s)", storeSize[i], storeRecords[i], storeFrameInterval[i]);
+		stores[i].reset(storeSize[i], storeRecords[i], stateSize);
+	}
+	scratchState.resetForOverwrite(stateSize);
+	encodeBuff.resetForOverwrite(DeltaStateStore::maxEncodedSize(stateSize));
+	setupSpill();
+}
+
+void RewindManager::clearDeltaStorage()
+{
+	for(auto &store : stores)
+		store.clear();
+	scratchState = {};
+	encodeBuff = {};
+	frameCount = framesSinceSave = savesSinceAdapt = 0;
+	adaptiveFrameInterval = 1;
+	clearSpill();
+}
+
+// the spill file can grow to this many times the size of the store it spills from
+constexpr size_t spillSizeMultiple = 8;
+
+void RewindManager::setupSpill()
+{
+	if(!diskSpill)
+		return;
+	auto &store = spillStore();
+	spillCapacity = store.capacity() * spillSizeMultiple;
+	store.onDropGroup = [this](const DeltaStateStore &s){ spillOldestGroup(s); };
+}
+
+void RewindManager::openSpillFile(ApplicationContext ctx)
+{
+	spillPath = FS::pathString(ctx.cachePath(), "rewind.spill");
+	spillFile = FileIO{spillPath, {.read = true, .write = true, .create = true, .truncate = true, .test = true}};
+	if(!spillFile)
+	{
+		log.error("can't open rewind spill file:{}", spillPath);
+		spillCapacity = 0;
+		return;
+	}
+	log.info("spilling up to {} bytes of rewind states to:{}", spillCapacity, spillPath);
+}
+
+void RewindManager::clearSpill()
+{
+	spillWriter.stop();
+	spillGroups.clear();
+	spillBuff = {};
+	spillWritePos = spillCapacity = 0;
+	if(!spillFile)
+		return;
+	spillFile = {};
+	FS::remove(spillPath);
+}
+
+void RewindManager::spillOldestGroup(const DeltaStateStore &store)
+{
+	if(!spillFile)
+		return;
+	store.serializeOldestGroup(spillBuff);
+	auto size = spillBuff.size();
+	if(size > spillCapacity)
+		return;
+	auto pos = spillWritePos;
+	if(pos + size > spillCapacity)
+	{
+		// wrap around, dropping any groups still stored past the write position
+		while(spillGroups.size() && spillGroups.front().offset >= spillWritePos)
+			spillGroups.erase(spillGroups.begin());
+		pos = 0;
+	}
+	while(spillGroups.size())
+	{
+		auto &oldest = spillGroups.front();
+		if(oldest.offset >= pos + size || oldest.offset + oldest.size <= pos)
+			break;
+		spillGroups.erase(spillGroups.begin());
+	}
+	spillWriter.push(spillFile, spillBuff, pos);
+	spillGroups.emplace_back(pos, size);
+	spillWritePos = pos + size;
+}
+
+bool RewindManager::loadSpilledGroup()
+{
+	if(spillGroups.empty())
+		return false;
+	auto group = spillGroups.back();
+	spillGroups.pop_back();
+	spillWritePos = group.offset;
+	spillWriter.wait();
+	spillBuff.resize(group.size);
+	if(spillFile.read(spillBuff.data(), group.size, group.offset) != ssize_t(group.size))
+	{
+		log.error("error reading {} bytes of spilled rewind states", group.size);
+		spillGroups.clear();
+		return false;
+	}
+	log.info("loaded {} bytes of spilled rewind states, {} group(s) left on disk", group.size, spillGroups.size());
+	spillStore().loadGroup(spillBuff);
+	return true;
+}
+
+size_t RewindManager::spillBytesUsed() const
 {
+	size_t bytes{};
+	for(auto &group : spillGroups)
+		bytes += group.size;
+	return bytes;
+}
+
+void RewindManager::saveDeltaState(EmuSystem &sys)
+{
+	if(spillCapacity && !spillFile)
+		openSpillFile(sys.appContext());
+	auto size = sys.writeState(scratchState, {.uncompressed = true, .sessionOnly = true});
+	assumeExpr(size <= scratchState.size());
+	// clear any bytes past the end of the state so they don't show up in the next delta
+	std::fill(scratchState.begin() + size, scratchState.end(), 0);
+	if(!usesMemoryBudget())
+	{
+		stores[0].save(scratchState, size, frameCount, keyframeInterval, encodeBuff);
+		return;
+	}
+	auto kfInterval = keyframeInterval ? keyframeInterval : budgetKeyframeInterval;
+	stores[0].save(scratchState, size, frameCount, kfInterval, encodeBuff);
+	for(auto i : iotaCount(rewindTierCount - 1))
+	{
+		auto &store = stores[i + 1];
+		if(store.empty() || frameCount - store.newestSeq() >= storeFrameInterval[i + 1])
+			store.save(scratchState, size, frameCount, kfInterval, encodeBuff);
+	}
+	if(++savesSinceAdapt == adaptIntervalSaves)
+	{
+		savesSinceAdapt = 0;
+		adaptFrameInterval();
+	}
+}
+
+void RewindManager::adaptFrameInterval()
+{
+	// pick the shortest interval that lets the recent store cover its whole span
+	// with the measured average encoded state size
+	auto &store = stores[0];
+	if(store.size() < 2)
+		return;
+	auto bytesPerSave = store.bytesUsed() / store.size();
+	auto recentFrames = size_t(recentTierSecs * frameRate);
+	auto bytesNeeded = [&](size_t interval){ return bytesPerSave * (recentFrames / interval + 1); };
+	auto maxInterval = storeFrameInterval[1];
+	auto prevInterval = adaptiveFrameInterval;
+	if(bytesNeeded(adaptiveFrameInterval) > store.capacity() && adaptiveFrameInterval < maxInterval)
+		adaptiveFrameInterval = std::min(adaptiveFrameInterval * 2, maxInterval);
+	else if(adaptiveFrameInterval > 1 && bytesNeeded(adaptiveFrameInterval / 2) * 2 < store.capacity())
+		adaptiveFrameInterval /= 2;
+	if(adaptiveFrameInterval != prevInterval)
+		log.info("rewind frame interval now {} with {} bytes per state", adaptiveFrameInterval, bytesPerSave);
+}
+
+bool RewindManager::loadPrevDeltaState(EmuApp &app)
+{
+	// load the newest state from any store, then drop any saved at or after it from the others
+	DeltaStateStore *newest{};
+	for(auto &store : stores)
+	{
+		if(!store.empty() && (!newest || store.newestSeq() > newest->newestSeq()))
+			newest = &store;
+	}
+	if(!newest)
+	{
+		if(!loadSpilledGroup())
+			return false;
+		newest = &spillStore();
+	}
+	auto seq = newest->newestSeq();
+	log.debug("rewinding to state of frame:{}", seq);
+	app.system().readState(app, newest->newestState());
+	newest->popNewest();
+	for(auto &store : stores)
+	{
+		if(&store != newest)
+			store.dropFromSeq(seq);
+	}
+	frameCount = seq;
+	framesSinceSave = 0;
+	return true;
+}
+
+size_t RewindManager::memoryUsed() const
+{
+	if(stateEntries.size())
+	{
+		size_t states{};
+		for(auto i : iotaCount(stateEntries.size()))
+		{
+			if(stateEntries[i].size)
+				states++;
+		}
+		return states * stateSize;
+	}
+	size_t bytes{};
+	for(auto &store : stores)
+		bytes += store.bytesUsed();
+	return bytes;
+}
+
+size_t RewindManager::memoryAllocated() const
+{
+	if(stateEntries.size())
+		return stateEntries.size() * (sizeof(StateEntry) + stateSize);
+	size_t bytes = scratchState.size() + encodeBuff.size();
+	for(auto &store : stores)
+		bytes += store.bytesAllocated();
+	return bytes;
+}
+
+void RewindManager::saveState(EmuSystem &sys)
+{
+	if(usesDeltaStates())
+	{
+		saveDeltaState(sys);
+		return;
+	}
 	assumeExpr(maxStates);
 	assumeExpr(stateIdx < maxStates);
 	//log.debug("saving rewind state index:{}", stateIdx);
 	auto &entry = stateEntries[stateIdx];
 	stateIdx = stateIdx + 1 == maxStates ? 0 : stateIdx + 1;
-	entry.size = app.writeState({entry.data, stateSize}, {.uncompressed = true});
+	entry.size = sys.writeState({entry.data, stateSize}, {.uncompressed = true, .sessionOnly = true});
 }
 
-void RewindManager::rewindState(EmuApp &app)
+bool RewindManager::loadPrevState(EmuApp &app)
 {
-	if(!maxStates)
-		return;
+	if(usesDeltaStates())
+		return loadPrevDeltaState(app);
+	if(!stateEntries.size())
+		return false;
 	assumeExpr(stateIdx < maxStates);
 	auto prevIdx = stateIdx ? stateIdx - 1 : maxStates - 1;
 	auto &entry = stateEntries[prevIdx];
 	if(!entry.size)
-		return;
+		return false;
 	log.info("rewinding to state index:{}", prevIdx);
-	app.readState({entry.data, std::exchange(entry.size, 0)});
+	app.system().readState(app, {entry.data, std::exchange(entry.size, 0)});
 	stateIdx = prevIdx;
-	saveTimer.reset();
+	return true;
+}
+
+void RewindManager::rewindState(EmuApp &app)
+{
+	if(!isEnabled())
+		return;
+	app.syncEmulationThread();
+	app.stopInputRecording("rewind");
+	if(!loadPrevState(app))
+		return;
+	app.system().clearInputBuffers(app.viewController().inputView);
+	app.autosaveManager.resetTimer();
+	resetTimer();
+}
+
+void RewindManager::setRewinding(EmuApp &app, bool on)
+{
+	if(isRewinding() == on)
+		return;
+	if(on)
+	{
+		if(!hasStorage())
+			return;
+		log.info("starting continuous rewind");
+		app.stopInputRecording("rewind");
+		saveTimer.pause();
+		framesUntilRewindStep = 0;
+		rewinding = true;
+	}
+	else
+	{
+		log.info("stopping continuous rewind");
+		app.syncEmulationThread();
+		rewinding = false;
+		app.system().clearInputBuffers(app.viewController().inputView);
+		app.autosaveManager.resetTimer();
+		resetTimer();
+	}
+}
+
+bool RewindManager::stepRewind(EmuApp &app, int frames)
+{
+	framesUntilRewindStep -= frames;
+	if(framesUntilRewindStep > 0)
+		return false;
+	framesUntilRewindStep = continuousRewindInterval;
+	try
+	{
+		return loadPrevState(app);
+	}
+	catch(std::exception &err)
+	{
+		log.error("error loading rewind state:{}", err.what());
+		return false;
+	}
+}
+
+void RewindManager::runRewindFrame(EmuApp &app, EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio)
+{
+	if(!reverseAudio)
+		audio = nullptr;
+	if(audio)
+		audio->setReverseWrites(true);
+	app.system().runFrame(taskCtx, video, audio);
+	if(audio)
+		audio->setReverseWrites(false);
 }
 
 void RewindManager::startTimer()
 {
-	if(!stateEntries.size())
+	if(!hasStorage() || usesFrameInterval())
 		return;
 	saveTimer.start();
 }
@@ -102,6 +707,13 @@ void RewindManager::pauseTimer()
 	saveTimer.pause();
 }
 
+void RewindManager::resetTimer()
+{
+	saveTimer.cancel();
+	framesSinceSave = 0;
+	startTimer();
+}
+
 bool RewindManager::readConfig(MapIO &io, unsigned key)
 {
 	switch(key)
@@ -113,6 +725,13 @@ bool RewindManager::readConfig(MapIO &io, unsigned key)
 			if(s > 0)
 				saveTimer.frequency = Seconds{s};
 		});
+		case CFGKEY_REWIND_KEYFRAME_INTERVAL: return readOptionValue<uint16_t>(io, [&](auto i){ keyframeInterval = i; });
+		case CFGKEY_REWIND_FRAME_INTERVAL: return readOptionValue<uint16_t>(io, [&](auto i){ frameInterval = i; });
+		case CFGKEY_REWIND_CONTINUOUS: return readOptionValue(io, continuousRewind);
+		case CFGKEY_REWIND_CONTINUOUS_INTERVAL: return readOptionValue(io, continuousRewindInterval, [](auto i){ return i > 0; });
+		case CFGKEY_REWIND_REVERSE_AUDIO: return readOptionValue(io, reverseAudio);
+		case CFGKEY_REWIND_MEMORY_BUDGET: return readOptionValue(io, memoryBudgetMiB);
+		case CFGKEY_REWIND_DISK_SPILL: return readOptionValue(io, diskSpill);
 	}
 }
 
@@ -120,6 +739,13 @@ void RewindManager::writeConfig(FileIO &io) const
 {
 	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_STATES, uint32_t(maxStates), 0u);
 	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_TIMER_SECS, int16_t(saveTimer.frequency.count()), defaultSaveFreq.count());
+	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_KEYFRAME_INTERVAL, uint16_t(keyframeInterval), uint16_t{});
+	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_FRAME_INTERVAL, uint16_t(frameInterval), uint16_t{});
+	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_CONTINUOUS, continuousRewind, false);
+	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_CONTINUOUS_INTERVAL, continuousRewindInterval, defaultContinuousRewindInterval);
+	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_REVERSE_AUDIO, reverseAudio, true);
+	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_MEMORY_BUDGET, memoryBudgetMiB, uint16_t{});
+	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_DISK_SPILL, diskSpill, false);
 }
 
 
@@ -0,0 +1,110 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/RunAheadManager.hh>
+#include <emuframework/EmuApp.hh>
+#include <emuframework/Option.hh>
+#include <emuframework/EmuOptions.hh>
+#include <imagine/util/ranges.hh>
+#include <imagine/logger/logger.h>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"RunAhead"};
+
+bool RunAheadManager::runFrames(EmuApp &app, EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio, int frames)
+{
+	// only worth running ahead when the result will be presented
+	if(!frames_ || !video)
+		return false;
+	auto &sys = app.system();
+	if(useSecondInstance && sys.hasRunAheadInstance())
+	{
+		// the primary instance only runs forward, the system copies its state to a secondary one
+		// that renders the speculative frame
+		app.skipFrames(taskCtx, frames, audio);
+		try
+		{
+			sys.runAheadFrames(taskCtx, *video, frames_);
+		}
+		catch(std::exception &err)
+		{
+			log.error("disabling run-ahead due to second instance error:{}", err.what());
+			frames_ = 0;
+		}
+		return true;
+	}
+	auto stateSize = sys.stateSize();
+	if(!stateSize)
+		return false;
+	if(stateBuff.size() < stateSize)
+	{
+		log.info("allocating {} byte run-ahead state", stateSize);
+		stateBuff = dynArrayForOverwrite<uint8_t>(stateSize);
+	}
+	// advance the real timeline with audio, then speculatively run ahead to draw a frame
+	// that already reflects the current input, and roll back to the saved state
+	app.skipFrames(taskCtx, frames, audio);
+	try
+	{
+		std::span<uint8_t> state{stateBuff.data(), sys.writeState(stateBuff, {.uncompressed = true, .sessionOnly = true})};
+		// speculative frames run the system directly so turbo input and the replay frame count
+		// only advance with the real timeline
+		for([[maybe_unused]] auto i : iotaCount(frames_ - 1))
+		{
+			sys.runFrame(taskCtx, nullptr, nullptr);
+		}
+		sys.runFrame(taskCtx, video, nullptr);
+		sys.readState(app, state);
+	}
+	catch(std::exception &err)
+	{
+		log.error("disabling run-ahead due to state error:{}", err.what());
+		frames_ = 0;
+		stateBuff = {};
+	}
+	return true;
+}
+
+void RunAheadManager::updateFrames(int8_t frames)
+{
+	frames_ = frames;
+	if(!frames_)
+		stateBuff = {};
+}
+
+void RunAheadManager::clear()
+{
+	stateBuff = {};
+}
+
+bool RunAheadManager::readConfig(MapIO &io, unsigned key)
+{
+	switch(key)
+	{
+		default: return false;
+		case CFGKEY_RUN_AHEAD_FRAMES: return readOptionValue(io, frames_, [](auto v){ return v >= 0 && v <= maxRunAheadFrames; });
+		case CFGKEY_RUN_AHEAD_SECOND_INSTANCE: return readOptionValue(io, useSecondInstance);
+	}
+}
+
+void RunAheadManager::writeConfig(FileIO &io) const
+{
+	writeOptionValueIfNotDefault(io, CFGKEY_RUN_AHEAD_FRAMES, frames_, int8_t{});
+	writeOptionValueIfNotDefault(io, CFGKEY_RUN_AHEAD_SECOND_INSTANCE, useSecondInstance, true);
+}
+
+}
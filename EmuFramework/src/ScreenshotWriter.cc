@@ -0,0 +1,55 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/BackupMemoryWriter.hh>
+#include <emuframework/ScreenshotWriter.hh>
+#include <emuframework/EmuApp.hh>
+#include <imagine/logger/logger.h>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"ScreenshotWriter"};
+
+MutablePixmapView ScreenshotWriter::allocPixmap(PixmapDesc desc)
+{
+	wait();
+	if(buffer.size() < size_t(desc.bytes()))
+		buffer = dynArrayForOverwrite<uint8_t>(desc.bytes());
+	return {desc, buffer.data()};
+}
+
+void ScreenshotWriter::write(PixmapView pix, FS::PathString path)
+{
+	assert(pix.data() == buffer.data());
+	thread = std::thread{[&app = app, pix, path]
+	{
+		auto success = app.writeScreenshot(pix, path);
+		if(!success)
+			log.error("error writing screenshot:{}", path);
+		app.runOnMainThread([&app, success](ApplicationContext)
+		{
+			app.printScreenshotResult(success);
+		});
+	}};
+}
+
+void ScreenshotWriter::wait()
+{
+	if(thread.joinable())
+		thread.join();
+}
+
+}
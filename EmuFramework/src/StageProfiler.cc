@@ -0,0 +1,63 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/StageProfiler.hh>
+#include <imagine/util/ranges.hh>
+#include <imagine/logger/logger.h>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"StageProfiler"};
+
+void StageProfiler::setEnabled(bool on)
+{
+	if(enabled.load(std::memory_order_relaxed) == on)
+		return;
+	for(auto &t : totals)
+		t.store(0, std::memory_order_relaxed);
+	periodStart = SteadyClock::now();
+	enabled.store(on, std::memory_order_relaxed);
+	log.info("{} stage profiling", on ? "enabled" : "disabled");
+}
+
+std::optional<StageTimes> StageProfiler::takeTimes(SteadyClockTimePoint now, SteadyClockTime period)
+{
+	auto elapsed = now - periodStart;
+	if(elapsed < period)
+		return {};
+	StageTimes stageTimes{.period = elapsed};
+	for(auto i : iotaCount(profileStages))
+	{
+		stageTimes.times[i] = SteadyClockTime{totals[i].exchange(0, std::memory_order_relaxed)};
+	}
+	periodStart = now;
+	return stageTimes;
+}
+
+std::string_view StageProfiler::stageName(ProfileStage stage)
+{
+	switch(stage)
+	{
+		case ProfileStage::none: break;
+		case ProfileStage::cpu: return "CPU";
+		case ProfileStage::video: return "Video";
+		case ProfileStage::sound: return "Sound";
+		case ProfileStage::audioOutput: return "Audio Output";
+	}
+	return "";
+}
+
+}
@@ -0,0 +1,152 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/StateSaveWorker.hh>
+#include <emuframework/EmuApp.hh>
+#include <imagine/util/zlib.hh>
+#include <imagine/logger/logger.h>
+#include <format>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"StateSaveWorker"};
+constexpr size_t maxFreeBuffers = 2;
+
+DynArray<uint8_t> StateSaveWorker::allocBuffer(size_t size)
+{
+	{
+		std::scoped_lock lock{mutex};
+		while(freeBuffers.size())
+		{
+			auto buff = std::move(freeBuffers.back());
+			freeBuffers.pop_back();
+			if(buff.size() >= size)
+			{
+				buffersReused++;
+				return buff;
+			}
+		}
+		buffersAllocated++;
+	}
+	return dynArrayForOverwrite<uint8_t>(size);
+}
+
+void StateSaveWorker::releaseBuffer(DynArray<uint8_t> buff)
+{
+	std::scoped_lock lock{mutex};
+	if(freeBuffers.size() < maxFreeBuffers)
+		freeBuffers.emplace_back(std::move(buff));
+}
+
+void StateSaveWorker::push(Job job)
+{
+	std::scoped_lock lock{mutex};
+	if(!thread.joinable())
+	{
+		quit = false;
+		thread = std::thread{[this]{ run(); }};
+	}
+	jobs.emplace_back(std::move(job));
+	jobCond.notify_one();
+}
+
+void StateSaveWorker::wait()
+{
+	std::unique_lock lock{mutex};
+	idleCond.wait(lock, [&]{ return jobs.empty() && !isWorking; });
+}
+
+void StateSaveWorker::stop()
+{
+	if(!thread.joinable())
+		return;
+	{
+		std::scoped_lock lock{mutex};
+		quit = true;
+		jobCond.notify_one();
+	}
+	thread.join();
+}
+
+void StateSaveWorker::setCPUAffinityMask(CPUMask mask)
+{
+	std::scoped_lock lock{mutex};
+	cpuMask = mask;
+	if(threadId)
+		setThreadCPUAffinityMask(std::span{&threadId, 1}, mask);
+}
+
+void StateSaveWorker::run()
+{
+	log.info("starting thread");
+	std::unique_lock lock{mutex};
+	threadId = thisThreadId();
+	if(cpuMask)
+		setThreadCPUAffinityMask(std::span{&threadId, 1}, cpuMask);
+	while(true)
+	{
+		jobCond.wait(lock, [&]{ return jobs.size() || quit; });
+		// finish all queued jobs before exiting so no state is lost
+		if(jobs.empty())
+			break;
+		auto job = std::move(jobs.front());
+		jobs.pop_front();
+		isWorking = true;
+		lock.unlock();
+		write(job);
+		releaseBuffer(std::move(job.state));
+		lock.lock();
+		isWorking = false;
+		if(jobs.empty())
+			idleCond.notify_all();
+	}
+	threadId = {};
+	compressBuffer = {};
+	log.info("exiting thread, reused {} of {} state buffers", buffersReused, buffersReused + buffersAllocated);
+}
+
+void StateSaveWorker::write(Job &job)
+{
+	std::span<uint8_t> data{job.state.data(), job.size};
+	if(job.compress)
+	{
+		if(auto maxSize = compressBound(job.size) + 32; compressBuffer.size() < maxSize)
+			compressBuffer = dynArrayForOverwrite<uint8_t>(maxSize);
+		auto compSize = EmuSystem::compressState(compressBuffer, data, {.compression = job.compression}, Z_DEFAULT_COMPRESSION);
+		data = {compressBuffer.data(), compSize};
+		//log.debug("compressed state from {} to {} bytes", job.size, compSize);
+	}
+	auto &io = job.output();
+	bool success = io.write(data, 0).bytes == ssize_t(data.size());
+	if(success && job.sharedFile)
+		success = io.truncate(data.size());
+	if(!success)
+		log.error("error writing {} byte state", data.size());
+	else
+		log.info("wrote {} byte state", data.size());
+	if(!success || job.notifySaved)
+	{
+		app.runOnMainThread([&app = app, success, errorMsg = job.errorMsg](ApplicationContext)
+		{
+			if(success)
+				app.postMessage("State Saved");
+			else
+				app.postErrorMessage(4, errorMsg);
+		});
+	}
+}
+
+}
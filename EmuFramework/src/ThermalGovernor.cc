@@ -0,0 +1,141 @@
+/*  This file is part of EmuFramework.
+
+	EmuFramework is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	EmuFramework is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/ThermalGovernor.hh>
+#include <emuframework/EmuApp.hh>
+#include <emuframework/EmuOptions.hh>
+#include <emuframework/Option.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <cmath>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"ThermalGovernor"};
+constexpr Seconds pollInterval{5};
+constexpr Seconds headroomForecast{10};
+constexpr int8_t coolPollsToStepDown = 6;
+
+ThermalGovernor::ThermalGovernor(EmuApp &app):
+	app{app},
+	pollTimer
+	{
+		"ThermalGovernor::pollTimer",
+		[this]()
+		{
+			poll();
+			return true;
+		}
+	} {}
+
+void ThermalGovernor::start()
+{
+	if(!enabled)
+		return;
+	pollTimer.runIn(Seconds{}, pollInterval);
+}
+
+void ThermalGovernor::pause()
+{
+	pollTimer.cancel();
+}
+
+void ThermalGovernor::reset()
+{
+	pollTimer.cancel();
+	coolPolls = 0;
+	setTier(minTier_);
+}
+
+void ThermalGovernor::setMinTier(ThermalTier t)
+{
+	if(t == minTier_)
+		return;
+	log.info("set minimum tier:{}", wise_enum::to_string(t));
+	minTier_ = t;
+	// without polling the tier only follows the minimum, otherwise let poll() step down from a higher one
+	if(!enabled || tier() < t)
+		setTier(t);
+}
+
+void ThermalGovernor::setEnabled(bool on)
+{
+	enabled = on;
+	if(!on)
+		reset();
+}
+
+void ThermalGovernor::poll()
+{
+	auto ctx = app.appContext();
+	auto status = ctx.thermalStatus();
+	auto headroom = ctx.thermalHeadroom(headroomForecast);
+	auto wantedTier = [&]
+	{
+		if(status >= ThermalStatus::severe || headroom >= 1.f)
+			return ThermalTier::FrameSkip;
+		if(status >= ThermalStatus::moderate || headroom >= .9f)
+			return ThermalTier::NoImageEffect;
+		return ThermalTier::Nominal;
+	}();
+	wantedTier = std::max(wantedTier, minTier_);
+	auto currTier = tier();
+	if(wantedTier > currTier)
+	{
+		coolPolls = 0;
+		log.info("status:{} headroom:{}, stepping up", int(status), headroom);
+		setTier(ThermalTier(int(currTier) + 1));
+	}
+	else if(wantedTier < currTier)
+	{
+		if(++coolPolls < coolPollsToStepDown)
+			return;
+		coolPolls = 0;
+		log.info("status:{} headroom:{}, stepping down", int(status), headroom);
+		setTier(ThermalTier(int(currTier) - 1));
+	}
+	else
+	{
+		coolPolls = 0;
+	}
+}
+
+void ThermalGovernor::setTier(ThermalTier newTier)
+{
+	if(newTier == tier())
+		return;
+	log.info("changed tier from {} to {}", wise_enum::to_string(tier()), wise_enum::to_string(newTier));
+	tier_.store(newTier, std::memory_order_relaxed);
+	// the effect also sets the video's color space, so the emulation thread can't be writing a frame
+	app.syncEmulationThread();
+	app.videoLayer.setEffectSuspended(app.system(), newTier >= ThermalTier::NoImageEffect, app.videoEffectPixelFormat());
+}
+
+bool ThermalGovernor::readConfig(MapIO &io, unsigned key)
+{
+	switch(key)
+	{
+		default: return false;
+		case CFGKEY_THERMAL_GOVERNOR: return readOptionValue(io, enabled);
+	}
+}
+
+void ThermalGovernor::writeConfig(FileIO &io) const
+{
+	writeOptionValueIfNotDefault(io, CFGKEY_THERMAL_GOVERNOR, enabled, false);
+}
+
+}
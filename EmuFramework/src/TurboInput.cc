@@ -25,6 +25,7 @@ constexpr SystemLogger log{"TurboInput"};
 void TurboInput::addEvent(KeyInfo key)
 {
 	key.flags.turbo = 0;
+	std::scoped_lock lock{keyMutex};
 	if(keys.empty())
 		clock = 0; // Reset the clock so new turbo event takes effect next frame
 	if(keys.tryPushBack(key))
@@ -36,6 +37,7 @@ void TurboInput::addEvent(KeyInfo key)
 void TurboInput::removeEvent(KeyInfo key)
 {
 	key.flags.turbo = 0;
+	std::scoped_lock lock{keyMutex};
 	if(erase(keys, key))
 	{
 		log.info("removed event action {}", key.codes[0]);
@@ -59,6 +61,10 @@ void TurboInput::updateEvent(EmuApp &app, KeyInfo key, Input::Action act)
 void TurboInput::update(EmuApp &app)
 {
 	const int turboFrames = 4;
+	// holding the lock while sending actions keeps a removed key from being pushed again after its release
+	std::scoped_lock lock{keyMutex};
+	if(keys.empty())
+		return;
 	for(auto k : keys)
 	{
 		if(clock == 0)
@@ -74,4 +80,10 @@ void TurboInput::update(EmuApp &app)
 	if(clock == turboFrames) clock = 0;
 }
 
+void TurboInput::clear()
+{
+	std::scoped_lock lock{keyMutex};
+	keys.clear();
+}
+
 }
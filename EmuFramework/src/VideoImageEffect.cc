@@ -21,36 +21,31 @@
 #include <imagine/fs/FSDefs.hh>
 #include <imagine/util/format.hh>
 #include <imagine/util/ScopeGuard.hh>
+#include <imagine/util/ranges.hh>
 #include <imagine/logger/logger.h>
+#include <algorithm>
+#include <charconv>
 
 namespace EmuEx
 {
 
 constexpr SystemLogger log{"VideoImageEffect"};
 
-constexpr VideoImageEffect::EffectDesc directDesc{"direct-v.txt", "direct-f.txt", {1, 1}};
+constexpr size_t maxPasses = 8;
+constexpr int paletteTextureUnit = 1;
 
-constexpr VideoImageEffect::EffectDesc hq2xDesc{"hq2x-v.txt", "hq2x-f.txt", {2, 2}};
+constexpr VideoImageEffect::EffectDesc directDesc{"direct", {1, 1}};
 
-constexpr VideoImageEffect::EffectDesc scale2xDesc{"scale2x-v.txt", "scale2x-f.txt", {2, 2}};
+constexpr VideoImageEffect::EffectDesc hq2xDesc{"hq2x", {2, 2}};
 
-constexpr VideoImageEffect::EffectDesc prescale2xDesc{"direct-v.txt", "direct-f.txt", {2, 2}};
-constexpr VideoImageEffect::EffectDesc prescale3xDesc{"direct-v.txt", "direct-f.txt", {3, 3}};
-constexpr VideoImageEffect::EffectDesc prescale4xDesc{"direct-v.txt", "direct-f.txt", {4, 4}};
+constexpr VideoImageEffect::EffectDesc scale2xDesc{"scale2x", {2, 2}};
 
-static constexpr const char *effectName(ImageEffectId id)
-{
-	switch(id)
-	{
-		case ImageEffectId::DIRECT: return "Direct";
-		case ImageEffectId::HQ2X: return "HQ2X";
-		case ImageEffectId::SCALE2X: return "Scale2X";
-		case ImageEffectId::PRESCALE2X: return "Prescale 2X";
-		case ImageEffectId::PRESCALE3X: return "Prescale 3X";
-		case ImageEffectId::PRESCALE4X: return "Prescale 4X";
-	}
-	return nullptr;
-}
+constexpr VideoImageEffect::EffectDesc prescale2xDesc{"direct", {2, 2}};
+constexpr VideoImageEffect::EffectDesc prescale3xDesc{"direct", {3, 3}};
+constexpr VideoImageEffect::EffectDesc prescale4xDesc{"direct", {4, 4}};
+
+constexpr VideoImageEffect::EffectDesc scale4xDesc{"scale4x", {}, true};
+constexpr VideoImageEffect::EffectDesc hq2xScale2xDesc{"hq2x-scale2x", {}, true};
 
 static constexpr VideoImageEffect::EffectDesc effectDesc(ImageEffectId id)
 {
@@ -62,32 +57,28 @@ static constexpr VideoImageEffect::EffectDesc effectDesc(ImageEffectId id)
 		case ImageEffectId::PRESCALE2X: return prescale2xDesc;
 		case ImageEffectId::PRESCALE3X: return prescale3xDesc;
 		case ImageEffectId::PRESCALE4X: return prescale4xDesc;
+		case ImageEffectId::SCALE4X: return scale4xDesc;
+		case ImageEffectId::HQ2X_SCALE2X: return hq2xScale2xDesc;
 	}
 	return {};
 }
 
-static Gfx::Shader makeEffectVertexShader(Gfx::Renderer &r, std::string_view src)
+static Gfx::Program makeEffectProgram(Gfx::Renderer &r, std::string_view vSrc, std::string_view fSrc,
+	std::span<Gfx::UniformLocationDesc> uniformDescs)
 {
-	std::string_view posDefs =
-		"#define POS pos\n"
-		"in vec4 pos;\n";
-	std::string_view shaderSrc[]
+	std::string_view vShaderSrc[]
 	{
-		posDefs,
-		src
+		"#define POS pos\n"
+		"in vec4 pos;\n",
+		vSrc
 	};
-	return r.makeCompatShader(shaderSrc, Gfx::ShaderType::VERTEX);
-}
-
-static Gfx::Shader makeEffectFragmentShader(Gfx::Renderer &r, std::string_view src)
-{
-	std::string_view shaderSrc[]
+	std::string_view fShaderSrc[]
 	{
 		"#define TEXTURE texture\n",
 		"uniform sampler2D TEX;\n",
-		src
+		fSrc
 	};
-	return r.makeCompatShader(shaderSrc, Gfx::ShaderType::FRAGMENT);
+	return {r.task(), vShaderSrc, fShaderSrc, {.hasTexture = true}, uniformDescs};
 }
 
 static PixelFormat effectFormat(IG::PixelFormat format, Gfx::ColorSpace colSpace)
@@ -100,22 +91,142 @@ static PixelFormat effectFormat(IG::PixelFormat format, Gfx::ColorSpace colSpace
 	return format;
 }
 
+static std::string_view trimmed(std::string_view str)
+{
+	constexpr std::string_view space = " \t\r\"";
+	auto start = str.find_first_not_of(space);
+	if(start == str.npos)
+		return {};
+	auto end = str.find_last_not_of(space);
+	return str.substr(start, end - start + 1);
+}
+
+static int parseInt(std::string_view str)
+{
+	int val{};
+	auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), val);
+	if(ec != std::errc{} || ptr != str.data() + str.size())
+		throw std::runtime_error{std::format("Invalid number:{} in effect preset", str)};
+	return val;
+}
+
+// splits "scale_x1" into "scale_x" & 1
+static std::pair<std::string_view, int> splitPassKey(std::string_view key)
+{
+	auto numPos = key.find_last_not_of("0123456789");
+	if(numPos == key.npos || numPos == key.size() - 1)
+		return {key, -1};
+	return {key.substr(0, numPos + 1), parseInt(key.substr(numPos + 1))};
+}
+
+std::vector<VideoImageEffect::PassDesc> VideoImageEffect::parsePreset(std::string_view src)
+{
+	std::vector<PassDesc> descs;
+	while(src.size())
+	{
+		auto lineEnd = src.find('\n');
+		auto line = src.substr(0, lineEnd);
+		src = lineEnd == src.npos ? std::string_view{} : src.substr(lineEnd + 1);
+		line = trimmed(line.substr(0, line.find('#')));
+		if(line.empty())
+			continue;
+		auto eqPos = line.find('=');
+		if(eqPos == line.npos)
+			throw std::runtime_error{std::format("Invalid line:{} in effect preset", line)};
+		auto key = trimmed(line.substr(0, eqPos));
+		auto val = trimmed(line.substr(eqPos + 1));
+		if(key == "shaders")
+		{
+			auto count = parseInt(val);
+			if(count < 1 || count > int(maxPasses))
+				throw std::runtime_error{std::format("Effect preset has {} passes, max is {}", count, maxPasses)};
+			descs.resize(count);
+			continue;
+		}
+		auto [name, passIdx] = splitPassKey(key);
+		if(passIdx < 0 || passIdx >= int(descs.size()))
+		{
+			log.warn("ignoring preset key:{}", key);
+			continue;
+		}
+		auto &desc = descs[passIdx];
+		if(name == "shader")
+		{
+			// accept a path to a shader and use its base name, the compat version is loaded from shaders/
+			val = val.substr(val.find_last_of('/') + 1);
+			desc.shaderName = val.substr(0, val.find('.'));
+		}
+		else if(name == "scale")
+			desc.scale.x = desc.scale.y = parseInt(val);
+		else if(name == "scale_x")
+			desc.scale.x = parseInt(val);
+		else if(name == "scale_y")
+			desc.scale.y = parseInt(val);
+		else if(name == "filter_linear")
+			desc.linearFilter = val == "true" || val == "1";
+		else if(name == "format")
+		{
+			if(val == "rgb565")
+				desc.format = IG::PixelFmtRGB565;
+			else if(val == "rgba8888")
+				desc.format = IG::PixelFmtRGBA8888;
+			else
+				log.warn("ignoring unknown pass format:{}", val);
+		}
+		else if(name == "scale_type" || name == "scale_type_x" || name == "scale_type_y")
+		{
+			if(val != "source")
+				log.warn("only source relative scaling is supported, ignoring {}:{}", key, val);
+		}
+		else
+		{
+			log.warn("ignoring preset key:{}", key);
+		}
+	}
+	if(descs.empty())
+		throw std::runtime_error{"Effect preset has no passes"};
+	for(const auto &desc : descs)
+	{
+		if(desc.shaderName.empty())
+			throw std::runtime_error{"Effect preset is missing a shader"};
+		if(desc.scale.x < 1 || desc.scale.y < 1 || desc.scale.x > 8 || desc.scale.y > 8)
+			throw std::runtime_error{std::format("Invalid scale for shader:{} in effect preset", desc.shaderName)};
+	}
+	return descs;
+}
+
 VideoImageEffect::VideoImageEffect(Gfx::Renderer &r, Id effect, IG::PixelFormat fmt, Gfx::ColorSpace colSpace,
+	Gfx::TextureSamplerConfig samplerConf, WSize size):
+		VideoImageEffect{r, effectDesc(effect), fmt, colSpace, samplerConf, size} {}
+
+VideoImageEffect::VideoImageEffect(Gfx::Renderer &r, EffectDesc desc, IG::PixelFormat fmt, Gfx::ColorSpace colSpace,
 	Gfx::TextureSamplerConfig samplerConf, WSize size):
 		quad{r.mainTask, {.size = 1}},
 		inputImgSize{size == WSize{} ? WSize{1, 1} : size}, format{effectFormat(fmt, colSpace)}, colorSpace{colSpace}
 {
 	quad.write(0, {.bounds = {{-1, -1}, {1, 1}}});
-	log.info("compiling effect:{}", effectName(effect));
-	compile(r, effectDesc(effect), samplerConf);
+	log.info("compiling effect:{} scale:{}x{}", desc.name, desc.scale.x, desc.scale.y);
+	compile(r, desc, samplerConf);
+}
+
+void VideoImageEffect::updatePassSizes()
+{
+	auto size = inputImgSize;
+	for(auto &pass : passes)
+	{
+		pass.inputSize = size;
+		size = {size.x * pass.scale.x, size.y * pass.scale.y};
+		pass.outputSize = size;
+	}
+	renderTargetImgSize = size;
 }
 
 void VideoImageEffect::initRenderTargetTexture(Gfx::Renderer &r, Gfx::TextureSamplerConfig samplerConf)
 {
-	if(!renderTargetScale.x)
+	if(passes.empty())
 		return;
-	renderTargetImgSize.x = inputImgSize.x * renderTargetScale.x;
-	renderTargetImgSize.y = inputImgSize.y * renderTargetScale.y;
+	updatePassSizes();
+	initIntermediateTargets(r);
 	IG::PixmapDesc renderPix{renderTargetImgSize, format};
 	if(!renderTarget_)
 	{
@@ -127,80 +238,172 @@ void VideoImageEffect::initRenderTargetTexture(Gfx::Renderer &r, Gfx::TextureSam
 		renderTarget_.setFormat(renderPix, 1, colorSpace, samplerConf);
 }
 
+void VideoImageEffect::initIntermediateTargets(Gfx::Renderer &r)
+{
+	// Every pass except the last renders to a pooled texture. A pass can't write the texture
+	// it reads from and a texture already given to an earlier pass is only shared if its
+	// format and the filter its reader samples with both match, since the sampler is set
+	// once per texture, so chains with equally sized passes ping-pong between two textures.
+	enum class Claim : uint8_t { none, nearest, linear };
+	std::vector<Claim> claims(targetPool.size());
+	int8_t prevIdx = -1;
+	for(size_t i = 0; i + 1 < passes.size(); i++)
+	{
+		auto &pass = passes[i];
+		IG::PixmapDesc desc{pass.outputSize, pass.format ? pass.format : format};
+		bool linear = passes[i + 1].linearFilter;
+		auto claim = linear ? Claim::linear : Claim::nearest;
+		auto samplerConf = linear ? Gfx::SamplerConfigs::noMipClamp : Gfx::SamplerConfigs::noLinearNoMipClamp;
+		int8_t idx = -1;
+		for(auto j : iotaCount(int8_t(targetPool.size())))
+		{
+			if(j == prevIdx || (claims[j] != Claim::none && claims[j] != claim))
+				continue;
+			if(targetPool[j].pixmapDesc() == desc)
+			{
+				idx = j;
+				break;
+			}
+			if(idx == -1 && claims[j] == Claim::none)
+				idx = j;
+		}
+		if(idx == -1)
+		{
+			Gfx::TextureConfig conf{desc, samplerConf};
+			targetPool.emplace_back(r.makeTexture(conf));
+			claims.push_back(claim);
+			idx = targetPool.size() - 1;
+			log.info("created intermediate target:{} ({}x{} {})", idx, desc.w(), desc.h(), desc.format.name());
+		}
+		else
+		{
+			auto &tex = targetPool[idx];
+			if(tex.pixmapDesc() != desc)
+				tex.setFormat(desc, 1, Gfx::ColorSpace::LINEAR, samplerConf);
+			else
+				tex.setSampler(samplerConf);
+			claims[idx] = claim;
+		}
+		pass.targetIdx = idx;
+		prevIdx = idx;
+	}
+	passes.back().targetIdx = -1;
+}
+
 void VideoImageEffect::compile(Gfx::Renderer &r, EffectDesc desc, Gfx::TextureSamplerConfig samplerConf)
 {
-	if(program())
+	if(*this)
 		return; // already compiled
-	if(!desc.scale.x) [[unlikely]]
+	std::vector<PassDesc> passDescs;
+	try
 	{
-		log.error("invalid effect descriptor");
+		if(desc.isPreset)
+		{
+			auto presetIO = r.appContext().openAsset(IG::format<FS::PathString>("shaders/{}-preset.txt", desc.name),
+				{.accessHint = IOAccessHint::All});
+			passDescs = parsePreset(presetIO.buffer().stringView());
+		}
+		else if(desc.scale.x)
+		{
+			passDescs.push_back({desc.name, desc.scale});
+		}
+		else [[unlikely]]
+		{
+			log.error("invalid effect descriptor");
+			return;
+		}
+	}
+	catch(std::exception &err)
+	{
+		auto &app = EmuApp::get(r.appContext());
+		app.postErrorMessage(5, err.what());
 		return;
 	}
-	renderTargetScale = desc.scale;
-	initRenderTargetTexture(r, samplerConf);
 	try
 	{
-		compileEffect(r, desc, false);
+		compileEffect(r, passDescs, false);
 	}
 	catch(std::exception &err)
 	{
 		try
 		{
-			compileEffect(r, desc, true);
+			compileEffect(r, passDescs, true);
 			log.info("compiled fallback version of effect");
 		}
 		catch(std::exception &fallbackErr)
 		{
+			passes.clear();
 			auto &app = EmuApp::get(r.appContext());
 			app.postErrorMessage(5, std::format("{}, {}", err.what(), fallbackErr.what()));
 			return;
 		}
 	}
+	initRenderTargetTexture(r, samplerConf);
+	for(auto &pass : passes)
+	{
+		updateProgramUniforms(pass);
+	}
+	log.info("effect has {} pass(es)", passes.size());
 }
 
-void VideoImageEffect::compileEffect(Gfx::Renderer &r, EffectDesc desc, bool useFallback)
+void VideoImageEffect::compileEffect(Gfx::Renderer &r, std::span<const PassDesc> passDescs, bool useFallback)
 {
 	auto ctx = r.appContext();
 	const char *fallbackStr = useFallback ? "fallback-" : "";
 	auto releaseShaderCompiler = IG::scopeGuard([&](){ r.autoReleaseShaderCompiler(); });
-
-	auto vShader = makeEffectVertexShader(r,
-		ctx.openAsset(IG::format<FS::PathString>("shaders/{}{}", fallbackStr, desc.vShaderFilename),
-		{.accessHint = IOAccessHint::All}).buffer().stringView());
-	if(!vShader)
+	struct ShaderSources
 	{
-		throw std::runtime_error{"GPU rejected shader (vertex compile error)"};
-	}
-
-	auto fShader = makeEffectFragmentShader(r,
-		ctx.openAsset(IG::format<FS::PathString>("shaders/{}{}", fallbackStr, desc.fShaderFilename),
-		{.accessHint = IOAccessHint::All}).buffer().stringView());
-	if(!fShader)
-	{
-		throw std::runtime_error{"GPU rejected shader (fragment compile error)"};
-	}
-	Gfx::UniformLocationDesc uniformDescs[]
-	{
-		{"srcTexelDelta", &srcTexelDeltaU},
-		{"srcTexelHalfDelta", &srcTexelHalfDeltaU},
-		{"srcPixels", &srcPixelsU},
+		std::string_view name;
+		IOBuffer vSrc, fSrc;
 	};
-	prog = {r.task(), vShader, fShader, {.hasTexture = true}, uniformDescs};
-	if(!prog)
+	// passes reusing the same shader pair only load it once
+	std::vector<ShaderSources> sources;
+	passes.clear();
+	passes.reserve(passDescs.size());
+	for(const auto &desc : passDescs)
 	{
-		throw std::runtime_error{"GPU rejected shader (link error)"};
+		auto srcIt = std::ranges::find(sources, std::string_view{desc.shaderName}, &ShaderSources::name);
+		if(srcIt == sources.end())
+		{
+			auto loadSrc = [&](std::string_view suffix)
+			{
+				return ctx.openAsset(IG::format<FS::PathString>("shaders/{}{}{}", fallbackStr, desc.shaderName, suffix),
+					{.accessHint = IOAccessHint::All}).buffer();
+			};
+			sources.push_back({desc.shaderName, loadSrc("-v.txt"), loadSrc("-f.txt")});
+			srcIt = sources.end() - 1;
+		}
+		auto &pass = passes.emplace_back();
+		pass.scale = desc.scale;
+		pass.format = desc.format;
+		pass.linearFilter = desc.linearFilter;
+		Gfx::UniformLocationDesc uniformDescs[]
+		{
+			{"srcTexelDelta", &pass.srcTexelDeltaU},
+			{"srcTexelHalfDelta", &pass.srcTexelHalfDeltaU},
+			{"srcPixels", &pass.srcPixelsU},
+			{"PAL", &pass.paletteU},
+		};
+		pass.prog = makeEffectProgram(r, srcIt->vSrc.stringView(), srcIt->fSrc.stringView(), uniformDescs);
+		if(!pass.prog)
+		{
+			throw std::runtime_error{"GPU rejected shader (compile or link error)"};
+		}
 	}
-	updateProgramUniforms(r);
 }
 
-void VideoImageEffect::updateProgramUniforms(Gfx::Renderer &r)
+void VideoImageEffect::updateProgramUniforms(Pass &pass)
 {
-	if(srcTexelDeltaU != -1)
-		prog.uniform(srcTexelDeltaU, 1.0f / (float)inputImgSize.x, 1.0f / (float)inputImgSize.y);
-	if(srcTexelHalfDeltaU != -1)
-		prog.uniform(srcTexelHalfDeltaU, 0.5f * (1.0f / (float)inputImgSize.x), 0.5f * (1.0f / (float)inputImgSize.y));
-	if(srcPixelsU != -1)
-		prog.uniform(srcPixelsU, (float)inputImgSize.x, (float)inputImgSize.y);
+	auto &prog = pass.prog;
+	auto size = pass.inputSize;
+	if(pass.srcTexelDeltaU != -1)
+		prog.uniform(pass.srcTexelDeltaU, 1.0f / (float)size.x, 1.0f / (float)size.y);
+	if(pass.srcTexelHalfDeltaU != -1)
+		prog.uniform(pass.srcTexelHalfDeltaU, 0.5f * (1.0f / (float)size.x), 0.5f * (1.0f / (float)size.y));
+	if(pass.srcPixelsU != -1)
+		prog.uniform(pass.srcPixelsU, (float)size.x, (float)size.y);
+	if(pass.paletteU != -1)
+		prog.uniform(pass.paletteU, paletteTextureUnit);
 }
 
 void VideoImageEffect::setImageSize(Gfx::Renderer &r, WSize size, Gfx::TextureSamplerConfig samplerConf)
@@ -210,9 +413,11 @@ void VideoImageEffect::setImageSize(Gfx::Renderer &r, WSize size, Gfx::TextureSa
 	if(inputImgSize == size)
 		return;
 	inputImgSize = size;
-	if(program())
-		updateProgramUniforms(r);
 	initRenderTargetTexture(r, samplerConf);
+	for(auto &pass : passes)
+	{
+		updateProgramUniforms(pass);
+	}
 }
 
 void VideoImageEffect::setFormat(Gfx::Renderer &r,IG::PixelFormat fmt, Gfx::ColorSpace colSpace, Gfx::TextureSamplerConfig samplerConf)
@@ -225,21 +430,32 @@ void VideoImageEffect::setFormat(Gfx::Renderer &r,IG::PixelFormat fmt, Gfx::Colo
 	initRenderTargetTexture(r, samplerConf);
 }
 
-Gfx::Program &VideoImageEffect::program()
+Gfx::Texture &VideoImageEffect::renderTarget()
 {
-	return prog;
+	return renderTarget_;
 }
 
-Gfx::Texture &VideoImageEffect::renderTarget()
+Gfx::TextureSpan VideoImageEffect::passInput(size_t idx, Gfx::TextureSpan srcTex) const
 {
-	return renderTarget_;
+	if(!idx)
+		return srcTex;
+	return targetPool[passes[idx - 1].targetIdx];
 }
 
-void VideoImageEffect::drawRenderTarget(Gfx::RendererCommands &cmds, Gfx::TextureSpan texSpan)
+void VideoImageEffect::draw(Gfx::RendererCommands &cmds, Gfx::TextureSpan srcTex)
 {
-	cmds.setViewport(renderTargetImgSize);
-	cmds.set(texSpan);
-	cmds.drawQuad(quad, 0);
+	for(auto i : iotaCount(passes.size()))
+	{
+		auto &pass = passes[i];
+		cmds.setProgram(pass.prog);
+		cmds.setRenderTarget(pass.targetIdx == -1 ? renderTarget_ : targetPool[pass.targetIdx]);
+		cmds.clear();
+		cmds.setViewport(pass.outputSize);
+		cmds.set(passInput(i, srcTex));
+		if(pass.paletteU != -1 && paletteTex && *paletteTex)
+			cmds.set(paletteTex->binding(), paletteTextureUnit);
+		cmds.drawQuad(quad, 0);
+	}
 }
 
 void VideoImageEffect::setSampler(Gfx::TextureSamplerConfig samplerConf)
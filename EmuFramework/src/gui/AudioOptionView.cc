@@ -104,6 +104,24 @@ AudioOptionView::AudioOptionView(ViewAttachParams attach, EmuAudio& audio_, bool
 			audio.addSoundBuffersOnUnderrunSetting = item.flipBoolValue(*this);
 		}
 	},
+	workerThread
+	{
+		"Process Audio In Separate Thread", attach,
+		audio_.useWorkerThread,
+		[this](BoolMenuItem &item)
+		{
+			audio.useWorkerThread = item.flipBoolValue(*this);
+		}
+	},
+	rateControl
+	{
+		"Dynamic Rate Control", attach,
+		audio_.dynamicRateControl,
+		[this](BoolMenuItem &item)
+		{
+			audio.dynamicRateControl = item.flipBoolValue(*this);
+		}
+	},
 	audioRateItem
 	{
 		[&]
@@ -186,6 +204,8 @@ void AudioOptionView::loadStockItems()
 	}
 	item.emplace_back(&soundBuffers);
 	item.emplace_back(&addSoundBuffersOnUnderrun);
+	item.emplace_back(&workerThread);
+	item.emplace_back(&rateControl);
 	if constexpr(IG::Audio::Manager::HAS_SOLO_MIX)
 	{
 		item.emplace_back(&audioSoloMix);
@@ -15,6 +15,7 @@
 
 #include <emuframework/Cheats.hh>
 #include <emuframework/EmuApp.hh>
+#include "RamSearchView.hh"
 #include <imagine/gui/TextEntry.hh>
 
 namespace EmuEx
@@ -29,13 +30,15 @@ BaseCheatsView::BaseCheatsView(ViewAttachParams attach):
 		{
 			return msg.visit(overloaded
 			{
-				[&](const ItemsMessage &m) -> ItemReply { return 1 + cheat.size(); },
+				[&](const ItemsMessage &m) -> ItemReply { return fixedItems() + cheat.size(); },
 				[&](const GetItemMessage &m) -> ItemReply
 				{
 					if(m.idx == 0)
 						return &edit;
+					else if(m.idx < fixedItems())
+						return &ramSearch;
 					else
-						return &cheat[m.idx - 1];
+						return &cheat[m.idx - fixedItems()];
 				},
 			});
 		}
@@ -56,6 +59,14 @@ BaseCheatsView::BaseCheatsView(ViewAttachParams attach):
 				});
 			pushAndShow(std::move(editCheatsView), e);
 		}
+	},
+	ramSearch
+	{
+		"RAM Search", attach,
+		[this](const Input::Event &e)
+		{
+			pushAndShow(makeView<RamSearchView>(), e);
+		}
 	} {}
 
 BaseEditCheatListView::BaseEditCheatListView(ViewAttachParams attach, TableView::ItemSourceDelegate itemSrc):
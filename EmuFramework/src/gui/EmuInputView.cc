@@ -135,6 +135,8 @@ bool EmuInputView::inputEvent(const Input::Event& e, ViewInputEventParams)
 						break;
 				}
 			}
+			if(didAction && isPushed && !isRepeated)
+				emuApp.frameTimeTelemetry.recordInput(keyEv.time());
 			return didAction
 				|| keyEv.isGamepad() // consume all gamepad events
 				|| devData.devConf.shouldHandleUnboundKeys;
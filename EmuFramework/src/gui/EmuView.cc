@@ -17,10 +17,13 @@
 #include <emuframework/EmuVideoLayer.hh>
 #include <emuframework/EmuSystem.hh>
 #include <emuframework/OutputTimingManager.hh>
+#include <emuframework/StageProfiler.hh>
 #include <imagine/base/Screen.hh>
 #include <imagine/gfx/Renderer.hh>
+#include <imagine/util/ranges.hh>
 #include <algorithm>
 #include <format>
+#include <string>
 
 namespace EmuEx
 {
@@ -29,11 +32,14 @@ EmuView::EmuView(ViewAttachParams attach, EmuVideoLayer *layer, EmuSystem &sys):
 	View{attach},
 	layer{layer},
 	sysPtr{&sys},
-	frameTimeStats{Gfx::Text{attach.rendererTask, &defaultFace()}, Gfx::IQuads{attach.rendererTask, {.size = 1}}} {}
+	frameTimeStats{Gfx::Text{attach.rendererTask, &defaultFace()}, Gfx::IQuads{attach.rendererTask, {.size = 1}}},
+	stageTimes{Gfx::Text{attach.rendererTask, &defaultFace()}, Gfx::IQuads{attach.rendererTask, {.size = 1}}},
+	latencyProbeQuads{attach.rendererTask, {.size = 1}} {}
 
 void EmuView::prepareDraw()
 {
 	doIfUsed(frameTimeStats, [&](auto &stats){ stats.text.makeGlyphs(); });
+	stageTimes.text.makeGlyphs();
 	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
 	audioStatsText.makeGlyphs(renderer());
 	#endif
@@ -76,6 +82,28 @@ void EmuView::drawframeTimeStatsText(Gfx::RendererCommands &__restrict__ cmds)
 	});
 }
 
+void EmuView::drawStageTimesText(Gfx::RendererCommands &__restrict__ cmds)
+{
+	if(!stageTimes.text.isVisible())
+		return;
+	using namespace IG::Gfx;
+	cmds.basicEffect().disableTexture(cmds);
+	cmds.set(BlendMode::ALPHA);
+	cmds.setColor({0., 0., 0., .7});
+	cmds.drawQuad(stageTimes.bgQuads, 0);
+	cmds.basicEffect().enableAlphaTexture(cmds);
+	stageTimes.text.draw(cmds, stageTimes.rect.pos(LC2DO) + WPt{stageTimes.text.spaceWidth(), 0}, LC2DO, ColorName::WHITE);
+}
+
+void EmuView::drawLatencyProbe(Gfx::RendererCommands &__restrict__ cmds)
+{
+	using namespace IG::Gfx;
+	cmds.basicEffect().disableTexture(cmds);
+	cmds.set(BlendMode::OFF);
+	cmds.setColor(ColorName::WHITE);
+	cmds.drawQuad(latencyProbeQuads, 0);
+}
+
 void EmuView::place()
 {
 	if(layer)
@@ -83,6 +111,10 @@ void EmuView::place()
 		layer->place(viewRect(), displayRect(), inputView, system());
 	}
 	placeFrameTimeStats();
+	placeStageTimes();
+	// square in the top right corner, sized for a photodiode or camera to pick up
+	auto probeSize = viewRect().ySize() / 8;
+	latencyProbeQuads.write(0, {.bounds = WRect{{viewRect().x2 - probeSize, viewRect().y}, {viewRect().x2, viewRect().y + probeSize}}.as<int16_t>()});
 	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
 	if(audioStatsText.compile(renderer()))
 	{
@@ -108,6 +140,34 @@ void EmuView::placeFrameTimeStats()
 	});
 }
 
+void EmuView::placeStageTimes()
+{
+	if(stageTimes.text.compile())
+	{
+		WRect rect = {{},
+			{stageTimes.text.pixelSize().x + stageTimes.text.spaceWidth() * 2, stageTimes.text.fullHeight()}};
+		// right side so it doesn't cover the frame time stats
+		rect.setPos(viewRect().pos(RC2DO), RC2DO);
+		stageTimes.rect = rect;
+		stageTimes.bgQuads.write(0, {.bounds = rect.as<int16_t>()});
+	}
+}
+
+void EmuView::updateStageTimes(const StageTimes &times)
+{
+	auto periodSecs = duration_cast<FloatSeconds>(times.period).count();
+	std::string str{"CPU Time Per Second"};
+	for(auto i : iotaCount(profileStages))
+	{
+		auto stage = ProfileStage(i);
+		auto secs = duration_cast<FloatSeconds>(times[stage]).count();
+		std::format_to(std::back_inserter(str), "\n{}: {:.1f}ms ({:.1f}%)",
+			StageProfiler::stageName(stage), secs * 1000. / periodSecs, secs * 100. / periodSecs);
+	}
+	stageTimes.text.resetString(str);
+	placeStageTimes();
+}
+
 void EmuView::updateFrameTimeStats(FrameTimeStats stats, SteadyClockTimePoint currentFrameTimestamp)
 {
 	auto screenFrameTime = duration_cast<Milliseconds>(screen()->frameTime());
@@ -133,9 +193,20 @@ void EmuView::updateFrameTimeStats(FrameTimeStats stats, SteadyClockTimePoint cu
 			"Draw: {}ms\n"
 			"Present: {}ms\n"
 			"Total: {}ms\n"
-			"Missed Callbacks: {}",
+			"Missed Callbacks: {}\n"
+			"Video Buffer Stalls: {}\n"
+			"Emulation Thread Wakeups: {:.0f}/s\n"
+			"Thermal Tier: {}\n"
+			"Draw Calls: {}\n"
+			"Texture Binds: {}\n"
+			"Program Switches: {}\n"
+			"State Changes: {}\n"
+			"Uploads: {} texture, {} buffer, {:.1f}KB",
 			screenFrameTime.count(), deadline.count(), timestampDiff.count(), callbackOverhead.count(), emulationTime.count(), submitFrameTime.count(),
-			postDrawTime.count(), drawTime.count(), presentTime.count(), frameTime.count(), stats.missedFrameCallbacks));
+			postDrawTime.count(), drawTime.count(), presentTime.count(), frameTime.count(), stats.missedFrameCallbacks, stats.videoBufferStalls, stats.taskWakeupsPerSecond,
+			wise_enum::to_string(stats.thermalTier), stats.drawStats.drawCalls, stats.drawStats.textureBinds,
+			stats.drawStats.programSwitches, stats.drawStats.stateChanges, stats.drawStats.textureUploads,
+			stats.drawStats.bufferUploads, stats.drawStats.uploadBytes / 1024.));
 		placeFrameTimeStats();
 	});
 }
@@ -22,6 +22,7 @@
 #include <emuframework/EmuAudio.hh>
 #include <emuframework/MainMenuView.hh>
 #include <emuframework/EmuOptions.hh>
+#include <emuframework/StageProfiler.hh>
 #include "../WindowData.hh"
 #include <imagine/base/ApplicationContext.hh>
 #include <imagine/base/Screen.hh>
@@ -369,6 +370,10 @@ bool EmuViewController::drawMainWindow(IG::Window &win, IG::WindowDrawParams par
 			inputView.draw(cmds);
 			if(app().showFrameTimeStats)
 				emuView.drawframeTimeStatsText(cmds);
+			if(StageProfiler::isEnabled())
+				emuView.drawStageTimesText(cmds);
+			if(app().frameTimeTelemetry.showsLatencyProbe() && app().frameTimeTelemetry.hasPendingInput())
+				emuView.drawLatencyProbe(cmds);
 			if(winData.hasPopup)
 				popup.draw(cmds);
 			app().record(FrameTimeStatEvent::aboutToPresent);
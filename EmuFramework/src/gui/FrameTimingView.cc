@@ -18,10 +18,14 @@
 #include <emuframework/EmuAppHelper.hh>
 #include <emuframework/EmuViewController.hh>
 #include <emuframework/viewUtils.hh>
+#include <emuframework/StageProfiler.hh>
 #include <imagine/base/Screen.hh>
 #include <imagine/base/ApplicationContext.hh>
 #include <imagine/gfx/Renderer.hh>
 #include <imagine/gfx/RendererCommands.hh>
+#include <imagine/fs/FS.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/util/memory/MemoryAccounting.hh>
 #include <format>
 #include <imagine/logger/logger.h>
 
@@ -169,6 +173,53 @@ public:
 	}
 };
 
+class MemoryUsageView final: public TableView, public EmuAppHelper
+{
+public:
+	MemoryUsageView(ViewAttachParams attach):
+		TableView{"Memory Usage (Current / Peak)", attach, item},
+		allocatorHeading{"By Allocator", attach},
+		ownerHeading{"By Owner", attach},
+		categoryItems
+		{
+			{"Virtual Memory", "", attach, [this]{ update(); }},
+			{"Dynamic Arrays", "", attach, [this]{ update(); }},
+			{"Textures", "", attach, [this]{ update(); }},
+			{"Rewind States", "", attach, [this]{ update(); }},
+			{"Audio Buffers", "", attach, [this]{ update(); }},
+			{"Emulated System", "", attach, [this]{ update(); }},
+		}
+	{
+		item.emplace_back(&allocatorHeading);
+		for(auto i : iotaCount(memoryCategories))
+		{
+			if(MemoryCategory(i) == MemoryCategory::rewind)
+				item.emplace_back(&ownerHeading);
+			item.emplace_back(&categoryItems[i]);
+		}
+		update();
+	}
+
+	void update()
+	{
+		auto toMiB = [](size_t bytes){ return bytes / (1024. * 1024.); };
+		for(auto i : iotaCount(memoryCategories))
+		{
+			auto cat = MemoryCategory(i);
+			categoryItems[i].set2ndName(std::format("{:.1f} / {:.1f} MiB",
+				toMiB(MemoryAccounting::current(cat)), toMiB(MemoryAccounting::peak(cat))));
+			categoryItems[i].place2nd();
+		}
+		postDraw();
+	}
+
+private:
+	TextHeadingMenuItem allocatorHeading;
+	TextHeadingMenuItem ownerHeading;
+	DualTextMenuItem categoryItems[memoryCategories];
+	StaticArrayList<MenuItem*, memoryCategories + 2> item;
+};
+
 static std::string makeFrameRateStr(VideoSystem vidSys, const OutputTimingManager &mgr)
 {
 	auto frameTimeOpt = mgr.frameTimeOption(vidSys);
@@ -200,6 +251,18 @@ FrameTimingView::FrameTimingView(ViewAttachParams attach):
 			.defaultItemOnSelect = [this](TextMenuItem &item) { app().frameInterval.setUnchecked(item.id); }
 		},
 	},
+	predictiveFrameSkip
+	{
+		"Predictive Frame Skip", attach,
+		app().predictiveFrameSkip,
+		[this](BoolMenuItem &item) { app().predictiveFrameSkip = item.flipBoolValue(*this); }
+	},
+	batchFrameInterval
+	{
+		"Batch Frames Below Target (Battery Saver)", attach,
+		app().batchFrameInterval,
+		[this](BoolMenuItem &item) { app().batchFrameInterval = item.flipBoolValue(*this); }
+	},
 	frameRateItems
 	{
 		{"Auto (Match screen when rates are similar)", attach,
@@ -306,11 +369,17 @@ FrameTimingView::FrameTimingView(ViewAttachParams attach):
 		app().showFrameTimeStats,
 		[this](BoolMenuItem &item) { app().showFrameTimeStats = item.flipBoolValue(*this); }
 	},
+	stageTimes
+	{
+		"Show CPU Time Breakdown", attach,
+		StageProfiler::isEnabled(),
+		[this](BoolMenuItem &item) { StageProfiler::setEnabled(item.flipBoolValue(*this)); }
+	},
 	frameClockItems
 	{
 		{"Auto",                                  attach, MenuItem::Config{.id = FrameTimeSource::Unset}},
 		{"Screen (Less latency & power use)",     attach, MenuItem::Config{.id = FrameTimeSource::Screen}},
-		{"Timer (Best for VRR displays)",         attach, MenuItem::Config{.id = FrameTimeSource::Timer}},
+		{"Timer (VRR displays, exact system rate)", attach, MenuItem::Config{.id = FrameTimeSource::Timer}},
 		{"Renderer (May buffer multiple frames)", attach, MenuItem::Config{.id = FrameTimeSource::Renderer}},
 	},
 	frameClock
@@ -406,7 +475,102 @@ FrameTimingView::FrameTimingView(ViewAttachParams attach):
 		app().allowBlankFrameInsertion,
 		[this](BoolMenuItem &item) { app().allowBlankFrameInsertion = item.flipBoolValue(*this); }
 	},
-	advancedHeading{"Advanced", attach}
+	pacedFrameTiming
+	{
+		"Paced Frame Timing", attach,
+		app().pacedFrameTiming,
+		[this](BoolMenuItem &item) { app().pacedFrameTiming = item.flipBoolValue(*this); }
+	},
+	pipelineFrames
+	{
+		"Pipeline Frames", attach,
+		app().pipelineFrames,
+		[this](BoolMenuItem &item) { app().pipelineFrames = item.flipBoolValue(*this); }
+	},
+	autoTune
+	{
+		"Auto-Tune With Current Content (~20s)", attach,
+		[this]
+		{
+			if(!app().autoTuner.start())
+			{
+				app().postErrorMessage("Load content to run auto-tune");
+				return;
+			}
+			app().showEmulation();
+		}
+	},
+	advancedHeading{"Advanced", attach},
+	telemetryHeading{"Telemetry (p50 / p95 / p99)", attach},
+	telemetry
+	{
+		"Record Frame Time Telemetry", attach,
+		app().frameTimeTelemetry.isEnabled(),
+		[this](BoolMenuItem &item)
+		{
+			app().frameTimeTelemetry.setEnabled(item.flipBoolValue(*this));
+			updateTelemetryStats();
+		}
+	},
+	telemetryStats
+	{
+		{"Emulate", "", attach, [this]{ updateTelemetryStats(); }},
+		{"Submit To Present", "", attach, [this]{ updateTelemetryStats(); }},
+		{"Total Frame", "", attach, [this]{ updateTelemetryStats(); }},
+		{"Input To Present", "", attach, [this]{ updateTelemetryStats(); }},
+	},
+	telemetryMissedCallbacks
+	{
+		"Missed Frame Callbacks", "", attach, [this]{ updateTelemetryStats(); }
+	},
+	telemetryEnergy
+	{
+		"Energy (On Battery)", "", attach, [this]{ updateTelemetryStats(); }
+	},
+	latencyProbe
+	{
+		"Flash Screen On Input", attach,
+		app().frameTimeTelemetry.showsLatencyProbe(),
+		[this](BoolMenuItem &item)
+		{
+			app().frameTimeTelemetry.setShowLatencyProbe(item.flipBoolValue(*this));
+		}
+	},
+	telemetryExport
+	{
+		"Export Telemetry To CSV", attach,
+		[this]
+		{
+			auto ctx = appContext();
+			auto path = FS::pathString(FS::createDirectorySegments(ctx.storagePath(), "EmuEx"),
+				std::format("frameTimeTelemetry-{}.csv", ctx.formatDateAndTimeAsFilename(WallClock::now())));
+			try
+			{
+				FileIO io{path, OpenFlags::newFile()};
+				if(!app().frameTimeTelemetry.writeCSV(io))
+					throw std::runtime_error{"write failed"};
+				app().postMessage(4, false, std::format("Wrote telemetry to {}", path));
+			}
+			catch(std::exception &err)
+			{
+				app().postErrorMessage(4, std::format("Error writing telemetry: {}", err.what()));
+			}
+		}
+	},
+	telemetryClear
+	{
+		"Clear Telemetry", attach,
+		[this]
+		{
+			app().frameTimeTelemetry.clear();
+			updateTelemetryStats();
+		}
+	},
+	memoryUsage
+	{
+		"Memory Usage", attach,
+		[this](const Input::Event &e) { pushAndShow(makeView<MemoryUsageView>(), e); }
+	}
 {
 	loadStockItems();
 }
@@ -414,6 +578,8 @@ FrameTimingView::FrameTimingView(ViewAttachParams attach):
 void FrameTimingView::loadStockItems()
 {
 	item.emplace_back(&frameInterval);
+	item.emplace_back(&predictiveFrameSkip);
+	item.emplace_back(&batchFrameInterval);
 	item.emplace_back(&frameRate);
 	if(EmuSystem::hasPALVideoSystem)
 	{
@@ -421,6 +587,7 @@ void FrameTimingView::loadStockItems()
 	}
 	if(used(frameTimeStats))
 		item.emplace_back(&frameTimeStats);
+	item.emplace_back(&stageTimes);
 	item.emplace_back(&advancedHeading);
 	item.emplace_back(&frameClock);
 	if(used(presentMode))
@@ -428,8 +595,52 @@ void FrameTimingView::loadStockItems()
 	if(used(presentationTime) && renderer().supportsPresentationTime())
 		item.emplace_back(&presentationTime);
 	item.emplace_back(&blankFrameInsertion);
+	item.emplace_back(&pacedFrameTiming);
+	item.emplace_back(&pipelineFrames);
+	item.emplace_back(&autoTune);
 	if(used(screenFrameRate) && app().emuScreen().supportedFrameRates().size() > 1)
 		item.emplace_back(&screenFrameRate);
+	item.emplace_back(&telemetryHeading);
+	item.emplace_back(&telemetry);
+	for(auto &i : telemetryStats)
+		item.emplace_back(&i);
+	item.emplace_back(&telemetryMissedCallbacks);
+	item.emplace_back(&telemetryEnergy);
+	item.emplace_back(&latencyProbe);
+	item.emplace_back(&telemetryExport);
+	item.emplace_back(&telemetryClear);
+	item.emplace_back(&memoryUsage);
+}
+
+void FrameTimingView::onShow()
+{
+	TableView::onShow();
+	updateTelemetryStats();
+}
+
+void FrameTimingView::updateTelemetryStats()
+{
+	auto &telemetry = app().frameTimeTelemetry;
+	auto toMs = [](Microseconds t){ return t.count() / 1000.; };
+	for(auto i : iotaCount(frameTimeMetrics))
+	{
+		auto &h = telemetry.histogram(FrameTimeMetric(i));
+		if(h.count())
+			telemetryStats[i].set2ndName(std::format("{:.1f} / {:.1f} / {:.1f}ms",
+				toMs(h.percentile(.5)), toMs(h.percentile(.95)), toMs(h.percentile(.99))));
+		else
+			telemetryStats[i].set2ndName("-");
+		telemetryStats[i].place2nd();
+	}
+	telemetryMissedCallbacks.set2ndName(std::format("{} of {} frames", telemetry.missedFrameCallbacks(), telemetry.frames()));
+	telemetryMissedCallbacks.place2nd();
+	auto &energy = telemetry.energy();
+	if(energy.hasPower() && telemetry.frames())
+		telemetryEnergy.set2ndName(std::format("{:.2f} mJ/frame, {:.2f} W", energy.joules() * 1000. / telemetry.frames(), energy.averageWatts()));
+	else
+		telemetryEnergy.set2ndName("-");
+	telemetryEnergy.place2nd();
+	postDraw();
 }
 
 bool FrameTimingView::onFrameTimeChange(VideoSystem vidSys, SteadyClockTime time)
@@ -34,16 +34,20 @@ class FrameTimingView : public TableView, public EmuAppHelper
 public:
 	FrameTimingView(ViewAttachParams attach);
 	void loadStockItems();
+	void onShow() override;
 
 protected:
 	static constexpr int MAX_ASPECT_RATIO_ITEMS = 5;
 	TextMenuItem frameIntervalItem[5];
 	MultiChoiceMenuItem frameInterval;
+	BoolMenuItem predictiveFrameSkip;
+	BoolMenuItem batchFrameInterval;
 	TextMenuItem frameRateItems[4];
 	VideoSystem activeVideoSystem{};
 	MultiChoiceMenuItem frameRate;
 	MultiChoiceMenuItem frameRatePAL;
 	ConditionalMember<enableFrameTimeStats, BoolMenuItem> frameTimeStats;
+	BoolMenuItem stageTimes;
 	TextMenuItem frameClockItems[4];
 	MultiChoiceMenuItem frameClock;
 	ConditionalMember<Gfx::supportsPresentModes, TextMenuItem> presentModeItems[3];
@@ -53,10 +57,23 @@ protected:
 	ConditionalMember<Gfx::supportsPresentationTime, TextMenuItem> presentationTimeItems[3];
 	ConditionalMember<Gfx::supportsPresentationTime, MultiChoiceMenuItem> presentationTime;
 	BoolMenuItem blankFrameInsertion;
+	BoolMenuItem pacedFrameTiming;
+	BoolMenuItem pipelineFrames;
+	TextMenuItem autoTune;
 	TextHeadingMenuItem advancedHeading;
-	StaticArrayList<MenuItem*, 10> item;
+	TextHeadingMenuItem telemetryHeading;
+	BoolMenuItem telemetry;
+	DualTextMenuItem telemetryStats[4];
+	DualTextMenuItem telemetryMissedCallbacks;
+	DualTextMenuItem telemetryEnergy;
+	BoolMenuItem latencyProbe;
+	TextMenuItem telemetryExport;
+	TextMenuItem telemetryClear;
+	TextMenuItem memoryUsage;
+	StaticArrayList<MenuItem*, 27> item;
 
 	bool onFrameTimeChange(VideoSystem vidSys, SteadyClockTime time);
+	void updateTelemetryStats();
 };
 
 }
@@ -0,0 +1,178 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include "RamSearchView.hh"
+#include <emuframework/EmuApp.hh>
+#include <emuframework/viewUtils.hh>
+#include <format>
+
+namespace EmuEx
+{
+
+// defaults to the largest section, in practice the main work RAM
+static size_t defaultRegion(EmuSystem &sys)
+{
+	size_t idx{}, largestIdx{}, largestSize{};
+	sys.forEachStateSection([&](StateSection s)
+	{
+		if(s.data.size() > largestSize)
+		{
+			largestSize = s.data.size();
+			largestIdx = idx;
+		}
+		idx++;
+	});
+	return largestIdx;
+}
+
+RamSearchView::RamSearchView(ViewAttachParams attach):
+	TableView
+	{
+		"RAM Search", attach,
+		[this](ItemMessage msg) -> ItemReply
+		{
+			return msg.visit(overloaded
+			{
+				[&](const ItemsMessage &m) -> ItemReply
+				{
+					return item.size() + (app().ramSearch.isActive() ? app().ramSearch.candidates() : 0);
+				},
+				[&](const GetItemMessage &m) -> ItemReply
+				{
+					if(m.idx < item.size())
+						return item[m.idx];
+					return &resultItem(m.idx - item.size());
+				},
+			});
+		}
+	},
+	regionItems
+	{
+		[&]
+		{
+			std::vector<TextMenuItem> items;
+			size_t idx{};
+			system().forEachStateSection([&](StateSection s)
+			{
+				items.emplace_back(s.name, attach, MenuItem::Config{.id = idx++});
+			});
+			return items;
+		}()
+	},
+	region
+	{
+		"Memory Region", attach,
+		MenuId{app().ramSearch.isActive() ? app().ramSearch.sectionIndex() : defaultRegion(system())},
+		regionItems,
+		MultiChoiceMenuItem::Config
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item)
+			{
+				regionIdx = item.id.val;
+				app().ramSearch.reset();
+				reloadItems();
+			}
+		},
+	},
+	start
+	{
+		"Start New Search", attach,
+		[this]
+		{
+			app().ramSearch.start(system(), regionIdx);
+			reloadItems();
+		}
+	},
+	equal{"Equal To Previous", attach, [this]{ filter(RamSearchCompare::equal); }},
+	notEqual{"Not Equal To Previous", attach, [this]{ filter(RamSearchCompare::notEqual); }},
+	greater{"Greater Than Previous", attach, [this]{ filter(RamSearchCompare::greater); }},
+	less{"Less Than Previous", attach, [this]{ filter(RamSearchCompare::less); }},
+	equalValue
+	{
+		"Equal To Value", attach,
+		[this](const Input::Event &e)
+		{
+			pushAndShowNewCollectValueRangeInputView<int, 0, 255>(attachParams(), e, "Input 0 to 255", "",
+				[this](CollectTextInputView &, auto val)
+				{
+					filter(RamSearchCompare::equalValue, val);
+					return true;
+				});
+		}
+	},
+	resultsHeading{"Results", attach},
+	resultItems
+	{
+		[&]
+		{
+			std::vector<TextMenuItem> items;
+			items.reserve(resultPoolSize);
+			for([[maybe_unused]] auto i : iotaCount(resultPoolSize))
+			{
+				items.emplace_back(u"", attach);
+			}
+			return items;
+		}()
+	},
+	resultItemRow(resultPoolSize, SIZE_MAX),
+	regionIdx{size_t(region.selected())}
+{
+	setVirtualRows(true);
+	reloadItems();
+}
+
+void RamSearchView::filter(RamSearchCompare compare, uint8_t value)
+{
+	app().ramSearch.filter(system(), compare, value);
+	reloadItems();
+}
+
+void RamSearchView::reloadItems()
+{
+	auto &search = app().ramSearch;
+	item.clear();
+	std::ranges::fill(resultItemRow, SIZE_MAX);
+	item.emplace_back(&region);
+	item.emplace_back(&start);
+	for(auto i : {&equal, &notEqual, &greater, &less, &equalValue})
+	{
+		i->setActive(search.isActive());
+		item.emplace_back(i);
+	}
+	if(search.isActive())
+	{
+		resultsHeading.compile(std::format("Results ({} Candidates)", search.candidates()));
+		item.emplace_back(&resultsHeading);
+	}
+	place();
+	postDraw();
+}
+
+TextMenuItem &RamSearchView::resultItem(size_t row)
+{
+	auto slot = row % resultPoolSize;
+	auto &i = resultItems[slot];
+	if(resultItemRow[slot] != row)
+	{
+		auto &search = app().ramSearch;
+		auto off = search.candidateOffset(row);
+		auto val = search.value(off);
+		i.compile(std::format("{:06X}: {} ({:02X})", search.sectionAddress() + off, val, val));
+		resultItemRow[slot] = row;
+	}
+	return i;
+}
+
+}
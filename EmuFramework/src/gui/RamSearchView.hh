@@ -0,0 +1,55 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/EmuAppHelper.hh>
+#include <emuframework/RamSearch.hh>
+#include <imagine/gui/TableView.hh>
+#include <imagine/gui/MenuItem.hh>
+#include <vector>
+
+namespace EmuEx
+{
+
+class RamSearchView : public TableView, public EmuAppHelper
+{
+public:
+	RamSearchView(ViewAttachParams attach);
+
+private:
+	// recycled for the visible result rows, more than any screen shows
+	static constexpr size_t resultPoolSize = 128;
+
+	std::vector<TextMenuItem> regionItems;
+	MultiChoiceMenuItem region;
+	TextMenuItem start;
+	TextMenuItem equal;
+	TextMenuItem notEqual;
+	TextMenuItem greater;
+	TextMenuItem less;
+	TextMenuItem equalValue;
+	TextHeadingMenuItem resultsHeading;
+	std::vector<TextMenuItem> resultItems;
+	std::vector<size_t> resultItemRow;
+	std::vector<MenuItem*> item;
+	size_t regionIdx{};
+
+	void filter(RamSearchCompare, uint8_t value = 0);
+	void reloadItems();
+	TextMenuItem &resultItem(size_t row);
+};
+
+}
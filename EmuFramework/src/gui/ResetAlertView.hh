@@ -32,6 +32,7 @@ public:
 				"Soft Reset", attach,
 				[this, &app]()
 				{
+					app.stopInputRecording("reset");
 					app.system().reset(app, EmuSystem::ResetMode::SOFT);
 					app.showEmulation();
 				}
@@ -41,6 +42,7 @@ public:
 				"Hard Reset", attach,
 				[this, &app]()
 				{
+					app.stopInputRecording("reset");
 					app.system().reset(app, EmuSystem::ResetMode::HARD);
 					app.showEmulation();
 				}
@@ -65,6 +67,7 @@ inline std::unique_ptr<View> resetAlertView(ViewAttachParams attachParams, EmuAp
 			{
 				.onYes = [&app]
 				{
+					app.stopInputRecording("reset");
 					app.system().reset(app, EmuSystem::ResetMode::SOFT);
 					app.showEmulation();
 				}
@@ -27,6 +27,8 @@
 #include "ResetAlertView.hh"
 #include <imagine/gui/TextEntry.hh>
 #include <imagine/base/ApplicationContext.hh>
+#include <imagine/fs/FS.hh>
+#include <imagine/io/FileIO.hh>
 #include <imagine/util/format.hh>
 #include <imagine/logger/logger.h>
 
@@ -35,6 +37,11 @@ namespace EmuEx
 
 constexpr SystemLogger log{"SystemActionsView"};
 
+static const char *inputRecordingName(EmuApp &app)
+{
+	return app.inputReplay.isRecording() ? "Stop Input Recording" : "Start Input Recording";
+}
+
 static auto autoSaveName(EmuApp &app)
 {
 	return std::format("Autosave Slot ({})", app.autosaveManager.slotFullName());
@@ -172,6 +179,25 @@ SystemActionsView::SystemActionsView(ViewAttachParams attach, bool customMenu):
 				}), e);
 		}
 	},
+	inputRecording
+	{
+		inputRecordingName(app()), attach,
+		[this]
+		{
+			if(!system().hasContent())
+				return;
+			auto &replay = app().inputReplay;
+			app().syncEmulationThread();
+			if(!replay.isRecording())
+			{
+				replay.startRecording(system());
+				app().showEmulation();
+				return;
+			}
+			app().stopInputRecording();
+			inputRecording.compile(inputRecordingName(app()));
+		}
+	},
 	resetSessionOptions
 	{
 		"Reset Saved Options", attach,
@@ -218,6 +244,7 @@ void SystemActionsView::onShow()
 	autosaveNow.setActive(app().autosaveManager.slotName() != noAutosaveName);
 	revertAutosave.setActive(app().autosaveManager.slotName() != noAutosaveName);
 	resetSessionOptions.setActive(app().hasSavedSessionOptions());
+	inputRecording.compile(inputRecordingName(app()));
 }
 
 void SystemActionsView::loadStandardItems()
@@ -234,6 +261,7 @@ void SystemActionsView::loadStandardItems()
 	if(used(addLauncherIcon))
 		item.emplace_back(&addLauncherIcon);
 	item.emplace_back(&screenshot);
+	item.emplace_back(&inputRecording);
 	item.emplace_back(&resetSessionOptions);
 	item.emplace_back(&close);
 }
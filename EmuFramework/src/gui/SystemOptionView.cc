@@ -90,6 +90,16 @@ SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 			app().autosaveManager.saveOnlyBackupMemory = item.flipBoolValue(*this);
 		}
 	},
+	autosaveMappedState
+	{
+		"Autosave State Storage", attach,
+		app().autosaveManager.useMappedState,
+		"Compressed", "Memory Mapped",
+		[this](BoolMenuItem &item)
+		{
+			app().autosaveManager.useMappedState = item.flipBoolValue(*this);
+		}
+	},
 	confirmOverwriteState
 	{
 		"Confirm Overwrite State", attach,
@@ -99,6 +109,21 @@ SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 			app().confirmOverwriteState = item.flipBoolValue(*this);
 		}
 	},
+	stateCompressionItem
+	{
+		{"Default",  attach, {.id = StateCompression::Default}},
+		{"Fast",     attach, {.id = StateCompression::Fast}},
+		{"Smallest", attach, {.id = StateCompression::Small}},
+	},
+	stateCompression
+	{
+		"Save State Compression", attach,
+		MenuId{app().stateCompression.value()},
+		stateCompressionItem,
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item) { app().stateCompression = StateCompression(item.id.val); }
+		},
+	},
 	fastModeSpeedItem
 	{
 		{"1.5x",  attach, {.id = 150}},
@@ -136,6 +161,16 @@ SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 			.defaultItemOnSelect = [this](TextMenuItem &item) { app().setAltSpeed(AltSpeedMode::fast, item.id); }
 		},
 	},
+	fastModeMaxThroughput
+	{
+		"Fast-forward Mode", attach,
+		app().fastModeMaxThroughput,
+		"Normal", "Max Throughput",
+		[this](BoolMenuItem &item)
+		{
+			app().fastModeMaxThroughput = item.flipBoolValue(*this);
+		}
+	},
 	slowModeSpeedItem
 	{
 		{"0.25x", attach, {.id = 25}},
@@ -211,6 +246,45 @@ SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 			.defaultItemOnSelect = [this](TextMenuItem &item) { app().rewindManager.updateMaxStates(item.id); }
 		},
 	},
+	rewindMemoryBudgetItem
+	{
+		{"Off",    attach, {.id = 0}},
+		{"16MB",   attach, {.id = 16}},
+		{"32MB",   attach, {.id = 32}},
+		{"64MB",   attach, {.id = 64}},
+		{"128MB",  attach, {.id = 128}},
+		{"256MB",  attach, {.id = 256}},
+	},
+	rewindMemoryBudget
+	{
+		"Rewind Memory Budget", attach,
+		MenuId{app().rewindManager.memoryBudgetMiB},
+		rewindMemoryBudgetItem,
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item)
+			{
+				app().syncEmulationThread();
+				app().rewindManager.updateMemoryBudget(item.id);
+				updateRewindMemoryUsage();
+			}
+		},
+	},
+	rewindMemoryUsage
+	{
+		"Rewind Memory In Use", "", attach,
+		[this]{ updateRewindMemoryUsage(); }
+	},
+	rewindDiskSpill
+	{
+		"Spill Rewind History To Storage", attach,
+		app().rewindManager.diskSpill,
+		[this](BoolMenuItem &item)
+		{
+			app().syncEmulationThread();
+			app().rewindManager.updateDiskSpill(item.flipBoolValue(*this));
+			updateRewindMemoryUsage();
+		}
+	},
 	rewindTimeInterval
 	{
 		"Rewind State Interval (Seconds)", std::to_string(app().rewindManager.saveTimer.frequency.count()), attach,
@@ -226,6 +300,124 @@ SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 				});
 		}
 	},
+	rewindFrameIntervalItem
+	{
+		{"Off", attach, {.id = 0}},
+		{"1",   attach, {.id = 1}},
+		{"2",   attach, {.id = 2}},
+		{"5",   attach, {.id = 5}},
+		{"10",  attach, {.id = 10}},
+		{"30",  attach, {.id = 30}},
+	},
+	rewindFrameInterval
+	{
+		"Rewind State Interval (Frames)", attach,
+		MenuId{app().rewindManager.frameInterval},
+		rewindFrameIntervalItem,
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item) { app().rewindManager.updateFrameInterval(item.id); }
+		},
+	},
+	rewindKeyframeIntervalItem
+	{
+		{"Off", attach, {.id = 0}},
+		{"10",  attach, {.id = 10}},
+		{"30",  attach, {.id = 30}},
+		{"60",  attach, {.id = 60}},
+	},
+	rewindKeyframeInterval
+	{
+		"Rewind Delta Keyframe Interval", attach,
+		MenuId{app().rewindManager.keyframeInterval},
+		rewindKeyframeIntervalItem,
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item) { app().rewindManager.updateKeyframeInterval(item.id); }
+		},
+	},
+	continuousRewind
+	{
+		"Rewind Key Action", attach,
+		app().rewindManager.continuousRewind,
+		"Single Step", "Hold To Rewind",
+		[this](BoolMenuItem &item)
+		{
+			app().rewindManager.continuousRewind = item.flipBoolValue(*this);
+		}
+	},
+	continuousRewindIntervalItem
+	{
+		{"1",  attach, {.id = 1}},
+		{"2",  attach, {.id = 2}},
+		{"4",  attach, {.id = 4}},
+		{"10", attach, {.id = 10}},
+	},
+	continuousRewindInterval
+	{
+		"Hold Rewind Frames Per State", attach,
+		MenuId{app().rewindManager.continuousRewindInterval},
+		continuousRewindIntervalItem,
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item) { app().rewindManager.continuousRewindInterval = item.id; }
+		},
+	},
+	rewindReverseAudio
+	{
+		"Play Reversed Audio While Rewinding", attach,
+		app().rewindManager.reverseAudio,
+		[this](BoolMenuItem &item)
+		{
+			app().rewindManager.reverseAudio = item.flipBoolValue(*this);
+		}
+	},
+	runAheadFramesItem
+	{
+		{"Off", attach, {.id = 0}},
+		{"1",   attach, {.id = 1}},
+		{"2",   attach, {.id = 2}},
+		{"3",   attach, {.id = 3}},
+		{"4",   attach, {.id = 4}},
+	},
+	runAheadFrames
+	{
+		"Run-Ahead Frames", attach,
+		MenuId{app().runAheadManager.frames()},
+		runAheadFramesItem,
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item)
+			{
+				app().syncEmulationThread();
+				app().runAheadManager.updateFrames(item.id);
+			}
+		},
+	},
+	runAheadSecondInstance
+	{
+		"Run-Ahead Using Second Instance", attach,
+		app().runAheadManager.useSecondInstance,
+		[this](BoolMenuItem &item)
+		{
+			app().syncEmulationThread();
+			app().runAheadManager.useSecondInstance = item.flipBoolValue(*this);
+		}
+	},
+	archiveCacheSizeItem
+	{
+		{"Off",    attach, {.id = 0}},
+		{"64MB",   attach, {.id = 64}},
+		{"128MB",  attach, {.id = 128}},
+		{"256MB",  attach, {.id = 256}},
+		{"512MB",  attach, {.id = 512}},
+		{"1024MB", attach, {.id = 1024}},
+	},
+	archiveCacheSize
+	{
+		"Extracted Archive Cache", attach,
+		MenuId{app().archiveCache.sizeCap()},
+		archiveCacheSizeItem,
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item) { app().archiveCache.setSizeCap(item.id); }
+		},
+	},
 	performanceMode
 	{
 		"Performance Mode", attach,
@@ -236,6 +428,15 @@ SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 			app().useSustainedPerformanceMode = item.flipBoolValue(*this);
 		}
 	},
+	thermalGovernor
+	{
+		"Reduce Quality When Hot", attach,
+		app().thermalGovernor.isEnabled(),
+		[this](BoolMenuItem &item)
+		{
+			app().thermalGovernor.setEnabled(item.flipBoolValue(*this));
+		}
+	},
 	noopThread
 	{
 		"No-op Thread (Experimental)", attach,
@@ -265,17 +466,59 @@ void SystemOptionView::loadStockItems()
 	item.emplace_back(&autosaveLaunch);
 	item.emplace_back(&autosaveTimer);
 	item.emplace_back(&autosaveContent);
+	item.emplace_back(&autosaveMappedState);
 	item.emplace_back(&confirmOverwriteState);
+	item.emplace_back(&stateCompression);
 	item.emplace_back(&fastModeSpeed);
+	item.emplace_back(&fastModeMaxThroughput);
 	item.emplace_back(&slowModeSpeed);
 	item.emplace_back(&rewindStates);
+	item.emplace_back(&rewindMemoryBudget);
+	item.emplace_back(&rewindMemoryUsage);
+	item.emplace_back(&rewindDiskSpill);
 	item.emplace_back(&rewindTimeInterval);
+	item.emplace_back(&rewindFrameInterval);
+	item.emplace_back(&rewindKeyframeInterval);
+	item.emplace_back(&continuousRewind);
+	item.emplace_back(&continuousRewindInterval);
+	item.emplace_back(&rewindReverseAudio);
+	item.emplace_back(&runAheadFrames);
+	if(app().system().hasRunAheadInstance())
+		item.emplace_back(&runAheadSecondInstance);
+	if(!EmuSystem::handlesArchiveFiles)
+		item.emplace_back(&archiveCacheSize);
 	if(used(performanceMode) && appContext().hasSustainedPerformanceMode())
 		item.emplace_back(&performanceMode);
+	if(used(thermalGovernor))
+		item.emplace_back(&thermalGovernor);
 	if(used(noopThread))
 		item.emplace_back(&noopThread);
 	if(used(cpuAffinity) && appContext().cpuCount() > 1)
 		item.emplace_back(&cpuAffinity);
 }
 
+void SystemOptionView::onShow()
+{
+	TableView::onShow();
+	updateRewindMemoryUsage();
+}
+
+void SystemOptionView::updateRewindMemoryUsage()
+{
+	auto &rewindManager = app().rewindManager;
+	constexpr double mib = 1024. * 1024.;
+	if(auto spilled = rewindManager.spillBytesUsed(); spilled)
+	{
+		rewindMemoryUsage.set2ndName(std::format("{:.1f} / {:.1f}MB (+{:.1f}MB stored)",
+			rewindManager.memoryUsed() / mib, rewindManager.memoryAllocated() / mib, spilled / mib));
+	}
+	else
+	{
+		rewindMemoryUsage.set2ndName(std::format("{:.1f} / {:.1f}MB",
+			rewindManager.memoryUsed() / mib, rewindManager.memoryAllocated() / mib));
+	}
+	rewindMemoryUsage.place2nd();
+	postDraw();
+}
+
 }
@@ -263,6 +263,8 @@ VideoOptionView::VideoOptionView(ViewAttachParams attach, EmuVideoLayer &videoLa
 		{"Prescale 2x", attach, {.id = ImageEffectId::PRESCALE2X}},
 		{"Prescale 3x", attach, {.id = ImageEffectId::PRESCALE3X}},
 		{"Prescale 4x", attach, {.id = ImageEffectId::PRESCALE4X}},
+		{"Scale4x",     attach, {.id = ImageEffectId::SCALE4X}},
+		{"hq2x + Scale2x", attach, {.id = ImageEffectId::HQ2X_SCALE2X}},
 	},
 	imgEffect
 	{
@@ -458,6 +460,27 @@ VideoOptionView::VideoOptionView(ViewAttachParams attach, EmuVideoLayer &videoLa
 			.defaultItemOnSelect = [this](TextMenuItem &item) { app().setRenderPixelFormat(PixelFormatId(item.id.val)); }
 		},
 	},
+	gpuPaletteConversion
+	{
+		"GPU Palette Conversion", attach,
+		app().gpuPaletteConversion,
+		[this](BoolMenuItem &item)
+		{
+			app().gpuPaletteConversion = item.flipBoolValue(*this);
+			// let the system pick the video format again
+			if(system().onVideoRenderFormatChange(emuVideo(), emuVideo().renderPixelFormat()))
+				app().renderSystemFramebuffer(emuVideo());
+		}
+	},
+	partialFrameUpload
+	{
+		"Upload Only Changed Lines", attach,
+		app().partialFrameUpload,
+		[this](BoolMenuItem &item)
+		{
+			app().partialFrameUpload = item.flipBoolValue(*this);
+		}
+	},
 	brightnessItem
 	{
 		{
@@ -573,6 +596,9 @@ void VideoOptionView::loadStockItems()
 	}
 	if(EmuSystem::canRenderRGBA8888)
 		item.emplace_back(&renderPixelFormat);
+	if(EmuSystem::canRenderPaletteIndices)
+		item.emplace_back(&gpuPaletteConversion);
+	item.emplace_back(&partialFrameUpload);
 	item.emplace_back(&imgEffectPixelFormat);
 	if(used(secondDisplay))
 		item.emplace_back(&secondDisplay);
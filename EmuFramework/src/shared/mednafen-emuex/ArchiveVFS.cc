@@ -20,21 +20,46 @@
 #include <imagine/io/MapIO.hh>
 #include <imagine/util/format.hh>
 #include <imagine/logger/logger.h>
+#include <algorithm>
 
 namespace Mednafen
 {
 
 constexpr IG::SystemLogger log{"ArchiveVFS"};
 
-ArchiveVFS::ArchiveVFS(IG::ArchiveIO arch):
-	VirtualFS('/', "/"),
-	arch{std::move(arch)} {}
+ArchiveVFS::ArchiveVFS(IG::ArchiveIO arch_):
+	VirtualFS('/', "/")
+{
+	if(!arch_.hasArchive())
+	{
+		arch = std::move(arch_);
+		return;
+	}
+	auto io = arch_.releaseIO();
+	if(auto entries = readZipDirectory(io); entries.size())
+	{
+		log.info("reading {} zip entries directly", entries.size());
+		zipIO = std::make_shared<IG::IO>(std::move(io));
+		zipEntries = std::move(entries);
+		return;
+	}
+	// solid or otherwise unsupported archives are extracted with libarchive
+	io.rewind();
+	arch = IG::ArchiveIO{std::move(io)};
+}
 
 Stream* ArchiveVFS::open(const std::string &path, const uint32 mode, const int do_lock, const bool throw_on_noent, const CanaryType canary)
 {
 	assert(mode == MODE_READ);
 	assert(do_lock == 0);
+	if(zipIO)
+	{
+		auto &entry = findZipEntry(path);
+		openedSize_ += entry.size;
+		return new ZipEntryStream{zipIO, entry};
+	}
 	seekFile(path);
+	openedSize_ += arch.size();
 	auto stream = std::make_unique<MemoryStream>(arch.size(), true);
 	if(arch.read(stream->map(), arch.size()) != ssize_t(arch.size()))
 	{
@@ -46,10 +71,29 @@ Stream* ArchiveVFS::open(const std::string &path, const uint32 mode, const int d
 FILE* ArchiveVFS::openAsStdio(const std::string& path, const uint32 mode)
 {
 	assert(mode == MODE_READ);
+	if(zipIO)
+	{
+		ZipEntryStream stream{zipIO, findZipEntry(path)};
+		IG::IOBuffer buff{size_t(stream.size())};
+		stream.read(buff.data(), buff.size());
+		return IG::MapIO{std::move(buff)}.toFileStream("rb");
+	}
 	seekFile(path);
 	return IG::MapIO{arch}.toFileStream("rb");
 }
 
+const ZipEntry &ArchiveVFS::findZipEntry(const std::string& path) const
+{
+	auto filename = IG::FS::basename(path);
+	log.info("looking for file:{}", filename);
+	auto it = std::ranges::find_if(zipEntries, [&](auto &e){ return IG::FS::basename(e.name) == filename; });
+	if(it == zipEntries.end())
+	{
+		throw MDFN_Error(ENOENT, "Not found");
+	}
+	return *it;
+}
+
 void ArchiveVFS::seekFile(const std::string& path)
 {
 	arch.rewind();
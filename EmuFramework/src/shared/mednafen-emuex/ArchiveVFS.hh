@@ -17,6 +17,10 @@
 
 #include <mednafen/VirtualFS.h>
 #include <imagine/io/ArchiveIO.hh>
+#include <imagine/io/IO.hh>
+#include "ZipEntryStream.hh"
+#include <memory>
+#include <vector>
 
 namespace Mednafen
 {
@@ -35,11 +39,20 @@ public:
 	bool finfo(const std::string& path, FileInfo*, const bool throw_on_noent = true) final;
 	void readdirentries(const std::string& path, std::function<bool(const std::string&)> callb) final;
 	std::string get_human_path(const std::string& path) final;
+	// zip entries hold their own reference to the archive and are read with positional reads
+	bool has_independent_streams(void) final { return bool(zipIO); }
+	// total uncompressed size of all files opened so far
+	uint64 openedSize() const { return openedSize_; }
 
 private:
 	IG::ArchiveIO arch;
+	// zip archives are read directly so entries support random access without extraction
+	std::shared_ptr<IG::IO> zipIO;
+	std::vector<ZipEntry> zipEntries;
+	uint64 openedSize_{};
 
 	void seekFile(const std::string& path);
+	const ZipEntry &findZipEntry(const std::string& path) const;
 };
 
 }
@@ -29,11 +29,20 @@
 #include <mednafen/MemoryStream.h>
 #include <mednafen/cdrom/CDInterface.h>
 #include <main/MainSystem.hh>
+#include <algorithm>
+#include <cstring>
 #include <string_view>
+#include <vector>
 
 namespace Mednafen
 {
 
+namespace MThreading
+{
+// IDs of all threads started with Thread_Create() that are still running, such as CD read threads
+void addActiveThreadIds(std::vector<IG::ThreadId> &);
+}
+
 struct DriveMediaStatus
 {
 	uint32 state_idx{};
@@ -124,11 +133,21 @@ inline BoolMenuItem saveFilenameTypeMenuItem(auto &view, auto &system)
 inline void loadContent(EmuSystem &sys, Mednafen::MDFNGI &mdfnGameInfo, IO &io, size_t maxContentSize)
 {
 	using namespace Mednafen;
-	auto stream = std::make_unique<MemoryStream>(maxContentSize, true);
-	auto size = io.read(stream->map(), stream->map_size());
-	if(size <= 0)
-		sys.throwFileReadError();
-	stream->setSize(size);
+	std::unique_ptr<Stream> stream;
+	if(auto mappedData = io.map(); mappedData.size())
+	{
+		// borrow the read-only mapping instead of copying, the core copies what it needs at load time
+		stream = std::make_unique<FileStream>(mappedData.first(std::min(mappedData.size(), maxContentSize)));
+	}
+	else
+	{
+		auto memStream = std::make_unique<MemoryStream>(maxContentSize, true);
+		auto size = io.read(memStream->map(), memStream->map_size());
+		if(size <= 0)
+			sys.throwFileReadError();
+		memStream->setSize(size);
+		stream = std::move(memStream);
+	}
 	MDFNFILE fp(&NVFS, std::move(stream));
 	GameFile gf{&NVFS, std::string{sys.contentDirectory()}, {}, fp.stream(),
 		std::string{dotExtension(sys.contentFileName())},
@@ -136,31 +155,102 @@ inline void loadContent(EmuSystem &sys, Mednafen::MDFNGI &mdfnGameInfo, IO &io,
 	mdfnGameInfo.Load(&gf);
 }
 
+inline void *pixels(const Mednafen::MDFN_Surface &surface)
+{
+	switch(surface.format.opp)
+	{
+		case 1: return surface.pixels8;
+		case 2: return surface.pixels16;
+		default: return surface.pixels;
+	}
+}
+
+// The texture memory can be used as an MDFN_Surface if it matches the format and holds whole pixels
+inline bool canRenderDirect(MutablePixmapView dest, PixmapDesc desc)
+{
+	return dest.desc() == desc && !(uintptr_t(dest.data()) % desc.format.bytesPerPixel());
+}
+
+// Points espec.SoundBuf straight into the audio output if it has room for maxFrames,
+// otherwise at espec.SoundBufFallback to be copied in by commitSoundBuf()
+inline void beginSoundBuf(Mednafen::EmulateSpecStruct &espec, EmuAudio *audio, size_t maxFrames)
+{
+	espec.SoundBufSize = 0;
+	if(!audio)
+	{
+		espec.SoundBuf = nullptr;
+		espec.SoundBufMaxSize = 0;
+		return;
+	}
+	espec.SoundBufMaxSize = maxFrames;
+	auto dest = static_cast<int16*>(audio->beginDirectWrite(maxFrames));
+	espec.SoundBuf = dest ? dest : espec.SoundBufFallback;
+}
+
+inline void commitSoundBuf(Mednafen::EmulateSpecStruct &espec, EmuAudio &audio)
+{
+	auto frames = std::exchange(espec.SoundBufSize, 0);
+	if(espec.SoundBuf != espec.SoundBufFallback)
+		audio.endDirectWrite(frames);
+	else
+		audio.writeFrames(espec.SoundBuf, frames);
+}
+
+// Cores whose committed frame is the whole of pixView can pass directRender to draw straight into
+// the locked video texture, commitVideoFrame() then falls back to a copy if the texture is incompatible
 inline void runFrame(EmuSystem &sys, Mednafen::MDFNGI &mdfnGameInfo, EmuSystemTaskContext taskCtx,
-	EmuVideo *videoPtr, MutablePixmapView pixView, EmuAudio *audioPtr, size_t maxAudioFrames, size_t maxLineWidths = 0)
+	EmuVideo *videoPtr, MutablePixmapView pixView, EmuAudio *audioPtr, size_t maxAudioFrames, size_t maxLineWidths = 0,
+	bool directRender = false)
 {
 	using namespace Mednafen;
 	int16 audioBuff[maxAudioFrames * 2];
 	EmulateSpecStruct espec{};
-	if(audioPtr)
-	{
-		espec.SoundBuf = audioBuff;
-		espec.SoundBufMaxSize = maxAudioFrames;
-	}
+	espec.SoundBufFallback = audioBuff;
+	beginSoundBuf(espec, audioPtr, maxAudioFrames);
 	espec.taskCtx = taskCtx;
 	espec.sys = &sys;
 	espec.video = videoPtr;
 	espec.skip = !videoPtr;
 	auto mSurface = toMDFNSurface(pixView);
+	EmuVideoImage videoImg;
+	if(videoPtr && directRender)
+	{
+		videoImg = videoPtr->startFrameWithFormat(taskCtx, pixView.desc());
+		if(videoImg)
+		{
+			if(canRenderDirect(videoImg.pixmap(), pixView.desc()))
+				mSurface = toMDFNSurface(videoImg.pixmap());
+			espec.videoImage = &videoImg;
+		}
+	}
 	espec.surface = &mSurface;
 	int32 lineWidth[maxLineWidths ?: 1];
 	if(maxLineWidths)
 		espec.LineWidths = lineWidth;
 	mdfnGameInfo.Emulate(&espec);
+	if(espec.videoImage) [[unlikely]] // core didn't commit a frame, still release the texture
+		videoImg.endFrame();
 	if(audioPtr)
 	{
-		assert((unsigned)espec.SoundBufSize <= audioPtr->format().bytesToFrames(sizeof(audioBuff)));
-		audioPtr->writeFrames((uint8_t*)audioBuff, espec.SoundBufSize);
+		assert((unsigned)espec.SoundBufSize <= maxAudioFrames);
+		commitSoundBuf(espec, *audioPtr);
+	}
+}
+
+// Submit the frame drawn into espec.surface, pix is the core's own buffer
+inline void commitVideoFrame(Mednafen::EmulateSpecStruct &espec, IG::PixmapView pix)
+{
+	if(auto img = std::exchange(espec.videoImage, nullptr))
+	{
+		if(img->pixmap().data() != pixels(*espec.surface))
+			img->pixmap().write(pix);
+		if(espec.lineTracker)
+			img->setDirtyLines(espec.lineTracker->takeRange());
+		img->endFrame();
+	}
+	else
+	{
+		espec.video->startFrameWithFormat(espec.taskCtx, pix);
 	}
 }
 
@@ -169,9 +259,17 @@ inline void runFrame(EmuSystem &sys, Mednafen::MDFNGI &mdfnGameInfo, EmuSystemTa
 inline size_t stateSizeMDFN()
 {
 	using namespace Mednafen;
-	MemoryStream s;
+	MemoryStream s, rawS;
 	MDFNSS_SaveSM(&s);
-	return s.size();
+	// raw states skip variable names but pad large arrays, so either layout can be the bigger one
+	MDFNSS_SaveSM(&rawS, true);
+	return std::max(s.size(), rawS.size());
+}
+
+// raw states from the data-only path start with a section name instead of the header magic
+inline bool isRawStateMDFN(std::span<const uint8_t> buff)
+{
+	return buff.size() >= 8 && std::memcmp(buff.data(), "MDFNSVST", 8) && std::memcmp(buff.data(), "MEDNAFEN", 8);
 }
 
 inline void readStateMDFN(EmuApp &app, std::span<uint8_t> buff)
@@ -194,7 +292,7 @@ inline void readStateMDFN(EmuApp &app, std::span<uint8_t> buff)
 	else
 	{
 		FileStream s{buff};
-		MDFNSS_LoadSM(&s);
+		MDFNSS_LoadSM(&s, isRawStateMDFN(buff));
 	}
 }
 
@@ -203,15 +301,17 @@ inline size_t writeStateMDFN(std::span<uint8_t> buff, SaveStateFlags flags)
 	using namespace Mednafen;
 	if(flags.uncompressed)
 	{
+		// session-only states use Mednafen's data-only path, a straight copy of each SFORMAT variable
+		// in table order without the name lookups, section map, or endian & bool conversion
 		FileStream s{buff};
-		MDFNSS_SaveSM(&s);
+		MDFNSS_SaveSM(&s, flags.sessionOnly);
 		return s.size();
 	}
 	else
 	{
 		MemoryStream s;
 		MDFNSS_SaveSM(&s);
-		return compressGzip(buff, {s.map(), size_t(s.size())}, MDFN_GetSettingI("filesys.state_comp_level"));
+		return EmuSystem::compressState(buff, {s.map(), size_t(s.size())}, flags, MDFN_GetSettingI("filesys.state_comp_level"));
 	}
 }
 
@@ -17,15 +17,19 @@
 #include <mednafen/MThreading.h>
 #include <imagine/util/utility.h>
 #include <imagine/thread/Semaphore.hh>
+#include <imagine/thread/Thread.hh>
 #include <imagine/logger/logger.h>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include <vector>
 
 namespace Mednafen::MThreading
 {
 
 constexpr IG::SystemLogger log{"MDFNThreading"};
+static std::mutex activeThreadIdsMutex;
+static std::vector<IG::ThreadId> activeThreadIds;
 
 struct Thread : public std::thread
 {
@@ -40,7 +44,23 @@ struct Sem : public std::counting_semaphore<0x80000>
 
 Thread* Thread_Create(int (*fn)(void *), void *data, const char* debug_name)
 {
-	return new Thread{fn, data};
+	return new Thread{[=]
+	{
+		auto id = IG::thisThreadId();
+		{
+			std::scoped_lock lock{activeThreadIdsMutex};
+			activeThreadIds.emplace_back(id);
+		}
+		fn(data);
+		std::scoped_lock lock{activeThreadIdsMutex};
+		std::erase(activeThreadIds, id);
+	}};
+}
+
+void addActiveThreadIds(std::vector<IG::ThreadId> &ids)
+{
+	std::scoped_lock lock{activeThreadIdsMutex};
+	ids.insert(ids.end(), activeThreadIds.begin(), activeThreadIds.end());
 }
 
 void Thread_Wait(Thread* thread, int* status)
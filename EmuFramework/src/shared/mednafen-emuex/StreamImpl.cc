@@ -68,7 +68,8 @@ catch(std::system_error &err)
 }
 
 FileStream::FileStream(std::span<uint8_t> buff):
-	io{IG::MapIO{buff}} {}
+	io{IG::MapIO{buff}},
+	attribs{Stream::ATTRIBUTE_READABLE} {}
 
 FileStream::~FileStream() {}
 
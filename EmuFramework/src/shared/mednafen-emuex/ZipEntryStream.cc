@@ -0,0 +1,294 @@
+/*  This file is part of EmuFramework.
+
+	EmuFramework is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	EmuFramework is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include "ZipEntryStream.hh"
+#include <mednafen/mednafen.h>
+#include <imagine/util/ranges.hh>
+#include <imagine/logger/logger.h>
+#include <zlib.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace Mednafen
+{
+
+constexpr IG::SystemLogger log{"ZipEntryStream"};
+constexpr uint32 endOfCentralDirSig = 0x06054b50, centralDirHeaderSig = 0x02014b50, localHeaderSig = 0x04034b50;
+constexpr size_t endOfCentralDirSize = 22, centralDirHeaderSize = 46, localHeaderSize = 30;
+constexpr size_t maxZipCommentSize = 0xFFFF;
+constexpr size_t windowSize = 32768; // deflate's max back-reference distance
+constexpr size_t inputBufferSize = 16384;
+constexpr uint64 accessPointSpan = 1024 * 1024; // uncompressed bytes between access points
+
+static uint16 readLE16(const uint8 *p) { return p[0] | (p[1] << 8); }
+static uint32 readLE32(const uint8 *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | (uint32(p[3]) << 24); }
+
+std::vector<ZipEntry> readZipDirectory(IG::IO &io)
+{
+	size_t fileSize = io.size();
+	if(fileSize < endOfCentralDirSize)
+		return {};
+	// the end of central directory record is located before the trailing comment
+	size_t tailSize = std::min(fileSize, endOfCentralDirSize + maxZipCommentSize);
+	std::vector<uint8> tail(tailSize);
+	if(io.read(tail.data(), tailSize, fileSize - tailSize) != ssize_t(tailSize))
+		return {};
+	const uint8 *eocd{};
+	for(auto i = ssize_t(tailSize - endOfCentralDirSize); i >= 0; i--)
+	{
+		if(readLE32(&tail[i]) == endOfCentralDirSig)
+		{
+			eocd = &tail[i];
+			break;
+		}
+	}
+	if(!eocd)
+		return {};
+	uint16 entries = readLE16(eocd + 10);
+	uint32 dirSize = readLE32(eocd + 12);
+	uint32 dirOffset = readLE32(eocd + 16);
+	if(entries == 0xFFFF || dirOffset == 0xFFFFFFFF || uint64(dirOffset) + dirSize > fileSize)
+		return {};
+	std::vector<uint8> dir(dirSize);
+	if(io.read(dir.data(), dirSize, dirOffset) != ssize_t(dirSize))
+		return {};
+	std::vector<ZipEntry> zipEntries;
+	zipEntries.reserve(entries);
+	size_t offset{};
+	for([[maybe_unused]] auto i : IG::iotaCount(entries))
+	{
+		if(offset + centralDirHeaderSize > dirSize)
+			return {};
+		auto h = &dir[offset];
+		if(readLE32(h) != centralDirHeaderSig)
+			return {};
+		uint16 flags = readLE16(h + 8);
+		uint16 method = readLE16(h + 10);
+		uint32 compressedSize = readLE32(h + 20);
+		uint32 size = readLE32(h + 24);
+		uint16 nameSize = readLE16(h + 28);
+		size_t recordSize = centralDirHeaderSize + nameSize + readLE16(h + 30) + readLE16(h + 32);
+		uint32 headerOffset = readLE32(h + 42);
+		if(offset + recordSize > dirSize)
+			return {};
+		std::string name{reinterpret_cast<const char*>(h + centralDirHeaderSize), nameSize};
+		if((flags & 1) || (method != 0 && method != 8) ||
+			compressedSize == 0xFFFFFFFF || size == 0xFFFFFFFF || headerOffset == 0xFFFFFFFF)
+		{
+			log.info("entry:{} needs extraction (flags:{:X} method:{})", name, flags, method);
+			return {};
+		}
+		zipEntries.emplace_back(std::move(name), headerOffset, compressedSize, size, method == 8);
+		offset += recordSize;
+	}
+	return zipEntries;
+}
+
+struct AccessPoint
+{
+	uint64 out; // uncompressed offset
+	uint64 in; // compressed offset of the first full byte
+	int bits; // bits of the previous byte still to be decoded
+	std::unique_ptr<uint8[]> window; // the preceding windowSize uncompressed bytes
+};
+
+struct ZipEntryStream::Inflater
+{
+	z_stream strm{};
+	bool active{};
+	uint64 outPos{}; // uncompressed offset of the next inflated byte
+	uint64 inPos{}; // compressed offset of the next byte read from the archive
+	std::vector<AccessPoint> points;
+	std::array<uint8, windowSize> window; // circular buffer of the latest output
+	std::array<uint8, inputBufferSize> input;
+
+	~Inflater()
+	{
+		if(active)
+			inflateEnd(&strm);
+	}
+};
+
+ZipEntryStream::ZipEntryStream(std::shared_ptr<IG::IO> archiveIO, const ZipEntry &entry):
+	io{std::move(archiveIO)},
+	compressedSize{entry.compressedSize},
+	size_{entry.size}
+{
+	std::array<uint8, localHeaderSize> header;
+	if(io->read(header.data(), header.size(), entry.headerOffset) != ssize_t(header.size()) ||
+		readLE32(header.data()) != localHeaderSig)
+	{
+		throw MDFN_Error(0, "Error reading zip entry header:\n%s", entry.name.c_str());
+	}
+	dataOffset = entry.headerOffset + localHeaderSize + readLE16(&header[26]) + readLE16(&header[28]);
+	if(entry.isDeflated)
+		inflater = std::make_unique<Inflater>();
+}
+
+ZipEntryStream::~ZipEntryStream() = default;
+
+uint64 ZipEntryStream::attributes()
+{
+	// deflated entries don't report slow seeks since the access points bound them to
+	// inflating at most accessPointSpan bytes, which allows streaming CD images
+	return ATTRIBUTE_READABLE | ATTRIBUTE_SEEKABLE;
+}
+
+uint64 ZipEntryStream::read(void *data, uint64 count, bool error_on_eos)
+{
+	auto bytes = readData(static_cast<uint8*>(data), count, pos);
+	pos += bytes;
+	if(bytes != count && error_on_eos)
+		throw MDFN_Error(0, _("Unexpected EOF"));
+	return bytes;
+}
+
+uint64 ZipEntryStream::readAtPos(void *data, uint64 count, uint64 offset)
+{
+	return readData(static_cast<uint8*>(data), count, offset);
+}
+
+uint64 ZipEntryStream::readData(uint8 *data, uint64 count, uint64 offset)
+{
+	if(offset >= size_)
+		return 0;
+	count = std::min(count, size_ - offset);
+	if(inflater)
+		return inflateData(data, count, offset);
+	auto bytes = io->read(data, count, dataOffset + offset);
+	if(bytes == -1)
+		throw MDFN_Error(0, _("Error reading zip entry data"));
+	return bytes;
+}
+
+uint64 ZipEntryStream::inflateData(uint8 *data, uint64 count, uint64 offset)
+{
+	auto &s = *inflater;
+	auto nextPoint = std::ranges::upper_bound(s.points, offset, {}, &AccessPoint::out);
+	const AccessPoint *point = nextPoint == s.points.begin() ? nullptr : &*std::prev(nextPoint);
+	// restart from the closest access point when going back or if it skips some inflating
+	if(!s.active || offset < s.outPos || (point && point->out > s.outPos))
+	{
+		if(!s.active)
+		{
+			if(inflateInit2(&s.strm, -MAX_WBITS) != Z_OK)
+				throw MDFN_Error(0, _("Error initializing zlib"));
+			s.active = true;
+		}
+		else
+		{
+			inflateReset(&s.strm);
+		}
+		s.strm.avail_in = 0;
+		s.strm.next_out = s.window.data();
+		s.strm.avail_out = windowSize;
+		s.outPos = point ? point->out : 0;
+		s.inPos = point ? point->in : 0;
+		if(point)
+		{
+			if(point->bits)
+			{
+				uint8 byte;
+				if(io->read(&byte, 1, dataOffset + point->in - 1) != 1)
+					throw MDFN_Error(0, _("Error reading zip entry data"));
+				inflatePrime(&s.strm, point->bits, byte >> (8 - point->bits));
+			}
+			inflateSetDictionary(&s.strm, point->window.get(), windowSize);
+			memcpy(s.window.data(), point->window.get(), windowSize);
+		}
+	}
+	uint64 copied{};
+	while(copied < count)
+	{
+		if(!s.strm.avail_in)
+		{
+			auto bytes = io->read(s.input.data(), std::min(uint64(inputBufferSize), compressedSize - s.inPos), dataOffset + s.inPos);
+			if(bytes <= 0)
+				throw MDFN_Error(0, _("Error reading zip entry data"));
+			s.inPos += bytes;
+			s.strm.next_in = s.input.data();
+			s.strm.avail_in = bytes;
+		}
+		if(!s.strm.avail_out)
+		{
+			s.strm.next_out = s.window.data();
+			s.strm.avail_out = windowSize;
+		}
+		auto outStart = s.strm.next_out;
+		auto res = inflate(&s.strm, Z_BLOCK);
+		if(res == Z_NEED_DICT || res == Z_DATA_ERROR || res == Z_MEM_ERROR || res == Z_STREAM_ERROR)
+			throw MDFN_Error(0, _("Error decompressing zip entry data"));
+		uint64 outputStart = s.outPos;
+		s.outPos += s.strm.next_out - outStart;
+		if(auto readPos = offset + copied; s.outPos > readPos)
+		{
+			auto bytes = std::min(s.outPos - readPos, count - copied);
+			memcpy(data + copied, outStart + (readPos - outputStart), bytes);
+			copied += bytes;
+		}
+		if(res == Z_STREAM_END)
+			break;
+		// record an access point at the start of a new, non-final deflate block
+		bool atBlockStart = (s.strm.data_type & 128) && !(s.strm.data_type & 64);
+		if(atBlockStart && s.outPos >= (s.points.size() ? s.points.back().out : 0) + accessPointSpan)
+		{
+			auto window = std::make_unique<uint8[]>(windowSize);
+			size_t oldest = s.strm.next_out - s.window.data();
+			if(oldest == windowSize)
+				oldest = 0;
+			memcpy(window.get(), s.window.data() + oldest, windowSize - oldest);
+			memcpy(window.get() + windowSize - oldest, s.window.data(), oldest);
+			s.points.emplace_back(s.outPos, s.inPos - s.strm.avail_in, s.strm.data_type & 7, std::move(window));
+		}
+	}
+	return copied;
+}
+
+void ZipEntryStream::write(const void *data, uint64 count)
+{
+	throw MDFN_Error(0, _("Zip entries are read-only"));
+}
+
+void ZipEntryStream::truncate(uint64 length)
+{
+	throw MDFN_Error(0, _("Zip entries are read-only"));
+}
+
+void ZipEntryStream::seek(int64 offset, int whence)
+{
+	int64 newPos = offset;
+	if(whence == SEEK_CUR)
+		newPos += pos;
+	else if(whence == SEEK_END)
+		newPos += size_;
+	if(newPos < 0)
+		throw MDFN_Error(EINVAL, _("Attempted to seek before start of stream"));
+	pos = newPos;
+}
+
+uint64 ZipEntryStream::tell() { return pos; }
+
+uint64 ZipEntryStream::size() { return size_; }
+
+void ZipEntryStream::flush() {}
+
+void ZipEntryStream::close()
+{
+	inflater.reset();
+	io.reset();
+}
+
+}
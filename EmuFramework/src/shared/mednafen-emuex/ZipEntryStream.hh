@@ -0,0 +1,75 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	EmuFramework is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	EmuFramework is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <mednafen/types.h>
+#include <mednafen/Stream.h>
+#include <imagine/io/IO.hh>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Mednafen
+{
+
+struct ZipEntry
+{
+	std::string name;
+	uint64 headerOffset{};
+	uint64 compressedSize{};
+	uint64 size{};
+	bool isDeflated{};
+};
+
+// Returns the entries of a zip archive from its central directory, or an empty list if the
+// archive isn't a zip or has entries that can't be read directly (encryption, zip64, methods
+// other than store or deflate), in which case it should be extracted with libarchive instead
+std::vector<ZipEntry> readZipDirectory(IG::IO &);
+
+// Random-access reads of a zip entry without extracting it. Stored data is read in place, while
+// deflated data records an access point with the inflate state every so often as it's decompressed,
+// so later seeks only have to inflate from the closest point instead of the start of the entry.
+class ZipEntryStream final : public Stream
+{
+public:
+	ZipEntryStream(std::shared_ptr<IG::IO> archiveIO, const ZipEntry &);
+	~ZipEntryStream() final;
+	uint64 attributes() final;
+	uint64 read(void *data, uint64 count, bool error_on_eos = true) final;
+	uint64 readAtPos(void *data, uint64 count, uint64 pos) final;
+	void write(const void *data, uint64 count) final;
+	void truncate(uint64 length) final;
+	void seek(int64 offset, int whence) final;
+	uint64 tell() final;
+	uint64 size() final;
+	void flush() final;
+	void close() final;
+
+private:
+	struct Inflater;
+
+	std::shared_ptr<IG::IO> io;
+	std::unique_ptr<Inflater> inflater;
+	uint64 dataOffset{};
+	uint64 compressedSize{};
+	uint64 size_{};
+	uint64 pos{};
+
+	uint64 readData(uint8 *data, uint64 count, uint64 offset);
+	uint64 inflateData(uint8 *data, uint64 count, uint64 offset);
+};
+
+}
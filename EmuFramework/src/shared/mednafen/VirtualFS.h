@@ -114,6 +114,10 @@ class VirtualFS
  virtual void readdirentries(const std::string& path, std::function<bool(const std::string&)> callb) = 0;
 
  virtual std::string get_human_path(const std::string& path) = 0;
+
+ // Returns true if opened streams stay valid after this object is destroyed and can be read
+ // from a thread other than the one that opened them.
+ virtual bool has_independent_streams(void) { return false; }
  //
  //
  //
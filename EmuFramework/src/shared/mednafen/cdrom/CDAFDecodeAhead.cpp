@@ -0,0 +1,160 @@
+/******************************************************************************/
+/* Mednafen - Multi-system Emulator                                           */
+/******************************************************************************/
+/* CDAFDecodeAhead.cpp:
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software Foundation, Inc.,
+** 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include <mednafen/mednafen.h>
+#include "CDAFDecodeAhead.h"
+#include <algorithm>
+
+namespace Mednafen
+{
+
+CDAFDecodeAhead::CDAFDecodeAhead() : Ring(new int16[RingFrames * 2])
+{
+ RingMutex = MThreading::Mutex_Create();
+ DataCond = MThreading::Cond_Create();
+ SpaceCond = MThreading::Cond_Create();
+ DecodeThread = MThreading::Thread_Create(ThreadEntry, this, "MDFN CD Audio Decode");
+}
+
+CDAFDecodeAhead::~CDAFDecodeAhead()
+{
+ MThreading::Mutex_Lock(RingMutex);
+ Running = false;
+ MThreading::Cond_Signal(SpaceCond);
+ MThreading::Mutex_Unlock(RingMutex);
+ MThreading::Thread_Wait(DecodeThread, NULL);
+
+ MThreading::Cond_Destroy(SpaceCond);
+ MThreading::Cond_Destroy(DataCond);
+ MThreading::Mutex_Destroy(RingMutex);
+
+ MDFN_printf("CD audio decode-ahead hits:%llu misses:%llu\n", (unsigned long long)HitCount, (unsigned long long)MissCount);
+}
+
+uint64 CDAFDecodeAhead::Read(CDAFReader* reader, uint64 frame_offset, int16* buffer, uint64 frames)
+{
+ MThreading::Mutex_Lock(RingMutex);
+
+ if(reader != Reader || frame_offset < RingStart || frame_offset > (RingStart + RingFill))
+ {
+  Reader = reader;
+  RingStart = frame_offset;
+  RingFill = 0;
+  DecodeEnd = false;
+  Generation++;
+  MThreading::Cond_Signal(SpaceCond);
+ }
+ else
+ {
+  RingFill -= frame_offset - RingStart;
+  RingStart = frame_offset;
+ }
+
+ if(RingFill >= frames || DecodeEnd)
+  HitCount++;
+ else
+  MissCount++;
+
+ while(RingFill < frames && !DecodeEnd)
+  MThreading::Cond_Wait(DataCond, RingMutex);
+
+ const uint64 ret = std::min(frames, RingFill);
+
+ for(uint64 copied = 0; copied < ret;)
+ {
+  const uint64 idx = (RingStart + copied) % RingFrames;
+  const uint64 count = std::min(ret - copied, RingFrames - idx);
+
+  memcpy(buffer + copied * 2, &Ring[idx * 2], count * 2 * sizeof(int16));
+  copied += count;
+ }
+
+ RingStart += ret;
+ RingFill -= ret;
+ MThreading::Cond_Signal(SpaceCond);
+ MThreading::Mutex_Unlock(RingMutex);
+
+ return ret;
+}
+
+int CDAFDecodeAhead::ThreadEntry(void* data)
+{
+ return ((CDAFDecodeAhead*)data)->ThreadMain();
+}
+
+int CDAFDecodeAhead::ThreadMain(void)
+{
+ std::unique_ptr<int16[]> chunk(new int16[DecodeChunkFrames * 2]);
+
+ MThreading::Mutex_Lock(RingMutex);
+
+ while(Running)
+ {
+  if(!Reader || DecodeEnd || (RingFill + DecodeChunkFrames) > RingFrames)
+  {
+   MThreading::Cond_Wait(SpaceCond, RingMutex);
+   continue;
+  }
+
+  CDAFReader* reader = Reader;
+  const uint64 gen = Generation;
+  const uint64 pos = RingStart + RingFill;
+  uint64 frames_read = 0;
+
+  MThreading::Mutex_Unlock(RingMutex);
+
+  try
+  {
+   frames_read = std::min<uint64>(reader->Read(pos, chunk.get(), DecodeChunkFrames), DecodeChunkFrames);
+  }
+  catch(std::exception& e)
+  {
+   MDFN_printf("Error decoding CD audio frame %llu: %s\n", (unsigned long long)pos, e.what());
+  }
+
+  MThreading::Mutex_Lock(RingMutex);
+
+  // frames decoded before a seek or track change are dropped
+  if(gen != Generation)
+   continue;
+
+  for(uint64 copied = 0; copied < frames_read;)
+  {
+   const uint64 idx = (pos + copied) % RingFrames;
+   const uint64 count = std::min(frames_read - copied, RingFrames - idx);
+
+   memcpy(&Ring[idx * 2], chunk.get() + copied * 2, count * 2 * sizeof(int16));
+   copied += count;
+  }
+
+  RingFill += frames_read;
+
+  if(frames_read < DecodeChunkFrames)
+   DecodeEnd = true;
+
+  MThreading::Cond_Signal(DataCond);
+ }
+
+ MThreading::Mutex_Unlock(RingMutex);
+
+ return 0;
+}
+
+}
@@ -0,0 +1,71 @@
+/******************************************************************************/
+/* Mednafen - Multi-system Emulator                                           */
+/******************************************************************************/
+/* CDAFDecodeAhead.h:
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software Foundation, Inc.,
+** 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef __MDFN_CDAFDECODEAHEAD_H
+#define __MDFN_CDAFDECODEAHEAD_H
+
+#include <mednafen/MThreading.h>
+#include "CDAFReader.h"
+#include <memory>
+
+namespace Mednafen
+{
+
+// Decodes audio track frames on a worker thread ahead of the current read position, keeping
+// about one second buffered for the track being played. Reading a different track or
+// jumping outside the buffered frames discards them and restarts decoding at the new position.
+// Once used with a CDAFReader, the reader must only be accessed through this object.
+class CDAFDecodeAhead
+{
+ public:
+ CDAFDecodeAhead();
+ ~CDAFDecodeAhead();
+
+ uint64 Read(CDAFReader* reader, uint64 frame_offset, int16* buffer, uint64 frames);
+
+ // reads served from buffered frames vs. ones that had to wait for decoding,
+ // only valid while no Read() is in progress
+ uint64 Hits(void) const { return HitCount; }
+ uint64 Misses(void) const { return MissCount; }
+
+ private:
+ enum : uint64 { RingFrames = 44100, DecodeChunkFrames = 588 * 4 };
+
+ static int ThreadEntry(void* data);
+ int ThreadMain(void);
+
+ std::unique_ptr<int16[]> Ring; // interleaved stereo frames, indexed by frame offset modulo RingFrames
+ CDAFReader* Reader = nullptr;
+ uint64 RingStart = 0; // frame offset of the next frame to be read
+ uint64 RingFill = 0; // frames decoded after RingStart
+ uint64 Generation = 0; // incremented when buffered frames are discarded
+ bool DecodeEnd = false; // the reader returned fewer frames than requested
+ bool Running = true;
+ uint64 HitCount = 0;
+ uint64 MissCount = 0;
+
+ MThreading::Thread* DecodeThread = nullptr;
+ MThreading::Mutex* RingMutex = nullptr;
+ MThreading::Cond* DataCond = nullptr; // signaled when frames are decoded
+ MThreading::Cond* SpaceCond = nullptr; // signaled when frames are consumed or discarded
+};
+
+}
+#endif
@@ -23,6 +23,7 @@
 #include <mednafen/general.h>
 
 #include <stdio.h>
+#include <algorithm>
 
 #include "CDAccess_CHD.h"
 
@@ -83,7 +84,9 @@ void CDAccess_CHD::Load(VirtualFS* vfs, const std::string &path, bool image_memc
 
   /* allocate storage for sector reads */
   const chd_header *head = chd_get_header(chd);
-  hunkmem = (uint8_t *)malloc(head->hunkbytes);
+  hunkmem = (uint8_t *)malloc(head->hunkbytes * HunkCacheSize);
+  for (int i = 0; i < HunkCacheSize; i++)
+    HunkCache[i].data = hunkmem + head->hunkbytes * i;
   oldhunk = -1;
 
   MDFN_printf("chd_load '%s' hunkbytes=%d\n", path.c_str(), head->hunkbytes);
@@ -209,10 +212,35 @@ void CDAccess_CHD::Load(VirtualFS* vfs, const std::string &path, bool image_memc
       assert(Tracks[x].index[i] >= 0);
     }
   }
+
+  CacheMutex = MThreading::Mutex_Create();
+  CHDMutex = MThreading::Mutex_Create();
+  HunkDecodedCond = MThreading::Cond_Create();
+  ReadAheadCond = MThreading::Cond_Create();
+  ReadAheadRunning = true;
+  ReadAheadThread = MThreading::Thread_Create(ReadAheadThreadEntry, this, "MDFN CHD Read-Ahead");
 }
 
 CDAccess_CHD::~CDAccess_CHD()
 {
+  if (ReadAheadThread)
+  {
+    MThreading::Mutex_Lock(CacheMutex);
+    ReadAheadRunning = false;
+    MThreading::Cond_Signal(ReadAheadCond);
+    MThreading::Mutex_Unlock(CacheMutex);
+    MThreading::Thread_Wait(ReadAheadThread, NULL);
+  }
+
+  if (ReadAheadCond)
+    MThreading::Cond_Destroy(ReadAheadCond);
+  if (HunkDecodedCond)
+    MThreading::Cond_Destroy(HunkDecodedCond);
+  if (CHDMutex)
+    MThreading::Mutex_Destroy(CHDMutex);
+  if (CacheMutex)
+    MThreading::Mutex_Destroy(CacheMutex);
+
   if (chd != NULL)
     chd_close(chd);
 
@@ -220,6 +248,108 @@ CDAccess_CHD::~CDAccess_CHD()
     free(hunkmem);
 }
 
+CDAccess_CHD::HunkSlot *CDAccess_CHD::FindHunk(int hunknum)
+{
+  for (auto &slot : HunkCache)
+  {
+    if (slot.hunknum == hunknum)
+      return &slot;
+  }
+  return nullptr;
+}
+
+CDAccess_CHD::HunkSlot *CDAccess_CHD::ClaimSlot(int hunknum)
+{
+  // at most two slots are decoding at once so there's always one to evict
+  HunkSlot *lru = nullptr;
+  for (auto &slot : HunkCache)
+  {
+    if (!slot.decoding && (!lru || slot.lastUse < lru->lastUse))
+      lru = &slot;
+  }
+  lru->hunknum = hunknum;
+  lru->decoding = true;
+  lru->lastUse = ++HunkUseCounter;
+  return lru;
+}
+
+// Called with CacheMutex locked, which is released while decompressing
+bool CDAccess_CHD::DecodeHunk(HunkSlot &slot)
+{
+  const int hunknum = slot.hunknum;
+  MThreading::Mutex_Unlock(CacheMutex);
+  MThreading::Mutex_Lock(CHDMutex);
+  chd_error err = chd_read(chd, hunknum, slot.data);
+  MThreading::Mutex_Unlock(CHDMutex);
+  MThreading::Mutex_Lock(CacheMutex);
+  slot.decoding = false;
+  if (err != CHDERR_NONE)
+  {
+    MDFN_printf("chd_read failed hunk=%d error=%d\n", hunknum, err);
+    slot.hunknum = -1;
+    slot.lastUse = 0;
+  }
+  MThreading::Cond_Signal(HunkDecodedCond);
+  return err == CHDERR_NONE;
+}
+
+const uint8_t *CDAccess_CHD::LockHunk(int hunknum)
+{
+  MThreading::Mutex_Lock(CacheMutex);
+  HunkSlot *slot;
+  while (!(slot = FindHunk(hunknum)) || slot->decoding)
+  {
+    if (slot)
+    {
+      // the read-ahead thread is already decoding it
+      MThreading::Cond_Wait(HunkDecodedCond, CacheMutex);
+    }
+    else if (!DecodeHunk(*ClaimSlot(hunknum)))
+    {
+      MThreading::Mutex_Unlock(CacheMutex);
+      return nullptr;
+    }
+  }
+  slot->lastUse = ++HunkUseCounter;
+  /* each hunk holds ~8 sectors, queue the following ones when moving to a new hunk */
+  if (hunknum != oldhunk)
+  {
+    oldhunk = hunknum;
+    ReadAheadNext = hunknum + 1;
+    ReadAheadEnd = std::min<int>(hunknum + 1 + ReadAheadHunks, chd_get_header(chd)->totalhunks);
+    MThreading::Cond_Signal(ReadAheadCond);
+  }
+  return slot->data;
+}
+
+void CDAccess_CHD::UnlockHunk(void)
+{
+  MThreading::Mutex_Unlock(CacheMutex);
+}
+
+int CDAccess_CHD::ReadAheadThreadEntry(void *data)
+{
+  return ((CDAccess_CHD*)data)->ReadAheadThreadMain();
+}
+
+int CDAccess_CHD::ReadAheadThreadMain(void)
+{
+  MThreading::Mutex_Lock(CacheMutex);
+  while (ReadAheadRunning)
+  {
+    if (ReadAheadNext >= ReadAheadEnd)
+    {
+      MThreading::Cond_Wait(ReadAheadCond, CacheMutex);
+      continue;
+    }
+    const int hunknum = ReadAheadNext++;
+    if (!FindHunk(hunknum))
+      DecodeHunk(*ClaimSlot(hunknum));
+  }
+  MThreading::Mutex_Unlock(CacheMutex);
+  return 0;
+}
+
 bool CDAccess_CHD::Read_CHD_Hunk_RAW(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
 {
   const chd_header *head = chd_get_header(chd);
@@ -227,21 +357,18 @@ bool CDAccess_CHD::Read_CHD_Hunk_RAW(uint8_t *buf, int32_t lba, CHDFILE_TRACK_IN
   int sph = head->hunkbytes / (2352 + 96);
   int hunknum = cad / sph; //(cad * head->unitbytes) / head->hunkbytes;
   int hunkofs = cad % sph; //(cad * head->unitbytes) % head->hunkbytes;
-  int err = CHDERR_NONE;
+  const uint8_t *hunk = LockHunk(hunknum);
 
-  /* each hunk holds ~8 sectors, optimize when reading contiguous sectors */
-  if (hunknum != oldhunk)
+  if (!hunk)
   {
-    err = chd_read(chd, hunknum, hunkmem);
-    if (err != CHDERR_NONE)
-    	MDFN_printf("chd_read_sector failed lba=%d error=%d\n", lba, err);
-    else
-      oldhunk = hunknum;
+    MDFN_printf("chd_read_sector failed lba=%d\n", lba);
+    return true;
   }
 
-  memcpy(buf, hunkmem + hunkofs * (2352 + 96), 2352);
+  memcpy(buf, hunk + hunkofs * (2352 + 96), 2352);
+  UnlockHunk();
 
-  return err;
+  return false;
 }
 
 bool CDAccess_CHD::Read_CHD_Hunk_M1(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
@@ -251,21 +378,18 @@ bool CDAccess_CHD::Read_CHD_Hunk_M1(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INF
   int sph = head->hunkbytes / (2352 + 96);
   int hunknum = cad / sph; //(cad * head->unitbytes) / head->hunkbytes;
   int hunkofs = cad % sph; //(cad * head->unitbytes) % head->hunkbytes;
-  int err = CHDERR_NONE;
+  const uint8_t *hunk = LockHunk(hunknum);
 
-  /* each hunk holds ~8 sectors, optimize when reading contiguous sectors */
-  if (hunknum != oldhunk)
+  if (!hunk)
   {
-    err = chd_read(chd, hunknum, hunkmem);
-    if (err != CHDERR_NONE)
-    	MDFN_printf("chd_read_sector failed lba=%d error=%d\n", lba, err);
-    else
-      oldhunk = hunknum;
+    MDFN_printf("chd_read_sector failed lba=%d\n", lba);
+    return true;
   }
 
-  memcpy(buf + 16, hunkmem + hunkofs * (2352 + 96), 2048);
+  memcpy(buf + 16, hunk + hunkofs * (2352 + 96), 2048);
+  UnlockHunk();
 
-  return err;
+  return false;
 }
 
 bool CDAccess_CHD::Read_CHD_Hunk_M2(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
@@ -275,21 +399,18 @@ bool CDAccess_CHD::Read_CHD_Hunk_M2(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INF
   int sph = head->hunkbytes / (2352 + 96);
   int hunknum = cad / sph; //(cad * head->unitbytes) / head->hunkbytes;
   int hunkofs = cad % sph; //(cad * head->unitbytes) % head->hunkbytes;
-  int err = CHDERR_NONE;
+  const uint8_t *hunk = LockHunk(hunknum);
 
-  /* each hunk holds ~8 sectors, optimize when reading contiguous sectors */
-  if (hunknum != oldhunk)
+  if (!hunk)
   {
-    err = chd_read(chd, hunknum, hunkmem);
-    if (err != CHDERR_NONE)
-    	MDFN_printf("chd_read_sector failed lba=%d error=%d\n", lba, err);
-    else
-      oldhunk = hunknum;
+    MDFN_printf("chd_read_sector failed lba=%d\n", lba);
+    return true;
   }
 
-  memcpy(buf + 16, hunkmem + hunkofs * (2352 + 96), 2336);
+  memcpy(buf + 16, hunk + hunkofs * (2352 + 96), 2336);
+  UnlockHunk();
 
-  return err;
+  return false;
 }
 
 int CDAccess_CHD::Read_Raw_Sector(uint8 *buf, int32 lba)
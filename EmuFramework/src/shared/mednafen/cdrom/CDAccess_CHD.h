@@ -23,6 +23,7 @@
 #include <mednafen/MemoryStream.h>
 
 #include "CDAccess.h"
+#include <mednafen/MThreading.h>
 #include <libchdr/chd.h>
 
 namespace Mednafen
@@ -97,10 +98,43 @@ class CDAccess_CHD final : public CDAccess
   int num_tracks;
 
   chd_file *chd;
-  /* hunk data cache */
-  uint8_t *hunkmem;
+
+  // LRU cache of decoded hunks, filled in ahead of sequential reads by a worker thread
+  // so decompression is usually done by the time the emulated drive gets to a hunk
+  enum { HunkCacheSize = 16, ReadAheadHunks = 2 };
+
+  struct HunkSlot
+  {
+   int hunknum = -1;
+   bool decoding = false;
+   uint64 lastUse = 0;
+   uint8_t *data = nullptr;
+  };
+
+  // Returns the hunk's data with CacheMutex locked until UnlockHunk(), or nullptr on error
+  const uint8_t *LockHunk(int hunknum);
+  void UnlockHunk(void);
+  HunkSlot *FindHunk(int hunknum);
+  HunkSlot *ClaimSlot(int hunknum);
+  bool DecodeHunk(HunkSlot &slot);
+  static int ReadAheadThreadEntry(void *data);
+  int ReadAheadThreadMain(void);
+
+  HunkSlot HunkCache[HunkCacheSize];
+  /* backing memory of all hunk slots */
+  uint8_t *hunkmem = nullptr;
+  uint64 HunkUseCounter = 0;
   /* last hunknum read */
-  int oldhunk;
+  int oldhunk = -1;
+  /* hunks queued for the read-ahead thread */
+  int ReadAheadNext = 0;
+  int ReadAheadEnd = 0;
+  bool ReadAheadRunning = false;
+  MThreading::Thread *ReadAheadThread = nullptr;
+  MThreading::Mutex *CacheMutex = nullptr; /* guards HunkCache and the read-ahead queue */
+  MThreading::Mutex *CHDMutex = nullptr; /* guards chd_read() */
+  MThreading::Cond *HunkDecodedCond = nullptr;
+  MThreading::Cond *ReadAheadCond = nullptr;
 };
 
 }
@@ -42,6 +42,7 @@
 #include "CDAccess_Image.h"
 
 #include "CDAFReader.h"
+#include "CDAFDecodeAhead.h"
 #include <imagine/util/string.h>
 
 #include <map>
@@ -947,6 +948,8 @@ void CDAccess_Image::ImageOpen(VirtualFS* vfs, const std::string& path, bool ima
 
 void CDAccess_Image::Cleanup(void)
 {
+ AudioDecodeAhead.reset();
+
  for(int32 track = 0; track < 100; track++)
  {
   CDRFILE_TRACK_INFO *this_track = &Tracks[track];
@@ -1079,7 +1082,10 @@ int CDAccess_Image::Read_Raw_Sector(uint8 *buf, int32 lba)
    if(ct->AReader)
    {
     int16 AudioBuf[588 * 2];
-    uint64 frames_read = ct->AReader->Read((ct->FileOffset / 4) + (lba - ct->LBA) * 588, AudioBuf, 588);
+    if(!AudioDecodeAhead)
+     AudioDecodeAhead = std::make_unique<CDAFDecodeAhead>();
+
+    uint64 frames_read = AudioDecodeAhead->Read(ct->AReader, (ct->FileOffset / 4) + (lba - ct->LBA) * 588, AudioBuf, 588);
 
     ct->LastSamplePos += frames_read;
 
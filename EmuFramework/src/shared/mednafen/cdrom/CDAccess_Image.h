@@ -2,12 +2,14 @@
 #define __MDFN_CDACCESS_IMAGE_H
 
 #include <map>
+#include <memory>
 
 namespace Mednafen
 {
 
 class Stream;
 class CDAFReader;
+class CDAFDecodeAhead;
 
 struct CDRFILE_TRACK_INFO
 {
@@ -93,6 +95,9 @@ class CDAccess_Image final: public CDAccess
 
  std::string base_dir;
 
+ // created on the first audio track read, must be destroyed before the track readers
+ std::unique_ptr<CDAFDecodeAhead> AudioDecodeAhead;
+
  void ImageOpen(VirtualFS* vfs, const std::string& path, bool image_memcache);
  void ImageOpenBinary(VirtualFS* vfs, const std::string& path, bool isIso);
  void LoadSBI(VirtualFS* vfs, const std::string& sbi_path);
@@ -233,10 +233,9 @@ CDInterface* CDInterface::Open(VirtualFS* vfs, const std::string& path, bool ima
  // Don't allow a custom VirtualFS implementation unless CD image memory caching is enabled, due to thread
  // safety and vfs object persistence/lifetime issues.
  //
- // TODO: Maybe add is_nonpersistent() and is_mtsafe() sort of functions to VirtualFS instead?
  // TODO: More general error message when 'vfs' isn't an object of a class derived from ArchiveReader.
  //
- if(vfs != &NVFS && !image_memcache)
+ if(vfs != &NVFS && !image_memcache && !vfs->has_independent_streams())
   throw MDFN_Error(0, _("CD image memory caching must be enabled to allow loading a CD image from an archive."));
  //
  //
@@ -46,6 +46,8 @@
 #if defined(__SSE2__)
 #include <xmmintrin.h>
 #include <emmintrin.h>
+#elif defined(HAVE_NEON_INTRINSICS)
+#include <arm_neon.h>
 #endif
 
 namespace Mednafen
@@ -2649,6 +2651,9 @@ static INLINE void RunCDDA(uint32 system_timestamp, int32 run_time)
 #if defined(__SSE2__)
     __m128i f0 = _mm_load_si128((__m128i *)&f[0]);
     __m128i f1 = _mm_load_si128((__m128i *)&f[8]);
+#elif defined(HAVE_NEON_INTRINSICS)
+    int16x8_t f0 = vld1q_s16(&f[0]);
+    int16x8_t f1 = vld1q_s16(&f[8]);
 #endif
       
     for(unsigned lr = 0; lr < 2; lr++)
@@ -2676,6 +2681,22 @@ static INLINE void RunCDDA(uint32 system_timestamp, int32 run_time)
       _mm_store_ss(&accum_f, (__m128)sum);
       //_mm_store_si128(&accum_m128, sum);
      }
+#elif defined(HAVE_NEON_INTRINSICS)
+     int32 accum;
+
+     {
+      int16x8_t b0 = vld1q_s16(&b[0]);
+      int16x8_t b1 = vld1q_s16(&b[8]);
+      int32x4_t sum;
+      int32x2_t sum2;
+
+      sum = vmull_s16(vget_low_s16(f0), vget_low_s16(b0));
+      sum = vmlal_s16(sum, vget_high_s16(f0), vget_high_s16(b0));
+      sum = vmlal_s16(sum, vget_low_s16(f1), vget_low_s16(b1));
+      sum = vmlal_s16(sum, vget_high_s16(f1), vget_high_s16(b1));
+      sum2 = vadd_s32(vget_low_s32(sum), vget_high_s32(sum));
+      accum = vget_lane_s32(vpadd_s32(sum2, sum2), 0);
+     }
 #else
      int32 accum = 0;
 
@@ -18,8 +18,10 @@
 namespace EmuEx
 {
 class EmuVideo;
+class EmuVideoImage;
 class EmuAudio;
 class EmuSystem;
+class DirtyLineTracker;
 }
 
 namespace Mednafen
@@ -415,9 +417,18 @@ struct EmulateSpecStruct
 	// Calls MDFND_commitVideoFrame upon drawing a frame if non-null. Set by the driver code.
 	EmuEx::EmuVideo *video{};
 
+	// Locked video image that surface may point into, ended on commit instead of copying if non-null. Set by the driver code.
+	EmuEx::EmuVideoImage *videoImage{};
+
+	// Lines changed since the last drawn frame, used to limit the video upload if non-null. Set by the emulation code.
+	EmuEx::DirtyLineTracker *lineTracker{};
+
 	// Used in MDFN_MidSync to update audio
 	EmuEx::EmuAudio *audio{};
 
+	// Buffer SoundBuf points to when it can't point straight into the audio output. Set by the driver code.
+	int16 *SoundBufFallback{};
+
 	//
 	// If sound is disabled, the driver code must set SoundRate to false, SoundBuf to NULL, SoundBufMaxSize to 0.
 
@@ -68,6 +68,10 @@
 #define _USE_SSE2
 #endif
 
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define _USE_NEON
+#endif
+
 #ifdef EXPORT
  #undef EXPORT
 #endif
@@ -126,6 +130,10 @@ static void speex_free (void *ptr) {free(ptr);}
 #include "resample_sse.h"
 #endif
 
+#ifdef _USE_NEON
+#include "resample_neon.h"
+#endif
+
 /* Numer of elements to allocate on the stack */
 #ifdef VAR_ARRAYS
 #define FIXED_STACK_ALLOC 8192
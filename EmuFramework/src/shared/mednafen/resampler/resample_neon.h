@@ -0,0 +1,97 @@
+/**
+   @file resample_neon.h
+   @brief Resampler functions (NEON version)
+*/
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+   
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   
+   - Neither the name of the Xiph.org Foundation nor the names of its
+   contributors may be used to endorse or promote products derived from
+   this software without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE FOUNDATION OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+
+/* Begin Mednafen modifications */
+
+#include <arm_neon.h>
+
+/* Filter lengths are only guaranteed to be multiples of 4 when down-sampling */
+#define OVERRIDE_INNER_PRODUCT_SINGLE
+static inline float inner_product_single(const float *a, const float *b, unsigned int len)
+{
+   unsigned int i;
+   float32x4_t sum = vdupq_n_f32(0);
+   for (i=0;i<len;i+=4)
+   {
+      sum = vmlaq_f32(sum, vld1q_f32(a+i), vld1q_f32(b+i));
+   }
+   float32x2_t s = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+   return vget_lane_f32(vpadd_f32(s, s), 0);
+}
+
+#define OVERRIDE_INTERPOLATE_PRODUCT_SINGLE
+static inline float interpolate_product_single(const float *a, const float *b, unsigned int len, const spx_uint32_t oversample, float *frac) {
+  unsigned int i;
+  float32x4_t sum = vdupq_n_f32(0);
+  for(i=0;i<len;i++)
+  {
+    sum = vmlaq_n_f32(sum, vld1q_f32(b+i*oversample), a[i]);
+  }
+  sum = vmulq_f32(sum, vld1q_f32(frac));
+  float32x2_t s = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+  return vget_lane_f32(vpadd_f32(s, s), 0);
+}
+
+#ifdef __aarch64__
+#define OVERRIDE_INNER_PRODUCT_DOUBLE
+static inline double inner_product_double(const float *a, const float *b, unsigned int len)
+{
+   unsigned int i;
+   float64x2_t sum1 = vdupq_n_f64(0);
+   float64x2_t sum2 = vdupq_n_f64(0);
+   for (i=0;i<len;i+=4)
+   {
+      float32x4_t t = vmulq_f32(vld1q_f32(a+i), vld1q_f32(b+i));
+      sum1 = vaddq_f64(sum1, vcvt_f64_f32(vget_low_f32(t)));
+      sum2 = vaddq_f64(sum2, vcvt_high_f64_f32(t));
+   }
+   return vaddvq_f64(vaddq_f64(sum1, sum2));
+}
+
+#define OVERRIDE_INTERPOLATE_PRODUCT_DOUBLE
+static inline double interpolate_product_double(const float *a, const float *b, unsigned int len, const spx_uint32_t oversample, float *frac) {
+  unsigned int i;
+  float64x2_t sum1 = vdupq_n_f64(0);
+  float64x2_t sum2 = vdupq_n_f64(0);
+  float32x4_t f = vld1q_f32(frac);
+  for(i=0;i<len;i++)
+  {
+    float32x4_t t = vmulq_n_f32(vld1q_f32(b+i*oversample), a[i]);
+    sum1 = vaddq_f64(sum1, vcvt_f64_f32(vget_low_f32(t)));
+    sum2 = vaddq_f64(sum2, vcvt_high_f64_f32(t));
+  }
+  sum1 = vmulq_f64(sum1, vcvt_f64_f32(vget_low_f32(f)));
+  sum2 = vmulq_f64(sum2, vcvt_high_f64_f32(f));
+  return vaddvq_f64(vaddq_f64(sum1, sum2));
+}
+#endif
+
+/* End Mednafen modifications */
@@ -114,6 +114,7 @@ static void updateTexture(const EmuApp &app, VControllerElement &e, Gfx::Rendere
 
 void VController::updateTextures()
 {
+	batchedGroups.clear();
 	for(auto &e : gpElements) { updateTexture(app(), e, renderer().mainTask, fanQuadIdxs); }
 	for(auto &e : uiElements) { updateTexture(app(), e, renderer().mainTask, fanQuadIdxs); }
 }
@@ -378,16 +379,19 @@ void VController::draw(Gfx::RendererCommands &__restrict__ cmds, bool showHidden
 			return !((e.buttonGroup() && gamepadDisabledFlags.buttons) ||
 				(e.dPad() && gamepadDisabledFlags.dpad));
 		};
-		auto activeElements = gpElements | std::views::filter(elementIsEnabled);
-		if(!activeElements.empty())
+		auto activeDPads = gpElements | std::views::filter([&](const VControllerElement &e)
+			{ return e.dPad() && elementIsEnabled(e); });
+		updateButtonBatch(showHidden);
+		for(const auto &e : activeDPads) { e.drawBounds(cmds, showHidden); }
+		if(btnBatchBounds)
 		{
-			for(const auto &e : activeElements) { e.drawBounds(cmds, showHidden); }
-			cmds.basicEffect().enableTexture(cmds, gamepadTex);
-			for(const auto &e : activeElements)
-			{
-				e.drawButtons(cmds, showHidden);
-			}
+			cmds.basicEffect().disableTexture(cmds);
+			cmds.drawQuads<uint16_t>(btnBatchBoundQuads, 0, btnBatchBounds);
 		}
+		cmds.basicEffect().enableTexture(cmds, gamepadTex);
+		for(const auto &e : activeDPads) { e.drawButtons(cmds, showHidden); }
+		if(btnBatchSprites)
+			cmds.drawQuads<uint16_t>(btnBatchQuads, 0, btnBatchSprites);
 	}
 	if(uiElements.size())
 	{
@@ -399,6 +403,61 @@ void VController::draw(Gfx::RendererCommands &__restrict__ cmds, bool showHidden
 	}
 }
 
+void VController::updateButtonBatch(bool showHidden)
+{
+	// group sprites are only copied into the batch when a group's layout, enabled buttons,
+	// or sprites (alpha, highlighting) changed since the last frame
+	bool needsUpdate = false;
+	size_t groupCount{};
+	for(auto &e : gpElements)
+	{
+		auto grpPtr = e.buttonGroup();
+		if(!grpPtr || gamepadDisabledFlags.buttons || !VControllerElement::shouldDraw(e.state, showHidden))
+			continue;
+		BatchedButtonGroup batched{grpPtr, grpPtr->enabledButtons(), grpPtr->showsBounds()};
+		if(grpPtr->spritesChanged || groupCount >= batchedGroups.size() || batchedGroups[groupCount] != batched)
+			needsUpdate = true;
+		groupCount++;
+	}
+	if(!needsUpdate && groupCount == batchedGroups.size())
+		return;
+	batchedGroups.clear();
+	btnBatchSprites = btnBatchBounds = 0;
+	for(auto &e : gpElements)
+	{
+		auto grpPtr = e.buttonGroup();
+		if(!grpPtr || gamepadDisabledFlags.buttons || !VControllerElement::shouldDraw(e.state, showHidden))
+			continue;
+		grpPtr->spritesChanged = false;
+		batchedGroups.emplace_back(grpPtr, grpPtr->enabledButtons(), grpPtr->showsBounds());
+		btnBatchSprites += grpPtr->enabledButtons();
+		if(grpPtr->showsBounds())
+			btnBatchBounds += grpPtr->enabledButtons();
+	}
+	if(!btnBatchSprites)
+		return;
+	btnBatchIdxs.reserve(btnBatchSprites);
+	btnBatchQuads.reset({.size = size_t(btnBatchSprites)});
+	if(btnBatchBounds)
+		btnBatchBoundQuads.reset({.size = size_t(btnBatchBounds)});
+	auto quadsMap = btnBatchQuads.map();
+	Gfx::MappedBuffer<Gfx::Vertex2IColI> boundQuadsMap;
+	if(btnBatchBounds)
+		boundQuadsMap = btnBatchBoundQuads.map();
+	ssize_t spriteIdx{}, boundIdx{};
+	for(auto &batched : batchedGroups)
+	{
+		for(auto &b : batched.group->buttons)
+		{
+			if(!b.enabled)
+				continue;
+			b.writeSprite(quadsMap, spriteIdx++);
+			if(batched.showsBounds)
+				b.writeBounds(boundQuadsMap, boundIdx++);
+		}
+	}
+}
+
 void VController::draw(Gfx::RendererCommands &__restrict__ cmds, const VControllerElement &elem, bool showHidden) const
 {
 	cmds.set(Gfx::BlendMode::PREMULT_ALPHA);
@@ -822,6 +881,10 @@ void VController::configure(IG::Window &win, Gfx::Renderer &renderer, const Gfx:
 			std::ranges::copy(Gfx::mapFanQuadIndices(i), indices.begin() + (i * 12));
 		}
 	}
+	btnBatchIdxs = {renderer.mainTask, 32};
+	btnBatchQuads = {renderer.mainTask, {.size = 0}, btnBatchIdxs};
+	btnBatchBoundQuads = {renderer.mainTask, {.size = 0}, btnBatchIdxs};
+	batchedGroups.clear();
 	gamepadTex = app().asset(AssetID::gamepadOverlay);
 	uiTex = app().asset(AssetID::more);
 	if(uiElements.size() && uiElements[0].layoutPos[0].pos.x == -1)
@@ -338,6 +338,8 @@ void BaseVControllerButtonGroup<Group>::updateSprites()
 		boundQuadsMap = g.boundQuads.map();
 	}
 	auto quadsMap = g.quads.map();
+	if constexpr(requires {g.spritesChanged;})
+		g.spritesChanged = true;
 	g.enabledBtns = 0;
 	for(auto &b : g.buttons)
 	{
@@ -356,6 +358,8 @@ void BaseVControllerButtonGroup<Group>::updateSprite(VControllerButton &b)
 {
 	auto &g = static_cast<Group&>(*this);
 	assert(b.spriteIdx < g.quads.size());
+	if constexpr(requires {g.spritesChanged;})
+		g.spritesChanged = true;
 	if constexpr(requires {g.boundQuads;})
 		b.updateSprite(g.quads, g.boundQuads);
 	else
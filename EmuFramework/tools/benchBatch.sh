@@ -0,0 +1,100 @@
+#!/bin/bash
+# Runs a set of input replays through an emulator's --replay mode as independent processes,
+# once per parallelism level from 1 up to --jobs, and reports aggregate frames/sec and scaling
+# efficiency. Each replay argument is "<content path>:<replay file>".
+#
+# Example: benchBatch.sh --exec=./md-bench --jobs=64 game1.bin:game1.rpl game2.bin:game2.rpl ...
+
+jobs=`nproc`
+for arg in "$@"
+do
+	case $arg in
+		*=*) optarg=`expr "X$arg" : '[^=]*=\(.*\)'` ;;
+	esac
+
+	case "$arg" in
+		--exec=*)
+			exec=$optarg
+		;;
+		--jobs=*)
+			jobs=$optarg
+		;;
+		-*)
+			echo "unknown option: $arg"
+			exit 1
+		;;
+		*)
+			replays+=("$arg")
+		;;
+	esac
+done
+
+if [ ! "$exec" ] || [ ${#replays[@]} = 0 ]
+then
+	echo "usage: benchBatch.sh --exec=<emulator binary> [--jobs=<max processes>] <content>:<replay> ..."
+	exit 1
+fi
+
+outDir=`mktemp -d`
+trap 'rm -rf "$outDir"' EXIT
+
+runReplay ()
+{
+	# $1 = output file, $2 = content:replay pair
+	"$exec" --replay "${2##*:}" "${2%:*}" > "$1" 2>&1
+}
+export -f runReplay
+export exec
+
+baseFps=
+failed=0
+level=1
+while true
+do
+	start=`date +%s.%N`
+	for i in "${!replays[@]}"
+	do
+		printf '%s\0%s\0' "$outDir/$level-$i" "${replays[$i]}"
+	done | xargs -0 -n 2 -P $level bash -c 'runReplay "$@"' _
+	end=`date +%s.%N`
+
+	frames=0
+	for i in "${!replays[@]}"
+	do
+		out="$outDir/$level-$i"
+		count=`sed -n 's/.*: replayed \([0-9]*\) frames.*/\1/p' "$out"`
+		if [ ! "$count" ]
+		then
+			echo "${replays[$i]} failed:"
+			cat "$out"
+			failed=1
+			continue
+		fi
+		frames=$((frames + count))
+		# results must not depend on how many processes ran alongside
+		if [ $level != 1 ] && [ "`grep -o 'state crc32.*audio crc32 [0-9a-f]*' "$out"`" != "`grep -o 'state crc32.*audio crc32 [0-9a-f]*' "$outDir/1-$i"`" ]
+		then
+			echo "${replays[$i]}: checksum differs from the single process run"
+			failed=1
+		fi
+	done
+
+	awk -v level=$level -v frames=$frames -v start=$start -v end=$end -v baseFps="$baseFps" 'BEGIN {
+		secs = end - start
+		fps = frames / secs
+		if(baseFps == "")
+			printf "%d processes: %d frames in %.3fs, %.1f frames/sec\n", level, frames, secs, fps
+		else
+			printf "%d processes: %d frames in %.3fs, %.1f frames/sec, %.1f%% scaling efficiency\n", level, frames, secs, fps, fps * 100 / (baseFps * level)
+		}'
+	if [ ! "$baseFps" ]
+	then
+		baseFps=`awk -v frames=$frames -v start=$start -v end=$end 'BEGIN { print frames / (end - start) }'`
+	fi
+
+	[ $level -ge $jobs ] && break
+	level=$((level * 2))
+	[ $level -gt $jobs ] && level=$jobs
+done
+
+exit $failed
@@ -20,6 +20,7 @@ gba/gbaMode2.cpp \
 gba/gbaMode3.cpp \
 gba/gbaMode4.cpp \
 gba/gbaMode5.cpp \
+gba/gbaRenderThread.cpp \
 gba/gbaEeprom.cpp \
 gba/gbaFlash.cpp \
 gba/gbaCpuArm.cpp \
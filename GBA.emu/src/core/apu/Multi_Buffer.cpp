@@ -239,43 +239,36 @@ void Stereo_Mixer::mix_mono( blip_sample_t* out_, int count )
 
 void Stereo_Mixer::mix_stereo( blip_sample_t* out_, int count )
 {
-	blip_sample_t* BLIP_RESTRICT out = out_ + count * stereo;
-
-	// do left + center and right + center separately to reduce register load
-	Tracked_Blip_Buffer* const* buf = &bufs [2];
-	while ( true ) // loop runs twice
-	{
-		--buf;
-		--out;
-
-		int const bass = BLIP_READER_BASS( *bufs [2] );
-		BLIP_READER_BEGIN( side,   **buf );
-		BLIP_READER_BEGIN( center, *bufs [2] );
-
-		BLIP_READER_ADJ_( side,   samples_read );
-		BLIP_READER_ADJ_( center, samples_read );
-
-		int offset = -count;
-		do
-		{
-			blargg_long s = BLIP_READER_READ_RAW( center ) + BLIP_READER_READ_RAW( side );
-			s >>= blip_sample_bits - 16;
-			BLIP_READER_NEXT_IDX_( side,   bass, offset );
-			BLIP_READER_NEXT_IDX_( center, bass, offset );
-			BLIP_CLAMP( s, s );
-
-			++offset; // before write since out is decremented to slightly before end
-			out [offset * stereo] = (blip_sample_t) s;
-		}
-		while ( offset );
+	// left, right, and center are read in a single pass so center is only integrated once
+	int const bass = BLIP_READER_BASS( *bufs [2] );
+	BLIP_READER_BEGIN( left,   *bufs [0] );
+	BLIP_READER_BEGIN( right,  *bufs [1] );
+	BLIP_READER_BEGIN( center, *bufs [2] );
 
-		BLIP_READER_END( side,   **buf );
+	BLIP_READER_ADJ_( left,   samples_read );
+	BLIP_READER_ADJ_( right,  samples_read );
+	BLIP_READER_ADJ_( center, samples_read );
 
-		if ( buf != bufs )
-			continue;
+	typedef blip_sample_t stereo_blip_sample_t [stereo];
+	stereo_blip_sample_t* BLIP_RESTRICT out = (stereo_blip_sample_t*) out_ + count;
+	int offset = -count;
+	do
+	{
+		blargg_long c = BLIP_READER_READ_RAW( center );
+		blargg_long l = (c + BLIP_READER_READ_RAW( left  )) >> (blip_sample_bits - 16);
+		blargg_long r = (c + BLIP_READER_READ_RAW( right )) >> (blip_sample_bits - 16);
+		BLIP_READER_NEXT_IDX_( left,   bass, offset );
+		BLIP_READER_NEXT_IDX_( right,  bass, offset );
+		BLIP_READER_NEXT_IDX_( center, bass, offset );
+		BLIP_CLAMP( l, l );
+		BLIP_CLAMP( r, r );
 
-		// only end center once
-		BLIP_READER_END( center, *bufs [2] );
-		break;
+		out [offset] [0] = (blip_sample_t) l;
+		out [offset] [1] = (blip_sample_t) r;
 	}
+	while ( ++offset );
+
+	BLIP_READER_END( left,   *bufs [0] );
+	BLIP_READER_END( right,  *bufs [1] );
+	BLIP_READER_END( center, *bufs [2] );
 }
@@ -13,6 +13,8 @@ class EmuAudio;
 class EmuSystemTaskContext;
 }
 
+class Multi_Buffer;
+
 enum IMAGE_TYPE {
     IMAGE_UNKNOWN = -1,
     IMAGE_GBA = 0,
@@ -97,7 +99,8 @@ extern uint32_t systemReadJoypad(int);
 extern uint32_t systemGetClock();
 extern void systemSetTitle(const char*);
 extern SoundDriver* systemSoundInit();
-extern void systemOnWriteDataToSoundBuffer(EmuEx::EmuAudio* audio, const uint16_t* finalWave, int length);
+// reads the available samples from the buffer into the audio output
+extern void systemOnWriteDataToSoundBuffer(EmuEx::EmuAudio* audio, Multi_Buffer& buffer);
 extern void systemOnSoundShutdown();
 extern void systemScreenMessage(const char*);
 extern void systemUpdateMotionSensor();
@@ -2386,8 +2386,10 @@ void CPUCompareVCOUNT(ARM7TDMI &cpu)
   }
   if (layerEnableDelay > 0) {
   	layerEnableDelay--;
-      if (layerEnableDelay == 1)
+      if (layerEnableDelay == 1) {
+      	gba.lcd.renderThread.sync();
       	layerEnable = coreOptions.layerSettings & DISPCNT;
+      }
   }
 
 }
@@ -2658,6 +2660,20 @@ void CPUCheckDMA(GBASys &gba, ARM7TDMI &cpu, int reason, int dmamask)
 #define soundEvent8(addr, data) soundEvent8(gba, addr, data)
 #define soundEvent16(addr, data) soundEvent16(gba, addr, data)
 
+// registers whose writes update GBALCD state instead of only the I/O registers copied for each queued line
+static constexpr bool updatesRenderState(uint32_t address)
+{
+  switch (address) {
+  case 0x00:
+  case 0x28: case 0x2A: case 0x2C: case 0x2E:
+  case 0x38: case 0x3A: case 0x3C: case 0x3E:
+  case 0x40: case 0x42:
+  case 0x50:
+    return true;
+  }
+  return false;
+}
+
 void CPUUpdateRegister(ARM7TDMI &cpu, uint32_t address, uint16_t value)
 {
 	auto &armIrqEnable = cpu.armIrqEnable;
@@ -2669,6 +2685,9 @@ void CPUUpdateRegister(ARM7TDMI &cpu, uint32_t address, uint16_t value)
 	auto &g_ioMem = cpu.gba->mem.ioMem;
 	auto &gba = *cpu.gba;
 
+  if (updatesRenderState(address))
+  	gba.lcd.renderThread.sync();
+
   switch (address) {
   case 0x00: { // we need to place the following code in { } because we declare & initialize variables in a case statement
       if ((value & 7) > 5) {
@@ -3716,6 +3735,8 @@ void CPULoop(GBASys &gba, EmuEx::EmuSystemTaskContext taskCtx, EmuEx::EmuVideo *
 {
 	auto cpu = gba.cpu;
 	auto restoreCpu = IG::scopeGuard([&](){ gba.cpu = cpu; });
+	// anything outside the loop may access the video state
+	auto syncRender = IG::scopeGuard([&](){ gba.lcd.renderThread.sync(); });
 	auto &holdState = cpu.holdState;
 	auto &armIrqEnable = cpu.armIrqEnable;
 	auto &ioMem = gba.mem.ioMem;
@@ -3727,6 +3748,8 @@ void CPULoop(GBASys &gba, EmuEx::EmuSystemTaskContext taskCtx, EmuEx::EmuVideo *
   int timerOverflow = 0;
   // variable used by the CPU core
   cpuTotalTicks = 0;
+  // code may have changed or a state was loaded since the last frame
+  cpu.idleLoopPC = ~0u;
 
 #ifndef NO_LINK
 // shuffle2: what's the purpose?
@@ -4053,13 +4076,14 @@ void CPULoop(GBASys &gba, EmuEx::EmuSystemTaskContext taskCtx, EmuEx::EmuVideo *
             	else
             	{
             	}*/
-              (*gba.lcd.renderLine)(gba.lcd.lineMix, gba.lcd, ioMem);
+              gba.lcd.renderThread.renderLine(gba.lcd, ioMem);
             }
             if (VCOUNT == 159)
             {
             	cpuBreakLoop = true;
               if (video)
               {
+            	  gba.lcd.renderThread.sync();
             	  systemDrawScreen(taskCtx, *video);
             	  video = nullptr;
               }
@@ -1,6 +1,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <algorithm>
 
 #ifndef _MSC_VER
 #include <strings.h>
@@ -1792,6 +1793,95 @@ static INSN_REGPARM int thumbC8(ARM7TDMI &cpu, uint32_t opcode, uint32_t oldArmN
   return 2 + codeTicksAccess16(armNextPC);
 }
 
+// Idle loop detection ////////////////////////////////////////////////////
+
+// Games often wait for VBlank or an interrupt by spinning in a short loop that only
+// reads memory. Everything such a loop can read only changes on events scheduled by
+// CPULoop(), so once an iteration ends with the same registers and flags as the previous
+// one, and nothing it read depended on the cycle count, the loop can't exit before the
+// next event and the rest of the wait is skipped.
+
+static constexpr uint32_t maxIdleLoopBytes = 16;
+
+// true if the loop body only has loads, register ops, and branches
+static bool thumbLoopIsIdleCandidate(ARM7TDMI &cpu, uint32_t start, uint32_t end)
+{
+  for (uint32_t pc = start; pc <= end; pc += 2) {
+    uint32_t op = CPUReadHalfWordQuick(cpu, pc);
+    switch (op >> 12) {
+    case 0x0:
+    case 0x1:
+    case 0x2:
+    case 0x3: // shifts, add/sub, immediate ops
+      break;
+    case 0x4:
+      if ((op & 0xFC00) == 0x4400) { // hi register ops, reject BX and writes to PC
+        bool isBX = (op & 0x0300) == 0x0300;
+        bool isCMP = (op & 0x0300) == 0x0100;
+        if (isBX || (!isCMP && ((op & 7) | ((op >> 4) & 8)) == 15))
+          return false;
+      }
+      break; // ALU ops, PC-relative load
+    case 0x5: // register offset, stores come before LDSB
+      if ((op & 0x0E00) < 0x0600)
+        return false;
+      break;
+    case 0x6:
+    case 0x7:
+    case 0x8:
+    case 0x9: // immediate and SP-relative, only loads
+      if (!(op & 0x0800))
+        return false;
+      break;
+    case 0xA: // ADD PC/SP
+      break;
+    case 0xD: // conditional branches, not SWI
+      if ((op & 0x0F00) >= 0x0E00)
+        return false;
+      break;
+    case 0xE: // unconditional branch
+      if (op & 0x0800)
+        return false;
+      break;
+    default:
+      return false;
+    }
+  }
+  return true;
+}
+
+static uint32_t idleLoopFlagState(const ARM7TDMI &cpu)
+{
+  return N_FLAG | (Z_FLAG << 1) | (C_FLAG << 2) | (V_FLAG << 3);
+}
+
+// called after a taken backward branch, returns the extra ticks to skip
+static int thumbIdleLoopTicks(ARM7TDMI &cpu, uint32_t branchPC, int clockTicks)
+{
+  uint32_t loopPC = armNextPC;
+  if (loopPC > branchPC || branchPC - loopPC >= maxIdleLoopBytes)
+    return 0;
+  if (loopPC != cpu.idleLoopPC) {
+    cpu.idleLoopPC = loopPC;
+    cpu.idleLoopIsPure = thumbLoopIsIdleCandidate(cpu, loopPC, branchPC);
+    cpu.idleLoopHasState = false;
+  }
+  if (!cpu.idleLoopIsPure)
+    return 0;
+  uint32_t flags = idleLoopFlagState(cpu);
+  bool repeated = cpu.idleLoopHasState && !cpu.idleLoopHazard && flags == cpu.idleLoopFlags;
+  for (int i = 0; i < 16; i++) {
+    repeated = repeated && reg[i].I == cpu.idleLoopRegs[i];
+    cpu.idleLoopRegs[i] = reg[i].I;
+  }
+  cpu.idleLoopFlags = flags;
+  cpu.idleLoopHasState = true;
+  cpu.idleLoopHazard = false;
+  if (!repeated)
+    return 0;
+  return std::max(cpu.cpuNextEvent - (cpu.cpuTotalTicks + clockTicks), 0);
+}
+
 // Conditional branches ///////////////////////////////////////////////////
 #define THUMB_CONDITIONAL_BRANCH(COND)                                  \
     UPDATE_OLDREG;                                                      \
@@ -1805,6 +1895,8 @@ static INSN_REGPARM int thumbC8(ARM7TDMI &cpu, uint32_t opcode, uint32_t oldArmN
         clockTicks += codeTicksAccessSeq16(armNextPC)              \
             + codeTicksAccess16(armNextPC) + 2;                    \
         busPrefetchCount = 0;                                           \
+        if (UNLIKELY(cpu.skipIdleLoops && (opcode & 0x80)))             \
+            clockTicks += thumbIdleLoopTicks(cpu, oldArmNextPC, clockTicks); \
     }                                                                   \
 		return clockTicks;
 
@@ -1917,6 +2009,8 @@ static INSN_REGPARM int thumbE0(ARM7TDMI &cpu, uint32_t opcode, uint32_t oldArmN
   THUMB_PREFETCH;
   int clockTicks = codeTicksAccessSeq16(armNextPC) * 2 + codeTicksAccess16(armNextPC) + 3;
   busPrefetchCount = 0;
+  if (UNLIKELY(cpu.skipIdleLoops && (opcode & 0x0400)))
+    clockTicks += thumbIdleLoopTicks(cpu, oldArmNextPC, clockTicks);
   return clockTicks;
 }
 
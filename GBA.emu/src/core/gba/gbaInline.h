@@ -94,6 +94,15 @@ static inline int8_t Downcast8(T value) {
     return static_cast<int8_t>(value);
 }
 
+// Timer counters are derived from the cycle count and serial registers change as they're
+// read, so polling them keeps a loop from being skipped as idle
+static inline void markIdleLoopHazardIO(ARM7TDMI &cpu, uint32_t address)
+{
+    uint32_t ioAddress = address & 0x3fe;
+    if (ioAddress >= 0x100 && ioAddress < 0x200 && (ioAddress < 0x130 || ioAddress > 0x132))
+        cpu.idleLoopHazard = true;
+}
+
 static inline uint32_t CPUReadMemory(ARM7TDMI &cpu, uint32_t address)
 {
     auto &g_ioMem = cpu.gba->mem.ioMem.b;
@@ -132,6 +141,7 @@ static inline uint32_t CPUReadMemory(ARM7TDMI &cpu, uint32_t address)
         value = READ32LE(((uint32_t*)&g_internalRAM[address & 0x7ffC]));
         break;
     case 4:
+        markIdleLoopHazardIO(cpu, address);
         if ((address < 0x4000400) && ioReadable[address & 0x3fc]) {
             if (ioReadable[(address & 0x3fc) + 2]) {
                 value = READ32LE(((uint32_t*)&g_ioMem[address & 0x3fC]));
@@ -169,12 +179,14 @@ static inline uint32_t CPUReadMemory(ARM7TDMI &cpu, uint32_t address)
         value = READ32LE(((uint32_t*)&g_rom[address & 0x1FFFFFC]));
         break;
     case 13:
+        cpu.idleLoopHazard = true;
         if (cpuEEPROMEnabled)
             // no need to swap this
             return eepromRead(address);
         goto unreadable;
     case 14:
     case 15:
+        cpu.idleLoopHazard = true;
         if (cpuFlashEnabled | cpuSramEnabled) { // no need to swap this
             value = flashRead(address) * 0x01010101;
         break;
@@ -274,6 +286,7 @@ static inline uint32_t CPUReadHalfWord(ARM7TDMI &cpu, uint32_t address)
         value = READ16LE(((uint16_t*)&g_internalRAM[address & 0x7ffe]));
         break;
     case 4:
+        markIdleLoopHazardIO(cpu, address);
         if ((address < 0x4000400) && ioReadable[address & 0x3fe]) {
             value = READ16LE(((uint16_t*)&g_ioMem[address & 0x3fe]));
             if (((address & 0x3fe) > 0xFF) && ((address & 0x3fe) < 0x10E)) {
@@ -313,18 +326,21 @@ static inline uint32_t CPUReadHalfWord(ARM7TDMI &cpu, uint32_t address)
     case 10:
     case 11:
     case 12:
-        if (address == 0x80000c4 || address == 0x80000c6 || address == 0x80000c8)
+        if (address == 0x80000c4 || address == 0x80000c6 || address == 0x80000c8) {
+            cpu.idleLoopHazard = true;
             value = rtcRead(*cpu.gba, address);
-        else
+        } else
             value = READ16LE(((uint16_t*)&g_rom[address & 0x1FFFFFE]));
         break;
     case 13:
+        cpu.idleLoopHazard = true;
         if (cpuEEPROMEnabled)
             // no need to swap this
             return eepromRead(address);
         goto unreadable;
     case 14:
     case 15:
+        cpu.idleLoopHazard = true;
         if (cpuFlashEnabled | cpuSramEnabled) {
             // no need to swap this
             value = flashRead(address) * 0x0101;
@@ -417,6 +433,7 @@ static inline uint8_t CPUReadByte(ARM7TDMI &cpu, uint32_t address)
     case 3:
         return g_internalRAM[address & 0x7fff];
     case 4:
+        markIdleLoopHazardIO(cpu, address);
         if ((address < 0x4000400) && ioReadable[address & 0x3ff])
             return g_ioMem[address & 0x3ff];
         else
@@ -439,11 +456,13 @@ static inline uint8_t CPUReadByte(ARM7TDMI &cpu, uint32_t address)
     case 12:
         return g_rom[address & 0x1FFFFFF];
     case 13:
+        cpu.idleLoopHazard = true;
         if (cpuEEPROMEnabled)
             return DowncastU8(eepromRead(address));
         goto unreadable;
     case 14:
     case 15:
+        cpu.idleLoopHazard = true;
         if (cpuSramEnabled | cpuFlashEnabled)
             return flashRead(address);
 
@@ -527,6 +546,7 @@ static inline void CPUWriteMemory(ARM7TDMI &cpu, uint32_t address, uint32_t valu
             goto unwritable;
         break;
     case 0x05:
+        cpu.gba->lcd.renderThread.sync();
 #ifdef VBAM_ENABLE_DEBUGGER
         if (*((uint32_t*)&freezePRAM[address & 0x3fc]))
             cheatsWriteMemory(address & 0x70003FC, value);
@@ -535,6 +555,7 @@ static inline void CPUWriteMemory(ARM7TDMI &cpu, uint32_t address, uint32_t valu
             WRITE32LE(((uint32_t*)&g_paletteRAM[address & 0x3FC]), value);
         break;
     case 0x06:
+        cpu.gba->lcd.renderThread.sync();
         address = (address & 0x1fffc);
         if (((DISPCNT & 7) > 2) && ((address & 0x1C000) == 0x18000))
             return;
@@ -550,6 +571,7 @@ static inline void CPUWriteMemory(ARM7TDMI &cpu, uint32_t address, uint32_t valu
             WRITE32LE(((uint32_t*)&g_vram[address]), value);
         break;
     case 0x07:
+        cpu.gba->lcd.renderThread.sync();
 #ifdef VBAM_ENABLE_DEBUGGER
         if (*((uint32_t*)&freezeOAM[address & 0x3fc]))
             cheatsWriteMemory(address & 0x70003FC, value);
@@ -631,6 +653,7 @@ static inline void CPUWriteHalfWord(ARM7TDMI &cpu, uint32_t address, uint16_t va
             goto unwritable;
         break;
     case 5:
+        cpu.gba->lcd.renderThread.sync();
 #ifdef VBAM_ENABLE_DEBUGGER
         if (*((uint16_t*)&freezePRAM[address & 0x03fe]))
             cheatsWriteHalfWord(address & 0x70003fe, value);
@@ -639,6 +662,7 @@ static inline void CPUWriteHalfWord(ARM7TDMI &cpu, uint32_t address, uint16_t va
             WRITE16LE(((uint16_t*)&g_paletteRAM[address & 0x3fe]), value);
         break;
     case 6:
+        cpu.gba->lcd.renderThread.sync();
         address = (address & 0x1fffe);
         if (((DISPCNT & 7) > 2) && ((address & 0x1C000) == 0x18000))
             return;
@@ -652,6 +676,7 @@ static inline void CPUWriteHalfWord(ARM7TDMI &cpu, uint32_t address, uint16_t va
             WRITE16LE(((uint16_t*)&g_vram[address]), value);
         break;
     case 7:
+        cpu.gba->lcd.renderThread.sync();
 #ifdef VBAM_ENABLE_DEBUGGER
         if (*((uint16_t*)&freezeOAM[address & 0x03fe]))
             cheatsWriteHalfWord(address & 0x70003fe, value);
@@ -790,10 +815,12 @@ static inline void CPUWriteByte(ARM7TDMI &cpu, uint32_t address, uint8_t b)
             goto unwritable;
         break;
     case 5:
+        cpu.gba->lcd.renderThread.sync();
         // no need to switch
         *((uint16_t*)&g_paletteRAM[address & 0x3FE]) = (b << 8) | b;
         break;
     case 6:
+        cpu.gba->lcd.renderThread.sync();
         address = (address & 0x1fffe);
         if (((DISPCNT & 7) > 2) && ((address & 0x1C000) == 0x18000))
             return;
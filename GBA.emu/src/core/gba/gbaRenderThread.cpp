@@ -0,0 +1,101 @@
+/*  This file is part of GBA.emu.
+
+	GBA.emu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	GBA.emu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with GBA.emu.  If not, see <http://www.gnu.org/licenses/> */
+
+#include "core/gba/gba.h"
+#include "core/gba/gbaGlobals.h"
+#include <cstring>
+
+void GBARenderThread::start(GBALCD &lcd)
+{
+	if(isActive())
+		return;
+	lcdPtr = &lcd;
+	thread = IG::makeThreadSync(
+		[this](auto &sem)
+		{
+			threadId_ = IG::thisThreadId();
+			sem.release();
+			run();
+		});
+}
+
+void GBARenderThread::stop()
+{
+	if(!isActive())
+		return;
+	push(nullptr, nullptr, nullptr);
+	thread.join();
+	threadId_ = {};
+}
+
+void GBARenderThread::renderLine(GBALCD &lcd, const GBAMem::IoMem &ioMem)
+{
+	if(!isActive())
+	{
+		lcd.renderLine(lcd.lineMix, lcd, ioMem);
+		return;
+	}
+	push(lcd.renderLine, lcd.lineMix, &ioMem);
+}
+
+void GBARenderThread::push(RenderLineFunc render, MixColorType *lineMix, const GBAMem::IoMem *ioMem)
+{
+	auto writePos = writeIdx.load(std::memory_order_relaxed);
+	for(auto readPos = readIdx.load(std::memory_order_acquire); writePos - readPos == capacity;
+		readPos = readIdx.load(std::memory_order_acquire)) [[unlikely]]
+	{
+		readIdx.wait(readPos, std::memory_order_acquire);
+	}
+	auto &line = ring[writePos % capacity];
+	line.render = render;
+	line.lineMix = lineMix;
+	if(ioMem)
+		memcpy(line.ioMem.b, ioMem->b, lcdRegsSize);
+	writeIdx.store(writePos + 1, std::memory_order_release);
+	writeIdx.notify_one();
+}
+
+void GBARenderThread::run()
+{
+	auto readPos = readIdx.load(std::memory_order_relaxed);
+	while(true)
+	{
+		auto writePos = writeIdx.load(std::memory_order_acquire);
+		if(readPos == writePos)
+		{
+			writeIdx.wait(writePos, std::memory_order_acquire);
+			continue;
+		}
+		auto &line = ring[readPos % capacity];
+		if(!line.render)
+		{
+			readIdx.store(readPos + 1, std::memory_order_release);
+			return;
+		}
+		line.render(line.lineMix, *lcdPtr, line.ioMem);
+		readIdx.store(++readPos, std::memory_order_release);
+		readIdx.notify_one();
+	}
+}
+
+void GBARenderThread::waitIdle()
+{
+	auto writePos = writeIdx.load(std::memory_order_relaxed);
+	for(auto readPos = readIdx.load(std::memory_order_acquire); readPos != writePos;
+		readPos = readIdx.load(std::memory_order_acquire))
+	{
+		readIdx.wait(readPos, std::memory_order_acquire);
+	}
+}
@@ -378,10 +378,13 @@ void flush_samples(Multi_Buffer * buffer, EmuEx::EmuAudio *audio)
         systemOnWriteDataToSoundBuffer(soundFinalWave, soundBufferLen);
     }
 #endif
-	std::array<uint16_t, 1800> soundFinalWave;
-	auto samples = buffer->read_samples((blip_sample_t*)soundFinalWave.data(), soundFinalWave.size());
 	if(audio) [[likely]]
-		systemOnWriteDataToSoundBuffer(audio, soundFinalWave.data(), samples);
+	{
+		systemOnWriteDataToSoundBuffer(audio, *buffer);
+		return;
+	}
+	std::array<uint16_t, 1800> soundFinalWave;
+	buffer->read_samples((blip_sample_t*)soundFinalWave.data(), soundFinalWave.size());
 }
 
 static void apply_filtering()
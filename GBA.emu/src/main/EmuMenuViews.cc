@@ -64,6 +64,36 @@ class ConsoleOptionView : public TableView, public MainAppHelper
 		}
 	};
 
+	TextMenuItem skipIdleLoopsItems[3]
+	{
+		{"Auto", attachParams(), {.id = AutoTristate::Auto}},
+		{"Off",  attachParams(), {.id = AutoTristate::Off}},
+		{"On",   attachParams(), {.id = AutoTristate::On}},
+	};
+
+	MultiChoiceMenuItem skipIdleLoops
+	{
+		"Skip Idle Loops", attachParams(),
+		MenuId{system().skipIdleLoops.value()},
+		skipIdleLoopsItems,
+		{
+			.onSetDisplayString = [this](auto idx, Gfx::Text &t)
+			{
+				if(idx == 0)
+				{
+					t.resetString(system().shouldSkipIdleLoops() ? "On" : "Off");
+					return true;
+				}
+				return false;
+			},
+			.defaultItemOnSelect = [this](TextMenuItem &item)
+			{
+				system().sessionOptionSet();
+				system().skipIdleLoops = AutoTristate(item.id.val);
+			}
+		}
+	};
+
 	TextMenuItem rtcItem[3]
 	{
 		{"Auto", attachParams(), {.id = RtcMode::AUTO}},
@@ -184,11 +214,12 @@ class ConsoleOptionView : public TableView, public MainAppHelper
 	};
 	#endif
 
-	std::array<MenuItem*, Config::SENSORS ? 4 : 3> menuItem
+	std::array<MenuItem*, Config::SENSORS ? 5 : 4> menuItem
 	{
 		&bios,
 		&rtc
 		, &saveType
+		, &skipIdleLoops
 		#ifdef IG_CONFIG_SENSORS
 		, &hardwareSensor
 		#endif
@@ -406,6 +437,26 @@ class CustomSystemOptionView : public SystemOptionView, public MainAppHelper
 		}
 	};
 
+	BoolMenuItem skipIdleLoops
+	{
+		"Default Skip Idle Loops", attachParams(),
+		system().defaultSkipIdleLoops,
+		[this](BoolMenuItem &item)
+		{
+			system().defaultSkipIdleLoops = item.flipBoolValue(*this);
+		}
+	};
+
+	BoolMenuItem renderThread
+	{
+		"Render Video On Separate Thread", attachParams(),
+		system().useRenderThread,
+		[this](BoolMenuItem &item)
+		{
+			system().setRenderThread(item.flipBoolValue(*this));
+		}
+	};
+
 	#ifdef IG_CONFIG_SENSORS
 	TextMenuItem lightSensorScaleItem[5]
 	{
@@ -453,6 +504,8 @@ public:
 	{
 		loadStockItems();
 		item.emplace_back(&bios);
+		item.emplace_back(&skipIdleLoops);
+		item.emplace_back(&renderThread);
 		#ifdef IG_CONFIG_SENSORS
 		item.emplace_back(&lightSensorScale);
 		#endif
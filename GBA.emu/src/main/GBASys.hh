@@ -3,8 +3,12 @@
 #include <core/base/system.h>
 #include <core/base/port.h>
 #include <core/gba/gba.h>
+#include <imagine/thread/Thread.hh>
 #include <imagine/util/used.hh>
 #include <imagine/util/utility.h>
+#include <array>
+#include <atomic>
+#include <thread>
 
 using MixColorType = uint16_t;
 struct GBALCD;
@@ -252,6 +256,54 @@ struct GBATimers
 
 void mode0RenderLine(MixColorType *, GBALCD &lcd, const GBAMem::IoMem &ioMem);
 
+// Optionally renders lines on a worker thread while the CPU keeps running. Each queued line
+// gets a copy of the LCD registers, but VRAM, palette, OAM, and the other GBALCD state are read
+// in place, so sync() must be called before the CPU modifies them.
+class GBARenderThread
+{
+public:
+	using RenderLineFunc = void (*)(MixColorType *lineMix, GBALCD &lcd, const GBAMem::IoMem &ioMem);
+
+	GBARenderThread() = default;
+	GBARenderThread &operator=(GBARenderThread &&) = delete;
+	~GBARenderThread() { stop(); }
+	void start(GBALCD &);
+	void stop();
+	bool isActive() const { return thread.joinable(); }
+	IG::ThreadId threadId() const { return threadId_; }
+	// renders the current line right away if the thread isn't running
+	void renderLine(GBALCD &, const GBAMem::IoMem &);
+
+	// waits for all queued lines to finish
+	void sync()
+	{
+		if(readIdx.load(std::memory_order_acquire) != writeIdx.load(std::memory_order_relaxed)) [[unlikely]]
+			waitIdle();
+	}
+
+private:
+	static constexpr uint32_t capacity = 32;
+	static constexpr size_t lcdRegsSize = 0x56; // DISPCNT to COLY
+
+	struct Line
+	{
+		RenderLineFunc render; // null to exit the thread
+		MixColorType *lineMix;
+		GBAMem::IoMem ioMem;
+	};
+
+	GBALCD *lcdPtr{};
+	std::thread thread;
+	IG::ThreadId threadId_{};
+	alignas(64) std::atomic_uint32_t writeIdx{};
+	alignas(64) std::atomic_uint32_t readIdx{};
+	std::array<Line, capacity> ring;
+
+	void push(RenderLineFunc, MixColorType *lineMix, const GBAMem::IoMem *);
+	void run();
+	void waitIdle();
+};
+
 struct GBALCD
 {
 	uint32_t line0[240];
@@ -282,9 +334,11 @@ struct GBALCD
 	int layerEnableDelay{};
 	int lcdTicks{};
 	uint16_t gfxLastVCOUNT{};
+	GBARenderThread renderThread;
 
 	void registerRamReset(uint32_t flags)
 	{
+		renderThread.sync();
     if(flags & 0x04) {
       // clear palette RAM
       memset(paletteRAM, 0, 0x400);
@@ -398,6 +452,14 @@ public:
 	bool armState{true};
 	bool armIrqEnable{true};
 	bool holdState{};
+	// idle loop detection, see thumbIdleLoopTicks()
+	bool skipIdleLoops{};
+	bool idleLoopIsPure{};
+	bool idleLoopHasState{};
+	bool idleLoopHazard{}; // set by reads that depend on the cycle count or change state
+	uint32_t idleLoopPC{~0u};
+	std::array<uint32_t, 16> idleLoopRegs{};
+	uint32_t idleLoopFlags{};
 	//uint8_t cpuBitsSet[256];
 	//uint8_t cpuLowestBitSet[256];
 	GBASys *gba;
@@ -21,6 +21,7 @@
 #include <imagine/util/format.hh>
 #include <imagine/util/string.h>
 #include <imagine/util/zlib.hh>
+#include <imagine/vmem/memory.hh>
 #include <imagine/logger/logger.h>
 #include <core/gba/gba.h>
 #include <core/gba/gbaGfx.h>
@@ -29,6 +30,7 @@
 #include <core/gba/gbaEeprom.h>
 #include <core/gba/gbaFlash.h>
 #include <core/gba/gbaCheats.h>
+#include <core/apu/Multi_Buffer.h>
 #include <core/base/sound_driver.h>
 #include <core/base/patch.h>
 #include <core/base/file_util.h>
@@ -43,6 +45,7 @@ namespace EmuEx
 
 constexpr SystemLogger log{"GBA.emu"};
 const char *EmuSystem::creditsViewStr = CREDITS_INFO_STRING "(c) 2012-2024\nRobert Broglia\nwww.explusalpha.com\n\nPortions (c) the\nVBA-m Team\nvba-m.com";
+bool EmuSystem::hasGzipStates = true;
 bool EmuSystem::hasBundledGames = true;
 bool EmuSystem::hasCheats = true;
 bool EmuApp::needsGlobalInstance = true;
@@ -57,6 +60,14 @@ EmuSystem::NameFilterFunc EmuSystem::defaultFsFilter =
 GbaApp::GbaApp(ApplicationInitParams initParams, ApplicationContext &ctx):
 	EmuApp{initParams, ctx}, gbaSystem{ctx} {}
 
+GbaSystem::GbaSystem(ApplicationContext ctx):
+	EmuSystem{ctx}
+{
+	// ROM reads are scattered over all 32MB after postLoadRomSetup() fills the unused space,
+	// so request huge pages before any of it is touched
+	vAdvise(gGba.mem.rom, {.hugePages = true});
+}
+
 const BundledGameInfo &EmuSystem::bundledGameInfo(int idx) const
 {
 	static const BundledGameInfo info[]
@@ -100,6 +111,18 @@ void GbaSystem::readState(EmuApp &app, std::span<uint8_t> buff)
 		throw std::runtime_error("Invalid state data");
 }
 
+void GbaSystem::forEachStateSection(StateSectionDelegate del)
+{
+	auto &mem = gGba.mem;
+	del({"cpu", {reinterpret_cast<uint8_t*>(gGba.cpu.reg.data()), sizeof(gGba.cpu.reg)}});
+	del({"io", mem.ioMem.b, 0x4000000});
+	del({"iwram", mem.internalRAM, 0x3000000});
+	del({"ewram", mem.workRAM, 0x2000000});
+	del({"vram", gGba.lcd.vram, 0x6000000});
+	del({"palette", gGba.lcd.paletteRAM, 0x5000000});
+	del({"oam", gGba.lcd.oam, 0x7000000});
+}
+
 size_t GbaSystem::writeState(std::span<uint8_t> buff, SaveStateFlags flags)
 {
 	assert(buff.size() >= saveStateSize);
@@ -112,7 +135,7 @@ size_t GbaSystem::writeState(std::span<uint8_t> buff, SaveStateFlags flags)
 		assert(saveStateSize);
 		auto stateArr = DynArray<uint8_t>(saveStateSize);
 		CPUWriteState(gGba, stateArr.data());
-		return compressGzip(buff, stateArr, Z_DEFAULT_COMPRESSION);
+		return compressState(buff, stateArr, flags, Z_DEFAULT_COMPRESSION);
 	}
 }
 
@@ -141,7 +164,7 @@ void GbaSystem::onFlushBackupMemory(EmuApp &app, BackupMemoryDirtyFlags)
 	else
 	{
 		log.info("saving backup memory");
-		saveFileIO.write(saveData.span(), 0);
+		app.backupMemoryWriter.push(saveFileIO, saveData.span());
 	}
 }
 
@@ -153,6 +176,7 @@ WallClockTimePoint GbaSystem::backupMemoryLastWriteTime(const EmuApp &app) const
 void GbaSystem::closeSystem()
 {
 	assert(hasContent());
+	gGba.lcd.renderThread.stop();
 	CPUCleanUp();
 	saveFileIO = {};
 	coreOptions.saveType = GBA_SAVE_NONE;
@@ -214,6 +238,7 @@ void GbaSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegat
 	}
 	CPUInit(gGba, biosRom);
 	CPUReset(gGba);
+	setRenderThread(useRenderThread);
 	saveStateSize = CPUWriteState(gGba, DynArray<uint8_t>{maxStateSize}.data());
 	readCheatFile(*this);
 }
@@ -245,8 +270,26 @@ void GbaSystem::renderFramebuffer(EmuVideo &video)
 	systemDrawScreen({}, video);
 }
 
+void GbaSystem::setRenderThread(bool on)
+{
+	useRenderThread = on;
+	if(!hasContent())
+		return;
+	if(on)
+		gGba.lcd.renderThread.start(gGba.lcd);
+	else
+		gGba.lcd.renderThread.stop();
+}
+
+void GbaSystem::addThreadGroupIds(std::vector<ThreadId> &ids) const
+{
+	if(gGba.lcd.renderThread.isActive())
+		ids.emplace_back(gGba.lcd.renderThread.threadId());
+}
+
 void GbaSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio)
 {
+	gGba.cpu.skipIdleLoops = shouldSkipIdleLoops();
 	CPULoop(gGba, taskCtx, video, audio);
 }
 
@@ -299,12 +342,11 @@ void systemDrawScreen(EmuEx::EmuSystemTaskContext taskCtx, EmuEx::EmuVideo &vide
 	img.endFrame();
 }
 
-void systemOnWriteDataToSoundBuffer(EmuEx::EmuAudio *audio, const uint16_t *finalWave, int length)
+void systemOnWriteDataToSoundBuffer(EmuEx::EmuAudio *audio, Multi_Buffer &buffer)
 {
-	if(audio)
+	// mix the stereo samples straight into the output buffer
+	audio->writeFrames(buffer.samples_avail() / 2, [&](void *dest, size_t frames)
 	{
-		int frames = length >> 1; // stereo samples
-		//log.debug("{} audio frames", frames);
-		audio->writeFrames(finalWave, frames);
-	}
+		return size_t(buffer.read_samples(static_cast<blip_sample_t*>(dest), frames * 2) / 2);
+	});
 }
@@ -42,7 +42,8 @@ enum
 	CFGKEY_SENSOR_TYPE = 262, CFGKEY_LIGHT_SENSOR_SCALE = 263,
 	CFGKEY_CHEATS_PATH = 264, CFGKEY_PATCHES_PATH = 265,
 	CFGKEY_USE_BIOS = 266, CFGKEY_DEFAULT_USE_BIOS = 267,
-	CFGKEY_BIOS_PATH = 268
+	CFGKEY_BIOS_PATH = 268, CFGKEY_SKIP_IDLE_LOOPS = 269,
+	CFGKEY_DEFAULT_SKIP_IDLE_LOOPS = 270, CFGKEY_RENDER_THREAD = 271,
 };
 
 void readCheatFile(class EmuSystem &);
@@ -90,12 +91,14 @@ public:
 	bool saveMemoryIsMappedFile{};
 	Property<AutoTristate, CFGKEY_USE_BIOS> useBios;
 	Property<bool, CFGKEY_DEFAULT_USE_BIOS> defaultUseBios;
+	Property<AutoTristate, CFGKEY_SKIP_IDLE_LOOPS> skipIdleLoops;
+	Property<bool, CFGKEY_DEFAULT_SKIP_IDLE_LOOPS, PropertyDesc<bool>{.defaultValue = true}> defaultSkipIdleLoops;
+	Property<bool, CFGKEY_RENDER_THREAD> useRenderThread;
 	ConditionalMember<Config::SENSORS, GbaSensorType> sensorType{};
 	ConditionalMember<Config::SENSORS, GbaSensorType> detectedSensorType{};
 	static constexpr auto gbaFrameTime{fromSeconds<FrameTime>(280896. / 16777216.)}; // ~59.7275Hz
 
-	GbaSystem(ApplicationContext ctx):
-		EmuSystem{ctx} {}
+	GbaSystem(ApplicationContext ctx);
 	void setGameSpecificSettings(GBASys &gba, int romSize);
 	void setRTC(RtcMode mode);
 	std::pair<int, int> saveTypeOverride() { return unpackSaveTypeOverride(optionSaveTypeOverride); }
@@ -103,6 +106,11 @@ public:
 	void setSensorActive(bool);
 	void setSensorType(GbaSensorType);
 	void clearSensorValues();
+	void setRenderThread(bool on);
+	bool shouldSkipIdleLoops() const
+	{
+		return skipIdleLoops == AutoTristate::Auto ? bool(defaultSkipIdleLoops) : skipIdleLoops == AutoTristate::On;
+	}
 
 	// required API functions
 	void loadContent(IO &, EmuSystemCreateParams, OnLoadProgressDelegate);
@@ -132,6 +140,8 @@ public:
 	void closeSystem();
 	bool onVideoRenderFormatChange(EmuVideo &, IG::PixelFormat);
 	void renderFramebuffer(EmuVideo &);
+	void forEachStateSection(StateSectionDelegate);
+	void addThreadGroupIds(std::vector<ThreadId> &) const;
 
 private:
 	void applyGamePatches(uint8_t *rom, int &romSize);
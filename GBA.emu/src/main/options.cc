@@ -45,6 +45,7 @@ bool GbaSystem::resetSessionOptions(EmuApp &)
 	optionSaveTypeOverride.reset();
 	sensorType = GbaSensorType::Auto;
 	useBios.reset();
+	skipIdleLoops.reset();
 	return true;
 }
 
@@ -63,6 +64,8 @@ bool GbaSystem::readConfig(ConfigType type, MapIO &io, unsigned key)
 			case CFGKEY_PATCHES_PATH: return readStringOptionValue(io, patchesDir);
 			case CFGKEY_BIOS_PATH: return readStringOptionValue(io, biosPath);
 			case CFGKEY_DEFAULT_USE_BIOS: return readOptionValue(io, defaultUseBios);
+			case CFGKEY_DEFAULT_SKIP_IDLE_LOOPS: return readOptionValue(io, defaultSkipIdleLoops);
+			case CFGKEY_RENDER_THREAD: return readOptionValue(io, useRenderThread);
 		}
 	}
 	else if(type == ConfigType::SESSION)
@@ -74,6 +77,7 @@ bool GbaSystem::readConfig(ConfigType type, MapIO &io, unsigned key)
 			case CFGKEY_SENSOR_TYPE:
 				return readOptionValue(io, sensorType, [&](auto v){return v <= IG::lastEnum<GbaSensorType>;});
 			case CFGKEY_USE_BIOS: return readOptionValue(io, useBios);
+			case CFGKEY_SKIP_IDLE_LOOPS: return readOptionValue(io, skipIdleLoops);
 		}
 	}
 	return false;
@@ -92,6 +96,8 @@ void GbaSystem::writeConfig(ConfigType type, FileIO &io)
 		writeStringOptionValue(io, CFGKEY_PATCHES_PATH, patchesDir);
 		writeStringOptionValue(io, CFGKEY_BIOS_PATH, biosPath);
 		writeOptionValueIfNotDefault(io, defaultUseBios);
+		writeOptionValueIfNotDefault(io, defaultSkipIdleLoops);
+		writeOptionValueIfNotDefault(io, useRenderThread);
 	}
 	else if(type == ConfigType::SESSION)
 	{
@@ -100,6 +106,7 @@ void GbaSystem::writeConfig(ConfigType type, FileIO &io)
 		if(sensorType != GbaSensorType::Auto)
 			writeOptionValue(io, CFGKEY_SENSOR_TYPE, sensorType);
 		writeOptionValueIfNotDefault(io, useBios);
+		writeOptionValueIfNotDefault(io, skipIdleLoops);
 	}
 }
 
@@ -3,9 +3,12 @@ inc_main := 1
 
 include $(IMAGINE_PATH)/make/imagineAppBase.mk
 
+VPATH += $(EMUFRAMEWORK_PATH)/src/shared
+
 CPPFLAGS += -DHAVE_STDINT_H \
 -DGAMBATTE_NO_OSD \
 -I$(projectPath)/src \
+-I$(EMUFRAMEWORK_PATH)/src/shared \
 -I$(projectPath)/src/libgambatte/include \
 -I$(projectPath)/src/common \
 -iquote $(projectPath)/src/libgambatte/src
@@ -59,6 +62,7 @@ resample/src/kaiser70sinc.cpp
 
 gambatteCommonPath := common
 SRC +=  $(addprefix $(gambatteCommonPath)/,$(gambatteCommonSrc))
+SRC += mednafen/sound/Blip_Buffer.cpp
 
 include $(EMUFRAMEWORK_PATH)/package/emuframework.mk
 include $(IMAGINE_PATH)/make/package/zlib.mk
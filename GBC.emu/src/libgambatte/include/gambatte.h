@@ -106,6 +106,14 @@ public:
 	void refreshPalettes();
 	void setColorConversionFlags(unsigned flags);
 
+	/**
+	  * Makes runFor write the change in amplitude of each stereo sample to audioBuf instead of
+	  * the samples themselves, as two native endian 16-bit deltas packed in the low and high
+	  * halves of each element, for output with a band-limited synthesizer such as Blip_Buffer.
+	  * A negative low delta borrows from the high half.
+	  */
+	void setSoundDeltaOutput(bool enable);
+
 	/** Sets the callback used for getting input state. */
 	void setInputGetter(InputGetter *getInput);
 
@@ -170,6 +170,10 @@ void GB::setColorConversionFlags(unsigned flags) {
 	p_->cpu.setColorConversionFlags(flags);
 }
 
+void GB::setSoundDeltaOutput(bool enable) {
+	p_->cpu.setSoundDeltaOutput(enable);
+}
+
 bool GB::loadState(std::string const &filepath) {
 	if (p_->cpu.loaded()) {
 		p_->cpu.saveSavedata();
@@ -118,6 +118,7 @@ public:
 	void setGameShark(std::string const &codes) { interrupter_.setGameShark(codes); }
 	void updateInput();
 	void setColorConversionFlags(unsigned flags) { lcd_.setColorConversionFlags(flags); }
+	void setSoundDeltaOutput(bool enable) { psg_.setDeltaOutput(enable); }
 
 private:
 	Cartridge cart_;
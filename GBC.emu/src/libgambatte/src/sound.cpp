@@ -54,6 +54,7 @@ PSG::PSG()
 , soVol_(0)
 , rsum_(0x8000) // initialize to 0x8000 to prevent borrows from high word, xor away later
 , enabled_(false)
+, deltaOutput_(false)
 {
 }
 
@@ -156,6 +157,16 @@ std::size_t PSG::fillBuffer() {
 	uint_least32_t *b = buffer_;
 	std::size_t n = bufferPos_;
 
+	if (deltaOutput_) {
+		// leave the channel deltas in place, only keep the running sum
+		// so switching back to summed output doesn't offset the level
+		while (n--)
+			sum += *b++;
+
+		rsum_ = sum;
+		return bufferPos_;
+	}
+
 	if (std::size_t n2 = n >> 3) {
 		n -= n2 << 3;
 
@@ -41,6 +41,7 @@ public:
 	void speedChange(unsigned long cc, bool doubleSpeed);
 	std::size_t fillBuffer();
 	void setBuffer(uint_least32_t *buf) { buffer_ = buf; bufferPos_ = 0; }
+	void setDeltaOutput(bool enable) { deltaOutput_ = enable; }
 
 	bool isEnabled() const { return enabled_; }
 	void setEnabled(bool value) { enabled_ = value; }
@@ -85,6 +86,7 @@ private:
 	unsigned long soVol_;
 	uint_least32_t rsum_;
 	bool enabled_;
+	bool deltaOutput_;
 
 	void accumulateChannels(unsigned long cycles);
 };
@@ -53,6 +53,12 @@ void GbcSystem::applyCheats()
 {
 	if(!hasContent())
 		return;
+	applyCheats(gbEmu);
+	runAheadEmuNeedsSettings = true;
+}
+
+void GbcSystem::applyCheats(gambatte::GB &gb)
+{
 	std::string ggCodeStr, gsCodeStr;
 	for(auto &e : cheatList)
 	{
@@ -63,8 +69,8 @@ void GbcSystem::applyCheats()
 			codeStr += ';';
 		codeStr += e.code;
 	}
-	gbEmu.setGameGenie(ggCodeStr);
-	gbEmu.setGameShark(gsCodeStr);
+	gb.setGameGenie(ggCodeStr);
+	gb.setGameShark(gsCodeStr);
 	if(ggCodeStr.size())
 		logMsg("set GG codes: %s", ggCodeStr.c_str());
 	if(gsCodeStr.size())
@@ -37,7 +37,7 @@ class CustomAudioOptionView : public AudioOptionView, public MainAppHelper
 	using MainAppHelper::app;
 	using MainAppHelper::system;
 
-	StaticArrayList<TextMenuItem, MAX_RESAMPLERS> resamplerItem;
+	StaticArrayList<TextMenuItem, MAX_RESAMPLERS + 1> resamplerItem;
 
 	MultiChoiceMenuItem resampler
 	{
@@ -63,6 +63,12 @@ public:
 					app().configFrameTime();
 				});
 		}
+		resamplerItem.emplace_back("Band-limited synthesis (fastest)", attachParams(),
+			[this, i = ResamplerInfo::num()]()
+			{
+				system().optionAudioResampler = i;
+				app().configFrameTime();
+			});
 		item.emplace_back(&resampler);
 	}
 };
@@ -26,6 +26,7 @@
 #include <libgambatte/src/mem/cartridge.h>
 #include <main/Cheats.hh>
 #include <imagine/logger/logger.h>
+#include <bit>
 
 namespace EmuEx
 {
@@ -64,6 +65,12 @@ uint_least32_t GbcSystem::makeOutputColor(uint_least32_t rgb888) const
 }
 
 void GbcSystem::applyGBPalette()
+{
+	applyGBPalette(gbEmu);
+	runAheadEmuNeedsSettings = true;
+}
+
+void GbcSystem::applyGBPalette(gambatte::GB &gb)
 {
 	size_t idx = optionGBPal;
 	assert(idx < gbPalettes().size());
@@ -74,11 +81,11 @@ void GbcSystem::applyGBPalette()
 		log.info("using palette index:{}", idx);
 	const GBPalette &pal = useBuiltin ? *gameBuiltinPalette : gbPalettes()[idx];
 	for(auto i : iotaCount(4))
-		gbEmu.setDmgPaletteColor(0, i, makeOutputColor(pal.bg[i]));
+		gb.setDmgPaletteColor(0, i, makeOutputColor(pal.bg[i]));
 	for(auto i : iotaCount(4))
-		gbEmu.setDmgPaletteColor(1, i, makeOutputColor(pal.sp1[i]));
+		gb.setDmgPaletteColor(1, i, makeOutputColor(pal.sp1[i]));
 	for(auto i : iotaCount(4))
-		gbEmu.setDmgPaletteColor(2, i, makeOutputColor(pal.sp2[i]));
+		gb.setDmgPaletteColor(2, i, makeOutputColor(pal.sp2[i]));
 }
 
 void GbcSystem::reset(EmuApp &app, ResetMode mode)
@@ -162,12 +169,15 @@ void GbcSystem::closeSystem()
 	gameBuiltinPalette = nullptr;
 	totalFrames = 0;
 	totalSamples = 0;
+	runAheadEmu.reset();
+	runAheadState = {};
+	romBuff = {};
 }
 
 void GbcSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegate)
 {
 	gbEmu.setSaveDir(std::string{contentSaveDirectory()});
-	auto buff = io.buffer();
+	auto buff = io.buffer(IOBufferMode::Release);
 	if(!buff)
 	{
 		throwFileReadError();
@@ -189,6 +199,7 @@ void GbcSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegat
 	saveStateSize = 0;
 	OStream<OutSizeTracker> stream{&saveStateSize};
 	gbEmu.saveState(frameBuffer, gambatte::lcd_hres, stream);
+	romBuff = std::move(buff);
 }
 
 bool GbcSystem::onVideoRenderFormatChange(EmuVideo &video, IG::PixelFormat fmt)
@@ -212,8 +223,24 @@ bool GbcSystem::onVideoRenderFormatChange(EmuVideo &video, IG::PixelFormat fmt)
 void GbcSystem::configAudioRate(FrameTime outputFrameTime, int outputRate)
 {
 	long inputRate = gbFrameTimeSecs / duration_cast<FloatSeconds>(outputFrameTime) * 2097152.;
-	if(optionAudioResampler >= ResamplerInfo::num())
+	if(optionAudioResampler > ResamplerInfo::num())
 		optionAudioResampler = std::min(ResamplerInfo::num(), 1zu);
+	gbEmu.setSoundDeltaOutput(usesBandLimitedSynthesis());
+	if(usesBandLimitedSynthesis())
+	{
+		resampler.reset();
+		activeResampler = optionAudioResampler;
+		if(blipBuffs[0].sample_rate() != outputRate || blipBuffs[0].clock_rate() != inputRate)
+		{
+			log.info("setting up band-limited synthesis for input rate {}Hz", inputRate);
+			for(auto &buff : blipBuffs)
+			{
+				buff.set_sample_rate(outputRate, 100);
+				buff.clock_rate(inputRate);
+			}
+		}
+		return;
+	}
 	if(!resampler || optionAudioResampler != activeResampler
 		|| resampler->outRate() != outputRate  || resampler->inRate() != inputRate)
 	{
@@ -223,7 +250,7 @@ void GbcSystem::configAudioRate(FrameTime outputFrameTime, int outputRate)
 	}
 }
 
-size_t GbcSystem::runUntilVideoFrame(gambatte::uint_least32_t *videoBuf, std::ptrdiff_t pitch,
+size_t GbcSystem::runUntilVideoFrame(gambatte::GB &gb, gambatte::uint_least32_t *videoBuf, std::ptrdiff_t pitch,
 	EmuAudio *audio, gambatte::VideoFrameDelegate videoFrameCallback)
 {
 	size_t samplesEmulated = 0;
@@ -233,11 +260,20 @@ size_t GbcSystem::runUntilVideoFrame(gambatte::uint_least32_t *videoBuf, std::pt
 	{
 		std::array<uint_least32_t, samplesPerRun+2064> snd;
 		size_t samples = samplesPerRun;
-		didOutputFrame = gbEmu.runFor(videoBuf, pitch, snd.data(), samples, videoFrameCallback) != -1;
+		didOutputFrame = gb.runFor(videoBuf, pitch, snd.data(), samples, videoFrameCallback) != -1;
 		samplesEmulated += samples;
-		if(audio)
+		if(audio && !resampler)
+		{
+			writeSynthesizedFrames(*audio, snd.data(), samples);
+		}
+		else if(audio)
 		{
 			constexpr size_t buffSize = (snd.size() / (2097152./48000.) + 1); // TODO: std::ceil() is constexpr with GCC but not Clang yet
+			if(auto dest = audio->beginDirectWrite(buffSize))
+			{
+				audio->endDirectWrite(resampler->resample((short*)dest, (const short*)snd.data(), samples));
+				continue;
+			}
 			std::array<uint32_t, buffSize> destBuff;
 			unsigned destFrames = resampler->resample((short*)destBuff.data(), (const short*)snd.data(), samples);
 			assumeExpr(destFrames <= destBuff.size());
@@ -247,10 +283,84 @@ size_t GbcSystem::runUntilVideoFrame(gambatte::uint_least32_t *videoBuf, std::pt
 	return samplesEmulated;
 }
 
+bool GbcSystem::usesBandLimitedSynthesis() const
+{
+	return optionAudioResampler == ResamplerInfo::num();
+}
+
+// Turns the per-sample channel deltas from gambatte into band-limited steps at the
+// output rate, avoiding the resampler's filtering of the full ~2MHz sample stream
+void GbcSystem::writeSynthesizedFrames(EmuAudio &audio, const uint_least32_t *deltas, size_t samples)
+{
+	constexpr int loIdx = std::endian::native == std::endian::little ? 0 : 1;
+	for(auto time : iotaCount(blip_time_t(samples)))
+	{
+		auto delta = deltas[time];
+		if(!delta)
+			continue;
+		auto lo = int16_t(delta);
+		auto hi = int16_t((delta - uint32_t(lo)) >> 16);
+		if(lo)
+			blipSynth.offset_inline(time, lo, &blipBuffs[loIdx]);
+		if(hi)
+			blipSynth.offset_inline(time, hi, &blipBuffs[loIdx ^ 1]);
+	}
+	for(auto &buff : blipBuffs) { buff.end_frame(samples); }
+	audio.writeFrames(blipBuffs[0].samples_avail(), [&](void *dest, size_t frames)
+	{
+		auto destSamples = static_cast<blip_sample_t*>(dest);
+		blipBuffs[0].read_samples(&destSamples[0], frames, true);
+		blipBuffs[1].read_samples(&destSamples[1], frames, true);
+		return frames;
+	});
+}
+
+// Renders the next frame straight into the locked video texture if it's in the same 32-bit format
+// as gambatte's output, otherwise into frameBuffer and copies or converts it from there
+size_t GbcSystem::runUntilVideoFrame(gambatte::GB &gb, const EmuSystemTaskContext &taskCtx, EmuVideo &video, EmuAudio *audio)
+{
+	auto fmt = videoFormat(video);
+	if(video.renderPixelFormat() == fmt)
+	{
+		auto img = video.startFrameWithFormat(taskCtx, {lcdSize, fmt});
+		if(img)
+		{
+			// the texture stays locked until emulation stops since the PPU keeps its
+			// pointer and can start the next frame's lines in the rest of the run
+			auto pix = img.pixmap();
+			size_t samples;
+			if(pix.format() == fmt && !(pix.pitchBytes() % sizeof(uint_least32_t)) &&
+				!(uintptr_t(pix.data()) % alignof(uint_least32_t)))
+			{
+				frameBufferIsCurrent = false;
+				samples = runUntilVideoFrame(gb, static_cast<uint_least32_t*>(pix.data()), pix.pitchPx(), audio, {});
+			}
+			else
+			{
+				frameBufferIsCurrent = true;
+				samples = runUntilVideoFrame(gb, frameBuffer, gambatte::lcd_hres, audio, {});
+				pix.writeConverted(IG::PixmapView{{lcdSize, fmt}, frameBuffer});
+			}
+			img.endFrame();
+			return samples;
+		}
+	}
+	frameBufferIsCurrent = true;
+	return runUntilVideoFrame(gb, frameBuffer, gambatte::lcd_hres, audio,
+		[this, &taskCtx, &video]()
+		{
+			renderVideo(taskCtx, video);
+		});
+}
+
+IG::PixelFormat GbcSystem::videoFormat(const EmuVideo &video) const
+{
+	return video.renderPixelFormat() == IG::PixelFmtBGRA8888 ? IG::PixelFmtBGRA8888 : IG::PixelFmtRGBA8888;
+}
+
 void GbcSystem::renderVideo(const EmuSystemTaskContext &taskCtx, EmuVideo &video)
 {
-	auto fmt = video.renderPixelFormat() == IG::PixelFmtBGRA8888 ? IG::PixelFmtBGRA8888 : IG::PixelFmtRGBA8888;
-	IG::PixmapView frameBufferPix{{lcdSize, fmt}, frameBuffer};
+	IG::PixmapView frameBufferPix{{lcdSize, videoFormat(video)}, frameBuffer};
 	video.startFrameWithAltFormat(taskCtx, frameBufferPix);
 }
 
@@ -267,23 +377,82 @@ void GbcSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio
 	}
 	if(video)
 	{
-		totalSamples += runUntilVideoFrame(frameBuffer, gambatte::lcd_hres, audio,
-			[this, &taskCtx, video]()
-			{
-				renderVideo(taskCtx, *video);
-			});
+		totalSamples += runUntilVideoFrame(gbEmu, taskCtx, *video, audio);
 	}
 	else
 	{
-		totalSamples += runUntilVideoFrame(nullptr, gambatte::lcd_hres, audio, {});
+		totalSamples += runUntilVideoFrame(gbEmu, nullptr, gambatte::lcd_hres, audio, {});
 	}
 }
 
 void GbcSystem::renderFramebuffer(EmuVideo &video)
 {
+	if(!frameBufferIsCurrent)
+	{
+		// the last frame only exists in the old texture, emulate the next one into
+		// frameBuffer from a copy of the current state so there's something to show
+		log.info("re-rendering frame from current state");
+		auto state = dynArrayForOverwrite<uint8_t>(saveStateSize);
+		{
+			OStream<MapIO> stream{state};
+			gbEmu.saveState(frameBuffer, gambatte::lcd_hres, stream);
+		}
+		runUntilVideoFrame(gbEmu, frameBuffer, gambatte::lcd_hres, nullptr, {});
+		{
+			IStream<MapIO> stream{state};
+			gbEmu.loadState(stream);
+		}
+		frameBufferIsCurrent = true;
+	}
 	renderVideo({}, video);
 }
 
+void GbcSystem::applyRunAheadEmuSettings()
+{
+	runAheadEmuNeedsSettings = false;
+	if(!runAheadEmu->isCgb())
+		applyGBPalette(*runAheadEmu);
+	runAheadEmu->setColorConversionFlags(colorConversionFlags());
+	runAheadEmu->refreshPalettes();
+	applyCheats(*runAheadEmu);
+}
+
+void GbcSystem::runAheadFrames(EmuSystemTaskContext taskCtx, EmuVideo &video, int frames)
+{
+	assert(frames > 0);
+	if(!runAheadEmu)
+	{
+		log.info("creating run-ahead instance");
+		runAheadEmu = std::make_unique<gambatte::GB>();
+		runAheadEmu->setInputGetter(&gbcInput);
+		if(auto result = runAheadEmu->load(romBuff.data(), romBuff.size(), contentFileName().data(), optionReportAsGba ? gbEmu.GBA_CGB : 0);
+			result != gambatte::LOADRES_OK)
+		{
+			runAheadEmu.reset();
+			throw std::runtime_error(gambatte::to_string(result));
+		}
+		runAheadState = dynArrayForOverwrite<uint8_t>(saveStateSize);
+		runAheadEmuNeedsSettings = true;
+	}
+	if(runAheadEmuNeedsSettings)
+		applyRunAheadEmuSettings();
+	// copy the primary state without touching its audio/video output
+	{
+		OStream<MapIO> stream{runAheadState};
+		gbEmu.saveState(frameBuffer, gambatte::lcd_hres, stream);
+	}
+	{
+		IStream<MapIO> stream{runAheadState};
+		if(!runAheadEmu->loadState(stream))
+			throw std::runtime_error("Invalid run-ahead state data");
+	}
+	for(auto i : iotaCount(frames - 1))
+	{
+		runUntilVideoFrame(*runAheadEmu, nullptr, gambatte::lcd_hres, nullptr, {});
+	}
+	runUntilVideoFrame(*runAheadEmu, taskCtx, video, nullptr);
+}
+
 void EmuApp::onCustomizeNavView(EmuApp::NavView &view)
 {
 	const Gfx::LGradientStopDesc navViewGrad[] =
@@ -296,14 +465,20 @@ void EmuApp::onCustomizeNavView(EmuApp::NavView &view)
 	view.setBackgroundGradient(navViewGrad);
 }
 
-void GbcSystem::updateColorConversionFlags()
+unsigned GbcSystem::colorConversionFlags() const
 {
 	unsigned flags{};
 	if(optionFullGbcSaturation)
 		flags |= COLOR_CONVERSION_SATURATED_BIT;
 	if(useBgrOrder)
 		flags |= COLOR_CONVERSION_BGR_BIT;
-	gbEmu.setColorConversionFlags(flags);
+	return flags;
+}
+
+void GbcSystem::updateColorConversionFlags()
+{
+	gbEmu.setColorConversionFlags(colorConversionFlags());
+	runAheadEmuNeedsSettings = true;
 }
 
 void GbcSystem::refreshPalettes()
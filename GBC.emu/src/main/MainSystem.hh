@@ -21,7 +21,11 @@
 #include <gambatte.h>
 #include <libgambatte/src/video/lcddef.h>
 #include <resample/resampler.h>
+#include <mednafen/sound/Blip_Buffer.h>
 #include <imagine/fs/FS.hh>
+#include <imagine/io/IOUtils.hh>
+#include <imagine/util/memory/DynArray.hh>
+#include <array>
 #include <memory>
 
 namespace EmuEx
@@ -53,15 +57,23 @@ public:
 	gambatte::GB gbEmu;
 	GbcInput gbcInput;
 	std::unique_ptr<Resampler> resampler;
+	// used instead of the resampler when usesBandLimitedSynthesis()
+	std::array<Blip_Buffer, 2> blipBuffs;
+	Blip_Synth<blip_good_quality, 0x10000> blipSynth;
 	const GBPalette *gameBuiltinPalette{};
 	FileIO saveFileIO;
 	FileIO rtcFileIO;
 	std::string cheatsDir;
+	std::unique_ptr<gambatte::GB> runAheadEmu;
+	IOBuffer romBuff; // kept to load the run-ahead instance
+	DynArray<uint8_t> runAheadState;
 	size_t saveStateSize{};
 	uint64_t totalSamples{};
 	uint32_t totalFrames{};
 	uint8_t activeResampler = 1;
 	bool useBgrOrder{};
+	bool runAheadEmuNeedsSettings{};
+	bool frameBufferIsCurrent{true}; // false after a frame was rendered straight into the video texture
 	alignas(8) uint_least32_t frameBuffer[gambatte::lcd_hres * gambatte::lcd_vres];
 
 	Property<uint8_t, CFGKEY_GB_PAL_IDX,
@@ -79,9 +91,12 @@ public:
 		EmuSystem{ctx}
 	{
 		gbEmu.setInputGetter(&gbcInput);
+		blipSynth.volume(1.);
 	}
 	void applyGBPalette();
+	bool usesBandLimitedSynthesis() const;
 	void applyCheats();
+	void applyCheats(gambatte::GB &);
 	void refreshPalettes();
 
 	// required API functions
@@ -111,12 +126,19 @@ public:
 	bool resetSessionOptions(EmuApp &);
 	bool onVideoRenderFormatChange(EmuVideo &, IG::PixelFormat);
 	void renderFramebuffer(EmuVideo &);
+	void runAheadFrames(EmuSystemTaskContext, EmuVideo &, int frames);
 
 protected:
 	uint_least32_t makeOutputColor(uint_least32_t rgb888) const;
-	size_t runUntilVideoFrame(gambatte::uint_least32_t *videoBuf, std::ptrdiff_t pitch,
+	void applyGBPalette(gambatte::GB &);
+	void applyRunAheadEmuSettings();
+	size_t runUntilVideoFrame(gambatte::GB &, gambatte::uint_least32_t *videoBuf, std::ptrdiff_t pitch,
 		EmuAudio *audio, gambatte::VideoFrameDelegate videoFrameCallback);
+	size_t runUntilVideoFrame(gambatte::GB &, const EmuSystemTaskContext &, EmuVideo &, EmuAudio *);
+	void writeSynthesizedFrames(EmuAudio &, const uint_least32_t *deltas, size_t samples);
 	void renderVideo(const EmuSystemTaskContext &taskCtx, EmuVideo &video);
+	IG::PixelFormat videoFormat(const EmuVideo &) const;
+	unsigned colorConversionFlags() const;
 	void updateColorConversionFlags();
 };
 
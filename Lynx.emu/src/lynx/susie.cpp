@@ -626,6 +626,9 @@ uint32 CSusie::PaintSprites(void)
 
 				if(render)
 				{
+					// Non-zero if whole runs of scaled pixels can be written at once
+					const uint32 span_mask=SpanPixelMask();
+
 					// Set the vertical position & offset
 					voff=(int16)mVPOSSTRT.Val16-screen_v_start;
 
@@ -704,6 +707,32 @@ uint32 CSusie::PaintSprites(void)
 									pixel_width=mHSIZACUM.Union8.High;
 									mHSIZACUM.Union8.High=0;
 
+									if(span_mask)
+									{
+										// Same result as the per-pixel loop below, but the
+										// visible part of the run is written in one go
+										int run=pixel_width;
+										if(!onscreen)
+										{
+											int lead;
+											if(hsign==1) lead=(hoff<0)?-hoff:((hoff>=SCREEN_WIDTH)?run:0);
+											else lead=(hoff>=SCREEN_WIDTH)?hoff-SCREEN_WIDTH+1:((hoff<0)?run:0);
+											if(lead>run) lead=run;
+											hoff+=lead*hsign;
+											run-=lead;
+										}
+										int visible=0;
+										if(hoff>=0 && hoff<SCREEN_WIDTH) visible=(hsign==1)?SCREEN_WIDTH-hoff:hoff+1;
+										if(visible>run) visible=run;
+										if(visible>0)
+										{
+											if(span_mask&(1<<pixel)) WritePixelSpan((hsign==1)?hoff:hoff-visible+1,visible,pixel);
+											onscreen = true;
+											everonscreen = true;
+											hoff+=visible*hsign;
+										}
+									}
+									else
 									for(hloop=0;hloop<pixel_width;hloop++)
 									{
 										// Draw if onscreen but break loop on transition to offscreen
@@ -865,6 +894,25 @@ INLINE void CSusie::WritePixel(uint32 hoff,uint32 pixel)
         cycles_used+=2*SPR_RDWR_CYC;
 }
 
+// Writes count pixels from hoff onwards, cycle count is the same as count WritePixel() calls
+INLINE void CSusie::WritePixelSpan(uint32 hoff,uint32 count,uint32 pixel)
+{
+        if(hoff&0x01)
+        {
+                WritePixel(hoff++,pixel);
+                count--;
+        }
+
+        const uint8 pair=(pixel<<4)|pixel;
+        for(;count>=2;count-=2,hoff+=2)
+        {
+                RAM_POKE(mLineBaseAddress+(hoff/2),pair);
+                cycles_used+=4*SPR_RDWR_CYC;
+        }
+
+        if(count) WritePixel(hoff,pixel);
+}
+
 INLINE uint32 CSusie::ReadPixel(uint32 hoff)
 {
         const uint16 scr_addr=mLineBaseAddress+(hoff/2);
@@ -999,6 +1047,32 @@ INLINE uint32 CSusie::LineGetBits(uint32 bits)
 //                        1 0 0 0 0 0 0 0   exclusive-or the data 
 //
 
+// Returns a mask of the pixel values the current sprite draws if it needs neither
+// the collision buffer nor the screen contents, so runs of a pixel can be written
+// with WritePixelSpan(), otherwise 0 and ProcessPixel() must be used
+uint32 CSusie::SpanPixelMask(void)
+{
+	const bool nocollide=mSPRCOLL_Collide || mSPRSYS_NoCollide;
+	switch(mSPRCTL0_Type)
+	{
+		case sprite_background_noncollide:
+			return 0xffff;
+		case sprite_noncollide:
+			return 0xfffe;
+		case sprite_background_shadow:
+			return nocollide?0xffff:0;
+		case sprite_normal:
+		case sprite_shadow:
+			return nocollide?0xfffe:0;
+		case sprite_boundary:
+			return nocollide?0x7ffe:0;
+		case sprite_boundary_shadow:
+			return nocollide?0x3ffe:0;
+		default:
+			return 0;
+	}
+}
+
 //inline 
 void CSusie::ProcessPixel(uint32 hoff,uint32 pixel)
 {
@@ -339,6 +339,8 @@ class CSusie : public CLynxBase
 
 		void	ProcessPixel(uint32 hoff,uint32 pixel);
 		void	WritePixel(uint32 hoff,uint32 pixel);
+		void	WritePixelSpan(uint32 hoff,uint32 count,uint32 pixel);
+		uint32	SpanPixelMask(void);
 		uint32	ReadPixel(uint32 hoff);
 		void	WriteCollision(uint32 hoff,uint32 pixel);
 		uint32	ReadCollision(uint32 hoff);
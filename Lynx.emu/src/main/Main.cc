@@ -37,6 +37,7 @@ namespace EmuEx
 
 constexpr SystemLogger log{"Lynx.emu"};
 const char *EmuSystem::creditsViewStr = CREDITS_INFO_STRING "(c) 2011-2024\nRobert Broglia\nwww.explusalpha.com\n\nPortions (c) the\nMednafen Team\nmednafen.github.io";
+bool EmuSystem::hasGzipStates = true;
 bool EmuApp::needsGlobalInstance = true;
 
 EmuSystem::NameFilterFunc EmuSystem::defaultFsFilter =
@@ -111,7 +112,7 @@ void LynxSystem::configAudioRate(FrameTime outputFrameTime, int outputRate)
 void LynxSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio)
 {
 	static constexpr size_t maxAudioFrames = 48000 / 20; // May output a large amount of audio samples during boot
-	EmuEx::runFrame(*this, mdfnGameInfo, taskCtx, video, mSurfacePix, audio, maxAudioFrames);
+	EmuEx::runFrame(*this, mdfnGameInfo, taskCtx, video, mSurfacePix, audio, maxAudioFrames, 0, true);
 	if(configuredHCount != Lynx_HCount()) [[unlikely]]
 	{
 		onFrameTimeChanged();
@@ -155,7 +156,7 @@ namespace Mednafen
 
 void MDFND_commitVideoFrame(EmulateSpecStruct *espec)
 {
-	espec->video->startFrameWithFormat(espec->taskCtx, static_cast<EmuEx::LynxSystem&>(*espec->sys).mSurfacePix);
+	EmuEx::commitVideoFrame(*espec, static_cast<EmuEx::LynxSystem&>(*espec->sys).mSurfacePix);
 }
 
 }
@@ -24,6 +24,7 @@
 #include "shared.h"
 #include "vdp_render.h"
 #include <imagine/pixmap/Pixmap.hh>
+#include <emuframework/StageProfiler.hh>
 
 #ifdef NGC
 #include "md_ntsc.h"
@@ -3705,6 +3706,7 @@ void render_reset(void)
 
 void render_line(int line, IG::MutablePixmapView pix)
 {
+  EmuEx::ScopedStageTimer stageTimer{EmuEx::ProfileStage::video};
   int width = bitmap.viewport.w;
 
   /* Check display status */
@@ -97,6 +97,7 @@ const char *EmuSystem::systemName() const
 }
 
 EmuSystem::NameFilterFunc EmuSystem::defaultFsFilter = hasMDWithCDExtension;
+EmuSystem::NameFilterFunc EmuSystem::uncachedArchiveEntryFilter = hasMDCDExtension;
 
 void MdSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio)
 {
@@ -104,8 +105,18 @@ void MdSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio
 	system_frame(taskCtx, video);
 
 	int16 audioBuff[snd.buffer_size * 2];
-	int frames = audio_update(audioBuff);
-	if(audio)
+	// mix straight into the audio output when it has room for a full update
+	auto directBuff = audio ? static_cast<int16*>(audio->beginDirectWrite(snd.buffer_size)) : nullptr;
+	int frames = [&]
+	{
+		ScopedStageTimer stageTimer{ProfileStage::sound};
+		return audio_update(directBuff ? directBuff : audioBuff);
+	}();
+	if(directBuff)
+	{
+		audio->endDirectWrite(frames);
+	}
+	else if(audio)
 	{
 		audio->writeFrames(audioBuff, frames);
 	}
@@ -155,6 +166,17 @@ size_t MdSystem::writeState(std::span<uint8_t> buff, SaveStateFlags flags)
 	return state_save(buff.data(), flags.uncompressed);
 }
 
+void MdSystem::forEachStateSection(StateSectionDelegate del)
+{
+	del({"68k-ram", work_ram, 0xFF0000});
+	del({"z80-ram", zram, 0xA00000});
+	del({"vdp-regs", vdp.reg});
+	del({"vram", vdp.vram.b});
+	del({"cram", vdp.cram.b});
+	del({"vsram", vdp.vsram.b});
+	del({"sat", vdp.sat.b});
+}
+
 static bool sramHasContent(std::span<uint8> sram)
 {
 	for(auto v : sram)
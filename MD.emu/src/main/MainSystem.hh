@@ -103,6 +103,7 @@ public:
 		Input::DragTrackerState prevDragState, IG::WindowRect gameRect);
 	bool onPointerInputEnd(const Input::MotionEvent &, Input::DragTrackerState, IG::WindowRect gameRect);
 	VideoSystem videoSystem() const;
+	void forEachStateSection(StateSectionDelegate);
 
 private:
 	void setupSmsInput(EmuApp &);
@@ -9,6 +9,8 @@
 #include <imagine/logger/logger.h>
 #include <imagine/util/mayAliasInt.h>
 #include <string.h>
+#include <array>
+#include <utility>
 
 static const int Table_Rot_Time[] =
 {
@@ -84,7 +86,10 @@ static void gfx_completed(Rot_Comp &rot_comp)
 }
 
 
-static void gfx_do(Rot_Comp &rot_comp, unsigned int func, unsigned short *stamp_base, unsigned int H_Dot)
+// func is a template parameter so the per-dot mode tests on it fold away,
+// gfx_cd_update() selects the instance once per operation from gfx_do_funcs
+template <unsigned int func>
+static void gfx_do(Rot_Comp &rot_comp, unsigned short *stamp_base, unsigned int H_Dot)
 {
 	//logMsg("func 0x%X", func);
 	unsigned int eax, ebx, ecx, edx, esi, edi, pixel;
@@ -296,6 +301,17 @@ Next_Pixel:
 }
 
 
+typedef void (*GfxDoFunc)(Rot_Comp &, unsigned short *, unsigned int);
+
+template <size_t... funcs>
+static constexpr std::array<GfxDoFunc, sizeof...(funcs)> makeGfxDoFuncs(std::index_sequence<funcs...>)
+{
+	return {gfx_do<funcs>...};
+}
+
+// indexed by rot_comp.Function: stamp size & screen bits (0-7) | priority mode (0x18)
+static constexpr auto gfx_do_funcs = makeGfxDoFuncs(std::make_index_sequence<0x20>{});
+
 void gfx_cd_update(Rot_Comp &rot_comp)
 {
 	int V_Dot = rot_comp.imgBuffVDotSize & 0xff;
@@ -323,14 +339,14 @@ void gfx_cd_update(Rot_Comp &rot_comp)
 	const bool gfxSupported = 1;
 	if (gfxSupported)
 	{
-		unsigned int func = rot_comp.Function;
+		GfxDoFunc gfx_do_func = gfx_do_funcs[rot_comp.Function & 0x1f];
 		unsigned int H_Dot = rot_comp.imgBuffHDotSize & 0x1ff;
 		unsigned short *stamp_base = (unsigned short *) (sCD.word.ram2M + rot_comp.Stamp_Map_Adr);
 
 		//logMsg("%d gfx jobs", jobs);
 		while (jobs--)
 		{
-			gfx_do(rot_comp, func, stamp_base, H_Dot);	// jmp [Jmp_Adr]:
+			gfx_do_func(rot_comp, stamp_base, H_Dot);	// jmp [Jmp_Adr]:
 
 			V_Dot--;				// dec byte [V_Dot]
 			if (V_Dot == 0)
@@ -33,6 +33,7 @@
 #include <stdio.h>
 #include <math.h>
 #include <assert.h>
+#include <string.h>
 
 #define BITSPERSAMPLE     16
 
@@ -117,6 +118,8 @@ struct Mixer
     UInt32 index;
     UInt32 volIndex;
     Int16   buffer[AUDIO_STEREO_BUFFER_SIZE];
+    Int32   mixLeft[AUDIO_MONO_BUFFER_SIZE];
+    Int32   mixRight[AUDIO_MONO_BUFFER_SIZE];
     AudioTypeInfo audioTypeInfo[MIXER_CHANNEL_TYPE_COUNT];
     MixerChannel channels[MAX_CHANNELS];
     MixerChannel midi; // This channel is only used for meter output
@@ -505,90 +508,127 @@ void mixerSync(Mixer* mixer)
         }
     }
 
+    /* Mix one channel at a time over the whole block so the inner loops
+     * vectorize, then scale and clip the sums in a single pass.
+     */
+    memset(mixer->mixLeft, 0, count * sizeof(Int32));
     if (mixer->stereo) {
-        while (count--) {
-            Int32 left = 0;
-            Int32 right = 0;
+        memset(mixer->mixRight, 0, count * sizeof(Int32));
+    }
 
-            for (i = 0; i < mixer->channelCount; i++) {
-                Int32 chanLeft;
-                Int32 chanRight;
+    for (i = 0; i < mixer->channelCount; i++) {
+        Int32* src      = chBuff[i];
+        Int32* mixLeft  = mixer->mixLeft;
+        Int32* mixRight = mixer->mixRight;
+        Int32 volLeft   = mixer->channels[i].volumeLeft;
+        Int32 volRight  = mixer->channels[i].volumeRight;
+        Int32 cntLeft   = 0;
+        Int32 cntRight  = 0;
+        UInt32 j;
+
+        if (src == NULL) {
+            continue;
+        }
 
-                if (chBuff[i] == NULL) {
-                    continue;
-                }
+        if (mixer->stereo) {
+            if (mixer->channels[i].stereo) {
+                for (j = 0; j < count; j++) {
+                    Int32 chanLeft  = volLeft  * src[2 * j];
+                    Int32 chanRight = volRight * src[2 * j + 1];
 
-                if (mixer->channels[i].stereo) {
-                    chanLeft = mixer->channels[i].volumeLeft * *chBuff[i]++;
-                    chanRight = mixer->channels[i].volumeRight * *chBuff[i]++;
+                    cntLeft  += (chanLeft  > 0 ? chanLeft  : -chanLeft)  / 2048;
+                    cntRight += (chanRight > 0 ? chanRight : -chanRight) / 2048;
+                    mixLeft[j]  += chanLeft;
+                    mixRight[j] += chanRight;
                 }
-                else {
-                    Int32 tmp = *chBuff[i]++;
-                    chanLeft = mixer->channels[i].volumeLeft * tmp;
-                    chanRight = mixer->channels[i].volumeRight * tmp;
+                chBuff[i] = src + 2 * count;
+            }
+            else {
+                for (j = 0; j < count; j++) {
+                    Int32 chanLeft  = volLeft  * src[j];
+                    Int32 chanRight = volRight * src[j];
+
+                    cntLeft  += (chanLeft  > 0 ? chanLeft  : -chanLeft)  / 2048;
+                    cntRight += (chanRight > 0 ? chanRight : -chanRight) / 2048;
+                    mixLeft[j]  += chanLeft;
+                    mixRight[j] += chanRight;
                 }
+                chBuff[i] = src + count;
+            }
+        }
+        else {
+            if (mixer->channels[i].stereo) {
+                for (j = 0; j < count; j++) {
+                    Int32 chanLeft = volLeft * (src[2 * j] + src[2 * j + 1]) / 2;
 
-                mixer->channels[i].volCntLeft  += (chanLeft  > 0 ? chanLeft  : -chanLeft)  / 2048;
-                mixer->channels[i].volCntRight += (chanRight > 0 ? chanRight : -chanRight) / 2048;
+                    cntLeft += (chanLeft > 0 ? chanLeft : -chanLeft) / 2048;
+                    mixLeft[j] += chanLeft;
+                }
+                chBuff[i] = src + 2 * count;
+            }
+            else {
+                for (j = 0; j < count; j++) {
+                    Int32 chanLeft = volLeft * src[j];
 
-                left  += chanLeft;
-                right += chanRight;
+                    cntLeft += (chanLeft > 0 ? chanLeft : -chanLeft) / 2048;
+                    mixLeft[j] += chanLeft;
+                }
+                chBuff[i] = src + count;
             }
+            cntRight = cntLeft;
+        }
 
-            left  /= 4096;
-            right /= 4096;
+        mixer->channels[i].volCntLeft  += cntLeft;
+        mixer->channels[i].volCntRight += cntRight;
+    }
 
-            mixer->volCntLeft  += left  > 0 ? left  : -left;
-            mixer->volCntRight += right > 0 ? right : -right;
+    if (mixer->stereo) {
+        Int16* out = buffer + mixer->index;
+        Int32 cntLeft  = 0;
+        Int32 cntRight = 0;
+        UInt32 j;
+
+        for (j = 0; j < count; j++) {
+            Int32 left  = mixer->mixLeft[j]  / 4096;
+            Int32 right = mixer->mixRight[j] / 4096;
+
+            cntLeft  += left  > 0 ? left  : -left;
+            cntRight += right > 0 ? right : -right;
 
             if (left  >  32767) { left  = 32767; }
             if (left  < -32767) { left  = -32767; }
             if (right >  32767) { right = 32767; }
             if (right < -32767) { right = -32767; }
 
-            buffer[mixer->index++] = (Int16)left;
-            buffer[mixer->index++] = (Int16)right;
-
-            mixer->volIndex++;
+            out[2 * j]     = (Int16)left;
+            out[2 * j + 1] = (Int16)right;
         }
+
+        mixer->volCntLeft  += cntLeft;
+        mixer->volCntRight += cntRight;
+        mixer->index += 2 * count;
     }
     else {
-        while (count--) {
-            Int32 left = 0;
+        Int16* out = buffer + mixer->index;
+        Int32 cntLeft = 0;
+        UInt32 j;
 
-            for (i = 0; i < mixer->channelCount; i++) {
-                Int32 chanLeft;
+        for (j = 0; j < count; j++) {
+            Int32 left = mixer->mixLeft[j] / 4096;
 
-                if (chBuff[i] == NULL) {
-                    continue;
-                }
-
-                if (mixer->channels[i].stereo) {
-                    Int32 tmp = *chBuff[i]++;
-                    chanLeft = mixer->channels[i].volumeLeft * (tmp + *chBuff[i]++) / 2;
-                }
-                else {
-                    chanLeft = mixer->channels[i].volumeLeft * *chBuff[i]++;
-                }
-            
-                mixer->channels[i].volCntLeft  += (chanLeft > 0 ? chanLeft : -chanLeft) / 2048;
-                mixer->channels[i].volCntRight += (chanLeft > 0 ? chanLeft : -chanLeft) / 2048;
-                left  += chanLeft;
-            }
-
-            left  /= 4096;
-
-            mixer->volCntLeft  += left > 0 ? left : -left;
-            mixer->volCntRight += left > 0 ? left : -left;
+            cntLeft += left > 0 ? left : -left;
 
             if (left  >  32767) left  = 32767;
             if (left  < -32767) left  = -32767;
 
-            buffer[mixer->index++] = (Int16)left;
-
-            mixer->volIndex++;
+            out[j] = (Int16)left;
         }
+
+        mixer->volCntLeft  += cntLeft;
+        mixer->volCntRight += cntLeft;
+        mixer->index += count;
     }
+    mixer->volIndex += count;
 
     flushMixerSamples(mixer, buffer);
 
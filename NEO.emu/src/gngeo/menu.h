@@ -25,6 +25,8 @@ enum { PBAR_ACTION_LOADROM, PBAR_ACTION_DECRYPT, PBAR_ACTION_LOADGNO, PBAR_ACTIO
 void gn_init_pbar(unsigned action,int size);
 void gn_update_pbar(int pos);
 void gn_terminate_pbar(void);
+// runs func over sub-ranges of [begin, end) on the frontend's worker threads and waits for them
+void gn_parallel_for(unsigned begin, unsigned end, void (*func)(void *data, unsigned begin, unsigned end), void *data);
 
 void gn_popup_error(char *name,char *fmt,...);
 int gn_popup_question(char *name,char *fmt,...);
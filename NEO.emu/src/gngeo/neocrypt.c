@@ -533,36 +533,42 @@ static void decrypt(UINT8 *r0, UINT8 *r1,
 
 #include <stdio.h>
 
-
-static void neogeo_gfx_decrypt(running_machine *machine, int extra_xor)
+typedef struct
 {
 	UINT8 *buf;
 	UINT8 *rom;
-	unsigned rpos;
-	const unsigned rom_size = memory_region_length(machine, "sprites");
+	unsigned rom_size;
+	int extra_xor;
+} gfx_decrypt_data;
 
-	buf = alloc_array_or_die(UINT8, rom_size);
+// Each 32-bit word decrypts independently and the address pass is a permutation,
+// so both passes can be split into ranges and run in parallel
+static void gfx_data_xor(void *dataPtr, unsigned begin, unsigned end)
+{
+	gfx_decrypt_data *data = dataPtr;
+	UINT8 *buf = data->buf;
+	const UINT8 *rom = data->rom;
+	unsigned rpos;
 
-	rom = memory_region(machine, "sprites");
-	const unsigned pbarUpdateCount = 20;
-	const unsigned pbarSteps = (rom_size/4)/pbarUpdateCount;
-	gn_init_pbar(PBAR_ACTION_DECRYPT, rom_size/2);
-	// Data xor
-	for (rpos = 0;rpos < rom_size/4;rpos++)
+	for (rpos = begin;rpos < end;rpos++)
 	{
 		decrypt(buf+4*rpos+0, buf+4*rpos+3, rom[4*rpos+0], rom[4*rpos+3], type0_t03, type0_t12, type1_t03, rpos, (rpos>>8) & 1);
 		decrypt(buf+4*rpos+1, buf+4*rpos+2, rom[4*rpos+1], rom[4*rpos+2], type0_t12, type0_t03, type1_t12, rpos, ((rpos>>16) ^ address_16_23_xor2[(rpos>>8) & 0xff]) & 1);
-		if (rpos % pbarSteps == 0) {
-			gn_update_pbar(rpos);
-		}
 	}
-	// Address xor
-	for (rpos = 0;rpos < rom_size/4;rpos++)
+}
+
+static void gfx_address_xor(void *dataPtr, unsigned begin, unsigned end)
+{
+	gfx_decrypt_data *data = dataPtr;
+	const UINT8 *buf = data->buf;
+	UINT8 *rom = data->rom;
+	const unsigned rom_size = data->rom_size;
+	const int extra_xor = data->extra_xor;
+	unsigned rpos;
+
+	for (rpos = begin;rpos < end;rpos++)
 	{
 		int baser;
-		if (rpos % pbarSteps == 0) {
-			gn_update_pbar(rpos + (rom_size >> 2));
-		}
 		baser = rpos;
 
 		baser ^= extra_xor;
@@ -596,8 +602,36 @@ static void neogeo_gfx_decrypt(running_machine *machine, int extra_xor)
 		rom[4*rpos+2] = buf[4*baser+2];
 		rom[4*rpos+3] = buf[4*baser+3];
 	}
+}
+
+static void neogeo_gfx_decrypt(running_machine *machine, int extra_xor)
+{
+	gfx_decrypt_data data;
+	unsigned rpos;
+	const unsigned rom_size = memory_region_length(machine, "sprites");
+	const unsigned words = rom_size/4;
+
+	data.buf = alloc_array_or_die(UINT8, rom_size);
+	data.rom = memory_region(machine, "sprites");
+	data.rom_size = rom_size;
+	data.extra_xor = extra_xor;
+	const unsigned pbarUpdateCount = 20;
+	const unsigned pbarSteps = words/pbarUpdateCount ? words/pbarUpdateCount : 1;
+	gn_init_pbar(PBAR_ACTION_DECRYPT, rom_size/2);
+	// Data xor
+	for (rpos = 0;rpos < words;rpos += pbarSteps)
+	{
+		gn_update_pbar(rpos);
+		gn_parallel_for(rpos, rpos + pbarSteps < words ? rpos + pbarSteps : words, gfx_data_xor, &data);
+	}
+	// Address xor
+	for (rpos = 0;rpos < words;rpos += pbarSteps)
+	{
+		gn_update_pbar(rpos + (rom_size >> 2));
+		gn_parallel_for(rpos, rpos + pbarSteps < words ? rpos + pbarSteps : words, gfx_address_xor, &data);
+	}
 	gn_terminate_pbar();
-	free(buf);
+	free(data.buf);
 }
 
 
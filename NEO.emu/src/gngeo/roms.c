@@ -1102,13 +1102,24 @@ static int convert_roms_tile(Uint8 *g, int tileno) {
 
 }
 
+// each usage word covers 16 tiles, so ranges of whole words convert independently
+static void convert_tile_range(void *data, unsigned begin, unsigned end) {
+	GAME_ROMS *r = data;
+	Uint32 tiles = r->tiles.size >> 7;
+	Uint32 i, j;
+	for (i = begin; i < end; i++) {
+		Uint32 usage = 0;
+		for (j = i << 4; j < ((i + 1) << 4) && j < tiles; j++) {
+			usage |= convert_roms_tile(r->tiles.p, j);
+		}
+		((Uint32*) r->spr_usage.p)[i] = usage;
+	}
+}
+
 void convert_all_tile(GAME_ROMS *r) {
-	Uint32 i;
 	allocate_region(&r->spr_usage, (r->tiles.size >> 11) * sizeof (Uint32), REGION_SPR_USAGE);
 	memset(r->spr_usage.p, 0, r->spr_usage.size);
-	for (i = 0; i < r->tiles.size >> 7; i++) {
-		((Uint32*) r->spr_usage.p)[i >> 4] |= convert_roms_tile(r->tiles.p, i);
-	}
+	gn_parallel_for(0, ((r->tiles.size >> 7) + 15) >> 4, convert_tile_range, r);
 }
 
 void convert_all_char(Uint8 *Ptr, int Taille,
@@ -29,6 +29,13 @@
 #include "transpack.h"
 #include "screen.h"
 #include <imagine/logger/logger.h>
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#define SIMD_TILE 1
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#define SIMD_TILE 1
+#endif
 
 extern int neogeo_fix_bank_type;
 unsigned int neogeo_frame_counter;
@@ -253,6 +260,100 @@ static void fix_value_init(void) {
 #define PUTPIXEL(dst,src) dst=BLEND16_25(src,dst)
 #include "video_template.h"
 
+#ifdef SIMD_TILE
+/* Opaque tile drawing with vector table lookups, 16 pixels per line:
+   the 4-bit pen indices go through a byte shuffle into the low and
+   high bytes of the 16 palette colors, and pen 0 stays transparent.
+   X zoom compacts the pen indices with a shuffle built from dda_x_skip,
+   unused lanes become pen 0 so the destination is left unchanged. */
+static void draw_tile_simd(unsigned int tileno, int sx, int sy, int zx, int zy,
+		int color, int xflip, int yflip, unsigned char *bmp)
+{
+	Uint32 *paldata = &current_pc_pal[16 * color];
+	Uint8 palLo[16], palHi[16], zoomShuf[16];
+	int pitch = buffer->pitch >> 1;
+	char *l_y_skip = zy == 16 ? full_y_skip : dda_y_skip;
+	Uint32 *gfxdata;
+	Uint16 *br;
+	int i, y;
+
+	tileno = tileno % memory.nb_of_tiles;
+	gfxdata = (Uint32 *)&memory.rom.tiles.p[tileno << 7];
+	for (i = 0; i < 16; i++) {
+		palLo[i] = paldata[i];
+		palHi[i] = paldata[i] >> 8;
+	}
+	if (zx != 16) {
+		int n = 0;
+		for (i = 0; i < 16; i++) {
+			if (dda_x_skip[i])
+				zoomShuf[n++] = i;
+		}
+		for (; n < 16; n++)
+			zoomShuf[n] = 0xff;
+	}
+	if (yflip) {
+		br = (Uint16 *)bmp + ((zy - 1) + sy) * pitch + sx;
+		pitch = -pitch;
+	} else
+		br = (Uint16 *)bmp + sy * pitch + sx;
+
+#if defined(__aarch64__)
+	uint8x16_t lo = vld1q_u8(palLo), hi = vld1q_u8(palHi), shuf = vld1q_u8(zoomShuf);
+	for (y = 0; y < zy; y++, br += pitch) {
+		gfxdata += l_y_skip[y] << 1;
+		if (!(gfxdata[0] | gfxdata[1]))
+			continue;
+		uint8x8_t b = vld1_u8((const Uint8 *)gfxdata);
+		uint8x8x2_t pens;
+		if (xflip) {
+			b = vext_u8(b, b, 4);
+			pens = vzip_u8(vand_u8(b, vdup_n_u8(0xf)), vshr_n_u8(b, 4));
+		} else {
+			b = vrev32_u8(b);
+			pens = vzip_u8(vshr_n_u8(b, 4), vand_u8(b, vdup_n_u8(0xf)));
+		}
+		uint8x16_t idx = vcombine_u8(pens.val[0], pens.val[1]);
+		if (zx != 16)
+			idx = vqtbl1q_u8(idx, shuf);
+		uint8x16x2_t px = vzipq_u8(vqtbl1q_u8(lo, idx), vqtbl1q_u8(hi, idx));
+		uint8x16_t opaque = vtstq_u8(idx, idx);
+		uint8x16x2_t mask = vzipq_u8(opaque, opaque);
+		vst1q_u16(br, vbslq_u16(vreinterpretq_u16_u8(mask.val[0]),
+			vreinterpretq_u16_u8(px.val[0]), vld1q_u16(br)));
+		vst1q_u16(br + 8, vbslq_u16(vreinterpretq_u16_u8(mask.val[1]),
+			vreinterpretq_u16_u8(px.val[1]), vld1q_u16(br + 8)));
+	}
+#else
+	__m128i lo = _mm_loadu_si128((const __m128i *)palLo);
+	__m128i hi = _mm_loadu_si128((const __m128i *)palHi);
+	__m128i shuf = _mm_loadu_si128((const __m128i *)zoomShuf);
+	__m128i order = xflip ? _mm_setr_epi8(4, 5, 6, 7, 0, 1, 2, 3, -1, -1, -1, -1, -1, -1, -1, -1)
+		: _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, -1, -1, -1, -1, -1, -1, -1, -1);
+	__m128i nibble = _mm_set1_epi8(0xf);
+	for (y = 0; y < zy; y++, br += pitch) {
+		gfxdata += l_y_skip[y] << 1;
+		if (!(gfxdata[0] | gfxdata[1]))
+			continue;
+		__m128i b = _mm_shuffle_epi8(_mm_loadl_epi64((const __m128i *)gfxdata), order);
+		__m128i bLo = _mm_and_si128(b, nibble);
+		__m128i bHi = _mm_and_si128(_mm_srli_epi16(b, 4), nibble);
+		__m128i idx = xflip ? _mm_unpacklo_epi8(bLo, bHi) : _mm_unpacklo_epi8(bHi, bLo);
+		if (zx != 16)
+			idx = _mm_shuffle_epi8(idx, shuf);
+		__m128i cLo = _mm_shuffle_epi8(lo, idx), cHi = _mm_shuffle_epi8(hi, idx);
+		__m128i clear = _mm_cmpeq_epi8(idx, _mm_setzero_si128());
+		__m128i m0 = _mm_unpacklo_epi8(clear, clear), m1 = _mm_unpackhi_epi8(clear, clear);
+		__m128i *dst = (__m128i *)br;
+		_mm_storeu_si128(dst, _mm_or_si128(_mm_and_si128(m0, _mm_loadu_si128(dst)),
+			_mm_andnot_si128(m0, _mm_unpacklo_epi8(cLo, cHi))));
+		_mm_storeu_si128(dst + 1, _mm_or_si128(_mm_and_si128(m1, _mm_loadu_si128(dst + 1)),
+			_mm_andnot_si128(m1, _mm_unpackhi_epi8(cLo, cHi))));
+	}
+#endif
+}
+#endif
+
 #ifdef PROCESSOR_ARM
 
 void draw_tile_arm_yflip_norm(unsigned int tileno, int color, unsigned short *bmp, int zy);
@@ -625,6 +726,12 @@ void draw_screen(void *emuTaskPtr, void *neoSystemPtr, void *emuVideoPtr) {
 #else
 				switch (penusage) {
 					case TILE_NORMAL:
+#ifdef SIMD_TILE
+						draw_tile_simd(tileno, sx + 16, sy, rzx, yskip, tileatr >> 8,
+								tileatr & 0x01, tileatr & 0x02,
+								(unsigned char*) buffer->pixels);
+						break;
+#endif
 						draw_tile(tileno, sx + 16, sy, rzx, yskip, tileatr >> 8,
 								tileatr & 0x01, tileatr & 0x02,
 								(unsigned char*) buffer->pixels);
@@ -685,6 +792,7 @@ void draw_screen_scanline(int start_line, int end_line, int refresh, void *emuTa
 	int invert;
 	Uint8 *zoomy_rom;
 	Uint8 penusage;
+	int strip_h, strip_y;
 
 	if (start_line > 255) start_line = 255;
 	if (end_line > 255) end_line = 255;
@@ -746,6 +854,12 @@ void draw_screen_scanline(int start_line, int end_line, int refresh, void *emuTa
 		if (sx<-16) continue;
 		//sx&=0x1ff;
 
+		/* Skip strips that don't cross any line in this range,
+		 * the strip covers lines sy to sy + my * 16 modulo 512 */
+		strip_h = my << 4;
+		strip_y = (start_line - sy) & 0x1ff;
+		if (strip_y >= strip_h && strip_y + (end_line - start_line) < 512) continue;
+
 		/* Process x zoom */
 		if (zx != 16) {
 			dda_x_skip = ddaxskip[zx];
@@ -791,23 +905,29 @@ void draw_screen_scanline(int start_line, int end_line, int refresh, void *emuTa
 				yoffs ^= 0x0f; // yoffs= 15 - yoffs;
 			}
 
-			tileno = READ_WORD(&vidram[offs + (tile << 2)]);
-			tileatr = READ_WORD(&vidram[offs + (tile << 2) + 2]);
+			/* consecutive lines mostly hit the same tile, only look it up
+			 * (and fetch it from the sprite cache) when it changes */
+			if (tile != otile) {
+				otile = tile;
+				tileno = READ_WORD(&vidram[offs + (tile << 2)]);
+				tileatr = READ_WORD(&vidram[offs + (tile << 2) + 2]);
 
-			if (memory.nb_of_tiles > 0x10000 && tileatr & 0x10) tileno += 0x10000;
-			if (memory.nb_of_tiles > 0x20000 && tileatr & 0x20) tileno += 0x20000;
-			if (memory.nb_of_tiles > 0x40000 && tileatr & 0x40) tileno += 0x40000;
+				if (memory.nb_of_tiles > 0x10000 && tileatr & 0x10) tileno += 0x10000;
+				if (memory.nb_of_tiles > 0x20000 && tileatr & 0x20) tileno += 0x20000;
+				if (memory.nb_of_tiles > 0x40000 && tileatr & 0x40) tileno += 0x40000;
 
-			/* animation automatique */
-			if (tileatr & 0x8) tileno = (tileno&~7)+((tileno + neogeo_frame_counter)&7);
-			else if (tileatr & 0x4) tileno = (tileno&~3)+((tileno + neogeo_frame_counter)&3);
-			if (tileatr & 0x02) yoffs ^= 0x0f; /* flip y */
+				/* animation automatique */
+				if (tileatr & 0x8) tileno = (tileno&~7)+((tileno + neogeo_frame_counter)&7);
+				else if (tileatr & 0x4) tileno = (tileno&~3)+((tileno + neogeo_frame_counter)&3);
 
-			penusage = PEN_USAGE(tileno);
-			if (memory.vid.spr_cache.data) {
-				memory.rom.tiles.p = get_cached_sprite_ptr(tileno);
-				tileno = (tileno & ((memory.vid.spr_cache.slot_size >> 7) - 1));
+				penusage = PEN_USAGE(tileno);
+				if (memory.vid.spr_cache.data) {
+					memory.rom.tiles.p = get_cached_sprite_ptr(tileno);
+					tileno = (tileno & ((memory.vid.spr_cache.slot_size >> 7) - 1));
+				}
 			}
+			if (penusage == TILE_INVISIBLE) continue;
+			if (tileatr & 0x02) yoffs ^= 0x0f; /* flip y */
 
 			switch (penusage) {
 #ifdef I386_ASM
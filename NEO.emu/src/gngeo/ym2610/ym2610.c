@@ -1350,8 +1350,19 @@ INLINE void advance_eg_channel(FM_OPN *OPN, FM_SLOT *SLOT)
 INLINE void chan_calc(FM_OPN *OPN, FM_CH *CH)
 {
 	unsigned int eg_out;
-
-	u32 AM = LFO_AM >> CH->ams;
+	u32 AM;
+
+	/* a channel with every slot released to silence and no feedback or
+	   MEM history left outputs nothing, its phase counters don't matter
+	   either since a key on restarts them */
+	if (CH->SLOT[SLOT1].state == EG_OFF && !CH->SLOT[SLOT1].key &&
+		CH->SLOT[SLOT2].state == EG_OFF && !CH->SLOT[SLOT2].key &&
+		CH->SLOT[SLOT3].state == EG_OFF && !CH->SLOT[SLOT3].key &&
+		CH->SLOT[SLOT4].state == EG_OFF && !CH->SLOT[SLOT4].key &&
+		!CH->op1_out[0] && !CH->op1_out[1] && !CH->mem_value)
+		return;
+
+	AM = LFO_AM >> CH->ams;
 
 
 	m2 = c1 = c2 = mem = 0;
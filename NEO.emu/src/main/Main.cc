@@ -93,6 +93,7 @@ namespace EmuEx
 
 constexpr SystemLogger log{"NEO.emu"};
 const char *EmuSystem::creditsViewStr = CREDITS_INFO_STRING "(c) 2012-2024\nRobert Broglia\nwww.explusalpha.com\n\nPortions (c) the\nGngeo Team\ncode.google.com/p/gngeo";
+bool EmuSystem::hasGzipStates = true;
 bool EmuSystem::handlesGenericIO = false; // TODO: need to re-factor GnGeo file loading code
 bool EmuSystem::canRenderRGBA8888 = false;
 bool EmuSystem::hasRectangularPixels = true;
@@ -223,7 +224,7 @@ size_t NeoSystem::writeState(std::span<uint8_t> buff, SaveStateFlags flags)
 		MapIO buffIO{stateArr};
 		openState(buffIO, STWRITE);
 		makeState(buffIO, STWRITE);
-		return compressGzip(buff, stateArr, Z_DEFAULT_COMPRESSION);
+		return compressState(buff, stateArr, flags, Z_DEFAULT_COMPRESSION);
 	}
 }
 
@@ -272,6 +273,22 @@ static auto openGngeoDataIO(IG::ApplicationContext ctx, IG::CStringView filename
 	#endif
 }
 
+static WallClockTimePoint romSetLastWriteTime(IG::ApplicationContext ctx, std::string_view dir, const ROM_DEF &drv)
+{
+	WallClockTimePoint time{};
+	for(auto name : {drv.name, drv.parent})
+	{
+		if(!strlen(name))
+			continue;
+		auto baseUri = FS::uriString(dir, name);
+		for(auto ext : {".zip", ".7z", ".rar"})
+		{
+			time = std::max(time, ctx.fileUriLastWriteTime(FS::PathString{baseUri + ext}));
+		}
+	}
+	return time;
+}
+
 void NeoSystem::loadContent(IO &, EmuSystemCreateParams, OnLoadProgressDelegate onLoadProgressFunc)
 {
 	if(contentDirectory().empty())
@@ -289,6 +306,12 @@ void NeoSystem::loadContent(IO &, EmuSystemCreateParams, OnLoadProgressDelegate
 	auto freeDrv = IG::scopeGuard([&](){ free(drv); });
 	log.info("rom set {}, {}", drv->name, drv->longname);
 	auto gnoFilename = EmuSystem::contentSaveFilePath(".gno");
+	if(optionCreateAndUseCache && ctx.fileUriExists(gnoFilename)
+		&& ctx.fileUriLastWriteTime(gnoFilename) < romSetLastWriteTime(ctx, contentDirectory(), *drv))
+	{
+		log.info("{} is older than its ROM set, removing", gnoFilename);
+		ctx.removeFileUri(gnoFilename);
+	}
 	if(optionCreateAndUseCache && ctx.fileUriExists(gnoFilename))
 	{
 		log.info("loading .gno file");
@@ -309,7 +332,11 @@ void NeoSystem::loadContent(IO &, EmuSystemCreateParams, OnLoadProgressDelegate
 		if(optionCreateAndUseCache && !ctx.fileUriExists(gnoFilename))
 		{
 			log.info("{} doesn't exist, creating", gnoFilename);
-			dr_save_gno(&memory.rom, gnoFilename.data());
+			if(!dr_save_gno(&memory.rom, gnoFilename.data()))
+			{
+				log.error("error writing {}", gnoFilename);
+				ctx.removeFileUri(gnoFilename);
+			}
 		}
 	}
 	EmuSystem::setContentDisplayName(drv->longname);
@@ -497,6 +524,17 @@ void gn_init_pbar(unsigned action, int size)
 	}
 }
 
+void gn_parallel_for(unsigned begin, unsigned end, void (*func)(void *data, unsigned begin, unsigned end), void *data)
+{
+	if(end <= begin)
+		return;
+	auto &app = EmuApp::get(gSystem().appContext());
+	app.jobPool().parallelFor(end - begin, [&](size_t sliceBegin, size_t sliceEnd)
+	{
+		func(data, begin + sliceBegin, begin + sliceEnd);
+	});
+}
+
 void gn_update_pbar(int pos)
 {
 	auto &sys = static_cast<NeoSystem&>(gSystem());
@@ -3,6 +3,8 @@ inc_main := 1
 
 include $(IMAGINE_PATH)/make/imagineAppBase.mk
 
+VPATH += $(EMUFRAMEWORK_PATH)/src/shared
+
 SRC += main/Main.cc \
 main/input.cc \
 main/options.cc \
@@ -16,7 +18,8 @@ CPPFLAGS += -I$(projectPath)/src \
 -DPSS_STYLE=1 \
 -DLSB_FIRST \
 -DFRAMESKIP \
--I$(projectPath)/src/fceu
+-I$(projectPath)/src/fceu \
+-I$(EMUFRAMEWORK_PATH)/src/shared
 
 CXXFLAGS_WARN += -Wno-register -Wno-sign-compare -Wno-missing-field-initializers -Wno-switch -Wno-bitwise-op-parentheses -Wno-expansion-to-defined
 
@@ -77,6 +80,7 @@ BOARDS_SRC := $(subst $(projectPath)/src/,,$(filter %.cpp %.c, $(wildcard $(proj
 FCEUX_SRC += $(BOARDS_SRC)
 FCEUX_OBJ := $(addprefix $(objDir)/,$(FCEUX_SRC:.cpp=.o))
 SRC += $(FCEUX_SRC)
+SRC += mednafen/sound/Blip_Buffer.cpp
 
 include $(EMUFRAMEWORK_PATH)/package/emuframework.mk
 include $(IMAGINE_PATH)/make/package/zlib.mk
@@ -46,6 +46,7 @@ static void NamcoSound(int Count);
 static void NamcoSoundHack(void);
 static void DoNamcoSound(int32 *Wave, int Count);
 static void DoNamcoSoundHQ(void);
+static void DoNamcoSoundBlip(void);
 static void SyncHQ(int32 ts);
 
 static int is210;        /* Lesser mapper. */
@@ -179,6 +180,7 @@ static DECLFW(Mapper19_write) {
 					GameExpSound.Fill = NamcoSound;
 					GameExpSound.HiFill = DoNamcoSoundHQ;
 					GameExpSound.HiSync = SyncHQ;
+					GameExpSound.BlipFill = DoNamcoSoundBlip;
 				}
 				FixCache(dopol, V);
 			}
@@ -220,6 +222,10 @@ static int dwave = 0;
 
 static void NamcoSoundHack(void) {
 	int32 z, a;
+	if (FSettings.soundq == 3) {
+		DoNamcoSoundBlip();
+		return;
+	}
 	if (FSettings.soundq >= 1) {
 		DoNamcoSoundHQ();
 		return;
@@ -241,6 +247,7 @@ static void NamcoSound(int Count) {
 static uint32 PlayIndex[8];
 static int32 vcount[8];
 static int32 CVBC;
+static int32 blipout[8];
 
 #define TOINDEX        (16 + 1)
 
@@ -300,6 +307,40 @@ static void DoNamcoSoundHQ(void) {
 	CVBC = SOUNDTS;
 }
 
+static void DoNamcoSoundBlip(void) {
+	int32 P;
+	int32 cyclesuck = (((IRAM[0x7F] >> 4) & 7) + 1) * 15;
+
+	for (P = 7; P >= 0; P--) {
+		if (P >= (7 - ((IRAM[0x7F] >> 4) & 7)) && (IRAM[0x44 + (P << 3)] & 0xE0) && (IRAM[0x47 + (P << 3)] & 0xF)) {
+			uint32 freq;
+			int32 vco, V, end;
+			uint32 lengo, envelope;
+
+			vco = vcount[P];
+			freq = FreqCache[P];
+			envelope = EnvCache[P];
+			lengo = LengthCache[P];
+
+			// Steps at the half-cycles where DoNamcoSoundHQ() would fetch the next sample
+			V = CVBC << 1;
+			end = SOUNDTS << 1;
+			FCEU_BlipLevel(blipout[P], CVBC, FetchDuff(P, envelope) << 1);
+			while (V + vco < end) {
+				V += vco;
+				PlayIndex[P] += freq;
+				while ((PlayIndex[P] >> TOINDEX) >= lengo) PlayIndex[P] -= lengo << TOINDEX;
+				V++;
+				FCEU_BlipLevel(blipout[P], V >> 1, FetchDuff(P, envelope) << 1);
+				vco = cyclesuck - 1;
+			}
+			vcount[P] = vco - (end - V);
+		} else
+			FCEU_BlipLevel(blipout[P], CVBC, 0);
+	}
+	CVBC = SOUNDTS;
+}
+
 
 static void DoNamcoSound(int32 *Wave, int Count) {
 	int P, V;
@@ -368,6 +409,7 @@ void Mapper19_ESI(void) {
 	GameExpSound.RChange = M19SC;
 	memset(vcount, 0, sizeof(vcount));
 	memset(PlayIndex, 0, sizeof(PlayIndex));
+	memset(blipout, 0, sizeof(blipout));
 	CVBC = 0;
 }
 
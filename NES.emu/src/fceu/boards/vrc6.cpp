@@ -50,6 +50,7 @@ static uint8 vpsg2[4];
 static int32 cvbc[3];
 static int32 vcount[3];
 static int32 dcount[2];
+static int32 blipout[3];
 
 static SFORMAT SStateRegs[] =
 {
@@ -309,6 +310,71 @@ static void DoSawVHQ(void) {
 	cvbc[2] = SOUNDTS;
 }
 
+static INLINE void DoSQVBlip(int x) {
+	int32 V = cvbc[x];
+	int32 end = SOUNDTS;
+	int32 amp = ((vpsg1[x << 2] & 15) << 8) * 6 / 8;
+
+	if (vpsg1[(x << 2) | 0x2] & 0x80) {
+		if (vpsg1[x << 2] & 0x80)
+			FCEU_BlipLevel(blipout[x], V, amp);
+		else {
+			int32 thresh = (vpsg1[x << 2] >> 4) & 7;
+			FCEU_BlipLevel(blipout[x], V, dcount[x] > thresh ? amp : 0);
+			for (;;) {
+				int32 step = vcount[x] > 0 ? vcount[x] : 1;
+				if (V + step > end) {
+					vcount[x] -= end - V;
+					break;
+				}
+				V += step;
+				vcount[x] = (vpsg1[(x << 2) | 0x1] | ((vpsg1[(x << 2) | 0x2] & 15) << 8)) + 1;
+				dcount[x] = (dcount[x] + 1) & 15;
+				FCEU_BlipLevel(blipout[x], V, dcount[x] > thresh ? amp : 0);
+			}
+		}
+	} else
+		FCEU_BlipLevel(blipout[x], V, 0);
+	cvbc[x] = end;
+}
+
+static void DoSQV1Blip(void) {
+	DoSQVBlip(0);
+}
+
+static void DoSQV2Blip(void) {
+	DoSQVBlip(1);
+}
+
+static void DoSawVBlip(void) {
+	static uint8 b3 = 0;
+	static int32 phaseacc = 0;
+	int32 V = cvbc[2];
+	int32 end = SOUNDTS;
+
+	if (vpsg2[2] & 0x80) {
+		FCEU_BlipLevel(blipout[2], V, (((phaseacc >> 3) & 0x1f) << 8) * 6 / 8);
+		for (;;) {
+			int32 step = vcount[2] > 0 ? vcount[2] : 1;
+			if (V + step > end) {
+				vcount[2] -= end - V;
+				break;
+			}
+			V += step;
+			vcount[2] = (vpsg2[1] + ((vpsg2[2] & 15) << 8) + 1) << 1;
+			phaseacc += vpsg2[0] & 0x3f;
+			b3++;
+			if (b3 == 7) {
+				b3 = 0;
+				phaseacc = 0;
+			}
+			FCEU_BlipLevel(blipout[2], V, (((phaseacc >> 3) & 0x1f) << 8) * 6 / 8);
+		}
+	} else
+		FCEU_BlipLevel(blipout[2], V, 0);
+	cvbc[2] = end;
+}
+
 
 void VRC6Sound(int Count) {
 	int x;
@@ -326,6 +392,12 @@ void VRC6SoundHQ(void) {
 	DoSawVHQ();
 }
 
+void VRC6SoundBlip(void) {
+	DoSQV1Blip();
+	DoSQV2Blip();
+	DoSawVBlip();
+}
+
 void VRC6SyncHQ(int32 ts) {
 	int x;
 	for (x = 0; x < 3; x++) cvbc[x] = ts;
@@ -336,12 +408,18 @@ static void VRC6_ESI(void) {
 	GameExpSound.Fill = VRC6Sound;
 	GameExpSound.HiFill = VRC6SoundHQ;
 	GameExpSound.HiSync = VRC6SyncHQ;
+	GameExpSound.BlipFill = VRC6SoundBlip;
 
 	memset(cvbc, 0, sizeof(cvbc));
 	memset(vcount, 0, sizeof(vcount));
 	memset(dcount, 0, sizeof(dcount));
+	memset(blipout, 0, sizeof(blipout));
 	if (FSettings.SndRate) {
-		if (FSettings.soundq >= 1) {
+		if (FSettings.soundq == 3) {
+			sfun[0] = DoSQV1Blip;
+			sfun[1] = DoSQV2Blip;
+			sfun[2] = DoSawVBlip;
+		} else if (FSettings.soundq >= 1) {
 			sfun[0] = DoSQV1HQ;
 			sfun[1] = DoSQV2HQ;
 			sfun[2] = DoSawVHQ;
@@ -135,6 +135,7 @@ void FDSSoundReset(void);
 void FDSSoundStateAdd(void);
 static void RenderSound(void);
 static void RenderSoundHQ(void);
+static void RenderSoundBlip(void);
 
 static void FDSInit(void) {
 	memset(FDSRegs, 0, sizeof(FDSRegs));
@@ -425,7 +426,9 @@ static DECLFR(FDSSRead) {
 
 static DECLFW(FDSSWrite) {
 	if (FSettings.SndRate) {
-		if (FSettings.soundq >= 1)
+		if (FSettings.soundq == 3)
+			RenderSoundBlip();
+		else if (FSettings.soundq >= 1)
 			RenderSoundHQ();
 		else
 			RenderSound();
@@ -554,6 +557,7 @@ static INLINE int32 FDSDoSound(void) {
 }
 
 static int32 FBC = 0;
+static int32 blipout = 0;
 
 static void RenderSound(void) {
 	int32 end, start;
@@ -586,6 +590,22 @@ static void RenderSoundHQ(void) {
 	FBC = SOUNDTS;
 }
 
+// The modulator can change the output on any clock, so it's still sampled every cycle,
+// but only the changes are added as steps
+static void RenderSoundBlip(void) {
+	uint32 x;
+
+	if (!(SPSG[0x9] & 0x80))
+		for (x = FBC; x < SOUNDTS; x++) {
+			uint32 t = FDSDoSound();
+			t += t >> 1;
+			FCEU_BlipLevel(blipout, x, t);
+		}
+	else
+		FCEU_BlipLevel(blipout, FBC, 0);
+	FBC = SOUNDTS;
+}
+
 static void HQSync(int32 ts) {
 	FBC = ts;
 }
@@ -596,6 +616,7 @@ void FDSSound(int c) {
 }
 
 static void FDS_ESI(void) {
+	blipout = 0;
 	if (FSettings.SndRate) {
 		if (FSettings.soundq >= 1) {
 			fdso.cycles = (int64)1 << 39;
@@ -615,6 +636,7 @@ void FDSSoundReset(void) {
 	FDS_ESI();
 	GameExpSound.HiSync = HQSync;
 	GameExpSound.HiFill = RenderSoundHQ;
+	GameExpSound.BlipFill = RenderSoundBlip;
 	GameExpSound.Fill = FDSSound;
 	GameExpSound.RChange = FDS_ESI;
 }
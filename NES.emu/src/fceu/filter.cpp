@@ -58,7 +58,8 @@ void SexyFilter(int32 *in, int32 *out, int32 count)
  vmul=(FSettings.SoundVolume<<16)*3/4/100;
 
  //FCEU_DispMessage("SoundVolume %d, vmul %d",0,FSettings.SoundVolume,vmul);
- if(FSettings.soundq) vmul/=4;
+ if(FSettings.soundq==3) vmul*=8;	/* Band-limited steps are read out at 1/4 of the WaveHi level, vs. NeoFilterSound()'s gain of 8 */
+ else if(FSettings.soundq) vmul/=4;
  else vmul*=2;			/* TODO:  Increase volume in low quality sound rendering code itself */
 
  while(count)
@@ -28,6 +28,8 @@
 #include "wave.h"
 #include "debug.h"
 
+#include <mednafen/sound/Blip_Buffer.h>
+
 #include <cstdlib>
 #include <cstdio>
 #include <cstring>
@@ -84,6 +86,14 @@ uint32 soundtsi=0;
 static int32 sqacc[2];
 /* LQ variables segment ends. */
 
+/* Variables exclusively for band-limited sound. */
+static Blip_Buffer blipBuf;
+static Blip_Synth<blip_good_quality, 0x10000> blipSynth;
+static int32 sqBlipOut=0;	// wlookup1[] level of the squares
+static int32 tndBlipOut=0;	// wlookup2[] level of the triangle, noise and PCM
+static int32 expBlipOut=0;	// level of expansion sound rendered into WaveHi
+/* Band-limited variables segment ends. */
+
 /*static*/ int32 lengthcount[4];
 static const uint8 lengthtable[0x20]=
 {
@@ -1012,6 +1022,172 @@ static void RDoNoise(void)
  ChannelBC[3]=SOUNDTS;
 }
 
+void FCEU_BlipOffset(uint32 time, int32 delta)
+{
+ blipSynth.offset_inline(time, delta, &blipBuf);
+}
+
+/* Both squares are stepped together so their output can go through the
+   same non-linear mix as WaveHi, only at the cycles where a duty step occurs. */
+static void BDoSQ(void)
+{
+   int32 amp[2], ampx;
+   int32 rthresh[2];
+   int32 cf[2];
+   int inie[2];
+   int32 V, end;
+   int x;
+
+   V=ChannelBC[0];
+   end=SOUNDTS;
+   if(end<=V) return;
+   ChannelBC[0]=ChannelBC[1]=end;
+
+   for(x=0;x<2;x++)
+   {
+    inie[x]=1;
+    if(curfreq[x]<8 || curfreq[x]>0x7ff)
+     inie[x]=0;
+    if(!CheckFreq(curfreq[x],PSG[(x<<2)|0x1]))
+     inie[x]=0;
+    if(!lengthcount[x])
+     inie[x]=0;
+
+    if(EnvUnits[x].Mode&0x1)
+     amp[x]=EnvUnits[x].Speed;
+    else
+     amp[x]=EnvUnits[x].decvolume;
+
+    ampx = x ? FSettings.Square2Volume : FSettings.Square1Volume;
+    if (ampx != 256) amp[x] = (amp[x] * ampx) / 256;
+
+    if(!inie[x]) amp[x]=0;
+
+    rthresh[x]=RectDuties[(PSG[(x<<2)]&0xC0)>>6];
+    cf[x]=(curfreq[x]+1)*2;
+   }
+
+   #define SQOUT (wlookup1[(RectDutyCount[0]<rthresh[0]?amp[0]:0) + (RectDutyCount[1]<rthresh[1]?amp[1]:0)])
+
+   FCEU_BlipLevel(sqBlipOut, V, SQOUT);
+
+   while(inie[0] || inie[1])
+   {
+    int32 step=0x7FFFFFFF;
+    for(x=0;x<2;x++)
+     if(inie[x] && wlcount[x]<step)
+      step=wlcount[x];
+    if(V+step>end)
+    {
+     for(x=0;x<2;x++)
+      if(inie[x]) wlcount[x]-=end-V;
+     break;
+    }
+    V+=step;
+    for(x=0;x<2;x++)
+    {
+     if(!inie[x]) continue;
+     wlcount[x]-=step;
+     if(!wlcount[x])
+     {
+      wlcount[x]=cf[x];
+      RectDutyCount[x]=(RectDutyCount[x]+1)&7;
+     }
+    }
+    FCEU_BlipLevel(sqBlipOut, V, SQOUT);
+   }
+
+   #undef SQOUT
+}
+
+/* Like BDoSQ(), the triangle, noise and PCM share a non-linear mix and are
+   advanced to each triangle step or noise shift in turn. */
+static void BDoTriangleNoisePCM(void)
+{
+   uint8 PAL = ::PAL;
+   int32 V, end;
+   int32 triout, noiseamp, pcmout;
+   int nshift;
+   int triinie;
+
+   V=ChannelBC[2];
+   end=SOUNDTS;
+   if(end<=V) return;
+   ChannelBC[2]=ChannelBC[3]=ChannelBC[4]=end;
+
+   triinie=lengthcount[2] && TriCount;
+
+   if(EnvUnits[2].Mode&0x1)
+    noiseamp=EnvUnits[2].Speed;
+   else
+    noiseamp=EnvUnits[2].decvolume;
+   if (FSettings.NoiseVolume != 256) noiseamp = (noiseamp * FSettings.NoiseVolume) / 256;
+   noiseamp<<=1;
+   if(!lengthcount[3])
+    noiseamp=0;
+
+   if(PSG[0xE]&0x80)  // "short" noise
+    nshift=8;
+   else
+    nshift=13;
+
+   pcmout=(RawDALatch * FSettings.PCMVolume) / 256;
+
+   #define TRIOUT (((((tristep&0x10)?0:0xF)^(tristep&0xF))*3 * FSettings.TriangleVolume) / 256)
+   #define TNDOUT (wlookup2[triout + (((nreg>>0xe)&1)?0:noiseamp) + pcmout])
+
+   triout=TRIOUT;
+   FCEU_BlipLevel(tndBlipOut, V, TNDOUT);
+
+   for(;;)
+   {
+    int32 step=wlcount[3];
+    if(triinie && wlcount[2]<step)
+     step=wlcount[2];
+    if(V+step>end)
+    {
+     if(triinie) wlcount[2]-=end-V;
+     wlcount[3]-=end-V;
+     break;
+    }
+    V+=step;
+    if(triinie)
+    {
+     wlcount[2]-=step;
+     if(!wlcount[2])
+     {
+      wlcount[2]=(PSG[0xa]|((PSG[0xb]&7)<<8))+1;
+      tristep++;
+      triout=TRIOUT;
+     }
+    }
+    wlcount[3]-=step;
+    if(!wlcount[3])
+    {
+     if(PAL)
+      wlcount[3]=NoiseFreqTablePAL[PSG[0xE]&0xF];
+     else
+      wlcount[3]=NoiseFreqTableNTSC[PSG[0xE]&0xF];
+     nreg=(nreg<<1)+(((nreg>>nshift)^(nreg>>14))&1);
+     nreg&=0x7fff;
+    }
+    FCEU_BlipLevel(tndBlipOut, V, TNDOUT);
+   }
+
+   #undef TRIOUT
+   #undef TNDOUT
+}
+
+/* Turns expansion sound that was rendered into WaveHi into steps. */
+static void BlipWaveHi(void)
+{
+ uint32 x;
+
+ for(x=0;x<SOUNDTS;x++)
+  FCEU_BlipLevel(expBlipOut, x, WaveHi[x]);
+ memset(WaveHi,0,SOUNDTS*sizeof(WaveHi[0]));
+}
+
 DECLFW(Write_IRQFM)
 {
  V=(V&0xC0)>>6;
@@ -1079,6 +1255,43 @@ int FlushEmulateSound(int32 *WaveFinal)
    for(x=0;x<5;x++)
     ChannelBC[x]=left;
   }
+  else if(FSettings.soundq==3)
+  {
+   static blip_sample_t blipOut[2048+512];
+
+   if(GameExpSound.BlipFill)
+    GameExpSound.BlipFill();
+   else if(GameExpSound.HiFill)
+   {
+    GameExpSound.HiFill();
+    BlipWaveHi();
+   }
+   blipBuf.end_frame(SOUNDTS);
+
+   end=std::min<long>(blipBuf.samples_avail(), sizeof(blipOut)/sizeof(blipOut[0]));
+   blipBuf.read_samples(blipOut,end);
+   for(x=0;x<end;x++)
+    WaveFinal[x]=blipOut[x];
+
+   if(GameExpSound.NeoFill)
+   {
+    /* NeoFill output is scaled for NeoFilterSound()'s output, which is 32
+       times the level of the steps read out here. */
+    static int32 neoOut[2048+512];
+    memset(neoOut,0,end*sizeof(neoOut[0]));
+    GameExpSound.NeoFill(neoOut,end);
+    for(x=0;x<end;x++)
+     WaveFinal[x]+=neoOut[x]>>5;
+   }
+
+   SexyFilter(WaveFinal,WaveFinal,end);
+   if(FSettings.lowpass)
+    SexyFilter2(WaveFinal,end);
+
+   if(GameExpSound.HiSync) GameExpSound.HiSync(0);
+   for(x=0;x<5;x++)
+    ChannelBC[x]=0;
+  }
   else
   {
    end=(SOUNDTS<<16)/soundtsinc;
@@ -1095,7 +1308,11 @@ int FlushEmulateSound(int32 *WaveFinal)
   }
   nosoundo:
 
-  if(FSettings.soundq>=1)
+  if(FSettings.soundq==3)
+  {
+   soundtsoffs=0;
+  }
+  else if(FSettings.soundq>=1)
   {
    soundtsoffs=left;
   }
@@ -1238,7 +1455,12 @@ void SetSoundVariables(void)
     wlookup2[x]=(double)16*16*16*4*163.67/((double)24329/(double)x+100);
     if(!FSettings.soundq) wlookup2[x]>>=4;
    }
-   if(FSettings.soundq>=1)
+   if(FSettings.soundq==3)
+   {
+    DoSQ1=DoSQ2=BDoSQ;
+    DoNoise=DoTriangle=DoPCM=BDoTriangleNoisePCM;
+   }
+   else if(FSettings.soundq>=1)
    {
     DoNoise=RDoNoise;
     DoTriangle=RDoTriangle;
@@ -1273,6 +1495,19 @@ void SetSoundVariables(void)
 
   LoadDMCPeriod(DMCFormat&0xF);  // For changing from PAL to NTSC
 
+  if(FSettings.soundq==3)
+  {
+   blipBuf.set_sample_rate(FSettings.SndRate, 100);
+   blipBuf.clock_rate((long)(PAL?PAL_CPU:NTSC_CPU));
+   blipBuf.clear();
+   // A step of 4 WaveHi units gives 1 output unit, leaving headroom for expansion sound
+   blipSynth.volume(0.25);
+   sqBlipOut=tndBlipOut=expBlipOut=0;
+   soundtsoffs=0;
+   memset(WaveHi,0,sizeof(WaveHi));
+   if(GameExpSound.HiSync) GameExpSound.HiSync(0);
+  }
+
   soundtsinc=(uint32)((uint64)(PAL?(long double)PAL_CPU*65536:(long double)NTSC_CPU*65536)/(FSettings.SndRate * 16));
 }
 
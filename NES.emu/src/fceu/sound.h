@@ -38,6 +38,12 @@ typedef struct {
 
 	   void (*RChange)(void);
 	   void (*Kill)(void);
+
+	   /* Called instead of HiFill in band-limited mode(soundq 3) by
+	      devices that report their output through FCEU_BlipLevel().
+	      Others keep filling WaveHi, which is converted afterwards.
+	   */
+	   void (*BlipFill)(void);
 } EXPSOUND;
 
 extern EXPSOUND GameExpSound;
@@ -62,6 +68,20 @@ extern uint32 soundtsoffs;
 extern bool swapDuty;
 #define SOUNDTS (soundtimestamp + soundtsoffs)
 
+/* Band-limited step synthesis(soundq 3).  Output level changes are added as
+   steps at SOUNDTS-based CPU cycle times and read out at the output rate,
+   skipping the WaveHi FIR decimation. */
+void FCEU_BlipOffset(uint32 time, int32 delta);
+
+static INLINE void FCEU_BlipLevel(int32 &out, uint32 time, int32 level)
+{
+	if(level != out)
+	{
+		FCEU_BlipOffset(time, level - out);
+		out = level;
+	}
+}
+
 void SetNESSoundMap(void);
 void FrameSoundUpdate(void);
 
@@ -44,6 +44,7 @@ void (*MapIRQHook)(int a);
  if(!overclocking) soundtimestamp+=__x; \
 }
 
+#ifdef _S9XLUA_H
 static X6502_MemHook* readMemHook = nullptr;
 static X6502_MemHook* writeMemHook = nullptr;
 static X6502_MemHook* execMemHook = nullptr;
@@ -156,6 +157,13 @@ void X6502_MemHook::Remove(enum X6502_MemHook::Type type, void (*func)(unsigned
 	}
 }
 
+#else
+// only Lua scripts add memory hooks, so without Lua the checks on every access fold away
+static constexpr X6502_MemHook* readMemHook = nullptr;
+static constexpr X6502_MemHook* writeMemHook = nullptr;
+static constexpr X6502_MemHook* execMemHook = nullptr;
+#endif
+
 //normal memory read
 static INLINE uint8 RdMem(unsigned int A)
 {
@@ -625,7 +633,9 @@ extern int test; test++;
 	//will probably cause a major speed decrease on low-end systems
    DEBUG( DebugCycle() );
 
+   #if defined(FCEUDEF_DEBUGGER) || defined(_S9XLUA_H)
    IncrementInstructionsCounters();
+   #endif
 
    _PI=_P;
    b1=RdMem(_PC);
@@ -470,11 +470,12 @@ class CustomAudioOptionView : public AudioOptionView, public MainAppHelper
 		FCEUI_SetSoundQuality(quaility);
 	}
 
-	TextMenuItem qualityItem[3]
+	TextMenuItem qualityItem[4]
 	{
 		{"Normal", attachParams(), [this](){ setQuality(0); }},
 		{"High", attachParams(), [this]() { setQuality(1); }},
-		{"Highest", attachParams(), [this]() { setQuality(2); }}
+		{"Highest", attachParams(), [this]() { setQuality(2); }},
+		{"Band-limited Synthesis", attachParams(), [this]() { setQuality(3); }}
 	};
 
 	MultiChoiceMenuItem quality
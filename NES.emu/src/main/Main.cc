@@ -51,6 +51,7 @@ constexpr SystemLogger log{"NES.emu"};
 const char *EmuSystem::creditsViewStr = CREDITS_INFO_STRING "(c) 2011-2024\nRobert Broglia\nwww.explusalpha.com\n\nPortions (c) the\nFCEUX Team\nfceux.com";
 bool EmuSystem::hasCheats = true;
 bool EmuSystem::hasPALVideoSystem = true;
+bool EmuSystem::canRenderPaletteIndices = true;
 bool EmuSystem::hasResetModes = true;
 bool EmuSystem::hasRectangularPixels = true;
 bool EmuApp::needsGlobalInstance = true;
@@ -426,7 +427,7 @@ void emulateSound(EmuAudio *audio)
 void NesSystem::updateVideoPixmap(EmuVideo &video, bool horizontalCrop, int lines)
 {
 	int xPixels = horizontalCrop ? 240 : 256;
-	video.setFormat({{xPixels, lines}, pixFmt});
+	video.setFormat({{xPixels, lines}, video.usesPaletteIndices() ? PixelFmtI8 : pixFmt});
 }
 
 void NesSystem::renderVideo(EmuSystemTaskContext taskCtx, EmuVideo &video, uint8 *buf)
@@ -438,9 +439,18 @@ void NesSystem::renderVideo(EmuSystemTaskContext taskCtx, EmuVideo &video, uint8
 	int yStart = optionStartVideoLine;
 	auto ppuPixRegion = ppuPix.subView({xStart, yStart}, pix.size());
 	assumeExpr(pix.size() == ppuPixRegion.size());
-	if(pix.format() == PixelFmtRGB565)
+	if(pix.format() == PixelFmtI8) // palette lookup done by the video layer
 	{
-		pix.writeTransformed([&](uint8 p){ return nativeCol.col16[p]; }, ppuPixRegion);
+		if(rgbaPaletteDirty)
+		{
+			video.setPalette(rgbaPalette);
+			rgbaPaletteDirty = false;
+		}
+		pix.write(ppuPixRegion);
+	}
+	else if(pix.format() == PixelFmtRGB565)
+	{
+		pix.writeIndexed(nativeCol.col16, ppuPixRegion);
 	}
 	else
 	{
@@ -493,6 +503,8 @@ void FCEUD_SetPalette(uint8 index, uint8 r, uint8 g, uint8 b)
 		auto desc = sys.pixFmt == PixelFmtBGRA8888 ? PixelDescBGRA8888Native : PixelDescRGBA8888Native;
 		sys.nativeCol.col32[index] = desc.build(r, g, b, (uint8)0);
 	}
+	sys.rgbaPalette[index] = PixelDescRGBA8888Native.build(r, g, b, (uint8)0xFF);
+	sys.rgbaPaletteDirty = true;
 	//log.debug("set palette {} {}", index, nativeCol[index]);
 }
 
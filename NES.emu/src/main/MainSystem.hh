@@ -86,6 +86,8 @@ public:
 		uint16_t col16[256];
 		uint32_t col32[256];
 	} nativeCol;
+	std::array<uint32_t, 256> rgbaPalette{}; // used for GPU palette conversion
+	bool rgbaPaletteDirty{true};
 	alignas(16) uint8 XBufData[256 * 256 + 16]{};
 	std::string cheatsDir;
 	std::string patchesDir;
@@ -106,7 +108,7 @@ public:
 		PropertyDesc<uint8_t>{.defaultValue = 0, .isValid = isValidWithMax<3>}> optionDefaultVideoSystem;
 	Property<bool, CFGKEY_SPRITE_LIMIT, PropertyDesc<bool>{.defaultValue = true}> optionSpriteLimit;
 	Property<uint8_t, CFGKEY_SOUND_QUALITY,
-		PropertyDesc<uint8_t>{.defaultValue = 0, .isValid = isValidWithMax<2>}> optionSoundQuality;
+		PropertyDesc<uint8_t>{.defaultValue = 0, .isValid = isValidWithMax<3>}> optionSoundQuality;
 	Property<bool, CFGKEY_COMPATIBLE_FRAMESKIP> optionCompatibleFrameskip;
 	Property<uint8_t, CFGKEY_START_VIDEO_LINE,
 		PropertyDesc<uint8_t>{.defaultValue = 8, .isValid = isSupportedStartingLine}> optionDefaultStartVideoLine;
@@ -38,6 +38,7 @@ namespace EmuEx
 {
 
 const char *EmuSystem::creditsViewStr = CREDITS_INFO_STRING "(c) 2011-2024\nRobert Broglia\nwww.explusalpha.com\n\nPortions (c) the\nMednafen Team\nmednafen.github.io";
+bool EmuSystem::hasGzipStates = true;
 bool EmuApp::needsGlobalInstance = true;
 
 EmuSystem::NameFilterFunc EmuSystem::defaultFsFilter =
@@ -129,7 +130,7 @@ void NgpSystem::configAudioRate(FrameTime outputFrameTime, int outputRate)
 void NgpSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio)
 {
 	static constexpr size_t maxAudioFrames = 48000 / minFrameRate;
-	EmuEx::runFrame(*this, mdfnGameInfo, taskCtx, video, mSurfacePix, audio, maxAudioFrames);
+	EmuEx::runFrame(*this, mdfnGameInfo, taskCtx, video, mSurfacePix, audio, maxAudioFrames, 0, true);
 }
 
 void EmuApp::onCustomizeNavView(EmuApp::NavView &view)
@@ -173,7 +174,7 @@ namespace Mednafen
 
 void MDFND_commitVideoFrame(EmulateSpecStruct *espec)
 {
-	espec->video->startFrameWithFormat(espec->taskCtx, static_cast<EmuEx::NgpSystem&>(*espec->sys).mSurfacePix);
+	EmuEx::commitVideoFrame(*espec, static_cast<EmuEx::NgpSystem&>(*espec->sys).mSurfacePix);
 }
 
 }
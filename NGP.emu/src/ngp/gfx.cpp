@@ -141,6 +141,7 @@ bool NGPGFX_CLASS::draw(MDFN_Surface *surface, bool skip)
         {
                 if (!K2GE_MODE)        draw_scanline_colour(layer_enable_setting, raster_line);
                 else                   draw_scanline_mono(layer_enable_setting, raster_line);
+                lineTracker.updateLine(raster_line, cfb_scanline);
 
 		if(surface->format.opp == 4)
 		{
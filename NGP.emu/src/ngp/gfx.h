@@ -14,6 +14,8 @@
 
 #ifndef __NEOPOP_GFX__
 #define __NEOPOP_GFX__
+
+#include <emuframework/DirtyLineTracker.hh>
 //=============================================================================
 
 namespace MDFN_IEN_NGP
@@ -45,6 +47,8 @@ class NGPGFX_CLASS
  bool draw(MDFN_Surface *surface, bool skip);
  bool hint(void);
 
+ EmuEx::DirtyLineTracker lineTracker{SCREEN_HEIGHT, SCREEN_WIDTH * sizeof(uint16)};
+
  void power(void);
 
  private:
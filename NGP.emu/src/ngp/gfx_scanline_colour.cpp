@@ -74,6 +74,10 @@ void NGPGFX_CLASS::drawColourPattern(uint8 screenx, uint16 tile, uint8 tiley, ui
 	//Get the data for the "tiley'th" line of "tile".
 	index = MDFN_de16lsb<true>(CharacterRAM + (tile * 16) + (tiley * 2));
 
+	//Fully transparent line, common for empty scroll plane tiles
+	if (!index)
+		return;
+
 	//Horizontal Flip
 	if (mirror)
 		index = mirrored[(index & 0xff00)>>8] | (mirrored[(index & 0xff)] << 8);
@@ -89,7 +93,8 @@ void NGPGFX_CLASS::drawColourPattern(uint8 screenx, uint16 tile, uint8 tiley, ui
 		right = highmark;
 	}
 
-	for (xx=right; xx>=left; --xx,index>>=2) {
+	//Stop once the remaining pixels are all transparent
+	for (xx=right; xx>=left && index; --xx,index>>=2) {
 		if (depth <= zbuffer[xx] || (index&3)==0) 
 			continue;
 		zbuffer[xx] = depth;
@@ -55,6 +55,10 @@ void NGPGFX_CLASS::drawMonoPattern(uint8 screenx, uint16 tile, uint8 tiley, uint
 	//Get the data for th e "tiley'th" line of "tile".
 	uint16 data = MDFN_de16lsb<true>(CharacterRAM + (tile * 16) + (tiley * 2));
 
+	//Fully transparent line, common for empty scroll plane tiles
+	if (!data)
+		return;
+
 	//Horizontal Flip
 	if (mirror)
 	{
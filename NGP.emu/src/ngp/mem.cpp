@@ -68,6 +68,8 @@ void SetFRM(void) // Call this function after rom is loaded
    FastReadMapReal[x] = &ngpc_rom.data[x * 65536 - 0x800000] - x * 65536;
  }
 
+ // BIOS, interrupt vectors and the HLE stubs are fetched from here
+ FastReadMapReal[0xff] = ngpc_bios - 0xff0000;
 }
 
 void RecacheFRM(void)
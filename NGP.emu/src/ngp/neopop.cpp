@@ -91,6 +91,7 @@ static void Emulate(EmulateSpecStruct *espec)
 
 	ngpc_soundTS = 0;
 	NGPFrameSkip = espec->skip;
+	espec->lineTracker = &NGPGfx->lineTracker;
 
 	do
 	{
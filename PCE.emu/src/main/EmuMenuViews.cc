@@ -344,6 +344,26 @@ class CustomSystemOptionView : public SystemOptionView, public MainAppHelper
 		};
 	}
 
+	BoolMenuItem fastCoreFallback
+	{
+		"Fall Back To pce_fast If Slow", attachParams(),
+		system().fastCoreFallback,
+		[this](BoolMenuItem &item)
+		{
+			system().fastCoreFallback = item.flipBoolValue(*this);
+		}
+	};
+
+	BoolMenuItem preloadDiscImage
+	{
+		"Preload Disc Image", attachParams(),
+		system().preloadDiscImage,
+		[this](BoolMenuItem &item)
+		{
+			system().preloadDiscImage = item.flipBoolValue(*this);
+		}
+	};
+
 	BoolMenuItem saveFilenameType = saveFilenameTypeMenuItem(*this, system());
 
 public:
@@ -351,7 +371,9 @@ public:
 	{
 		loadStockItems();
 		item.emplace_back(&emuCore);
+		item.emplace_back(&fastCoreFallback);
 		item.emplace_back(&cdSpeed);
+		item.emplace_back(&preloadDiscImage);
 		item.emplace_back(&saveFilenameType);
 	}
 };
@@ -35,6 +35,7 @@ namespace EmuEx
 {
 
 const char *EmuSystem::creditsViewStr = CREDITS_INFO_STRING "(c) 2011-2024\nRobert Broglia\nwww.explusalpha.com\n\nPortions (c) the\nMednafen Team\nmednafen.github.io";
+bool EmuSystem::hasGzipStates = true;
 bool EmuSystem::hasRectangularPixels = true;
 bool EmuSystem::stateSizeChangesAtRuntime = true;
 constexpr double masterClockFrac = 21477272.727273 / 3.;
@@ -71,6 +72,7 @@ const char *EmuSystem::systemName() const
 }
 
 EmuSystem::NameFilterFunc EmuSystem::defaultFsFilter = hasPCEWithCDExtension;
+EmuSystem::NameFilterFunc EmuSystem::uncachedArchiveEntryFilter = hasCDExtension;
 
 void PceSystem::loadBackupMemory(EmuApp &)
 {
@@ -108,12 +110,21 @@ void PceSystem::closeSystem()
 	clearCDInterfaces(CDInterfaces);
 }
 
+void PceSystem::addThreadGroupIds(std::vector<ThreadId> &ids) const
+{
+	Mednafen::MThreading::addActiveThreadIds(ids);
+}
+
 WSize PceSystem::multiresVideoBaseSize() const { return {512, 0}; }
 
-void PceSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegate)
+void PceSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegate onLoadProgress)
 {
 	mdfnGameInfo = resolvedCore() == EmuCore::Accurate ? EmulatedPCE : EmulatedPCE_Fast;
 	logMsg("using emulator core module:%s", asModuleString(resolvedCore()).data());
+	// only fall back when the accurate core comes from the default, not a per-game choice
+	coreCostFrames = fastCoreFallback && core == EmuCore::Auto && resolvedCore() == EmuCore::Accurate ?
+		coreCostSkipFrames + coreCostSampleFrames : 0;
+	coreCostTime = {};
 	if(hasCDExtension(contentFileName()))
 	{
 		bool isArchive = std::holds_alternative<ArchiveIO>(io);
@@ -134,7 +145,10 @@ void PceSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegat
 		}
 		else
 		{
-			CDInterfaces.push_back(CDInterface::Open(&NVFS, std::string{contentLocation()}, false, 0));
+			// reading the whole image up front avoids storage latency stalls during CD audio and ADPCM
+			if(preloadDiscImage && onLoadProgress)
+				onLoadProgress(0, 0, "Preloading Disc Image...");
+			CDInterfaces.push_back(CDInterface::Open(&NVFS, std::string{contentLocation()}, preloadDiscImage, 0));
 		}
 		writeCDMD5(mdfnGameInfo, CDInterfaces);
 		mdfnGameInfo.LoadCD(&CDInterfaces);
@@ -197,13 +211,43 @@ void PceSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio
 {
 	static constexpr size_t maxAudioFrames = 48000 / minFrameRate;
 	static constexpr size_t maxLineWidths = 264;
+	auto startTime = coreCostFrames ? SteadyClock::now() : SteadyClockTimePoint{};
 	EmuEx::runFrame(*this, mdfnGameInfo, taskCtx, video, mSurfacePix, audio, maxAudioFrames, maxLineWidths);
+	if(coreCostFrames) [[unlikely]]
+	{
+		addAccurateCoreCost(SteadyClock::now() - startTime);
+	}
 	if(configuredFor263Lines != isUsing263Lines()) [[unlikely]]
 	{
 		onFrameTimeChanged();
 	}
 }
 
+void PceSystem::addAccurateCoreCost(SteadyClockTime t)
+{
+	// skip the first frames so startup and initial loading don't count
+	if(--coreCostFrames >= coreCostSampleFrames)
+		return;
+	coreCostTime += t;
+	if(coreCostFrames)
+		return;
+	auto avgTime = std::chrono::duration_cast<Microseconds>(coreCostTime / coreCostSampleFrames);
+	// leave some of the frame for video and audio output
+	auto maxTime = std::chrono::duration_cast<Microseconds>(frameTime() * 9 / 10);
+	logMsg("accurate core average frame time:%lldus, limit:%lldus", (long long)avgTime.count(), (long long)maxTime.count());
+	if(avgTime <= maxTime)
+		return;
+	appContext().runOnMainThread([this](ApplicationContext ctx)
+	{
+		if(!hasContent())
+			return;
+		// save states aren't compatible between cores, so switch on the next load
+		core = EmuCore::Fast;
+		sessionOptionSet();
+		EmuApp::get(ctx).postMessage(4, false, "pce core is too slow on this device, pce_fast will be used when reloading this game");
+	});
+}
+
 void PceSystem::reset(EmuApp &, ResetMode mode)
 {
 	assert(hasContent());
@@ -65,7 +65,8 @@ enum
 	CFGKEY_NO_SPRITE_LIMIT = 281, CFGKEY_CD_SPEED = 282,
 	CFGKEY_CDDA_VOLUME = 283, CFGKEY_ADPCM_VOLUME = 284,
 	CFGKEY_ADPCM_FILTER = 285, CFGKEY_EMU_CORE = 286,
-	CFGKEY_NO_MD5_FILENAMES = 287,
+	CFGKEY_NO_MD5_FILENAMES = 287, CFGKEY_FAST_CORE_FALLBACK = 288,
+	CFGKEY_PRELOAD_DISC_IMAGE = 289,
 };
 
 void set6ButtonPadEnabled(EmuApp &, bool);
@@ -115,6 +116,12 @@ public:
 	bool noMD5InFilenames{};
 	EmuCore defaultCore{};
 	EmuCore core{};
+	bool fastCoreFallback{true};
+	bool preloadDiscImage{};
+	// frames left to measure the accurate core's cost over, 0 when not measuring
+	int coreCostFrames{};
+	SteadyClockTime coreCostTime{};
+	static constexpr int coreCostSkipFrames = 60, coreCostSampleFrames = 600;
 
 	PceSystem(ApplicationContext ctx):
 		EmuSystem{ctx}
@@ -131,6 +138,7 @@ public:
 	EmuCore resolvedCore(EmuCore c) const { return c == EmuCore::Auto ? defaultCore : c; }
 	EmuCore resolvedCore() const { return resolvedCore(core); }
 	EmuCore resolvedDefaultCore() const { return defaultCore == EmuCore::Auto ? EmuCore::Fast : defaultCore; }
+	void addAccurateCoreCost(SteadyClockTime);
 
 	// required API functions
 	void loadContent(IO &, EmuSystemCreateParams, OnLoadProgressDelegate);
@@ -160,6 +168,7 @@ public:
 	void onSessionOptionsLoaded(EmuApp &);
 	bool resetSessionOptions(EmuApp &);
 	double videoAspectRatioScale() const;
+	void addThreadGroupIds(std::vector<ThreadId> &) const;
 
 private:
 	void updateCdSettings();
@@ -74,6 +74,8 @@ bool PceSystem::readConfig(ConfigType type, MapIO &io, unsigned key)
 			case CFGKEY_ADPCM_FILTER: return readOptionValue(io, adpcmFilter);
 			case CFGKEY_EMU_CORE: return readOptionValue(io, defaultCore, [](auto val){return val <= lastEnum<EmuCore>;});
 			case CFGKEY_NO_MD5_FILENAMES: return readOptionValue(io, noMD5InFilenames);
+			case CFGKEY_FAST_CORE_FALLBACK: return readOptionValue(io, fastCoreFallback);
+			case CFGKEY_PRELOAD_DISC_IMAGE: return readOptionValue(io, preloadDiscImage);
 		}
 	}
 	else if(type == ConfigType::SESSION)
@@ -110,6 +112,8 @@ void PceSystem::writeConfig(ConfigType type, FileIO &io)
 			writeOptionValue(io, CFGKEY_ADPCM_FILTER, adpcmFilter);
 		writeOptionValueIfNotDefault(io, CFGKEY_EMU_CORE, defaultCore, EmuCore::Auto);
 		writeOptionValueIfNotDefault(io, CFGKEY_NO_MD5_FILENAMES, noMD5InFilenames, false);
+		writeOptionValueIfNotDefault(io, CFGKEY_FAST_CORE_FALLBACK, fastCoreFallback, true);
+		writeOptionValueIfNotDefault(io, CFGKEY_PRELOAD_DISC_IMAGE, preloadDiscImage, false);
 	}
 	else if(type == ConfigType::SESSION)
 	{
@@ -24,6 +24,7 @@
 #include "pcecd.h"
 #include <mednafen/cputest/cputest.h>
 #include <trio/trio.h>
+#include <array>
 
 namespace MDFN_IEN_PCE_FAST
 {
@@ -75,6 +76,38 @@ static INLINE void FixPCache(int entry)
  }
 }
 
+// Planar to chunky conversion tables, spreading each bit of a bitplane byte to the low bit of
+// its pixel's byte in the tile caches so a row converts with a few lookups instead of per-pixel
+// shifts. Background cache rows hold the leftmost pixel(bit 7) in the first byte in memory,
+// sprite cache rows hold bit 0 first.
+template<bool bitsReversed>
+static constexpr std::array<uint64, 256> MakePlaneSpreadTable(void)
+{
+ std::array<uint64, 256> tab{};
+
+ for(unsigned v = 0; v < 256; v++)
+ {
+  for(unsigned x = 0; x < 8; x++)
+  {
+   unsigned mem_pos = bitsReversed ? (7 - x) : x;
+
+   #ifdef MSB_FIRST
+   const unsigned shift = (7 - mem_pos) * 8;
+   #else
+   const unsigned shift = mem_pos * 8;
+   #endif
+
+   if(v & (1U << x))
+    tab[v] |= (uint64)1 << shift;
+  }
+ }
+
+ return tab;
+}
+
+static constexpr auto bg_plane_spread = MakePlaneSpreadTable<true>();
+static constexpr auto spr_plane_spread = MakePlaneSpreadTable<false>();
+
 static INLINE void FixTileCache(vdc_t *which_vdc, uint16 A)
 {
  uint32 charname = (A >> 4);
@@ -84,21 +117,8 @@ static INLINE void FixTileCache(vdc_t *which_vdc, uint16 A)
  uint32 bitplane01 = which_vdc->VRAM[y + charname * 16];
  uint32 bitplane23 = which_vdc->VRAM[y+ 8 + charname * 16];
 
- *tc = 0;
-
- for(int x = 0; x < 8; x++)
- {
-  uint32 raw_pixel = ((bitplane01 >> x) & 1);
-  raw_pixel |= ((bitplane01 >> (x + 8)) & 1) << 1;
-  raw_pixel |= ((bitplane23 >> x) & 1) << 2;
-  raw_pixel |= ((bitplane23 >> (x + 8)) & 1) << 3;
-
-  #ifdef MSB_FIRST
-  *tc |= (uint64)raw_pixel << ((x) * 8);
-  #else
-  *tc |= (uint64)raw_pixel << ((7 - x) * 8);
-  #endif
- }
+ *tc = bg_plane_spread[bitplane01 & 0xFF] | (bg_plane_spread[bitplane01 >> 8] << 1) |
+	(bg_plane_spread[bitplane23 & 0xFF] << 2) | (bg_plane_spread[bitplane23 >> 8] << 3);
 }
 
 static INLINE void CheckFixSpriteTileCache(vdc_t *which_vdc, uint16 no, uint32 special)
@@ -126,13 +146,8 @@ static INLINE void CheckFixSpriteTileCache(vdc_t *which_vdc, uint16 no, uint32 s
    uint32 bitplane0 = which_vdc->VRAM[y + 0x00 + no * 0x40 + ((special & 1) << 5)];
    uint32 bitplane1 = which_vdc->VRAM[y + 0x10 + no * 0x40 + ((special & 1) << 5)];
 
-   for(int x = 0; x < 16; x++)
-   {
-    uint32 raw_pixel;
-    raw_pixel = ((bitplane0 >> x) & 1) << 0;
-    raw_pixel |= ((bitplane1 >> x) & 1) << 1;
-    tc[x] = raw_pixel;
-   }
+   MDFN_ennsb<uint64, true>(tc + 0, spr_plane_spread[bitplane0 & 0xFF] | (spr_plane_spread[bitplane1 & 0xFF] << 1));
+   MDFN_ennsb<uint64, true>(tc + 8, spr_plane_spread[bitplane0 >> 8] | (spr_plane_spread[bitplane1 >> 8] << 1));
   }
  }
  else
@@ -146,15 +161,10 @@ static INLINE void CheckFixSpriteTileCache(vdc_t *which_vdc, uint16 no, uint32 s
    uint32 bitplane2 = which_vdc->VRAM[y + 0x20 + no * 0x40];
    uint32 bitplane3 = which_vdc->VRAM[y + 0x30 + no * 0x40];
 
-   for(int x = 0; x < 16; x++)
-   {
-    uint32 raw_pixel;
-    raw_pixel = ((bitplane0 >> x) & 1) << 0;
-    raw_pixel |= ((bitplane1 >> x) & 1) << 1;
-    raw_pixel |= ((bitplane2 >> x) & 1) << 2;
-    raw_pixel |= ((bitplane3 >> x) & 1) << 3;
-    tc[x] = raw_pixel;
-   }
+   MDFN_ennsb<uint64, true>(tc + 0, spr_plane_spread[bitplane0 & 0xFF] | (spr_plane_spread[bitplane1 & 0xFF] << 1) |
+	(spr_plane_spread[bitplane2 & 0xFF] << 2) | (spr_plane_spread[bitplane3 & 0xFF] << 3));
+   MDFN_ennsb<uint64, true>(tc + 8, spr_plane_spread[bitplane0 >> 8] | (spr_plane_spread[bitplane1 >> 8] << 1) |
+	(spr_plane_spread[bitplane2 >> 8] << 2) | (spr_plane_spread[bitplane3 >> 8] << 3));
   }
  }
 
@@ -100,8 +100,8 @@ typedef struct
 	uint16 SAT[0x100];
 
         uint16 VRAM[65536];	//VRAM_Size];
-        uint64 bg_tile_cache[4096 * 8]; 	// Tile, y, x
-        uint8 spr_tile_cache[1024][16][16];	// Tile, y, x
+        alignas(64) uint64 bg_tile_cache[4096 * 8]; 	// Tile, y, x
+        alignas(64) uint8 spr_tile_cache[1024][16][16];	// Tile, y, x, rows are written as 2 aligned uint64
         uint8 spr_tile_clean[1024];     //VRAM_Size / 64];
 } vdc_t;
 
@@ -25,6 +25,7 @@
 #include "MainApp.hh"
 #include <imagine/fs/FS.hh>
 #include <imagine/gui/AlertView.hh>
+#include <imagine/gui/TextTableView.hh>
 #include <imagine/util/format.hh>
 #include <ss/cart.h>
 #include <imagine/logger/logger.h>
@@ -569,6 +570,53 @@ class CustomSystemOptionView : public SystemOptionView, public MainAppHelper
 
 	BoolMenuItem saveFilenameType = saveFilenameTypeMenuItem(*this, system());
 
+	BoolMenuItem lowMemoryMode
+	{
+		"Low Memory Mode", attachParams(),
+		system().lowMemoryMode,
+		[this](BoolMenuItem &item)
+		{
+			system().lowMemoryMode = item.flipBoolValue(*this);
+			auto &rewindManager = app().rewindManager;
+			if(system().lowMemoryMode && rewindManager.maxStates && !rewindManager.usesDeltaStates())
+			{
+				// full rewind states are several MB each with this system
+				rewindManager.updateKeyframeInterval(30);
+				app().postMessage("Rewind now uses delta states");
+			}
+			if(system().hasContent())
+				app().postMessage("Reload content to stream archived discs");
+		}
+	};
+
+	BoolMenuItem preloadDiscImage
+	{
+		"Preload Disc Image", attachParams(),
+		system().preloadDiscImage,
+		[this](BoolMenuItem &item)
+		{
+			system().preloadDiscImage = item.flipBoolValue(*this);
+			if(system().preloadDiscImage && system().lowMemoryMode)
+				app().postMessage("Disabled while Low Memory Mode is on");
+		}
+	};
+
+	TextMenuItem memoryUsage
+	{
+		"Core Memory Usage", attachParams(),
+		[this](const Input::Event &e)
+		{
+			constexpr double mib = 1024. * 1024.;
+			auto &sys = system();
+			auto view = makeViewWithName<TextTableView>("Core Memory Usage", 4);
+			view->appendItem(std::format("Emulated Hardware: {:.1f}MiB", sys.stateSize() / mib), []{});
+			view->appendItem(std::format("Disc Image Cache: {:.1f}MiB", sys.cdImageMemorySize / mib), []{});
+			view->appendItem(std::format("Frame Buffer: {:.1f}MiB", sys.pixBuff.size() * sizeof(uint32_t) / mib), []{});
+			view->appendItem(std::format("Rewind States: {:.1f}MiB", app().rewindManager.memoryAllocated() / mib), []{});
+			pushAndShow(std::move(view), e);
+		}
+	};
+
 public:
 	CustomSystemOptionView(ViewAttachParams attach): SystemOptionView{attach, true}
 	{
@@ -576,6 +624,10 @@ public:
 		item.emplace_back(&biosLanguage);
 		item.emplace_back(&autoSetRTC);
 		item.emplace_back(&saveFilenameType);
+		item.emplace_back(&lowMemoryMode);
+		item.emplace_back(&preloadDiscImage);
+		if(system().hasContent())
+			item.emplace_back(&memoryUsage);
 	}
 };
 
@@ -49,6 +49,7 @@ namespace EmuEx
 
 constexpr SystemLogger log{"Saturnemu"};
 const char *EmuSystem::creditsViewStr = CREDITS_INFO_STRING "(c) 2011-2024\nRobert Broglia\nwww.explusalpha.com\n\nPortions (c) the\nMednafen Team\nmednafen.github.io";
+bool EmuSystem::hasGzipStates = true;
 bool EmuSystem::handlesArchiveFiles = true;
 bool EmuSystem::hasResetModes = true;
 bool EmuSystem::hasRectangularPixels = true;
@@ -192,12 +193,20 @@ void SaturnSystem::closeSystem()
 {
 	mdfnGameInfo.CloseGame();
 	clearCDInterfaces(CDInterfaces);
+	cdImageMemorySize = 0;
+	pixBuff = {};
 	backupRamFileIO = {};
 	cartRamFileIO = {};
 	stvEepromFileIO = {};
 	rtcFileIO = {};
 }
 
+void SaturnSystem::addThreadGroupIds(std::vector<ThreadId> &ids) const
+{
+	// includes the VDP2 render thread along with the CD read threads
+	Mednafen::MThreading::addActiveThreadIds(ids);
+}
+
 WSize SaturnSystem::multiresVideoBaseSize() const { return {704, 0}; }
 
 static FrameTime makeFrameTime(uint8 InterlaceMode)
@@ -237,6 +246,13 @@ static bool isM3U(std::string_view s)
 	return endsWithAnyCaseless(s, ".m3u");
 }
 
+static size_t discImageBytes(CDInterface &cdIF)
+{
+	CDUtility::TOC toc;
+	cdIF.ReadTOC(&toc);
+	return size_t(toc.tracks[100].lba) * 2352;
+}
+
 static ArchiveIO scanCDImages(ArchiveIO arch)
 {
 	// prioritize .m3u in archives
@@ -253,7 +269,7 @@ static ArchiveIO scanCDImages(ArchiveIO arch)
 	}
 }
 
-void SaturnSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegate)
+void SaturnSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegate onLoadProgress)
 {
 	bool isArchive = EmuApp::hasArchiveExtension(contentFileName());
 	auto unloadCD = scopeGuard([&]() { clearCDInterfaces(CDInterfaces); });
@@ -273,10 +289,15 @@ void SaturnSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDele
 			filenames.emplace_back(cdImgFile.name());
 		}
 		ArchiveVFS archVFS{std::move(cdImgFile)};
+		// zip tracks can be streamed by the CD read thread instead of copied into memory
+		bool cacheImage = !(lowMemoryMode && archVFS.has_independent_streams());
 		for(auto &fn : filenames)
 		{
-			CDInterfaces.emplace_back(CDInterface::Open(&archVFS, std::move(fn), true, 0));
+			CDInterfaces.emplace_back(CDInterface::Open(&archVFS, std::move(fn), cacheImage, 0));
 		}
+		if(cacheImage)
+			cdImageMemorySize = archVFS.openedSize();
+		log.info("{} disc image from archive", cacheImage ? "cached" : "streaming");
 	}
 	else
 	{
@@ -298,10 +319,21 @@ void SaturnSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDele
 		{
 			filenames.emplace_back(contentLocation());
 		}
+		// reading the whole image up front avoids storage latency stalls during FMV and CD audio
+		bool cacheImage = preloadDiscImage && !lowMemoryMode;
+		if(cacheImage && onLoadProgress)
+			onLoadProgress(0, filenames.size(), "Preloading Disc Image...");
 		for(auto &fn : filenames)
 		{
-			CDInterfaces.emplace_back(CDInterface::Open(&NVFS, std::move(fn), false, 0));
+			CDInterfaces.emplace_back(CDInterface::Open(&NVFS, std::move(fn), cacheImage, 0));
+			if(!cacheImage)
+				continue;
+			// CHD images are held compressed, others as raw sectors up to the lead-out
+			cdImageMemorySize += isCHD ? io.size() : discImageBytes(*CDInterfaces.back());
+			if(onLoadProgress)
+				onLoadProgress(CDInterfaces.size(), 0, nullptr);
 		}
+		log.info("{} disc image from storage", cacheImage ? "cached" : "streaming");
 	}
 	if(!CDInterfaces.size())
 		throw std::runtime_error("No disc images found");
@@ -330,7 +362,12 @@ bool SaturnSystem::onVideoRenderFormatChange(EmuVideo &, IG::PixelFormat fmt)
 
 void SaturnSystem::updatePixmap(IG::PixelFormat fmt)
 {
-	mSurfacePix = {{{mdfnGameInfo.fb_width, mdfnGameInfo.fb_height}, fmt}, pixBuff};
+	WSize size{mdfnGameInfo.fb_width, mdfnGameInfo.fb_height};
+	// only allocate what the current format needs instead of a full 32-bit PAL frame
+	size_t words = size.x * size.y * fmt.bytesPerPixel() / sizeof(uint32_t);
+	if(pixBuff.size() != words)
+		pixBuff.reset(words);
+	mSurfacePix = {{size, fmt}, pixBuff.data()};
 }
 
 FrameTime SaturnSystem::frameTime() const { return frameTime_; }
@@ -347,9 +384,8 @@ void SaturnSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAu
 	using namespace Mednafen;
 	int16 audioBuff[maxAudioFrames * 2];
 	espec.audio = audio;
-	espec.SoundBuf = audio ? audioBuff : nullptr;
-	espec.SoundBufMaxSize = audio ? maxAudioFrames : 0;
-	espec.SoundBufSize = 0;
+	espec.SoundBufFallback = audioBuff;
+	beginSoundBuf(espec, audio, maxAudioFrames);
 	espec.taskCtx = taskCtx;
 	espec.video = video;
 	espec.skip = !video;
@@ -449,7 +485,9 @@ void MDFN_MidSync(EmulateSpecStruct *espec, const unsigned flags)
 	if(!espec->audio)
 		return;
 	//log.debug("{} audio frames", espec.SoundBufSize);
-	espec->audio->writeFrames(espec->SoundBuf, std::exchange(espec->SoundBufSize, 0));
+	auto maxFrames = espec->SoundBufMaxSize;
+	commitSoundBuf(*espec, *espec->audio);
+	beginSoundBuf(*espec, espec->audio, maxFrames);
 }
 
 void MDFND_commitVideoFrame(EmulateSpecStruct *espec)
@@ -16,6 +16,7 @@
 	along with Saturn.emu.  If not, see <http://www.gnu.org/licenses/> */
 
 #include <imagine/base/ApplicationContext.hh>
+#include <imagine/util/memory/DynArray.hh>
 #include <emuframework/EmuSystem.hh>
 #include <mednafen/mednafen.h>
 #include <ss/ss.h>
@@ -32,7 +33,6 @@ class CDInterface;
 namespace MDFN_IEN_SS
 {
 extern Mednafen::CDInterface* Cur_CDIF;
-extern IG::ThreadId RThreadId;
 extern const int ActiveCartType;
 extern uint8 AreaCode;
 }
@@ -85,7 +85,8 @@ enum
 	CFGKEY_DEFAULT_NTSC_VIDEO_LINES = 287, CFGKEY_DEFAULT_PAL_VIDEO_LINES = 288,
 	CFGKEY_DEFAULT_SHOW_H_OVERSCAN = 289, CFGKEY_SHOW_H_OVERSCAN = 290,
 	CFGKEY_DEINTERLACE_MODE = 291, CFGKEY_WIDESCREEN_MODE = 292,
-	CFGKEY_NO_MD5_FILENAMES = 293
+	CFGKEY_NO_MD5_FILENAMES = 293, CFGKEY_LOW_MEMORY_MODE = 294,
+	CFGKEY_PRELOAD_DISC_IMAGE = 295
 };
 
 struct VideoLineRange
@@ -111,9 +112,10 @@ public:
 	FileIO stvEepromFileIO;
 	std::array<uint64_t, 13> inputBuff; // 12 gamepad buffers + 1 for misc keys
 	static constexpr int maxFrameBuffWidth = 704, maxFrameBuffHeight = 576;
-	alignas(8) uint32_t pixBuff[maxFrameBuffWidth * maxFrameBuffHeight];
+	DynArray<uint32_t> pixBuff; // sized for the current video mode and pixel format
 	MutablePixmapView mSurfacePix;
 	std::vector<CDInterface *> CDInterfaces;
+	size_t cdImageMemorySize{};
 	std::string naBiosPath;
 	std::string jpBiosPath;
 	std::string kof95ROMPath;
@@ -132,6 +134,8 @@ public:
 	bool correctLineAspect{};
 	bool autoRTCTime{true};
 	bool noMD5InFilenames{};
+	bool lowMemoryMode{};
+	bool preloadDiscImage{};
 	Rotation sysContentRotation{Rotation::ANY};
 	WidescreenMode widescreenMode{WidescreenMode::Auto};
 
@@ -194,7 +198,7 @@ public:
 	bool onPointerInputStart(const Input::MotionEvent &e, Input::DragTrackerState, WRect gameRect);
 	bool onPointerInputEnd(const Input::MotionEvent &, Input::DragTrackerState, WRect);
 	Rotation contentRotation() const;
-	void addThreadGroupIds(std::vector<ThreadId> &ids) const { ids.emplace_back(MDFN_IEN_SS::RThreadId); }
+	void addThreadGroupIds(std::vector<ThreadId> &) const;
 };
 
 using MainSystem = SaturnSystem;
@@ -80,6 +80,8 @@ bool SaturnSystem::readConfig(ConfigType type, MapIO &io, unsigned key)
 			case CFGKEY_DEFAULT_PAL_VIDEO_LINES: return readOptionValue(io, defaultPalLines, linesAreValid<288>);
 			case CFGKEY_DEFAULT_SHOW_H_OVERSCAN: return readOptionValue(io, defaultShowHOverscan);
 			case CFGKEY_NO_MD5_FILENAMES: return readOptionValue(io, noMD5InFilenames);
+			case CFGKEY_LOW_MEMORY_MODE: return readOptionValue(io, lowMemoryMode);
+			case CFGKEY_PRELOAD_DISC_IMAGE: return readOptionValue(io, preloadDiscImage);
 		}
 	}
 	else if(type == ConfigType::SESSION)
@@ -113,6 +115,8 @@ void SaturnSystem::writeConfig(ConfigType type, FileIO &io)
 		writeOptionValueIfNotDefault(io, CFGKEY_DEFAULT_PAL_VIDEO_LINES, defaultPalLines, safePalLines);
 		writeOptionValueIfNotDefault(io, CFGKEY_DEFAULT_SHOW_H_OVERSCAN, defaultShowHOverscan, false);
 		writeOptionValueIfNotDefault(io, CFGKEY_NO_MD5_FILENAMES, noMD5InFilenames, false);
+		writeOptionValueIfNotDefault(io, CFGKEY_LOW_MEMORY_MODE, lowMemoryMode, false);
+		writeOptionValueIfNotDefault(io, CFGKEY_PRELOAD_DISC_IMAGE, preloadDiscImage, false);
 	}
 	else if(type == ConfigType::SESSION)
 	{
@@ -28,6 +28,7 @@
 #include <mednafen/resampler/resampler.h>
 #include <mednafen/hw_cpu/m68k/m68k.h>
 #include <mednafen/jump.h>
+#include <emuframework/StageProfiler.hh>
 
 #ifndef MDFN_SSFPLAY_COMPILE
 #include "ss.h"
@@ -289,6 +290,7 @@ void SOUND_SetClockRatio(uint32 ratio)
 
 sscpu_timestamp_t SOUND_Update(sscpu_timestamp_t timestamp)
 {
+ EmuEx::ScopedStageTimer stageTimer{EmuEx::ProfileStage::sound};
  run_until_time += ((uint64)(timestamp - lastts) * clock_ratio);
  lastts = timestamp;
  //
@@ -340,6 +342,7 @@ void SOUND_StartFrame(double rate, uint32 quality)
 
 int32 SOUND_FlushOutput(int16* SoundBuf, const int32 SoundBufMaxSize, const bool reverse)
 {
+ EmuEx::ScopedStageTimer stageTimer{EmuEx::ProfileStage::sound};
  if(SoundBuf && reverse)
  {
   for(unsigned lr = 0; lr < 2; lr++)
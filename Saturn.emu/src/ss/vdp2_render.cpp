@@ -31,6 +31,7 @@
 #include "vdp2_common.h"
 #include "vdp2_render.h"
 #include <imagine/thread/Thread.hh>
+#include <emuframework/StageProfiler.hh>
 #include <imagine/util/container/RingBuffer.hh>
 
 #include <atomic>
@@ -3187,7 +3188,6 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
 //
 //
 static MThreading::Thread* RThread = NULL;
-IG::ThreadId RThreadId{};
 
 enum
 {
@@ -3220,8 +3220,6 @@ static INLINE void WWQ(uint16 command, uint32 arg32 = 0, uint16 arg16 = 0)
 
 static int RThreadEntry(void* data)
 {
- RThreadId = IG::thisThreadId();
-
  auto nextCommand = []() { return WQ.pop({.blocking = true}); };
  for(WQ_Entry entry = nextCommand(); entry.Command != COMMAND_EXIT; entry = nextCommand())
  {
@@ -3238,8 +3236,11 @@ static int RThreadEntry(void* data)
 	break;
 
    case COMMAND_DRAW_LINE:
-	//for(unsigned i = 0; i < 2; i++)
-	DrawLine((uint16)wqe->Arg32, wqe->Arg32 >> 16, wqe->Arg16);
+	{
+	 EmuEx::ScopedStageTimer stageTimer{EmuEx::ProfileStage::video};
+	 //for(unsigned i = 0; i < 2; i++)
+	 DrawLine((uint16)wqe->Arg32, wqe->Arg32 >> 16, wqe->Arg16);
+	}
 	//
 	break;
 
@@ -3346,7 +3347,6 @@ void VDP2REND_Kill(void)
   WQ.notifyWrite();
   MThreading::Thread_Wait(RThread, NULL);
   RThread = NULL;
-  RThreadId = {};
  }
 }
 
@@ -72,6 +72,7 @@ main/options.cc \
 main/S9XApi.cc \
 main/EmuMenuViews.cc \
 main/Cheats.cc \
+main/ReadAheadStream.cc \
 $(addprefix $(snes9xPath)/,$(snes9xSrc))
 
 include $(EMUFRAMEWORK_PATH)/package/emuframework.mk
@@ -0,0 +1 @@
+include $(IMAGINE_PATH)/make/shortcut/common-builds/linux-x86_64-bench.mk
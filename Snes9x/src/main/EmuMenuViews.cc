@@ -184,6 +184,18 @@ class ConsoleOptionView : public TableView, public MainAppHelper
 		}
 	};
 
+	BoolMenuItem sa1RunUntilSync
+	{
+		"Run SA-1 In Larger Slices", attachParams(),
+		(bool)system().optionSA1RunUntilSync,
+		[this](BoolMenuItem &item, View &, Input::Event e)
+		{
+			system().sessionOptionSet();
+			system().optionSA1RunUntilSync = item.flipBoolValue(*this);
+			Settings.SA1RunUntilSync = system().optionSA1RunUntilSync;
+		}
+	};
+
 	void setSuperFXClock(unsigned val)
 	{
 		system().sessionOptionSet();
@@ -239,7 +251,7 @@ class ConsoleOptionView : public TableView, public MainAppHelper
 	};
 	#endif
 
-	std::array<MenuItem*, IS_SNES9X_VERSION_1_4 ? 6 : 10> menuItem
+	std::array<MenuItem*, IS_SNES9X_VERSION_1_4 ? 6 : 11> menuItem
 	{
 		&inputPorts,
 		&multitap,
@@ -252,6 +264,7 @@ class ConsoleOptionView : public TableView, public MainAppHelper
 		&blockInvalidVRAMAccess,
 		&separateEchoBuffer,
 		&superFXClock,
+		&sa1RunUntilSync,
 		#endif
 	};
 
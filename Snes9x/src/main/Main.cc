@@ -31,6 +31,7 @@ namespace EmuEx
 {
 
 const char *EmuSystem::creditsViewStr = CREDITS_INFO_STRING "(c) 2011-2024\nRobert Broglia\nwww.explusalpha.com\n\nPortions (c) the\nSnes9x Team\nwww.snes9x.com";
+bool EmuSystem::hasGzipStates = true;
 #if PIXEL_FORMAT == RGB565
 constexpr auto srcPixFmt = IG::PixelFmtRGB565;
 #else
@@ -182,7 +183,7 @@ size_t Snes9xSystem::writeState(std::span<uint8_t> buff, SaveStateFlags flags)
 	{
 		auto uncompArr = DynArray<uint8_t>(saveStateSize);
 		freezeStateTo(uncompArr);
-		return compressGzip(buff, uncompArr, Z_DEFAULT_COMPRESSION);
+		return compressState(buff, uncompArr, flags, Z_DEFAULT_COMPRESSION);
 	}
 }
 
@@ -27,6 +27,7 @@ enum
 	CFGKEY_CHEATS_PATH = 284, CFGKEY_PATCHES_PATH = 285,
 	CFGKEY_SATELLAVIEW_PATH = 286, CFGKEY_SUFAMI_BIOS_PATH = 287,
 	CFGKEY_BSX_BIOS_PATH = 288, CFGKEY_DEINTERLACE_MODE = 289,
+	CFGKEY_SA1_RUN_UNTIL_SYNC = 290,
 };
 
 #ifdef SNES9X_VERSION_1_4
@@ -84,6 +85,7 @@ public:
 	Property<bool, CFGKEY_SEPARATE_ECHO_BUFFER> optionSeparateEchoBuffer;
 	Property<uint8_t, CFGKEY_SUPERFX_CLOCK_MULTIPLIER,
 		PropertyDesc<uint8_t>{.defaultValue = 100, .isValid = isValidWithMinMax<5, 250>}> optionSuperFXClockMultiplier;
+	Property<bool, CFGKEY_SA1_RUN_UNTIL_SYNC> optionSA1RunUntilSync;
 	Property<uint8_t, CFGKEY_AUDIO_DSP_INTERPOLATON,
 		PropertyDesc<uint8_t>{.defaultValue = DSP_INTERPOLATION_GAUSSIAN, .isValid = isValidWithMax<4>}> optionAudioDSPInterpolation;
 	#endif
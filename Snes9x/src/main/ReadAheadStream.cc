@@ -0,0 +1,240 @@
+#include <imagine/logger/logger.h>
+#include <emuframework/EmuApp.hh>
+#include "MainSystem.hh"
+#include <snes9x.h>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"ReadAheadStream"};
+constexpr size_t chunkSize = 44100 * 4; // 1 second of 16-bit stereo MSU-1 PCM
+
+// Buffers a stream that's mostly read sequentially so the emulation thread doesn't
+// block on storage. A worker thread fills the next chunk while the current one is
+// consumed and, when idle, the chunk at keepPos so looping back to it needs no read.
+class ReadAheadStream final : public Stream
+{
+public:
+	ReadAheadStream(Stream *s, size_t keepPos):
+		stream{s},
+		size_{s->size()},
+		streamPos{s->pos()},
+		readPos{streamPos}
+	{
+		front.data.resize(chunkSize);
+		back.data.resize(chunkSize);
+		if(keepPos < size_)
+		{
+			kept.data.resize(chunkSize);
+			kept.start = keepPos;
+		}
+		requestFill(readPos);
+		thread = std::thread{[this]{ run(); }};
+	}
+
+	~ReadAheadStream() final
+	{
+		{
+			std::scoped_lock lock{mutex};
+			quit = true;
+		}
+		cond.notify_all();
+		thread.join();
+		stream->closeStream();
+	}
+
+	int get_char() final
+	{
+		uint8 c;
+		return read(&c, 1) ? c : EOF;
+	}
+
+	char *gets(char *buf, size_t len) final
+	{
+		size_t i{};
+		while(i + 1 < len)
+		{
+			int c = get_char();
+			if(c == EOF)
+				break;
+			buf[i++] = c;
+			if(c == '\n')
+				break;
+		}
+		if(!i)
+			return nullptr;
+		buf[i] = 0;
+		return buf;
+	}
+
+	size_t read(void *buf, size_t len) final
+	{
+		size_t copied{};
+		while(copied < len)
+		{
+			if(!front.contains(readPos) && !loadFront())
+				break;
+			auto n = std::min(len - copied, front.end() - readPos);
+			std::memcpy(static_cast<uint8*>(buf) + copied, &front.data[readPos - front.start], n);
+			readPos += n;
+			copied += n;
+		}
+		return copied;
+	}
+
+	size_t write(void *, size_t) final { return 0; }
+	size_t pos() final { return readPos; }
+	size_t size() final { return size_; }
+
+	int revert(uint8 origin, int32 offset) final
+	{
+		// only moves the read position, the next read picks the buffered chunk or starts a new fill
+		readPos = pos_from_origin_offset(origin, offset);
+		return 0;
+	}
+
+	void closeStream() final { delete this; }
+
+private:
+	struct Chunk
+	{
+		std::vector<uint8> data;
+		size_t start{};
+		size_t size{};
+
+		size_t end() const { return start + size; }
+		bool contains(size_t pos) const { return pos >= start && pos < end(); }
+	};
+
+	Stream *stream; // only accessed by the worker thread after construction
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable cond;
+	Chunk front; // being consumed by the reader
+	Chunk back; // owned by the worker while fillPending
+	Chunk kept; // owned by the worker until keptReady
+	size_t size_;
+	size_t streamPos;
+	size_t readPos;
+	size_t fillStart{};
+	bool fillPending{};
+	bool keptReady{};
+	bool quit{};
+
+	void requestFill(size_t start)
+	{
+		{
+			std::scoped_lock lock{mutex};
+			fillStart = start;
+			fillPending = true;
+		}
+		// the reader may be waiting on the same condition
+		cond.notify_all();
+	}
+
+	// returns true if the worker was still busy
+	bool waitForFill()
+	{
+		std::unique_lock lock{mutex};
+		if(!fillPending)
+			return false;
+		cond.wait(lock, [&]{ return !fillPending; });
+		return true;
+	}
+
+	bool hasKeptChunk() const { return kept.data.size(); }
+
+	bool loadFront()
+	{
+		if(readPos >= size_)
+			return false;
+		bool waited = waitForFill();
+		if(back.contains(readPos))
+		{
+			// a sequential read caught up with the prefetch
+			if(waited && front.size && readPos == front.end())
+			{
+				log.warn("underrun at offset:{}", readPos);
+				EmuApp::get(gAppContext()).frameTimeTelemetry.recordStreamUnderrun();
+			}
+			std::swap(front, back);
+		}
+		else if(hasKeptChunk() && isKeptReady() && kept.contains(readPos))
+		{
+			std::ranges::copy(kept.data, front.data.begin());
+			front.start = kept.start;
+			front.size = kept.size;
+		}
+		else
+		{
+			// seek outside the buffered range, the read has to wait on this fill
+			requestFill(readPos);
+			waitForFill();
+			if(!back.contains(readPos))
+				return false;
+			std::swap(front, back);
+		}
+		if(front.end() < size_)
+			requestFill(front.end());
+		return true;
+	}
+
+	bool isKeptReady()
+	{
+		std::scoped_lock lock{mutex};
+		return keptReady;
+	}
+
+	void fill(Chunk &c, size_t start)
+	{
+		if(streamPos != start)
+			stream->revert(SEEK_SET, start);
+		auto n = stream->read(c.data.data(), chunkSize);
+		if(n > chunkSize) // read error
+			n = 0;
+		streamPos = start + n;
+		c.start = start;
+		c.size = n;
+	}
+
+	void run()
+	{
+		std::unique_lock lock{mutex};
+		while(true)
+		{
+			cond.wait(lock, [&]{ return quit || fillPending || (hasKeptChunk() && !keptReady); });
+			if(quit)
+				return;
+			if(fillPending)
+			{
+				auto start = fillStart;
+				lock.unlock();
+				fill(back, start);
+				lock.lock();
+				fillPending = false;
+				cond.notify_all();
+			}
+			else
+			{
+				lock.unlock();
+				fill(kept, kept.start);
+				lock.lock();
+				keptReady = true;
+			}
+		}
+	}
+};
+
+}
+
+STREAM readAheadStreamHelper(STREAM s, size_t keepPos)
+{
+	return new EmuEx::ReadAheadStream(s, keepPos);
+}
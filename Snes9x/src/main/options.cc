@@ -81,6 +81,7 @@ bool Snes9xSystem::readConfig(ConfigType type, MapIO &io, unsigned key)
 			case CFGKEY_BLOCK_INVALID_VRAM_ACCESS: return readOptionValue(io, optionBlockInvalidVRAMAccess);
 			case CFGKEY_SEPARATE_ECHO_BUFFER: return readOptionValue(io, optionSeparateEchoBuffer);
 			case CFGKEY_SUPERFX_CLOCK_MULTIPLIER: return readOptionValue(io, optionSuperFXClockMultiplier);
+			case CFGKEY_SA1_RUN_UNTIL_SYNC: return readOptionValue(io, optionSA1RunUntilSync);
 			#endif
 		}
 	}
@@ -111,6 +112,7 @@ void Snes9xSystem::writeConfig(ConfigType type, FileIO &io)
 		writeOptionValueIfNotDefault(io, optionBlockInvalidVRAMAccess);
 		writeOptionValueIfNotDefault(io, optionSeparateEchoBuffer);
 		writeOptionValueIfNotDefault(io, optionSuperFXClockMultiplier);
+		writeOptionValueIfNotDefault(io, optionSA1RunUntilSync);
 		#endif
 	}
 }
@@ -122,6 +124,7 @@ void Snes9xSystem::onSessionOptionsLoaded(EmuApp &app)
 	PPU.BlockInvalidVRAMAccess = optionBlockInvalidVRAMAccess;
 	SNES::dsp.spc_dsp.separateEchoBuffer = optionSeparateEchoBuffer;
 	setSuperFXSpeedMultiplier(optionSuperFXClockMultiplier);
+	Settings.SA1RunUntilSync = optionSA1RunUntilSync;
 	#endif
 }
 
@@ -137,6 +140,7 @@ bool Snes9xSystem::resetSessionOptions(EmuApp &app)
 	PPU.BlockInvalidVRAMAccess = optionBlockInvalidVRAMAccess.reset();
 	SNES::dsp.spc_dsp.separateEchoBuffer = optionSeparateEchoBuffer.reset();
 	setSuperFXSpeedMultiplier(optionSuperFXClockMultiplier.reset());
+	Settings.SA1RunUntilSync = optionSA1RunUntilSync.reset();
 	#endif
 	return true;
 }
@@ -174,7 +174,7 @@ void S9xMainLoop2 (void)
 		Registers.PCw++;
 		(*Opcodes[Op].S9xOpcode)();
 
-		if (HAS_SA1)
+		if (HAS_SA1 && S9xSA1NeedsSync())
 			S9xSA1MainLoop();
 	}
 
@@ -932,8 +932,11 @@ bool8 CMemory::Init (void)
 		return (FALSE);
     }
 
-	ROMStorage.resize(MAX_ROM_SIZE + 0x200 + 0x8000);
-	std::fill(ROMStorage.begin(), ROMStorage.end(), 0);
+	// freshly mapped pages read as zero, so remap instead of filling to leave them untouched
+	if(ROMStorage.size() == MAX_ROM_SIZE + 0x200 + 0x8000)
+		ROMStorage.resetElements();
+	else
+		ROMStorage.resize(MAX_ROM_SIZE + 0x200 + 0x8000);
 	SRAMStorage.resize(SRAM_SIZE);
 	std::fill(SRAMStorage.begin(), SRAMStorage.end(), 0);
 	SRAM = &SRAMStorage[0];
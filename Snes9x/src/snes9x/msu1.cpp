@@ -134,6 +134,9 @@ static bool AudioOpen()
 
         MSU1.MSU1_AUDIO_POS = 8;
 
+		// keep storage reads off the emulation thread, with the loop point buffered for repeating tracks
+		audioStream = readAheadStreamHelper(audioStream, audioLoopPos);
+
 		MSU1.MSU1_STATUS &= ~AudioError;
 		return true;
 	}
@@ -959,6 +959,8 @@ void S9xSetPPU (uint8 Byte, uint16 Address)
 		else
 		if (Settings.SA1     && Address >= 0x2200)
 		{
+			if (Settings.SA1RunUntilSync)
+				S9xSA1MainLoop();
 			if (Address <= 0x23ff)
 				S9xSetSA1(Byte, Address);
 			else
@@ -1210,7 +1212,11 @@ uint8 S9xGetPPU (uint16 Address)
 			return (S9xGetSuperFX(Address));
 		else
 		if (Settings.SA1     && Address >= 0x2200)
+		{
+			if (Settings.SA1RunUntilSync)
+				S9xSA1MainLoop();
 			return (S9xGetSA1(Address));
+		}
 		else
 		if (Settings.BS      && Address >= 0x2188 && Address <= 0x219f)
 			return (S9xGetBSXPPU(Address));
@@ -93,6 +93,15 @@ uint8 S9xGetSA1 (uint32);
 void S9xSetSA1 (uint8, uint32);
 void S9xSA1Init (void);
 void S9xSA1MainLoop (void);
+
+// With Settings.SA1RunUntilSync, the SA-1 is only caught up once it's this many of its
+// cycles behind the main CPU, or when the main CPU accesses the SA-1 registers
+#define SA1_SYNC_SLICE	(ONE_DOT_CYCLE * 3 * 32)
+
+static inline bool S9xSA1NeedsSync (void)
+{
+	return !Settings.SA1RunUntilSync || CPU.Cycles * 3 - SA1.Cycles >= SA1_SYNC_SLICE;
+}
 void S9xSA1PostLoadState (void);
 
 static inline void S9xSA1UnpackStatus (void)
@@ -56,6 +56,8 @@ void removeFileHelper(const char *filename);
 #define FIND_STREAM(s)			s->pos()
 #define REVERT_STREAM(s, o, p)	s->revert(p, o)
 #define CLOSE_STREAM(s)			s->closeStream()
+// takes ownership of s and reads it ahead on a worker thread, also keeping the chunk at keepPos for seeks back to it
+STREAM readAheadStreamHelper(STREAM s, size_t keepPos);
 
 #define SNES_WIDTH					256
 #define SNES_HEIGHT					224
@@ -316,6 +318,7 @@ struct SSettings
 
   static const bool8  SeparateEchoBuffer = 0;
 	uint32	SuperFXClockMultiplier = 100;
+	bool8	SA1RunUntilSync = 0;
   static const int OverclockMode = 0;
 	static const int	OneClockCycle = 6;
 	static const int	OneSlowClockCycle = 8;
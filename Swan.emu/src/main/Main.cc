@@ -42,6 +42,7 @@ namespace EmuEx
 using namespace MDFN_IEN_WSWAN;
 
 const char *EmuSystem::creditsViewStr = CREDITS_INFO_STRING "(c) 2011-2024\nRobert Broglia\nwww.explusalpha.com\n\nPortions (c) the\nMednafen Team\nmednafen.github.io";
+bool EmuSystem::hasGzipStates = true;
 bool EmuApp::needsGlobalInstance = true;
 
 EmuSystem::NameFilterFunc EmuSystem::defaultFsFilter =
@@ -140,7 +141,7 @@ void WsSystem::configAudioRate(FrameTime outputFrameTime, int outputRate)
 void WsSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio)
 {
 	static constexpr size_t maxAudioFrames = 48000 / minFrameRate;
-	EmuEx::runFrame(*this, mdfnGameInfo, taskCtx, video, mSurfacePix, audio, maxAudioFrames);
+	EmuEx::runFrame(*this, mdfnGameInfo, taskCtx, video, mSurfacePix, audio, maxAudioFrames, 0, true);
 	if(configuredLCDVTotal != lcdVTotal()) [[unlikely]]
 	{
 		onFrameTimeChanged();
@@ -171,7 +172,7 @@ namespace Mednafen
 
 void MDFND_commitVideoFrame(EmulateSpecStruct *espec)
 {
-	espec->video->startFrameWithFormat(espec->taskCtx, static_cast<EmuEx::WsSystem&>(*espec->sys).mSurfacePix);
+	EmuEx::commitVideoFrame(*espec, static_cast<EmuEx::WsSystem&>(*espec->sys).mSurfacePix);
 }
 
 }
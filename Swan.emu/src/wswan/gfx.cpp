@@ -27,6 +27,7 @@
 #include "comm.h"
 #include <mednafen/video.h>
 #include <trio/trio.h>
+#include <emuframework/DirtyLineTracker.hh>
 
 namespace MDFN_IEN_WSWAN
 {
@@ -39,6 +40,9 @@ static uint32 wsCols[16][16];
 
 static uint32 ColorMapG[16];
 static uint32 ColorMap[16*16*16];
+// Lines are first resolved to 12-bit colors, or gray levels tagged with bit 12 in mono mode,
+// which fully determine the output so they're also what the dirty line tracker compares
+static EmuEx::DirtyLineTracker lineTracker{144, 224 * sizeof(uint16)};
 static uint32 LayerEnabled;
 
 static uint8 wsLine;                 /*current scanline*/
@@ -534,7 +538,10 @@ bool wsExecuteLine(EmulateSpecStruct *espec, MDFN_Surface *surface, bool skip)
         if(wsLine == 144)
         {
   	            if(espec->video)
+  	            {
+  	             espec->lineTracker = &lineTracker;
   	             MDFND_commitVideoFrame(espec);
+  	            }
 		FrameWhichActive = !FrameWhichActive;
                 ret = true;
                 WSwan_Interrupt(WSINT_VBLANK);
@@ -627,18 +634,32 @@ void WSwan_SetPixelFormat(const MDFN_PixelFormat &format)
  }
 }
 
+static INLINE void wsResolveScanline(uint16* MDFN_RESTRICT colors, uint8* MDFN_RESTRICT bg, uint8* MDFN_RESTRICT bg_pal)
+{
+	if(wsVMode)
+	{
+	 for(size_t l = 0; l < 224; l++)
+	  colors[l] = wsCols[bg_pal[l]][bg[l] & 0xF];
+	}
+	else
+	{
+	 for(size_t l = 0; l < 224; l++)
+	  colors[l] = 0x1000 | (bg[l] & 0xF);
+	}
+}
+
 template<typename T>
-static INLINE void wsBlitScanline(T* MDFN_RESTRICT target, uint8* MDFN_RESTRICT bg, uint8* MDFN_RESTRICT bg_pal)
+static INLINE void wsBlitScanline(T* MDFN_RESTRICT target, const uint16* MDFN_RESTRICT colors)
 {
 	if(wsVMode)
 	{
 	 for(size_t l = 0; l < 224; l++)
-	  target[l] = ColorMap[wsCols[bg_pal[l]][bg[l] & 0xF]];
+	  target[l] = ColorMap[colors[l]];
 	}
 	else
 	{
 	 for(size_t l = 0; l < 224; l++)
-	  target[l] = ColorMapG[bg[l] & 0xF];
+	  target[l] = ColorMapG[colors[l] & 0xF];
 	}
 }
 
@@ -907,10 +928,13 @@ static void wsScanline(MDFN_Surface* surface)
 	//
 	//
 	//
+	uint16 colors[224];
+	wsResolveScanline(colors, b_bg + 7, b_bg_pal + 7);
+	lineTracker.updateLine(wsLine, colors);
 	if(surface->format.opp == 4)
-	 wsBlitScanline<uint32>(surface->pix<uint32>() + wsLine * surface->pitchinpix, b_bg + 7, b_bg_pal + 7);
+	 wsBlitScanline<uint32>(surface->pix<uint32>() + wsLine * surface->pitchinpix, colors);
 	else
-	 wsBlitScanline<uint16>(surface->pix<uint16>() + wsLine * surface->pitchinpix, b_bg + 7, b_bg_pal + 7);
+	 wsBlitScanline<uint16>(surface->pix<uint16>() + wsLine * surface->pitchinpix, colors);
 }
 
 void WSwan_GfxReset(void)
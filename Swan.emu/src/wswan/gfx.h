@@ -16,7 +16,6 @@ MDFN_HIDE extern uint8	wsTCacheFlipped2[512*64];  	  //tiles cache (H flip)
 MDFN_HIDE extern uint8	wsTCacheUpdate2[512];	  //tiles cache flags
 MDFN_HIDE extern int	wsVMode;			  //Video Mode	
 
-void wsMakeTiles(void);
 void wsGetTile(uint32,uint32,int,int,int);
 void wsSetVideo(int, bool);
 
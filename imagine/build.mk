@@ -24,6 +24,7 @@ include $(imagineSrcDir)/font/system.mk
 include $(imagineSrcDir)/data-type/image/system.mk
 include $(imagineSrcDir)/thread/system.mk
 include $(imagineSrcDir)/vmem/system.mk
+include $(imagineSrcDir)/util/MemoryAccounting.mk
 include $(imagineSrcDir)/logger/system.mk
 include $(buildSysPath)/package/stdc++.mk
 
@@ -26,6 +26,9 @@
 	#if CONFIG_PACKAGE_PULSEAUDIO
 	#include <imagine/audio/pulseaudio/PAOutputStream.hh>
 	#endif
+	#if CONFIG_PACKAGE_PIPEWIRE
+	#include <imagine/audio/pipewire/PWOutputStream.hh>
+	#endif
 	#if CONFIG_PACKAGE_ALSA
 	#include <imagine/audio/alsa/ALSAOutputStream.hh>
 	#endif
@@ -74,6 +77,9 @@ using OutputStreamVariant = std::variant<CAOutputStream, NullOutputStream>;
 	#ifdef CONFIG_PACKAGE_PULSEAUDIO
 	PAOutputStream,
 	#endif
+	#ifdef CONFIG_PACKAGE_PIPEWIRE
+	PWOutputStream,
+	#endif
 	#ifdef CONFIG_PACKAGE_ALSA
 	ALSAOutputStream,
 	#endif
@@ -96,6 +102,8 @@ public:
 	void flush();
 	bool isOpen();
 	bool isPlaying();
+	// frames the device consumes per callback when the API reports it, otherwise 0
+	int framesPerBurst();
 	void reset();
 	explicit constexpr operator bool() const { return !std::holds_alternative<NullOutputStream>(*this); }
 };
@@ -40,6 +40,7 @@ public:
 	void flush();
 	bool isOpen();
 	bool isPlaying();
+	int framesPerBurst();
 	explicit operator bool() const;
 
 private:
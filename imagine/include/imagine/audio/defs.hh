@@ -38,6 +38,7 @@ enum class Api: uint8_t
 	COREAUDIO,
 	OPENSL_ES,
 	AAUDIO,
+	PIPEWIRE,
 };
 
 #if defined __ANDROID__
@@ -49,6 +50,9 @@ constexpr std::array systemApis{Api::COREAUDIO};
 	#ifdef CONFIG_PACKAGE_PULSEAUDIO
 	Api::PULSEAUDIO,
 	#endif
+	#ifdef CONFIG_PACKAGE_PIPEWIRE
+	Api::PIPEWIRE,
+	#endif
 	#ifdef CONFIG_PACKAGE_ALSA
 	Api::ALSA,
 	#endif
@@ -0,0 +1,52 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/audio/defs.hh>
+#include <imagine/audio/Format.hh>
+
+struct pw_thread_loop;
+struct pw_stream;
+
+namespace IG::Audio
+{
+
+class PWOutputStream
+{
+public:
+	PWOutputStream();
+	~PWOutputStream();
+	PWOutputStream &operator=(PWOutputStream &&) = delete;
+	StreamError open(OutputStreamConfig config);
+	void play();
+	void pause();
+	void close();
+	void flush();
+	bool isOpen();
+	bool isPlaying();
+	int framesPerBurst();
+	explicit operator bool() const;
+
+private:
+	pw_thread_loop *loop{};
+	pw_stream *stream{};
+	OnSamplesNeededDelegate onSamplesNeeded{};
+	Format pcmFormat;
+	uint32_t quantumFrames{};
+	bool isActive{};
+};
+
+}
@@ -117,8 +117,14 @@ public:
 	// CPU configuration
 	int cpuCount() const;
 	int maxCPUFrequencyKHz(int cpuIdx) const;
+	int cpuCapacity(int cpuIdx) const; // relative performance reported by the scheduler, 0 if unknown
+	int64_t batteryPowerMicrowatts() const; // instantaneous battery draw, 0 if unknown or not on battery
 	CPUMask performanceCPUMask() const;
+	CPUMask efficiencyCPUMask() const;
 	PerformanceHintManager performanceHintManager();
+	ThermalStatus thermalStatus() const;
+	// forecast fraction of the throttling threshold in the given time, 1 and above means throttling, NaN if unknown
+	float thermalHeadroom(Seconds forecast) const;
 
 	// App Callbacks
 
@@ -208,6 +214,8 @@ public:
 	void endIdleByUserActivity();
 	bool hasSustainedPerformanceMode() const;
 	void setSustainedPerformanceMode(bool on);
+	GameMode gameMode() const; // mode chosen by the user in the system's game settings
+	void setGameState(bool isLoading, bool inGameplay);
 
 	// Permissions
 	bool usesPermission(Permission p) const;
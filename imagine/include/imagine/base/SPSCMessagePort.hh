@@ -0,0 +1,196 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/config/defs.hh>
+#include <imagine/base/CustomEvent.hh>
+#include <imagine/base/MessagePort.hh>
+#include <imagine/util/concepts.hh>
+#include <imagine/util/utility.h>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <thread>
+
+namespace IG
+{
+
+// Single producer, single consumer message port backed by a shared memory ring.
+// The consumer's event loop is only woken through the doorbell (an eventfd on Linux)
+// when it has drained the ring and gone idle, so messages sent while it's still
+// processing cost no system calls.
+template<class MsgType, size_t capacity = 16>
+class SPSCMessagePort
+{
+public:
+	static_assert(std::has_single_bit(capacity), "capacity must be a power of 2");
+	static_assert(std::is_trivially_copyable_v<MsgType>);
+
+	class Messages
+	{
+	public:
+		struct Sentinel {};
+
+		class Iterator
+		{
+		public:
+			constexpr Iterator(SPSCMessagePort &port): port{&port}
+			{
+				this->operator++();
+			}
+
+			Iterator operator++()
+			{
+				if(!port) [[unlikely]]
+					return *this;
+				if(!port->pop(msg))
+					port = nullptr; // end of messages
+				return *this;
+			}
+
+			bool operator==(Sentinel) const { return !port; }
+			const MsgType &operator*() const { return msg; }
+
+		private:
+			SPSCMessagePort *port{};
+			MsgType msg;
+		};
+
+		constexpr Messages(SPSCMessagePort &port): port{port} {}
+		auto begin() const { return Iterator{port}; }
+		auto end() const { return Sentinel{}; }
+
+	protected:
+		SPSCMessagePort &port;
+	};
+
+	SPSCMessagePort(const char *debugLabel = nullptr):
+		doorbell{debugLabel} {}
+
+	// called from the consumer thread
+	void attach(EventLoop loop, auto &&f)
+	{
+		using F = std::decay_t<decltype(f)>;
+		consumerIdle.store(true, std::memory_order_seq_cst);
+		doorbell.attach(loop, [this, f = IG_forward(f)]()
+		{
+			do
+			{
+				wakeRequested.store(false, std::memory_order_relaxed);
+				Messages msgs{*this};
+				if constexpr(Callable<F, bool, Messages>)
+				{
+					if(!f(msgs))
+						return;
+				}
+				else
+				{
+					f(msgs);
+				}
+			} while(!goIdle());
+		});
+		// handle anything sent before attaching
+		if(readIdx.load(std::memory_order_relaxed) != writeIdx.load(std::memory_order_acquire))
+			wake();
+	}
+
+	void detach()
+	{
+		doorbell.detach();
+	}
+
+	// called from the producer thread, yields while the ring is full
+	bool send(MsgType msg)
+	{
+		auto writePos = writeIdx.load(std::memory_order_relaxed);
+		while(writePos - readIdx.load(std::memory_order_acquire) == capacity) [[unlikely]]
+		{
+			std::this_thread::yield();
+		}
+		ring[writePos & (capacity - 1)] = msg;
+		writeIdx.store(writePos + 1, std::memory_order_seq_cst);
+		wake();
+		return true;
+	}
+
+	bool send(MsgType msg, MessageReplyMode mode)
+	{
+		if(mode == MessageReplyMode::wait)
+		{
+			std::binary_semaphore replySemaphore{0};
+			return send(msg, &replySemaphore);
+		}
+		else
+		{
+			return send(msg);
+		}
+	}
+
+	bool send(ReplySemaphoreSettableMessage auto msg, std::binary_semaphore *semPtr)
+	{
+		if(semPtr)
+		{
+			msg.setReplySemaphore(semPtr);
+			send(msg);
+			semPtr->acquire();
+			return true;
+		}
+		else
+		{
+			return send(msg);
+		}
+	}
+
+	// rings the doorbell if the consumer is idle, callable from any thread
+	void wake()
+	{
+		wakeRequested.store(true, std::memory_order_seq_cst);
+		if(consumerIdle.exchange(false, std::memory_order_seq_cst))
+			doorbell.notify();
+	}
+
+	explicit operator bool() const { return (bool)doorbell; }
+
+protected:
+	CustomEvent doorbell;
+	alignas(64) std::atomic_size_t writeIdx{};
+	alignas(64) std::atomic_size_t readIdx{};
+	std::atomic_bool consumerIdle{true};
+	std::atomic_bool wakeRequested{};
+	std::array<MsgType, capacity> ring{};
+
+	bool pop(MsgType &msg)
+	{
+		auto readPos = readIdx.load(std::memory_order_relaxed);
+		if(readPos == writeIdx.load(std::memory_order_acquire))
+			return false;
+		msg = ring[readPos & (capacity - 1)];
+		readIdx.store(readPos + 1, std::memory_order_release);
+		return true;
+	}
+
+	// returns false if messages or wake requests arrived while going idle and must be processed
+	bool goIdle()
+	{
+		consumerIdle.store(true, std::memory_order_seq_cst);
+		if(!wakeRequested.load(std::memory_order_seq_cst))
+			return true;
+		// a producer may have seen the consumer busy and skipped the doorbell
+		return !consumerIdle.exchange(false, std::memory_order_seq_cst);
+	}
+};
+
+}
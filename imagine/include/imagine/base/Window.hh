@@ -54,7 +54,8 @@ public:
 	void drawNow(bool needsSync = false);
 	Screen *screen() const;
 	NativeWindow nativeObject() const;
-	void setIntendedFrameRate(FrameRate rate);
+	// fixedSource hints that content is produced at exactly this rate, letting a variable refresh display match it
+	void setIntendedFrameRate(FrameRate rate, bool fixedSource = false);
 	void setFormat(NativeWindowFormat);
 	void setFormat(PixelFormat);
 	PixelFormat pixelFormat() const;
@@ -235,6 +235,12 @@ struct WindowDrawParams
 
 enum class ScreenChange : int8_t { added, removed, frameRate };
 
+// matches the severity levels of Android's thermal status API
+enum class ThermalStatus : int8_t { none, light, moderate, severe, critical, emergency, shutdown };
+
+// matches the modes of Android's GameManager API
+enum class GameMode : int8_t { unsupported, standard, performance, battery, custom };
+
 WISE_ENUM_CLASS((SensorType, uint8_t),
 	(Accelerometer, 1),
 	(Gyroscope, 4),
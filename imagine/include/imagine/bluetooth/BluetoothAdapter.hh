@@ -27,6 +27,7 @@
 
 #include <imagine/util/DelegateFunc.hh>
 #include <imagine/base/ApplicationContext.hh>
+#include <imagine/time/Time.hh>
 #include <imagine/util/used.hh>
 #include <system_error>
 
@@ -71,7 +72,8 @@ protected:
 class BluetoothSocket : public BluetoothSocketImpl
 {
 public:
-	using OnDataDelegate = DelegateFunc<bool (const char* data, size_t size)>;
+	// time is when the report arrived, which can be earlier than the callback if the event loop was busy
+	using OnDataDelegate = DelegateFunc<bool (const char* data, size_t size, SteadyClockTimePoint time)>;
 	using OnStatusDelegate = DelegateFunc<uint32_t (BluetoothSocket&, BluetoothSocketState)>;
 	using State = BluetoothSocketState;
 
@@ -30,7 +30,7 @@ public:
 	bool open1Ctl(BluetoothAdapter &adapter, BluetoothPendingSocket &pending, Input::Device &);
 	bool open2Int(BluetoothAdapter &adapter, BluetoothPendingSocket &pending);
 	void close();
-	bool dataHandler(Input::Device &, const char *data, size_t size);
+	bool dataHandler(Input::Device &, const char *data, size_t size, SteadyClockTimePoint);
 	uint32_t statusHandler(Input::Device &, BluetoothSocket &, BluetoothSocketState status);
 	void setLEDs(uint32_t player);
 	const char *keyName(Input::Key k) const;
@@ -40,7 +40,7 @@ public:
 	Wiimote(ApplicationContext, BluetoothAddr);
 	~Wiimote();
 	bool open(BluetoothAdapter &, Input::Device &) final;
-	bool dataHandler(Input::Device &, const char *data, size_t size);
+	bool dataHandler(Input::Device &, const char *data, size_t size, SteadyClockTimePoint);
 	uint32_t statusHandler(Input::Device &, BluetoothSocket &, BluetoothSocketState status);
 	void requestStatus();
 	void setLEDs(uint8_t player);
@@ -31,7 +31,7 @@ public:
 	bool open(BluetoothAdapter &, Input::Device &) final;
 	void close();
 	uint32_t statusHandler(Input::Device&, BluetoothSocket&, BluetoothSocketState);
-	bool dataHandler(Input::Device &, const char *packet, size_t size);
+	bool dataHandler(Input::Device &, const char *packet, size_t size, SteadyClockTimePoint);
 	const char *keyName(Input::Key k) const;
 	std::span<Input::Axis> motionAxes() { return axis; };
 	static bool isSupportedClass(std::array<uint8_t, 3> devClass);
@@ -73,6 +73,7 @@ bool access(CStringView path, acc type);
 bool remove(CStringView path);
 bool create_directory(CStringView path);
 bool rename(CStringView oldPath, CStringView newPath);
+bool last_write_time(CStringView path, file_time_type time);
 
 PathString makeAppPathFromLaunchCommand(CStringView launchPath);
 FileString basename(CStringView path);
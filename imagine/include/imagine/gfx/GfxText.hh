@@ -96,6 +96,8 @@ protected:
 	int ySize{};
 	GlyphSetMetrics metrics;
 	ITexQuads quads;
+	TextLayoutConfig layoutConfig;
+	uint32_t faceGeneration{}; // GlyphTextureSet::generation() when the quads were written
 
 	bool hasText() const;
 };
@@ -19,6 +19,7 @@
 #include <imagine/font/Font.hh>
 #include <imagine/gfx/Texture.hh>
 #include <imagine/util/container/VMemArray.hh>
+#include <deque>
 #include <string_view>
 
 namespace IG::Gfx
@@ -28,10 +29,13 @@ constexpr auto glyphSamplerConfig = SamplerConfigs::noMipClamp;
 
 struct GlyphEntry
 {
-	Texture glyph;
+	TextureSpan glyph; // region of an atlas page
 	GlyphMetrics metrics;
 };
 
+// Glyphs are rendered on first use and packed into shared atlas textures,
+// so a string with all its glyphs in one page can be drawn in a single call
+
 class GlyphTextureSet
 {
 public:
@@ -49,6 +53,8 @@ public:
 	int nominalHeight() const { return metrics().nominalHeight; }
 	void freeCaches(uint32_t rangeToFreeBits);
 	void freeCaches() { freeCaches(~0); }
+	// changes when glyphs move to different atlas locations so compiled text can be updated
+	uint32_t generation() const { return generation_; }
 
 private:
 	Font font;
@@ -57,10 +63,16 @@ private:
 	FontSize faceSize;
 	GlyphSetMetrics metrics_;
 	uint32_t usedGlyphTableBits{};
+	uint32_t generation_{};
+	std::deque<Texture> atlasPages; // deque keeps page addresses stable for the glyph entries
+	WPt atlasPos; // next free position in the last page
+	int atlasRowHeight{};
+	int atlasPageSize{};
 
 	void calcMetrics(Renderer &r);
 	void resetGlyphTable();
 	bool cacheChar(Renderer &r, int c, int tableIdx);
+	TextureSpan addToAtlas(Renderer &r, PixmapView);
 };
 
 }
@@ -50,6 +50,8 @@ public:
 	operator TextureSpan() const;
 	operator const Texture&() const;
 	bool isExternal() const;
+	// times the writer had to wait for the GPU to release a buffer
+	uint32_t bufferStalls() const;
 };
 
 }
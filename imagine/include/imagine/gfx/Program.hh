@@ -62,6 +62,9 @@ public:
 	using ProgramImpl::ProgramImpl;
 	Program(RendererTask &, NativeShader vShader, NativeShader fShader,
 		ProgramFlags, std::span<UniformLocationDesc>);
+	// compiles the sources in compat mode, or loads the program from the binary cache if it was made before
+	Program(RendererTask &, std::span<std::string_view> vShaderSrcs, std::span<std::string_view> fShaderSrcs,
+		ProgramFlags, std::span<UniformLocationDesc>);
 	int uniformLocation(const char *name);
 	void uniform(int location, float v1);
 	void uniform(int location, float v1, float v2);
@@ -98,6 +98,7 @@ public:
 	void setCorrectnessChecks(bool on);
 	std::vector<DrawableConfigDesc> supportedDrawableConfigs() const;
 	bool hasBgraFormat(TextureBufferMode) const;
+	DrawStats lastFrameDrawStats() const;
 
 	// shaders
 
@@ -92,6 +92,8 @@ public:
 	void setClipRect(ClipRect b);
 	void setTexture(const Texture &t);
 	void set(TextureBinding);
+	// binds to another texture unit for shaders sampling more than one texture, unit 0 stays active
+	void set(TextureBinding, int unit);
 	void setTextureSampler(const TextureSampler &sampler);
 	void setViewport(Viewport v);
 	void restoreViewport();
@@ -39,6 +39,8 @@ public:
 	using LockedTextureBufferImpl::LockedTextureBufferImpl;
 	MutablePixmapView pixmap() const;
 	WRect sourceDirtyRect() const;
+	// only upload lines [start, end) on unlock, an empty range skips the upload
+	void setDirtyLines(int start, int end);
 	explicit operator bool() const;
 };
 
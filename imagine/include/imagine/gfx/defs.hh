@@ -77,6 +77,18 @@ enum class BlendEquation: uint8_t { ADD, SUB, RSUB };
 
 enum class Faces: uint8_t { BOTH, FRONT, BACK };
 
+// Graphics API work done by the renderer for one presented frame
+struct DrawStats
+{
+	uint32_t drawCalls{};
+	uint32_t textureBinds{};
+	uint32_t programSwitches{};
+	uint32_t stateChanges{};
+	uint32_t textureUploads{};
+	uint32_t bufferUploads{};
+	uint32_t uploadBytes{};
+};
+
 enum class ColorName: uint8_t
 {
 	RED,
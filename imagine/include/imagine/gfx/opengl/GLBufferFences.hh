@@ -0,0 +1,58 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/config/defs.hh>
+#include <imagine/gfx/defs.hh>
+#include <array>
+#include <atomic>
+
+namespace IG::Gfx
+{
+
+// Tracks when the GPU is done with each CPU-written buffer of a multi-buffered texture
+// so a buffer is only handed back to the writer once the commands reading it completed.
+// Fences are only used with EGL where they can be waited on outside the GL context,
+// otherwise only completion of the render thread task is tracked.
+class GLBufferFences
+{
+public:
+	static constexpr int8_t maxBuffers = 3;
+
+	// kept at a fixed address, such as in a unique_ptr, since render thread tasks refer to it
+	GLBufferFences(RendererTask &);
+	GLBufferFences &operator=(GLBufferFences &&) = delete;
+	~GLBufferFences();
+	// called after the writer submits the buffer
+	void markSubmitted(int8_t idx);
+	// queue a fence on the render thread after all commands reading the buffer
+	void queueFence(int8_t idx);
+	// wait for the buffer to be released, returns true if it had to wait
+	bool acquire(int8_t idx);
+	void reset();
+	uint32_t stalls() const { return stallCount.load(std::memory_order_relaxed); }
+
+private:
+	RendererTask &task;
+	std::array<std::atomic<void*>, maxBuffers> fences{};
+	std::array<std::atomic_bool, maxBuffers> pending{};
+	std::atomic_uint32_t stallCount{};
+	bool useFences{};
+
+	void deleteFence(int8_t idx);
+};
+
+}
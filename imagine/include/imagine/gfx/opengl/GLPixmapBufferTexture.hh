@@ -20,6 +20,7 @@
 #include <imagine/gfx/opengl/android/SurfaceTextureStorage.hh>
 #endif
 #include <imagine/gfx/Texture.hh>
+#include <imagine/gfx/opengl/GLBufferFences.hh>
 #include <memory>
 #include <variant>
 #include <array>
@@ -38,29 +39,30 @@ public:
 
 	GLTextureStorage(RendererTask &rTask, TextureConfig config, bool singleBuffer):
 		Texture{rTask, config},
-		bufferIdx{singleBuffer ? SINGLE_BUFFER_VALUE : (int8_t)0} {}
+		fences{singleBuffer ? nullptr : std::make_unique<GLBufferFences>(rTask)},
+		bufferCount{singleBuffer ? int8_t(1) : GLBufferFences::maxBuffers} {}
 
 	bool setFormat(PixmapDesc, ColorSpace, TextureSamplerConfig);
 	void writeAligned(PixmapView pixmap, int assumeAlign, TextureWriteFlags writeFlags = {});
 	LockedTextureBuffer lock(TextureBufferFlags bufferFlags = {});
 	void unlock(LockedTextureBuffer lockBuff, TextureWriteFlags writeFlags = {});
-	bool isSingleBuffered() const { return bufferIdx == SINGLE_BUFFER_VALUE; }
+	bool isSingleBuffered() const { return bufferCount == 1; }
+	uint32_t bufferStalls() const { return fences ? fences->stalls() : 0; }
 
 protected:
+	std::unique_ptr<GLBufferFences> fences;
+	std::array<BufferInfo, GLBufferFences::maxBuffers> info{};
 	int8_t bufferIdx{};
-	std::array<BufferInfo, 2> info{};
-	static constexpr int8_t SINGLE_BUFFER_VALUE = 2;
+	int8_t bufferCount{1};
 
 	BufferInfo currentBuffer() const
 	{
-		return isSingleBuffered() ? info[0] : info[bufferIdx];
+		return info[bufferIdx];
 	}
 
 	void swapBuffer()
 	{
-		if(isSingleBuffered())
-			return;
-		bufferIdx = (bufferIdx + 1) % 2;
+		bufferIdx = (bufferIdx + 1) % bufferCount;
 	}
 };
 
@@ -76,7 +78,7 @@ class GLSystemMemoryStorage final: public GLTextureStorage<GLSystemMemoryStorage
 public:
 	constexpr GLSystemMemoryStorage() = default;
 	GLSystemMemoryStorage(RendererTask &rTask, TextureConfig config, bool singleBuffer);
-	void initBuffer(PixmapDesc desc, bool singleBuffer);
+	void initBuffer(PixmapDesc desc);
 
 private:
 	std::unique_ptr<char[]> storage;
@@ -95,11 +97,13 @@ class GLPixelBufferStorage final: public GLTextureStorage<GLPixelBufferStorage,
 public:
 	constexpr GLPixelBufferStorage() = default;
 	GLPixelBufferStorage(RendererTask &rTask, TextureConfig config, bool singleBuffer);
-	void initBuffer(PixmapDesc desc, bool singleBuffer);
+	void initBuffer(PixmapDesc desc);
 	GLuint pbo() const { return pixelBuff.get(); }
+	bool pboIsCoherent() const { return coherentMapping; }
 
 private:
 	UniqueGLBuffer pixelBuff{};
+	bool coherentMapping{};
 };
 
 using GLPixmapBufferTextureVariant = std::variant<
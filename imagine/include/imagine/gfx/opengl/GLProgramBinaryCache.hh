@@ -0,0 +1,58 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/config/defs.hh>
+#include <imagine/base/GLContext.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <imagine/util/string/CStringView.hh>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace IG::Gfx
+{
+
+struct GLProgramBinary
+{
+	GLenum format{};
+	std::vector<uint8_t> data;
+
+	explicit operator bool() const { return data.size(); }
+};
+
+// Keeps linked program binaries in the app cache directory so shaders don't need compiling
+// on every launch. Entries are keyed by a hash of the shader sources & program settings and
+// the whole cache is cleared when the GL renderer or driver version changes.
+class GLProgramBinaryCache
+{
+public:
+	constexpr GLProgramBinaryCache() = default;
+	void init(CStringView cachePath, std::string_view driverId);
+	uint64_t key(std::span<std::string_view> vShaderSrcs, std::span<std::string_view> fShaderSrcs, uint32_t settings) const;
+	GLProgramBinary load(uint64_t key) const;
+	void store(uint64_t key, const GLProgramBinary &) const;
+	void remove(uint64_t key) const;
+	explicit operator bool() const { return dirPath.size(); }
+
+private:
+	FS::PathString dirPath;
+
+	FS::PathString entryPath(uint64_t key) const;
+};
+
+}
@@ -23,8 +23,10 @@
 #include <imagine/gfx/RendererTask.hh>
 #include <imagine/gfx/BasicEffect.hh>
 #include <imagine/gfx/Quads.hh>
+#include <imagine/gfx/opengl/GLProgramBinaryCache.hh>
 #include <imagine/util/used.hh>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string_view>
 #ifdef CONFIG_BASE_GL_PLATFORM_EGL
@@ -48,6 +50,18 @@
 #define GL_RED 0x1903
 #endif
 
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
 namespace IG
 {
 class ApplicationContext;
@@ -121,6 +135,10 @@ public:
 		//static void glWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) { ::glWaitSync(sync, flags, timeout); }
 		#endif
 	#endif
+	// GL ES 3.0, GL 4.1, or GL_OES/ARB_get_program_binary
+	void (* GL_APIENTRY glGetProgramBinary)(GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary){};
+	void (* GL_APIENTRY glProgramBinary)(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length){};
+	void (* GL_APIENTRY glProgramParameteri)(GLuint program, GLenum pname, GLint value){};
 	#ifdef __ANDROID__
 	void (GL_APIENTRYP glEGLImageTargetTexStorageEXT)(GLenum target, GLeglImageOES image, const GLint* attrib_list){};
 	#endif
@@ -155,6 +173,7 @@ public:
 	bool hasImmutableBufferStorage() const;
 	bool hasMemoryBarriers() const;
 	bool hasVAOFuncs() const;
+	bool hasProgramBinary() const;
 	GLsync fenceSync(GLDisplay dpy);
 	void deleteSync(GLDisplay dpy, GLsync sync);
 	GLenum clientWaitSync(GLDisplay dpy, GLsync sync, GLbitfield flags, GLuint64 timeout);
@@ -162,6 +181,21 @@ public:
 	void setGLDebugOutput(bool on);
 };
 
+// Counts are added from the rendering thread and latched at each present
+// so the previous frame's totals can be read from any thread
+class GLDrawStatsCounter
+{
+public:
+	DrawStats frame;
+
+	void endFrame(uint32_t stateChanges);
+	DrawStats lastFrame() const;
+
+private:
+	mutable std::mutex mutex;
+	DrawStats lastFrame_;
+};
+
 class GLRenderer
 {
 public:
@@ -171,6 +205,8 @@ public:
 	BasicEffect basicEffect_{};
 	Gfx::QuadIndexArray<uint8_t> quadIndices;
 	CustomEvent releaseShaderCompilerEvent{CustomEvent::NullInit{}};
+	GLProgramBinaryCache programBinaryCache;
+	GLDrawStatsCounter drawStats;
 
 	GLRenderer(ApplicationContext);
 	GLDisplay glDisplay() const;
@@ -190,6 +226,7 @@ protected:
 	void setupImmutableBufferStorage();
 	void setupMemoryBarrier();
 	void setupVAOFuncs(bool oes = false);
+	void setupProgramBinary(bool oes = false);
 	void setupFenceSync();
 	void setupAppleFenceSync();
 	void setupEglFenceSync(std::string_view eglExtenstionStr);
@@ -37,6 +37,7 @@ public:
 	};
 
 	static bool verifyState;
+	uint32_t changes{}; // GL calls that weren't filtered out
 
 	GLenum blendFuncSfactor = -1, blendFuncDfactor = -1;
 	void blendFunc(GLenum sfactor, GLenum dfactor);
@@ -22,6 +22,7 @@
 #include <imagine/pixmap/Pixmap.hh>
 #include <imagine/util/used.hh>
 #include <imagine/util/memory/UniqueResource.hh>
+#include <imagine/util/memory/MemoryAccounting.hh>
 #ifdef __ANDROID__
 #include <EGL/egl.h>
 #include <EGL/eglext.h>
@@ -37,14 +38,15 @@ class GLLockedTextureBuffer
 public:
 	constexpr GLLockedTextureBuffer() = default;
 	constexpr GLLockedTextureBuffer(void *bufferOffset, MutablePixmapView pix, WRect srcDirtyRect,
-		int lockedLevel, bool shouldFreeBuffer, GLuint pbo = 0):
+		int lockedLevel, bool shouldFreeBuffer, GLuint pbo = 0, bool pboIsCoherent = false):
 		bufferOffset_{bufferOffset}, pix{pix},
 		lockedLevel{(int8_t)lockedLevel}, shouldFreeBuffer_{shouldFreeBuffer},
-		srcDirtyRect{srcDirtyRect}, pbo_{pbo}
+		pboIsCoherent_{pboIsCoherent}, srcDirtyRect{srcDirtyRect}, pbo_{pbo}
 	{}
 	int level() const { return lockedLevel; }
 	GLuint pbo() const { return pbo_; }
 	bool shouldFreeBuffer() const { return shouldFreeBuffer_; }
+	bool pboIsCoherent() const { return pboIsCoherent_; }
 	void *bufferOffset() const { return bufferOffset_; }
 
 protected:
@@ -52,6 +54,7 @@ protected:
 	MutablePixmapView pix{};
 	int8_t lockedLevel{};
 	bool shouldFreeBuffer_{};
+	bool pboIsCoherent_{};
 	WRect srcDirtyRect{};
 	GLuint pbo_ = 0;
 };
@@ -85,6 +88,7 @@ public:
 protected:
 	UniqueGLTextureRef texName_{};
 	PixmapDesc pixDesc{};
+	MemoryCharge<MemoryCategory::texture> storageCharge;
 	int8_t levels_{};
 	TextureType type_{TextureType::UNSET};
 
@@ -19,6 +19,8 @@
 #include <imagine/base/android/HardwareBuffer.hh>
 #include <imagine/base/android/GraphicBuffer.hh>
 #include "egl.hh"
+#include <imagine/gfx/opengl/GLBufferFences.hh>
+#include <memory>
 #include <type_traits>
 #include <array>
 
@@ -47,6 +49,7 @@ public:
 	bool setFormat(PixmapDesc, ColorSpace, TextureSamplerConfig);
 	LockedTextureBuffer lock(TextureBufferFlags bufferFlags);
 	void unlock(LockedTextureBuffer lockBuff, TextureWriteFlags writeFlags);
+	uint32_t bufferStalls() const { return fences->stalls(); }
 
 protected:
 	struct EGLImageDeleter
@@ -61,8 +64,10 @@ protected:
 		uint32_t pitchBytes{};
 	};
 
-	std::array<BufferInfo, 2> bufferInfo{};
-	uint8_t bufferIdx{};
+	std::unique_ptr<GLBufferFences> fences;
+	std::array<BufferInfo, GLBufferFences::maxBuffers> bufferInfo{};
+	int8_t bufferIdx{};
+	int8_t boundIdx{-1}; // buffer currently sampled by the texture
 
 	void swapBuffer();
 };
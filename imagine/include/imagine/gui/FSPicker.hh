@@ -28,6 +28,9 @@
 #include <vector>
 #include <string>
 #include <string_view>
+#include <mutex>
+#include <optional>
+#include <span>
 
 namespace IG::FS
 {
@@ -62,6 +65,23 @@ public:
 
 	enum class DepthMode { increment, decrement, reset };
 
+	// unfiltered directory contents as returned by the file system
+	struct DirListEntry
+	{
+		std::string path;
+		std::string name;
+		FS::file_type type{};
+
+		bool operator==(const DirListEntry &) const = default;
+	};
+
+	struct DirListing
+	{
+		std::string path;
+		FS::file_time_type lastWriteTime{};
+		std::vector<DirListEntry> entries; // in display order
+	};
+
 	FSPicker(ViewAttachParams attach, Gfx::TextureSpan backRes, Gfx::TextureSpan closeRes,
 			FilterFunc filter = {}, Mode mode = Mode::FILE, Gfx::GlyphTextureSet *face = {});
 	void place() override;
@@ -101,6 +121,13 @@ protected:
 	Mode mode_{};
 	bool showHiddenFiles_{};
 	WorkThread dirListThread{};
+	// results passed from dirListThread, guarded by dirListMutex
+	std::mutex dirListMutex;
+	std::vector<DirListEntry> pendingEntries;
+	std::optional<DirListing> finishedListing;
+	std::string dirListError;
+	bool showingCachedListing{};
+	bool restoredUIState{};
 
 	void changeDirByInput(CStringView path, FS::RootPathInfo, const Input::Event &,
 		DepthMode depthMode = DepthMode::increment);
@@ -108,7 +135,11 @@ protected:
 	Gfx::GlyphTextureSet &face();
 	TableView &fileTableView();
 	void startDirectoryListThread(CStringView path);
-	void listDirectory(CStringView path, ThreadStop &stop);
+	void listDirectory(CStringView path, std::optional<FS::file_time_type> cachedWriteTime, ThreadStop &stop);
+	void updateDirectoryList();
+	void addEntries(std::span<const DirListEntry>);
+	void showEntries();
+	void clearPendingEntries();
 	void setEmptyPath(std::string_view message);
 };
 
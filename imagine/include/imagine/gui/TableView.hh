@@ -83,6 +83,11 @@ public:
 	void resetName(UTF16Convertible auto &&name) { nameStr = IG_forward(name); }
 	void resetName() { nameStr.clear(); }
 	void resetItemSource(ItemSourceDelegate src = [](ItemMessage) -> ItemReply { return 0uz; }) { itemSrc = src; }
+	// Only place and prepare the rows on screen, for lists too large to lay out up front.
+	// The item source may then recycle a pool of items larger than visibleRows(), re-binding
+	// one to a new row with compile(), and the scroll extent comes from the row count.
+	void setVirtualRows(bool on) { virtualRows = on; }
+	int visibleRows() const { return visibleCells; }
 
 protected:
 	static constexpr size_t maxSeparators = 32;
@@ -98,8 +103,13 @@ protected:
 	bool onlyScrollIfNeeded = false;
 	bool selectedIsActivated = false;
 	bool hasFocus = true;
+	bool virtualRows = false;
+	mutable ssize_t placedRowsStart{};
+	mutable ssize_t placedRowsEnd{};
 
 	void setYCellSize(int s);
+	std::pair<ssize_t, ssize_t> visibleRowRange(ssize_t cells) const;
+	void placeVisibleRows(ssize_t cells) const;
 	WRect focusRect();
 	void onSelectElement(const Input::Event &, size_t i, MenuItem &);
 	int nextSelectableElement(int start, int items);
@@ -68,7 +68,9 @@ protected:
 
 	UniqueAAsset asset{};
 	MapIO mapIO{};
+	bool mappedFromFd{};
 
+	bool mapUncompressed();
 	bool makeMapIO();
 	static void closeAAsset(AAsset *);
 };
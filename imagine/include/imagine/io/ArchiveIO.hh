@@ -60,6 +60,8 @@ public:
 	bool hasEntry() const;
 	bool hasArchive() const { return arch.get(); }
 	void rewind();
+	// returns the IO of the archive file itself and closes the archive
+	IO releaseIO();
 	struct archive* archive() const { return arch.get(); }
 	ssize_t read(void *buff, size_t bytes, std::optional<off_t> offset = {});
 	ssize_t write(const void *buff, size_t bytes, std::optional<off_t> offset = {});
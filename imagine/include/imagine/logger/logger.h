@@ -15,6 +15,8 @@ typedef uint8_t LoggerSeverity;
 CLINK void logger_setLogDirectoryPrefix(const char *dirStr) __attribute__((cold));
 CLINK void logger_setEnabled(bool enable);
 CLINK bool logger_isEnabled();
+// print formatted messages from a background thread, see Log::printMsg()
+CLINK void logger_setAsync(bool async);
 CLINK void logger_printf(LoggerSeverity severity, const char* msg, ...) __attribute__((format (printf, 2, 3)));
 CLINK void logger_vprintf(LoggerSeverity severity, const char* msg, va_list arg);
 
@@ -23,6 +23,7 @@
 #include <imagine/util/mdspan.hh>
 #include <imagine/util/concepts.hh>
 #include <cstring>
+#include <span>
 
 namespace IG
 {
@@ -41,6 +42,16 @@ uint32_t transformRGB565ToBGRX8888(uint16_t p);
 uint32_t transformRGB888ToRGBX8888(RGBTripleArray p);
 uint32_t transformRGB888ToBGRX8888(RGBTripleArray p);
 
+// Run conversions over count pixels, vectorized with SSE2 or NEON when the target has them,
+// results are identical to the single pixel versions above
+void transformNRGB565ToRGBX8888(const uint16_t *src, size_t count, uint32_t *dest);
+void transformNRGB565ToBGRX8888(const uint16_t *src, size_t count, uint32_t *dest);
+void transformNRGBX8888ToRGB565(const uint32_t *src, size_t count, uint16_t *dest);
+void transformNBGRX8888ToRGB565(const uint32_t *src, size_t count, uint16_t *dest);
+void transformNRGBA8888ToBGRA8888(const uint32_t *src, size_t count, uint32_t *dest);
+// expands 8-bit indices using a 256 entry palette
+void transformNIndexedToRGB16(const uint8_t *src, size_t count, uint16_t *dest, const uint16_t *palette);
+
 template <class Func>
 concept PixmapTransformFunc =
 		requires (Func &&f, unsigned data){ f(data); } ||
@@ -313,6 +324,18 @@ public:
 		subView(destPos, size() - destPos).writeTransformed(func, pixmap);
 	}
 
+	// write 8-bit indices from pixmap after looking them up in a 16-bit palette
+	void writeIndexed(std::span<const uint16_t, 256> palette, auto pixmap) requires(dataIsMutable)
+	{
+		assumeExpr(pixmap.format().bytesPerPixel() == 1);
+		assumeExpr(format().bytesPerPixel() == 2);
+		writeLines<uint8_t, uint16_t>(pixmap,
+			[&](const uint8_t *src, size_t count, uint16_t *dest)
+			{
+				transformNIndexedToRGB16(src, count, dest, palette.data());
+			});
+	}
+
 	template <class Src, class Dest>
 	void writeTransformedDirect(PixmapTransformFunc auto &&func, auto pixmap) requires(dataIsMutable)
 	{
@@ -367,6 +390,29 @@ protected:
 		}
 	}
 
+	// calls lineFunc(src, count, dest) once for unpadded data, otherwise once per line
+	template <class Src, class Dest>
+	void writeLines(auto pixmap, auto &&lineFunc) requires(dataIsMutable)
+	{
+		auto srcData = (const Src*)pixmap.data();
+		auto destData = (Dest*)data_;
+		if(w() == pixmap.w() && !isPadded() && !pixmap.isPadded())
+		{
+			lineFunc(srcData, size_t(pixmap.w() * pixmap.h()), destData);
+		}
+		else
+		{
+			auto srcPitchPixels = pixmap.pitchPx();
+			auto destPitchPixels = pitchPx();
+			for(auto h : iotaCount(pixmap.h()))
+			{
+				lineFunc(srcData, size_t(pixmap.w()), destData);
+				srcData += srcPitchPixels;
+				destData += destPitchPixels;
+			}
+		}
+	}
+
 	static void invalidFormatConversion(auto dest, auto src)
 	{
 		bug_unreachable("unimplemented conversion:%s -> %s", src.format().name(), dest.format().name());
@@ -384,12 +430,12 @@ protected:
 
 	static void convertRGB565ToRGBX8888(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGB565ToRGBX8888, src);
+		dest.template writeLines<uint16_t, uint32_t>(src, transformNRGB565ToRGBX8888);
 	}
 
 	static void convertRGB565ToBGRX8888(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGB565ToBGRX8888, src);
+		dest.template writeLines<uint16_t, uint32_t>(src, transformNRGB565ToBGRX8888);
 	}
 
 	static void convertRGBX8888ToRGB888(auto dest, auto src)
@@ -414,17 +460,17 @@ protected:
 
 	static void convertRGBX8888ToRGB565(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGBX8888ToRGB565, src);
+		dest.template writeLines<uint32_t, uint16_t>(src, transformNRGBX8888ToRGB565);
 	}
 
 	static void convertRGBA8888ToBGRA8888(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGBA8888ToBGRA8888, src);
+		dest.template writeLines<uint32_t, uint32_t>(src, transformNRGBA8888ToBGRA8888);
 	}
 
 	static void convertBGRX8888ToRGB565(auto dest, auto src)
 	{
-		dest.template writeTransformed(transformBGRX8888ToRGB565, src);
+		dest.template writeLines<uint32_t, uint16_t>(src, transformNBGRX8888ToRGB565);
 	}
 };
 
@@ -0,0 +1,101 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/config/defs.hh>
+#include <imagine/thread/Thread.hh>
+#include <imagine/util/DelegateFunc.hh>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace IG
+{
+
+// Fixed-size pool of worker threads for short jobs submitted every frame, such as slices of a
+// frame's rendering, so subsystems don't need to own threads. Jobs are queued per worker
+// round-robin and idle workers steal from the others. The worker thread IDs can be added to
+// a thread group to apply the same CPU affinity or performance hints as the frame threads.
+class JobPool
+{
+public:
+	using Job = DelegateFuncS<sizeof(void*) * 4, void()>;
+
+	JobPool() = default;
+	JobPool(int threads, const char *name = "JobPool");
+	~JobPool();
+	JobPool &operator=(JobPool &&) = delete;
+	explicit operator bool() const { return workers.size(); }
+	int threads() const { return workers.size(); }
+	void submit(Job);
+	// runs queued jobs on the calling thread until all submitted jobs complete
+	void wait();
+	void addThreadIds(std::vector<ThreadId> &) const;
+
+	// splits [0, count) into one range per thread plus the caller and waits for them,
+	// f is called as f(begin, end) and must stay valid until this returns
+	void parallelFor(size_t count, auto &&f)
+	{
+		size_t slices = std::min(count, size_t(threads()) + 1);
+		if(slices <= 1)
+		{
+			if(count)
+				f(size_t{}, count);
+			return;
+		}
+		size_t sliceSize = count / slices, extra = count % slices;
+		size_t begin = 0;
+		for(size_t i = 0; i < slices; i++)
+		{
+			size_t end = begin + sliceSize + (i < extra ? 1 : 0);
+			if(i == slices - 1)
+				f(begin, end); // the caller takes the last slice
+			else
+				submit([&f, begin, end]{ f(begin, end); });
+			begin = end;
+		}
+		wait();
+	}
+
+private:
+	struct Worker
+	{
+		std::mutex mutex;
+		std::deque<Job> jobs;
+		std::thread thread;
+		ThreadId id{};
+	};
+
+	std::vector<std::unique_ptr<Worker>> workers;
+	std::mutex mutex;
+	std::condition_variable jobCond;
+	std::condition_variable idleCond;
+	std::atomic_uint32_t pendingJobs{};
+	std::atomic_int queuedJobs{}; // can briefly go negative when a job is taken before it's counted
+	uint32_t nextWorker{};
+	bool quit{};
+
+	void run(int idx);
+	bool runOneJob(int preferredIdx);
+	void finishJob();
+};
+
+}
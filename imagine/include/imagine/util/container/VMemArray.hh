@@ -35,7 +35,8 @@ public:
 
 	constexpr VMemArray() = default;
 
-	VMemArray(size_t size)
+	VMemArray(size_t size, VMemFlags flags = {}):
+		flags{flags}
 	{
 		resize(size);
 	}
@@ -81,13 +82,16 @@ public:
 		allocateStorage(size());
 	}
 
+	void setFlags(VMemFlags flags_) { flags = flags_; }
+
 private:
 	UniqueVPtr<T> buff;
+	VMemFlags flags{};
 
 	void allocateStorage(size_t size)
 	{
 		buff.reset();
-		buff = makeUniqueVPtr<T>(size);
+		buff = makeUniqueVPtr<T>(size, flags);
 	}
 
 };
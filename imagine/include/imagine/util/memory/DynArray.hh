@@ -15,6 +15,7 @@
 	You should have received a copy of the GNU General Public License
 	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
 
+#include <imagine/util/memory/MemoryAccounting.hh>
 #include <memory>
 #include <span>
 
@@ -32,10 +33,12 @@ public:
 	constexpr DynArray() = default;
 	constexpr explicit DynArray(size_t size):
 		ptr{std::make_unique<T[]>(size)},
-		size_{size} {}
+		size_{size},
+		charge{size * sizeof(T)} {}
 	constexpr DynArray(size_t size, ForOverwrite):
 		ptr{std::make_unique_for_overwrite<T[]>(size)},
-		size_{size} {}
+		size_{size},
+		charge{size * sizeof(T)} {}
 	constexpr auto data(this auto&& self) { return self.ptr.get(); }
 	constexpr size_t size() const { return size_; }
 	constexpr auto& operator[] (this auto&& self, size_t idx) { return self.data()[idx]; }
@@ -45,7 +48,11 @@ public:
 	constexpr operator std::span<T>() const { return span(); }
 	auto reset(size_t size) { *this = DynArray{size}; }
 	auto resetForOverwrite(size_t size) { *this = DynArray{size, ForOverwrite{}}; }
-	auto release() { return ptr.release(); }
+	auto release()
+	{
+		charge.set(0);
+		return ptr.release();
+	}
 
 	constexpr void trim(size_t smallerSize)
 	{
@@ -56,6 +63,7 @@ public:
 private:
 	std::unique_ptr<T[]> ptr;
 	size_t size_{};
+	MemoryCharge<MemoryCategory::dynArray> charge; // keeps the allocated size after trim()
 };
 
 template<class T>
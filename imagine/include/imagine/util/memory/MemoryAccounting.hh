@@ -0,0 +1,80 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/util/enum.hh>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace IG
+{
+
+// The first three group memory by how it's allocated, the rest by who owns it,
+// so owner categories overlap the allocator ones, e.g. rewind states live in vmem
+WISE_ENUM_CLASS((MemoryCategory, uint8_t),
+	vmem,
+	dynArray,
+	texture,
+	rewind,
+	audio,
+	guest);
+
+constexpr size_t memoryCategories = wise_enum::size<MemoryCategory>;
+
+// Live totals and high-water marks of tracked allocations, safe to update from any thread
+namespace MemoryAccounting
+{
+
+void add(MemoryCategory, size_t bytes);
+void sub(MemoryCategory, size_t bytes);
+size_t current(MemoryCategory);
+size_t peak(MemoryCategory);
+
+}
+
+// Charges its size to a category for as long as it lives, for owners that don't allocate through a tracked path
+template<MemoryCategory category>
+class MemoryCharge
+{
+public:
+	constexpr MemoryCharge() = default;
+	explicit MemoryCharge(size_t bytes) { set(bytes); }
+	MemoryCharge(MemoryCharge &&o) noexcept: bytes_{std::exchange(o.bytes_, 0)} {}
+	MemoryCharge &operator=(MemoryCharge &&o) noexcept
+	{
+		set(0);
+		bytes_ = std::exchange(o.bytes_, 0);
+		return *this;
+	}
+	~MemoryCharge() { set(0); }
+
+	void set(size_t bytes)
+	{
+		if(bytes > bytes_)
+			MemoryAccounting::add(category, bytes - bytes_);
+		else if(bytes < bytes_)
+			MemoryAccounting::sub(category, bytes_ - bytes);
+		bytes_ = bytes;
+	}
+
+	size_t bytes() const { return bytes_; }
+
+private:
+	size_t bytes_{};
+};
+
+}
@@ -26,9 +26,20 @@ namespace IG
 
 extern uintptr_t pageSize;
 
-std::span<uint8_t> vAlloc(size_t bytes);
+struct VMemFlags
+{
+	uint8_t
+	// back the memory with huge/large pages when the OS supports it to reduce TLB misses
+	hugePages:1{},
+	// lock the memory in RAM so it's never paged out
+	locked:1{};
+};
+
+std::span<uint8_t> vAlloc(size_t bytes, VMemFlags flags = {});
 std::span<uint8_t> vAllocMirrored(size_t bytes);
 void vFree(std::span<uint8_t>);
+// Applies flags to the whole pages within existing memory, like a large static array, before it's first used
+bool vAdvise(std::span<uint8_t>, VMemFlags);
 
 inline uintptr_t truncPageSize(uintptr_t addr)
 {
@@ -55,9 +66,9 @@ inline auto roundPageSize(uint8_t *p)
 }
 
 template <class T>
-inline std::span<T> vNew(size_t size)
+inline std::span<T> vNew(size_t size, VMemFlags flags = {})
 {
-	auto buff = vAlloc(size * sizeof(T));
+	auto buff = vAlloc(size * sizeof(T), flags);
 	return {reinterpret_cast<T*>(buff.data()), size};
 }
 
@@ -94,9 +105,9 @@ template<class T>
 using UniqueVPtr = std::unique_ptr<T[], VPtrDeleter<T>>;
 
 template<class T>
-inline UniqueVPtr<T> makeUniqueVPtr(size_t size)
+inline UniqueVPtr<T> makeUniqueVPtr(size_t size, VMemFlags flags = {})
 {
-	auto buff = vNew<T>(size);
+	auto buff = vNew<T>(size, flags);
 	return {buff.data(), VPtrDeleter<T>{buff.size()}};
 }
 
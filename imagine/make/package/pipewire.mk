@@ -0,0 +1,8 @@
+ifndef inc_pkg_pipewire
+inc_pkg_pipewire := 1
+
+configEnable += CONFIG_PACKAGE_PIPEWIRE
+
+pkgConfigDeps += libpipewire-0.3
+
+endif
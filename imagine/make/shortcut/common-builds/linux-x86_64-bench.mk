@@ -0,0 +1,8 @@
+include $(IMAGINE_PATH)/make/config.mk
+# release build for headless benchmark runs (app launched with --bench <frames> <content path>)
+O_RELEASE := 1
+LTO_MODE ?= lto
+targetExtension := -bench
+-include $(projectPath)/config.mk
+include $(IMAGINE_PATH)/make/linux-x86_64-gcc.mk
+include $(projectPath)/build.mk
@@ -51,6 +51,9 @@ static constexpr ApiDesc apiDesc[]
 	#ifdef CONFIG_PACKAGE_PULSEAUDIO
 	{"PulseAudio", Api::PULSEAUDIO},
 	#endif
+	#ifdef CONFIG_PACKAGE_PIPEWIRE
+	{"PipeWire", Api::PIPEWIRE},
+	#endif
 	#ifdef CONFIG_PACKAGE_ALSA
 	{"ALSA", Api::ALSA},
 	#endif
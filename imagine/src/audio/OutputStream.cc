@@ -31,6 +31,9 @@ void OutputStream::setApi(const Manager &mgr, Api api)
 		#ifdef CONFIG_PACKAGE_PULSEAUDIO
 		case Api::PULSEAUDIO: emplace<PAOutputStream>(); return;
 		#endif
+		#ifdef CONFIG_PACKAGE_PIPEWIRE
+		case Api::PIPEWIRE: emplace<PWOutputStream>(); return;
+		#endif
 		#ifdef CONFIG_PACKAGE_ALSA
 		case Api::ALSA: emplace<ALSAOutputStream>(); return;
 		#endif
@@ -53,6 +56,17 @@ void OutputStream::close() { visit([&](auto &v){ v.close(); }); }
 void OutputStream::flush() { visit([&](auto &v){ v.flush(); }); }
 bool OutputStream::isOpen() { return visit([&](auto &v){ return v.isOpen(); }); }
 bool OutputStream::isPlaying() { return visit([&](auto &v){ return v.isPlaying(); }); }
+
+int OutputStream::framesPerBurst()
+{
+	return visit([&](auto &v)
+	{
+		if constexpr(requires{ v.framesPerBurst(); })
+			return v.framesPerBurst();
+		else
+			return 0;
+	});
+}
 void OutputStream::reset() { emplace<NullOutputStream>(); }
 
 OutputStreamConfig Manager::makeNativeOutputStreamConfig() const
@@ -42,6 +42,8 @@ static aaudio_result_t (*AAudioStream_requestPause)(AAudioStream* stream){};
 static aaudio_result_t (*AAudioStream_requestFlush)(AAudioStream* stream){};
 static aaudio_result_t (*AAudioStream_requestStop)(AAudioStream* stream){};
 static aaudio_stream_state_t (*AAudioStream_getState)(AAudioStream *stream){};
+static int32_t (*AAudioStream_getFramesPerBurst)(AAudioStream* stream){};
+static aaudio_result_t (*AAudioStream_setBufferSizeInFrames)(AAudioStream* stream, int32_t numFrames){};
 static aaudio_result_t (*AAudioStream_waitForStateChange)(AAudioStream *stream, aaudio_stream_state_t inputState,
 	aaudio_stream_state_t *nextState, int64_t timeoutNanoseconds){};
 
@@ -77,6 +79,8 @@ static void loadAAudioLib(const Manager &manager)
 	loadSymbol(AAudioStream_requestFlush, lib, "AAudioStream_requestFlush");
 	loadSymbol(AAudioStream_requestStop, lib, "AAudioStream_requestStop");
 	loadSymbol(AAudioStream_getState, lib, "AAudioStream_getState");
+	loadSymbol(AAudioStream_getFramesPerBurst, lib, "AAudioStream_getFramesPerBurst");
+	loadSymbol(AAudioStream_setBufferSizeInFrames, lib, "AAudioStream_setBufferSizeInFrames");
 	loadSymbol(AAudioStream_waitForStateChange, lib, "AAudioStream_waitForStateChange");
 	if(manager.hasStreamUsage())
 	{
@@ -178,6 +182,17 @@ StreamError AAudioOutputStream::open(OutputStreamConfig config)
 		log.error("error:{} creating stream", streamResultStr(res));
 		return StreamError::BadArgument;
 	}
+	if(lowLatencyMode)
+	{
+		// double buffer at the burst size, the minimum that avoids glitches on most devices
+		auto burstFrames = AAudioStream_getFramesPerBurst(stream);
+		if(auto res = AAudioStream_setBufferSizeInFrames(stream, burstFrames * 2);
+			res < 0)
+		{
+			log.warn("error:{} setting buffer size to 2 bursts", streamResultStr(res));
+		}
+		log.info("using {} frames per burst", burstFrames);
+	}
 	if(config.startPlaying)
 		play();
 	return {};
@@ -252,6 +267,13 @@ bool AAudioOutputStream::isPlaying()
 	return isPlaying_;
 }
 
+int AAudioOutputStream::framesPerBurst()
+{
+	if(!stream) [[unlikely]]
+		return 0;
+	return AAudioStream_getFramesPerBurst(stream);
+}
+
 AAudioOutputStream::operator bool() const
 {
 	return loadedAAudioLib();
@@ -0,0 +1,8 @@
+ifndef inc_audio_pw
+inc_audio_pw := 1
+
+include $(IMAGINE_PATH)/make/package/pipewire.mk
+
+SRC += audio/OutputStream.cc audio/pipewire/pipewire.cc
+
+endif
@@ -0,0 +1,203 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/audio/pipewire/PWOutputStream.hh>
+#include <imagine/audio/OutputStream.hh>
+#include <imagine/logger/logger.h>
+#include <pipewire/pipewire.h>
+#include <spa/param/audio/format-utils.h>
+#include <algorithm>
+
+namespace IG::Audio
+{
+
+constexpr SystemLogger log{"PipeWire"};
+
+static spa_audio_format pcmFormatToPW(const SampleFormat &format)
+{
+	switch(format.bytes())
+	{
+		case 4 : return format.isFloat() ? SPA_AUDIO_FORMAT_F32 : SPA_AUDIO_FORMAT_S32;
+		case 2 : return SPA_AUDIO_FORMAT_S16;
+		case 1 : return SPA_AUDIO_FORMAT_U8;
+		default:
+			bug_unreachable("bytes == %d", format.bytes());
+	}
+}
+
+PWOutputStream::PWOutputStream()
+{
+	pw_init(nullptr, nullptr);
+	loop = pw_thread_loop_new("IGAudio", nullptr);
+	if(!loop)
+	{
+		log.error("error creating thread loop");
+		pw_deinit();
+		return;
+	}
+	if(pw_thread_loop_start(loop) < 0)
+	{
+		log.error("error starting thread loop");
+		pw_thread_loop_destroy(std::exchange(loop, {}));
+		pw_deinit();
+	}
+}
+
+PWOutputStream::~PWOutputStream()
+{
+	if(!loop)
+		return;
+	close();
+	pw_thread_loop_stop(loop);
+	pw_thread_loop_destroy(loop);
+	pw_deinit();
+}
+
+StreamError PWOutputStream::open(OutputStreamConfig config)
+{
+	if(isOpen())
+	{
+		log.info("audio already open");
+		return {};
+	}
+	if(!loop) [[unlikely]]
+	{
+		return StreamError::BadArgument;
+	}
+	auto format = config.format;
+	pcmFormat = format;
+	onSamplesNeeded = config.onSamplesNeeded;
+	// request a quantum close to the wanted latency so the graph runs without an extra buffering stage
+	auto wantedLatency = config.wantedLatencyHint.count() ? config.wantedLatencyHint : Microseconds{10000};
+	quantumFrames = std::max(uint32_t(format.timeToFrames(wantedLatency)), 64u);
+	auto props = pw_properties_new(PW_KEY_MEDIA_TYPE, "Audio",
+		PW_KEY_MEDIA_CATEGORY, "Playback",
+		PW_KEY_MEDIA_ROLE, "Game",
+		nullptr);
+	pw_properties_setf(props, PW_KEY_NODE_LATENCY, "%u/%u", quantumFrames, format.rate);
+	static constexpr pw_stream_events streamEvents
+	{
+		.version = PW_VERSION_STREAM_EVENTS,
+		.process = [](void *thisPtr_)
+		{
+			// runs on the realtime data thread
+			auto thisPtr = static_cast<PWOutputStream*>(thisPtr_);
+			auto pwBuff = pw_stream_dequeue_buffer(thisPtr->stream);
+			if(!pwBuff) [[unlikely]]
+				return;
+			auto &data = pwBuff->buffer->datas[0];
+			if(!data.data) [[unlikely]]
+				return;
+			auto bytesPerFrame = thisPtr->pcmFormat.bytesPerFrame();
+			uint32_t frames = data.maxsize / bytesPerFrame;
+			if(pwBuff->requested)
+				frames = std::min(frames, uint32_t(pwBuff->requested));
+			assumeExpr(thisPtr->onSamplesNeeded);
+			thisPtr->onSamplesNeeded(data.data, frames);
+			data.chunk->offset = 0;
+			data.chunk->stride = bytesPerFrame;
+			data.chunk->size = frames * bytesPerFrame;
+			pw_stream_queue_buffer(thisPtr->stream, pwBuff);
+		},
+	};
+	pw_thread_loop_lock(loop);
+	stream = pw_stream_new_simple(pw_thread_loop_get_loop(loop), "Playback", props, &streamEvents, this);
+	if(!stream)
+	{
+		pw_thread_loop_unlock(loop);
+		log.error("error creating stream");
+		return StreamError::BadArgument;
+	}
+	uint8_t podBuff[1024];
+	spa_pod_builder builder = SPA_POD_BUILDER_INIT(podBuff, sizeof(podBuff));
+	spa_audio_info_raw info{.format = pcmFormatToPW(format.sample), .rate = uint32_t(format.rate), .channels = uint32_t(format.channels)};
+	const spa_pod *params[]{spa_format_audio_raw_build(&builder, SPA_PARAM_EnumFormat, &info)};
+	isActive = config.startPlaying;
+	auto flags = pw_stream_flags(PW_STREAM_FLAG_AUTOCONNECT | PW_STREAM_FLAG_MAP_BUFFERS |
+		PW_STREAM_FLAG_RT_PROCESS | (isActive ? 0 : PW_STREAM_FLAG_INACTIVE));
+	if(pw_stream_connect(stream, PW_DIRECTION_OUTPUT, PW_ID_ANY, flags, params, std::size(params)) < 0)
+	{
+		pw_stream_destroy(std::exchange(stream, {}));
+		pw_thread_loop_unlock(loop);
+		log.error("error connecting playback stream");
+		return StreamError::BadArgument;
+	}
+	pw_thread_loop_unlock(loop);
+	log.info("opened stream {}Hz, {} channels, quantum:{} frames", format.rate, format.channels, quantumFrames);
+	return {};
+}
+
+void PWOutputStream::play()
+{
+	if(!isOpen()) [[unlikely]]
+		return;
+	pw_thread_loop_lock(loop);
+	pw_stream_set_active(stream, true);
+	pw_thread_loop_unlock(loop);
+	isActive = true;
+}
+
+void PWOutputStream::pause()
+{
+	if(!isOpen()) [[unlikely]]
+		return;
+	log.info("pausing playback");
+	pw_thread_loop_lock(loop);
+	pw_stream_set_active(stream, false);
+	pw_thread_loop_unlock(loop);
+	isActive = false;
+}
+
+void PWOutputStream::close()
+{
+	if(!isOpen())
+		return;
+	pw_thread_loop_lock(loop);
+	pw_stream_destroy(std::exchange(stream, {}));
+	pw_thread_loop_unlock(loop);
+	isActive = false;
+}
+
+void PWOutputStream::flush()
+{
+	if(!isOpen()) [[unlikely]]
+		return;
+	log.info("clearing queued samples");
+	pw_thread_loop_lock(loop);
+	pw_stream_flush(stream, false);
+	pw_thread_loop_unlock(loop);
+}
+
+bool PWOutputStream::isOpen()
+{
+	return stream;
+}
+
+bool PWOutputStream::isPlaying()
+{
+	return isOpen() && isActive;
+}
+
+int PWOutputStream::framesPerBurst()
+{
+	return isOpen() ? quantumFrames : 0;
+}
+
+PWOutputStream::operator bool() const
+{
+	return loop;
+}
+
+}
@@ -1,6 +1,10 @@
 ifeq ($(ENV), linux)
  ifneq ($(SUBENV), pandora)
   include $(imagineSrcDir)/audio/pulseaudio/build.mk
+  # PipeWire output is optional so libpipewire isn't a build dependency by default
+  ifdef linuxPipeWire
+   include $(imagineSrcDir)/audio/pipewire/build.mk
+  endif
   include $(imagineSrcDir)/audio/alsa/build.mk
  else
   include $(imagineSrcDir)/audio/alsa/build.mk
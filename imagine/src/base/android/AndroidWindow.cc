@@ -238,7 +238,7 @@ NativeWindow Window::nativeObject() const
 	return nWin;
 }
 
-void Window::setIntendedFrameRate(FrameRate rate)
+void Window::setIntendedFrameRate(FrameRate rate, bool fixedSource)
 {
 	screen()->setFrameRate(rate);
 	if(appContext().androidSDK() < 30 || !nWin)
@@ -248,9 +248,11 @@ void Window::setIntendedFrameRate(FrameRate rate)
 		auto lib = openSharedLibrary("libnativewindow.so");
 		loadSymbol(ANativeWindow_setFrameRate, lib, "ANativeWindow_setFrameRate");
 	}
-	if(ANativeWindow_setFrameRate(nWin, rate, 0))
+	// ANATIVEWINDOW_FRAME_RATE_COMPATIBILITY_DEFAULT or ANATIVEWINDOW_FRAME_RATE_COMPATIBILITY_FIXED_SOURCE
+	int8_t compatibility = fixedSource ? 1 : 0;
+	if(ANativeWindow_setFrameRate(nWin, rate, compatibility))
 	{
-		log.error("error in ANativeWindow_setFrameRate() with window:{} rate:{:g}", (void*)nWin, rate);
+		log.error("error in ANativeWindow_setFrameRate() with window:{} rate:{:g} compatibility:{}", (void*)nWin, rate, compatibility);
 	}
 }
 
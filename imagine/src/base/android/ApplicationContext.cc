@@ -342,6 +342,36 @@ void ApplicationContext::setSustainedPerformanceMode(bool on)
 	jSetSustainedPerformanceMode(env, baseActivity, on);
 }
 
+GameMode ApplicationContext::gameMode() const
+{
+	if(androidSDK() < 31)
+		return GameMode::unsupported;
+	auto env = thisThreadJniEnv();
+	auto baseActivity = baseActivityObject();
+	JNI::InstMethod<jint()> jGameMode{env, baseActivity, "gameMode", "()I"};
+	return GameMode(jGameMode(env, baseActivity));
+}
+
+int64_t ApplicationContext::batteryPowerMicrowatts() const
+{
+	if(androidSDK() < 21)
+		return 0;
+	auto env = thisThreadJniEnv();
+	auto baseActivity = baseActivityObject();
+	JNI::InstMethod<jlong()> jBatteryPowerMicrowatts{env, baseActivity, "batteryPowerMicrowatts", "()J"};
+	return jBatteryPowerMicrowatts(env, baseActivity);
+}
+
+void ApplicationContext::setGameState(bool isLoading, bool inGameplay)
+{
+	if(androidSDK() < 33)
+		return;
+	auto env = mainThreadJniEnv();
+	auto baseActivity = baseActivityObject();
+	JNI::InstMethod<void(jboolean, jboolean)> jSetGameState{env, baseActivity, "setGameState", "(ZZ)V"};
+	jSetGameState(env, baseActivity, isLoading, inGameplay);
+}
+
 void AndroidApplicationContext::setNoopThreadActive(bool on)
 {
 	auto &ctx = *static_cast<ApplicationContext*>(this);
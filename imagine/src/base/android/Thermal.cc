@@ -0,0 +1,73 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "Thermal"
+#include <imagine/base/ApplicationContext.hh>
+#include <imagine/base/sharedLibrary.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <limits>
+
+struct AThermalManager;
+
+namespace IG
+{
+
+static int (*AThermal_getCurrentThermalStatus)(AThermalManager*);
+static float (*AThermal_getThermalHeadroom)(AThermalManager*, int forecastSeconds);
+
+// the manager is kept for the lifetime of the process
+static AThermalManager *thermalManager(int androidSDK)
+{
+	static AThermalManager *mgrPtr = [&]() -> AThermalManager*
+	{
+		if(androidSDK < 30)
+			return nullptr;
+		AThermalManager* (*AThermal_acquireManager)(){};
+		loadSymbol(AThermal_acquireManager, {}, "AThermal_acquireManager");
+		loadSymbol(AThermal_getCurrentThermalStatus, {}, "AThermal_getCurrentThermalStatus");
+		if(androidSDK >= 31)
+			loadSymbol(AThermal_getThermalHeadroom, {}, "AThermal_getThermalHeadroom");
+		if(!AThermal_acquireManager || !AThermal_getCurrentThermalStatus)
+		{
+			logErr("missing thermal functions");
+			return nullptr;
+		}
+		return AThermal_acquireManager();
+	}();
+	return mgrPtr;
+}
+
+ThermalStatus ApplicationContext::thermalStatus() const
+{
+	auto mgrPtr = thermalManager(androidSDK());
+	if(!mgrPtr)
+		return ThermalStatus::none;
+	auto status = AThermal_getCurrentThermalStatus(mgrPtr);
+	if(status < 0) // ATHERMAL_STATUS_ERROR
+		return ThermalStatus::none;
+	return ThermalStatus(std::min(status, int(ThermalStatus::shutdown)));
+}
+
+float ApplicationContext::thermalHeadroom(Seconds forecast) const
+{
+	auto mgrPtr = thermalManager(androidSDK());
+	if(!mgrPtr || !AThermal_getThermalHeadroom)
+		return std::numeric_limits<float>::quiet_NaN();
+	// returns NaN if called more often than once per second
+	return AThermal_getThermalHeadroom(mgrPtr, forecast.count());
+}
+
+}
@@ -20,6 +20,7 @@ base/android/input.cc \
 base/android/moga.cc \
 base/android/PerformanceHintManager.cc \
 base/android/Sensor.cc \
+base/android/Thermal.cc \
 base/android/surfaceTexture.cc \
 base/android/RootCpufreqParamSetter.cc \
 base/android/VibrationManager.cc \
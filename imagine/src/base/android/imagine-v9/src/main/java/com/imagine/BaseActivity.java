@@ -18,13 +18,17 @@ package com.imagine;
 import android.widget.TextView;
 import android.widget.PopupWindow;
 import android.app.NativeActivity;
+import android.app.GameManager;
+import android.app.GameState;
 import android.content.Intent;
+import android.content.IntentFilter;
 import android.content.Context;
 import android.graphics.drawable.Icon;
 import android.os.Vibrator;
 import android.os.Bundle;
 import android.os.Environment;
 import android.os.Build;
+import android.os.BatteryManager;
 import android.os.ParcelFileDescriptor;
 import android.os.PowerManager;
 import android.view.View;
@@ -507,6 +511,40 @@ public final class BaseActivity extends NativeActivity implements AudioManager.O
 			getWindow().setSustainedPerformanceMode(on);
 		}
 	}
+
+	int gameMode()
+	{
+		if(Build.VERSION.SDK_INT >= 31)
+		{
+			return ((GameManager)getSystemService(Context.GAME_SERVICE)).getGameMode();
+		}
+		return 0;
+	}
+
+	long batteryPowerMicrowatts()
+	{
+		if(Build.VERSION.SDK_INT < 21)
+			return 0;
+		long microAmps = ((BatteryManager)getSystemService(Context.BATTERY_SERVICE))
+			.getLongProperty(BatteryManager.BATTERY_PROPERTY_CURRENT_NOW);
+		if(microAmps == Long.MIN_VALUE || microAmps == 0)
+			return 0;
+		Intent status = registerReceiver(null, new IntentFilter(Intent.ACTION_BATTERY_CHANGED));
+		if(status == null || status.getIntExtra(BatteryManager.EXTRA_PLUGGED, 0) != 0)
+			return 0;
+		long milliVolts = status.getIntExtra(BatteryManager.EXTRA_VOLTAGE, 0);
+		// the sign of the current for discharge varies by device
+		return Math.abs(microAmps) * milliVolts / 1000;
+	}
+
+	void setGameState(boolean isLoading, boolean inGameplay)
+	{
+		if(Build.VERSION.SDK_INT >= 33)
+		{
+			((GameManager)getSystemService(Context.GAME_SERVICE)).setGameState(
+				new GameState(isLoading, inGameplay ? GameState.MODE_GAMEPLAY_INTERRUPTIBLE : GameState.MODE_NONE));
+		}
+	}
 	
 	Bitmap makeBitmap(int width, int height, int format)
 	{
@@ -273,6 +273,20 @@ bool AndroidApplication::processInputEvent(AInputEvent* event, Input::Device *de
 					auto &axes = getAs<AndroidInputDevice>(*devPtr).jsAxes();
 					if(hasGetAxisValue())
 					{
+						#if ANDROID_MIN_API > 9
+						// replay samples batched since the last event so a hat or trigger pressed
+						// and released within one batch still registers, touch and mouse events
+						// only need their latest position so their history is skipped
+						for(auto h : iotaCount(AMotionEvent_getHistorySize(event)))
+						{
+							auto histTime = SteadyClockTimePoint{Nanoseconds{AMotionEvent_getHistoricalEventTime(event, h)}};
+							for(auto &axis : axes)
+							{
+								auto pos = AMotionEvent_getHistoricalAxisValue(event, (int32_t)axis.id(), 0, h);
+								axis.dispatchInputEvent(pos, Input::Map::SYSTEM, histTime, *devPtr, win);
+							}
+						}
+						#endif
 						for(auto &axis : axes)
 						{
 							auto pos = AMotionEvent_getAxisValue(event, (int32_t)axis.id(), 0);
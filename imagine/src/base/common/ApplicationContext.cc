@@ -35,7 +35,9 @@
 #include <imagine/util/memory/UniqueFileStream.hh>
 #include <imagine/util/bit.hh>
 #include <imagine/logger/logger.h>
+#include <cstdlib>
 #include <cstring>
+#include <limits>
 
 namespace IG
 {
@@ -418,34 +420,95 @@ void ApplicationContext::setSwappedConfirmKeys(std::optional<bool> opt)
 	#endif
 }
 
+[[gnu::weak]] int ApplicationContext::cpuCapacity(int cpuIdx) const
+{
+	#ifdef __linux__
+	auto capacityFile = UniqueFileStream{fopen(std::format("/sys/devices/system/cpu/cpu{}/cpu_capacity", cpuIdx).c_str(), "r")};
+	if(!capacityFile)
+		return 0;
+	int capacity{};
+	auto items = fscanf(capacityFile.get(), "%d", &capacity);
+	return capacity;
+	#else
+	return 0;
+	#endif
+}
+
+[[gnu::weak]] int64_t ApplicationContext::batteryPowerMicrowatts() const
+{
+	#ifdef __linux__
+	auto readValue = [](const char *battery, const char *name) -> int64_t
+	{
+		auto file = UniqueFileStream{fopen(std::format("/sys/class/power_supply/{}/{}", battery, name).c_str(), "r")};
+		if(!file)
+			return 0;
+		long long val{};
+		if(fscanf(file.get(), "%lld", &val) != 1)
+			return 0;
+		return std::abs(val); // some drivers report discharge as negative
+	};
+	for(auto battery : {"BAT0", "BAT1", "battery"})
+	{
+		auto statusFile = UniqueFileStream{fopen(std::format("/sys/class/power_supply/{}/status", battery).c_str(), "r")};
+		char status[16]{};
+		if(!statusFile || !fgets(status, sizeof(status), statusFile.get()) || !std::string_view{status}.starts_with("Discharging"))
+			continue;
+		if(auto power = readValue(battery, "power_now"))
+			return power;
+		auto current = readValue(battery, "current_now");
+		auto voltage = readValue(battery, "voltage_now");
+		if(current && voltage)
+			return current * voltage / 1'000'000;
+	}
+	#endif
+	return 0;
+}
+
 [[gnu::weak]] CPUMask ApplicationContext::performanceCPUMask() const
 {
 	auto cpus = cpuCount();
 	if(cpus <= 2) // use all cores when count is small
 		return 0;
-	struct CPUFreqInfo{int freq, cpuIdx;};
-	StaticArrayList<CPUFreqInfo, maxCPUs> cpuFreqInfos;
+	struct CPUPerfInfo{int perf, cpuIdx;};
+	StaticArrayList<CPUPerfInfo, maxCPUs> cpuPerfInfos;
+	// capacity accounts for micro-architecture differences between core types, unlike max frequency
+	bool useCapacity = cpuCapacity(0) > 0;
 	for(int i : iotaCount(cpus))
 	{
-		auto freq = maxCPUFrequencyKHz(i);
-		if(freq > 0)
-			cpuFreqInfos.emplace_back(CPUFreqInfo{freq, i});
+		auto perf = useCapacity ? cpuCapacity(i) : maxCPUFrequencyKHz(i);
+		if(perf > 0)
+			cpuPerfInfos.emplace_back(CPUPerfInfo{perf, i});
 	}
-	auto [min, max] = std::ranges::minmax_element(cpuFreqInfos, {}, &CPUFreqInfo::freq);
-	if(min->freq == max->freq) // not heterogeneous
+	if(cpuPerfInfos.empty())
+		return 0;
+	auto [min, max] = std::ranges::minmax_element(cpuPerfInfos, {}, &CPUPerfInfo::perf);
+	if(min->perf == max->perf) // not heterogeneous
 		return 0;
-	log.debug("Detected heterogeneous CPUs with min:{} max:{} frequencies", min->freq, max->freq);
+	log.debug("Detected heterogeneous CPUs with min:{} max:{} {}", min->perf, max->perf,
+		useCapacity ? "capacities" : "frequencies");
 	CPUMask mask{};
-	for(auto info : cpuFreqInfos)
+	for(auto info : cpuPerfInfos)
 	{
-		if(info.freq != min->freq)
+		if(info.perf != min->perf)
 			mask |= bit(info.cpuIdx);
 	}
 	return mask;
 }
 
+[[gnu::weak]] CPUMask ApplicationContext::efficiencyCPUMask() const
+{
+	auto perfMask = performanceCPUMask();
+	if(!perfMask)
+		return 0;
+	return ~perfMask & bits<CPUMask>(cpuCount());
+}
+
 [[gnu::weak]] PerformanceHintManager ApplicationContext::performanceHintManager() { return {}; }
 
+[[gnu::weak]] ThermalStatus ApplicationContext::thermalStatus() const { return ThermalStatus::none; }
+
+[[gnu::weak]] float ApplicationContext::thermalHeadroom(Seconds) const { return std::numeric_limits<float>::quiet_NaN(); }
+
 [[gnu::weak]] bool ApplicationContext::packageIsInstalled(CStringView name) const { return false; }
 
 [[gnu::weak]] int32_t ApplicationContext::androidSDK() const
@@ -455,6 +518,8 @@ void ApplicationContext::setSwappedConfirmKeys(std::optional<bool> opt)
 
 [[gnu::weak]] bool ApplicationContext::hasSustainedPerformanceMode() const { return false; }
 [[gnu::weak]] void ApplicationContext::setSustainedPerformanceMode(bool on) {}
+[[gnu::weak]] GameMode ApplicationContext::gameMode() const { return GameMode::unsupported; }
+[[gnu::weak]] void ApplicationContext::setGameState(bool isLoading, bool inGameplay) {}
 
 [[gnu::weak]] std::string ApplicationContext::formatDateAndTime(WallClockTimePoint time)
 {
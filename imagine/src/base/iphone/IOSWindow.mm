@@ -271,7 +271,7 @@ IG::PixelFormat Window::pixelFormat() const
 	return PixelFmtRGBA8888;
 }
 
-void Window::setIntendedFrameRate(FrameRate rate) {}
+void Window::setIntendedFrameRate(FrameRate rate, bool fixedSource) {}
 
 void WindowConfig::setFormat(IG::PixelFormat) {}
 
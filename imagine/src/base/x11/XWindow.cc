@@ -252,7 +252,7 @@ NativeWindow Window::nativeObject() const
 	return xWin;
 }
 
-void Window::setIntendedFrameRate(FrameRate rate)
+void Window::setIntendedFrameRate(FrameRate rate, bool)
 {
 	screen()->setFrameRate(rate);
 }
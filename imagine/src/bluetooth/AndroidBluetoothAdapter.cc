@@ -44,6 +44,13 @@ struct asocket
 
 static JNI::InstMethod<jint(jobject)> jStartScan;
 static JNI::InstMethod<jint(jbyteArray, jint, jint)> jInRead;
+
+// precedes each report sent from the read thread, time is taken when the read returns
+struct DataPipeHeader
+{
+	SteadyClockTimePoint time;
+	uint16_t size;
+};
 static JNI::InstMethod<jint()> jGetFd;
 static JNI::InstMethod<jint(jobject)> jState;
 static JNI::InstMethod<jobject(jlong)> jDefaultAdapter;
@@ -390,7 +397,7 @@ bool AndroidBluetoothSocket::readPendingData(int events)
 				return false;
 			}
 			//logMsg("read %d bytes from socket %d", len, nativeFd);
-			if(!sock.onData(buff, len))
+			if(!sock.onData(buff, len, SteadyClock::now()))
 				break; // socket was closed
 		}
 	}
@@ -446,13 +453,14 @@ void AndroidBluetoothSocket::onStatusDelegateMessage(BluetoothAdapter& bta, Blue
 								auto &socket = *((BluetoothSocket*)data);
 								while(fd_bytesReadable(fd))
 								{
-									uint16_t size;
-									int ret = read(fd, &size, sizeof(size));
-									if(ret != sizeof(size))
+									DataPipeHeader header;
+									int ret = read(fd, &header, sizeof(header));
+									if(ret != sizeof(header))
 									{
 										logErr("error reading BT socket data header in pipe, returned %d", ret);
 										return 1;
 									}
+									auto size = header.size;
 									char data[size];
 									ret = read(fd, data, size);
 									if(ret != size)
@@ -460,7 +468,7 @@ void AndroidBluetoothSocket::onStatusDelegateMessage(BluetoothAdapter& bta, Blue
 										logErr("error reading BT socket data header in pipe, returned %d", ret);
 										return 1;
 									}
-									socket.onData(&data[0], size);
+									socket.onData(&data[0], size, header.time);
 								}
 								return 1;
 							}, this);
@@ -479,6 +487,7 @@ void AndroidBluetoothSocket::onStatusDelegateMessage(BluetoothAdapter& bta, Blue
 					for(;;)
 					{
 						int16_t len = jInRead(env, jInput, jData, 0, 48);
+						auto time = SteadyClock::now();
 						//logMsg("read %d bytes", (int)len);
 						if(len <= 0 || env->ExceptionCheck()) [[unlikely]]
 						{
@@ -491,7 +500,8 @@ void AndroidBluetoothSocket::onStatusDelegateMessage(BluetoothAdapter& bta, Blue
 								bta.sendSocketStatusMessage({sock, BluetoothSocketState::ReadError});
 							break;
 						}
-						if(::write(dataPipe[1], &len, sizeof(len)) != sizeof(len))
+						DataPipeHeader header{time, uint16_t(len)};
+						if(::write(dataPipe[1], &header, sizeof(header)) != sizeof(header))
 						{
 							logErr("unable to write message header to pipe: %s", strerror(errno));
 						}
@@ -26,7 +26,9 @@
 #include <imagine/util/fd-utils.h>
 #include <imagine/util/ranges.hh>
 #include <imagine/util/algorithm.h>
+#include <sys/socket.h>
 #include <cerrno>
+#include <cstring>
 
 #ifdef __ANDROID__
 // Bluez dlsym functions
@@ -359,6 +361,25 @@ std::system_error BluetoothSocket::open(BluetoothAdapter&, BluetoothPendingSocke
 	return std::error_code{};
 }
 
+// converts the socket's wall clock receive timestamp to the steady clock used by input events
+static SteadyClockTimePoint arrivalTime(msghdr &msg)
+{
+	auto now = SteadyClock::now();
+	for(auto cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+	{
+		if(cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_TIMESTAMPNS)
+			continue;
+		timespec ts;
+		memcpy(&ts, CMSG_DATA(cmsg), sizeof ts);
+		auto age = WallClock::now().time_since_epoch() - duration_cast<WallClockTime>(Seconds{ts.tv_sec} + Nanoseconds{ts.tv_nsec});
+		// ignore stamps thrown off by a wall clock change
+		if(age < WallClockTime{} || age > Seconds{1})
+			break;
+		return now - duration_cast<SteadyClockTime>(age);
+	}
+	return now;
+}
+
 bool BluezBluetoothSocket::readPendingData(int events)
 {
 	auto &sock = static_cast<BluetoothSocket&>(*this);
@@ -387,11 +408,13 @@ bool BluezBluetoothSocket::readPendingData(int events)
 	else if(events & POLLEV_IN)
 	{
 		char buff[50];
+		alignas(cmsghdr) char ctrlBuff[CMSG_SPACE(sizeof(timespec))];
 		//logMsg("at least %d bytes ready on socket %d", fd_bytesReadable(fd), fd);
 		while(fd_bytesReadable(fd))
 		{
-			//auto len = read(fd, buff, IG::min((size_t)bytesToRead, sizeof buff));
-			auto len = read(fd, buff, sizeof buff);
+			iovec iov{buff, sizeof buff};
+			msghdr msg{.msg_iov = &iov, .msg_iovlen = 1, .msg_control = ctrlBuff, .msg_controllen = sizeof ctrlBuff};
+			auto len = recvmsg(fd, &msg, 0);
 			if(len <= 0) [[unlikely]]
 			{
 				logMsg("error %d reading packet from socket %d", len == -1 ? errno : 0, fd);
@@ -399,7 +422,7 @@ bool BluezBluetoothSocket::readPendingData(int events)
 				return false;
 			}
 			//logMsg("read %d bytes from socket %d", len, fd);
-			if(!sock.onData(buff, len))
+			if(!sock.onData(buff, len, arrivalTime(msg)))
 				break; // socket was closed
 		}
 	}
@@ -417,6 +440,10 @@ bool BluezBluetoothSocket::readPendingData(int events)
 
 void BluezBluetoothSocket::setupFDEvents(int events)
 {
+	// have the kernel stamp each report on arrival so a busy main thread doesn't skew input timing
+	int on = 1;
+	if(setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof on) == -1)
+		logWarn("error %d enabling timestamps on socket %d", errno, fd);
 	fdSrc = {fd, {},
 		[this](int fd, int events)
 		{
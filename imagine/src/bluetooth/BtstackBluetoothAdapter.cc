@@ -258,7 +258,7 @@ void BtstackBluetoothAdapter::packetHandler(uint8_t packet_type, uint16_t channe
 				logErr("can't find socket");
 				return;
 			}
-			sock->onData((char*)packet, size);
+			sock->onData((char*)packet, size, SteadyClock::now());
 			//debugPrintL2CAPPacket(channel, packet, size);
 			break;
 		}
@@ -119,9 +119,9 @@ bool IControlPad::open(BluetoothAdapter &adapter, Input::Device &dev)
 {
 	logMsg("connecting to iCP");
 	sock.onData =
-		[&dev](const char *packet, size_t size)
+		[&dev](const char *packet, size_t size, SteadyClockTimePoint time)
 		{
-			return getAs<IControlPad>(dev).dataHandler(dev, packet, size);
+			return getAs<IControlPad>(dev).dataHandler(dev, packet, size, time);
 		};
 	sock.onStatus =
 		[&dev](BluetoothSocket &sock, BluetoothSocketState status)
@@ -165,7 +165,7 @@ uint32_t IControlPad::statusHandler(Input::Device &dev, BluetoothSocket &sock, B
 	return 0;
 }
 
-bool IControlPad::dataHandler(Input::Device &dev, const char *packetPtr, size_t size)
+bool IControlPad::dataHandler(Input::Device &dev, const char *packetPtr, size_t size, SteadyClockTimePoint time)
 {
 	auto packet = (const uint8_t*)packetPtr;
 	uint32_t bytesLeft = size;
@@ -202,7 +202,6 @@ bool IControlPad::dataHandler(Input::Device &dev, const char *packetPtr, size_t
 			// check if inputBuffer is complete
 			if(inputBufferPos == 6)
 			{
-				auto time = SteadyClock::now();
 				for(auto i : iotaCount(4))
 				{
 					if(axis[i].dispatchInputEvent(inputBuffer[i], Input::Map::ICONTROLPAD, time, dev, ctx.mainWindow()))
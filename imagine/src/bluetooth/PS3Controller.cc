@@ -129,9 +129,9 @@ bool PS3Controller::open(BluetoothAdapter &adapter, Input::Device &dev)
 bool PS3Controller::open1Ctl(BluetoothAdapter &adapter, BluetoothPendingSocket &pending, Input::Device &dev)
 {
 	ctlSock.onData = intSock.onData =
-		[&dev](const char *packet, size_t size)
+		[&dev](const char *packet, size_t size, SteadyClockTimePoint time)
 		{
-			return getAs<PS3Controller>(dev).dataHandler(dev, packet, size);
+			return getAs<PS3Controller>(dev).dataHandler(dev, packet, size, time);
 		};
 	ctlSock.onStatus = intSock.onStatus =
 		[&dev](BluetoothSocket &sock, BluetoothSocketState status)
@@ -193,7 +193,7 @@ void PS3Controller::close()
 	ctlSock.close();
 }
 
-bool PS3Controller::dataHandler(Input::Device &dev, const char *packetPtr, size_t size)
+bool PS3Controller::dataHandler(Input::Device &dev, const char *packetPtr, size_t size, SteadyClockTimePoint time)
 {
 	auto packet = (const uint8_t*)packetPtr;
 	/*logMsg("data with size %d", (int)size);
@@ -213,7 +213,6 @@ bool PS3Controller::dataHandler(Input::Device &dev, const char *packetPtr, size_
 	{
 		case 0xA1:
 		{
-			auto time = SteadyClock::now();
 			const uint8_t *digitalBtnData = &packet[3];
 			for(auto &e : padDataAccess)
 			{
@@ -190,9 +190,9 @@ bool Wiimote::open(BluetoothAdapter& adapter, Input::Device& dev)
 	logMsg("opening Wiimote");
 	btaPtr = &adapter;
 	ctlSock.onData = intSock.onData =
-		[&dev](const char *packet, size_t size)
+		[&dev](const char *packet, size_t size, SteadyClockTimePoint time)
 		{
-			return getAs<Wiimote>(dev).dataHandler(dev, packet, size);
+			return getAs<Wiimote>(dev).dataHandler(dev, packet, size, time);
 		};
 	ctlSock.onStatus = intSock.onStatus =
 		[&dev](BluetoothSocket &sock, BluetoothSocketState status)
@@ -302,7 +302,7 @@ void Wiimote::sendDataModeByExtension()
 	}
 }
 
-bool Wiimote::dataHandler(Input::Device &dev, const char *packetPtr, size_t size)
+bool Wiimote::dataHandler(Input::Device &dev, const char *packetPtr, size_t size, SteadyClockTimePoint time)
 {
 	using namespace IG::Input;
 	auto packet = (const uint8_t*)packetPtr;
@@ -311,7 +311,6 @@ bool Wiimote::dataHandler(Input::Device &dev, const char *packetPtr, size_t size
 		logWarn("Unknown report in Wiimote packet");
 		return 1;
 	}
-	auto time = SteadyClock::now();
 	switch(packet[1])
 	{
 		case 0x30:
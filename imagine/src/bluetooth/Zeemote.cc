@@ -65,9 +65,9 @@ bool Zeemote::open(BluetoothAdapter& adapter, Input::Device& dev)
 {
 	logMsg("connecting to Zeemote");
 	sock.onData =
-		[&dev](const char *packet, size_t size)
+		[&dev](const char *packet, size_t size, SteadyClockTimePoint time)
 		{
-			return getAs<Zeemote>(dev).dataHandler(dev, packet, size);
+			return getAs<Zeemote>(dev).dataHandler(dev, packet, size, time);
 		};
 	sock.onStatus =
 		[&dev](BluetoothSocket &sock, BluetoothSocketState status)
@@ -112,7 +112,7 @@ uint32_t Zeemote::statusHandler(Input::Device &dev, BluetoothSocket &sock, Bluet
 	return 0;
 }
 
-bool Zeemote::dataHandler(Input::Device &dev, const char *packet, size_t size)
+bool Zeemote::dataHandler(Input::Device &dev, const char *packet, size_t size, SteadyClockTimePoint time)
 {
 	//logMsg("%d bytes ready", size);
 	uint32_t bytesLeft = size;
@@ -140,7 +140,6 @@ bool Zeemote::dataHandler(Input::Device &dev, const char *packet, size_t size)
 		// check if inputBuffer is complete
 		if(inputBufferPos == packetSize)
 		{
-			auto time = SteadyClock::now();
 			uint32_t rID = inputBuffer[2];
 			logMsg("report id 0x%X, %s", rID, reportIDToStr(rID));
 			switch(rID)
@@ -46,10 +46,13 @@ void Text::makeGlyphs()
 {
 	if(!hasText()) [[unlikely]]
 		return;
-	for(auto c : textStr)
+	for(auto c : stringView())
 	{
 		face_->glyphEntry(renderer(), c);
 	}
+	// texture coordinates of compiled quads are invalid if the atlas was rebuilt
+	if(faceGeneration != face_->generation())
+		compile(layoutConfig);
 }
 
 auto writeSpan(Renderer &r, auto quadsIt, WPt pos, std::u16string_view strView, GlyphTextureSet *face_, int spaceSize)
@@ -72,7 +75,7 @@ auto writeSpan(Renderer &r, auto quadsIt, WPt pos, std::u16string_view strView,
 		pos.x += metrics.xAdvance;
 		ITexQuad quad
 		{
-			{.bounds = {drawPos, (drawPos + metrics.size)}, .textureBounds = ITexQuad::unitTexCoordRect()}
+			{.bounds = {drawPos, (drawPos + metrics.size)}, .textureSpan = glyph}
 		};
 		quadsIt = std::ranges::copy(quad.v, quadsIt).out;
 	}
@@ -89,6 +92,8 @@ bool Text::compile(TextLayoutConfig conf)
 	}
 	assert(quads.hasTask());
 	auto &r = renderer();
+	layoutConfig = conf;
+	faceGeneration = face_->generation();
 	if(sizeBeforeLineSpans)
 	{
 		textStr.resize(stringSize());
@@ -205,10 +210,30 @@ bool Text::compile(TextLayoutConfig conf)
 	return true;
 }
 
-static int drawSpan(RendererCommands &cmds, std::u16string_view strView, int spriteOffset, GlyphTextureSet *face_)
+static void drawGlyphs(RendererCommands &cmds, std::u16string_view strView, GlyphTextureSet *face_)
 {
 	auto &renderer = cmds.renderer();
 	auto &basicEffect = cmds.basicEffect();
+	// quads beyond the shared index buffer's range are drawn individually as strips
+	const int indexedQuads = rendererQuadIndices(renderer.mainTask).size() / 6;
+	const Texture *runTexture{};
+	int runStart{}, runSize{};
+	auto drawRun = [&]
+	{
+		if(!runSize)
+			return;
+		basicEffect.enableTexture(cmds, *runTexture);
+		if(runStart + runSize <= indexedQuads)
+		{
+			cmds.drawQuads(runStart, runSize);
+		}
+		else
+		{
+			for(auto i : iotaCount(runSize))
+				cmds.drawQuad(runStart + i);
+		}
+	};
+	int spriteOffset = 0;
 	for(auto c : strView)
 	{
 		if(c == '\n')
@@ -221,10 +246,18 @@ static int drawSpan(RendererCommands &cmds, std::u16string_view strView, int spr
 			//log.info("no glyph for {:X}", c);
 			continue;
 		}
-		auto &[glyph, metrics] = *gly;
-		basicEffect.drawSprite(cmds, spriteOffset++, glyph);
+		auto pageTexture = gly->glyph.texturePtr;
+		if(pageTexture != runTexture)
+		{
+			drawRun();
+			runTexture = pageTexture;
+			runStart = spriteOffset;
+			runSize = 0;
+		}
+		runSize++;
+		spriteOffset++;
 	}
-	return spriteOffset;
+	drawRun();
 }
 
 void Text::draw(RendererCommands &cmds, WPt pos, _2DOrigin o, Color c) const
@@ -246,25 +279,8 @@ void Text::draw(RendererCommands &cmds, WPt pos, _2DOrigin o) const
 	//log.info("drawing text @ {},{}, size:{},{}", xPos, yPos, xSize, ySize);
 	cmds.basicEffect().setModelView(cmds, Mat4::makeTranslate({pos.x, pos.y, 0}));
 	cmds.setVertexArray(quads);
-	auto lines = currentLines();
-	if(lines > 1)
-	{
-		auto s = textStr.data();
-		auto spansPtr = &textStr[sizeBeforeLineSpans];
-		int spriteOffset = 0;
-		for(auto i : iotaCount(lines))
-		{
-			auto [xLineSize, charsToDraw] = LineSpan::decode({spansPtr, LineSpan::encodedChar16Size});
-			spansPtr += LineSpan::encodedChar16Size;
-			//log.info("line:{} chars:{}", i, charsToDraw);
-			spriteOffset = drawSpan(cmds, std::u16string_view{s, charsToDraw}, spriteOffset, face_);
-			s += charsToDraw;
-		}
-	}
-	else
-	{
-		drawSpan(cmds, std::u16string_view{textStr}, 0, face_);
-	}
+	// glyphs of all lines are stored in order, so the line spans aren't needed to draw
+	drawGlyphs(cmds, stringView(), face_);
 }
 
 uint16_t Text::currentLines() const
@@ -20,6 +20,8 @@
 #include <imagine/gfx/GlyphTextureSet.hh>
 #include <imagine/data-type/image/PixmapSource.hh>
 #include <imagine/logger/logger.h>
+#include <algorithm>
+#include <bit>
 #include <cstdlib>
 
 namespace IG::Gfx
@@ -55,37 +57,18 @@ void GlyphTextureSet::resetGlyphTable()
 	logMsg("resetting glyph table");
 	usedGlyphTableBits = 0;
 	glyphTable.resetElements();
+	atlasPages.clear();
+	atlasPos = {};
+	atlasRowHeight = 0;
+	atlasPageSize = 0;
+	generation_++;
 }
 
 void GlyphTextureSet::freeCaches(uint32_t purgeBits)
 {
-	if(purgeBits == ~0u)
-	{
-		// free the whole table
+	// glyphs from all ranges share the atlas pages, so purging any range frees the whole table
+	if(usedGlyphTableBits & purgeBits)
 		resetGlyphTable();
-		return;
-	}
-	auto tableBits = usedGlyphTableBits;
-	for(auto i : iotaCount(32))
-	{
-		if((tableBits & 1) && (purgeBits & 1))
-		{
-			logMsg("purging glyphs from table range %d/31", i);
-			int firstChar = i << 11;
-			for(auto c : std::views::iota(firstChar, 2048))
-			{
-				if(mapCharToTable(c) == -1)
-				{
-					//logMsg( "%c not a known drawable character, skipping", c);
-					continue;
-				}
-				glyphTable[i].~GlyphEntry();
-			}
-			usedGlyphTableBits = IG::clearBits(usedGlyphTableBits, IG::bit(i));
-		}
-		tableBits >>= 1;
-		purgeBits >>= 1;
-	}
 }
 
 GlyphTextureSet::GlyphTextureSet(Renderer &r, IG::Font font, IG::FontSettings set):
@@ -157,12 +140,55 @@ bool GlyphTextureSet::cacheChar(Renderer &r, int c, int tableIdx)
 	}
 	//logMsg("setting up table entry %d", tableIdx);
 	metrics = res.metrics;
-	glyph = r.makeTexture(res.image, glyphSamplerConfig, false);
+	glyph = addToAtlas(r, res.image.pixmap());
+	if(!glyph)
+	{
+		metrics.size.y = -1;
+		return false;
+	}
 	usedGlyphTableBits |= IG::bit((c >> 11) & 0x1F); // use upper 5 BMP plane bits to map in range 0-31
 	//logMsg("used table bits 0x%X", usedGlyphTableBits);
 	return true;
 }
 
+TextureSpan GlyphTextureSet::addToAtlas(Renderer &r, PixmapView pix)
+{
+	constexpr int padding = 1; // keeps filtering at glyph edges from sampling neighbors
+	if(!atlasPageSize)
+	{
+		// room for at least a few hundred glyphs of the current size per page
+		atlasPageSize = std::clamp(int(std::bit_ceil(unsigned(settings.pixelHeight()) * 16)), 256, 2048);
+	}
+	auto size = pix.size();
+	if(size.x + padding > atlasPageSize || size.y + padding > atlasPageSize) [[unlikely]]
+	{
+		logErr("glyph size %dx%d larger than atlas page", size.x, size.y);
+		return {};
+	}
+	if(atlasPages.size() && atlasPos.x + size.x + padding > atlasPageSize)
+	{
+		atlasPos = {padding, atlasPos.y + atlasRowHeight + padding};
+		atlasRowHeight = 0;
+	}
+	if(atlasPages.empty() || atlasPos.y + size.y + padding > atlasPageSize)
+	{
+		logMsg("adding %dx%d glyph atlas page:%zu", atlasPageSize, atlasPageSize, atlasPages.size());
+		auto &newPage = atlasPages.emplace_back(r.makeTexture(TextureConfig{{{atlasPageSize, atlasPageSize}, PixelFmtA8}, glyphSamplerConfig}));
+		newPage.clear(0);
+		atlasPos = {padding, padding};
+		atlasRowHeight = 0;
+	}
+	auto &page = atlasPages.back();
+	if(size.x && size.y)
+		page.write(0, pix, atlasPos);
+	float pageSize = atlasPageSize;
+	FRect bounds{{atlasPos.x / pageSize, atlasPos.y / pageSize},
+		{(atlasPos.x + size.x) / pageSize, (atlasPos.y + size.y) / pageSize}};
+	atlasPos.x += size.x + padding;
+	atlasRowHeight = std::max(atlasRowHeight, size.y);
+	return {&page, bounds};
+}
+
 static int mapCharToTable(int c)
 {
 	//logMsg("mapping char 0x%X", c);
@@ -31,10 +31,7 @@ bool GLBasicEffect::setShaders(RendererTask &task, std::span<std::string_view> v
 		{"proj", &projUniform},
 		{"textureMode", &textureModeUniform},
 	};
-	Program newProg{task,
-		Shader{task, vertSrcs, ShaderType::VERTEX, Shader::CompileMode::COMPAT},
-		Shader{task, fragSrcs, ShaderType::FRAGMENT, Shader::CompileMode::COMPAT},
-		{.hasColor = true, .hasTexture = true}, uniformDescs};
+	Program newProg{task, vertSrcs, fragSrcs, {.hasColor = true, .hasTexture = true}, uniformDescs};
 	if(!newProg) [[unlikely]]
 		return false;
 	program = newProg.release();
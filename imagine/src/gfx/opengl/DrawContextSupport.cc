@@ -207,6 +207,11 @@ bool DrawContextSupport::hasVAOFuncs() const
 	#endif
 }
 
+bool DrawContextSupport::hasProgramBinary() const
+{
+	return glProgramBinary;
+}
+
 static const char *debugTypeToStr(GLenum type)
 {
 	switch(type)
@@ -0,0 +1,105 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/gfx/opengl/GLBufferFences.hh>
+#include <imagine/gfx/Renderer.hh>
+#include <imagine/gfx/RendererTask.hh>
+#include <imagine/gfx/SyncFence.hh>
+#include <imagine/util/ranges.hh>
+#include <imagine/logger/logger.h>
+
+namespace IG::Gfx
+{
+
+constexpr SystemLogger log{"GLBufferFences"};
+
+GLBufferFences::GLBufferFences(RendererTask &task):
+	task{task},
+	useFences{Config::GL_PLATFORM_EGL && task.renderer().support.hasSyncFences()} {}
+
+GLBufferFences::~GLBufferFences()
+{
+	reset();
+}
+
+void GLBufferFences::markSubmitted(int8_t idx)
+{
+	pending[idx].store(true, std::memory_order_relaxed);
+}
+
+void GLBufferFences::queueFence(int8_t idx)
+{
+	task.GLTask::run(
+		[&f = *this, idx](GLTask::TaskContext ctx)
+		{
+			if(f.useFences)
+			{
+				auto sync = f.task.renderer().support.fenceSync(ctx.glDisplay);
+				if(auto oldSync = f.fences[idx].exchange(sync, std::memory_order_relaxed)) [[unlikely]]
+					f.task.renderer().support.deleteSync(ctx.glDisplay, static_cast<GLsync>(oldSync));
+			}
+			f.pending[idx].store(false, std::memory_order_release);
+			f.pending[idx].notify_all();
+		});
+}
+
+bool GLBufferFences::acquire(int8_t idx)
+{
+	bool stalled{};
+	if(pending[idx].load(std::memory_order_acquire))
+	{
+		// render thread hasn't processed the buffer's commands yet
+		stalled = true;
+		pending[idx].wait(true, std::memory_order_acquire);
+	}
+	if(auto sync = static_cast<GLsync>(fences[idx].exchange(nullptr, std::memory_order_relaxed)))
+	{
+		auto &support = task.renderer().support;
+		auto dpy = task.renderer().glDisplay();
+		#ifdef CONFIG_BASE_GL_PLATFORM_EGL
+		if(support.clientWaitSync(dpy, sync, 0, 0) == EGL_TIMEOUT_EXPIRED_KHR)
+		{
+			stalled = true;
+			support.clientWaitSync(dpy, sync, 0, SyncFence::IGNORE_TIMEOUT.count());
+		}
+		#endif
+		support.deleteSync(dpy, sync);
+	}
+	if(stalled)
+	{
+		auto stalls = stallCount.fetch_add(1, std::memory_order_relaxed) + 1;
+		if(Config::DEBUG_BUILD)
+			log.debug("waited on buffer:{}, {} stalls total", idx, stalls);
+	}
+	return stalled;
+}
+
+void GLBufferFences::reset()
+{
+	task.awaitPending(); // tasks run in order, so none still refer to this object after
+	for(auto i : iotaCount(maxBuffers))
+	{
+		pending[i].store(false, std::memory_order_relaxed); // buffers are re-created or no longer used
+		deleteFence(i);
+	}
+}
+
+void GLBufferFences::deleteFence(int8_t idx)
+{
+	if(auto sync = fences[idx].exchange(nullptr, std::memory_order_relaxed))
+		task.renderer().support.deleteSync(task.renderer().glDisplay(), static_cast<GLsync>(sync));
+}
+
+}
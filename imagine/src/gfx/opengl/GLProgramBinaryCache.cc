@@ -0,0 +1,145 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/gfx/opengl/GLProgramBinaryCache.hh>
+#include <imagine/fs/FS.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/util/format.hh>
+#include <imagine/logger/logger.h>
+#include <cstring>
+
+namespace IG::Gfx
+{
+
+constexpr SystemLogger log{"GLProgramCache"};
+
+// bump when the compat shader preamble or entry layout changes
+constexpr uint32_t cacheVersion = 1;
+constexpr uint32_t entryMagic = 0x42504749; // "IGPB"
+
+struct EntryHeader
+{
+	uint32_t magic;
+	uint32_t format;
+	uint64_t key;
+};
+
+// 64-bit FNV-1a
+static uint64_t hashBytes(uint64_t hash, std::string_view bytes)
+{
+	for(auto c : bytes)
+	{
+		hash ^= uint8_t(c);
+		hash *= 0x100000001b3;
+	}
+	return hash;
+}
+
+void GLProgramBinaryCache::init(CStringView cachePath, std::string_view driverId)
+{
+	dirPath = {};
+	try
+	{
+		FS::create_directory(cachePath);
+		auto path = FS::createDirectorySegments(cachePath, "glProgramCache");
+		auto idPath = FS::pathString(path, "driver.txt");
+		auto fullId = std::format("{}\n{}", cacheVersion, driverId);
+		auto idBuff = FileUtils::bufferFromPath(idPath, {.test = true});
+		if(!idBuff || idBuff.stringView() != fullId)
+		{
+			log.info("renderer or driver changed, clearing program cache in:{}", path);
+			for(auto &entry : FS::directory_iterator{path})
+			{
+				FS::remove(entry.path());
+			}
+			if(FileUtils::writeToPath(idPath, std::span{reinterpret_cast<const unsigned char*>(fullId.data()), fullId.size()}) == -1)
+			{
+				log.error("error writing:{}", idPath);
+				return;
+			}
+		}
+		dirPath = path;
+		log.info("using program cache in:{}", dirPath);
+	}
+	catch(std::exception &err)
+	{
+		log.error("can't use program cache:{}", err.what());
+	}
+}
+
+uint64_t GLProgramBinaryCache::key(std::span<std::string_view> vShaderSrcs, std::span<std::string_view> fShaderSrcs,
+	uint32_t settings) const
+{
+	uint64_t hash = 0xcbf29ce484222325;
+	hash = hashBytes(hash, {reinterpret_cast<const char*>(&settings), sizeof(settings)});
+	// separate the vertex & fragment sources so moving text between them changes the key
+	for(auto srcs : {vShaderSrcs, fShaderSrcs})
+	{
+		for(auto s : srcs)
+		{
+			hash = hashBytes(hash, s);
+		}
+		hash = hashBytes(hash, {"\0", 1});
+	}
+	return hash;
+}
+
+FS::PathString GLProgramBinaryCache::entryPath(uint64_t key) const
+{
+	return FS::pathString(dirPath, std::format("{:016x}.bin", key));
+}
+
+GLProgramBinary GLProgramBinaryCache::load(uint64_t key) const
+{
+	if(!dirPath.size())
+		return {};
+	auto buff = FileUtils::bufferFromPath(entryPath(key), {.test = true});
+	if(buff.size() <= sizeof(EntryHeader))
+		return {};
+	EntryHeader header;
+	std::memcpy(&header, buff.data(), sizeof(header));
+	if(header.magic != entryMagic || header.key != key) [[unlikely]]
+	{
+		log.warn("ignoring invalid entry:{:016x}", key);
+		return {};
+	}
+	auto binaryData = buff.span().subspan(sizeof(header));
+	return {header.format, {binaryData.begin(), binaryData.end()}};
+}
+
+void GLProgramBinaryCache::store(uint64_t key, const GLProgramBinary &binary) const
+{
+	if(!dirPath.size() || !binary)
+		return;
+	EntryHeader header{entryMagic, binary.format, key};
+	std::vector<unsigned char> entry(sizeof(header) + binary.data.size());
+	std::memcpy(entry.data(), &header, sizeof(header));
+	std::memcpy(entry.data() + sizeof(header), binary.data.data(), binary.data.size());
+	if(FileUtils::writeToPath(entryPath(key), entry) == -1)
+	{
+		log.error("error writing entry:{:016x}", key);
+		return;
+	}
+	log.info("stored entry:{:016x} ({} bytes)", key, binary.data.size());
+}
+
+void GLProgramBinaryCache::remove(uint64_t key) const
+{
+	if(!dirPath.size())
+		return;
+	FS::remove(entryPath(key));
+}
+
+}
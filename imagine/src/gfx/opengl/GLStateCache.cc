@@ -27,6 +27,7 @@ void GLStateCache::blendFunc(GLenum sfactor, GLenum dfactor)
 		{
 			glBlendFunc(sfactor, dfactor);
 		}, "glBlendFunc()");
+		changes++;
 		blendFuncSfactor = sfactor;
 		blendFuncDfactor = dfactor;
 	}
@@ -40,6 +41,7 @@ void GLStateCache::blendEquation(GLenum mode)
 		{
 			glBlendEquation(mode);
 		}, "glBlendEquation()");
+		changes++;
 		blendEquationState = mode;
 	}
 }
@@ -79,6 +81,7 @@ void GLStateCache::enable(GLenum cap)
 			glEnable(cap);
 		}, "glEnable()");
 		*state = 1;
+		changes++;
 	}
 
 	if(verifyState)
@@ -115,6 +118,7 @@ void GLStateCache::disable(GLenum cap)
 			glDisable(cap);
 		}, "glDisable()");
 		*state = 0;
+		changes++;
 	}
 
 	if(verifyState)
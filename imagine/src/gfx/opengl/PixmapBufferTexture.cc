@@ -19,12 +19,14 @@
 #include <imagine/util/ScopeGuard.hh>
 #include <imagine/util/utility.h>
 #include <imagine/util/math.hh>
+#include <imagine/util/ranges.hh>
 #ifdef __ANDROID__
 #include <imagine/gfx/opengl/android/HardwareBufferStorage.hh>
 #include <imagine/gfx/opengl/android/SurfaceTextureStorage.hh>
 #endif
 #include <imagine/logger/logger.h>
 #include <cstdlib>
+#include <tuple>
 #include <algorithm>
 
 #ifndef GL_MAP_WRITE_BIT
@@ -229,10 +231,24 @@ bool PixmapBufferTexture::isExternal() const
 		visit([&](auto &t){ return t.target() == GL_TEXTURE_EXTERNAL_OES; }, directTex);
 }
 
+uint32_t PixmapBufferTexture::bufferStalls() const
+{
+	return visit([&](auto &t) -> uint32_t
+	{
+		if constexpr(requires {t.bufferStalls();})
+			return t.bufferStalls();
+		else
+			return 0;
+	}, directTex);
+}
+
 template<class Impl, class BufferInfo>
 bool GLTextureStorage<Impl, BufferInfo>::setFormat(PixmapDesc desc, ColorSpace colorSpace, TextureSamplerConfig samplerConf)
 {
-	static_cast<Impl*>(this)->initBuffer(desc, isSingleBuffered());
+	if(fences)
+		fences->reset();
+	bufferIdx = 0;
+	static_cast<Impl*>(this)->initBuffer(desc);
 	return Texture::setFormat(desc, 1, colorSpace, samplerConf);
 }
 
@@ -244,23 +260,33 @@ LockedTextureBuffer GLTextureStorage<Impl, BufferInfo>::lock(TextureBufferFlags
 		logErr("called lock when uninitialized");
 		return {};
 	}
+	if(fences)
+		fences->acquire(bufferIdx);
 	auto bufferInfo = currentBuffer();
 	IG::WindowRect fullRect{{}, size(0)};
 	MutablePixmapView pix{{fullRect.size(), pixmapDesc().format}, bufferInfo.data};
 	if(bufferFlags.clear)
 		pix.clear();
 	GLuint pbo{};
+	bool pboIsCoherent{};
 	if constexpr(requires {static_cast<Impl*>(this)->pbo();})
 	{
 		pbo = static_cast<Impl*>(this)->pbo();
+		pboIsCoherent = static_cast<Impl*>(this)->pboIsCoherent();
 	}
-	return {bufferInfo.dataStoreOffset(), pix, fullRect, 0, false, pbo};
+	return {bufferInfo.dataStoreOffset(), pix, fullRect, 0, false, pbo, pboIsCoherent};
 }
 
 template<class Impl, class BufferInfo>
 void GLTextureStorage<Impl, BufferInfo>::unlock(LockedTextureBuffer lockBuff, TextureWriteFlags writeFlags)
 {
+	if(!lockBuff.sourceDirtyRect().ySize()) // nothing to upload, the same buffer is returned by the next lock()
+		return;
+	if(fences)
+		fences->markSubmitted(bufferIdx);
 	Texture::unlock(lockBuff, writeFlags);
+	if(fences)
+		fences->queueFence(bufferIdx);
 	swapBuffer();
 }
 
@@ -286,71 +312,94 @@ void GLTextureStorage<Impl, BufferInfo>::writeAligned(PixmapView pixmap, int ass
 GLSystemMemoryStorage::GLSystemMemoryStorage(RendererTask &rTask, TextureConfig config, bool singleBuffer):
 	GLTextureStorage{rTask, config, singleBuffer}
 {
-	initBuffer(config.pixmapDesc, singleBuffer);
+	initBuffer(config.pixmapDesc);
 }
 
-void GLSystemMemoryStorage::initBuffer(PixmapDesc desc, bool singleBuffer)
+void GLSystemMemoryStorage::initBuffer(PixmapDesc desc)
 {
 	task().awaitPending();
 	auto bytes = desc.bytes();
-	auto fullBytes = singleBuffer ? bytes : bytes * 2;
-	storage = std::make_unique<char[]>(fullBytes);
-	logMsg("allocated system memory with buffers:%d size:%d data:%p", singleBuffer ? 1 : 2, bytes, storage.get());
-	info[0] = {storage.get()};
-	info[1] = {singleBuffer ? nullptr : storage.get() + bytes};
+	storage = std::make_unique<char[]>(bytes * bufferCount);
+	logMsg("allocated system memory with buffers:%d size:%d data:%p", bufferCount, bytes, storage.get());
+	for(auto i : iotaCount(GLBufferFences::maxBuffers))
+	{
+		info[i] = {i < bufferCount ? storage.get() + bytes * i : nullptr};
+	}
 }
 
 GLPixelBufferStorage::GLPixelBufferStorage(RendererTask &rTask, TextureConfig config, bool singleBuffer):
 	GLTextureStorage{rTask, config, singleBuffer},
 	pixelBuff{GLBufferDeleter{&rTask}}
 {
-	initBuffer(config.pixmapDesc, singleBuffer);
+	initBuffer(config.pixmapDesc);
 }
 
-void GLPixelBufferStorage::initBuffer(PixmapDesc desc, bool singleBuffer)
+void GLPixelBufferStorage::initBuffer(PixmapDesc desc)
 {
 	const auto bufferBytes = desc.bytes();
 	auto &r = renderer();
 	assert(hasPersistentBufferMapping(r));
 	char *bufferPtr{};
-	const auto fullBufferBytes = singleBuffer ? bufferBytes : bufferBytes * 2;
+	bool isCoherent{};
+	const auto fullBufferBytes = bufferBytes * bufferCount;
 	task().runSync(
-		[=, &r, &bufferPtr, &pbo = pixelBuff.get()](GLTask::TaskContext ctx)
+		[=, &r, &bufferPtr, &isCoherent, &pbo = pixelBuff.get()](GLTask::TaskContext ctx)
 		{
 			if(pbo)
 			{
 				glDeleteBuffers(1, &pbo);
 				pbo = 0;
 			}
-			GLuint newPbo;
-			glGenBuffers(1, &newPbo);
-			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, newPbo);
-			r.support.glBufferStorage(GL_PIXEL_UNPACK_BUFFER, fullBufferBytes, nullptr,
-				GL_DYNAMIC_STORAGE_BIT | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT);
-			bufferPtr = (char*)r.support.glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, fullBufferBytes,
-				GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_FLUSH_EXPLICIT_BIT);
-			if(!bufferPtr) [[unlikely]]
+			// Prefer a coherent mapping so writes need no per-frame flush, the buffer
+			// fences already keep the CPU from touching a slot the GPU is still reading
+			auto makeMappedBuffer = [&](GLbitfield extraFlags) -> std::pair<GLuint, char*>
+			{
+				GLuint newPbo;
+				glGenBuffers(1, &newPbo);
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, newPbo);
+				r.support.glBufferStorage(GL_PIXEL_UNPACK_BUFFER, fullBufferBytes, nullptr,
+					GL_DYNAMIC_STORAGE_BIT | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | (extraFlags & GL_MAP_COHERENT_BIT));
+				auto ptr = (char*)r.support.glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, fullBufferBytes,
+					GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | extraFlags);
+				if(!ptr)
+				{
+					glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+					glDeleteBuffers(1, &newPbo);
+					return {0, nullptr};
+				}
+				return {newPbo, ptr};
+			};
+			auto [newPbo, ptr] = makeMappedBuffer(GL_MAP_COHERENT_BIT);
+			isCoherent = bool(ptr);
+			if(!ptr) [[unlikely]]
+			{
+				logWarn("coherent PBO mapping failed, using explicit flushes");
+				std::tie(newPbo, ptr) = makeMappedBuffer(GL_MAP_FLUSH_EXPLICIT_BIT);
+			}
+			if(!ptr) [[unlikely]]
 			{
-				logErr("PBO:%u mapping failed", newPbo);
+				logErr("PBO mapping failed");
 				ctx.notifySemaphore();
-				glDeleteBuffers(1, &newPbo);
 			}
 			else
 			{
 				pbo = newPbo;
+				bufferPtr = ptr;
 				ctx.notifySemaphore();
 				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 			}
 		});
+	coherentMapping = isCoherent;
 	if(bufferPtr)
 	{
-		logMsg("allocated PBO:%u with buffers:%u size:%u data:%p", pixelBuff.get(), singleBuffer ? 1 : 2, bufferBytes, bufferPtr);
-		info[0] = {bufferPtr, nullptr};
-		if(singleBuffer)
-			info[1] = {nullptr};
-		else
+		logMsg("allocated %sPBO:%u with buffers:%u size:%u data:%p", coherentMapping ? "coherent " : "",
+			pixelBuff.get(), bufferCount, bufferBytes, bufferPtr);
+		for(auto i : iotaCount(GLBufferFences::maxBuffers))
 		{
-			info[1] = {bufferPtr + bufferBytes, (void *)(uintptr_t)bufferBytes};
+			if(i < bufferCount)
+				info[i] = {bufferPtr + bufferBytes * i, (void *)(uintptr_t)(bufferBytes * i)};
+			else
+				info[i] = {};
 		}
 	}
 	else [[unlikely]]
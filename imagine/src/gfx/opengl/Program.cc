@@ -23,6 +23,7 @@
 #include "utils.hh"
 #include <cstring>
 #include <format>
+#include <utility>
 
 namespace IG::Gfx
 {
@@ -39,6 +40,54 @@ static GLuint makeGLProgram(GLuint vShader, GLuint fShader)
 	return program;
 }
 
+static GLuint makeGLProgram(const DrawContextSupport &support, const GLProgramBinary &binary)
+{
+	auto program = glCreateProgram();
+	runGLChecked(
+		[&]()
+		{
+			support.glProgramBinary(program, binary.format, binary.data.data(), binary.data.size());
+		}, "glProgramBinary()");
+	GLint success;
+	glGetProgramiv(program, GL_LINK_STATUS, &success);
+	if(success == GL_FALSE)
+	{
+		glDeleteProgram(program);
+		return 0;
+	}
+	return program;
+}
+
+static GLProgramBinary programBinary(const DrawContextSupport &support, GLuint program)
+{
+	GLProgramBinary binary;
+	GLint size{};
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &size);
+	if(size <= 0)
+		return {};
+	binary.data.resize(size);
+	GLsizei writtenSize{};
+	runGLChecked(
+		[&]()
+		{
+			support.glGetProgramBinary(program, size, &writtenSize, &binary.format, binary.data.data());
+		}, "glGetProgramBinary()");
+	binary.data.resize(writtenSize);
+	return binary;
+}
+
+static void getUniformLocations(GLuint program, std::span<UniformLocationDesc> uniformDescs)
+{
+	for(auto desc : uniformDescs)
+	{
+		runGLChecked([&]()
+		{
+			*desc.locationPtr = glGetUniformLocation(program, desc.name);
+		}, "glGetUniformLocation()");
+		logMsg("uniform:%s location:%d", desc.name, *desc.locationPtr);
+	}
+}
+
 static bool linkGLProgram(GLuint program)
 {
 	runGLChecked(
@@ -102,7 +151,7 @@ Program::Program(RendererTask &rTask, NativeShader vShader, NativeShader fShader
 {
 	GLuint programOut{};
 	rTask.runSync(
-		[=, &programOut]()
+		[=, &programOut, &support = std::as_const(rTask.renderer().support)]()
 		{
 			auto program = makeGLProgram(vShader, fShader);
 			if(!program) [[unlikely]]
@@ -128,6 +177,8 @@ Program::Program(RendererTask &rTask, NativeShader vShader, NativeShader fShader
 						glBindAttribLocation(program, VATTR_TEX_UV, "texUV");
 					}, "glBindAttribLocation(..., texUV)");
 			}
+			if(support.glProgramParameteri)
+				support.glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 			if(!linkGLProgram(program))
 			{
 				glDeleteProgram(program);
@@ -136,19 +187,61 @@ Program::Program(RendererTask &rTask, NativeShader vShader, NativeShader fShader
 			logMsg("made program:%d", program);
 			glDetachShader(program, vShader);
 			glDetachShader(program, fShader);
-			for(auto desc : uniformDescs)
-			{
-				runGLChecked([&]()
-				{
-					*desc.locationPtr = glGetUniformLocation(program, desc.name);
-				}, "glGetUniformLocation()");
-				logMsg("uniform:%s location:%d", desc.name, *desc.locationPtr);
-			}
+			getUniformLocations(program, uniformDescs);
 			programOut = program;
 		});
 	program_ = {programOut, {&rTask}};
 }
 
+Program::Program(RendererTask &rTask, std::span<std::string_view> vShaderSrcs, std::span<std::string_view> fShaderSrcs,
+	ProgramFlags flags, std::span<UniformLocationDesc> uniformDescs)
+{
+	auto &r = rTask.renderer();
+	const auto &support = r.support;
+	const auto &cache = r.programBinaryCache;
+	uint64_t cacheKey{};
+	if(cache)
+	{
+		// settings that change the generated compat source or the linked attributes
+		uint32_t settings = flags.hasColor | flags.hasTexture << 1 | bool(support.useLegacyGLSL) << 2;
+		cacheKey = cache.key(vShaderSrcs, fShaderSrcs, settings);
+		if(auto binary = cache.load(cacheKey))
+		{
+			GLuint programOut{};
+			rTask.runSync(
+				[&]()
+				{
+					programOut = makeGLProgram(support, binary);
+					if(programOut)
+						getUniformLocations(programOut, uniformDescs);
+				});
+			if(programOut)
+			{
+				logMsg("made program:%d from cached binary", programOut);
+				program_ = {programOut, {&rTask}};
+				return;
+			}
+			logWarn("cached program binary was rejected, compiling");
+			cache.remove(cacheKey);
+		}
+	}
+	Program prog{rTask,
+		Shader{rTask, vShaderSrcs, ShaderType::VERTEX, Shader::CompileMode::COMPAT},
+		Shader{rTask, fShaderSrcs, ShaderType::FRAGMENT, Shader::CompileMode::COMPAT},
+		flags, uniformDescs};
+	if(prog && cache)
+	{
+		GLProgramBinary binary;
+		rTask.runSync(
+			[&, program = prog.glProgram()]()
+			{
+				binary = programBinary(support, program);
+			});
+		cache.store(cacheKey, binary);
+	}
+	program_ = std::move(prog.program_);
+}
+
 Program::operator bool() const
 {
 	return program_.get();
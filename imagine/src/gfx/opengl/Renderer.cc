@@ -323,6 +323,24 @@ PresentMode Renderer::evalPresentMode(const Window &win, PresentMode mode) const
 	return mode;
 }
 
+void GLDrawStatsCounter::endFrame(uint32_t stateChanges)
+{
+	frame.stateChanges += stateChanges;
+	std::scoped_lock lock{mutex};
+	lastFrame_ = std::exchange(frame, {});
+}
+
+DrawStats GLDrawStatsCounter::lastFrame() const
+{
+	std::scoped_lock lock{mutex};
+	return lastFrame_;
+}
+
+DrawStats Renderer::lastFrameDrawStats() const
+{
+	return drawStats.lastFrame();
+}
+
 int Renderer::maxSwapChainImages() const
 {
 	#ifdef __ANDROID__
@@ -583,6 +601,10 @@ static void printFeatures(DrawContextSupport support)
 	{
 		featuresStr.append(" [Memory Barriers]");
 	}
+	if(support.hasProgramBinary())
+	{
+		featuresStr.append(" [Program Binaries]");
+	}
 	if(Config::Gfx::OPENGL_ES && support.hasUnpackRowLength)
 	{
 		featuresStr.append(" [Unpack Sub-Images]");
@@ -758,6 +780,23 @@ void GLRenderer::setupVAOFuncs(bool oes)
 	#endif
 }
 
+void GLRenderer::setupProgramBinary(bool oes)
+{
+	if(support.glProgramBinary)
+		return;
+	if(oes)
+	{
+		support.glGetProgramBinary = (typeof(support.glGetProgramBinary))glManager.procAddress("glGetProgramBinaryOES");
+		support.glProgramBinary = (typeof(support.glProgramBinary))glManager.procAddress("glProgramBinaryOES");
+	}
+	else
+	{
+		support.glGetProgramBinary = (typeof(support.glGetProgramBinary))glManager.procAddress("glGetProgramBinary");
+		support.glProgramBinary = (typeof(support.glProgramBinary))glManager.procAddress("glProgramBinary");
+		support.glProgramParameteri = (typeof(support.glProgramParameteri))glManager.procAddress("glProgramParameteri");
+	}
+}
+
 void GLRenderer::setupFenceSync()
 {
 	#if !defined CONFIG_BASE_GL_PLATFORM_EGL && defined CONFIG_GFX_OPENGL_ES
@@ -884,6 +923,10 @@ void GLRenderer::checkExtensionString(std::string_view extStr)
 	{
 		setupImmutableBufferStorage();
 	}
+	else if(extStr == "GL_OES_get_program_binary")
+	{
+		setupProgramBinary(true);
+	}
 	/*else if(string_equal(extStr, "GL_OES_mapbuffer"))
 	{
 		// handled in *_map_buffer_range currently
@@ -919,6 +962,10 @@ void GLRenderer::checkExtensionString(std::string_view extStr)
 	{
 		setupImmutableBufferStorage();
 	}
+	else if(extStr == "GL_ARB_get_program_binary")
+	{
+		setupProgramBinary();
+	}
 	else if(extStr == "GL_ARB_shader_image_load_store")
 	{
 		setupMemoryBarrier();
@@ -946,13 +993,15 @@ void Renderer::configureRenderer()
 	{
 		setCorrectnessChecks(true);
 	}
+	std::string driverId;
 	task().runSync(
-		[this](GLTask::TaskContext ctx)
+		[this, &driverId](GLTask::TaskContext ctx)
 		{
 			auto version = (const char*)glGetString(GL_VERSION);
 			assert(version);
 			auto rendererName = (const char*)glGetString(GL_RENDERER);
 			logMsg("version: %s (%s)", version, rendererName);
+			driverId = std::format("{}\n{}\n{}", (const char*)glGetString(GL_VENDOR), rendererName, version);
 
 			int glVer = glVersionFromStr(version);
 
@@ -988,12 +1037,15 @@ void Renderer::configureRenderer()
 					setupSpecifyDrawReadBuffers();
 				support.hasUnpackRowLength = true;
 				support.useLegacyGLSL = false;
+				setupProgramBinary();
 			}
 			if(glVer >= 31)
 			{
 				setupMemoryBarrier();
 			}
 			#endif // CONFIG_GFX_OPENGL_ES
+			if(!Config::Gfx::OPENGL_ES && glVer >= 41)
+				setupProgramBinary();
 
 			// extension functionality
 			forEachOpenGLExtension([&](const auto &extStr)
@@ -1002,6 +1054,17 @@ void Renderer::configureRenderer()
 			});
 			printGLExtensions();
 
+			if(support.hasProgramBinary())
+			{
+				GLint binaryFormats{};
+				glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormats);
+				if(!binaryFormats)
+				{
+					logMsg("no program binary formats supported");
+					support.glProgramBinary = {};
+				}
+			}
+
 			GLint texSize;
 			glGetIntegerv(GL_MAX_TEXTURE_SIZE, &texSize);
 			support.textureSizeSupport.maxXSize = support.textureSizeSupport.maxYSize = texSize;
@@ -1010,6 +1073,8 @@ void Renderer::configureRenderer()
 			printFeatures(support);
 			task().runInitialCommandsInGL(ctx, support);
 		});
+	if(support.hasProgramBinary())
+		programBinaryCache.init(mainTask.appContext().cachePath(), driverId);
 	support.isConfigured = true;
 }
 
@@ -53,6 +53,7 @@ void GLRendererCommands::bindGLVertexArray(GLuint vao)
 		return;
 	currVertexArrayName = vao;
 	r->support.glBindVertexArray(vao);
+	r->drawStats.frame.stateChanges++;
 }
 
 void GLRendererCommands::bindGLArrayBuffer(GLuint vbo)
@@ -131,6 +132,7 @@ void RendererCommands::present(SteadyClockTimePoint t)
 		r->glManager.setPresentationTime(drawable, t);
 	notifyDrawComplete();
 	doPresent();
+	r->drawStats.endFrame(std::exchange(glState.changes, 0));
 }
 
 SyncFence RendererCommands::addSyncFence()
@@ -369,6 +371,18 @@ void RendererCommands::set(TextureBinding binding)
 		logWarn("binding default texture");
 	}
 	glBindTexture(binding.target, binding.name);
+	r->drawStats.frame.textureBinds++;
+}
+
+void RendererCommands::set(TextureBinding binding, int unit)
+{
+	if(!unit)
+		return set(binding);
+	rTask->verifyCurrentContext();
+	glActiveTexture(GL_TEXTURE0 + unit);
+	glBindTexture(binding.target, binding.name);
+	glActiveTexture(GL_TEXTURE0);
+	r->drawStats.frame.textureBinds++;
 }
 
 void RendererCommands::setTextureSampler(const TextureSampler &sampler)
@@ -380,6 +394,7 @@ void RendererCommands::setTextureSampler(const TextureSampler &sampler)
 	{
 		//logMsg("binding sampler object:0x%X (%s)", (int)sampler.name(), sampler.label());
 		renderer().support.glBindSampler(0, sampler.name());
+		r->drawStats.frame.stateChanges++;
 	}
 	currSamplerName = sampler.name();
 }
@@ -405,6 +420,8 @@ void RendererCommands::restoreViewport()
 void RendererCommands::vertexBufferData(ssize_t offset, const void *data, size_t size)
 {
 	glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+	r->drawStats.frame.bufferUploads++;
+	r->drawStats.frame.uploadBytes += size;
 }
 
 constexpr bool shouldNormalize(AttribType type, bool normalize) { return type != AttribType::Float && normalize; }
@@ -415,6 +432,7 @@ void RendererCommands::drawPrimitives(Primitive mode, int start, int count)
 	{
 		glDrawArrays(GLenum(mode), start, count);
 	}, "glDrawArrays()");
+	r->drawStats.frame.drawCalls++;
 }
 
 void RendererCommands::drawPrimitiveElements(Primitive mode, int start, int count, AttribType type)
@@ -423,6 +441,7 @@ void RendererCommands::drawPrimitiveElements(Primitive mode, int start, int coun
 	{
 		glDrawElements(GLenum(mode), count, asGLType(type), (const void*)(intptr_t)start);
 	}, "glDrawElements()");
+	r->drawStats.frame.drawCalls++;
 }
 
 bool GLRendererCommands::hasVAOFuncs() const { return r->support.hasVAOFuncs(); }
@@ -465,6 +484,7 @@ void RendererCommands::setProgram(NativeProgram program)
 	{
 		glUseProgram(program);
 		currProgram = program;
+		r->drawStats.frame.programSwitches++;
 	}
 }
 
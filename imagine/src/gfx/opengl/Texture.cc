@@ -221,6 +221,17 @@ IG::WindowRect LockedTextureBuffer::sourceDirtyRect() const
 	return srcDirtyRect;
 }
 
+void LockedTextureBuffer::setDirtyLines(int start, int end)
+{
+	assumeExpr(start >= 0 && start <= end && end <= pix.h());
+	if(shouldFreeBuffer_) // buffer is freed using the original data pointer
+		return;
+	bufferOffset_ = (char*)bufferOffset_ + pix.pitchBytes() * start;
+	srcDirtyRect.y += start;
+	srcDirtyRect.y2 = srcDirtyRect.y + (end - start);
+	pix = {pix.desc().makeNewSize({pix.w(), end - start}), pix.data({0, start}), {pix.pitchBytes(), PixmapUnits::BYTE}};
+}
+
 LockedTextureBuffer::operator bool() const
 {
 	return (bool)pix;
@@ -413,7 +424,7 @@ void Texture::writeAligned(int level, PixmapView pixmap, WPt destPos, int assume
 	if(hasUnpackRowLength || !pixmap.isPadded())
 	{
 		task().run(
-			[=, &r = std::as_const(r), texName = texName()]()
+			[=, &r = std::as_const(r), &stats = r.drawStats.frame, texName = texName()]()
 			{
 				glBindTexture(GL_TEXTURE_2D, texName);
 				glPixelStorei(GL_UNPACK_ALIGNMENT, assumeAlign);
@@ -427,6 +438,8 @@ void Texture::writeAligned(int level, PixmapView pixmap, WPt destPos, int assume
 						glTexSubImage2D(GL_TEXTURE_2D, level, destPos.x, destPos.y,
 							pixmap.w(), pixmap.h(), format, dataType, pixmap.data());
 					}, "glTexSubImage2D()");
+				stats.textureUploads++;
+				stats.uploadBytes += pixmap.bytes();
 				if(makeMipmaps)
 				{
 					log.info("generating mipmaps for texture:0x{:X}", texName);
@@ -515,9 +528,9 @@ void Texture::unlock(LockedTextureBuffer lockBuff, TextureWriteFlags writeFlags)
 		updateLevelsForMipmapGeneration();
 	}
 	task().run(
-		[&r = std::as_const(renderer()), pix = lockBuff.pixmap(), bufferOffset = lockBuff.bufferOffset(),
+		[&r = std::as_const(renderer()), &stats = renderer().drawStats.frame, pix = lockBuff.pixmap(), bufferOffset = lockBuff.bufferOffset(),
 		 texName = texName(), destPos = WPt{lockBuff.sourceDirtyRect().x, lockBuff.sourceDirtyRect().y},
-		 pbo = lockBuff.pbo(), level = lockBuff.level(),
+		 pbo = lockBuff.pbo(), pboIsCoherent = lockBuff.pboIsCoherent(), level = lockBuff.level(),
 		 shouldFreeBuffer = lockBuff.shouldFreeBuffer(), makeMipmaps]()
 		{
 			glBindTexture(GL_TEXTURE_2D, texName);
@@ -527,7 +540,8 @@ void Texture::unlock(LockedTextureBuffer lockBuff, TextureWriteFlags writeFlags)
 				assumeExpr(r.support.hasUnpackRowLength);
 				glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
 				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
-				r.support.glFlushMappedBufferRange(GL_PIXEL_UNPACK_BUFFER, (GLintptr)bufferOffset, pix.bytes());
+				if(!pboIsCoherent)
+					r.support.glFlushMappedBufferRange(GL_PIXEL_UNPACK_BUFFER, (GLintptr)bufferOffset, pix.bytes());
 			}
 			else
 			{
@@ -542,6 +556,8 @@ void Texture::unlock(LockedTextureBuffer lockBuff, TextureWriteFlags writeFlags)
 					glTexSubImage2D(GL_TEXTURE_2D, level, destPos.x, destPos.y,
 						pix.w(), pix.h(), format, dataType, bufferOffset);
 				}, "glTexSubImage2D()");
+			stats.textureUploads++;
+			stats.uploadBytes += pix.bytes();
 			if(pbo)
 			{
 				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
@@ -689,6 +705,9 @@ void GLTexture::updateFormatInfo(PixmapDesc desc, int8_t levels, GLenum target)
 	assert(levels);
 	levels_ = levels;
 	pixDesc = desc;
+	// a full mipmap chain adds about a third
+	size_t bytes = desc.bytes();
+	storageCharge.set(levels > 1 ? bytes + bytes / 3 : bytes);
 	if(Config::Gfx::OPENGL_TEXTURE_TARGET_EXTERNAL && target == GL_TEXTURE_EXTERNAL_OES)
 		type_ = TextureType::T2D_EXTERNAL;
 	else
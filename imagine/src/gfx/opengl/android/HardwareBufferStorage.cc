@@ -81,7 +81,8 @@ void HardwareSingleBufferStorage<Buffer>::unlock(LockedTextureBuffer, TextureWri
 
 template<class Buffer>
 HardwareBufferStorage<Buffer>::HardwareBufferStorage(RendererTask &r, TextureConfig config):
-	Texture{r}
+	Texture{r},
+	fences{std::make_unique<GLBufferFences>(r)}
 {
 	config = baseInit(r, config);
 	if(!setFormat(config.pixmapDesc, config.colorSpace, config.samplerConfig)) [[unlikely]]
@@ -93,6 +94,9 @@ HardwareBufferStorage<Buffer>::HardwareBufferStorage(RendererTask &r, TextureCon
 template<class Buffer>
 bool HardwareBufferStorage<Buffer>::setFormat(PixmapDesc desc, ColorSpace colorSpace, TextureSamplerConfig samplerConf)
 {
+	fences->reset();
+	bufferIdx = 0;
+	boundIdx = -1;
 	auto dpy = renderer().glDisplay();
 	for(auto &[buff, eglImg, pitchBytes] : bufferInfo)
 	{
@@ -120,6 +124,7 @@ template<class Buffer>
 LockedTextureBuffer HardwareBufferStorage<Buffer>::lock(TextureBufferFlags bufferFlags)
 {
 	void *data{};
+	fences->acquire(bufferIdx);
 	auto &[buff, eglImg, pitchBytes] = bufferInfo[bufferIdx];
 	if(!buff.lock(lockUsage, &data)) [[unlikely]]
 	{
@@ -140,7 +145,12 @@ template<class Buffer>
 void HardwareBufferStorage<Buffer>::swapBuffer()
 {
 	updateWithEGLImage(bufferInfo[bufferIdx].eglImg.get());
-	bufferIdx = (bufferIdx + 1) % 2;
+	// draws sampling the previously bound buffer were all queued before this point
+	if(boundIdx != -1)
+		fences->queueFence(boundIdx);
+	fences->markSubmitted(bufferIdx);
+	boundIdx = bufferIdx;
+	bufferIdx = (bufferIdx + 1) % GLBufferFences::maxBuffers;
 }
 
 template class HardwareSingleBufferStorage<HardwareBuffer>;
@@ -11,6 +11,8 @@ SRC += gfx/common/GfxText.cc \
  gfx/opengl/BasicEffect.cc \
  gfx/opengl/Buffer.cc \
  gfx/opengl/DrawContextSupport.cc \
+ gfx/opengl/GLBufferFences.cc \
+ gfx/opengl/GLProgramBinaryCache.cc \
  gfx/opengl/GLStateCache.cc \
  gfx/opengl/GLTask.cc \
  gfx/opengl/PixmapBufferTexture.cc \
@@ -25,6 +25,7 @@
 #include <imagine/util/math.hh>
 #include <imagine/util/format.hh>
 #include <imagine/util/string.h>
+#include <algorithm>
 #include <string>
 #include <system_error>
 
@@ -32,6 +33,40 @@ namespace IG
 {
 
 constexpr SystemLogger log{"FSPicker"};
+constexpr size_t incrementalListBatchSize = 256;
+constexpr size_t maxCachedListings = 16;
+
+static bool isDirectory(const FSPicker::FileEntry &e) { return e.isDir(); }
+static bool isDirectory(const FSPicker::DirListEntry &e) { return e.type == FS::file_type::directory; }
+
+// directories first, then by path
+constexpr auto listingOrder = [](const auto &e1, const auto &e2)
+{
+	bool isDir1 = isDirectory(e1), isDir2 = isDirectory(e2);
+	if(isDir1 != isDir2)
+		return isDir1;
+	return caselessLexCompare(e1.path, e2.path);
+};
+
+// listings shared by all pickers, most recently used last
+static std::vector<FSPicker::DirListing> cachedListings;
+
+static const FSPicker::DirListing *findCachedListing(std::string_view path)
+{
+	auto it = std::ranges::find(cachedListings, path, &FSPicker::DirListing::path);
+	if(it == cachedListings.end())
+		return nullptr;
+	std::rotate(it, it + 1, cachedListings.end());
+	return &cachedListings.back();
+}
+
+static void storeCachedListing(FSPicker::DirListing listing)
+{
+	std::erase_if(cachedListings, [&](auto &l){ return l.path == listing.path; });
+	if(cachedListings.size() == maxCachedListings)
+		cachedListings.erase(cachedListings.begin());
+	cachedListings.emplace_back(std::move(listing));
+}
 
 FSPicker::FSPicker(ViewAttachParams attach, Gfx::TextureSpan backRes, Gfx::TextureSpan closeRes,
 	FilterFunc filter, Mode mode, Gfx::GlyphTextureSet *face_):
@@ -73,6 +108,7 @@ FSPicker::FSPicker(ViewAttachParams attach, Gfx::TextureSpan backRes, Gfx::Textu
 		});
 	controller.setNavView(std::move(nav));
 	controller.push(makeView<TableView>(dir));
+	fileTableView().setVirtualRows(true); // large folders only lay out the rows on screen
 	controller.navView()->showLeftBtn(true);
 	dir.reserve(16); // start with some initial capacity to avoid small reallocations
 }
@@ -179,18 +215,15 @@ void FSPicker::prepareDraw()
 
 void FSPicker::draw(Gfx::RendererCommands &__restrict__ cmds, ViewDrawParams) const
 {
-	if(!dirListThread.isWorking())
+	if(dir.size())
 	{
-		if(dir.size())
-		{
-			controller.top().draw(cmds);
-		}
-		else
-		{
-			using namespace IG::Gfx;
-			cmds.basicEffect().enableAlphaTexture(cmds);
-			msgText.draw(cmds, controller.top().viewRect().pos(C2DO), C2DO, ColorName::WHITE);
-		}
+		controller.top().draw(cmds);
+	}
+	else if(!dirListThread.isWorking())
+	{
+		using namespace IG::Gfx;
+		cmds.basicEffect().enableAlphaTexture(cmds);
+		msgText.draw(cmds, controller.top().viewRect().pos(C2DO), C2DO, ColorName::WHITE);
 	}
 	controller.navView()->draw(cmds);
 }
@@ -205,6 +238,8 @@ void FSPicker::setEmptyPath(std::string_view message)
 	log.info("setting empty path");
 	dirListThread.stop();
 	dirListEvent.cancel();
+	clearPendingEntries();
+	showingCachedListing = false;
 	root = {};
 	newFileUIState = {};
 	fileUIStates.clear();
@@ -468,17 +503,25 @@ void FSPicker::startDirectoryListThread(CStringView path)
 	}
 	dir.clear();
 	fileTableView().resetItemSource();
+	clearPendingEntries();
+	restoredUIState = false;
+	std::optional<FS::file_time_type> cachedWriteTime;
+	if(auto listing = findCachedListing(path))
+	{
+		log.info("showing cached listing of:{}", path);
+		cachedWriteTime = listing->lastWriteTime;
+		addEntries(listing->entries);
+		showEntries();
+	}
+	showingCachedListing = cachedWriteTime.has_value();
 	dirListEvent.setCallback([this]()
 	{
-		fileTableView().resetItemSource(dir);
-		place();
-		fileTableView().restoreUIState(std::exchange(newFileUIState, {}));
-		postDraw();
+		updateDirectoryList();
 	});
 	dirListEvent.cancel();
-	dirListThread.reset([this](WorkThread::Context ctx, const std::string &path)
+	dirListThread.reset([this, cachedWriteTime](WorkThread::Context ctx, const std::string &path)
 	{
-		listDirectory(path, ctx.stop);
+		listDirectory(path, cachedWriteTime, ctx.stop);
 		if(ctx.stop.isQuitting()) [[unlikely]]
 			return;
 		ctx.finishedWork();
@@ -486,12 +529,28 @@ void FSPicker::startDirectoryListThread(CStringView path)
 	}, std::string{path});
 }
 
-void FSPicker::listDirectory(CStringView path, ThreadStop &stop)
+// Runs on dirListThread, entries are passed to the main thread in batches until the
+// listing is complete unless a cached listing is already shown
+void FSPicker::listDirectory(CStringView path, std::optional<FS::file_time_type> cachedWriteTime, ThreadStop &stop)
 {
 	try
 	{
+		auto lastWriteTime = appContext().fileUriLastWriteTime(path);
+		if(cachedWriteTime && lastWriteTime != FS::file_time_type{} && lastWriteTime == *cachedWriteTime)
+		{
+			log.info("cached listing of:{} is current", path);
+			return;
+		}
+		std::vector<DirListEntry> entries;
+		size_t postedEntries{};
+		auto postEntries = [&]()
+		{
+			std::scoped_lock lock{dirListMutex};
+			pendingEntries.insert(pendingEntries.end(), entries.begin() + postedEntries, entries.end());
+			postedEntries = entries.size();
+		};
 		appContext().forEachInDirectoryUri(path,
-			[this, &stop](auto &entry)
+			[&](auto &entry)
 			{
 				//log.info("entry:{}", entry.path());
 				if(stop) [[unlikely]]
@@ -499,79 +558,144 @@ void FSPicker::listDirectory(CStringView path, ThreadStop &stop)
 					log.info("interrupted listing directory");
 					return false;
 				}
-				bool isDir = entry.type() == FS::file_type::directory;
-				if(mode_ == Mode::FILE_IN_DIR) // filter directories
-				{
-					if(isDir)
-						return true;
-				}
-				if(!showHiddenFiles_ && entry.name().starts_with('.'))
-				{
-					return true;
-				}
-				if(filter && !filter(entry))
+				entries.emplace_back(std::string{entry.path()}, std::string{entry.name()}, entry.type());
+				if(!cachedWriteTime && entries.size() - postedEntries == incrementalListBatchSize)
 				{
-					return true;
+					postEntries();
+					dirListEvent.notify();
 				}
-				auto &item = dir.emplace_back(attachParams(), std::string{entry.path()}, entry.name());
-				if(isDir)
-					item.text.flags.user |= FileEntry::isDirFlag;
-				if(mode_ == Mode::DIR && !isDir)
-					item.text.setActive(false);
 				return true;
 			});
-		std::sort(dir.begin(), dir.end(),
-			[](const FileEntry &e1, const FileEntry &e2)
-			{
-				if(e1.isDir() && !e2.isDir())
-					return true;
-				else if(!e1.isDir() && e2.isDir())
-					return false;
-				else
-					return caselessLexCompare(e1.path, e2.path);
-			});
-		if(dir.size())
+		if(stop)
+			return;
+		if(!cachedWriteTime)
+			postEntries();
+		std::ranges::sort(entries, listingOrder);
+		std::scoped_lock lock{dirListMutex};
+		finishedListing = DirListing{std::string{path}, lastWriteTime, std::move(entries)};
+	}
+	catch(std::system_error &err)
+	{
+		log.error("can't open:{}", path);
+		std::scoped_lock lock{dirListMutex};
+		dirListError = err.code().message();
+	}
+}
+
+void FSPicker::updateDirectoryList()
+{
+	std::vector<DirListEntry> entries;
+	std::optional<DirListing> listing;
+	std::string error;
+	{
+		std::scoped_lock lock{dirListMutex};
+		entries = std::exchange(pendingEntries, {});
+		listing = std::exchange(finishedListing, {});
+		error = std::exchange(dirListError, {});
+	}
+	if(error.size())
+	{
+		if(showingCachedListing)
 		{
-			for(auto &d : dir)
-			{
-				if(!d.text.active())
-					continue;
-				if(d.isDir())
-				{
-					d.text.onSelect =
-						[this, &dirPath = d.path](const Input::Event &e)
-						{
-							assert(!isSingleDirectoryMode());
-							auto path = std::move(dirPath);
-							log.info("entering dir:{}", path);
-							changeDirByInput(path, root.info, e);
-						};
-				}
-				else
-				{
-					d.text.onSelect =
-						[this, &dirPath = d.path](const Input::Event &e)
-						{
-							onSelectPath_.callCopy(*this, dirPath, appContext().fileUriDisplayName(dirPath), e);
-						};
-				}
-			}
-			msgText.resetString();
+			dir.clear();
+			std::erase_if(cachedListings, [&](auto &l){ return l.path == root.path; });
 		}
-		else // no entries, show a message instead
+		std::string_view extraMsg = mode_ == Mode::FILE_IN_DIR ? "" : "\nPick a path from the top bar";
+		msgText.resetString(std::format("Can't open directory:\n{}{}", error, extraMsg));
+		msgText.compile();
+	}
+	if(listing && showingCachedListing)
+	{
+		// replace the cached entries already shown if the directory changed
+		if(auto cached = findCachedListing(listing->path); !cached || cached->entries != listing->entries)
 		{
-			msgText.resetString("Empty Directory");
-			msgText.compile();
+			log.info("updating cached listing of:{}", listing->path);
+			auto uiState = fileTableView().saveUIState();
+			dir.clear();
+			addEntries(listing->entries);
+			fileTableView().restoreUIState(uiState);
 		}
 	}
-	catch(std::system_error &err)
+	else if(entries.size())
 	{
-		log.error("can't open:{}", path);
-		auto ec = err.code();
-		std::string_view extraMsg = mode_ == Mode::FILE_IN_DIR ? "" : "\nPick a path from the top bar";
-		msgText.resetString(std::format("Can't open directory:\n{}{}", ec.message(), extraMsg));
+		std::ranges::sort(entries, listingOrder);
+		addEntries(entries);
+	}
+	if(listing)
+		storeCachedListing(std::move(*listing));
+	if(!dirListThread.isWorking() && !dir.size() && error.empty())
+	{
+		msgText.resetString("Empty Directory");
 		msgText.compile();
 	}
+	showEntries();
+}
+
+// Adds entries passing the filters, merging them into the current ones in display order
+void FSPicker::addEntries(std::span<const DirListEntry> entries)
+{
+	auto prevSize = dir.size();
+	for(const auto &e : entries)
+	{
+		bool isDir = e.type == FS::file_type::directory;
+		if(mode_ == Mode::FILE_IN_DIR && isDir) // filter directories
+			continue;
+		if(!showHiddenFiles_ && e.name.starts_with('.'))
+			continue;
+		if(filter && !filter(FS::directory_entry{e.path, e.name, e.type}))
+			continue;
+		auto &item = dir.emplace_back(attachParams(), e.path, e.name);
+		if(isDir)
+			item.text.flags.user |= FileEntry::isDirFlag;
+		if(mode_ == Mode::DIR && !isDir)
+			item.text.setActive(false);
+	}
+	if(prevSize == dir.size())
+		return;
+	std::inplace_merge(dir.begin(), dir.begin() + prevSize, dir.end(), listingOrder);
+	// entries may have moved so update all references to their paths
+	for(auto &d : dir)
+	{
+		if(!d.text.active())
+			continue;
+		if(d.isDir())
+		{
+			d.text.onSelect =
+				[this, &dirPath = d.path](const Input::Event &e)
+				{
+					assert(!isSingleDirectoryMode());
+					auto path = std::move(dirPath);
+					log.info("entering dir:{}", path);
+					changeDirByInput(path, root.info, e);
+				};
+		}
+		else
+		{
+			d.text.onSelect =
+				[this, &dirPath = d.path](const Input::Event &e)
+				{
+					onSelectPath_.callCopy(*this, dirPath, appContext().fileUriDisplayName(dirPath), e);
+				};
+		}
+	}
+	msgText.resetString();
+}
+
+void FSPicker::showEntries()
+{
+	fileTableView().resetItemSource(dir);
+	place();
+	if(dir.size() && !std::exchange(restoredUIState, true))
+		fileTableView().restoreUIState(std::exchange(newFileUIState, {}));
+	postDraw();
+}
+
+void FSPicker::clearPendingEntries()
+{
+	std::scoped_lock lock{dirListMutex};
+	pendingEntries.clear();
+	finishedListing.reset();
+	dirListError.clear();
 }
 
 }
@@ -61,17 +61,55 @@ void TableView::setAlign(_2DOrigin align)
 void TableView::prepareDraw()
 {
 	auto src = itemSrc;
+	if(virtualRows)
+	{
+		auto [start, end] = visibleRowRange(cells());
+		for(auto i = start; i < end; i++)
+		{
+			item(src, i).prepareDraw();
+		}
+		return;
+	}
 	for(auto i : iotaCount(cells()))
 	{
 		item(src, i).prepareDraw();
 	}
 }
 
+std::pair<ssize_t, ssize_t> TableView::visibleRowRange(ssize_t cells_) const
+{
+	if(!yCellSize)
+		return {};
+	ssize_t start = std::clamp(ssize_t(scrollOffset() / yCellSize), 0z, cells_);
+	return {start, std::min(start + visibleCells, cells_)};
+}
+
+// lays out rows that scrolled into view since the last call, done at draw time
+// since the scroll offset changes from many input and animation paths
+void TableView::placeVisibleRows(ssize_t cells_) const
+{
+	auto src = itemSrc;
+	auto [start, end] = visibleRowRange(cells_);
+	for(auto i = start; i < end; i++)
+	{
+		if(i < placedRowsStart || i >= placedRowsEnd)
+		{
+			auto &row = item(src, i);
+			row.place();
+			row.prepareDraw();
+		}
+	}
+	placedRowsStart = start;
+	placedRowsEnd = end;
+}
+
 void TableView::draw(Gfx::RendererCommands &__restrict__ cmds, ViewDrawParams) const
 {
 	ssize_t cells_ = cells();
 	if(!cells_)
 		return;
+	if(virtualRows)
+		placeVisibleRows(cells_);
 	auto src = itemSrc;
 	using namespace IG::Gfx;
 	auto visibleRect = viewRect() + WindowRect{{}, {0, displayRect().y2 - viewRect().y2}};
@@ -121,7 +159,8 @@ void TableView::draw(Gfx::RendererCommands &__restrict__ cmds, ViewDrawParams) c
 			{
 				int ySize = regularYSize;
 				auto color = regularColor;
-				if(!item(src, i - 1).selectable())
+				// the row above the first visible one may not be bound in virtual mode
+				if(!(virtualRows && i == startYCell) && !item(src, i - 1).selectable())
 				{
 					ySize = headingYSize;
 					color = headingColor;
@@ -171,19 +210,35 @@ void TableView::draw(Gfx::RendererCommands &__restrict__ cmds, ViewDrawParams) c
 
 void TableView::place()
 {
-	auto cells_ = cells();
+	ssize_t cells_ = cells();
 	auto src = itemSrc;
-	for(auto i : iotaCount(cells_))
+	if(virtualRows)
 	{
-		//log.debug("place item:{}", i);
-		item(src, i).place();
+		// row heights only depend on the font, so any row gives the cell size
+		placedRowsStart = placedRowsEnd = 0;
+		if(cells_)
+		{
+			auto firstRow = yCellSize ? std::min(ssize_t(std::max(scrollOffset(), 0) / yCellSize), cells_ - 1) : 0z;
+			setYCellSize(IG::makeEvenRoundedUp(item(src, firstRow).ySize()*2));
+		}
+	}
+	else
+	{
+		for(auto i : iotaCount(cells_))
+		{
+			//log.debug("place item:{}", i);
+			item(src, i).place();
+		}
+		if(cells_)
+			setYCellSize(IG::makeEvenRoundedUp(item(0).ySize()*2));
 	}
 	if(cells_)
 	{
-		setYCellSize(IG::makeEvenRoundedUp(item(0).ySize()*2));
 		visibleCells = IG::divRoundUp(displayRect().ySize(), yCellSize) + 1;
 		scrollToFocusRect();
 		selectQuads.write(0, {.bounds = WRect{{}, {viewRect().xSize(), yCellSize-1}}.as<int16_t>()});
+		if(virtualRows)
+			placeVisibleRows(cells_);
 	}
 	else
 		visibleCells = 0;
@@ -27,6 +27,7 @@
 #include <sys/inotify.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <ctime>
 #include <vector>
 #include <algorithm>
 
@@ -311,6 +312,12 @@ static bool processDevNode(LinuxApplication &app, CStringView path, int id, bool
 		logWarn("unable to get device info");
 	}
 	auto vendorProductId = ((devInfo.vendor & 0xFFFF) << 16) | (devInfo.product & 0xFFFF);
+	// event timestamps default to CLOCK_REALTIME, use the same clock as SteadyClock
+	// so the delay from the kernel receiving an event to it being handled can be measured
+	if(int clockId = CLOCK_MONOTONIC; ioctl(fd, EVIOCSCLOCKID, &clockId) < 0)
+	{
+		logWarn("unable to set event clock");
+	}
 	auto evDev = std::make_unique<Device>(std::in_place_type<EvdevInputDevice>, id, fd, DeviceTypeFlags{.gamepad = true}, nameStr.data(), vendorProductId);
 	fd_setNonblock(fd, 1);
 	EvdevInputDevice::addPollEvent(*evDev, app);
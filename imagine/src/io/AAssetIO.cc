@@ -17,6 +17,7 @@
 #include <imagine/io/AAssetIO.hh>
 #include <imagine/base/ApplicationContext.hh>
 #include <imagine/util/format.hh>
+#include <imagine/vmem/memory.hh>
 #include <imagine/logger/logger.h>
 #include "utils.hh"
 #include <imagine/io/IOUtils-impl.hh>
@@ -53,7 +54,9 @@ AAssetIO::AAssetIO(ApplicationContext ctx, CStringView name, OpenFlags openFlags
 			throw std::runtime_error{std::format("Error opening asset: {}", name)};
 	}
 	logMsg("opened asset:%p name:%s access:%s", asset.get(), name.data(), asString(access));
-	if(access == IOAccessHint::All)
+	// uncompressed assets are always mapped since it costs no more than the open,
+	// compressed ones only when the whole asset will be read anyway
+	if(!mapUncompressed() && access == IOAccessHint::All)
 		makeMapIO();
 }
 
@@ -131,6 +134,34 @@ void AAssetIO::advise(off_t offset, size_t bytes, Advice advice)
 		mapIO.advise(offset, bytes, advice);
 }
 
+// Maps an asset stored uncompressed directly from the APK file so reads are page faults
+// instead of going through the asset manager, returns false for compressed assets
+bool AAssetIO::mapUncompressed()
+{
+	off64_t start, length;
+	int fd = AAsset_openFileDescriptor64(asset.get(), &start, &length);
+	if(fd < 0)
+		return false;
+	// entries are only aligned to 4 bytes in the APK so map from the start of the page
+	auto pageOffset = start & off64_t(pageSize - 1);
+	void *data = mmap(nullptr, length + pageOffset, PROT_READ, MAP_SHARED, fd, start - pageOffset);
+	::close(fd);
+	if(data == MAP_FAILED) [[unlikely]]
+	{
+		logErr("error mapping asset:%p @ %lld (%lld bytes)", asset.get(), (long long)start, (long long)length);
+		return false;
+	}
+	logMsg("mapped uncompressed asset:%p to %p (%lld bytes)", asset.get(), data, (long long)length);
+	mapIO = {IOBuffer{{(uint8_t*)data + pageOffset, size_t(length)}, {.mappedFile = true},
+		[](const uint8_t *ptr, size_t size)
+		{
+			auto pagePtr = truncPageSize(const_cast<uint8_t*>(ptr));
+			munmap(pagePtr, size + (ptr - pagePtr));
+		}}};
+	mappedFromFd = true;
+	return true;
+}
+
 bool AAssetIO::makeMapIO()
 {
 	if(mapIO)
@@ -150,6 +181,8 @@ IOBuffer AAssetIO::releaseBuffer()
 {
 	if(!makeMapIO())
 		return {};
+	if(mappedFromFd) // the mapping doesn't depend on the asset
+		return mapIO.releaseBuffer();
 	auto map = mapIO.map();
 	logMsg("releasing asset:%p with buffer:%p (%zu bytes)", asset.get(), map.data(), map.size());
 	return {map, {},
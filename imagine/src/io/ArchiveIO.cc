@@ -252,6 +252,17 @@ void ArchiveIO::rewind()
 	init(std::move(io));
 }
 
+IO ArchiveIO::releaseIO()
+{
+	if(!ctrlBlock) [[unlikely]]
+		return {};
+	auto io = std::move(ctrlBlock->io);
+	arch = {};
+	ptr = {};
+	ctrlBlock = {};
+	return io;
+}
+
 ssize_t ArchiveIO::read(void *buff, size_t bytes, std::optional<off_t> offset)
 {
 	if(!*this) [[unlikely]]
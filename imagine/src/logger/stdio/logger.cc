@@ -19,6 +19,13 @@
 #include <imagine/logger/logger.h>
 #include <cstdio>
 #include <cstring>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #ifdef __ANDROID__
 #include <android/log.h>
@@ -52,6 +59,11 @@ static bool shouldLogToExternalFile(const char *dirStr)
 	return FS::exists(externalLogEnablePath(dirStr));
 }
 
+static bool shouldLogAsync(const char *dirStr)
+{
+	return FS::exists(FS::pathString(dirStr, "imagine_enable_log_async"));
+}
+
 void logger_setLogDirectoryPrefix(const char *dirStr)
 {
 	if(!logEnabled)
@@ -65,6 +77,8 @@ void logger_setLogDirectoryPrefix(const char *dirStr)
 		logMsg("external log file: %s", path.data());
 		logExternalFile = fopen(path.data(), "wb");
 	}
+	if(shouldLogAsync(dirStr))
+		logger_setAsync(true);
 }
 
 void logger_setEnabled(bool enable)
@@ -165,7 +179,135 @@ void logger_printf(LoggerSeverity severity, const char* msg, ...)
 namespace IG::Log
 {
 
+// In async mode each thread that logs gets its own single producer/consumer ring of
+// formatted messages which the logger thread drains, so the logging thread only pays for
+// the copy. A message is dropped and counted if its ring is full, and one too long
+// for a ring record is printed directly.
+struct AsyncLogRecord
+{
+	LoggerSeverity lv;
+	uint16_t size;
+	char str[508];
+};
+
+struct AsyncLogRing
+{
+	static constexpr size_t capacity = 64;
+
+	std::array<AsyncLogRecord, capacity> records;
+	std::atomic_size_t writeIdx{};
+	std::atomic_size_t readIdx{};
+	std::atomic_size_t dropped{};
+	std::atomic_bool orphaned{};
+};
+
+// marks the ring for removal once drained when its thread exits
+struct AsyncLogRingOwner
+{
+	AsyncLogRing *ring{};
+
+	~AsyncLogRingOwner()
+	{
+		if(ring)
+			ring->orphaned.store(true, std::memory_order_release);
+	}
+};
+
+static void printMsgNow(LoggerSeverity lv, const char* str, size_t strSize);
+
+static std::atomic_bool asyncLog{};
+static std::mutex asyncRingsMutex;
+static std::vector<std::unique_ptr<AsyncLogRing>> asyncRings;
+static thread_local AsyncLogRingOwner threadRing;
+static thread_local bool isAsyncLogThread{};
+
+static void drainAsyncRings()
+{
+	std::scoped_lock lock{asyncRingsMutex};
+	std::erase_if(asyncRings, [](auto &ringPtr)
+	{
+		auto &ring = *ringPtr;
+		bool orphaned = ring.orphaned.load(std::memory_order_acquire);
+		auto readIdx = ring.readIdx.load(std::memory_order_relaxed);
+		auto writeIdx = ring.writeIdx.load(std::memory_order_acquire);
+		for(; readIdx != writeIdx; readIdx++)
+		{
+			auto &rec = ring.records[readIdx % AsyncLogRing::capacity];
+			printMsgNow(rec.lv, rec.str, rec.size);
+			ring.readIdx.store(readIdx + 1, std::memory_order_release);
+		}
+		if(auto dropped = ring.dropped.exchange(0, std::memory_order_relaxed); dropped)
+		{
+			char str[64];
+			auto size = snprintf(str, sizeof(str), "LoggerStdio: dropped %zu async log message(s)", dropped);
+			printMsgNow(LOG_W, str, size);
+		}
+		return orphaned;
+	});
+}
+
+static struct AsyncLogThread
+{
+	std::thread thread;
+
+	~AsyncLogThread() { stop(); }
+
+	void start()
+	{
+		thread = std::thread{[]
+		{
+			isAsyncLogThread = true;
+			while(asyncLog.load(std::memory_order_relaxed))
+			{
+				drainAsyncRings();
+				std::this_thread::sleep_for(std::chrono::milliseconds{10});
+			}
+			drainAsyncRings();
+		}};
+	}
+
+	void stop()
+	{
+		asyncLog.store(false, std::memory_order_relaxed);
+		if(thread.joinable())
+			thread.join();
+	}
+} asyncLogThread;
+
+static void pushAsyncMsg(LoggerSeverity lv, const char* str, size_t strSize)
+{
+	auto &owner = threadRing;
+	if(!owner.ring)
+	{
+		std::scoped_lock lock{asyncRingsMutex};
+		owner.ring = asyncRings.emplace_back(std::make_unique<AsyncLogRing>()).get();
+	}
+	auto &ring = *owner.ring;
+	auto writeIdx = ring.writeIdx.load(std::memory_order_relaxed);
+	if(writeIdx - ring.readIdx.load(std::memory_order_acquire) == AsyncLogRing::capacity)
+	{
+		ring.dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	auto &rec = ring.records[writeIdx % AsyncLogRing::capacity];
+	rec.lv = lv;
+	rec.size = uint16_t(strSize);
+	memcpy(rec.str, str, strSize);
+	rec.str[strSize] = 0;
+	ring.writeIdx.store(writeIdx + 1, std::memory_order_release);
+}
+
 void printMsg(LoggerSeverity lv, const char* str, size_t strSize)
+{
+	if(asyncLog.load(std::memory_order_relaxed) && !isAsyncLogThread && strSize < sizeof(AsyncLogRecord::str))
+	{
+		pushAsyncMsg(lv, str, strSize);
+		return;
+	}
+	printMsgNow(lv, str, strSize);
+}
+
+static void printMsgNow(LoggerSeverity lv, const char* str, size_t strSize)
 {
 	const char newLine = '\n';
 	if(logExternalFile)
@@ -194,3 +336,13 @@ void print(LoggerSeverity lv, std::string_view tag, std::string_view format, std
 }
 
 }
+
+void logger_setAsync(bool async)
+{
+	if(asyncLog.exchange(async) == async)
+		return;
+	if(async)
+		IG::Log::asyncLogThread.start();
+	else
+		IG::Log::asyncLogThread.stop();
+}
@@ -13,14 +13,19 @@
 	You should have received a copy of the GNU General Public License
 	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
 
+#include <imagine/pixmap/Pixmap.hh>
 #include <array>
 #include <cstdint>
+#include <utility>
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace IG
 {
 
-using RGBTripleArray = std::array<unsigned char, 3>;
-
 RGBTripleArray transformRGB565ToRGB888(uint16_t p)
 {
 	unsigned b = p       & 0x1F;
@@ -109,4 +114,165 @@ static uint32_t transformRGB888ToRGBX8888Impl(RGBTripleArray p)
 uint32_t transformRGB888ToRGBX8888(RGBTripleArray p) { return transformRGB888ToRGBX8888Impl(p); }
 uint32_t transformRGB888ToBGRX8888(RGBTripleArray p) { return transformRGB888ToRGBX8888Impl<true>(p); }
 
+// The vector versions widen channels to 16-bit lanes and use multiply, add & shift
+// constants that give the same rounding as the division based scalar formulas:
+// 5 -> 8 bits: (v * 527 + 23) >> 6, 6 -> 8 bits: (v * 259 + 33) >> 6
+// 8 -> 5 bits: (v * 249 + 1014) >> 11, 8 -> 6 bits: (v * 253 + 505) >> 10
+// All intermediate values fit in 16 bits unsigned.
+
+template <bool BGR_SWAP = false>
+static void transformNRGB565ToRGBX8888Impl(const uint16_t *src, size_t count, uint32_t *dest)
+{
+	#if defined(__ARM_NEON)
+	auto expand = [](uint16x8_t v, uint16_t mul, uint16_t add) { return vmovn_u16(vshrq_n_u16(vmlaq_n_u16(vdupq_n_u16(add), v, mul), 6)); };
+	for(; count >= 8; count -= 8, src += 8, dest += 8)
+	{
+		uint16x8_t p = vld1q_u16(src);
+		uint16x8_t r = vshrq_n_u16(p, 11);
+		uint16x8_t g = vandq_u16(vshrq_n_u16(p, 5), vdupq_n_u16(0x3F));
+		uint16x8_t b = vandq_u16(p, vdupq_n_u16(0x1F));
+		if constexpr(BGR_SWAP) { std::swap(r, b); }
+		uint8x8x4_t out{{expand(r, 527, 23), expand(g, 259, 33), expand(b, 527, 23), vdup_n_u8(0)}};
+		vst4_u8((uint8_t*)dest, out);
+	}
+	#elif defined(__SSE2__)
+	auto expand = [](__m128i v, short mul, short add) { return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(v, _mm_set1_epi16(mul)), _mm_set1_epi16(add)), 6); };
+	for(; count >= 8; count -= 8, src += 8, dest += 8)
+	{
+		__m128i p = _mm_loadu_si128((const __m128i*)src);
+		__m128i r = _mm_srli_epi16(p, 11);
+		__m128i g = _mm_and_si128(_mm_srli_epi16(p, 5), _mm_set1_epi16(0x3F));
+		__m128i b = _mm_and_si128(p, _mm_set1_epi16(0x1F));
+		if constexpr(BGR_SWAP) { std::swap(r, b); }
+		__m128i rg = _mm_or_si128(expand(r, 527, 23), _mm_slli_epi16(expand(g, 259, 33), 8));
+		b = expand(b, 527, 23);
+		_mm_storeu_si128((__m128i*)dest, _mm_unpacklo_epi16(rg, b));
+		_mm_storeu_si128((__m128i*)(dest + 4), _mm_unpackhi_epi16(rg, b));
+	}
+	#endif
+	for(; count; count--)
+	{
+		*dest++ = transformRGB565ToRGBX8888Impl<BGR_SWAP>(*src++);
+	}
+}
+
+void transformNRGB565ToRGBX8888(const uint16_t *src, size_t count, uint32_t *dest) { transformNRGB565ToRGBX8888Impl(src, count, dest); }
+void transformNRGB565ToBGRX8888(const uint16_t *src, size_t count, uint32_t *dest) { transformNRGB565ToRGBX8888Impl<true>(src, count, dest); }
+
+template <bool BGR_SWAP = false>
+static void transformNRGBX8888ToRGB565Impl(const uint32_t *src, size_t count, uint16_t *dest)
+{
+	#if defined(__ARM_NEON)
+	auto reduce = [](uint8x8_t v, uint16_t mul, uint16_t add, auto shift)
+	{
+		return vshrq_n_u16(vmlaq_n_u16(vdupq_n_u16(add), vmovl_u8(v), mul), decltype(shift)::value);
+	};
+	for(; count >= 8; count -= 8, src += 8, dest += 8)
+	{
+		uint8x8x4_t p = vld4_u8((const uint8_t*)src);
+		uint8x8_t rIn = p.val[0], bIn = p.val[2];
+		if constexpr(BGR_SWAP) { std::swap(rIn, bIn); }
+		uint16x8_t r = reduce(rIn, 249, 1014, std::integral_constant<int, 11>{});
+		uint16x8_t g = reduce(p.val[1], 253, 505, std::integral_constant<int, 10>{});
+		uint16x8_t b = reduce(bIn, 249, 1014, std::integral_constant<int, 11>{});
+		vst1q_u16(dest, vorrq_u16(vorrq_u16(vshlq_n_u16(r, 11), vshlq_n_u16(g, 5)), b));
+	}
+	#elif defined(__SSE2__)
+	const __m128i mask8 = _mm_set1_epi32(0xFF);
+	auto channel = [&](__m128i p0, __m128i p1, int shift)
+	{
+		return _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(p0, shift), mask8), _mm_and_si128(_mm_srli_epi32(p1, shift), mask8));
+	};
+	auto reduce = [](__m128i v, short mul, short add, int shift) { return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(v, _mm_set1_epi16(mul)), _mm_set1_epi16(add)), shift); };
+	for(; count >= 8; count -= 8, src += 8, dest += 8)
+	{
+		__m128i p0 = _mm_loadu_si128((const __m128i*)src);
+		__m128i p1 = _mm_loadu_si128((const __m128i*)(src + 4));
+		__m128i r = channel(p0, p1, 0);
+		__m128i g = channel(p0, p1, 8);
+		__m128i b = channel(p0, p1, 16);
+		if constexpr(BGR_SWAP) { std::swap(r, b); }
+		r = reduce(r, 249, 1014, 11);
+		g = reduce(g, 253, 505, 10);
+		b = reduce(b, 249, 1014, 11);
+		_mm_storeu_si128((__m128i*)dest, _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b));
+	}
+	#endif
+	for(; count; count--)
+	{
+		*dest++ = transformRGBX8888ToRGB565Impl<BGR_SWAP>(*src++);
+	}
+}
+
+void transformNRGBX8888ToRGB565(const uint32_t *src, size_t count, uint16_t *dest) { transformNRGBX8888ToRGB565Impl(src, count, dest); }
+void transformNBGRX8888ToRGB565(const uint32_t *src, size_t count, uint16_t *dest) { transformNRGBX8888ToRGB565Impl<true>(src, count, dest); }
+
+void transformNRGBA8888ToBGRA8888(const uint32_t *src, size_t count, uint32_t *dest)
+{
+	#if defined(__ARM_NEON)
+	for(; count >= 16; count -= 16, src += 16, dest += 16)
+	{
+		uint8x16x4_t p = vld4q_u8((const uint8_t*)src);
+		std::swap(p.val[0], p.val[2]);
+		vst4q_u8((uint8_t*)dest, p);
+	}
+	#elif defined(__SSE2__)
+	const __m128i maskGA = _mm_set1_epi32(int(0xFF00FF00));
+	const __m128i mask8 = _mm_set1_epi32(0xFF);
+	for(; count >= 4; count -= 4, src += 4, dest += 4)
+	{
+		__m128i p = _mm_loadu_si128((const __m128i*)src);
+		__m128i rb = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(p, 16), mask8), _mm_slli_epi32(_mm_and_si128(p, mask8), 16));
+		_mm_storeu_si128((__m128i*)dest, _mm_or_si128(_mm_and_si128(p, maskGA), rb));
+	}
+	#endif
+	for(; count; count--)
+	{
+		*dest++ = transformRGBA8888ToBGRA8888(*src++);
+	}
+}
+
+void transformNIndexedToRGB16(const uint8_t *src, size_t count, uint16_t *dest, const uint16_t *palette)
+{
+	#if defined(__aarch64__)
+	// split the palette into low & high byte planes of four 64 entry tables,
+	// indices outside a table's range leave the previous lookup untouched
+	uint8x16x4_t lo[4], hi[4];
+	for(int t = 0; t < 4; t++)
+	{
+		for(int k = 0; k < 4; k++)
+		{
+			uint8x16x2_t entries = vld2q_u8((const uint8_t*)(palette + t * 64 + k * 16));
+			lo[t].val[k] = entries.val[0];
+			hi[t].val[k] = entries.val[1];
+		}
+	}
+	for(; count >= 16; count -= 16, src += 16, dest += 16)
+	{
+		uint8x16_t idx = vld1q_u8(src);
+		uint8x16x2_t out{{vqtbl4q_u8(lo[0], idx), vqtbl4q_u8(hi[0], idx)}};
+		for(int t = 1; t < 4; t++)
+		{
+			idx = vsubq_u8(idx, vdupq_n_u8(64));
+			out.val[0] = vqtbx4q_u8(out.val[0], lo[t], idx);
+			out.val[1] = vqtbx4q_u8(out.val[1], hi[t], idx);
+		}
+		vst2q_u8((uint8_t*)dest, out);
+	}
+	#endif
+	// without a byte table lookup instruction, gathers aren't faster than scalar loads,
+	// so just unroll to keep multiple loads in flight
+	for(; count >= 4; count -= 4, src += 4, dest += 4)
+	{
+		dest[0] = palette[src[0]];
+		dest[1] = palette[src[1]];
+		dest[2] = palette[src[2]];
+		dest[3] = palette[src[3]];
+	}
+	for(; count; count--)
+	{
+		*dest++ = palette[*src++];
+	}
+}
+
 }
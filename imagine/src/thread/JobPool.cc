@@ -0,0 +1,147 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/thread/JobPool.hh>
+#include <imagine/logger/logger.h>
+#include <format>
+
+namespace IG
+{
+
+constexpr SystemLogger log{"JobPool"};
+
+JobPool::JobPool(int threads, const char *name)
+{
+	workers.reserve(threads);
+	for(int i = 0; i < threads; i++)
+	{
+		auto &w = *workers.emplace_back(std::make_unique<Worker>());
+		w.thread = makeThreadSync([this, &w, i](auto &sem)
+		{
+			w.id = thisThreadId();
+			sem.release();
+			run(i);
+		});
+	}
+	log.info("started {} with {} threads", name, threads);
+}
+
+JobPool::~JobPool()
+{
+	if(workers.empty())
+		return;
+	wait();
+	{
+		std::scoped_lock lock{mutex};
+		quit = true;
+	}
+	jobCond.notify_all();
+	for(auto &w : workers)
+	{
+		w->thread.join();
+	}
+}
+
+void JobPool::submit(Job job)
+{
+	if(workers.empty())
+	{
+		job();
+		return;
+	}
+	pendingJobs.fetch_add(1, std::memory_order_relaxed);
+	auto &w = *workers[nextWorker++ % workers.size()];
+	{
+		std::scoped_lock lock{w.mutex};
+		w.jobs.emplace_back(std::move(job));
+	}
+	{
+		// taking the lock orders the count update with a worker checking it before sleeping
+		std::scoped_lock lock{mutex};
+		queuedJobs.fetch_add(1, std::memory_order_relaxed);
+	}
+	jobCond.notify_one();
+}
+
+bool JobPool::runOneJob(int preferredIdx)
+{
+	auto workerCount = workers.size();
+	for(size_t i = 0; i < workerCount; i++)
+	{
+		auto &w = *workers[(preferredIdx + i) % workerCount];
+		Job job;
+		{
+			std::scoped_lock lock{w.mutex};
+			if(w.jobs.empty())
+				continue;
+			// a worker takes its newest job, others steal the oldest
+			if(i == 0)
+			{
+				job = std::move(w.jobs.back());
+				w.jobs.pop_back();
+			}
+			else
+			{
+				job = std::move(w.jobs.front());
+				w.jobs.pop_front();
+			}
+		}
+		queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+		job();
+		finishJob();
+		return true;
+	}
+	return false;
+}
+
+void JobPool::finishJob()
+{
+	if(pendingJobs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		std::scoped_lock lock{mutex};
+		idleCond.notify_all();
+	}
+}
+
+void JobPool::wait()
+{
+	// help with the remaining jobs instead of blocking
+	while(runOneJob(0)) {}
+	std::unique_lock lock{mutex};
+	idleCond.wait(lock, [&]{ return !pendingJobs.load(std::memory_order_acquire); });
+}
+
+void JobPool::addThreadIds(std::vector<ThreadId> &ids) const
+{
+	for(auto &w : workers)
+	{
+		ids.emplace_back(w->id);
+	}
+}
+
+void JobPool::run(int idx)
+{
+	while(true)
+	{
+		if(runOneJob(idx))
+			continue;
+		std::unique_lock lock{mutex};
+		jobCond.wait(lock, [&]{ return queuedJobs.load(std::memory_order_relaxed) > 0 || quit; });
+		if(quit && queuedJobs.load(std::memory_order_relaxed) <= 0)
+			return;
+	}
+}
+
+}
@@ -0,0 +1,48 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/util/memory/MemoryAccounting.hh>
+#include <imagine/util/utility.h>
+#include <array>
+#include <atomic>
+
+namespace IG::MemoryAccounting
+{
+
+struct CategoryTotals
+{
+	std::atomic_size_t current;
+	std::atomic_size_t peak;
+};
+
+static constinit std::array<CategoryTotals, memoryCategories> totals{};
+
+void add(MemoryCategory c, size_t bytes)
+{
+	auto &t = totals[to_underlying(c)];
+	auto newCurrent = t.current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+	auto peak = t.peak.load(std::memory_order_relaxed);
+	while(newCurrent > peak && !t.peak.compare_exchange_weak(peak, newCurrent, std::memory_order_relaxed)) {}
+}
+
+void sub(MemoryCategory c, size_t bytes)
+{
+	totals[to_underlying(c)].current.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+size_t current(MemoryCategory c) { return totals[to_underlying(c)].current.load(std::memory_order_relaxed); }
+size_t peak(MemoryCategory c) { return totals[to_underlying(c)].peak.load(std::memory_order_relaxed); }
+
+}
@@ -0,0 +1,6 @@
+ifndef inc_memory_accounting
+inc_memory_accounting := 1
+
+SRC += util/MemoryAccounting.cc
+
+endif
@@ -15,6 +15,7 @@
 
 #include <imagine/config/defs.hh>
 #include <imagine/vmem/memory.hh>
+#include <imagine/util/memory/MemoryAccounting.hh>
 #include <imagine/util/utility.h>
 #include <imagine/logger/logger.h>
 #include <sys/mman.h>
@@ -50,12 +51,40 @@ static std::span<uint8_t> vAlloc(size_t bytes, bool shared)
 		log.error("error in mmap");
 		return {};
 	}
+	MemoryAccounting::add(MemoryCategory::vmem, bytes);
 	return {static_cast<uint8_t*>(buff), bytes};
 }
 
-std::span<uint8_t> vAlloc(size_t bytes)
+std::span<uint8_t> vAlloc(size_t bytes, VMemFlags flags)
 {
-	return vAlloc(bytes, false);
+	auto buff = vAlloc(bytes, false);
+	if(buff.data() && (flags.hugePages || flags.locked))
+		vAdvise(buff, flags);
+	return buff;
+}
+
+bool vAdvise(std::span<uint8_t> buff, VMemFlags flags)
+{
+	auto start = roundPageSize(buff.data());
+	auto end = truncPageSize(buff.data() + buff.size());
+	if(end <= start)
+		return false;
+	size_t bytes = end - start;
+	bool success = true;
+	#ifdef MADV_HUGEPAGE
+	if(flags.hugePages && madvise(start, bytes, MADV_HUGEPAGE) == -1)
+	{
+		// kernel may be built without transparent huge page support
+		log.warn("error in madvise(MADV_HUGEPAGE)");
+		success = false;
+	}
+	#endif
+	if(flags.locked && mlock(start, bytes) == -1)
+	{
+		log.warn("error in mlock");
+		success = false;
+	}
+	return success;
 }
 
 void vFree(std::span<uint8_t> buff)
@@ -65,7 +94,9 @@ void vFree(std::span<uint8_t> buff)
 	if(munmap(buff.data(), buff.size_bytes()) == -1)
 	{
 		log.error("error in unmap");
+		return;
 	}
+	MemoryAccounting::sub(MemoryCategory::vmem, buff.size_bytes());
 }
 
 std::span<uint8_t> vAllocMirrored(size_t bytes)
@@ -15,11 +15,13 @@
 
 #include <imagine/config/defs.hh>
 #include <imagine/vmem/memory.hh>
+#include <imagine/util/memory/MemoryAccounting.hh>
 #include <imagine/util/utility.h>
 #include <imagine/logger/logger.h>
 #include <mach/mach.h>
 #include <mach/vm_map.h>
 #include <mach/machine/vm_param.h>
+#include <sys/mman.h>
 
 namespace IG
 {
@@ -27,15 +29,42 @@ namespace IG
 constexpr SystemLogger log{"VMem"};
 uintptr_t pageSize = PAGE_SIZE;
 
-std::span<uint8_t> vAlloc(size_t bytes)
+std::span<uint8_t> vAlloc(size_t bytes, VMemFlags flags)
 {
 	vm_address_t addr;
-	if(vm_allocate(mach_task_self(), &addr, bytes, VM_FLAGS_ANYWHERE) != KERN_SUCCESS) [[unlikely]]
+	bool allocated{};
+	#ifdef VM_FLAGS_SUPERPAGE_SIZE_ANY
+	// superpages aren't supported on all hardware, fall back to regular pages
+	if(flags.hugePages)
+		allocated = vm_allocate(mach_task_self(), &addr, bytes, VM_FLAGS_ANYWHERE | VM_FLAGS_SUPERPAGE_SIZE_ANY) == KERN_SUCCESS;
+	#endif
+	if(!allocated && vm_allocate(mach_task_self(), &addr, bytes, VM_FLAGS_ANYWHERE) != KERN_SUCCESS) [[unlikely]]
 	{
 		log.error("error in vm_allocate");
 		return {};
 	}
-	return {reinterpret_cast<uint8_t*>(addr), bytes};
+	MemoryAccounting::add(MemoryCategory::vmem, bytes);
+	std::span<uint8_t> buff{reinterpret_cast<uint8_t*>(addr), bytes};
+	if(flags.locked)
+		vAdvise(buff, flags);
+	return buff;
+}
+
+bool vAdvise(std::span<uint8_t> buff, VMemFlags flags)
+{
+	// superpages can only be requested when allocating
+	if(!flags.locked)
+		return !flags.hugePages;
+	auto start = roundPageSize(buff.data());
+	auto end = truncPageSize(buff.data() + buff.size());
+	if(end <= start)
+		return false;
+	if(mlock(start, end - start) == -1)
+	{
+		log.warn("error in mlock");
+		return false;
+	}
+	return true;
 }
 
 void vFree(std::span<uint8_t> buff)
@@ -45,7 +74,9 @@ void vFree(std::span<uint8_t> buff)
 	if(vm_deallocate(mach_task_self(), vm_address_t(buff.data()), buff.size()) != KERN_SUCCESS)
 	{
 		log.error("error in vm_deallocate");
+		return;
 	}
+	MemoryAccounting::sub(MemoryCategory::vmem, buff.size());
 }
 
 std::span<uint8_t> vAllocMirrored(size_t bytes)
@@ -1,6 +1,8 @@
 ifndef inc_vmem
 inc_vmem := 1
 
+include $(imagineSrcDir)/util/MemoryAccounting.mk
+
 ifeq ($(ENV_KERNEL), linux)
  SRC += vmem/linux.cc
 else ifeq ($(ENV_KERNEL), mach)